@@ -0,0 +1,99 @@
+
+include ../../deps/build/make/platforms/detect-host.mk
+
+NAME       = Bench
+TARGET     = $(BINDIR)/$(NAME)$(SUFFIX)$(EXTBIN)
+INCDIR     = ../../deps/include/
+SRCDIR     = ../../src/$(NAME)
+OBJDIR    := $(OBJDIR)/$(NAME)
+LIBDIRDEP  = ../../deps/build/make/$(LIBDIR)
+LIBDIRPRE  = ../../deps/prebuilt/$(TARGET_OS)/$(TARGET_ARCH)
+DEFINES   := $(DEFINES) \
+             -DUNICODE \
+             -D_SILENCE_ALL_CXX17_DEPRECATION_WARNINGS
+INCLUDES  := $(INCLUDES) \
+             -I../../src \
+             -I../../src/Engine \
+             -I$(INCDIR) \
+             -I$(SRCDIR)
+CXXFLAGS  := $(CXXFLAGS) \
+             -Wno-unknown-warning-option \
+             -Wno-deprecated-declarations \
+             -Wno-enum-compare-switch \
+             -Wno-format-security \
+             -Wno-ignored-attributes \
+             -std=c++17
+LINKFLAGS := $(LINKFLAGS)
+LINKPATH  := $(LINKPATH)
+LINKLIBS  := $(LINKLIBS) \
+             $(LIBDIR)/Engine$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/stk$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/brainflow$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/brainflow-boardcontroller$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/edflib$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/oscpack$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/kissfft$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/wavelib$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/zlib$(SUFFIX)$(EXTLIB)
+OBJS       = main.o \
+             ClassifierRun.o \
+             NmdCodec.o \
+             SnapshotStress.o \
+             SampleFormatCheck.o \
+             MathChain.o \
+             BandPowerCheck.o \
+             HrvCheck.o \
+             HistogramCheck.o \
+             LoretaBench.o \
+             Regression.o
+
+ifeq ($(TARGET_ARCH),x86)
+DEFINES   := $(DEFINES) -DNEUROMORE_ARCHITECTURE_X86
+endif
+
+ifeq ($(TARGET_ARCH),x64)
+DEFINES   := $(DEFINES) -DNEUROMORE_ARCHITECTURE_X86
+endif
+
+ifeq ($(TARGET_OS),win)
+DEFINES   := $(DEFINES) \
+             -D_CRT_SECURE_NO_WARNINGS \
+             -DNEUROMORE_PLATFORM_WINDOWS
+LINKFLAGS := $(LINKFLAGS) -Xlinker /SUBSYSTEM:CONSOLE
+LINKLIBS  := $(LINKLIBS) \
+             -lsetupapi.lib \
+             -lws2_32.lib \
+             -liphlpapi.lib \
+             -lwinmm.lib \
+             -ladvapi32.lib
+endif
+
+ifeq ($(TARGET_OS),osx)
+DEFINES   := $(DEFINES) -DNEUROMORE_PLATFORM_OSX
+LINKLIBS  := $(LINKLIBS) \
+             -framework CoreFoundation \
+             -framework IOKit
+endif
+
+ifeq ($(TARGET_OS),linux)
+DEFINES   := $(DEFINES) -DNEUROMORE_PLATFORM_LINUX
+LINKLIBS  := $(LINKLIBS) \
+             -lpthread \
+             -ldl
+endif
+
+OBJS := $(patsubst %,$(OBJDIR)/%,$(OBJS))
+
+$(OBJDIR)/%.o:
+	@echo [CXX] $@
+	$(CXX) $(CPUFLAGS) $(DEFINES) $(INCLUDES) $(CXXFLAGS) -c $(@:$(OBJDIR)%.o=$(SRCDIR)%.cpp) -o $@
+
+.DEFAULT_GOAL := build
+
+build: $(OBJS)
+	@echo [LNK] $(TARGET)
+	$(LINK) $(LINKFLAGS) $(LINKPATH) $(OBJS) $(LINKLIBS) -o $(TARGET)
+
+clean:
+	-$(call deletefiles,$(OBJDIR),*.o)
+	-$(call deletefiles,$(BINDIR),$(NAME)$(SUFFIX)$(EXTBIN))
@@ -8,6 +8,7 @@ SRCDIRPRIV = ../../priv/src/$(NAME)
 OBJDIR    := $(OBJDIR)/$(NAME)
 DEFINES   := $(DEFINES) \
              -DUNICODE \
+             -DCHROMIUM_ZLIB_NO_CHROMECONF \
              -D_SILENCE_ALL_CXX17_DEPRECATION_WARNINGS
 INCLUDES  := $(INCLUDES) \
              -I$(INCDIR) \
@@ -43,6 +44,8 @@ OBJS       = Core/AABB.o \
              Core/Math.o \
              Core/MemoryFile.o \
              Core/Mutex.o \
+             Core/MappedFile.o \
+             Core/Profiler.o \
              Core/String.o \
              Core/StringCharacter.o \
              Core/StringIterator.o \
@@ -74,17 +77,22 @@ OBJS       = Core/AABB.o \
              Devices/NeuroSky/NeuroSkyDevice.o \
              Devices/OpenBCI/OpenBCIDevices.o \
              Devices/Test/TestDevice.o \
+             Devices/Test/LoadGeneratorDevice.o \
+             Devices/Test/ReplayDevice.o \
              Devices/Test/TestDeviceDriver.o \
              Devices/Versus/VersusDevice.o \
              Devices/DeviceInventory.o \
              DSP/AttributeChannels.o \
+             DSP/BandPowerProcessor.o \
              DSP/Channel.o \
              DSP/ChannelBase.o \
+             DSP/ChannelChunkStore.o \
              DSP/ChannelFileReader.o \
              DSP/ChannelFileWriter.o \
              DSP/ChannelProcessor.o \
              DSP/ChannelReader.o \
              DSP/ClockGenerator.o \
+             DSP/CrossSpectrum.o \
              DSP/Epoch.o \
              DSP/FFT_FFTW.o \
              DSP/FFT_KissFFT.o \
@@ -93,15 +101,23 @@ OBJS       = Core/AABB.o \
              DSP/FilterGenerator.o \
              DSP/FrequencyBand.o \
              DSP/Histogram.o \
+             DSP/HrvFrequencyDomain.o \
              DSP/HrvProcessor.o \
+             DSP/HrvSlidingWindow.o \
              DSP/HrvTimeDomain.o \
              DSP/LinearFilterProcessor.o \
+             DSP/MathExpression.o \
+             DSP/MorletFilterBank.o \
              DSP/MultiChannel.o \
              DSP/MultiChannelReader.o \
+             DSP/PSDProcessor.o \
              DSP/ResampleProcessor.o \
+             DSP/SLoretaSolver.o \
              DSP/Spectrum.o \
              DSP/SpectrumAnalyzerSettings.o \
+             DSP/SpectrumAnalyzerCache.o \
              DSP/StatisticsProcessor.o \
+             DSP/WaveletDenoiser.o \
              DSP/WindowFunction.o \
              Graph/Action.o \
              Graph/Actions.o \
@@ -110,6 +126,7 @@ OBJS       = Core/AABB.o \
              Graph/AnnotationNode.o \
              Graph/AutoThresholdNode.o \
              Graph/AVEColorNode.o \
+             Graph/BandPowerNode.o \
              Graph/BinSelectorNode.o \
              Graph/BiquadFilterNode.o \
              Graph/BodyFeedbackNode.o \
@@ -124,6 +141,7 @@ OBJS       = Core/AABB.o \
              Graph/ColorWheelNode.o \
              Graph/CompareNode.o \
              Graph/Connection.o \
+             Graph/ConnectivityNode.o \
              Graph/CustomFeedbackNode.o \
              Graph/DelayNode.o \
              Graph/DeviceInputNode.o \
@@ -132,6 +150,7 @@ OBJS       = Core/AABB.o \
              Graph/EegDeviceNode.o \
              Graph/EntryState.o \
              Graph/ExitState.o \
+             Graph/ExpressionNode.o \
              Graph/FeedbackNode.o \
              Graph/FFTNode.o \
              Graph/FileReaderNode.o \
@@ -165,6 +184,7 @@ OBJS       = Core/AABB.o \
              Graph/PointsNode.o \
              Graph/Port.o \
              Graph/ProcessorNode.o \
+             Graph/PSDNode.o \
              Graph/RecolorNode.o \
              Graph/RemapNode.o \
              Graph/RenameNode.o \
@@ -197,6 +217,7 @@ OBJS       = Core/AABB.o \
              Graph/ToneGeneratorNode.o \
              Graph/ViewNode.o \
              Graph/WaveformNode.o \
+             Graph/WaveletNode.o \
              Graph/VolumeControlNode.o \
              Graph/ScreenBrightnessNode.o \
              Graph/SpeedControlNode.o \
@@ -223,7 +244,9 @@ OBJS       = Core/AABB.o \
              EngineManager.o \
              Experience.o \
              License.o \
+             NmdCompressor.o \
              Sensor.o \
+             SensorRecording.o \
              SerialPortManager.o \
              Session.o \
              SessionExporter.o \
@@ -31,6 +31,7 @@ LINKLIBS  := $(LINKLIBS) \
              $(LIBDIRDEP)/edflib$(SUFFIX)$(EXTLIB) \
              $(LIBDIRDEP)/oscpack$(SUFFIX)$(EXTLIB) \
              $(LIBDIRDEP)/kissfft$(SUFFIX)$(EXTLIB) \
+             $(LIBDIRDEP)/wavelib$(SUFFIX)$(EXTLIB) \
              $(LIBDIRDEP)/zlib$(SUFFIX)$(EXTLIB) \
              $(LIBDIR)/Engine$(SUFFIX)$(EXTLIB)
 OBJS       = main.o
@@ -322,6 +322,7 @@ OBJS       = Devices/ABM/AbmDriver.o \
              Rendering/OpenGLManager.o \
              Rendering/OpenGLWidget.o \
              Rendering/OpenGLWidget2DHelpers.o \
+             Rendering/MinMaxPyramid.o \
              Rendering/OpenGLWidgetCallback.o \
              Rendering/TextureManager.o \
              UnitTests/StudioTestFacility.o \
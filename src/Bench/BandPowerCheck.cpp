@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "BandPowerCheck.h"
+#include "ClassifierRun.h"
+#include <Engine/EngineManager.h>
+#include <Engine/Core/Math.h>
+#include <Engine/Graph/Classifier.h>
+#include <Engine/Graph/SignalGeneratorNode.h>
+#include <Engine/Graph/FFTNode.h>
+#include <Engine/Graph/FrequencyBandNode.h>
+#include <Engine/Graph/BandPowerNode.h>
+#include <Engine/Graph/CustomFeedbackNode.h>
+#include <stdio.h>
+
+using namespace Core;
+
+
+// band power check classifier: FFT -> frequency band and band power with the same band, FFT order and window shift on one generator, for amplitude and power
+static Classifier* CreateBandPowerCheckClassifier(const BenchConfig& config)
+{
+	Classifier* classifier = new Classifier();
+	classifier->SetName("Band Power Check");
+
+	// a sine inside the band, between two bins
+	Node* generator = AddNode( classifier, SignalGeneratorNode::Uuid(), "Generator" );
+	generator->SetFloatAttribute( "sampleRate", config.mSampleRate );
+	generator->SetFloatAttribute( "frequency", 10.3 );
+	generator->SetFloatAttribute( "amplitude", 10.0 );
+	generator->OnAttributesChanged();
+
+	const double minFrequency = 8.0;
+	const double maxFrequency = 12.0;
+	const int32 fftOrder = 7;
+	const int32 windowShift = 8;
+	const int32 numBands = GetEngine()->GetSpectrumAnalyzerSettings()->GetNumFrequencyBands();
+
+	String name;
+	for (int32 valueType=FrequencyBandNode::VALUE_AMPLITUDE; valueType<=FrequencyBandNode::VALUE_POWER; ++valueType)
+	{
+		Node* fftNode = AddNode( classifier, FFTNode::Uuid(), name.Format("FFT %i", valueType) );
+		fftNode->SetInt32Attribute( "FFTorder", fftOrder );
+		fftNode->SetInt32Attribute( "NumWindowShiftSamples", windowShift );
+		fftNode->SetInt32Attribute( "WindowFunction", WindowFunction::WINDOWFUNCTION_RECTANGULAR );
+		fftNode->SetBoolAttribute( "UseZeroPadding", false );
+		fftNode->OnAttributesChanged();
+
+		// custom (fixed) band
+		Node* bandNode = AddNode( classifier, FrequencyBandNode::Uuid(), name.Format("Frequency Band %i", valueType) );
+		bandNode->SetInt32Attribute( "ValueType", valueType );
+		bandNode->SetInt32Attribute( "FrequencyBands", numBands );
+		bandNode->SetFloatAttribute( "MinFrequency", minFrequency );
+		bandNode->SetFloatAttribute( "MaxFrequency", maxFrequency );
+		bandNode->OnAttributesChanged();
+
+		Node* bandPowerNode = AddNode( classifier, BandPowerNode::Uuid(), name.Format("Band Power %i", valueType) );
+		bandPowerNode->SetInt32Attribute( "ValueType", valueType );
+		bandPowerNode->SetFloatAttribute( "MinFrequency", minFrequency );
+		bandPowerNode->SetFloatAttribute( "MaxFrequency", maxFrequency );
+		bandPowerNode->SetInt32Attribute( "FFTorder", fftOrder );
+		bandPowerNode->SetInt32Attribute( "NumWindowShiftSamples", windowShift );
+		bandPowerNode->OnAttributesChanged();
+
+		classifier->AddConnection( generator, 0, fftNode, FFTNode::INPUTPORT_CHANNEL );
+		classifier->AddConnection( fftNode, FFTNode::OUTPUTPORT_SPECTRUM, bandNode, FrequencyBandNode::INPUTPORT_SPECTRUM );
+		classifier->AddConnection( generator, 0, bandPowerNode, BandPowerNode::INPUTPORT_CHANNEL );
+
+		// the feedback values come in pairs: FFT -> frequency band, band power
+		Node* spectrumFeedback = AddNode( classifier, CustomFeedbackNode::Uuid(), name.Format("Frequency Band Feedback %i", valueType) );
+		classifier->AddConnection( bandNode, FrequencyBandNode::OUTPUTPORT_CHANNEL, spectrumFeedback, CustomFeedbackNode::INPUTPORT_VALUE );
+		Node* bandPowerFeedback = AddNode( classifier, CustomFeedbackNode::Uuid(), name.Format("Band Power Feedback %i", valueType) );
+		classifier->AddConnection( bandPowerNode, BandPowerNode::OUTPUTPORT_CHANNEL, bandPowerFeedback, CustomFeedbackNode::INPUTPORT_VALUE );
+	}
+
+	classifier->CollectNodes();
+	return classifier;
+}
+
+
+// run FFT -> frequency band and the band power node on the same generator: they must end up with the same band amplitude and power
+bool RunBandPowerCheck(const BenchConfig& config, Json::Item& rootItem, Json::Item& runsItem)
+{
+	Array<double> values;
+	if (RunClassifier(CreateBandPowerCheckClassifier(config), config, runsItem, &values) == false)
+		return false;
+
+	bool isEqual = (values.Size() == 4);
+
+	Json::Item checkItem = rootItem.AddArray("bandPowerCheck");
+	const char* valueTypeNames[2] = { "amplitude", "power" };
+	for (uint32 i=0; i<2 && values.Size() == 4; ++i)
+	{
+		const double spectrumValue = values[2*i];
+		const double bandPowerValue = values[2*i+1];
+		const bool isValueEqual = (Math::AbsD(spectrumValue - bandPowerValue) <= 1e-9 * Max(1.0, Math::AbsD(spectrumValue)));
+
+		Json::Item valueItem = checkItem.AddObject();
+		valueItem.AddString( "value", valueTypeNames[i] );
+		valueItem.AddDouble( "frequencyBandValue", spectrumValue );
+		valueItem.AddDouble( "bandPowerValue", bandPowerValue );
+		valueItem.AddBool( "equal", isValueEqual );
+
+		if (isValueEqual == false)
+		{
+			fprintf(stderr, "Band power and FFT -> frequency band disagree (%s): %.17g vs %.17g\n", valueTypeNames[i], bandPowerValue, spectrumValue);
+			isEqual = false;
+		}
+	}
+
+	return isEqual;
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_BENCHCONFIG_H
+#define __NEUROMORE_BENCHCONFIG_H
+
+// include required headers
+#include <Engine/Config.h>
+#include <Engine/Core/String.h>
+#include <Engine/Core/Array.h>
+#include <Engine/DSP/ChannelBase.h>
+
+
+// what a bench invocation does, exactly one mode per run
+enum EBenchMode
+{
+	BENCHMODE_CLASSIFIERS = 0,		// the given classifiers, or the synthetic one without any
+	BENCHMODE_NMD,					// session file codec round-trip (--nmd)
+	BENCHMODE_SNAPSHOTSTRESS,		// feedback snapshot consistency (--snapshot-stress)
+	BENCHMODE_SAMPLEFORMATS,		// channel sample format error bounds (--sample-formats)
+	BENCHMODE_MATHCHAIN,			// Math2 chain against the expression node (--math-chain)
+	BENCHMODE_BANDPOWERCHECK,		// band power node against FFT -> frequency band (--bandpower-check)
+	BENCHMODE_HRV,					// incremental against batch HRV (--hrv)
+	BENCHMODE_HISTOGRAM,			// histogram searches against the linear walk (--histogram)
+	BENCHMODE_LORETA,				// LORETA source estimation throughput (--loreta)
+	BENCHMODE_REGRESSION			// recorded sessions against their golden results (--regress)
+};
+
+
+// command line options
+struct BenchConfig
+{
+	EBenchMode		mMode;
+	uint32			mNumChannels;
+	uint32			mSampleRate;
+	uint32			mNumGenerators;
+	double			mSeconds;
+	double			mTickRate;
+	bool			mProfileNodes;
+	bool			mUseBandPower;
+	double			mSnapshotStressSeconds;
+	ChannelBase::ESampleFormat mSampleFormat;
+	double			mSampleResolution;
+	uint32			mMathChainLength;
+	uint32			mNumSlowBranches;
+	bool			mSkipIdleProcessors;
+	uint32			mNumDebugViews;
+	bool			mDemandTracking;
+	uint32			mHrvWindowLength;
+	uint32			mNumHistogramBins;
+	uint32			mLoretaGridResolution;
+	uint32			mNumAutoThresholdBins;
+	bool			mUseLoadGenerator;
+	uint32			mSeed;
+	double			mArtifactRate;
+	double			mDropoutRate;
+	double			mJitter;
+	uint32			mNumDevices;
+	double			mSlowDeviceDelay;
+	bool			mAcquisitionThreads;
+	Core::String	mRecordFilename;
+	bool			mUpdateGolden;
+	double			mTolerance;
+	double			mRelativeTolerance;
+	Core::String	mOutputFilename;
+	Core::Array<Core::String> mClassifierFilenames;
+	Core::Array<Core::String> mNmdFilenames;
+	Core::Array<Core::String> mRegressionFilenames;
+};
+
+
+#endif
@@ -0,0 +1,338 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "ClassifierRun.h"
+#include <Engine/EngineManager.h>
+#include <Engine/Core/Timer.h>
+#include <Engine/Core/Profiler.h>
+#include <Engine/Core/Math.h>
+#include <Engine/SensorRecording.h>
+#include <Engine/Devices/Test/LoadGeneratorDevice.h>
+#include <Engine/Graph/Classifier.h>
+#include <algorithm>
+#include <stdio.h>
+
+using namespace Core;
+
+
+// accumulated per-node cost of a run
+struct NodeCost
+{
+	String	mName;
+	String	mType;
+	uint32	mNumCalls;
+	double	mTotalTime;
+	double	mMaxTime;
+	double	mNumSamplesIn;
+	double	mNumSamplesOut;
+	double	mNumAllocations;
+};
+
+
+// create a node and add it to the classifier
+Node* AddNode(Classifier* classifier, const char* typeUuid, const char* name)
+{
+	Node* node = static_cast<Node*>( GetGraphObjectFactory()->CreateObjectByTypeUuid(classifier, typeUuid) );
+	if (node == NULL)
+		return NULL;
+
+	node->SetName(name);
+	classifier->AddNode(node);
+	return node;
+}
+
+
+// total number of samples produced by all input sensors of the classifier
+static uint64 CountInputSamples(Classifier* classifier)
+{
+	uint64 numSamples = 0;
+
+	const uint32 numInputNodes = classifier->GetNumInputNodes();
+	for (uint32 i=0; i<numInputNodes; ++i)
+	{
+		InputNode* inputNode = classifier->GetInputNode(i);
+
+		const uint32 numSensors = inputNode->GetNumSensors();
+		for (uint32 j=0; j<numSensors; ++j)
+			numSamples += inputNode->GetSensor(j)->GetChannel()->GetSampleCounter();
+	}
+
+	// device input nodes are collected separately (counter instead of buffered samples, the device buffers may be shorter than the run)
+	const uint32 numDeviceInputNodes = classifier->GetNumDeviceInputNodes();
+	for (uint32 i=0; i<numDeviceInputNodes; ++i)
+	{
+		DeviceInputNode* inputNode = classifier->GetDeviceInputNode(i);
+
+		const uint32 numSensors = inputNode->GetNumSensors();
+		for (uint32 j=0; j<numSensors; ++j)
+			numSamples += inputNode->GetSensor(j)->GetChannel()->GetSampleCounter();
+	}
+
+	return numSamples;
+}
+
+
+// fold the profiler events recorded since the last call into the node costs and drop them
+static void AccumulateNodeCosts(Classifier* classifier, Array<NodeCost>& nodeCosts)
+{
+	Profiler& profiler = GetEngine()->GetProfiler();
+
+	Array<Profiler::ScopeStatistics> statistics;
+	profiler.CollectStatistics( statistics, 3600.0 );
+	profiler.Clear();
+
+	const uint32 numScopes = statistics.Size();
+	for (uint32 i=0; i<numScopes; ++i)
+	{
+		const Profiler::ScopeStatistics& scope = statistics[i];
+
+		while (nodeCosts.Size() <= scope.mScopeID)
+		{
+			NodeCost& cost = nodeCosts.AddEmpty();
+			cost.mNumCalls = 0;
+			cost.mTotalTime = cost.mMaxTime = 0.0;
+			cost.mNumSamplesIn = cost.mNumSamplesOut = cost.mNumAllocations = 0.0;
+		}
+
+		NodeCost& cost = nodeCosts[scope.mScopeID];
+		cost.mName				 = scope.mName;
+		cost.mType				 = scope.mCategory;
+		cost.mNumCalls			+= scope.mNumCalls;
+		cost.mTotalTime			+= scope.mTotalTime;
+		cost.mMaxTime			 = Max<double>( cost.mMaxTime, scope.mMaxTime );
+		cost.mNumSamplesIn		+= scope.mNumSamplesIn;
+		cost.mNumSamplesOut		+= scope.mNumSamplesOut;
+		cost.mNumAllocations	+= scope.mNumAllocations;
+	}
+
+	// prefer the readable node type over the profiler category
+	const uint32 numNodes = classifier->GetNumNodes();
+	for (uint32 i=0; i<numNodes; ++i)
+	{
+		Node* node = classifier->GetNode(i);
+		const uint32 scopeID = node->GetProfilerScopeID();
+		if (scopeID < nodeCosts.Size())
+			nodeCosts[scopeID].mType = node->GetReadableType();
+	}
+}
+
+
+// percentile of an ascending sorted array
+static double Percentile(const Array<double>& sorted, double percentile)
+{
+	if (sorted.Size() == 0)
+		return 0.0;
+
+	const uint32 index = Min<uint32>( (uint32)(percentile * (sorted.Size() - 1) + 0.5), sorted.Size() - 1 );
+	return sorted[index];
+}
+
+
+// run a single classifier and add its report to the runs array
+bool RunClassifier(Classifier* classifier, const BenchConfig& config, Json::Item& runsItem, Array<double>* outFeedbackValues)
+{
+	EngineManager* engine = GetEngine();
+	Profiler& profiler = engine->GetProfiler();
+
+	String classifierName = classifier->GetName();
+	if (engine->LoadGraph(classifier) == false)
+		return false;
+
+	engine->Reset();
+	profiler.SetEnabled(config.mProfileNodes);
+	profiler.Clear();
+
+	// capture the device input for regression tests
+	SensorRecording recording;
+	if (config.mRecordFilename.IsEmpty() == false)
+		engine->SetSensorRecording(&recording);
+
+	const double	tickDelta		= 1.0 / config.mTickRate;
+	const uint32	numTicks		= (uint32)(config.mSeconds * config.mTickRate + 0.5);
+	const uint64	startSamples	= CountInputSamples(classifier);
+
+	Array<double>	tickTimes;
+	Array<NodeCost>	nodeCosts;
+	tickTimes.Reserve(numTicks);
+
+	uint64 peakMemoryAllocated	= 0;
+	uint64 peakMemoryUsed		= 0;
+
+	Timer tickTimer;
+	Timer runTimer;
+	runTimer.GetTimeDelta();
+
+	// demand tracking: a signal view is opened after a quarter of the run (the spectrum debug views stay suspended), a spectrum view halfway through
+	uint32 numSuspendedNodes = 0;
+	uint32 numSuspendedNodesSignalView = 0;
+
+	for (uint32 i=0; i<numTicks; ++i)
+	{
+		if (config.mDemandTracking == true && i == numTicks / 4)
+		{
+			numSuspendedNodes = classifier->GetNumSuspendedNodes();
+			engine->AddViewConsumer(EngineManager::VIEWTYPE_SIGNAL);
+		}
+		if (config.mDemandTracking == true && i == numTicks / 2)
+		{
+			numSuspendedNodesSignalView = classifier->GetNumSuspendedNodes();
+			engine->AddViewConsumer(EngineManager::VIEWTYPE_SPECTRUM);
+		}
+
+		tickTimer.GetTimeDelta();
+		engine->Update( tickDelta );
+		tickTimes.Add( tickTimer.GetTimeDelta().InSeconds() );
+
+		// sampled outside the timed section
+		peakMemoryAllocated	= Max<uint64>( peakMemoryAllocated, classifier->CalculateBufferMemoryAllocated() );
+		peakMemoryUsed		= Max<uint64>( peakMemoryUsed, classifier->CalculateBufferMemoryUsed() );
+
+		// drain the profiler ring buffers before they wrap around
+		if (config.mProfileNodes == true && (i % 16) == 15)
+			AccumulateNodeCosts(classifier, nodeCosts);
+	}
+
+	const double wallSeconds = runTimer.GetTimeDelta().InSeconds();
+	if (config.mRecordFilename.IsEmpty() == false)
+	{
+		engine->SetSensorRecording(NULL);
+		if (recording.SaveToDisk(config.mRecordFilename.AsChar()) == false)
+			fprintf(stderr, "Failed to write recording '%s'\n", config.mRecordFilename.AsChar());
+	}
+	if (config.mDemandTracking == true)
+	{
+		engine->RemoveViewConsumer(EngineManager::VIEWTYPE_SIGNAL);
+		engine->RemoveViewConsumer(EngineManager::VIEWTYPE_SPECTRUM);
+	}
+	if (config.mProfileNodes == true)
+		AccumulateNodeCosts(classifier, nodeCosts);
+
+	const uint64 numSamples = CountInputSamples(classifier) - startSamples;
+	const double simulatedSeconds = numTicks * tickDelta;
+
+	// tick latency statistics
+	double totalTickTime = 0.0;
+	for (uint32 i=0; i<numTicks; ++i)
+		totalTickTime += tickTimes[i];
+
+	std::sort( tickTimes.GetPtr(), tickTimes.GetPtr() + tickTimes.Size() );
+
+	// report
+	Json::Item runItem = runsItem.AddObject();
+	runItem.AddString( "classifier", classifierName.AsChar() );
+	runItem.AddInt( "numNodes", classifier->GetNumNodes() );
+	runItem.AddInt( "ticks", numTicks );
+	runItem.AddDouble( "simulatedSeconds", simulatedSeconds );
+	runItem.AddDouble( "wallSeconds", wallSeconds );
+	runItem.AddDouble( "realtimeFactor", wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0 );
+	runItem.AddDouble( "inputSamples", (double)numSamples );
+	runItem.AddDouble( "samplesPerSecond", wallSeconds > 0.0 ? numSamples / wallSeconds : 0.0 );
+	runItem.AddDouble( "peakBufferMemoryAllocated", (double)peakMemoryAllocated );
+	runItem.AddDouble( "peakBufferMemoryUsed", (double)peakMemoryUsed );
+
+	Json::Item latencyItem = runItem.AddObject("tickLatencyMicroseconds");
+	latencyItem.AddDouble( "mean", numTicks > 0 ? totalTickTime / numTicks * 1e6 : 0.0 );
+	latencyItem.AddDouble( "p50", Percentile(tickTimes, 0.50) * 1e6 );
+	latencyItem.AddDouble( "p90", Percentile(tickTimes, 0.90) * 1e6 );
+	latencyItem.AddDouble( "p99", Percentile(tickTimes, 0.99) * 1e6 );
+	latencyItem.AddDouble( "max", Percentile(tickTimes, 1.00) * 1e6 );
+
+	// node updates and processor updates that were skipped because they could not produce output (every node is still updated)
+	Json::Item updatesItem = runItem.AddObject("updates");
+	updatesItem.AddDouble( "nodes", (double)classifier->GetTotalNodeUpdates() );
+	updatesItem.AddDouble( "processorSkips", (double)classifier->GetTotalProcessorSkips() );
+	updatesItem.AddDouble( "nodesPerTick", numTicks > 0 ? (double)classifier->GetTotalNodeUpdates() / numTicks : 0.0 );
+	updatesItem.AddDouble( "processorSkipsPerTick", numTicks > 0 ? (double)classifier->GetTotalProcessorSkips() / numTicks : 0.0 );
+
+	// injected load generator events
+	LoadGeneratorDevice* loadGenerator = static_cast<LoadGeneratorDevice*>( GetDeviceManager()->FindDeviceByType(LoadGeneratorDevice::TYPE_ID, 0) );
+	if (loadGenerator != NULL && loadGenerator->GetNumNeuroSensors() > 0)
+	{
+		Json::Item generatorItem = runItem.AddObject("loadGenerator");
+		generatorItem.AddInt( "artifacts", loadGenerator->GetNumArtifacts() );
+		generatorItem.AddInt( "dropouts", loadGenerator->GetNumDropouts() );
+		generatorItem.AddInt( "lostSamplesPerChannel", loadGenerator->GetNeuroSensor(0)->GetNumLostSamples() );
+	}
+
+	// device acquisition: samples dropped by the bounded sensor queues of devices that could not keep up
+	DeviceManager* deviceManager = GetDeviceManager();
+	uint32 numDroppedSamples = 0;
+	const uint32 numDevices = deviceManager->GetNumDevices();
+	for (uint32 i=0; i<numDevices; ++i)
+	{
+		Device* device = deviceManager->GetDevice(i);
+		const uint32 numSensors = device->GetNumSensors();
+		for (uint32 j=0; j<numSensors; ++j)
+			numDroppedSamples += device->GetSensor(j)->GetNumDroppedSamples();
+	}
+
+	Json::Item acquisitionItem = runItem.AddObject("acquisition");
+	acquisitionItem.AddInt( "devices", numDevices );
+	acquisitionItem.AddInt( "threads", deviceManager->GetNumAcquisitionThreads() );
+	acquisitionItem.AddInt( "droppedSamples", numDroppedSamples );
+
+	if (config.mDemandTracking == true)
+	{
+		updatesItem.AddInt( "suspendedBeforeViewsOpened", numSuspendedNodes );
+		updatesItem.AddInt( "suspendedWithSignalView", numSuspendedNodesSignalView );
+		updatesItem.AddInt( "suspendedAfterViewsOpened", classifier->GetNumSuspendedNodes() );
+	}
+
+	if (config.mProfileNodes == true)
+	{
+		Json::Item nodesItem = runItem.AddArray("nodes");
+
+		const uint32 numCosts = nodeCosts.Size();
+		for (uint32 i=0; i<numCosts; ++i)
+		{
+			const NodeCost& cost = nodeCosts[i];
+			if (cost.mNumCalls == 0)
+				continue;
+
+			Json::Item nodeItem = nodesItem.AddObject();
+			nodeItem.AddString( "name", cost.mName.AsChar() );
+			nodeItem.AddString( "type", cost.mType.AsChar() );
+			nodeItem.AddInt( "calls", cost.mNumCalls );
+			nodeItem.AddDouble( "totalMicroseconds", cost.mTotalTime * 1e6 );
+			nodeItem.AddDouble( "averageMicroseconds", cost.mTotalTime / cost.mNumCalls * 1e6 );
+			nodeItem.AddDouble( "maxMicroseconds", cost.mMaxTime * 1e6 );
+			nodeItem.AddDouble( "samplesIn", cost.mNumSamplesIn );
+			nodeItem.AddDouble( "samplesOut", cost.mNumSamplesOut );
+			nodeItem.AddDouble( "allocations", cost.mNumAllocations );
+		}
+	}
+
+	// final values of the feedback nodes (before the classifier gets deleted)
+	if (outFeedbackValues != NULL)
+	{
+		outFeedbackValues->Clear();
+		const uint32 numFeedbackNodes = classifier->GetNumFeedbackNodes();
+		for (uint32 i=0; i<numFeedbackNodes; ++i)
+			outFeedbackValues->Add( classifier->GetFeedbackNode(i)->GetCurrentValue() );
+	}
+
+	profiler.SetEnabled(false);
+	engine->UnloadGraph(classifier);
+	return true;
+}
@@ -0,0 +1,45 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_BENCHCLASSIFIERRUN_H
+#define __NEUROMORE_BENCHCLASSIFIERRUN_H
+
+// include required headers
+#include "BenchConfig.h"
+#include <Engine/Core/Json.h>
+
+
+// forward declarations
+class Classifier;
+class Node;
+
+
+// create a node and add it to the classifier
+Node* AddNode(Classifier* classifier, const char* typeUuid, const char* name);
+
+// load a classifier into the engine, tick it in simulated time and add its report (tick latency, throughput, memory, per-node cost) to the runs array
+// the final values of the feedback nodes are returned on request, the classifier is unloaded afterwards
+bool RunClassifier(Classifier* classifier, const BenchConfig& config, Core::Json::Item& runsItem, Core::Array<double>* outFeedbackValues = NULL);
+
+
+#endif
@@ -0,0 +1,326 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "HistogramCheck.h"
+#include <Engine/Core/Timer.h>
+#include <Engine/Core/Math.h>
+#include <Engine/DSP/Histogram.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Core;
+
+
+// reference for Histogram::CalcHighThreshold(): walk the bins upwards from the low threshold (the auto threshold node did this for every control sample)
+static double ReferenceHighThreshold(const Histogram& histogram, double lowThreshold, double target, bool areaTarget)
+{
+	if (histogram.GetNumValues() == 0)
+		return 0;
+
+	const uint32 numSamples = histogram.GetNumValues();
+	const uint32 scoreTargetSampleCount = numSamples * target;
+	uint32 currentSampleCount = 0;
+	double currentInverseArea = 0;
+
+	const int32 highBinIndex = histogram.GetNumBins()-1;
+	const int32 lowBinIndex = histogram.CalcBinIndex(lowThreshold);
+	for (int32 i=lowBinIndex; i<=highBinIndex; ++i)
+	{
+		const uint32 binSize = histogram.GetBin(i);
+		const double highThreshold = histogram.GetBinMaxValue(i);
+		currentSampleCount += binSize;
+
+		if (areaTarget == false)
+		{
+			if (currentSampleCount >= scoreTargetSampleCount)
+			{
+				const uint32 numSamplesOvershoot = currentSampleCount - scoreTargetSampleCount;
+				const double correctionOffset = (binSize == 0 ? 0 : histogram.GetBinWidth() * ((double)numSamplesOvershoot / (double)binSize));
+				return highThreshold - correctionOffset;
+			}
+		}
+		else
+		{
+			const double height = (highThreshold - lowThreshold);
+			if (height == 0)
+				continue;
+
+			currentInverseArea += height * binSize;
+			const double totalArea = height * (double)numSamples;
+			const double nonVisitedInverseArea = height * (numSamples - currentSampleCount);
+			const double currentArea = totalArea - (currentInverseArea + nonVisitedInverseArea);
+			if (currentArea >= totalArea * target)
+				return highThreshold;
+		}
+	}
+
+	return histogram.GetBinMaxValue(highBinIndex);
+}
+
+
+// reference for Histogram::CalcLowThreshold(): walk the bins downwards from the high threshold
+static double ReferenceLowThreshold(const Histogram& histogram, double highThreshold, double target, bool areaTarget)
+{
+	if (histogram.GetNumValues() == 0)
+		return 0;
+
+	const uint32 numSamples = histogram.GetNumValues();
+	const uint32 scoreTargetSampleCount = numSamples * target;
+	uint32 currentSampleCount = 0;
+	double currentInverseArea = 0;
+
+	const int32 highBinIndex = histogram.CalcBinIndex(highThreshold);
+	const int32 lowBinIndex = 0;
+	for (int32 i=highBinIndex; i>=lowBinIndex; --i)
+	{
+		const uint32 binSize = histogram.GetBin(i);
+		const double lowThreshold = histogram.GetBinMinValue(i);
+		currentSampleCount += binSize;
+
+		if (areaTarget == false)
+		{
+			if (currentSampleCount >= scoreTargetSampleCount)
+			{
+				const uint32 numSamplesOvershoot = currentSampleCount - scoreTargetSampleCount;
+				const double correctionOffset = (binSize == 0 ? 0 : histogram.GetBinWidth() * ((double)numSamplesOvershoot / (double)binSize));
+				return lowThreshold + correctionOffset;
+			}
+		}
+		else
+		{
+			const double height = (highThreshold - lowThreshold);
+			if (height == 0)
+				continue;
+
+			currentInverseArea += height * binSize;
+			const double totalArea = height * (double)numSamples;
+			const double nonVisitedInverseArea = height * (numSamples - currentSampleCount);
+			const double currentArea = totalArea - (currentInverseArea + nonVisitedInverseArea);
+			if (currentArea >= totalArea * target)
+				return lowThreshold;
+		}
+	}
+
+	return histogram.GetBinMinValue(lowBinIndex);
+}
+
+
+// random value with a roughly normal distribution
+static double RandomHistogramValue(double center, double spread)
+{
+	double sum = 0.0;
+	for (uint32 i=0; i<4; ++i)
+		sum += (double)rand() / RAND_MAX;
+
+	return center + (sum - 2.0) * spread;
+}
+
+
+// compare the histogram threshold searches, bin queries and range extension against linear walks over the bins
+bool RunHistogramCheck(uint32 numBins, Json::Item& rootItem)
+{
+	const uint32 numValues = 10000;
+	const uint32 numQueries = 20000;
+
+	srand(42);
+	Array<double> values;
+	values.Resize(numValues);
+	for (uint32 i=0; i<numValues; ++i)
+		values[i] = RandomHistogramValue(0.2, 0.5);
+
+	Histogram histogram;
+	histogram.Init(numBins, -1.5, 1.5);
+	for (uint32 i=0; i<numValues; ++i)
+		histogram.AddValue(values[i]);
+
+	// slide the window: replace the first half of the values
+	for (uint32 i=0; i<numValues/2; ++i)
+	{
+		histogram.RemoveValue(values[i]);
+		values[i] = RandomHistogramValue(-0.1, 0.3);
+		histogram.AddValue(values[i]);
+	}
+
+	uint32 numErrors = 0;
+
+	// bin queries
+	uint32 lowBin = 0, highBin = 0, minCount = CORE_INVALIDINDEX32, maxCount = 0, cumulativeCount = 0;
+	double cumulativeWeightedCount = 0.0;
+	bool foundLowBin = false;
+	for (uint32 i=0; i<numBins; ++i)
+	{
+		const uint32 count = histogram.GetBin(i);
+		if (count > 0)
+		{
+			if (foundLowBin == false)
+				lowBin = i;
+			foundLowBin = true;
+			highBin = i;
+		}
+		minCount = Min(minCount, count);
+		maxCount = Max(maxCount, count);
+		cumulativeCount += count;
+		cumulativeWeightedCount += (double)i * count;
+		if (histogram.CalcCumulativeCount(i) != cumulativeCount || histogram.CalcCumulativeWeightedCount(i) != cumulativeWeightedCount)
+			++numErrors;
+	}
+	if (histogram.FindLowBin() != lowBin || histogram.FindHighBin() != highBin || histogram.CalcMinCount() != minCount || histogram.CalcMaxCount() != maxCount)
+		++numErrors;
+
+	// threshold searches: random thresholds inside and outside of the range, also exactly on the bin edges
+	Array<double> thresholds;
+	Array<double> targets;
+	thresholds.Resize(numQueries);
+	targets.Resize(numQueries);
+	for (uint32 i=0; i<numQueries; ++i)
+	{
+		thresholds[i] = (i % 4 == 0 ? histogram.GetBinMinValue(rand() % numBins) : ((double)rand() / RAND_MAX * 4.0 - 2.0));
+		targets[i] = (i % 50 == 0 ? (double)(i % 3) * 0.5 : (double)rand() / RAND_MAX);
+	}
+
+	Array<double> referenceResults;
+	Array<double> results;
+	referenceResults.Resize(numQueries * 4);
+	results.Resize(numQueries * 4);
+
+	Timer timer;
+	timer.GetTimeDelta();
+	for (uint32 i=0; i<numQueries; ++i)
+	{
+		referenceResults[4*i+0] = ReferenceHighThreshold(histogram, thresholds[i], targets[i], false);
+		referenceResults[4*i+1] = ReferenceHighThreshold(histogram, thresholds[i], targets[i], true);
+		referenceResults[4*i+2] = ReferenceLowThreshold(histogram, thresholds[i], targets[i], false);
+		referenceResults[4*i+3] = ReferenceLowThreshold(histogram, thresholds[i], targets[i], true);
+	}
+	const double referenceTime = timer.GetTimeDelta().InSeconds();
+
+	for (uint32 i=0; i<numQueries; ++i)
+	{
+		results[4*i+0] = histogram.CalcHighThreshold(thresholds[i], targets[i], false);
+		results[4*i+1] = histogram.CalcHighThreshold(thresholds[i], targets[i], true);
+		results[4*i+2] = histogram.CalcLowThreshold(thresholds[i], targets[i], false);
+		results[4*i+3] = histogram.CalcLowThreshold(thresholds[i], targets[i], true);
+	}
+	const double treeTime = timer.GetTimeDelta().InSeconds();
+
+	// Note: with a zero target the area of the first bin equals the target area, the linear walk decides that tie by rounding
+	double maxError = 0.0;
+	for (uint32 i=0; i<numQueries*4; ++i)
+	{
+		const bool areaTarget = (i % 2 == 1);
+		if (areaTarget == true && targets[i/4] == 0.0)
+			continue;
+
+		const double error = Math::AbsD(results[i] - referenceResults[i]);
+		maxError = Max(maxError, error);
+		if (error > histogram.GetBinWidth() * 1e-9)
+			++numErrors;
+	}
+
+	// range extension: the merged bins must equal a histogram that was filled with the new range directly, and removing all values must empty it
+	Histogram extended;
+	extended.Init(numBins, -1.0, 1.0);
+	for (uint32 i=0; i<numValues; ++i)
+		extended.AddValue(Clamp(values[i], -0.9, 0.9));
+
+	uint32 numExtendErrors = 0;
+	if (extended.ExtendRange(-3.0, 2.5) == false || extended.GetMinValue() > -3.0 || extended.GetMaxValue() < 2.5)
+		++numExtendErrors;
+
+	Histogram direct;
+	direct.Init(numBins, extended.GetMinValue(), extended.GetMaxValue());
+	for (uint32 i=0; i<numValues; ++i)
+		direct.AddValue(Clamp(values[i], -0.9, 0.9));
+
+	for (uint32 i=0; i<numBins; ++i)
+		if (extended.GetBin(i) != direct.GetBin(i))
+			++numExtendErrors;
+
+	for (uint32 i=0; i<numValues; ++i)
+		extended.RemoveValue(Clamp(values[i], -0.9, 0.9));
+	if (extended.GetNumValues() != 0 || extended.CalcMaxCount() != 0)
+		++numExtendErrors;
+
+	// sliding window over values on the bin edges and the range limits while the range keeps growing: every value has to be removed from the bin it was added to
+	Histogram sliding;
+	sliding.Init(numBins, -1.0, 1.0);
+	Array<double> window;
+	uint32 windowStart = 0;
+	const uint32 windowSize = 4 * numBins;
+	for (uint32 i=0; i<numValues; ++i)
+	{
+		double value;
+		switch (rand() % 8)
+		{
+			case 0:		value = sliding.GetBinMinValue(rand() % numBins);								break;
+			case 1:		value = sliding.GetMaxValue();													break;
+			case 2:		value = sliding.GetMinValue();													break;
+			case 3:		value = (rand() % 2 == 0 ? sliding.GetMaxValue() + sliding.GetBinWidth() * (rand() % 3) : sliding.GetMinValue() - sliding.GetBinWidth() * (rand() % 3));	break;
+			default:	value = sliding.GetMinValue() + (double)rand() / RAND_MAX * (sliding.GetMaxValue() - sliding.GetMinValue());	break;
+		}
+
+		// like the auto threshold node: extend the range before adding values that are not covered
+		if (sliding.IsInRange(value) == false && sliding.ExtendRange(Min(value, sliding.GetMinValue()), Max(value, sliding.GetMaxValue())) == false)
+			break;
+
+		sliding.AddValue(value);
+		window.Add(value);
+
+		if (window.Size() - windowStart > windowSize)
+		{
+			if (sliding.GetBin(sliding.CalcBinIndex(window[windowStart])) == 0)
+				++numExtendErrors;
+
+			sliding.RemoveValue(window[windowStart]);
+			++windowStart;
+		}
+	}
+
+	for (uint32 i=windowStart; i<window.Size(); ++i)
+	{
+		if (sliding.GetBin(sliding.CalcBinIndex(window[i])) == 0)
+			++numExtendErrors;
+
+		sliding.RemoveValue(window[i]);
+	}
+	if (sliding.GetNumValues() != 0 || sliding.CalcMaxCount() != 0)
+		++numExtendErrors;
+
+	Json::Item histogramItem = rootItem.AddObject("histogram");
+	histogramItem.AddInt( "bins", numBins );
+	histogramItem.AddInt( "queries", numQueries * 4 );
+	histogramItem.AddDouble( "linearMicrosecondsPerQuery", referenceTime * 1e6 / (numQueries * 4) );
+	histogramItem.AddDouble( "treeMicrosecondsPerQuery", treeTime * 1e6 / (numQueries * 4) );
+	histogramItem.AddDouble( "maxError", maxError );
+	histogramItem.AddInt( "errors", numErrors );
+	histogramItem.AddInt( "extendRangeErrors", numExtendErrors );
+
+	if (numErrors > 0 || numExtendErrors > 0)
+	{
+		fprintf(stderr, "Histogram check failed: %u query errors, %u range extension errors\n", numErrors, numExtendErrors);
+		return false;
+	}
+
+	return true;
+}
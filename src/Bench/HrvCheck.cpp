@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "HrvCheck.h"
+#include <Engine/Core/Timer.h>
+#include <Engine/Core/Math.h>
+#include <Engine/DSP/Channel.h>
+#include <Engine/DSP/ChannelReader.h>
+#include <Engine/DSP/HrvTimeDomain.h>
+#include <Engine/DSP/HrvFrequencyDomain.h>
+#include <Engine/DSP/HrvSlidingWindow.h>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Core;
+
+
+// feed a synthetic RR series (0.1 Hz and 0.25 Hz modulation plus noise) through the batch epoch functions and the incremental sliding window and compare every output
+bool RunHrvCheck(uint32 numIntervals, Json::Item& rootItem)
+{
+	const uint32 numBeats = numIntervals * 10;
+	const uint32 numTimeDomainMethods = HrvTimeDomain::METHOD_LF;
+	const uint32 frequencyDomainStep = 10;		// the batch periodogram is O(N) per bin, only evaluate it for every 10th beat
+
+	srand(42);
+	Array<double> intervals;
+	intervals.Resize(numBeats);
+	double time = 0.0;
+	for (uint32 i=0; i<numBeats; ++i)
+	{
+		const double noise = ((double)rand() / RAND_MAX * 2.0 - 1.0) * 0.02;
+		intervals[i] = 0.85 + 0.05 * sin(Math::twoPiD * 0.1 * time) + 0.03 * sin(Math::twoPiD * 0.25 * time) + noise;
+		time += intervals[i];
+	}
+
+	// batch: one zero padded epoch reader per method on the same event channel
+	Channel<double> input;
+	Array<ChannelReader*> readers;
+	Array<Channel<double>*> outputs;
+	for (uint32 m=0; m<numTimeDomainMethods; ++m)
+	{
+		ChannelReader* reader = new ChannelReader(&input);
+		reader->SetEpochLength(numIntervals);
+		reader->SetEpochShift(1);
+		reader->SetEpochZeroPadding(true);
+		reader->Update();
+		readers.Add(reader);
+		outputs.Add(new Channel<double>());
+	}
+
+	HrvSlidingWindow timeDomainWindow;
+	timeDomainWindow.Init(numIntervals);
+	HrvSlidingWindow frequencyDomainWindow;
+	frequencyDomainWindow.SetFrequencyDomainEnabled(true);
+	frequencyDomainWindow.Init(numIntervals);
+
+	double maxErrors[HrvTimeDomain::NUM_TIME_DOMAIN_METHODS];
+	for (uint32 m=0; m<HrvTimeDomain::NUM_TIME_DOMAIN_METHODS; ++m)
+		maxErrors[m] = 0.0;
+
+	Array<double> window;
+	window.Resize(numIntervals);
+
+	Timer timer;
+	double batchTime = 0.0, incrementalTime = 0.0, batchFrequencyTime = 0.0, incrementalFrequencyTime = 0.0;
+	uint32 numFrequencyChecks = 0;
+
+	for (uint32 i=0; i<numBeats; ++i)
+	{
+		input.BeginAddSamples();
+		input.AddSample(intervals[i]);
+
+		timer.GetTimeDelta();
+		for (uint32 m=0; m<numTimeDomainMethods; ++m)
+		{
+			readers[m]->Update();
+			HrvTimeDomain::GetFunction((HrvTimeDomain::EMethod)m)(readers[m], outputs[m]);
+		}
+		batchTime += timer.GetTimeDelta().InSeconds();
+
+		timeDomainWindow.AddInterval(intervals[i]);
+		double values[HrvTimeDomain::NUM_TIME_DOMAIN_METHODS];
+		for (uint32 m=0; m<numTimeDomainMethods; ++m)
+			values[m] = timeDomainWindow.GetValue((HrvTimeDomain::EMethod)m);
+		incrementalTime += timer.GetTimeDelta().InSeconds();
+
+		for (uint32 m=0; m<numTimeDomainMethods; ++m)
+		{
+			// relative error (absolute for small values)
+			const double expected = outputs[m]->GetLastSample();
+			const double error = Math::AbsD(values[m] - expected) / Max(1.0, Math::AbsD(expected));
+			maxErrors[m] = Max(maxErrors[m], error);
+		}
+
+		frequencyDomainWindow.AddInterval(intervals[i]);
+		double lf, hf;
+		frequencyDomainWindow.CalcBandPowers(&lf, &hf);
+		incrementalFrequencyTime += timer.GetTimeDelta().InSeconds();
+
+		if (i % frequencyDomainStep != 0)
+			continue;
+
+		// zero padded window ending at the current beat
+		for (uint32 s=0; s<numIntervals; ++s)
+			window[s] = (i + s + 1 >= numIntervals ? intervals[i + s + 1 - numIntervals] : 0.0);
+
+		timer.GetTimeDelta();
+		double batchLF, batchHF;
+		HrvFrequencyDomain::CalcBandPowers(window.GetPtr(), numIntervals, &batchLF, &batchHF);
+		batchFrequencyTime += timer.GetTimeDelta().InSeconds();
+		numFrequencyChecks++;
+
+		const double ratio = HrvFrequencyDomain::CalcRatio(lf, hf);
+		const double batchRatio = HrvFrequencyDomain::CalcRatio(batchLF, batchHF);
+		maxErrors[HrvTimeDomain::METHOD_LF] = Max(maxErrors[HrvTimeDomain::METHOD_LF], Math::AbsD(lf - batchLF) / Max(1.0, batchLF));
+		maxErrors[HrvTimeDomain::METHOD_HF] = Max(maxErrors[HrvTimeDomain::METHOD_HF], Math::AbsD(hf - batchHF) / Max(1.0, batchHF));
+		maxErrors[HrvTimeDomain::METHOD_LFHF] = Max(maxErrors[HrvTimeDomain::METHOD_LFHF], Math::AbsD(ratio - batchRatio) / Max(1.0, batchRatio));
+	}
+
+	Json::Item hrvItem = rootItem.AddObject("hrv");
+	hrvItem.AddInt( "intervals", numIntervals );
+	hrvItem.AddInt( "beats", numBeats );
+	hrvItem.AddDouble( "batchMicrosecondsPerBeat", batchTime * 1e6 / numBeats );
+	hrvItem.AddDouble( "incrementalMicrosecondsPerBeat", incrementalTime * 1e6 / numBeats );
+	hrvItem.AddDouble( "batchFrequencyDomainMicrosecondsPerBeat", batchFrequencyTime * 1e6 / Max<uint32>(1, numFrequencyChecks) );
+	hrvItem.AddDouble( "incrementalFrequencyDomainMicrosecondsPerBeat", incrementalFrequencyTime * 1e6 / numBeats );
+
+	// SDSD of the batch functions is calculated with a float square root
+	bool result = true;
+	Json::Item errorsItem = hrvItem.AddObject("maxRelativeErrors");
+	for (uint32 m=0; m<HrvTimeDomain::NUM_TIME_DOMAIN_METHODS; ++m)
+	{
+		const HrvTimeDomain::EMethod method = (HrvTimeDomain::EMethod)m;
+		errorsItem.AddDouble( HrvTimeDomain::GetName(method), maxErrors[m] );
+
+		const double tolerance = (method == HrvTimeDomain::METHOD_SDSD ? 1e-6 : 1e-8);
+		if (maxErrors[m] > tolerance)
+		{
+			fprintf(stderr, "Incremental HRV method '%s' differs from the batch result by %g\n", HrvTimeDomain::GetName(method), maxErrors[m]);
+			result = false;
+		}
+	}
+
+	for (uint32 m=0; m<numTimeDomainMethods; ++m)
+	{
+		delete readers[m];
+		delete outputs[m];
+	}
+
+	return result;
+}
@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "LoretaBench.h"
+#include "ClassifierRun.h"
+#include <Engine/EngineManager.h>
+#include <Engine/Core/Timer.h>
+#include <Engine/Core/Math.h>
+#include <Engine/Devices/Test/TestDevice.h>
+#include <Engine/Devices/Test/TestDeviceNode.h>
+#include <Engine/Graph/Classifier.h>
+#include <Engine/Graph/LoretaNode.h>
+#include <stdio.h>
+
+using namespace Core;
+
+// source estimates per second the node has to deliver
+#define LORETABENCH_UPDATE_RATE 10.0
+
+
+// run the LORETA node in simulated time and measure how many source estimates per wall clock second it calculates
+bool RunLoretaBench(const BenchConfig& config, Json::Item& rootItem)
+{
+	EngineManager* engine = GetEngine();
+
+	Classifier* classifier = new Classifier();
+	classifier->SetName("LORETA");
+
+	Node* deviceNode = AddNode( classifier, TestDeviceNode::Uuid(), "Test Device" );
+	Node* loretaNode = AddNode( classifier, LoretaNode::Uuid(), "LORETA" );
+	if (deviceNode == NULL || loretaNode == NULL)
+	{
+		delete classifier;
+		return false;
+	}
+
+	loretaNode->SetFloatAttribute( "updateRate", LORETABENCH_UPDATE_RATE );
+	loretaNode->SetInt32Attribute( "gridResolution", (int32)config.mLoretaGridResolution );
+	loretaNode->OnAttributesChanged();
+	classifier->AddConnection( deviceNode, 0, loretaNode, LoretaNode::INPUTPORT );
+	classifier->CollectNodes();
+
+	if (engine->LoadGraph(classifier) == false)
+		return false;
+
+	engine->Reset();
+
+	const double	tickDelta	= 1.0 / config.mTickRate;
+	const uint32	numTicks	= (uint32)(config.mSeconds * config.mTickRate + 0.5);
+	LoretaNode*		node		= static_cast<LoretaNode*>(loretaNode);
+
+	// the node builds the inverse solution when it starts, which takes much longer than an estimate: time the ticks until then separately
+	Timer timer;
+	timer.GetTimeDelta();
+	uint32 numSetupTicks = 0;
+	while (numSetupTicks < numTicks && node->GetSolver().IsInitialized() == false)
+	{
+		engine->Update( tickDelta );
+		numSetupTicks++;
+	}
+	const double setupSeconds = timer.GetTimeDelta().InSeconds();
+
+	const ChannelBase* output = node->GetOutputPort(LoretaNode::OUTPUTPORT).GetChannels()->GetChannel(0);
+	const uint64 startEstimates = (output != NULL ? output->GetSampleCounter() : 0);
+
+	timer.GetTimeDelta();
+	for (uint32 i=numSetupTicks; i<numTicks; ++i)
+		engine->Update( tickDelta );
+	const double wallSeconds = timer.GetTimeDelta().InSeconds();
+
+	const uint32 numElectrodes	= node->GetSolver().GetNumElectrodes();
+	const uint32 numVoxels		= node->GetSolver().GetNumVoxels();
+	const uint32 numEstimates	= (output != NULL ? (uint32)(output->GetSampleCounter() - startEstimates) : 0);
+	const double simulatedSeconds = (numTicks - numSetupTicks) * tickDelta;
+	const double estimatesPerSecond = (wallSeconds > 0.0 ? numEstimates / wallSeconds : 0.0);
+
+	engine->UnloadGraph(classifier);
+
+	Json::Item loretaItem = rootItem.AddObject("loreta");
+	loretaItem.AddInt( "electrodes", numElectrodes );
+	loretaItem.AddInt( "voxels", numVoxels );
+	loretaItem.AddInt( "gridResolution", config.mLoretaGridResolution );
+	loretaItem.AddDouble( "setupSeconds", setupSeconds );
+	loretaItem.AddDouble( "simulatedSeconds", simulatedSeconds );
+	loretaItem.AddDouble( "wallSeconds", wallSeconds );
+	loretaItem.AddInt( "estimates", numEstimates );
+	loretaItem.AddDouble( "microsecondsPerEstimate", numEstimates > 0 ? wallSeconds / numEstimates * 1e6 : 0.0 );
+	loretaItem.AddDouble( "estimatesPerSecond", estimatesPerSecond );
+	loretaItem.AddDouble( "targetEstimatesPerSecond", LORETABENCH_UPDATE_RATE );
+	loretaItem.AddBool( "realtime", estimatesPerSecond >= LORETABENCH_UPDATE_RATE );
+
+	if (numVoxels == 0 || numEstimates == 0)
+	{
+		fprintf(stderr, "The LORETA node did not calculate any source estimates (%u electrodes, %u voxels)\n", numElectrodes, numVoxels);
+		return false;
+	}
+
+	if (estimatesPerSecond < LORETABENCH_UPDATE_RATE)
+		fprintf(stderr, "The LORETA node calculates %.1f source estimates per second, below the target of %.0f\n", estimatesPerSecond, LORETABENCH_UPDATE_RATE);
+
+	return true;
+}
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "MathChain.h"
+#include "ClassifierRun.h"
+#include <Engine/EngineManager.h>
+#include <Engine/Core/Math.h>
+#include <Engine/Graph/Classifier.h>
+#include <Engine/Graph/SignalGeneratorNode.h>
+#include <Engine/Graph/Math2Node.h>
+#include <Engine/Graph/ExpressionNode.h>
+#include <Engine/Graph/CustomFeedbackNode.h>
+#include <stdio.h>
+
+using namespace Core;
+
+
+// add a chain of Math2 nodes behind the generators and return the equivalent formula over a and b
+//  the chain alternates x*0.99, x+0.5 and every fifth node adds the second generator; without a classifier only the formula is built
+static void AddMathChain(Classifier* classifier, Node* generatorA, Node* generatorB, uint32 length, String* outFormula)
+{
+	String name;
+	String formula = "a";
+	Node* lastNode = generatorA;
+	uint32 lastPort = 0;
+	for (uint32 i=0; i<length; ++i)
+	{
+		String term;
+		int32 mathFunction;
+		double staticValue = 0.0;
+		if (i % 5 == 4)
+		{
+			mathFunction = 0;		// add
+			term.Format("(%s + b)", formula.AsChar());
+		}
+		else if (i % 2 == 0)
+		{
+			mathFunction = 2;		// multiply
+			staticValue = 0.99;
+			term.Format("(%s * 0.99)", formula.AsChar());
+		}
+		else
+		{
+			mathFunction = 0;		// add
+			staticValue = 0.5;
+			term.Format("(%s + 0.5)", formula.AsChar());
+		}
+		formula = term;
+
+		if (classifier == NULL)
+			continue;
+
+		Node* mathNode = AddNode( classifier, Math2Node::Uuid(), name.Format("Math %i", i) );
+		mathNode->SetInt32Attribute( "mathFunction", mathFunction );
+		mathNode->SetFloatAttribute( "staticValue", staticValue );
+		mathNode->OnAttributesChanged();
+
+		classifier->AddConnection( lastNode, lastPort, mathNode, Math2Node::INPUTPORT_X );
+		if (i % 5 == 4)
+			classifier->AddConnection( generatorB, 0, mathNode, Math2Node::INPUTPORT_Y );
+
+		lastNode = mathNode;
+		lastPort = Math2Node::OUTPUTPORT_RESULT;
+	}
+
+	if (classifier != NULL)
+	{
+		Node* feedbackNode = AddNode( classifier, CustomFeedbackNode::Uuid(), "Chain Feedback" );
+		classifier->AddConnection( lastNode, lastPort, feedbackNode, CustomFeedbackNode::INPUTPORT_VALUE );
+	}
+
+	*outFormula = formula;
+}
+
+
+// add an expression node with the formula behind the generators
+static void AddExpression(Classifier* classifier, Node* generatorA, Node* generatorB, const String& formula)
+{
+	Node* expressionNode = AddNode( classifier, ExpressionNode::Uuid(), "Expression" );
+	expressionNode->SetStringAttribute( "expression", formula.AsChar() );
+	expressionNode->OnAttributesChanged();
+	classifier->AddConnection( generatorA, 0, expressionNode, ExpressionNode::INPUTPORT_A );
+	classifier->AddConnection( generatorB, 0, expressionNode, ExpressionNode::INPUTPORT_B );
+
+	Node* feedbackNode = AddNode( classifier, CustomFeedbackNode::Uuid(), "Expression Feedback" );
+	classifier->AddConnection( expressionNode, ExpressionNode::OUTPUTPORT_RESULT, feedbackNode, CustomFeedbackNode::INPUTPORT_VALUE );
+}
+
+
+// math chain benchmark classifier: the Math2 chain, the expression node or both on the same generators
+static Classifier* CreateMathChainClassifier(const BenchConfig& config, const char* name, bool addChain, bool addExpression)
+{
+	Classifier* classifier = new Classifier();
+	classifier->SetName(name);
+
+	Node* generatorA = AddNode( classifier, SignalGeneratorNode::Uuid(), "Generator A" );
+	Node* generatorB = AddNode( classifier, SignalGeneratorNode::Uuid(), "Generator B" );
+	generatorA->SetFloatAttribute( "sampleRate", config.mSampleRate );
+	generatorA->SetFloatAttribute( "frequency", 3.0 );
+	generatorB->SetFloatAttribute( "sampleRate", config.mSampleRate );
+	generatorB->SetFloatAttribute( "frequency", 7.0 );
+
+	// the formula is generated along with the chain
+	String formula;
+	AddMathChain( addChain == true ? classifier : NULL, generatorA, generatorB, config.mMathChainLength, &formula );
+
+	if (addExpression == true)
+		AddExpression( classifier, generatorA, generatorB, formula );
+
+	classifier->CollectNodes();
+	return classifier;
+}
+
+
+// time the Math2 chain and the expression node separately, then run both on the same generators: they must end up with the same feedback value
+bool RunMathChain(const BenchConfig& config, Json::Item& rootItem, Json::Item& runsItem)
+{
+	if (RunClassifier(CreateMathChainClassifier(config, "Math Chain", true, false), config, runsItem) == false ||
+		RunClassifier(CreateMathChainClassifier(config, "Expression", false, true), config, runsItem) == false)
+		return false;
+
+	Array<double> values;
+	if (RunClassifier(CreateMathChainClassifier(config, "Math Chain + Expression", true, true), config, runsItem, &values) == false)
+		return false;
+
+	const double chainValue = (values.Size() == 2 ? values[0] : 0.0);
+	const double expressionValue = (values.Size() == 2 ? values[1] : 0.0);
+	const bool isEqual = (values.Size() == 2 && Math::AbsD(chainValue - expressionValue) <= 1e-9 * Max(1.0, Math::AbsD(chainValue)));
+
+	Json::Item chainItem = rootItem.AddObject("mathChain");
+	chainItem.AddInt( "length", config.mMathChainLength );
+	chainItem.AddDouble( "chainValue", chainValue );
+	chainItem.AddDouble( "expressionValue", expressionValue );
+	chainItem.AddBool( "equal", isEqual );
+
+	if (isEqual == false)
+		fprintf(stderr, "Math chain and expression node disagree: %.17g vs %.17g\n", chainValue, expressionValue);
+
+	return isEqual;
+}
@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "NmdCodec.h"
+#include <Engine/Core/Timer.h>
+#include <Engine/NmdCompressor.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace Core;
+
+
+// compress and decompress a session file, check that the samples survive bit-exact
+bool RunNmdCodec(const char* filename, Json::Item& filesItem)
+{
+	Array<float> samples;
+	if (NmdCompressor::LoadFromDisk(filename, samples) == false)
+	{
+		fprintf(stderr, "Failed to load '%s'\n", filename);
+		return false;
+	}
+
+	const uint32 numSamples = samples.Size();
+	Timer timer;
+
+	Array<uint8> compressed;
+	timer.GetTimeDelta();
+	const bool compressResult = NmdCompressor::Compress(samples.GetReadPtr(), numSamples, compressed);
+	const double compressSeconds = timer.GetTimeDelta().InSeconds();
+
+	Array<float> decompressed;
+	timer.GetTimeDelta();
+	const bool decompressResult = NmdCompressor::Decompress(compressed.GetReadPtr(), compressed.Size(), decompressed);
+	const double decompressSeconds = timer.GetTimeDelta().InSeconds();
+
+	// compare the bit patterns (NaNs included)
+	const bool roundTrip = (compressResult == true && decompressResult == true && decompressed.Size() == numSamples && (numSamples == 0 || memcmp(decompressed.GetReadPtr(), samples.GetReadPtr(), numSamples * sizeof(float)) == 0));
+
+	const double rawBytes = sizeof(uint32) + numSamples * (double)sizeof(float);
+	const double megaBytes = numSamples * sizeof(float) / (1024.0 * 1024.0);
+
+	Json::Item fileItem = filesItem.AddObject();
+	fileItem.AddString( "file", filename );
+	fileItem.AddInt( "samples", numSamples );
+	fileItem.AddDouble( "rawBytes", rawBytes );
+	fileItem.AddDouble( "compressedBytes", compressed.Size() );
+	fileItem.AddDouble( "ratio", compressed.IsEmpty() == false ? rawBytes / compressed.Size() : 0.0 );
+	fileItem.AddDouble( "compressMBPerSecond", compressSeconds > 0.0 ? megaBytes / compressSeconds : 0.0 );
+	fileItem.AddDouble( "decompressMBPerSecond", decompressSeconds > 0.0 ? megaBytes / decompressSeconds : 0.0 );
+	fileItem.AddBool( "roundTrip", roundTrip );
+
+	if (roundTrip == false)
+		fprintf(stderr, "Round-trip mismatch for '%s'\n", filename);
+
+	return roundTrip;
+}
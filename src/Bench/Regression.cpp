@@ -0,0 +1,471 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "Regression.h"
+#include <Engine/EngineManager.h>
+#include <Engine/Core/Timer.h>
+#include <Engine/Core/Math.h>
+#include <Engine/SensorRecording.h>
+#include <Engine/Devices/Test/ReplayDevice.h>
+#include <Engine/Graph/Classifier.h>
+#include <Engine/Graph/StateMachine.h>
+#include <Engine/Graph/State.h>
+#include <Engine/Graph/GraphImporter.h>
+#include <Engine/Graph/FeedbackNode.h>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <string.h>
+
+using namespace Core;
+
+
+// outputs of a replayed classifier and state machine, tick after tick
+struct RegressionOutput
+{
+	String			mName;
+	Array<double>	mValues;
+};
+
+struct RegressionTrace
+{
+	uint32					mNumTicks;
+	Array<RegressionOutput>	mOutputs;			// feedback node outputs (NaN before an output appeared)
+	Array<String>			mStates;			// active states per tick (empty without state machine)
+};
+
+
+// file of a regression case next to its recording (corpus/protocol.nmr -> corpus/protocol.golden.json)
+static String GetCaseFilename(const char* recordingFilename, const char* extension)
+{
+	std::filesystem::path path(recordingFilename);
+	path.replace_extension(extension);
+	return path.string().c_str();
+}
+
+
+// append the values of all feedback outputs and the active states of the current tick
+static void AddTraceTick(Classifier* classifier, StateMachine* stateMachine, RegressionTrace& trace)
+{
+	const uint32 tickIndex = trace.mNumTicks++;
+	String name;
+
+	const uint32 numFeedbackNodes = classifier->GetNumFeedbackNodes();
+	for (uint32 i=0; i<numFeedbackNodes; ++i)
+	{
+		FeedbackNode* node = classifier->GetFeedbackNode(i);
+
+		const uint32 numValues = Max<uint32>( 1, node->GetNumCurrentValues() );
+		for (uint32 c=0; c<numValues; ++c)
+		{
+			if (c == 0)
+				name = node->GetName();
+			else
+				name.Format("%s[%i]", node->GetName(), c);
+
+			// outputs that appear later (e.g. more channels) are NaN before
+			uint32 outputIndex = CORE_INVALIDINDEX32;
+			for (uint32 j=0; j<trace.mOutputs.Size() && outputIndex == CORE_INVALIDINDEX32; ++j)
+				if (trace.mOutputs[j].mName == name)
+					outputIndex = j;
+
+			if (outputIndex == CORE_INVALIDINDEX32)
+			{
+				outputIndex = trace.mOutputs.Size();
+				trace.mOutputs.AddEmpty();
+				trace.mOutputs[outputIndex].mName = name;
+			}
+
+			Array<double>& values = trace.mOutputs[outputIndex].mValues;
+			while (values.Size() < tickIndex)
+				values.Add( std::numeric_limits<double>::quiet_NaN() );
+			values.Add( node->GetCurrentValue(c) );
+		}
+	}
+
+	if (stateMachine != NULL)
+	{
+		String states;
+		const uint32 numActiveStates = stateMachine->GetNumActiveStates();
+		for (uint32 i=0; i<numActiveStates; ++i)
+		{
+			if (i > 0)
+				states += ", ";
+			states += stateMachine->GetActiveState(i)->GetName();
+		}
+
+		trace.mStates.Add(states);
+	}
+}
+
+
+// json has no NaN and infinity, they are stored as strings
+static void AddTraceValue(Json::Item& arrayItem, double value)
+{
+	if (std::isnan(value) == true)
+		arrayItem.AddString("nan");
+	else if (std::isinf(value) == true)
+		arrayItem.AddString(value > 0.0 ? "inf" : "-inf");
+	else
+		arrayItem.AddDouble(value);
+}
+
+static double GetTraceValue(const Json::Item& item)
+{
+	if (item.IsNumber() == true)
+		return item.GetDouble();
+
+	if (item.IsString() == true && strcmp(item.GetString(), "inf") == 0)
+		return std::numeric_limits<double>::infinity();
+	if (item.IsString() == true && strcmp(item.GetString(), "-inf") == 0)
+		return -std::numeric_limits<double>::infinity();
+
+	return std::numeric_limits<double>::quiet_NaN();
+}
+
+
+static bool WriteGolden(const char* filename, const char* recordingFilename, Classifier* classifier, StateMachine* stateMachine, double tickRate, const RegressionTrace& trace)
+{
+	Json json;
+	Json::Item rootItem = json.GetRootItem();
+	rootItem.AddString( "recording", std::filesystem::path(recordingFilename).filename().string().c_str() );
+	rootItem.AddString( "classifier", classifier->GetName() );
+	if (stateMachine != NULL)
+		rootItem.AddString( "stateMachine", stateMachine->GetName() );
+	rootItem.AddDouble( "fps", tickRate );
+	rootItem.AddInt( "ticks", trace.mNumTicks );
+
+	Json::Item outputsItem = rootItem.AddArray("outputs");
+	const uint32 numOutputs = trace.mOutputs.Size();
+	for (uint32 i=0; i<numOutputs; ++i)
+	{
+		Json::Item outputItem = outputsItem.AddObject();
+		outputItem.AddString( "name", trace.mOutputs[i].mName.AsChar() );
+
+		Json::Item valuesItem = outputItem.AddArray("values");
+		const uint32 numValues = trace.mOutputs[i].mValues.Size();
+		for (uint32 j=0; j<numValues; ++j)
+			AddTraceValue( valuesItem, trace.mOutputs[i].mValues[j] );
+	}
+
+	if (stateMachine != NULL)
+	{
+		Json::Item statesItem = rootItem.AddArray("states");
+		const uint32 numStates = trace.mStates.Size();
+		for (uint32 i=0; i<numStates; ++i)
+			statesItem.AddString( trace.mStates[i].AsChar() );
+	}
+
+	return json.WriteToFile(filename, false);
+}
+
+
+// values match if both are NaN, equal infinities or within the absolute plus relative tolerance
+static bool IsTraceValueEqual(double expected, double actual, const BenchConfig& config)
+{
+	if (std::isnan(expected) == true || std::isnan(actual) == true)
+		return (std::isnan(expected) == std::isnan(actual));
+
+	if (std::isinf(expected) == true || std::isinf(actual) == true)
+		return (expected == actual);
+
+	return (Math::AbsD(actual - expected) <= config.mTolerance + config.mRelativeTolerance * Math::AbsD(expected));
+}
+
+
+// compare a trace against the golden results, the first mismatches go to the report
+static bool CompareTrace(const RegressionTrace& trace, Json& golden, const BenchConfig& config, Json::Item& caseItem)
+{
+	const uint32 maxReportedMismatches = 10;
+
+	uint32 numMismatches = 0;
+	uint32 numMismatchedStates = 0;
+	double maxDifference = 0.0;
+	Json::Item mismatchesItem = caseItem.AddArray("mismatches");
+
+	Json::Item ticksItem = golden.Find("ticks");
+	const uint32 numTicks = (ticksItem.IsInt() == true ? ticksItem.GetInt() : 0);
+	if (numTicks != trace.mNumTicks)
+	{
+		Json::Item mismatchItem = mismatchesItem.AddObject();
+		mismatchItem.AddString( "output", "ticks" );
+		mismatchItem.AddInt( "expected", numTicks );
+		mismatchItem.AddInt( "actual", trace.mNumTicks );
+		++numMismatches;
+	}
+
+	// outputs by name, the order of the feedback nodes does not matter
+	Array<bool> isCompared;
+	isCompared.Resize(trace.mOutputs.Size());
+	isCompared.SetAll(false);
+
+	Json::Item outputsItem = golden.Find("outputs");
+	const uint32 numGoldenOutputs = (outputsItem.IsArray() == true ? outputsItem.Size() : 0);
+	for (uint32 i=0; i<numGoldenOutputs; ++i)
+	{
+		Json::Item outputItem = outputsItem[i];
+		Json::Item nameItem = outputItem.Find("name");
+		Json::Item valuesItem = outputItem.Find("values");
+		const char* name = (nameItem.IsString() == true ? nameItem.GetString() : "");
+
+		const RegressionOutput* output = NULL;
+		for (uint32 j=0; j<trace.mOutputs.Size() && output == NULL; ++j)
+		{
+			if (trace.mOutputs[j].mName == name)
+			{
+				output = &trace.mOutputs[j];
+				isCompared[j] = true;
+			}
+		}
+
+		if (output == NULL || valuesItem.IsArray() == false)
+		{
+			if (numMismatches++ < maxReportedMismatches)
+			{
+				Json::Item mismatchItem = mismatchesItem.AddObject();
+				mismatchItem.AddString( "output", name );
+				mismatchItem.AddString( "error", "missing" );
+			}
+			continue;
+		}
+
+		// values after the end of the shorter trace are missing
+		const uint32 numValues = Max<uint32>( valuesItem.Size(), output->mValues.Size() );
+		for (uint32 j=0; j<numValues; ++j)
+		{
+			const double expected = (j < valuesItem.Size() ? GetTraceValue(valuesItem[j]) : std::numeric_limits<double>::quiet_NaN());
+			const double actual = (j < output->mValues.Size() ? output->mValues[j] : std::numeric_limits<double>::quiet_NaN());
+			if (std::isfinite(expected) == true && std::isfinite(actual) == true)
+				maxDifference = Max( maxDifference, Math::AbsD(actual - expected) );
+
+			if (j < valuesItem.Size() && j < output->mValues.Size() && IsTraceValueEqual(expected, actual, config) == true)
+				continue;
+
+			if (numMismatches++ < maxReportedMismatches)
+			{
+				Json::Item mismatchItem = mismatchesItem.AddObject();
+				mismatchItem.AddString( "output", name );
+				mismatchItem.AddInt( "tick", j );
+				Json::Item expectedItem = mismatchItem.AddArray("expected");
+				Json::Item actualItem = mismatchItem.AddArray("actual");
+				AddTraceValue( expectedItem, expected );
+				AddTraceValue( actualItem, actual );
+			}
+		}
+	}
+
+	// outputs the golden results do not know
+	for (uint32 i=0; i<trace.mOutputs.Size(); ++i)
+	{
+		if (isCompared[i] == true)
+			continue;
+
+		if (numMismatches++ < maxReportedMismatches)
+		{
+			Json::Item mismatchItem = mismatchesItem.AddObject();
+			mismatchItem.AddString( "output", trace.mOutputs[i].mName.AsChar() );
+			mismatchItem.AddString( "error", "unexpected" );
+		}
+	}
+
+	// active states
+	Json::Item statesItem = golden.Find("states");
+	const uint32 numGoldenStates = (statesItem.IsArray() == true ? statesItem.Size() : 0);
+	const uint32 numStates = Max<uint32>( numGoldenStates, trace.mStates.Size() );
+	for (uint32 i=0; i<numStates; ++i)
+	{
+		const char* expected = (i < numGoldenStates && statesItem[i].IsString() == true ? statesItem[i].GetString() : "");
+		const char* actual = (i < trace.mStates.Size() ? trace.mStates[i].AsChar() : "");
+		if (i < numGoldenStates && i < trace.mStates.Size() && strcmp(expected, actual) == 0)
+			continue;
+
+		if (numMismatchedStates++ == 0)
+		{
+			Json::Item mismatchItem = mismatchesItem.AddObject();
+			mismatchItem.AddString( "output", "states" );
+			mismatchItem.AddInt( "tick", i );
+			mismatchItem.AddString( "expected", expected );
+			mismatchItem.AddString( "actual", actual );
+		}
+	}
+
+	caseItem.AddDouble( "maxAbsoluteDifference", maxDifference );
+	caseItem.AddInt( "mismatchedValues", numMismatches );
+	caseItem.AddInt( "mismatchedStates", numMismatchedStates );
+
+	return (numMismatches == 0 && numMismatchedStates == 0);
+}
+
+
+// replay a recording and compare it against (or write) the golden results
+bool RunRegressionCase(const char* recordingFilename, const BenchConfig& config, Json::Item& casesItem)
+{
+	EngineManager* engine = GetEngine();
+	DeviceManager* deviceManager = GetDeviceManager();
+
+	const String classifierFilename		= GetCaseFilename(recordingFilename, ".json");
+	const String stateMachineFilename	= GetCaseFilename(recordingFilename, ".statemachine.json");
+	const String goldenFilename			= GetCaseFilename(recordingFilename, ".golden.json");
+
+	Json::Item caseItem = casesItem.AddObject();
+	caseItem.AddString( "recording", recordingFilename );
+
+	SensorRecording recording;
+	if (recording.LoadFromDisk(recordingFilename) == false)
+	{
+		fprintf(stderr, "Failed to load recording '%s'\n", recordingFilename);
+		caseItem.AddString( "status", "error" );
+		return false;
+	}
+
+	std::error_code error;
+	Json golden;
+	const bool compare = (config.mUpdateGolden == false && std::filesystem::exists(goldenFilename.AsChar(), error) == true);
+	if (compare == true && golden.ParseFile(goldenFilename.AsChar()) == false)
+	{
+		fprintf(stderr, "Failed to load golden results '%s'\n", goldenFilename.AsChar());
+		caseItem.AddString( "status", "error" );
+		return false;
+	}
+
+	double tickRate = config.mTickRate;
+	if (compare == true)
+	{
+		Json::Item fpsItem = golden.Find("fps");
+		if (fpsItem.IsNumber() == true && fpsItem.GetDouble() > 0.0)
+			tickRate = fpsItem.GetDouble();
+	}
+
+	Classifier* classifier = new Classifier();
+	if (GraphImporter::LoadFromFile(classifierFilename.AsChar(), classifier) == false)
+	{
+		fprintf(stderr, "Failed to load classifier '%s'\n", classifierFilename.AsChar());
+		caseItem.AddString( "status", "error" );
+		delete classifier;
+		return false;
+	}
+
+	// the engine keeps its graphs by uuid and headless there is no uuid generator, so the files identify the graphs (like the uuids the engine API gets)
+	if (classifier->GetNameString().IsEmpty() == true)
+		classifier->SetName(classifierFilename.AsChar());
+	if (classifier->GetUuidString().IsEmpty() == true)
+		classifier->SetUuid(classifierFilename.AsChar());
+	classifier->CollectNodes();
+
+	StateMachine* stateMachine = NULL;
+	if (std::filesystem::exists(stateMachineFilename.AsChar(), error) == true)
+	{
+		stateMachine = new StateMachine();
+		if (GraphImporter::LoadFromFile(stateMachineFilename.AsChar(), stateMachine) == false)
+		{
+			fprintf(stderr, "Failed to load state machine '%s'\n", stateMachineFilename.AsChar());
+			caseItem.AddString( "status", "error" );
+			delete stateMachine;
+			delete classifier;
+			return false;
+		}
+
+		if (stateMachine->GetNameString().IsEmpty() == true)
+			stateMachine->SetName(stateMachineFilename.AsChar());
+		if (stateMachine->GetUuidString().IsEmpty() == true)
+			stateMachine->SetUuid(stateMachineFilename.AsChar());
+		stateMachine->CollectStates();
+	}
+
+	caseItem.AddString( "classifier", classifier->GetName() );
+	if (stateMachine != NULL)
+		caseItem.AddString( "stateMachine", stateMachine->GetName() );
+
+	// the recorded devices replace the live ones
+	Array<Device*> devices;
+	SensorReplay::CreateDevices(&recording, devices);
+	const uint32 numDevices = devices.Size();
+	for (uint32 i=0; i<numDevices; ++i)
+		deviceManager->AddDevice(devices[i]);
+
+	engine->LoadGraph(classifier);
+	if (stateMachine != NULL)
+		engine->LoadGraph(stateMachine);
+
+	engine->Reset();
+	if (stateMachine != NULL)
+		stateMachine->Start();
+
+	// simulated time with the fixed tick schedule
+	const double tickDelta = 1.0 / tickRate;
+	const uint32 numTicks = (uint32)(recording.GetTime().InSeconds() * tickRate + 0.5);
+
+	RegressionTrace trace;
+	trace.mNumTicks = 0;
+
+	Timer timer;
+	timer.GetTimeDelta();
+	for (uint32 i=0; i<numTicks; ++i)
+	{
+		engine->Update( tickDelta );
+		AddTraceTick(classifier, stateMachine, trace);
+	}
+	const double wallSeconds = timer.GetTimeDelta().InSeconds();
+
+	// all outputs cover all ticks
+	const uint32 numOutputs = trace.mOutputs.Size();
+	for (uint32 i=0; i<numOutputs; ++i)
+		while (trace.mOutputs[i].mValues.Size() < trace.mNumTicks)
+			trace.mOutputs[i].mValues.Add( std::numeric_limits<double>::quiet_NaN() );
+
+	caseItem.AddDouble( "fps", tickRate );
+	caseItem.AddInt( "ticks", numTicks );
+	caseItem.AddInt( "outputs", numOutputs );
+	caseItem.AddDouble( "simulatedSeconds", numTicks * tickDelta );
+	caseItem.AddDouble( "wallSeconds", wallSeconds );
+
+	bool result = true;
+	if (compare == true)
+	{
+		result = CompareTrace(trace, golden, config, caseItem);
+		caseItem.AddString( "status", result == true ? "passed" : "failed" );
+		if (result == false)
+			fprintf(stderr, "Regression '%s' differs from '%s'\n", recordingFilename, goldenFilename.AsChar());
+	}
+	else
+	{
+		result = WriteGolden(goldenFilename.AsChar(), recordingFilename, classifier, stateMachine, tickRate, trace);
+		if (result == false)
+			caseItem.AddString( "status", "error" );
+		else
+			caseItem.AddString( "status", config.mUpdateGolden == true ? "updated" : "created" );
+		caseItem.AddString( "golden", goldenFilename.AsChar() );
+		if (result == false)
+			fprintf(stderr, "Failed to write golden results '%s'\n", goldenFilename.AsChar());
+	}
+
+	if (stateMachine != NULL)
+		engine->UnloadGraph(stateMachine);
+	engine->UnloadGraph(classifier);
+
+	for (uint32 i=0; i<numDevices; ++i)
+		deviceManager->RemoveDevice(devices[i]);
+
+	return result;
+}
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "SampleFormatCheck.h"
+#include <Engine/Core/Math.h>
+#include <Engine/DSP/Channel.h>
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Core;
+
+
+// largest value a scaled integer format can represent
+static double GetSampleFormatRange(ChannelBase::ESampleFormat format, double resolution)
+{
+	switch (format)
+	{
+		case ChannelBase::SAMPLEFORMAT_INT32:	return CORE_INT32_MAX * resolution;
+		case ChannelBase::SAMPLEFORMAT_INT16:	return CORE_INT16_MAX * resolution;
+		default:								return DBL_MAX;
+	}
+}
+
+
+// compare a decoded sample against the value that was added, returns false if the error exceeds the bound of the format
+static bool CheckSampleError(ChannelBase::ESampleFormat format, double resolution, double value, double decoded, double* inOutMaxError)
+{
+	if (std::isnan(value) == true)
+		return std::isnan(decoded);
+
+	// out of range values are clamped by the integer formats
+	const double range = GetSampleFormatRange(format, resolution);
+	const double expected = Clamp<double>(value, -range, range);
+	const double error = Math::AbsD(decoded - expected);
+	*inOutMaxError = Max(*inOutMaxError, error);
+
+	switch (format)
+	{
+		case ChannelBase::SAMPLEFORMAT_DOUBLE:	return (error == 0.0);
+		case ChannelBase::SAMPLEFORMAT_FLOAT:	return (error <= Math::AbsD(expected) * 5.9604644775390625e-8);		// 2^-24
+		default:								return (error <= resolution * 0.5 * (1.0 + 1e-9));
+	}
+}
+
+
+// fill buffer and storage channels of every sample format with random values and check them against the error bounds
+bool RunSampleFormatCheck(Json::Item& rootItem)
+{
+	const uint32 bufferSize = 1000;
+	const uint32 numSamples = 5000;
+	const double resolutions[ChannelBase::NUM_SAMPLEFORMATS] = { 1.0, 1.0, 1e-6, 1e-3 };
+
+	Json::Item formatsItem = rootItem.AddArray("sampleFormats");
+	bool result = true;
+
+	for (uint32 f=0; f<ChannelBase::NUM_SAMPLEFORMATS; ++f)
+	{
+		const ChannelBase::ESampleFormat format = (ChannelBase::ESampleFormat)f;
+		const double resolution = resolutions[f];
+		const double range = (format == ChannelBase::SAMPLEFORMAT_INT16 ? 40.0 : 1000.0);	// int16 values beyond 32.767 get clamped
+
+		// same random sequence for every format, with a NaN every 97 samples
+		srand(42);
+		Array<double> values;
+		values.Resize(numSamples);
+		for (uint32 i=0; i<numSamples; ++i)
+			values[i] = (i % 97 == 0 ? std::numeric_limits<double>::quiet_NaN() : ((double)rand() / RAND_MAX * 2.0 - 1.0) * range);
+
+		Channel<double> buffer(128, bufferSize);
+		Channel<double> storage;
+		Channel<double> converted;
+		buffer.SetSampleFormat(format, resolution);
+		storage.SetSampleFormat(format, resolution);
+
+		for (uint32 i=0; i<numSamples; ++i)
+		{
+			buffer.AddSample(values[i]);
+			storage.AddSample(values[i]);
+			converted.AddSample(values[i]);
+		}
+
+		// format change of a filled channel keeps the samples
+		converted.SetSampleFormat(format, resolution);
+
+		uint32 numErrors = 0;
+		double maxError = 0.0;
+		for (uint64 i=buffer.GetMinSampleIndex(); i<=buffer.GetMaxSampleIndex(); ++i)
+			if (CheckSampleError(format, resolution, values[i], buffer.GetSample(i), &maxError) == false)
+				++numErrors;
+
+		for (uint32 i=0; i<numSamples; ++i)
+		{
+			if (CheckSampleError(format, resolution, values[i], storage.GetSample(i), &maxError) == false)
+				++numErrors;
+			if (CheckSampleError(format, resolution, values[i], converted.GetSample(i), &maxError) == false)
+				++numErrors;
+		}
+
+		Json::Item formatItem = formatsItem.AddObject();
+		formatItem.AddString( "format", ChannelBase::GetSampleFormatName(format) );
+		formatItem.AddDouble( "resolution", resolution );
+		formatItem.AddDouble( "maxError", maxError );
+		formatItem.AddInt( "errors", numErrors );
+		formatItem.AddDouble( "bufferBytes", (double)buffer.CalculateMemoryAllocated() );
+		formatItem.AddDouble( "storageBytes", (double)storage.CalculateMemoryAllocated() );
+
+		if (numErrors > 0)
+		{
+			fprintf(stderr, "Sample format '%s' exceeds its error bound for %u samples\n", ChannelBase::GetSampleFormatName(format), numErrors);
+			result = false;
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "SnapshotStress.h"
+#include <Engine/Core/SeqLock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <stdio.h>
+
+using namespace Core;
+
+
+// one thread publishes feedback snapshots as fast as it can while reader threads verify that every snapshot they get belongs to a single publish
+bool RunSnapshotStress(double seconds, Json::Item& rootItem)
+{
+	const uint32 maxValues = 64;
+	const uint32 numReaders = 3;
+
+	SeqLockArray<double> snapshot;
+	std::atomic<bool> stop(false);
+	std::atomic<uint64> numReads(0);
+	std::atomic<uint64> numTorn(0);
+	uint64 numPublished = 0;
+
+	// publish n carries (n % maxValues) + 1 values, value i is n * maxValues + i and the timestamp is n
+	// the writer grows the capacity on demand, like the engine does when the number of feedbacks changes
+	std::thread writer([&]()
+	{
+		double values[maxValues];
+		while (stop.load(std::memory_order_relaxed) == false)
+		{
+			++numPublished;
+			const uint32 numValues = (numPublished % maxValues) + 1;
+			for (uint32 i=0; i<numValues; ++i)
+				values[i] = (double)(numPublished * maxValues + i);
+
+			snapshot.Reserve(numValues);
+			snapshot.Publish(values, numValues, (double)numPublished);
+		}
+	});
+
+	Array<std::thread*> readers;
+	for (uint32 r=0; r<numReaders; ++r)
+	{
+		readers.Add( new std::thread([&]()
+		{
+			double values[maxValues];
+			uint64 reads = 0;
+			uint64 torn = 0;
+			while (stop.load(std::memory_order_relaxed) == false)
+			{
+				double timestamp;
+				const uint32 numValues = snapshot.Read(values, maxValues, &timestamp);
+				++reads;
+
+				// nothing published yet
+				if (numValues == 0)
+					continue;
+
+				const uint64 n = (uint64)timestamp;
+				bool valid = (numValues == (n % maxValues) + 1);
+				for (uint32 i=0; i<numValues && valid==true; ++i)
+					valid = (values[i] == (double)(n * maxValues + i));
+
+				if (valid == false)
+					++torn;
+			}
+
+			numReads += reads;
+			numTorn += torn;
+		}) );
+	}
+
+	std::this_thread::sleep_for( std::chrono::duration<double>(seconds) );
+	stop = true;
+
+	writer.join();
+	for (uint32 r=0; r<numReaders; ++r)
+	{
+		readers[r]->join();
+		delete readers[r];
+	}
+
+	Json::Item stressItem = rootItem.AddObject("snapshotStress");
+	stressItem.AddDouble( "seconds", seconds );
+	stressItem.AddInt( "readers", numReaders );
+	stressItem.AddDouble( "publishes", (double)numPublished );
+	stressItem.AddDouble( "reads", (double)numReads.load() );
+	stressItem.AddDouble( "torn", (double)numTorn.load() );
+
+	if (numTorn.load() > 0)
+		fprintf(stderr, "Torn feedback snapshots: %llu of %llu reads\n", (unsigned long long)numTorn.load(), (unsigned long long)numReads.load());
+
+	return (numTorn.load() == 0 && numReads.load() > 0 && numPublished > 0);
+}
@@ -0,0 +1,669 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include <Engine/Config.h>
+#include <Engine/EngineManager.h>
+#include <Engine/Core/Json.h>
+#include <Engine/Devices/DeviceInventory.h>
+#include <Engine/Devices/Test/TestDevice.h>
+#include <Engine/Devices/Test/TestDeviceDriver.h>
+#include <Engine/Devices/Test/TestDeviceNode.h>
+#include <Engine/Devices/Test/LoadGeneratorDevice.h>
+#include <Engine/Devices/Test/LoadGeneratorDeviceNode.h>
+#include <Engine/Graph/Classifier.h>
+#include <Engine/Graph/GraphImporter.h>
+#include <Engine/Graph/SignalGeneratorNode.h>
+#include <Engine/Graph/FFTNode.h>
+#include <Engine/Graph/FrequencyBandNode.h>
+#include <Engine/Graph/BandPowerNode.h>
+#include <Engine/Graph/CustomFeedbackNode.h>
+#include <Engine/Graph/Math2Node.h>
+#include <Engine/Graph/StatisticsNode.h>
+#include <Engine/Graph/ViewNode.h>
+#include <Engine/Graph/AutoThresholdNode.h>
+#include "BenchConfig.h"
+#include "ClassifierRun.h"
+#include "NmdCodec.h"
+#include "SnapshotStress.h"
+#include "SampleFormatCheck.h"
+#include "MathChain.h"
+#include "BandPowerCheck.h"
+#include "HrvCheck.h"
+#include "HistogramCheck.h"
+#include "LoretaBench.h"
+#include "Regression.h"
+#include <filesystem>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Core;
+
+// headless engine benchmark
+// runs classifiers against synthetic input in simulated time (no wall-clock pacing) and reports tick latency, throughput, memory and per-node cost as json
+// the checks of the other modes live in their own files
+
+
+// print usage
+static void PrintUsage()
+{
+	printf("Usage: Bench [options] [classifier.json|directory ...]\n");
+	printf("  --channels N      number of test device channels (default 8, the test device has one electrode per channel)\n");
+	printf("  --samplerate R    test device and signal generator sample rate in Hz (default 128)\n");
+	printf("  --generators N    number of signal generator chains in the synthetic classifier (default 0)\n");
+	printf("  --seconds S       simulated time per classifier (default 60)\n");
+	printf("  --fps F           engine update rate in Hz (default 60)\n");
+	printf("  --no-profile      do not record per-node cost\n");
+	printf("  --bandpower       use the band power node instead of FFT -> frequency band in the synthetic classifier\n");
+	printf("  --bandpower-check compare the band power node against FFT -> frequency band (amplitude and power) on the same generator\n");
+	printf("  --output FILE     write the json report to FILE instead of stdout\n");
+	printf("  --nmd PATH        compression round-trip and throughput of a .nmd session file or of all .nmd files in a directory\n");
+	printf("  --snapshot-stress S  publish feedback snapshots while reader threads check them for torn reads for S seconds\n");
+	printf("  --sample-format F    storage format of the node output buffers: double, float, int32 or int16 (default double)\n");
+	printf("  --sample-resolution R  value of one integer step for the int32 and int16 formats (default 1)\n");
+	printf("  --sample-formats     check the error bounds and memory use of all channel sample formats\n");
+	printf("  --math-chain N       compare a chain of N Math2 nodes against the same formula in one expression node\n");
+	printf("  --slow-branches N    add N 4 s epoch statistics -> Math2 chains behind the test device to the synthetic classifier\n");
+	printf("  --no-idle-skip       update every processor on every tick, even if it cannot produce output\n");
+	printf("  --debug-views N      add N FFT -> view debug branches behind the test device to the synthetic classifier\n");
+	printf("  --demand             suspend nodes without a consumed sink; a signal view is opened after a quarter of each run, a spectrum view halfway through\n");
+	printf("  --hrv N              compare the incremental HRV metrics over N RR intervals against the batch epoch functions\n");
+	printf("  --histogram N        compare the histogram threshold searches with N bins against a linear walk over the bins\n");
+	printf("  --loreta N           LORETA source estimates per second on all test device channels (e.g. --channels 64) with N voxels along the brain diameter (24, the node default, gives a few thousand voxels)\n");
+	printf("  --auto-threshold N   add an auto threshold node with N bins per test device channel to the synthetic classifier\n");
+	printf("  --load-generator     use the load generator device instead of the test device (any channel count and sample rate)\n");
+	printf("  --seed N             load generator seed (default 1)\n");
+	printf("  --artifacts R        load generator artifacts per second (default 0)\n");
+	printf("  --dropouts R         load generator dropouts per second, the dropped samples are reported as lost (default 0)\n");
+	printf("  --jitter S           load generator maximum delivery delay in seconds (default 0)\n");
+	printf("  --devices N          number of input devices, the classifier reads the first one (default 1)\n");
+	printf("  --slow-device MS     every acquisition of the last load generator blocks for MS milliseconds, like a slow driver\n");
+	printf("  --acquisition-threads  acquire every device on its own thread (default: in sequence during the update, reproducible)\n");
+	printf("  --record FILE        record the device input of the run (a single classifier) to FILE, e.g. corpus/protocol.nmr\n");
+	printf("  --regress PATH       replay a recording or all .nmr recordings in a directory through the classifier next to it (protocol.json,\n");
+	printf("                       optionally protocol.statemachine.json) and compare all outputs against protocol.golden.json (written if missing)\n");
+	printf("  --update-golden      rewrite the golden results of the replayed recordings instead of comparing\n");
+	printf("  --tolerance A        absolute tolerance of the golden comparison (default 1e-12)\n");
+	printf("  --relative-tolerance R  relative tolerance of the golden comparison (default 1e-9)\n");
+	printf("Without classifiers a synthetic FFT -> frequency band -> feedback classifier (or band power -> feedback with --bandpower) is benchmarked.\n");
+	printf("--nmd, --snapshot-stress, --sample-formats, --math-chain, --bandpower-check, --hrv, --histogram, --loreta and --regress select another mode instead, only one per run.\n");
+}
+
+
+// select the mode of the run, fails if another mode was selected already (repeating the same mode is fine, e.g. several --nmd paths)
+static bool SelectMode(BenchConfig& config, EBenchMode mode)
+{
+	if (config.mMode != BENCHMODE_CLASSIFIERS && config.mMode != mode)
+	{
+		fprintf(stderr, "Only one mode per run\n");
+		return false;
+	}
+
+	config.mMode = mode;
+	return true;
+}
+
+
+// parse the command line, returns false on invalid arguments
+static bool ParseArguments(int argc, char* argv[], BenchConfig& outConfig)
+{
+	for (int i=1; i<argc; ++i)
+	{
+		const char* arg = argv[i];
+		const bool hasValue = (i+1 < argc);
+
+		if (strcmp(arg, "--channels") == 0 && hasValue)			outConfig.mNumChannels = atoi(argv[++i]);
+		else if (strcmp(arg, "--samplerate") == 0 && hasValue)	outConfig.mSampleRate = atoi(argv[++i]);
+		else if (strcmp(arg, "--generators") == 0 && hasValue)	outConfig.mNumGenerators = atoi(argv[++i]);
+		else if (strcmp(arg, "--seconds") == 0 && hasValue)		outConfig.mSeconds = atof(argv[++i]);
+		else if (strcmp(arg, "--fps") == 0 && hasValue)			outConfig.mTickRate = atof(argv[++i]);
+		else if (strcmp(arg, "--output") == 0 && hasValue)		outConfig.mOutputFilename = argv[++i];
+		else if (strcmp(arg, "--no-profile") == 0)				outConfig.mProfileNodes = false;
+		else if (strcmp(arg, "--bandpower") == 0)				outConfig.mUseBandPower = true;
+		else if (strcmp(arg, "--bandpower-check") == 0)
+		{
+			if (SelectMode(outConfig, BENCHMODE_BANDPOWERCHECK) == false)
+				return false;
+		}
+		else if (strcmp(arg, "--snapshot-stress") == 0 && hasValue && SelectMode(outConfig, BENCHMODE_SNAPSHOTSTRESS) == true)	outConfig.mSnapshotStressSeconds = atof(argv[++i]);
+		else if (strcmp(arg, "--sample-resolution") == 0 && hasValue)	outConfig.mSampleResolution = atof(argv[++i]);
+		else if (strcmp(arg, "--sample-formats") == 0)
+		{
+			if (SelectMode(outConfig, BENCHMODE_SAMPLEFORMATS) == false)
+				return false;
+		}
+		else if (strcmp(arg, "--math-chain") == 0 && hasValue && SelectMode(outConfig, BENCHMODE_MATHCHAIN) == true)	outConfig.mMathChainLength = atoi(argv[++i]);
+		else if (strcmp(arg, "--slow-branches") == 0 && hasValue)	outConfig.mNumSlowBranches = atoi(argv[++i]);
+		else if (strcmp(arg, "--no-idle-skip") == 0)			outConfig.mSkipIdleProcessors = false;
+		else if (strcmp(arg, "--debug-views") == 0 && hasValue)	outConfig.mNumDebugViews = atoi(argv[++i]);
+		else if (strcmp(arg, "--demand") == 0)					outConfig.mDemandTracking = true;
+		else if (strcmp(arg, "--hrv") == 0 && hasValue && SelectMode(outConfig, BENCHMODE_HRV) == true)	outConfig.mHrvWindowLength = atoi(argv[++i]);
+		else if (strcmp(arg, "--histogram") == 0 && hasValue && SelectMode(outConfig, BENCHMODE_HISTOGRAM) == true)	outConfig.mNumHistogramBins = atoi(argv[++i]);
+		else if (strcmp(arg, "--loreta") == 0 && hasValue && SelectMode(outConfig, BENCHMODE_LORETA) == true)	outConfig.mLoretaGridResolution = atoi(argv[++i]);
+		else if (strcmp(arg, "--auto-threshold") == 0 && hasValue)	outConfig.mNumAutoThresholdBins = atoi(argv[++i]);
+		else if (strcmp(arg, "--load-generator") == 0)			outConfig.mUseLoadGenerator = true;
+		else if (strcmp(arg, "--seed") == 0 && hasValue)		outConfig.mSeed = atoi(argv[++i]);
+		else if (strcmp(arg, "--artifacts") == 0 && hasValue)	outConfig.mArtifactRate = atof(argv[++i]);
+		else if (strcmp(arg, "--dropouts") == 0 && hasValue)	outConfig.mDropoutRate = atof(argv[++i]);
+		else if (strcmp(arg, "--jitter") == 0 && hasValue)		outConfig.mJitter = atof(argv[++i]);
+		else if (strcmp(arg, "--devices") == 0 && hasValue)		outConfig.mNumDevices = atoi(argv[++i]);
+		else if (strcmp(arg, "--slow-device") == 0 && hasValue)	outConfig.mSlowDeviceDelay = atof(argv[++i]) / 1000.0;
+		else if (strcmp(arg, "--acquisition-threads") == 0)		outConfig.mAcquisitionThreads = true;
+		else if (strcmp(arg, "--record") == 0 && hasValue)		outConfig.mRecordFilename = argv[++i];
+		else if (strcmp(arg, "--update-golden") == 0)			outConfig.mUpdateGolden = true;
+		else if (strcmp(arg, "--tolerance") == 0 && hasValue)	outConfig.mTolerance = atof(argv[++i]);
+		else if (strcmp(arg, "--relative-tolerance") == 0 && hasValue)	outConfig.mRelativeTolerance = atof(argv[++i]);
+		else if (strcmp(arg, "--sample-format") == 0 && hasValue)
+		{
+			const char* name = argv[++i];
+			if (strcmp(name, "double") == 0)		outConfig.mSampleFormat = ChannelBase::SAMPLEFORMAT_DOUBLE;
+			else if (strcmp(name, "float") == 0)	outConfig.mSampleFormat = ChannelBase::SAMPLEFORMAT_FLOAT;
+			else if (strcmp(name, "int32") == 0)	outConfig.mSampleFormat = ChannelBase::SAMPLEFORMAT_INT32;
+			else if (strcmp(name, "int16") == 0)	outConfig.mSampleFormat = ChannelBase::SAMPLEFORMAT_INT16;
+			else
+				return false;
+		}
+		else if (strcmp(arg, "--nmd") == 0 && hasValue && SelectMode(outConfig, BENCHMODE_NMD) == true)
+		{
+			const char* path = argv[++i];
+
+			std::error_code error;
+			if (std::filesystem::is_directory(path, error) == true)
+			{
+				Array<String> filenames;
+				for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path, error))
+					if (entry.is_regular_file() == true && entry.path().extension() == ".nmd")
+						filenames.Add( entry.path().string().c_str() );
+
+				filenames.Sort();
+				outConfig.mNmdFilenames.Add(filenames);
+			}
+			else
+				outConfig.mNmdFilenames.Add(path);
+		}
+		else if (strcmp(arg, "--regress") == 0 && hasValue && SelectMode(outConfig, BENCHMODE_REGRESSION) == true)
+		{
+			const char* path = argv[++i];
+
+			std::error_code error;
+			if (std::filesystem::is_directory(path, error) == true)
+			{
+				Array<String> filenames;
+				for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path, error))
+					if (entry.is_regular_file() == true && entry.path().extension() == ".nmr")
+						filenames.Add( entry.path().string().c_str() );
+
+				// an empty corpus must not pass silently
+				if (filenames.IsEmpty() == true)
+				{
+					fprintf(stderr, "No recordings in '%s'\n", path);
+					return false;
+				}
+
+				filenames.Sort();
+				outConfig.mRegressionFilenames.Add(filenames);
+			}
+			else
+				outConfig.mRegressionFilenames.Add(path);
+		}
+		else if (arg[0] == '-')
+			return false;
+		else
+		{
+			// directories contribute all json files inside them (sorted, for reproducible reports)
+			std::error_code error;
+			if (std::filesystem::is_directory(arg, error) == true)
+			{
+				Array<String> filenames;
+				for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(arg, error))
+					if (entry.is_regular_file() == true && entry.path().extension() == ".json")
+						filenames.Add( entry.path().string().c_str() );
+
+				filenames.Sort();
+				outConfig.mClassifierFilenames.Add(filenames);
+			}
+			else
+				outConfig.mClassifierFilenames.Add(arg);
+		}
+	}
+
+	// classifiers and recordings belong to the classifier mode, a recording holds one run
+	if (outConfig.mMode != BENCHMODE_CLASSIFIERS && (outConfig.mClassifierFilenames.IsEmpty() == false || outConfig.mRecordFilename.IsEmpty() == false))
+		return false;
+	if (outConfig.mRecordFilename.IsEmpty() == false && outConfig.mClassifierFilenames.Size() > 1)
+		return false;
+
+	// the selected mode needs something to do
+	if ((outConfig.mMode == BENCHMODE_SNAPSHOTSTRESS && outConfig.mSnapshotStressSeconds <= 0.0) ||
+		(outConfig.mMode == BENCHMODE_MATHCHAIN && outConfig.mMathChainLength == 0) ||
+		(outConfig.mMode == BENCHMODE_HRV && outConfig.mHrvWindowLength == 0) ||
+		(outConfig.mMode == BENCHMODE_HISTOGRAM && outConfig.mNumHistogramBins == 0) ||
+		(outConfig.mMode == BENCHMODE_LORETA && outConfig.mLoretaGridResolution == 0))
+		return false;
+
+	// only the load generator can stall its acquisition
+	if (outConfig.mSlowDeviceDelay > 0.0 && outConfig.mUseLoadGenerator == false)
+		return false;
+
+	return (outConfig.mNumChannels > 0 && outConfig.mSampleRate > 0 && outConfig.mSeconds > 0.0 && outConfig.mTickRate > 0.0 && outConfig.mSampleResolution > 0.0 && outConfig.mTolerance >= 0.0 && outConfig.mRelativeTolerance >= 0.0 && outConfig.mNumDevices > 0 && outConfig.mSlowDeviceDelay >= 0.0);
+}
+
+
+// add a FFT -> frequency band -> custom feedback chain behind the given output port
+static void AddSpectrumChain(Classifier* classifier, Node* sourceNode, uint32 outputPortNr, const char* prefix)
+{
+	String name;
+	Node* fftNode		= AddNode( classifier, FFTNode::Uuid(), name.Format("%s FFT", prefix) );
+	Node* bandNode		= AddNode( classifier, FrequencyBandNode::Uuid(), name.Format("%s Band", prefix) );
+	Node* feedbackNode	= AddNode( classifier, CustomFeedbackNode::Uuid(), name.Format("%s Feedback", prefix) );
+	if (fftNode == NULL || bandNode == NULL || feedbackNode == NULL)
+		return;
+
+	classifier->AddConnection( sourceNode, outputPortNr, fftNode, FFTNode::INPUTPORT_CHANNEL );
+	classifier->AddConnection( fftNode, FFTNode::OUTPUTPORT_SPECTRUM, bandNode, FrequencyBandNode::INPUTPORT_SPECTRUM );
+	classifier->AddConnection( bandNode, FrequencyBandNode::OUTPUTPORT_CHANNEL, feedbackNode, CustomFeedbackNode::INPUTPORT_VALUE );
+}
+
+
+// add a band power -> custom feedback chain behind the given output port (same band value as the spectrum chain)
+static void AddBandPowerChain(Classifier* classifier, Node* sourceNode, uint32 outputPortNr, const char* prefix)
+{
+	String name;
+	Node* bandNode		= AddNode( classifier, BandPowerNode::Uuid(), name.Format("%s Band Power", prefix) );
+	Node* feedbackNode	= AddNode( classifier, CustomFeedbackNode::Uuid(), name.Format("%s Feedback", prefix) );
+	if (bandNode == NULL || feedbackNode == NULL)
+		return;
+
+	classifier->AddConnection( sourceNode, outputPortNr, bandNode, BandPowerNode::INPUTPORT_CHANNEL );
+	classifier->AddConnection( bandNode, BandPowerNode::OUTPUTPORT_CHANNEL, feedbackNode, CustomFeedbackNode::INPUTPORT_VALUE );
+}
+
+
+// add a statistics node producing one value per 4 s epoch, followed by a few Math2 nodes that only receive a sample per epoch
+static void AddSlowBranch(Classifier* classifier, Node* sourceNode, uint32 outputPortNr, uint32 sampleRate, const char* prefix)
+{
+	String name;
+	Node* statisticsNode = AddNode( classifier, StatisticsNode::Uuid(), name.Format("%s Epoch Mean", prefix) );
+	if (statisticsNode == NULL)
+		return;
+
+	statisticsNode->SetInt32Attribute( "IntervalType", StatisticsNode::INTERVALTYPE_NUMSAMPLES );
+	statisticsNode->SetInt32Attribute( "IntervalLengthInSamples", (int32)(sampleRate * 4) );
+	statisticsNode->SetInt32Attribute( "Epoching", StatisticsNode::EPOCHMODE_ON );
+	statisticsNode->OnAttributesChanged();
+	classifier->AddConnection( sourceNode, outputPortNr, statisticsNode, StatisticsNode::INPUTPORT_CHANNEL );
+
+	Node* lastNode = statisticsNode;
+	uint32 lastPort = StatisticsNode::OUTPUTPORT_CHANNEL;
+	for (uint32 i=0; i<3; ++i)
+	{
+		Node* mathNode = AddNode( classifier, Math2Node::Uuid(), name.Format("%s Math %i", prefix, i) );
+		mathNode->SetInt32Attribute( "mathFunction", 2 );		// multiply
+		mathNode->SetFloatAttribute( "staticValue", 2.0 );
+		mathNode->OnAttributesChanged();
+		classifier->AddConnection( lastNode, lastPort, mathNode, Math2Node::INPUTPORT_X );
+
+		lastNode = mathNode;
+		lastPort = Math2Node::OUTPUTPORT_RESULT;
+	}
+
+	Node* feedbackNode = AddNode( classifier, CustomFeedbackNode::Uuid(), name.Format("%s Feedback", prefix) );
+	classifier->AddConnection( lastNode, lastPort, feedbackNode, CustomFeedbackNode::INPUTPORT_VALUE );
+}
+
+
+// auto threshold node on all channels of the given port, with constant target (50 %) and low threshold inputs at 60 Hz
+static void AddAutoThresholdBranch(Classifier* classifier, Node* sourceNode, uint32 outputPortNr, uint32 numBins, const char* prefix)
+{
+	String name;
+	Node* thresholdNode = AddNode( classifier, AutoThresholdNode::Uuid(), name.Format("%s Auto Threshold", prefix) );
+	if (thresholdNode == NULL)
+		return;
+
+	thresholdNode->SetInt32Attribute( "numBins", (int32)numBins );
+	thresholdNode->OnAttributesChanged();
+
+	Node* targetNode = AddNode( classifier, SignalGeneratorNode::Uuid(), name.Format("%s Target", prefix) );
+	Node* lowNode = AddNode( classifier, SignalGeneratorNode::Uuid(), name.Format("%s Low", prefix) );
+	Node* controlNodes[2] = { targetNode, lowNode };
+	for (uint32 i=0; i<2; ++i)
+	{
+		controlNodes[i]->SetFloatAttribute( "sampleRate", 60.0 );
+		controlNodes[i]->SetFloatAttribute( "amplitude", 0.0 );
+		controlNodes[i]->SetFloatAttribute( "dcoffset", (i == 0 ? 0.5 : -20.0) );
+		controlNodes[i]->OnAttributesChanged();
+	}
+
+	classifier->AddConnection( sourceNode, outputPortNr, thresholdNode, AutoThresholdNode::INPUTPORT_SIGNAL );
+	classifier->AddConnection( targetNode, 0, thresholdNode, AutoThresholdNode::INPUTPORT_TARGET );
+	classifier->AddConnection( lowNode, 0, thresholdNode, AutoThresholdNode::INPUTPORT_LOW );
+
+	Node* feedbackNode = AddNode( classifier, CustomFeedbackNode::Uuid(), name.Format("%s Feedback", prefix) );
+	classifier->AddConnection( thresholdNode, AutoThresholdNode::OUTPUTPORT_HIGH, feedbackNode, CustomFeedbackNode::INPUTPORT_VALUE );
+}
+
+
+static void AddChain(const BenchConfig& config, Classifier* classifier, Node* sourceNode, uint32 outputPortNr, const char* prefix)
+{
+	if (config.mUseBandPower == true)
+		AddBandPowerChain( classifier, sourceNode, outputPortNr, prefix );
+	else
+		AddSpectrumChain( classifier, sourceNode, outputPortNr, prefix );
+}
+
+
+// build the synthetic classifier used when no corpus is given
+static Classifier* CreateSyntheticClassifier(const BenchConfig& config)
+{
+	Classifier* classifier = new Classifier();
+	classifier->SetName("Synthetic");
+
+	Node* deviceNode;
+	if (config.mUseLoadGenerator == true)
+		deviceNode = AddNode( classifier, LoadGeneratorDeviceNode::Uuid(), "Load Generator" );
+	else
+		deviceNode = AddNode( classifier, TestDeviceNode::Uuid(), "Test Device" );
+
+	if (deviceNode != NULL)
+		AddChain( config, classifier, deviceNode, 0, "EEG" );
+
+	String name;
+	for (uint32 i=0; deviceNode != NULL && i<config.mNumSlowBranches; ++i)
+		AddSlowBranch( classifier, deviceNode, 0, config.mSampleRate, name.Format("Slow %i", i) );
+
+	if (deviceNode != NULL && config.mNumAutoThresholdBins > 0)
+		AddAutoThresholdBranch( classifier, deviceNode, 0, config.mNumAutoThresholdBins, "Threshold" );
+
+	for (uint32 i=0; deviceNode != NULL && i<config.mNumDebugViews; ++i)
+	{
+		Node* fftNode	= AddNode( classifier, FFTNode::Uuid(), name.Format("Debug %i FFT", i) );
+		Node* viewNode	= AddNode( classifier, ViewNode::Uuid(), name.Format("Debug %i View", i) );
+		classifier->AddConnection( deviceNode, 0, fftNode, FFTNode::INPUTPORT_CHANNEL );
+		classifier->AddConnection( fftNode, FFTNode::OUTPUTPORT_SPECTRUM, viewNode, ViewNode::INPUTPORT_SPECTRUM );
+	}
+
+	for (uint32 i=0; i<config.mNumGenerators; ++i)
+	{
+		name.Format("Generator %i", i);
+		Node* generatorNode = AddNode( classifier, SignalGeneratorNode::Uuid(), name.AsChar() );
+		if (generatorNode == NULL)
+			continue;
+
+		generatorNode->SetFloatAttribute( "sampleRate", config.mSampleRate );
+		generatorNode->SetFloatAttribute( "frequency", 1.0 + (i % 40) );
+		AddChain( config, classifier, generatorNode, 0, name.AsChar() );
+	}
+
+	classifier->CollectNodes();
+	return classifier;
+}
+
+
+
+
+int main(int argc, char* argv[])
+{
+	BenchConfig config;
+	config.mMode			= BENCHMODE_CLASSIFIERS;
+	config.mNumChannels		= 8;
+	config.mSampleRate		= 128;
+	config.mNumGenerators	= 0;
+	config.mSeconds			= 60.0;
+	config.mTickRate		= 60.0;
+	config.mProfileNodes	= true;
+	config.mUseBandPower	= false;
+	config.mSnapshotStressSeconds = 0.0;
+	config.mSampleFormat	= ChannelBase::SAMPLEFORMAT_DOUBLE;
+	config.mSampleResolution = 1.0;
+	config.mMathChainLength	= 0;
+	config.mNumSlowBranches	= 0;
+	config.mSkipIdleProcessors = true;
+	config.mNumDebugViews	= 0;
+	config.mDemandTracking	= false;
+	config.mHrvWindowLength	= 0;
+	config.mNumHistogramBins = 0;
+	config.mLoretaGridResolution = 0;
+	config.mNumAutoThresholdBins = 0;
+	config.mUseLoadGenerator = false;
+	config.mSeed			= 1;
+	config.mArtifactRate	= 0.0;
+	config.mDropoutRate		= 0.0;
+	config.mJitter			= 0.0;
+	config.mNumDevices		= 1;
+	config.mSlowDeviceDelay	= 0.0;
+	config.mAcquisitionThreads = false;
+	config.mUpdateGolden	= false;
+	config.mTolerance		= 1e-12;
+	config.mRelativeTolerance = 1e-9;
+
+	if (ParseArguments(argc, argv, config) == false)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	if (EngineInitializer::Init() == false)
+	{
+		fprintf(stderr, "Failed to initialize the engine\n");
+		return 1;
+	}
+
+	GetEngine()->SetChannelSampleFormat(config.mSampleFormat, config.mSampleResolution);
+	GetEngine()->SetSkipIdleProcessors(config.mSkipIdleProcessors);
+	GetEngine()->SetDemandTrackingEnabled(config.mDemandTracking);
+
+	// synthetic input device
+	DeviceInventory::RegisterDevices(true);
+	DeviceManager* deviceManager = GetDeviceManager();
+	deviceManager->SetRemoveInactiveDevicesEnabled(false);
+	// the engine runs the acquisition on threads by default, the bench only does so on request to keep the runs reproducible
+	deviceManager->SetAcquisitionThreadsEnabled(config.mAcquisitionThreads);
+
+	// the test device has one electrode per channel, the load generator any number of channels
+	if (config.mUseLoadGenerator == false && config.mNumChannels > TestDevice::GetMaxNumChannels())
+	{
+		fprintf(stderr, "The test device has at most %u channels, use --load-generator for more\n", TestDevice::GetMaxNumChannels());
+		EngineInitializer::Shutdown();
+		return 1;
+	}
+
+	// the regression cases replay their recorded devices instead
+	if (config.mMode != BENCHMODE_REGRESSION)
+	{
+		TestDeviceDriver* driver = new TestDeviceDriver();
+		deviceManager->AddDeviceDriver(driver);
+		for (uint32 i=0; i<config.mNumDevices; ++i)
+		{
+			if (config.mUseLoadGenerator == true)
+			{
+				LoadGeneratorDevice::Settings settings;
+				settings.mNumChannels	= config.mNumChannels;
+				settings.mSampleRate	= config.mSampleRate;
+				settings.mSeed			= config.mSeed + i;
+				settings.mArtifactRate	= config.mArtifactRate;
+				settings.mDropoutRate	= config.mDropoutRate;
+				settings.mJitter		= config.mJitter;
+
+				// the misbehaving device is the last one, the classifier reads the first
+				if (i == config.mNumDevices - 1)
+					settings.mAcquisitionDelay = config.mSlowDeviceDelay;
+
+				deviceManager->AddDevice( new LoadGeneratorDevice(driver, settings) );
+			}
+			else
+				deviceManager->AddDevice( new TestDevice(driver, config.mSampleRate, config.mNumChannels) );
+		}
+	}
+
+	// report header
+	Json json;
+	Json::Item rootItem = json.GetRootItem();
+	Json::Item configItem = rootItem.AddObject("config");
+	configItem.AddInt( "channels", config.mNumChannels );
+	configItem.AddInt( "sampleRate", config.mSampleRate );
+	configItem.AddInt( "generators", config.mNumGenerators );
+	configItem.AddDouble( "seconds", config.mSeconds );
+	configItem.AddDouble( "fps", config.mTickRate );
+	configItem.AddBool( "bandPower", config.mUseBandPower );
+	configItem.AddString( "sampleFormat", ChannelBase::GetSampleFormatName(config.mSampleFormat) );
+	configItem.AddInt( "slowBranches", config.mNumSlowBranches );
+	configItem.AddBool( "skipIdleProcessors", config.mSkipIdleProcessors );
+	configItem.AddInt( "debugViews", config.mNumDebugViews );
+	configItem.AddBool( "demandTracking", config.mDemandTracking );
+	configItem.AddInt( "autoThresholdBins", config.mNumAutoThresholdBins );
+	configItem.AddBool( "loadGenerator", config.mUseLoadGenerator );
+	configItem.AddInt( "devices", config.mNumDevices );
+	configItem.AddBool( "acquisitionThreads", config.mAcquisitionThreads );
+	if (config.mUseLoadGenerator == true)
+	{
+		configItem.AddInt( "seed", config.mSeed );
+		configItem.AddDouble( "artifactRate", config.mArtifactRate );
+		configItem.AddDouble( "dropoutRate", config.mDropoutRate );
+		configItem.AddDouble( "jitter", config.mJitter );
+		configItem.AddDouble( "slowDeviceDelay", config.mSlowDeviceDelay );
+	}
+	if (config.mMode == BENCHMODE_REGRESSION)
+	{
+		configItem.AddBool( "updateGolden", config.mUpdateGolden );
+		configItem.AddDouble( "tolerance", config.mTolerance );
+		configItem.AddDouble( "relativeTolerance", config.mRelativeTolerance );
+	}
+	Json::Item runsItem = rootItem.AddArray("runs");
+
+	int result = 0;
+	switch (config.mMode)
+	{
+		// session file codec
+		case BENCHMODE_NMD:
+		{
+			Json::Item filesItem = rootItem.AddArray("nmd");
+
+			const uint32 numFiles = config.mNmdFilenames.Size();
+			for (uint32 i=0; i<numFiles; ++i)
+				if (RunNmdCodec(config.mNmdFilenames[i].AsChar(), filesItem) == false)
+					result = 1;
+			break;
+		}
+
+		// feedback snapshot consistency
+		case BENCHMODE_SNAPSHOTSTRESS:
+			if (RunSnapshotStress(config.mSnapshotStressSeconds, rootItem) == false)
+				result = 1;
+			break;
+
+		// channel sample formats
+		case BENCHMODE_SAMPLEFORMATS:
+			if (RunSampleFormatCheck(rootItem) == false)
+				result = 1;
+			break;
+
+		// Math2 chain against the expression node
+		case BENCHMODE_MATHCHAIN:
+			if (RunMathChain(config, rootItem, runsItem) == false)
+				result = 1;
+			break;
+
+		// band power node against FFT -> frequency band
+		case BENCHMODE_BANDPOWERCHECK:
+			if (RunBandPowerCheck(config, rootItem, runsItem) == false)
+				result = 1;
+			break;
+
+		// incremental against batch HRV
+		case BENCHMODE_HRV:
+			if (RunHrvCheck(config.mHrvWindowLength, rootItem) == false)
+				result = 1;
+			break;
+
+		// histogram searches against the linear walk
+		case BENCHMODE_HISTOGRAM:
+			if (RunHistogramCheck(config.mNumHistogramBins, rootItem) == false)
+				result = 1;
+			break;
+
+		// LORETA source estimation throughput
+		case BENCHMODE_LORETA:
+			if (RunLoretaBench(config, rootItem) == false)
+				result = 1;
+			break;
+
+		// recorded sessions against their golden results
+		case BENCHMODE_REGRESSION:
+		{
+			Json::Item casesItem = rootItem.AddArray("regression");
+
+			const uint32 numFiles = config.mRegressionFilenames.Size();
+			for (uint32 i=0; i<numFiles; ++i)
+				if (RunRegressionCase(config.mRegressionFilenames[i].AsChar(), config, casesItem) == false)
+					result = 1;
+			break;
+		}
+
+		// the given classifiers or the synthetic one
+		case BENCHMODE_CLASSIFIERS:
+		{
+			if (config.mClassifierFilenames.IsEmpty() == true)
+			{
+				if (RunClassifier( CreateSyntheticClassifier(config), config, runsItem ) == false)
+					result = 1;
+				break;
+			}
+
+			const uint32 numFiles = config.mClassifierFilenames.Size();
+			for (uint32 i=0; i<numFiles; ++i)
+			{
+				const char* filename = config.mClassifierFilenames[i].AsChar();
+
+				Classifier* classifier = new Classifier();
+				if (GraphImporter::LoadFromFile(filename, classifier) == false)
+				{
+					fprintf(stderr, "Failed to load classifier '%s'\n", filename);
+					delete classifier;
+					result = 1;
+					continue;
+				}
+
+				if (classifier->GetNameString().IsEmpty() == true)
+					classifier->SetName(filename);
+
+				classifier->CollectNodes();
+				if (RunClassifier(classifier, config, runsItem) == false)
+					result = 1;
+			}
+			break;
+		}
+	}
+
+	// write report
+	if (config.mOutputFilename.IsEmpty() == true)
+		printf("%s\n", json.ToString().AsChar());
+	else if (json.WriteToFile(config.mOutputFilename.AsChar()) == false)
+	{
+		fprintf(stderr, "Failed to write report '%s'\n", config.mOutputFilename.AsChar());
+		result = 1;
+	}
+
+	EngineInitializer::Shutdown();
+	return result;
+}
@@ -126,6 +126,9 @@ void AttributeSet::AddAttribute(AttributeSettings* settings, Attribute* attribut
 	mAttributes.AddEmpty();
 	mAttributes.GetLast().mSettings = settings;
 	mAttributes.GetLast().mValue	= attributeValue;
+
+	if (mNameIndex.empty() == false)
+		mNameIndex.emplace( settings->GetInternalNameString(), mAttributes.Size()-1 );
 }
 
 
@@ -136,6 +139,9 @@ void AttributeSet::AddAttribute(AttributeSettings* settings)
 	mAttributes.AddEmpty();
 	mAttributes.GetLast().mSettings = settings;
 	mAttributes.GetLast().mValue	= NULL;
+
+	if (mNameIndex.empty() == false)
+		mNameIndex.emplace( settings->GetInternalNameString(), mAttributes.Size()-1 );
 }
 
 
@@ -153,18 +159,19 @@ void AttributeSet::RemoveAllAttributes(bool delFromMem)
 	}
 
 	mAttributes.Clear(true);
+	mNameIndex.clear();
 }
 
 
 // search for attribute by pointer
-bool AttributeSet::HasAttribute(Attribute* attribute) const
+uint32 AttributeSet::FindAttributeIndex(Attribute* attribute) const
 {
 	const uint32 numAttributes = mAttributes.Size();
 	for (uint32 i=0; i<numAttributes; ++i)
 		if (mAttributes[i].mValue == attribute)
-			return true;
+			return i;
 
-	return false;
+	return CORE_INVALIDINDEX32;
 }
 
 
@@ -172,11 +179,48 @@ bool AttributeSet::HasAttribute(Attribute* attribute) const
 uint32 AttributeSet::FindAttributeIndexByInternalName(const char* name) const
 {
 	const uint32 numAttributes = mAttributes.Size();
-	for (uint32 i=0; i<numAttributes; ++i)
-		if (mAttributes[i].mSettings->GetInternalNameString() == name)
-			return i;
 
-	return CORE_INVALIDINDEX32;
+	// a linear search is faster for the few attributes most objects have
+	if (numAttributes < 16)
+	{
+		for (uint32 i=0; i<numAttributes; ++i)
+			if (mAttributes[i].mSettings->GetInternalNameString() == name)
+				return i;
+
+		return CORE_INVALIDINDEX32;
+	}
+
+	if (mNameIndex.empty() == true)
+		BuildNameIndex();
+
+	auto iter = mNameIndex.find( String(name) );
+	if (iter == mNameIndex.end())
+		return CORE_INVALIDINDEX32;
+
+	// the index can be stale in case an internal name changed after adding the attribute
+	const uint32 index = iter->second;
+	if (index < numAttributes && mAttributes[index].mSettings->GetInternalNameString() == name)
+		return index;
+
+	BuildNameIndex();
+	iter = mNameIndex.find( String(name) );
+	return (iter != mNameIndex.end()) ? iter->second : CORE_INVALIDINDEX32;
+}
+
+
+// build the internal name -> attribute index lookup table
+void AttributeSet::BuildNameIndex() const
+{
+	mNameIndex.clear();
+
+	const uint32 numAttributes = mAttributes.Size();
+	mNameIndex.reserve( numAttributes );
+	for (uint32 i=0; i<numAttributes; ++i)
+	{
+		// attribute slots might not be filled yet after a Resize()
+		if (mAttributes[i].mSettings != NULL)
+			mNameIndex.emplace( mAttributes[i].mSettings->GetInternalNameString(), i );
+	}
 }
 
 
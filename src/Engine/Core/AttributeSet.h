@@ -31,6 +31,7 @@
 #include "Color.h"
 #include "Json.h"
 #include "AttributeSettings.h"
+#include <unordered_map>
 
 
 namespace Core
@@ -52,18 +53,19 @@ class ENGINE_API AttributeSet
 		inline AttributeSettings* GetAttribute(uint32 index) const					{ return mAttributes[index].mSettings; }
 		inline AttributeSettings* GetAttributeSettings(uint32 index) const			{ return mAttributes[index].mSettings; }
 		inline Attribute* GetAttributeValue(uint32 index) const						{ return mAttributes[index].mValue; }
-		inline void SetAttributeSettings(uint32 index, AttributeSettings* settings)	{ mAttributes[index].mSettings = settings; }
+		inline void SetAttributeSettings(uint32 index, AttributeSettings* settings)	{ mAttributes[index].mSettings = settings; mNameIndex.clear(); }
 		inline void SetAttributeValue(uint32 index, Attribute* value)				{ mAttributes[index].mValue = value; }
 
 		void AddAttribute(AttributeSettings* settings, Attribute* attributeValue);
 		void AddAttribute(AttributeSettings* settings);
 		void RemoveAllAttributes(bool delFromMem=true);
-		void Resize(uint32 numAttributes)											{ mAttributes.Resize( numAttributes ); }
+		void Resize(uint32 numAttributes)											{ mAttributes.Resize( numAttributes ); mNameIndex.clear(); }
 
 		uint32 FindAttributeIndexByInternalName(const char* name) const;
 		uint32 FindAttributeIndexByName(const char* name) const;
+		uint32 FindAttributeIndex(Attribute* attribute) const;
 
-		bool HasAttribute(Attribute* attribute) const;
+		bool HasAttribute(Attribute* attribute) const								{ return (FindAttributeIndex(attribute) != CORE_INVALIDINDEX32); }
 		bool HasAttributeWithInternalName(const char* name) const					{ return (FindAttributeIndexByInternalName(name) != CORE_INVALIDINDEX32); }
 		bool HasAttributeWithName(const char* name) const							{ return (FindAttributeIndexByName(name) != CORE_INVALIDINDEX32); }
 
@@ -136,6 +138,10 @@ class ENGINE_API AttributeSet
 		};
 
 		Array<AttributeData>	mAttributes;
+
+		// internal name -> attribute index, built lazily on the first lookup (internal names are expected to be set before the attribute gets added)
+		void BuildNameIndex() const;
+		mutable std::unordered_map<String, uint32, StringHasher> mNameIndex;
 };
 
 } // namespace Core
@@ -40,6 +40,7 @@ class ENGINE_API Complex
 		Complex() : mReal(0.0), mImag(0.0)												{}
         Complex(double real, double imaginary) : mReal(real), mImag(imaginary)			{}
 		Complex(double real) : mReal(real), mImag(0.0)									{}
+		Complex(const Complex& other) = default;										// declared because of the user-defined assignment (-Wdeprecated-copy)
 		~Complex()																		{}
 	
 		// assignment	
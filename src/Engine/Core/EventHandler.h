@@ -35,6 +35,9 @@
 #include "../Graph/StateTransitionCondition.h"
 #include "../Device.h"
 #include "../BciDevice.h"
+#include "LockFreeQueue.h"
+#include <new>
+#include <type_traits>
 
 // forward declaration (classifier is-of-type EventHandler)
 class Classifier;
@@ -43,15 +46,168 @@ class Experience;
 namespace Core
 {
 
+class EventHandler;
+
+/**
+ * Queued event, calls the event function on the given handler.
+ * The function object (e.g. a lambda with the event arguments) is stored inline, so creating and moving queued events does not allocate.
+ * Only function objects that do not fit (e.g. events that copy a whole user) are allocated on the heap; the capacity holds the largest
+ * notify function arguments including one inline string (EventString), long strings allocate their characters though.
+ */
+class QueuedEvent
+{
+	public:
+		enum { CAPACITY = 160 };
+
+		QueuedEvent() : mCall(NULL), mMove(NULL), mDestroy(NULL)	{}
+
+		template <class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, QueuedEvent>::value>::type>
+		QueuedEvent(F&& function)
+		{
+			typedef typename std::decay<F>::type Function;
+
+			if constexpr (sizeof(Function) <= CAPACITY && alignof(Function) <= alignof(std::max_align_t))
+			{
+				new (mStorage) Function( std::forward<F>(function) );
+				mCall		= [](void* storage, EventHandler* handler)	{ (*static_cast<Function*>(storage))(handler); };
+				mMove		= [](void* target, void* source)			{ new (target) Function( std::move(*static_cast<Function*>(source)) ); static_cast<Function*>(source)->~Function(); };
+				mDestroy	= [](void* storage)							{ static_cast<Function*>(storage)->~Function(); };
+			}
+			else
+			{
+				*reinterpret_cast<Function**>(mStorage) = new Function( std::forward<F>(function) );
+				mCall		= [](void* storage, EventHandler* handler)	{ (**static_cast<Function**>(storage))(handler); };
+				mMove		= [](void* target, void* source)			{ *static_cast<Function**>(target) = *static_cast<Function**>(source); };
+				mDestroy	= [](void* storage)							{ delete *static_cast<Function**>(storage); };
+			}
+		}
+
+		QueuedEvent(QueuedEvent&& other) : mCall(NULL), mMove(NULL), mDestroy(NULL)	{ MoveFrom(other); }
+		QueuedEvent& operator=(QueuedEvent&& other)					{ if (&other != this) { Reset(); MoveFrom(other); } return *this; }
+		~QueuedEvent()												{ Reset(); }
+
+		QueuedEvent(const QueuedEvent&) = delete;
+		QueuedEvent& operator=(const QueuedEvent&) = delete;
+
+		void operator()(EventHandler* handler)						{ if (mCall != NULL) mCall(mStorage, handler); }
+
+	private:
+		void Reset()												{ if (mDestroy != NULL) mDestroy(mStorage); mCall = NULL; mMove = NULL; mDestroy = NULL; }
+		void MoveFrom(QueuedEvent& other)							{ if (other.mMove == NULL) return; other.mMove(mStorage, other.mStorage); mCall = other.mCall; mMove = other.mMove; mDestroy = other.mDestroy; other.mCall = NULL; other.mMove = NULL; other.mDestroy = NULL; }
+
+		alignas(std::max_align_t) char	mStorage[CAPACITY];
+		void							(*mCall)(void*, EventHandler*);
+		void							(*mMove)(void*, void*);
+		void							(*mDestroy)(void*);
+};
+
+
 class ENGINE_API EventHandler
 {
 	public:
-		EventHandler() : mEventSystemAcceptEvents(true) {}
-		virtual ~EventHandler() {}
+		// event types, one per notify function in the EventManager
+		enum EEventType
+		{
+			EVENT_PROGRESSSTART = 0,
+			EVENT_PROGRESSEND,
+			EVENT_PROGRESSTEXT,
+			EVENT_PROGRESSVALUE,
+			EVENT_SUBPROGRESSTEXT,
+			EVENT_SUBPROGRESSVALUE,
+			EVENT_PREPARESESSION,
+			EVENT_PREPAREDSESSION,
+			EVENT_STARTSESSION,
+			EVENT_STOPSESSION,
+			EVENT_SESSIONUSERCHANGED,
+			EVENT_SWITCHAPPLICATION,
+			EVENT_SWITCHSTAGE,
+			EVENT_GRAPHRESET,
+			EVENT_GRAPHMODIFIED,
+			EVENT_NODERENAMED,
+			EVENT_NODEADDED,
+			EVENT_REMOVENODE,
+			EVENT_NODEREMOVED,
+			EVENT_CONNECTIONADDED,
+			EVENT_REMOVECONNECTION,
+			EVENT_CONNECTIONREMOVED,
+			EVENT_ATTRIBUTEUPDATED,
+			EVENT_NODESTARTED,
+			EVENT_NODESTOPPED,
+			EVENT_EXITSTATEREACHED,
+			EVENT_DEVICEADDED,
+			EVENT_REMOVEDEVICE,
+			EVENT_DEVICEREMOVED,
+			EVENT_ACTIVEBCICHANGED,
+			EVENT_ACTIVECLASSIFIERCHANGED,
+			EVENT_ACTIVESTATEMACHINECHANGED,
+			EVENT_ACTIVEEXPERIENCECHANGED,
+			EVENT_PLAYAUDIO,
+			EVENT_STOPAUDIO,
+			EVENT_PAUSEAUDIO,
+			EVENT_SEEKAUDIO,
+			EVENT_PLAYVIDEO,
+			EVENT_STOPVIDEO,
+			EVENT_PAUSEVIDEO,
+			EVENT_SEEKVIDEO,
+			EVENT_SHOWIMAGE,
+			EVENT_HIDEIMAGE,
+			EVENT_SHOWTEXT,
+			EVENT_HIDETEXT,
+			EVENT_SETBACKGROUNDCOLOR,
+			EVENT_SETFOURZONEAVECOLORS,
+			EVENT_HIDEFOURZONEAVE,
+			EVENT_SHOWBUTTON,
+			EVENT_CLEARBUTTONS,
+			EVENT_COMMAND,
+			EVENT_OPENURL,
+			EVENT_BROWSERSTARTPLAYER,
+			EVENT_BROWSERSTOPPLAYER,
+			EVENT_BROWSERPAUSEPLAYER,
+			EVENT_SHOWTEXTINPUT,
+			EVENT_HIDETEXTINPUT,
+			NUM_EVENTTYPES
+		};
+
+		// queued event (calls the event function on the given handler)
+		typedef Core::QueuedEvent QueuedEvent;
+
+		EventHandler() : mEventSystemAcceptEvents(true), mEventQueue(NULL)	{ SubscribeAllEvents(); for (uint32 i=0; i<NUM_EVENTTYPES; ++i) mEventSystemQueued[i] = false; }
+		virtual ~EventHandler()												{ delete mEventQueue; }
 
 		void SetAcceptEvents(bool accept = true)		{ mEventSystemAcceptEvents = accept; }
 		bool GetAcceptEvents() const					{ return mEventSystemAcceptEvents; }
 
+		// event subscriptions (all events by default)
+		// NOTE: the EventManager only calls handlers that subscribed to an event; change subscriptions before registering the handler or call EventManager::UpdateEventHandler() afterwards
+		void SubscribeEvent(EEventType type, bool subscribe = true)			{ mEventSystemSubscriptions[type] = subscribe; }
+		void SubscribeAllEvents(bool subscribe = true)						{ for (uint32 i=0; i<NUM_EVENTTYPES; ++i) mEventSystemSubscriptions[i] = subscribe; }
+		void UnsubscribeAllEvents()											{ SubscribeAllEvents(false); }
+		bool IsSubscribed(uint32 type) const								{ return mEventSystemSubscriptions[type]; }
+
+		// queued delivery: events of the given type are posted to a lock-free queue instead of being called on the emitting thread, the handler drains it on its own thread using ProcessQueuedEvents()
+		// NOTE: string arguments are copied, the graph object events (attribute updated, node started/stopped) look their objects up again by uuid and are skipped if they got removed in the meantime,
+		//       other pointer arguments are delivered as they are (only queue those events if their objects outlive the next drain)
+		void SetQueuedDelivery(EEventType type, bool queued = true)			{ mEventSystemQueued[type] = queued; if (queued == true && mEventQueue == NULL) mEventQueue = new LockFreeQueue<QueuedEvent>(); }
+		bool IsQueuedDelivery(uint32 type) const							{ return mEventSystemQueued[type]; }
+		void PostEvent(QueuedEvent&& event)									{ mEventQueue->Push( std::move(event) ); }
+
+		// call all queued events, returns the number of processed events
+		uint32 ProcessQueuedEvents()
+		{
+			if (mEventQueue == NULL)
+				return 0;
+
+			uint32 numEvents = 0;
+			QueuedEvent event;
+			while (mEventQueue->Pop(event) == true)
+			{
+				event(this);
+				numEvents++;
+			}
+
+			return numEvents;
+		}
+
 		//
 		// Core Events
 		//  Frequently used events in the core are implemented with their own callback functions which reduces the calling overhead.
@@ -160,6 +316,13 @@ class ENGINE_API EventHandler
 		// enable/disable all events
 		bool mEventSystemAcceptEvents;
 
+		// subscribed event types
+		bool mEventSystemSubscriptions[NUM_EVENTTYPES];
+
+		// event types with queued delivery and their queue (NULL until the first type is queued)
+		bool mEventSystemQueued[NUM_EVENTTYPES];
+		LockFreeQueue<QueuedEvent>* mEventQueue;
+
 };
 
 } // namespace Core
@@ -29,11 +29,60 @@
 #include "EventHandler.h"
 #include "LogManager.h"
 #include "EventLogger.h"
+#include "../EngineManager.h"
+#include "../Graph/GraphManager.h"
 
 
 namespace Core
 {
 
+// store the uuids of the graph and the object
+EventGraphObject::EventGraphObject(Graph* graph, GraphObject* object)
+{
+	mGraphUuid[0]	= '\0';
+	mObjectUuid[0]	= '\0';
+
+	mIsValid = (graph != NULL && object != NULL);
+	if (mIsValid == true)
+		mIsValid = CopyUuid(mGraphUuid, graph->GetUuid()) && CopyUuid(mObjectUuid, object->GetUuid());
+}
+
+
+bool EventGraphObject::CopyUuid(char* outUuid, const char* uuid)
+{
+	const size_t length = strlen(uuid);
+	if (length > MAX_UUIDLENGTH)
+		return false;
+
+	memcpy(outUuid, uuid, length + 1);
+	return true;
+}
+
+
+// look up the graph and the object again
+bool EventGraphObject::Find(Graph** outGraph, GraphObject** outObject) const
+{
+	if (mIsValid == false)
+		return false;
+
+	Graph* graph = GetGraphManager()->FindGraphByUuid(mGraphUuid);
+	if (graph == NULL)
+		return false;
+
+	// the graph itself or one of its objects
+	GraphObject* object = graph;
+	if (graph->GetUuidString().IsEqualNoCase(mObjectUuid) == false)
+		object = graph->FindObjectByUuid(mObjectUuid);
+
+	if (object == NULL)
+		return false;
+
+	*outGraph	= graph;
+	*outObject	= object;
+	return true;
+}
+
+
 EventManager::EventManager()
 {
 	mEventLogger = NULL;
@@ -49,6 +98,9 @@ EventManager::EventManager()
 EventManager::~EventManager()
 {
 	mEventHandlers.Clear();
+	for (uint32 i=0; i<EventHandler::NUM_EVENTTYPES; ++i)
+		mSubscribers[i].Clear();
+
 	delete mEventLogger;
 }
 
@@ -58,6 +110,41 @@ void EventManager::AddEventHandler(EventHandler* eventHandler)
 	CORE_ASSERT(FindEventHandlerIndex(eventHandler) == CORE_INVALIDINDEX32);
 
 	mEventHandlers.Add(eventHandler);
+
+	// add it to the subscriber lists of all event types it is interested in
+	for (uint32 i=0; i<EventHandler::NUM_EVENTTYPES; ++i)
+	{
+		if (eventHandler->IsSubscribed(i) == true)
+			mSubscribers[i].Add(eventHandler);
+	}
+}
+
+
+void EventManager::UpdateEventHandler(EventHandler* eventHandler)
+{
+	if (FindEventHandlerIndex(eventHandler) == CORE_INVALIDINDEX32)
+		return;
+
+	for (uint32 i=0; i<EventHandler::NUM_EVENTTYPES; ++i)
+	{
+		const bool isSubscriber = mSubscribers[i].Contains(eventHandler);
+		if (eventHandler->IsSubscribed(i) == true && isSubscriber == false)
+			mSubscribers[i].Add(eventHandler);
+		else if (eventHandler->IsSubscribed(i) == false && isSubscriber == true)
+			mSubscribers[i].RemoveByValue(eventHandler);
+	}
+}
+
+
+uint32 EventManager::ProcessQueuedEvents()
+{
+	uint32 numEvents = 0;
+
+	const uint32 numEventHandlers = mEventHandlers.Size();
+	for (uint32 i=0; i<numEventHandlers; ++i)
+		numEvents += mEventHandlers[i]->ProcessQueuedEvents();
+
+	return numEvents;
 }
 
 
@@ -87,8 +174,12 @@ bool EventManager::RemoveEventHandler(EventHandler* eventHandler, bool delFromMe
 
 void EventManager::RemoveEventHandler(uint32 index, bool delFromMem)
 {
+	EventHandler* eventHandler = mEventHandlers[index];
+	for (uint32 i=0; i<EventHandler::NUM_EVENTTYPES; ++i)
+		mSubscribers[i].RemoveByValue(eventHandler);
+
 	if (delFromMem == true)
-		delete mEventHandlers[index];
+		delete eventHandler;
 
 	mEventHandlers.Remove(index);
 }
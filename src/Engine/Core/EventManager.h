@@ -42,6 +42,29 @@ class StateTransitionCondition;
 namespace Core
 {
 
+/**
+ * Graph object argument of a queued event. The graph and the object are stored by uuid (inline, no allocation) and looked up again
+ * when the handler processes the event, so the event can be skipped in case they got removed in the meantime.
+ */
+class ENGINE_API EventGraphObject
+{
+	public:
+		EventGraphObject(Graph* graph, GraphObject* object);
+
+		// returns false in case the graph or the object does not exist anymore
+		bool Find(Graph** outGraph, GraphObject** outObject) const;
+
+	private:
+		enum { MAX_UUIDLENGTH = 47 };
+
+		bool CopyUuid(char* outUuid, const char* uuid);
+
+		char mGraphUuid[MAX_UUIDLENGTH + 1];
+		char mObjectUuid[MAX_UUIDLENGTH + 1];
+		bool mIsValid;					// false in case the uuids did not fit
+};
+
+
 class ENGINE_API EventManager
 {
 	public:
@@ -56,117 +79,202 @@ class ENGINE_API EventManager
 		uint32 GetNumEventHandlers() const						{ return mEventHandlers.Size(); }
 		uint32 FindEventHandlerIndex(EventHandler* eventHandler) const;
 
+		// rebuild the subscriber lists of the given handler (call after changing its subscriptions)
+		void UpdateEventHandler(EventHandler* eventHandler);
+		uint32 GetNumSubscribers(uint32 eventType) const		{ return mSubscribers[eventType].Size(); }
+
+		// call the queued events of all handlers with queued delivery, returns the number of processed events
+		// NOTE: the queues are single consumer, only call this from the thread the queued handlers live in
+		uint32 ProcessQueuedEvents();
+
 		//---------------------------------------------------------------------
 
 		//
 		// Core Events
 		//  Frequently used events in the core are implemented with their own callback functions which reduces the calling overhead.
-		//  Use the EVENT_CREATE_NOTIFY_FUNCTION_ macros to generate a function that calls the same-named function in all registered event handlers.
+		//  Use the EVENT_CREATE_NOTIFY_FUNCTION_ macros to generate a function that calls the same-named function in all event handlers subscribed to the event type.
 
 		// Progress View Events
 		void OnProgressStart( bool showProgressText, bool showProgressValue, bool showSubProgressText, bool showSubProgressValue )
 		{
-			const uint32 numEventHandlers = mEventHandlers.Size();
+			const Core::Array<EventHandler*>& handlers = mSubscribers[EventHandler::EVENT_PROGRESSSTART];
+			const uint32 numEventHandlers = handlers.Size();
 			for (uint32 i = 0; i < numEventHandlers; ++i)
 			{
-				mEventHandlers[i]->OnProgressStart( showProgressText, showProgressValue, showSubProgressText, showSubProgressValue );
-				mEventHandlers[i]->OnProgressValue( 0.0f );
+				EventHandler* handler = handlers[i];
+				if (handler->IsQueuedDelivery(EventHandler::EVENT_PROGRESSSTART) == true)
+				{
+					handler->PostEvent( [=](EventHandler* h) { h->OnProgressStart( showProgressText, showProgressValue, showSubProgressText, showSubProgressValue ); h->OnProgressValue( 0.0f ); } );
+					continue;
+				}
+
+				handler->OnProgressStart( showProgressText, showProgressValue, showSubProgressText, showSubProgressValue );
+				handler->OnProgressValue( 0.0f );
 			}
 		}
 
 		void OnProgressEnd()
 		{
-			const uint32 numEventHandlers = mEventHandlers.Size();
+			const Core::Array<EventHandler*>& handlers = mSubscribers[EventHandler::EVENT_PROGRESSEND];
+			const uint32 numEventHandlers = handlers.Size();
 			for (uint32 i = 0; i<numEventHandlers; ++i)
 			{
-				mEventHandlers[i]->OnProgressValue( 100.0f ); 
-				mEventHandlers[i]->OnProgressEnd();
+				EventHandler* handler = handlers[i];
+				if (handler->IsQueuedDelivery(EventHandler::EVENT_PROGRESSEND) == true)
+				{
+					handler->PostEvent( [](EventHandler* h) { h->OnProgressValue( 100.0f ); h->OnProgressEnd(); } );
+					continue;
+				}
+
+				handler->OnProgressValue( 100.0f ); 
+				handler->OnProgressEnd();
 			}
 		}
 
 		// Progress Window
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnProgressText,  const char*, text );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnProgressValue, float, percentage );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnSubProgressText,  const char*, text );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnSubProgressValue, float, percentage );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_PROGRESSTEXT, OnProgressText,  const char*, text );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_PROGRESSVALUE, OnProgressValue, float, percentage );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_SUBPROGRESSTEXT, OnSubProgressText,  const char*, text );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_SUBPROGRESSVALUE, OnSubProgressValue, float, percentage );
 
 		// session
-		inline EVENT_CREATE_NOTIFY_FUNCTION_0( OnPrepareSession );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_0( OnPreparedSession );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_0( OnStartSession );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_0( OnStopSession );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnSessionUserChanged, const User&, user );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_PREPARESESSION, OnPrepareSession );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_PREPAREDSESSION, OnPreparedSession );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_STARTSESSION, OnStartSession );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_STOPSESSION, OnStopSession );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_SESSIONUSERCHANGED, OnSessionUserChanged, const User&, user );
 
 		// Visualization Tier Control Events
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnSwitchApplication, const char*, name );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnSwitchStage, uint32, index );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_SWITCHAPPLICATION, OnSwitchApplication, const char*, name );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_SWITCHSTAGE, OnSwitchStage, uint32, index );
 
 		// Graph Editing Events
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnGraphReset,	Graph*, graph);
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnGraphModified, Graph*, graph, GraphObject*, object );							// POST event, object may be INVALID pointer
-		inline EVENT_CREATE_NOTIFY_FUNCTION_3( OnNodeRenamed,	Graph*, graph, Node*, node, const Core::String&, oldName );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnNodeAdded,		Graph*, graph, Node*, node );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnRemoveNode,	Graph*, graph, Node*, node );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnNodeRemoved,	Graph*, graph, Node*, node );									// POST event, node IS INVALID pointer	
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnConnectionAdded,	Graph*, graph, Connection*, connection );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnRemoveConnection,  Graph*, graph, Connection*, connection );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnConnectionRemoved, Graph*, graph, Connection*, connection );					// POST event, connection IS INVALID pointer	
-		inline EVENT_CREATE_NOTIFY_FUNCTION_3( OnAttributeUpdated,  Graph*, graph, GraphObject*, object, Core::Attribute*, attribute);
-
-		// classifier events
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnNodeStarted, Graph*, graph, SPNode*, node );									// POST event, SPNode::Start was executed already
-		inline EVENT_CREATE_NOTIFY_FUNCTION_2( OnNodeStopped, Graph*, graph, SPNode*, node );									// POST event, SPNode::Start was executed already
-
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnExitStateReached, uint32, exitStatus );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_GRAPHRESET, OnGraphReset,	Graph*, graph);
+		inline EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_GRAPHMODIFIED, OnGraphModified, Graph*, graph, GraphObject*, object );							// POST event, object may be INVALID pointer
+		inline EVENT_CREATE_NOTIFY_FUNCTION_3( EVENT_NODERENAMED, OnNodeRenamed,	Graph*, graph, Node*, node, const Core::String&, oldName );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_NODEADDED, OnNodeAdded,		Graph*, graph, Node*, node );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_REMOVENODE, OnRemoveNode,	Graph*, graph, Node*, node );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_NODEREMOVED, OnNodeRemoved,	Graph*, graph, Node*, node );									// POST event, node IS INVALID pointer	
+		inline EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_CONNECTIONADDED, OnConnectionAdded,	Graph*, graph, Connection*, connection );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_REMOVECONNECTION, OnRemoveConnection,  Graph*, graph, Connection*, connection );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_CONNECTIONREMOVED, OnConnectionRemoved, Graph*, graph, Connection*, connection );					// POST event, connection IS INVALID pointer	
+
+		// queued: the attribute is passed by its index in the object, attributes of child objects (e.g. the conditions of a transition) are delivered as NULL
+		void OnAttributeUpdated(Graph* graph, GraphObject* object, Core::Attribute* attribute)
+		{
+			const Core::Array<EventHandler*>& handlers = mSubscribers[EventHandler::EVENT_ATTRIBUTEUPDATED];
+			const uint32 numEventHandlers = handlers.Size();
+			for (uint32 i = 0; i < numEventHandlers; ++i)
+			{
+				EventHandler* handler = handlers[i];
+				if (handler->GetAcceptEvents() == false)
+					continue;
+
+				if (handler->IsQueuedDelivery(EventHandler::EVENT_ATTRIBUTEUPDATED) == true)
+				{
+					handler->PostEvent( [arg = EventGraphObject(graph, object), attributeIndex = (object != NULL ? object->FindAttributeIndex(attribute) : CORE_INVALIDINDEX32)](EventHandler* h)
+					{
+						Graph* g; GraphObject* o;
+						if (arg.Find(&g, &o) == true)
+							h->OnAttributeUpdated( g, o, attributeIndex < o->GetNumAttributes() ? o->GetAttributeValue(attributeIndex) : NULL );
+					} );
+					continue;
+				}
+
+				handler->OnAttributeUpdated(graph, object, attribute);
+			}
+		}
+
+		// classifier events (POST events, SPNode::Start/Stop was executed already; queued: skipped in case the node got removed)
+		void OnNodeStarted(Graph* graph, SPNode* node)			{ NotifyNodeEvent(EventHandler::EVENT_NODESTARTED, graph, node); }
+		void OnNodeStopped(Graph* graph, SPNode* node)			{ NotifyNodeEvent(EventHandler::EVENT_NODESTOPPED, graph, node); }
+
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_EXITSTATEREACHED, OnExitStateReached, uint32, exitStatus );
 
 		// Device Manager events
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnDeviceAdded,	Device*, device );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnRemoveDevice,	Device*, device );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnDeviceRemoved, Device*, device );	// POST event, device IS INVALID pointer
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_DEVICEADDED, OnDeviceAdded,	Device*, device );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_REMOVEDEVICE, OnRemoveDevice,	Device*, device );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_DEVICEREMOVED, OnDeviceRemoved, Device*, device );	// POST event, device IS INVALID pointer
 
 		// Misc events
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnActiveBciChanged,			BciDevice*,		device );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnActiveClassifierChanged,	Classifier*,	classifier );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnActiveStateMachineChanged, StateMachine*,	stateMachine );
-		inline EVENT_CREATE_NOTIFY_FUNCTION_1( OnActiveExperienceChanged,	Experience*,	experience );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_ACTIVEBCICHANGED, OnActiveBciChanged,			BciDevice*,		device );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_ACTIVECLASSIFIERCHANGED, OnActiveClassifierChanged,	Classifier*,	classifier );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_ACTIVESTATEMACHINECHANGED, OnActiveStateMachineChanged, StateMachine*,	stateMachine );
+		inline EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_ACTIVEEXPERIENCECHANGED, OnActiveExperienceChanged,	Experience*,	experience );
 
 		// experience events
-		EVENT_CREATE_NOTIFY_FUNCTION_5( OnPlayAudio, const char*, url, int32, numLoops, double, beginAt, double, volume, bool, allowStream );
-		EVENT_CREATE_NOTIFY_FUNCTION_1( OnStopAudio, const char*, url );
-		EVENT_CREATE_NOTIFY_FUNCTION_2( OnPauseAudio, const char*, url, bool, unpause );
-		EVENT_CREATE_NOTIFY_FUNCTION_2( OnSeekAudio, const char*, url, uint32, millisecs );
+		EVENT_CREATE_NOTIFY_FUNCTION_5( EVENT_PLAYAUDIO, OnPlayAudio, const char*, url, int32, numLoops, double, beginAt, double, volume, bool, allowStream );
+		EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_STOPAUDIO, OnStopAudio, const char*, url );
+		EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_PAUSEAUDIO, OnPauseAudio, const char*, url, bool, unpause );
+		EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_SEEKAUDIO, OnSeekAudio, const char*, url, uint32, millisecs );
 
-		EVENT_CREATE_NOTIFY_FUNCTION_5( OnPlayVideo, const char*, url, int32, numLoops, double, beginAt, double, volume, bool, allowStream );
-		EVENT_CREATE_NOTIFY_FUNCTION_0( OnStopVideo );
-		EVENT_CREATE_NOTIFY_FUNCTION_2( OnPauseVideo, const char*, url, bool, unpause );
-		EVENT_CREATE_NOTIFY_FUNCTION_2( OnSeekVideo, const char*, url, uint32, millisecs);
+		EVENT_CREATE_NOTIFY_FUNCTION_5( EVENT_PLAYVIDEO, OnPlayVideo, const char*, url, int32, numLoops, double, beginAt, double, volume, bool, allowStream );
+		EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_STOPVIDEO, OnStopVideo );
+		EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_PAUSEVIDEO, OnPauseVideo, const char*, url, bool, unpause );
+		EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_SEEKVIDEO, OnSeekVideo, const char*, url, uint32, millisecs);
 
-		EVENT_CREATE_NOTIFY_FUNCTION_1( OnShowImage, const char*, url );
-		EVENT_CREATE_NOTIFY_FUNCTION_0( OnHideImage );
+		EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_SHOWIMAGE, OnShowImage, const char*, url );
+		EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_HIDEIMAGE, OnHideImage );
 
-		EVENT_CREATE_NOTIFY_FUNCTION_2( OnShowText, const char*, text, const Core::Color&, color );
-		EVENT_CREATE_NOTIFY_FUNCTION_0( OnHideText );
+		EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_SHOWTEXT, OnShowText, const char*, text, const Core::Color&, color );
+		EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_HIDETEXT, OnHideText );
 
-		EVENT_CREATE_NOTIFY_FUNCTION_1( OnSetBackgroundColor, const Core::Color&, color );
+		EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_SETBACKGROUNDCOLOR, OnSetBackgroundColor, const Core::Color&, color );
 
-		EVENT_CREATE_NOTIFY_FUNCTION_4( OnSetFourZoneAVEColors, const float*, red, const float*, green, const float*, blue, const float*, alpha );
-		EVENT_CREATE_NOTIFY_FUNCTION_0( OnHideFourZoneAVE );
+		EVENT_CREATE_NOTIFY_FUNCTION_4( EVENT_SETFOURZONEAVECOLORS, OnSetFourZoneAVEColors, const float*, red, const float*, green, const float*, blue, const float*, alpha );
+		EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_HIDEFOURZONEAVE, OnHideFourZoneAVE );
 
-		EVENT_CREATE_NOTIFY_FUNCTION_2( OnShowButton, const char*, text, uint32, buttonId );
-		EVENT_CREATE_NOTIFY_FUNCTION_0( OnClearButtons );
+		EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_SHOWBUTTON, OnShowButton, const char*, text, uint32, buttonId );
+		EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_CLEARBUTTONS, OnClearButtons );
 
-		EVENT_CREATE_NOTIFY_FUNCTION_1( OnCommand, const char*, command );
+		EVENT_CREATE_NOTIFY_FUNCTION_1( EVENT_COMMAND, OnCommand, const char*, command );
 
-		EVENT_CREATE_NOTIFY_FUNCTION_1(OnOpenUrl, const char*, url);
-		EVENT_CREATE_NOTIFY_FUNCTION_2(OnBrowserStartPlayer, double, progress, bool, fullscreen);
-		EVENT_CREATE_NOTIFY_FUNCTION_0(OnBrowserStopPlayer);
-		EVENT_CREATE_NOTIFY_FUNCTION_0(OnBrowserPausePlayer);
+		EVENT_CREATE_NOTIFY_FUNCTION_1(EVENT_OPENURL, OnOpenUrl, const char*, url);
+		EVENT_CREATE_NOTIFY_FUNCTION_2(EVENT_BROWSERSTARTPLAYER, OnBrowserStartPlayer, double, progress, bool, fullscreen);
+		EVENT_CREATE_NOTIFY_FUNCTION_0(EVENT_BROWSERSTOPPLAYER, OnBrowserStopPlayer);
+		EVENT_CREATE_NOTIFY_FUNCTION_0(EVENT_BROWSERPAUSEPLAYER, OnBrowserPausePlayer);
 
-		EVENT_CREATE_NOTIFY_FUNCTION_2( OnShowTextInput, const char*, text, uint32, inputId );
-		EVENT_CREATE_NOTIFY_FUNCTION_0( OnHideTextInput );
+		EVENT_CREATE_NOTIFY_FUNCTION_2( EVENT_SHOWTEXTINPUT, OnShowTextInput, const char*, text, uint32, inputId );
+		EVENT_CREATE_NOTIFY_FUNCTION_0( EVENT_HIDETEXTINPUT, OnHideTextInput );
 
 	private:
+		void NotifyNodeEvent(EventHandler::EEventType type, Graph* graph, SPNode* node)
+		{
+			const Core::Array<EventHandler*>& handlers = mSubscribers[type];
+			const uint32 numEventHandlers = handlers.Size();
+			for (uint32 i = 0; i < numEventHandlers; ++i)
+			{
+				EventHandler* handler = handlers[i];
+				if (handler->GetAcceptEvents() == false)
+					continue;
+
+				if (handler->IsQueuedDelivery(type) == true)
+				{
+					handler->PostEvent( [type, arg = EventGraphObject(graph, node)](EventHandler* h)
+					{
+						Graph* g; GraphObject* o;
+						if (arg.Find(&g, &o) == false)
+							return;
+
+						// classifier nodes are signal processing nodes
+						SPNode* n = static_cast<SPNode*>(o);
+						if (type == EventHandler::EVENT_NODESTARTED)
+							h->OnNodeStarted(g, n);
+						else
+							h->OnNodeStopped(g, n);
+					} );
+					continue;
+				}
+
+				if (type == EventHandler::EVENT_NODESTARTED)
+					handler->OnNodeStarted(graph, node);
+				else
+					handler->OnNodeStopped(graph, node);
+			}
+		}
+
 		Core::Array<EventHandler*>			mEventHandlers;
+		Core::Array<EventHandler*>			mSubscribers[EventHandler::NUM_EVENTTYPES];		// handlers per event type
 		EventLogger*						mEventLogger;
 };
 
@@ -24,52 +24,153 @@
 #ifndef __CORE_EVENTMANAGERHELPERS_H
 #define __CORE_EVENTMANAGERHELPERS_H
 
+// include the required headers
+#include "String.h"
+#include <type_traits>
+
 /**
  * Helper macros for implementing the notify functions (contain loops that call all registered EventHandlers) in the EventManager. 
  * They allow us to implement event callbacks with zero overhead which is useful for frequently used core events,
  * but on the flipside disallow us to selectively disable/block them.
+ * Only the handlers that subscribed to the event type are called; handlers with queued delivery get the event posted to their queue
+ * (arguments are stored using EventArg, so strings outlive the notify call).
+ * Queued string arguments are stored inline in the event; only strings longer than EventString::MAX_INLINELENGTH allocate.
  */
-#define EVENT_CREATE_NOTIFY_FUNCTION_0(FNAME)					\
-	void FNAME() {												\
-		const uint32 size = mEventHandlers.Size();			\
-		for (uint32 i = 0; i<size; ++i)							\
-			if (mEventHandlers[i]->GetAcceptEvents() == true)	\
-				mEventHandlers[i]->FNAME(); }
-
-#define EVENT_CREATE_NOTIFY_FUNCTION_1(FNAME, TYPE1, VNAME1)	\
-	void FNAME(TYPE1 VNAME1) {									\
-		const uint32 size = mEventHandlers.Size();			\
-		for (uint32 i = 0; i<size; ++i)							\
-			if (mEventHandlers[i]->GetAcceptEvents() == true)	\
-				mEventHandlers[i]->FNAME( VNAME1 );		  }
-
-#define EVENT_CREATE_NOTIFY_FUNCTION_2(FNAME, TYPE1, VNAME1, TYPE2, VNAME2)	\
-	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2) {								\
-		const uint32 size = mEventHandlers.Size();						\
-		for (uint32 i = 0; i<size; ++i)										\
-			if (mEventHandlers[i]->GetAcceptEvents() == true)				\
-				mEventHandlers[i]->FNAME( VNAME1, VNAME2 );			}
-
-#define EVENT_CREATE_NOTIFY_FUNCTION_3(FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3)	\
-	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3)	{								\
-		const uint32 size = mEventHandlers.Size();										\
-		for (uint32 i = 0; i<size; ++i)														\
-			if (mEventHandlers[i]->GetAcceptEvents() == true)								\
-				mEventHandlers[i]->FNAME( VNAME1, VNAME2, VNAME3 );		}
-
-#define EVENT_CREATE_NOTIFY_FUNCTION_4(FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3, TYPE4, VNAME4)	\
-	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3, TYPE4 VNAME4)	{									\
-		const uint32 size = mEventHandlers.Size();														\
-		for (uint32 i = 0; i<size; ++i)																		\
-			if (mEventHandlers[i]->GetAcceptEvents() == true)												\
-				mEventHandlers[i]->FNAME( VNAME1, VNAME2, VNAME3, VNAME4 ); }
-
-#define EVENT_CREATE_NOTIFY_FUNCTION_5(FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3, TYPE4, VNAME4, TYPE5, VNAME5)	\
-	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3, TYPE4 VNAME4, TYPE5 VNAME5)	{									\
-		const uint32 size = mEventHandlers.Size();																		\
-		for (uint32 i = 0; i<size; ++i)																						\
-			if (mEventHandlers[i]->GetAcceptEvents() == true)																\
-				mEventHandlers[i]->FNAME( VNAME1, VNAME2, VNAME3, VNAME4, VNAME5 ); }
 
+namespace Core
+{
+
+// storage of a queued event argument (by value by default)
+template <typename T>
+struct EventArg
+{
+	typedef typename std::decay<T>::type Type;
+	static Type Store(const Type& value)								{ return value; }
+	static const Type& Get(const Type& value)							{ return value; }
+};
+
+// string argument of a queued event: short strings (urls, texts, commands) are stored inline, longer ones on the heap
+class EventString
+{
+	public:
+		enum { MAX_INLINELENGTH = 95 };
+
+		EventString(const char* value)									{ Init( value != NULL ? value : "", value != NULL ? strlen(value) : 0 ); }
+		EventString(const EventString& other)							{ Init( other.AsChar(), other.mLength ); }
+		EventString(EventString&& other)								{ if (other.mHeap != NULL) { mHeap = other.mHeap; mLength = other.mLength; mInline[0] = '\0'; other.mHeap = NULL; } else Init( other.mInline, other.mLength ); }
+		~EventString()													{ delete[] mHeap; }
+
+		EventString& operator=(const EventString&) = delete;
+		EventString& operator=(EventString&&) = delete;
+
+		const char* AsChar() const										{ return (mHeap != NULL ? mHeap : mInline); }
+
+	private:
+		void Init(const char* value, size_t length)
+		{
+			mLength = length;
+			mHeap = NULL;
+
+			char* target = mInline;
+			if (length > MAX_INLINELENGTH)
+				target = mHeap = new char[length + 1];
+
+			memcpy(target, value, length);
+			target[length] = '\0';
+		}
+
+		char	mInline[MAX_INLINELENGTH + 1];
+		char*	mHeap;
+		size_t	mLength;
+};
+
+// strings are copied, the caller's buffer is only valid during the notify call
+template <>
+struct EventArg<const char*>
+{
+	typedef EventString Type;
+	static Type Store(const char* value)								{ return Type(value); }
+	static const char* Get(const Type& value)							{ return value.AsChar(); }
+};
+
+} // namespace Core
+
+#define EVENT_CREATE_NOTIFY_FUNCTION_0(EVENTTYPE, FNAME)												\
+	void FNAME() {																						\
+		const Core::Array<Core::EventHandler*>& handlers = mSubscribers[Core::EventHandler::EVENTTYPE];	\
+		const uint32 size = handlers.Size();															\
+		for (uint32 i = 0; i<size; ++i) {																\
+			Core::EventHandler* handler = handlers[i];													\
+			if (handler->GetAcceptEvents() == false)													\
+				continue;																				\
+			if (handler->IsQueuedDelivery(Core::EventHandler::EVENTTYPE) == true) {													\
+				handler->PostEvent( [](Core::EventHandler* h) { h->FNAME(); } ); }						\
+			else																						\
+				handler->FNAME(); } }
+
+#define EVENT_CREATE_NOTIFY_FUNCTION_1(EVENTTYPE, FNAME, TYPE1, VNAME1)													\
+	void FNAME(TYPE1 VNAME1) {																							\
+		const Core::Array<Core::EventHandler*>& handlers = mSubscribers[Core::EventHandler::EVENTTYPE];					\
+		const uint32 size = handlers.Size();																			\
+		for (uint32 i = 0; i<size; ++i) {																				\
+			Core::EventHandler* handler = handlers[i];																	\
+			if (handler->GetAcceptEvents() == false)																	\
+				continue;																								\
+			if (handler->IsQueuedDelivery(Core::EventHandler::EVENTTYPE) == true) {																	\
+				handler->PostEvent( [arg1 = Core::EventArg<TYPE1>::Store(VNAME1)](Core::EventHandler* h) { h->FNAME( Core::EventArg<TYPE1>::Get(arg1) ); } ); }	\
+			else																										\
+				handler->FNAME( VNAME1 ); } }
+
+#define EVENT_CREATE_NOTIFY_FUNCTION_2(EVENTTYPE, FNAME, TYPE1, VNAME1, TYPE2, VNAME2)																	\
+	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2) {																											\
+		const Core::Array<Core::EventHandler*>& handlers = mSubscribers[Core::EventHandler::EVENTTYPE];													\
+		const uint32 size = handlers.Size();																											\
+		for (uint32 i = 0; i<size; ++i) {																												\
+			Core::EventHandler* handler = handlers[i];																									\
+			if (handler->GetAcceptEvents() == false)																									\
+				continue;																																\
+			if (handler->IsQueuedDelivery(Core::EventHandler::EVENTTYPE) == true) {																									\
+				handler->PostEvent( [arg1 = Core::EventArg<TYPE1>::Store(VNAME1), arg2 = Core::EventArg<TYPE2>::Store(VNAME2)](Core::EventHandler* h) { h->FNAME( Core::EventArg<TYPE1>::Get(arg1), Core::EventArg<TYPE2>::Get(arg2) ); } ); }	\
+			else																																		\
+				handler->FNAME( VNAME1, VNAME2 ); } }
+
+#define EVENT_CREATE_NOTIFY_FUNCTION_3(EVENTTYPE, FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3)																						\
+	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3) {																																	\
+		const Core::Array<Core::EventHandler*>& handlers = mSubscribers[Core::EventHandler::EVENTTYPE];																						\
+		const uint32 size = handlers.Size();																																				\
+		for (uint32 i = 0; i<size; ++i) {																																					\
+			Core::EventHandler* handler = handlers[i];																																		\
+			if (handler->GetAcceptEvents() == false)																																		\
+				continue;																																									\
+			if (handler->IsQueuedDelivery(Core::EventHandler::EVENTTYPE) == true) {																																		\
+				handler->PostEvent( [arg1 = Core::EventArg<TYPE1>::Store(VNAME1), arg2 = Core::EventArg<TYPE2>::Store(VNAME2), arg3 = Core::EventArg<TYPE3>::Store(VNAME3)](Core::EventHandler* h) { h->FNAME( Core::EventArg<TYPE1>::Get(arg1), Core::EventArg<TYPE2>::Get(arg2), Core::EventArg<TYPE3>::Get(arg3) ); } ); }	\
+			else																																											\
+				handler->FNAME( VNAME1, VNAME2, VNAME3 ); } }
+
+#define EVENT_CREATE_NOTIFY_FUNCTION_4(EVENTTYPE, FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3, TYPE4, VNAME4)																										\
+	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3, TYPE4 VNAME4) {																																					\
+		const Core::Array<Core::EventHandler*>& handlers = mSubscribers[Core::EventHandler::EVENTTYPE];																														\
+		const uint32 size = handlers.Size();																																												\
+		for (uint32 i = 0; i<size; ++i) {																																													\
+			Core::EventHandler* handler = handlers[i];																																										\
+			if (handler->GetAcceptEvents() == false)																																										\
+				continue;																																																	\
+			if (handler->IsQueuedDelivery(Core::EventHandler::EVENTTYPE) == true) {																																										\
+				handler->PostEvent( [arg1 = Core::EventArg<TYPE1>::Store(VNAME1), arg2 = Core::EventArg<TYPE2>::Store(VNAME2), arg3 = Core::EventArg<TYPE3>::Store(VNAME3), arg4 = Core::EventArg<TYPE4>::Store(VNAME4)](Core::EventHandler* h) { h->FNAME( Core::EventArg<TYPE1>::Get(arg1), Core::EventArg<TYPE2>::Get(arg2), Core::EventArg<TYPE3>::Get(arg3), Core::EventArg<TYPE4>::Get(arg4) ); } ); }	\
+			else																																																			\
+				handler->FNAME( VNAME1, VNAME2, VNAME3, VNAME4 ); } }
+
+#define EVENT_CREATE_NOTIFY_FUNCTION_5(EVENTTYPE, FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3, TYPE4, VNAME4, TYPE5, VNAME5)																																\
+	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3, TYPE4 VNAME4, TYPE5 VNAME5) {																																											\
+		const Core::Array<Core::EventHandler*>& handlers = mSubscribers[Core::EventHandler::EVENTTYPE];																																							\
+		const uint32 size = handlers.Size();																																																					\
+		for (uint32 i = 0; i<size; ++i) {																																																						\
+			Core::EventHandler* handler = handlers[i];																																																			\
+			if (handler->GetAcceptEvents() == false)																																																			\
+				continue;																																																										\
+			if (handler->IsQueuedDelivery(Core::EventHandler::EVENTTYPE) == true) {																																																			\
+				handler->PostEvent( [arg1 = Core::EventArg<TYPE1>::Store(VNAME1), arg2 = Core::EventArg<TYPE2>::Store(VNAME2), arg3 = Core::EventArg<TYPE3>::Store(VNAME3), arg4 = Core::EventArg<TYPE4>::Store(VNAME4), arg5 = Core::EventArg<TYPE5>::Store(VNAME5)](Core::EventHandler* h) { h->FNAME( Core::EventArg<TYPE1>::Get(arg1), Core::EventArg<TYPE2>::Get(arg2), Core::EventArg<TYPE3>::Get(arg3), Core::EventArg<TYPE4>::Get(arg4), Core::EventArg<TYPE5>::Get(arg5) ); } ); }	\
+			else																																																												\
+				handler->FNAME( VNAME1, VNAME2, VNAME3, VNAME4, VNAME5 ); } }
 
 #endif
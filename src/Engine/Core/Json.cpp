@@ -420,6 +420,8 @@ Json::Item Json::Item::operator[](uint32 index) const
 // constructor
 Json::Json()
 {
+	mInsituBuffer = NULL;
+
 	// define the document as an object
 	mDocument.SetObject();
 }
@@ -428,8 +430,8 @@ Json::Json()
 // copy constructor
 Json::Json(const Json& other)
 {
-	// define the document as an object
-	mDocument.CopyFrom( other.mDocument, mDocument.GetAllocator() );
+	mInsituBuffer = NULL;
+	CopyDocument(other);
 }
 
 
@@ -438,6 +440,8 @@ Json::Json(const Json::Item& object)
 {
 	CORE_ASSERT(object.IsObject() == true);
 
+	mInsituBuffer = NULL;
+
 	// define the document as an object
 	mDocument.SetObject();
 
@@ -452,6 +456,7 @@ Json::Json(const Json::Item& object)
 // destructor
 Json::~Json()
 {
+	ReleaseInsituBuffer();
 }
 
 
@@ -460,6 +465,7 @@ void Json::Clear()
 {
 	// define the document as an object
 	mDocument.SetObject();
+	ReleaseInsituBuffer();
 }
 
 
@@ -525,14 +531,32 @@ bool Json::Parse(const char* input)
 	if (mDocument.Parse(input).HasParseError())
 		return false;
 
+	// the document doesn't reference an in-situ buffer anymore
+	ReleaseInsituBuffer();
 	return true;
 }
 
 
+// parse in-situ
+bool Json::ParseInsitu(const char* input)
+{
+	const size_t length = strlen(input);
+
+	// keep the previous buffer alive until the document got replaced
+	char* oldBuffer = mInsituBuffer;
+	mInsituBuffer = new char[length+1];
+	memcpy( mInsituBuffer, input, length+1 );
+
+	const bool result = ParseInsituBuffer();
+	delete[] oldBuffer;
+	return result;
+}
+
+
 // parse from file
 bool Json::ParseFile(const char* filename)
 {
-	// create the file on disk
+	// open the file
 	FILE* file;
 	file = fopen(filename, "rb\0");
 	if (file == NULL)
@@ -545,26 +569,50 @@ bool Json::ParseFile(const char* filename)
 	long fileSize = ftell(file);
 	fseek(file, 0, SEEK_SET);
 
-	// load the whole file into a string
-	char* stringData = new char[fileSize+1];
+	// load the whole file into the in-situ buffer, the document decodes its strings directly inside of it
+	char* oldBuffer = mInsituBuffer;
+	mInsituBuffer = new char[fileSize+1];
 
-	if (fread(stringData, fileSize, 1, file) < 0)
+	if (fileSize > 0 && fread(mInsituBuffer, fileSize, 1, file) != 1)
 	{
 		LogError( "Json::ParseFromFile(): Cannot read file '%s'.", filename );
-		delete[] stringData;
+		fclose(file);
+		delete[] mInsituBuffer;
+		mInsituBuffer = oldBuffer;
 		return false;
 	}
-	stringData[fileSize] = '\0';
+	mInsituBuffer[fileSize] = '\0';
 
 	fclose(file);
 
-	// load json from string data
-	bool result = Parse( stringData );
-	delete[] stringData;
+	const bool result = ParseInsituBuffer();
+	delete[] oldBuffer;
 	return result;
 }
 
 
+// parse the in-situ buffer
+bool Json::ParseInsituBuffer()
+{
+	if (mDocument.ParseInsitu(mInsituBuffer).HasParseError())
+	{
+		// rapidjson leaves the previous document untouched on errors, which might still point into the old buffer
+		mDocument.SetObject();
+		return false;
+	}
+
+	return true;
+}
+
+
+// release the in-situ buffer (only call this after the document stopped referencing it)
+void Json::ReleaseInsituBuffer()
+{
+	delete[] mInsituBuffer;
+	mInsituBuffer = NULL;
+}
+
+
 // serialize to string
 void Json::WriteToString(Core::String& outString, bool pretty) const
 {
@@ -618,11 +666,32 @@ bool Json::WriteToFile(const char* filename, bool pretty) const
 // copy assignment operator
 Json& Json::operator=(const Json& other)
 {
-	mDocument.CopyFrom( other.mDocument, mDocument.GetAllocator() );
+	if (this != &other)
+		CopyDocument(other);
+
 	return *this;
 }
 
 
+// deep copy the document of another json
+void Json::CopyDocument(const Json& other)
+{
+	// in-situ parsed strings are only references into the buffer of the other json and the rapidjson copy would keep them that way, so go via text
+	if (other.mInsituBuffer != NULL)
+	{
+		String text;
+		other.WriteToString( text, false );
+		ParseInsitu( text.AsChar() );
+		return;
+	}
+
+	mDocument.CopyFrom( other.mDocument, mDocument.GetAllocator() );
+
+	// the deep copy doesn't reference our in-situ buffer anymore
+	ReleaseInsituBuffer();
+}
+
+
 //
 //// move assignment operator
 //Json& Json::operator=(Json&& other)
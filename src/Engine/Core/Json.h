@@ -133,6 +133,10 @@ class ENGINE_API Json
 		bool Parse(const char* input);
 		bool ParseFile(const char* filename);
 
+		// in-situ parsing: the input is copied once into a buffer owned by this object and strings are decoded in place (no per-string allocations)
+		// NOTE: string values of an in-situ parsed json reference that buffer, Item::AddJson() subtrees of it into other jsons only while this one is alive
+		bool ParseInsitu(const char* input);
+
 		// serialize json to string
 		void WriteToString(Core::String& outString, bool pretty=true) const;
 		bool WriteToFile(const char* filename, bool pretty=true) const;
@@ -145,7 +149,12 @@ class ENGINE_API Json
 		//Json& operator=(Json&& other);
 
 	private:
+		void CopyDocument(const Json& other);
+		bool ParseInsituBuffer();
+		void ReleaseInsituBuffer();
+
 		rapidjson::Document mDocument;
+		char*				mInsituBuffer;		// source text of the last in-situ parse, string values point into it
 };
 
 }; // namespace Core
@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __CORE_LOCKFREEQUEUE_H
+#define __CORE_LOCKFREEQUEUE_H
+
+// include required headers
+#include "StandardHeaders.h"
+#include <atomic>
+#include <utility>
+
+
+namespace Core
+{
+
+/**
+ * Unbounded lock-free queue for multiple producer threads and a single consumer thread.
+ * The nodes come from a pool that is allocated up front, so Push() does not allocate as long as the pool lasts (it falls back to the heap once the pool is exhausted).
+ * Push() never blocks, Pop() must only be called from one thread at a time.
+ * NOTE: the value type has to be default constructible and move assignable (the queue always keeps one dummy node).
+ */
+template <class T>
+class LockFreeQueue
+{
+	public:
+		// constructor & destructor
+		LockFreeQueue(uint32 numPoolNodes = 256)
+		{
+			// chain all pool nodes into the free list (stored as index + 1, zero marks the end of the list)
+			mNumPoolNodes = numPoolNodes;
+			mPool = new Node[numPoolNodes];
+			for (uint32 i=0; i<numPoolNodes; ++i)
+				mPool[i].mNextFree.store(i + 2 < numPoolNodes + 1 ? i + 2 : 0, std::memory_order_relaxed);
+			mFreeList.store(numPoolNodes > 0 ? 1 : 0, std::memory_order_relaxed);
+
+			Node* stub = AllocNode();
+			mHead.store(stub, std::memory_order_relaxed);
+			mTail = stub;
+		}
+
+		~LockFreeQueue()
+		{
+			T item;
+			while (Pop(item) == true) {}
+
+			FreeNode(mTail);
+			delete[] mPool;
+		}
+
+		// append an item (any thread)
+		void Push(T&& item)
+		{
+			Node* node = AllocNode();
+			node->mValue = std::move(item);
+			LinkNode(node);
+		}
+
+		void Push(const T& item)
+		{
+			Node* node = AllocNode();
+			node->mValue = item;
+			LinkNode(node);
+		}
+
+		// remove the oldest item (consumer thread only), returns false in case the queue is empty
+		bool Pop(T& outItem)
+		{
+			Node* tail = mTail;
+			Node* next = tail->mNext.load(std::memory_order_acquire);
+			if (next == NULL)
+				return false;
+
+			// the popped node becomes the new dummy node
+			outItem = std::move(next->mValue);
+			mTail = next;
+			FreeNode(tail);
+
+			return true;
+		}
+
+		// consumer thread only
+		bool IsEmpty() const												{ return mTail->mNext.load(std::memory_order_acquire) == NULL; }
+
+	private:
+		struct Node
+		{
+			Node() : mNext(NULL), mNextFree(0)								{}
+
+			std::atomic<Node*>	mNext;
+			std::atomic<uint32>	mNextFree;		// next node in the free list (index + 1)
+			T					mValue;
+		};
+
+		// link the node behind the previous head, the consumer sees it as soon as the next pointer is set
+		void LinkNode(Node* node)
+		{
+			Node* previous = mHead.exchange(node, std::memory_order_acq_rel);
+			previous->mNext.store(node, std::memory_order_release);
+		}
+
+		// take a node from the free list (any thread)
+		// the list head carries a tag that changes with every modification, so a producer that got preempted can't pop a node that was reused in the meantime (ABA)
+		Node* AllocNode()
+		{
+			uint64 freeList = mFreeList.load(std::memory_order_acquire);
+			for (;;)
+			{
+				const uint32 index = (uint32)(freeList & 0xFFFFFFFF);
+				if (index == 0)
+					return new Node();
+
+				Node* node = &mPool[index - 1];
+				const uint64 next = (((freeList >> 32) + 1) << 32) | node->mNextFree.load(std::memory_order_relaxed);
+				if (mFreeList.compare_exchange_weak(freeList, next, std::memory_order_acquire, std::memory_order_acquire) == true)
+				{
+					node->mNext.store(NULL, std::memory_order_relaxed);
+					return node;
+				}
+			}
+		}
+
+		// return a node to the free list (consumer thread only), nodes from the heap are deleted
+		void FreeNode(Node* node)
+		{
+			const uintptr_t address = (uintptr_t)node;
+			if (address < (uintptr_t)mPool || address >= (uintptr_t)(mPool + mNumPoolNodes))
+			{
+				delete node;
+				return;
+			}
+
+			// release what the value holds right away instead of when the node gets reused
+			node->mValue = T();
+
+			const uint32 index = (uint32)(node - mPool) + 1;
+			uint64 freeList = mFreeList.load(std::memory_order_relaxed);
+			uint64 next;
+			do
+			{
+				node->mNextFree.store((uint32)(freeList & 0xFFFFFFFF), std::memory_order_relaxed);
+				next = (((freeList >> 32) + 1) << 32) | index;
+			} while (mFreeList.compare_exchange_weak(freeList, next, std::memory_order_release, std::memory_order_relaxed) == false);
+		}
+
+		std::atomic<Node*>	mHead;			// last pushed node (producers)
+		Node*				mTail;			// dummy node in front of the oldest item (consumer)
+
+		Node*				mPool;
+		uint32				mNumPoolNodes;
+		std::atomic<uint64>	mFreeList;		// tag in the upper and index + 1 of the first free pool node in the lower 32 bits
+};
+
+} // namespace Core
+
+
+#endif
@@ -0,0 +1,259 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include the required headers
+#include "MappedFile.h"
+#include "LogManager.h"
+
+#ifndef NEUROMORE_PLATFORM_WINDOWS
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <stdlib.h>
+#endif
+
+
+namespace Core
+{
+
+// the mapping grows at least by this amount, remapping is expensive
+#define MAPPEDFILE_MIN_GROWTH (64 * 1024 * 1024)
+
+
+// constructor
+MappedFile::MappedFile()
+{
+	mData = NULL;
+	mSize = 0;
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	mFile		= INVALID_HANDLE_VALUE;
+	mMapping	= NULL;
+#else
+	mFile		= -1;
+#endif
+}
+
+
+// destructor
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+
+// create the scratch file
+bool MappedFile::OpenScratch(const char* folder)
+{
+	Close();
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	char tempFolder[MAX_PATH];
+	if (folder == NULL || folder[0] == '\0')
+	{
+		if (GetTempPathA(MAX_PATH, tempFolder) == 0)
+			return false;
+		folder = tempFolder;
+	}
+
+	char filename[MAX_PATH];
+	if (GetTempFileNameA(folder, "nmc", 0, filename) == 0)
+	{
+		LogError("MappedFile: Cannot create scratch file in '%s'.", folder);
+		return false;
+	}
+
+	// deleted by the system as soon as the handle is closed
+	mFile = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+	if (mFile == INVALID_HANDLE_VALUE)
+	{
+		LogError("MappedFile: Cannot open scratch file '%s'.", filename);
+		return false;
+	}
+#else
+	String filename = (folder != NULL && folder[0] != '\0') ? folder : "";
+	if (filename.IsEmpty() == true)
+	{
+		const char* tempFolder = getenv("TMPDIR");
+		filename = (tempFolder != NULL && tempFolder[0] != '\0') ? tempFolder : "/tmp";
+	}
+	if (filename.GetLength() > 0 && filename.AsChar()[filename.GetLength()-1] != '/')
+		filename += "/";
+	filename += "neuromore-XXXXXX";
+
+	mFile = mkstemp(filename.AsChar());
+	if (mFile < 0)
+	{
+		LogError("MappedFile: Cannot create scratch file '%s'.", filename.AsChar());
+		return false;
+	}
+
+	// the file lives on until the descriptor gets closed
+	unlink(filename.AsChar());
+#endif
+
+	return Map(MAPPEDFILE_MIN_GROWTH);
+}
+
+
+// remove the scratch file
+void MappedFile::Close()
+{
+	Unmap();
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	if (mFile != INVALID_HANDLE_VALUE)
+		CloseHandle(mFile);
+	mFile = INVALID_HANDLE_VALUE;
+#else
+	if (mFile >= 0)
+		close(mFile);
+	mFile = -1;
+#endif
+
+	mSize = 0;
+}
+
+
+// grow the file to at least the given size
+bool MappedFile::Reserve(uint64 numBytes)
+{
+	if (numBytes <= mSize)
+		return true;
+
+	// grow geometrically
+	uint64 newSize = mSize + (mSize / 2);
+	if (newSize < mSize + MAPPEDFILE_MIN_GROWTH)
+		newSize = mSize + MAPPEDFILE_MIN_GROWTH;
+	if (newSize < numBytes)
+		newSize = numBytes;
+
+	Unmap();
+	return Map(newSize);
+}
+
+
+// set the file size and map all of it
+bool MappedFile::Map(uint64 numBytes)
+{
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	if (mFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	mMapping = CreateFileMappingA(mFile, NULL, PAGE_READWRITE, (DWORD)(numBytes >> 32), (DWORD)(numBytes & 0xFFFFFFFF), NULL);
+	if (mMapping == NULL)
+	{
+		LogError("MappedFile: Cannot map %llu bytes.", (unsigned long long)numBytes);
+		return false;
+	}
+
+	mData = (uint8*)MapViewOfFile(mMapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)numBytes);
+	if (mData == NULL)
+	{
+		CloseHandle(mMapping);
+		mMapping = NULL;
+		LogError("MappedFile: Cannot map %llu bytes.", (unsigned long long)numBytes);
+		return false;
+	}
+#else
+	if (mFile < 0)
+		return false;
+
+	if (ftruncate(mFile, (off_t)numBytes) != 0)
+	{
+		LogError("MappedFile: Cannot grow scratch file to %llu bytes.", (unsigned long long)numBytes);
+		return false;
+	}
+
+	void* data = mmap(NULL, (size_t)numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, mFile, 0);
+	if (data == MAP_FAILED)
+	{
+		LogError("MappedFile: Cannot map %llu bytes.", (unsigned long long)numBytes);
+		return false;
+	}
+	mData = (uint8*)data;
+#endif
+
+	mSize = numBytes;
+	return true;
+}
+
+
+// unmap the file (keeps it open)
+void MappedFile::Unmap()
+{
+	if (mData == NULL)
+		return;
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	UnmapViewOfFile(mData);
+	CloseHandle(mMapping);
+	mMapping = NULL;
+#else
+	munmap(mData, (size_t)mSize);
+#endif
+
+	mData = NULL;
+}
+
+
+// drop the pages of the given range from the working set
+void MappedFile::ReleasePages(uint64 offset, uint64 numBytes)
+{
+	if (mData == NULL || numBytes == 0 || offset + numBytes > mSize)
+		return;
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	// unlocking pages that are not locked removes them from the working set
+	VirtualUnlock(mData + offset, (SIZE_T)numBytes);
+#else
+	// only whole pages inside the range
+	const uint64 pageSize = GetPageSize();
+	const uint64 begin = (offset + pageSize - 1) / pageSize * pageSize;
+	const uint64 end = (offset + numBytes) / pageSize * pageSize;
+	if (end > begin)
+	{
+		// write back first, dropping a shared mapping keeps the data in the file
+		msync(mData + begin, (size_t)(end - begin), MS_ASYNC);
+		madvise(mData + begin, (size_t)(end - begin), MADV_DONTNEED);
+	}
+#endif
+}
+
+
+// memory page size
+uint64 MappedFile::GetPageSize()
+{
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwPageSize;
+#else
+	return (uint64)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+} // namespace Core
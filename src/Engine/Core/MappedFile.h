@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __CORE_MAPPEDFILE_H
+#define __CORE_MAPPEDFILE_H
+
+// include required headers
+#include "StandardHeaders.h"
+#include "String.h"
+
+
+namespace Core
+{
+
+/**
+ * Growable memory-mapped scratch file.
+ * The file is created in the given folder under a unique name and removed again when it gets closed (or the process ends).
+ * NOTE: growing the file remaps it, so pointers returned by GetData() are only valid until the next Reserve() call.
+ */
+class ENGINE_API MappedFile
+{
+	public:
+		// constructor & destructor
+		MappedFile();
+		~MappedFile();
+
+		// create the scratch file, folder can be empty for the system temp folder
+		bool OpenScratch(const char* folder);
+		void Close();
+		bool IsOpen() const														{ return mData != NULL; }
+
+		// grow the file (and the mapping) to at least the given size
+		bool Reserve(uint64 numBytes);
+
+		uint8* GetData()														{ return mData; }
+		uint64 GetSize() const													{ return mSize; }
+
+		// drop the pages of the given range from the working set, the data stays in the file
+		void ReleasePages(uint64 offset, uint64 numBytes);
+
+		// ranges aligned to this size can be released completely
+		static uint64 GetPageSize();
+
+	private:
+		bool Map(uint64 numBytes);
+		void Unmap();
+
+		uint8*		mData;
+		uint64		mSize;
+
+	#ifdef NEUROMORE_PLATFORM_WINDOWS
+		HANDLE		mFile;
+		HANDLE		mMapping;
+	#else
+		int			mFile;
+	#endif
+};
+
+} // namespace Core
+
+
+#endif
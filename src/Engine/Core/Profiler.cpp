@@ -0,0 +1,495 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "Profiler.h"
+#include "Json.h"
+#include "LogManager.h"
+#include <chrono>
+
+#if defined(NEUROMORE_CPU_X86ORX64)
+	#if (CORE_COMPILER == CORE_COMPILER_MSVC)
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#endif
+
+
+namespace Core
+{
+
+// seconds on the monotonic clock
+static double GetMonotonicTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// every profiler gets its own id so the per-thread buffer cache can't be confused by a new profiler at the same address
+static std::atomic<uint32> gProfilerInstanceCounter(0);
+
+// sort scopes by total time, most expensive first
+static int32 CORE_CDECL ScopeTotalTimeCompare(const Profiler::ScopeStatistics& itemA, const Profiler::ScopeStatistics& itemB)
+{
+	if (itemA.mTotalTime > itemB.mTotalTime) return -1;
+	else if (itemA.mTotalTime == itemB.mTotalTime) return 0;
+	else return 1;
+}
+
+
+// constructor
+Profiler::Profiler(uint32 numEventsPerThread) : mIsEnabled(false), mClearTicks(0)
+{
+	// round up to a power of two so we can mask the write index
+	mNumEventsPerThread = 1;
+	while (mNumEventsPerThread < numEventsPerThread)
+		mNumEventsPerThread <<= 1;
+
+	mInstanceID			= ++gProfilerInstanceCounter;
+	mClockStartTicks	= GetTicks();
+	mClockStartTime		= GetMonotonicTime();
+
+#if defined(NEUROMORE_CPU_X86ORX64)
+	mTicksPerSecond		= 0.0;
+#else
+	mTicksPerSecond		= 1000000000.0;
+#endif
+}
+
+
+// destructor
+Profiler::~Profiler()
+{
+	const uint32 numBuffers = mThreadBuffers.Size();
+	for (uint32 i=0; i<numBuffers; ++i)
+	{
+		Free( mThreadBuffers[i]->mEvents );
+		delete mThreadBuffers[i];
+	}
+}
+
+
+// enable or disable recording
+void Profiler::SetEnabled(bool enabled)
+{
+	mIsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+
+// register a new scope (reuses the id of an unregistered one)
+uint32 Profiler::RegisterScope(const char* name, const char* category)
+{
+	mLock.Lock();
+
+	uint32 scopeID;
+	if (mFreeScopeIDs.IsEmpty() == false)
+	{
+		scopeID = mFreeScopeIDs.GetLast();
+		mFreeScopeIDs.RemoveLast();
+	}
+	else
+	{
+		scopeID = mScopes.Size();
+		mScopes.AddEmpty();
+	}
+
+	Scope& scope = mScopes[scopeID];
+	scope.mName				= name;
+	scope.mCategory			= category;
+	scope.mMinStartTicks	= GetTicks();
+	scope.mIsRegistered		= true;
+
+	mLock.Unlock();
+	return scopeID;
+}
+
+
+// release a scope (e.g. when its node gets destroyed), its events are ignored from now on
+void Profiler::UnregisterScope(uint32 scopeID)
+{
+	mLock.Lock();
+
+	if (scopeID < mScopes.Size() && mScopes[scopeID].mIsRegistered == true)
+	{
+		Scope& scope = mScopes[scopeID];
+		scope.mName.Clear();
+		scope.mCategory.Clear();
+		scope.mIsRegistered = false;
+
+		mFreeScopeIDs.Add(scopeID);
+	}
+
+	mLock.Unlock();
+}
+
+
+// rename a scope (e.g. after a node got renamed)
+void Profiler::SetScopeName(uint32 scopeID, const char* name)
+{
+	mLock.Lock();
+
+	if (scopeID < mScopes.Size())
+		mScopes[scopeID].mName = name;
+
+	mLock.Unlock();
+}
+
+
+// get the number of registered scopes
+uint32 Profiler::GetNumScopes() const
+{
+	mLock.Lock();
+	const uint32 numScopes = mScopes.Size() - mFreeScopeIDs.Size();
+	mLock.Unlock();
+
+	return numScopes;
+}
+
+
+// get the current clock ticks
+uint64 Profiler::GetTicks()
+{
+#if defined(NEUROMORE_CPU_X86ORX64)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+// derive the tsc frequency from the time passed since construction (more accurate the longer the profiler lives), returns the new estimate
+double Profiler::CalibrateClock() const
+{
+#if defined(NEUROMORE_CPU_X86ORX64)
+	const double timeElapsed = GetMonotonicTime() - mClockStartTime;
+	if (timeElapsed < 0.001)
+	{
+		// too early for a reasonable estimate, assume a nominal 1 GHz
+		double ticksPerSecond = mTicksPerSecond.load(std::memory_order_relaxed);
+		if (ticksPerSecond <= 0.0)
+		{
+			ticksPerSecond = 1000000000.0;
+			mTicksPerSecond.store(ticksPerSecond, std::memory_order_relaxed);
+		}
+		return ticksPerSecond;
+	}
+
+	const double ticksPerSecond = (double)(GetTicks() - mClockStartTicks) / timeElapsed;
+	mTicksPerSecond.store(ticksPerSecond, std::memory_order_relaxed);
+	return ticksPerSecond;
+#else
+	return mTicksPerSecond.load(std::memory_order_relaxed);
+#endif
+}
+
+
+// get the ring buffer of the calling thread, registers one on first use
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+	// cache of the last used profiler, buffers are owned (and freed) by their profiler
+	static thread_local ThreadBuffer*	tBuffer = NULL;
+	static thread_local uint32			tInstanceID = 0;
+
+	if (tInstanceID == mInstanceID)
+		return tBuffer;
+
+	const std::thread::id threadID = std::this_thread::get_id();
+
+	mLock.Lock();
+
+	// the thread switched back from another profiler: reuse the buffer it already has here
+	ThreadBuffer* buffer = NULL;
+	const uint32 numBuffers = mThreadBuffers.Size();
+	for (uint32 i=0; i<numBuffers; ++i)
+	{
+		if (mThreadBuffers[i]->mThreadID == threadID)
+		{
+			buffer = mThreadBuffers[i];
+			break;
+		}
+	}
+
+	// first use on this thread
+	if (buffer == NULL)
+	{
+		buffer = new ThreadBuffer();
+		buffer->mEvents		= (Event*)Allocate( mNumEventsPerThread * sizeof(Event) );
+		buffer->mMask		= mNumEventsPerThread - 1;
+		buffer->mThreadID	= threadID;
+		buffer->mNumWritten.store(0, std::memory_order_relaxed);
+
+		buffer->mThreadIndex = mThreadBuffers.Size();
+		mThreadBuffers.Add(buffer);
+	}
+
+	mLock.Unlock();
+
+	tBuffer		= buffer;
+	tInstanceID	= mInstanceID;
+	return buffer;
+}
+
+
+// finish a measurement and record the event
+void Profiler::End(Marker& marker, uint32 scopeID, uint32 subIndex, uint32 numSamplesIn, uint32 numSamplesOut)
+{
+	if (marker.mIsOpen == false)
+		return;
+
+	const uint64 endTicks = GetTicks();
+	marker.mIsOpen = false;
+
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	// only the owning thread writes, readers detect overwritten slots using the write counter
+	const uint64 index = buffer->mNumWritten.load(std::memory_order_relaxed);
+	Event& event = buffer->mEvents[index & buffer->mMask];
+	event.mStartTicks		= marker.mStartTicks;
+	event.mNumTicks			= endTicks - marker.mStartTicks;
+	event.mScopeID			= scopeID;
+	event.mSubIndex			= subIndex;
+	event.mNumSamplesIn		= numSamplesIn;
+	event.mNumSamplesOut	= numSamplesOut;
+	event.mNumAllocations	= (uint32)(GetThreadAllocationCounter() - marker.mStartAllocations);
+	buffer->mNumWritten.store(index + 1, std::memory_order_release);
+}
+
+
+// copy the still valid events of a ring buffer
+void Profiler::CopyEvents(const ThreadBuffer* buffer, uint64 minStartTicks, Array<Event>& outEvents) const
+{
+	const uint64 capacity	= buffer->mMask + 1;
+	const uint64 numWritten	= buffer->mNumWritten.load(std::memory_order_acquire);
+	const uint64 first		= (numWritten > capacity ? numWritten - capacity : 0);
+
+	// remember the ring index of every copied event, the start time filter leaves gaps
+	const uint32 startIndex = outEvents.Size();
+	Array<uint64> ringIndices;
+	for (uint64 i=first; i<numWritten; ++i)
+	{
+		const Event& event = buffer->mEvents[i & buffer->mMask];
+		if (event.mStartTicks >= minStartTicks)
+		{
+			outEvents.Add(event);
+			ringIndices.Add(i);
+		}
+	}
+
+	// the writer may have wrapped around while we were copying: drop everything that could have been overwritten
+	// (including the slot of event numWrittenAfter, which the writer may be filling right now)
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const uint64 numWrittenAfter = buffer->mNumWritten.load(std::memory_order_relaxed);
+	if (numWrittenAfter - first >= capacity)
+	{
+		const uint64 firstValid = numWrittenAfter - capacity + 1;
+		uint32 numValid = 0;
+		const uint32 numCopied = ringIndices.Size();
+		for (uint32 i=0; i<numCopied; ++i)
+			if (ringIndices[i] >= firstValid)
+				outEvents[startIndex + numValid++] = outEvents[startIndex + i];
+		outEvents.Resize(startIndex + numValid);
+	}
+}
+
+
+// the event was recorded by the current owner of its scope
+bool Profiler::IsEventOfScope(const Event& event, const Array<Scope>& scopes) const
+{
+	if (event.mScopeID >= scopes.Size())
+		return false;
+
+	const Scope& scope = scopes[event.mScopeID];
+	return (scope.mIsRegistered == true && event.mStartTicks >= scope.mMinStartTicks);
+}
+
+
+// aggregate the events of the last seconds per scope
+void Profiler::CollectStatistics(Array<ScopeStatistics>& outStatistics, double windowSeconds) const
+{
+	outStatistics.Clear();
+	const double ticksPerSecond = CalibrateClock();
+
+	const uint64 nowTicks		= GetTicks();
+	const uint64 windowTicks	= (uint64)(windowSeconds * ticksPerSecond);
+	uint64 minStartTicks		= (nowTicks > windowTicks ? nowTicks - windowTicks : 0);
+	minStartTicks				= Max<uint64>( minStartTicks, mClearTicks.load(std::memory_order_relaxed) );
+
+	Array<Event> events;
+	Array<Scope> scopes;
+
+	mLock.Lock();
+
+	const uint32 numBuffers = mThreadBuffers.Size();
+	for (uint32 i=0; i<numBuffers; ++i)
+		CopyEvents( mThreadBuffers[i], minStartTicks, events );
+
+	scopes = mScopes;
+
+	mLock.Unlock();
+
+	// one entry per scope (unregistered scopes get no events and are removed below)
+	const uint32 numScopes = scopes.Size();
+	outStatistics.Resize(numScopes);
+	for (uint32 i=0; i<numScopes; ++i)
+	{
+		ScopeStatistics& stats = outStatistics[i];
+		stats.mScopeID			= i;
+		stats.mName				= scopes[i].mName;
+		stats.mCategory			= scopes[i].mCategory;
+		stats.mNumCalls			= 0;
+		stats.mTotalTime		= 0.0;
+		stats.mAverageTime		= 0.0;
+		stats.mMaxTime			= 0.0;
+		stats.mNumSamplesIn		= 0;
+		stats.mNumSamplesOut	= 0;
+		stats.mNumAllocations	= 0;
+	}
+
+	// accumulate (sub scope events are already contained in their parent scope event)
+	const double secondsPerTick = 1.0 / ticksPerSecond;
+	const uint32 numEvents = events.Size();
+	for (uint32 i=0; i<numEvents; ++i)
+	{
+		const Event& event = events[i];
+		if (event.mSubIndex != CORE_INVALIDINDEX32 || IsEventOfScope(event, scopes) == false)
+			continue;
+
+		ScopeStatistics& stats = outStatistics[event.mScopeID];
+		const double time = event.mNumTicks * secondsPerTick;
+
+		stats.mNumCalls++;
+		stats.mTotalTime		+= time;
+		stats.mMaxTime			= Max<double>( stats.mMaxTime, time );
+		stats.mNumSamplesIn		+= event.mNumSamplesIn;
+		stats.mNumSamplesOut	+= event.mNumSamplesOut;
+		stats.mNumAllocations	+= event.mNumAllocations;
+	}
+
+	// remove scopes that were not active in the window and sort by cost
+	for (uint32 i=0; i<outStatistics.Size();)
+	{
+		if (outStatistics[i].mNumCalls == 0)
+		{
+			outStatistics.Remove(i);
+			continue;
+		}
+
+		outStatistics[i].mAverageTime = outStatistics[i].mTotalTime / outStatistics[i].mNumCalls;
+		++i;
+	}
+
+	outStatistics.Sort( ScopeTotalTimeCompare );
+}
+
+
+// export the events of the last seconds as chrome trace events
+void Profiler::ExportChromeTrace(Json& outJson, double windowSeconds) const
+{
+	const double ticksPerSecond = CalibrateClock();
+
+	const uint64 nowTicks		= GetTicks();
+	const uint64 windowTicks	= (uint64)(windowSeconds * ticksPerSecond);
+	uint64 minStartTicks		= (nowTicks > windowTicks ? nowTicks - windowTicks : 0);
+	minStartTicks				= Max<uint64>( minStartTicks, mClearTicks.load(std::memory_order_relaxed) );
+
+	Array<Event>	events;
+	Array<uint32>	threadIndices;
+	Array<Scope>	scopes;
+
+	mLock.Lock();
+
+	const uint32 numBuffers = mThreadBuffers.Size();
+	for (uint32 i=0; i<numBuffers; ++i)
+	{
+		CopyEvents( mThreadBuffers[i], minStartTicks, events );
+		while (threadIndices.Size() < events.Size())
+			threadIndices.Add( mThreadBuffers[i]->mThreadIndex );
+	}
+
+	scopes = mScopes;
+
+	mLock.Unlock();
+
+	// timestamps and durations are in microseconds
+	const double microsecondsPerTick = 1000000.0 / ticksPerSecond;
+
+	Json::Item rootItem = outJson.GetRootItem();
+	Json::Item eventsItem = rootItem.AddArray("traceEvents");
+
+	String name;
+	const uint32 numEvents = events.Size();
+	for (uint32 i=0; i<numEvents; ++i)
+	{
+		const Event& event = events[i];
+		if (IsEventOfScope(event, scopes) == false)
+			continue;
+
+		name = scopes[event.mScopeID].mName;
+		if (event.mSubIndex != CORE_INVALIDINDEX32)
+			name.FormatAdd( " #%i", event.mSubIndex );
+
+		Json::Item eventItem = eventsItem.AddObject();
+		eventItem.AddString( "name", name.AsChar() );
+		eventItem.AddString( "cat", scopes[event.mScopeID].mCategory.AsChar() );
+		eventItem.AddString( "ph", "X" );
+		eventItem.AddDouble( "ts", (event.mStartTicks - mClockStartTicks) * microsecondsPerTick );
+		eventItem.AddDouble( "dur", event.mNumTicks * microsecondsPerTick );
+		eventItem.AddInt( "pid", 0 );
+		eventItem.AddInt( "tid", threadIndices[i] );
+
+		Json::Item argsItem = eventItem.AddObject("args");
+		argsItem.AddInt( "samplesIn", event.mNumSamplesIn );
+		argsItem.AddInt( "samplesOut", event.mNumSamplesOut );
+		argsItem.AddInt( "allocations", event.mNumAllocations );
+	}
+
+	rootItem.AddString( "displayTimeUnit", "ms" );
+}
+
+
+// export the events of the last seconds into a chrome trace file
+bool Profiler::ExportChromeTrace(const char* filename, double windowSeconds) const
+{
+	Json json;
+	ExportChromeTrace( json, windowSeconds );
+
+	if (json.WriteToFile(filename, false) == false)
+	{
+		LogError( "Profiler: Cannot write trace file '%s'.", filename );
+		return false;
+	}
+
+	return true;
+}
+
+
+// drop all recorded events
+void Profiler::Clear()
+{
+	mClearTicks.store( GetTicks(), std::memory_order_relaxed );
+}
+
+}
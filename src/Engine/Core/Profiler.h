@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __CORE_PROFILER_H
+#define __CORE_PROFILER_H
+
+// include required headers
+#include "StandardHeaders.h"
+#include "Array.h"
+#include "String.h"
+#include "Mutex.h"
+#include <atomic>
+#include <thread>
+
+
+namespace Core
+{
+
+// forward declaration
+class Json;
+
+// low overhead hot-path profiler
+// events are recorded lock-free into per-thread ring buffers; aggregation and trace export only read them
+class ENGINE_API Profiler
+{
+	public:
+		// a single recorded event
+		struct Event
+		{
+			uint64	mStartTicks;
+			uint64	mNumTicks;
+			uint32	mScopeID;
+			uint32	mSubIndex;					// sub scope (e.g. processor index inside a node), CORE_INVALIDINDEX32 for the scope itself
+			uint32	mNumSamplesIn;
+			uint32	mNumSamplesOut;
+			uint32	mNumAllocations;
+		};
+
+		// an open measurement, see Begin() and End()
+		struct Marker
+		{
+			Marker() : mStartTicks(0), mStartAllocations(0), mIsOpen(false)	{}
+
+			uint64	mStartTicks;
+			uint64	mStartAllocations;
+			bool	mIsOpen;
+		};
+
+		// aggregated statistics of a scope over a time window
+		struct ScopeStatistics
+		{
+			uint32	mScopeID;
+			String	mName;
+			String	mCategory;
+			uint32	mNumCalls;
+			double	mTotalTime;					// in seconds
+			double	mAverageTime;				// in seconds
+			double	mMaxTime;					// in seconds
+			uint64	mNumSamplesIn;
+			uint64	mNumSamplesOut;
+			uint64	mNumAllocations;
+		};
+
+		// constructor & destructor
+		Profiler(uint32 numEventsPerThread=65536);
+		~Profiler();
+
+		// enable or disable recording (disabled by default)
+		void SetEnabled(bool enabled);
+		inline bool IsEnabled() const												{ return mIsEnabled.load(std::memory_order_relaxed); }
+
+		// scopes (e.g. one per node); the scope id stays valid until the scope gets unregistered, then it may be handed out again
+		uint32 RegisterScope(const char* name, const char* category);
+		void UnregisterScope(uint32 scopeID);
+		void SetScopeName(uint32 scopeID, const char* name);
+		uint32 GetNumScopes() const;
+
+		// measure a section: call Begin() before and End() after it, End() does nothing if the profiler was disabled in Begin()
+		inline void Begin(Marker& marker)											{ marker.mIsOpen = IsEnabled(); if (marker.mIsOpen == false) return; marker.mStartAllocations = GetThreadAllocationCounter(); marker.mStartTicks = GetTicks(); }
+		void End(Marker& marker, uint32 scopeID, uint32 subIndex=CORE_INVALIDINDEX32, uint32 numSamplesIn=0, uint32 numSamplesOut=0);
+
+		// clock (tsc on x86/x64, monotonic clock elsewhere)
+		static uint64 GetTicks();
+		inline double GetTicksPerSecond() const										{ return mTicksPerSecond.load(std::memory_order_relaxed); }
+
+		// aggregate all events that started within the last windowSeconds seconds (sorted by total time, descending)
+		void CollectStatistics(Array<ScopeStatistics>& outStatistics, double windowSeconds) const;
+
+		// export all events of the last windowSeconds seconds in the chrome trace event format (chrome://tracing, perfetto)
+		void ExportChromeTrace(Json& outJson, double windowSeconds) const;
+		bool ExportChromeTrace(const char* filename, double windowSeconds) const;
+
+		// drop all recorded events (scopes stay registered)
+		void Clear();
+
+	private:
+		// the event ring buffer of a single thread
+		struct ThreadBuffer
+		{
+			Event*					mEvents;
+			uint32					mMask;
+			uint32					mThreadIndex;
+			std::thread::id			mThreadID;			// owning thread, a thread keeps its buffer when it switches between profilers
+			std::atomic<uint64>		mNumWritten;
+		};
+
+		struct Scope
+		{
+			String	mName;
+			String	mCategory;
+			uint64	mMinStartTicks;				// events that started earlier belong to a previous owner of the scope id
+			bool	mIsRegistered;
+		};
+
+		ThreadBuffer* GetThreadBuffer();
+		void CopyEvents(const ThreadBuffer* buffer, uint64 minStartTicks, Array<Event>& outEvents) const;
+		bool IsEventOfScope(const Event& event, const Array<Scope>& scopes) const;
+		double CalibrateClock() const;
+
+		Array<ThreadBuffer*>	mThreadBuffers;
+		Array<Scope>			mScopes;
+		Array<uint32>			mFreeScopeIDs;			// unregistered scopes, reused by RegisterScope()
+		mutable Mutex			mLock;
+		std::atomic<bool>		mIsEnabled;
+		uint32					mNumEventsPerThread;
+		uint32					mInstanceID;
+		std::atomic<uint64>		mClearTicks;			// events started before this are ignored
+		uint64					mClockStartTicks;
+		double					mClockStartTime;
+		mutable std::atomic<double>	mTicksPerSecond;		// recalibrated by the const readers, which may run on any thread
+};
+
+}
+
+#endif
@@ -0,0 +1,229 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __CORE_SEQLOCK_H
+#define __CORE_SEQLOCK_H
+
+// include required headers
+#include "StandardHeaders.h"
+#include "Array.h"
+#include <atomic>
+
+
+namespace Core
+{
+
+/**
+ * Double-buffered sequence lock for publishing a small array of values from one writer thread to any number of readers.
+ * The writer fills the slot that is not published, so Publish() never waits for readers and readers never take a lock.
+ * A read only has to be repeated if the writer published twice while it was copying (the sequence of the slot changed).
+ * The capacity is set at runtime by the writer using Reserve(); it only grows and the replaced buffers are kept until destruction,
+ * because a reader might still copy from them (growing geometrically keeps them below the size of the current buffers).
+ * NOTE: the value type has to be trivially copyable and lock-free as std::atomic, Publish() and Reserve() must only be called from one thread at a time.
+ */
+template <class T>
+class SeqLockArray
+{
+	static_assert(std::atomic<T>::is_always_lock_free, "SeqLockArray needs lock-free atomic values");
+
+	public:
+		// constructor
+		SeqLockArray(uint32 capacity = 0) : mPublished(0), mCapacity(0)
+		{
+			for (uint32 s=0; s<2; ++s)
+			{
+				mSlots[s].mSequence.store(0, std::memory_order_relaxed);
+				mSlots[s].mNumValues.store(0, std::memory_order_relaxed);
+				mSlots[s].mTimestamp.store(0.0, std::memory_order_relaxed);
+				mSlots[s].mBuffer.store(NULL, std::memory_order_relaxed);
+			}
+
+			Reserve(capacity);
+		}
+
+		// destructor
+		~SeqLockArray()
+		{
+			const uint32 numBuffers = mBuffers.Size();
+			for (uint32 i=0; i<numBuffers; ++i)
+				DestroyBuffer(mBuffers[i]);
+		}
+
+		// make room for the given number of values (writer thread), readers keep working on the old buffers meanwhile
+		void Reserve(uint32 capacity)
+		{
+			if (capacity <= mCapacity)
+				return;
+
+			// grow geometrically, so the replaced buffers that are kept alive never sum up to more than the current ones
+			uint32 newCapacity = (mCapacity < 8 ? 8 : mCapacity * 2);
+			while (newCapacity < capacity)
+				newCapacity *= 2;
+
+			// the published slot keeps its buffer until the next publish, the copy makes the new buffer complete right away
+			for (uint32 s=0; s<2; ++s)
+			{
+				Slot& slot = mSlots[s];
+				Buffer* buffer = CreateBuffer(newCapacity);
+				const Buffer* oldBuffer = slot.mBuffer.load(std::memory_order_relaxed);
+				const uint32 numValues = slot.mNumValues.load(std::memory_order_relaxed);
+				for (uint32 i=0; i<numValues; ++i)
+					buffer->mValues[i].store(oldBuffer->mValues[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+				slot.mBuffer.store(buffer, std::memory_order_release);
+			}
+
+			mCapacity = newCapacity;
+		}
+
+		// publish a new snapshot (writer thread), values beyond the capacity are skipped
+		void Publish(const T* values, uint32 numValues, double timestamp)
+		{
+			if (numValues > mCapacity)
+				numValues = mCapacity;
+
+			// fill the unpublished slot, an odd sequence marks it as being written
+			const uint32 index = 1 - mPublished.load(std::memory_order_relaxed);
+			Slot& slot = mSlots[index];
+
+			const uint32 sequence = slot.mSequence.load(std::memory_order_relaxed);
+			slot.mSequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			Buffer* buffer = slot.mBuffer.load(std::memory_order_relaxed);
+			for (uint32 i=0; i<numValues; ++i)
+				buffer->mValues[i].store(values[i], std::memory_order_relaxed);
+			slot.mNumValues.store(numValues, std::memory_order_relaxed);
+			slot.mTimestamp.store(timestamp, std::memory_order_relaxed);
+
+			slot.mSequence.store(sequence + 2, std::memory_order_release);
+			mPublished.store(index, std::memory_order_release);
+		}
+
+		// copy the latest snapshot (any thread), returns the number of values in it (only maxValues of them are copied)
+		uint32 Read(T* outValues, uint32 maxValues, double* outTimestamp) const
+		{
+			for (;;)
+			{
+				const Slot& slot = mSlots[mPublished.load(std::memory_order_acquire)];
+
+				const uint32 sequence = slot.mSequence.load(std::memory_order_acquire);
+				if ((sequence & 1) != 0)
+					continue;
+
+				// the number of values might belong to a newer publish than the buffer, never copy beyond its capacity
+				const Buffer* buffer = slot.mBuffer.load(std::memory_order_acquire);
+				const uint32 numValues = slot.mNumValues.load(std::memory_order_relaxed);
+				uint32 numCopy = (numValues < maxValues ? numValues : maxValues);
+				if (buffer == NULL)
+					numCopy = 0;
+				else if (numCopy > buffer->mCapacity)
+					numCopy = buffer->mCapacity;
+
+				for (uint32 i=0; i<numCopy; ++i)
+					outValues[i] = buffer->mValues[i].load(std::memory_order_relaxed);
+				const double timestamp = slot.mTimestamp.load(std::memory_order_relaxed);
+
+				// retry in case the slot got rewritten meanwhile
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (slot.mSequence.load(std::memory_order_relaxed) != sequence)
+					continue;
+
+				if (outTimestamp != NULL)
+					*outTimestamp = timestamp;
+
+				return numValues;
+			}
+		}
+
+		// single value of the latest snapshot (any thread), returns false in case the index is not part of it
+		bool ReadValue(uint32 index, T& outValue) const
+		{
+			for (;;)
+			{
+				const Slot& slot = mSlots[mPublished.load(std::memory_order_acquire)];
+
+				const uint32 sequence = slot.mSequence.load(std::memory_order_acquire);
+				if ((sequence & 1) != 0)
+					continue;
+
+				const Buffer* buffer = slot.mBuffer.load(std::memory_order_acquire);
+				const bool valid = (buffer != NULL && index < slot.mNumValues.load(std::memory_order_relaxed) && index < buffer->mCapacity);
+				const T value = (valid ? buffer->mValues[index].load(std::memory_order_relaxed) : T());
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (slot.mSequence.load(std::memory_order_relaxed) != sequence)
+					continue;
+
+				outValue = value;
+				return valid;
+			}
+		}
+
+		// capacity of the writer (readers might still use smaller, replaced buffers)
+		uint32 GetCapacity() const											{ return mCapacity; }
+
+	private:
+		// value buffer, never changes its capacity
+		struct Buffer
+		{
+			uint32				mCapacity;
+			std::atomic<T>*		mValues;
+		};
+
+		Buffer* CreateBuffer(uint32 capacity)
+		{
+			Buffer* buffer = new Buffer();
+			buffer->mCapacity = capacity;
+			buffer->mValues = new std::atomic<T>[capacity];
+			for (uint32 i=0; i<capacity; ++i)
+				buffer->mValues[i].store(T(), std::memory_order_relaxed);
+
+			mBuffers.Add(buffer);
+			return buffer;
+		}
+
+		static void DestroyBuffer(Buffer* buffer)
+		{
+			delete[] buffer->mValues;
+			delete buffer;
+		}
+
+		struct Slot
+		{
+			std::atomic<uint32>		mSequence;
+			std::atomic<uint32>		mNumValues;
+			std::atomic<double>		mTimestamp;
+			std::atomic<Buffer*>	mBuffer;
+		};
+
+		Slot					mSlots[2];
+		std::atomic<uint32>		mPublished;		// index of the slot readers use
+		uint32					mCapacity;		// capacity of the current buffers (writer only)
+		Array<Buffer*>			mBuffers;		// all buffers ever created, including the replaced ones (writer only)
+};
+
+} // namespace Core
+
+
+#endif
@@ -85,13 +85,22 @@
 namespace Core
 {
 
+// number of heap allocations done by the calling thread through Allocate() and Realloc() (used by the profiler)
+inline uint64& GetThreadAllocationCounter()
+{
+	static thread_local uint64 numAllocations = 0;
+	return numAllocations;
+}
+
 inline void* Allocate(size_t numBytes)
 {
+	GetThreadAllocationCounter()++;
 	return malloc(numBytes);
 }
 
 inline void* Realloc(void* memory, size_t numBytes)
 {
+	GetThreadAllocationCounter()++;
 	void* newMemPtr = realloc( memory, numBytes );
 
 	if (newMemPtr == NULL)
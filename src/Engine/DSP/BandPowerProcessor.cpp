@@ -0,0 +1,222 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required files
+#include "BandPowerProcessor.h"
+#include "Channel.h"
+#include "ChannelProcessor.h"
+
+
+using namespace Core;
+
+// constructor
+BandPowerProcessor::BandPowerProcessor()
+{
+	Init();
+	mIsInitialized = false;
+	mWindowPos = 0;
+	mNumSamples = 0;
+	mSamplesUntilOutput = 0;
+	mNumSpectrumBins = 0;
+}
+
+
+// destructor
+BandPowerProcessor::~BandPowerProcessor()
+{
+}
+
+
+// init band power processor
+void BandPowerProcessor::Init()
+{
+	// one double channel input
+	AddInput<double>();
+
+	// one double channel output
+	AddOutput<double>();
+}
+
+
+// reinit processor internals
+void BandPowerProcessor::ReInit()
+{
+	// ReInit baseclass
+	ChannelProcessor::ReInit();
+
+	mIsInitialized = false;
+
+	ChannelBase* input = GetInput();
+	ChannelBase* output = GetOutput();
+
+	// nothing to do until both channels are connected
+	if (input == NULL || output == NULL)
+		return;
+
+	// clamp shift parameter to > 0
+	if (mSettings.mEpochShift == 0)
+		mSettings.mEpochShift = 1;
+
+	// clamp FFT order to > 0
+	if (mSettings.mFFTOrder == 0)
+		mSettings.mFFTOrder = 1;
+
+	// calculate number of window samples
+	mSettings.mNumFFTSamples = Math::Pow(2, mSettings.mFFTOrder);
+	const uint32 numSamples = mSettings.mNumFFTSamples;
+	mNumSpectrumBins = numSamples / 2 + 1;
+
+	// select the bins inside the band (same bin frequencies as the spectrum of the FFT processor)
+	const double maxFrequency = input->GetSampleRate() / 2.0;
+	mBins.Clear();
+	for (uint32 k=0; k<mNumSpectrumBins; ++k)
+	{
+		const double frequency = k / (double)(mNumSpectrumBins - 1) * maxFrequency;
+		if (frequency > mSettings.mMaxFrequency || frequency < mSettings.mMinFrequency)
+			continue;
+
+		const double omega = 2.0 * Math::piD * k / (double)numSamples;
+
+		Bin bin;
+		bin.mIndex		 = k;
+		bin.mTwiddle	 = Complex(Math::CosD(omega), Math::SinD(omega));
+		bin.mCoefficient = 2.0 * Math::CosD(omega);
+		bin.mSpectrum	 = Complex(0.0, 0.0);
+		bin.mGoertzel1	 = 0.0;
+		bin.mGoertzel2	 = 0.0;
+		mBins.Add(bin);
+	}
+
+	// empty window
+	mWindow.Resize(numSamples);
+	for (uint32 i=0; i<numSamples; ++i)
+		mWindow[i] = 0.0;
+
+	mWindowPos = 0;
+	mNumSamples = 0;
+	mSamplesUntilOutput = numSamples;
+
+	// calculate output sample rate
+	double outputSampleRate = input->GetSampleRate() / (double)mSettings.mEpochShift;
+
+	// set output sample rate
+	output->SetSampleRate(outputSampleRate);
+
+	mIsInitialized = true;
+}
+
+
+// main update function
+void BandPowerProcessor::Update()
+{
+	if (mIsInitialized == false)
+		return;
+
+	// update input readers
+	ChannelProcessor::Update();
+
+	ChannelReader*		input			= GetInputReader(0);
+	Channel<double>*	output			= GetOutput()->AsType<double>();
+	const uint32		numNewSamples	= input->GetNumNewSamples();
+	const uint32		numBins			= mBins.Size();
+	const uint32		numSamples		= mSettings.mNumFFTSamples;
+
+	for (uint32 i=0; i<numNewSamples; ++i)
+	{
+		// 1) shift the sample into the window
+		const double sample = input->PopOldestSample<double>();
+		const double oldestSample = mWindow[mWindowPos];
+		mWindow[mWindowPos] = sample;
+
+		mWindowPos++;
+		if (mWindowPos == numSamples)
+			mWindowPos = 0;
+
+		mNumSamples++;
+
+		// 2) sliding DFT: X'[k] = (X[k] - x_oldest + x_new) * e^(j 2 pi k / N)
+		const double delta = sample - oldestSample;
+		for (uint32 b=0; b<numBins; ++b)
+		{
+			Bin& bin = mBins[b];
+			bin.mSpectrum = (bin.mSpectrum + delta) * bin.mTwiddle;
+
+			// Goertzel recursion over the current block of N samples
+			const double state = sample + bin.mCoefficient * bin.mGoertzel1 - bin.mGoertzel2;
+			bin.mGoertzel2 = bin.mGoertzel1;
+			bin.mGoertzel1 = state;
+		}
+
+		// 3) the window holds exactly the last block: replace the sliding DFT by the Goertzel result so rounding errors can't accumulate
+		if (mWindowPos == 0)
+		{
+			for (uint32 b=0; b<numBins; ++b)
+			{
+				Bin& bin = mBins[b];
+				bin.mSpectrum = bin.mTwiddle * bin.mGoertzel1 - bin.mGoertzel2;
+				bin.mGoertzel1 = 0.0;
+				bin.mGoertzel2 = 0.0;
+			}
+		}
+
+		// 4) output one value per epoch shift once the window is full (same timing as the FFT processor)
+		mSamplesUntilOutput--;
+		if (mSamplesUntilOutput == 0)
+		{
+			output->AddSample(CalcValue());
+			mSamplesUntilOutput = mSettings.mEpochShift;
+		}
+	}
+}
+
+
+// average amplitude or power of the selected bins, scaled like the spectrum of the FFT processor
+double BandPowerProcessor::CalcValue() const
+{
+	const uint32 numBins = mBins.Size();
+	if (numBins == 0)
+		return 0.0;
+
+	double sum = 0.0;
+	for (uint32 b=0; b<numBins; ++b)
+	{
+		const Bin& bin = mBins[b];
+
+		// DC part is scaled by 2 due to the half symmetry of the complex spectrum
+		double amplitude;
+		if (bin.mIndex == 0)
+			amplitude = Math::AbsD(bin.mSpectrum.mReal) / mNumSpectrumBins / 2.0;
+		else
+			amplitude = bin.mSpectrum.Norm() / (mNumSpectrumBins - 1);
+
+		if (mSettings.mValueType == VALUE_POWER)
+			sum += amplitude * amplitude;
+		else
+			sum += amplitude;
+	}
+
+	return sum / (double)numBins;
+}
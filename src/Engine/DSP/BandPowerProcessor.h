@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_BANDPOWERPROCESSOR_H
+#define __NEUROMORE_BANDPOWERPROCESSOR_H
+
+// include required headers
+#include "../Config.h"
+#include "ChannelProcessor.h"
+#include "Channel.h"
+
+
+// band amplitude or power of the last N samples, evaluated only for the bins inside the band (sliding DFT)
+// The result is the same as FFT processor -> frequency band with the same FFT order and window shift, but costs O(bins) per sample.
+class ENGINE_API BandPowerProcessor : public ChannelProcessor
+{
+	public:
+		enum { TYPE_ID = 0x005E };
+
+		enum EValueType
+		{
+			VALUE_AMPLITUDE = 0,
+			VALUE_POWER		= 1,
+		};
+
+		class BandPowerSettings : public ChannelProcessor::Settings
+		{
+			public:
+				enum { TYPE_ID = 0x005E };
+
+				BandPowerSettings()								{ mFFTOrder = 7; mNumFFTSamples = 128; mEpochShift = 1; mMinFrequency = 8.0; mMaxFrequency = 12.0; mValueType = VALUE_AMPLITUDE; }
+				virtual ~BandPowerSettings()					{}
+
+				uint32 GetType() const override					{ return BandPowerProcessor::TYPE_ID; }
+
+				uint32			mFFTOrder;
+				uint32			mNumFFTSamples;
+				uint32			mEpochShift;
+				double			mMinFrequency;
+				double			mMaxFrequency;
+				EValueType		mValueType;
+		};
+
+		// constructors & destructor
+		BandPowerProcessor();
+		virtual ~BandPowerProcessor();
+
+		uint32 GetType() const override											{ return TYPE_ID; }
+		ChannelProcessor* Clone() override										{ BandPowerProcessor* clone = new BandPowerProcessor(); return clone; }
+
+		void Init() override;
+		void ReInit() override;
+		void Update() override;
+
+		// settings
+		void Setup(const ChannelProcessor::Settings& settings) override			{ mSettings = static_cast<const BandPowerSettings&>(settings); }
+		const Settings& GetSettings() const	override							{ return mSettings; }
+
+		uint32 GetNumBins() const												{ return mBins.Size(); }
+
+		// DSP related properties
+		uint32 GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const override			{ return mSettings.mNumFFTSamples; }
+		double GetLatency(uint32 inputPortIndex, uint32 outputPortIndex) const override			{ return (mSettings.mNumFFTSamples / 2.0) / GetOutput()->GetSampleRate(); /* very coarse assumption (half epoch)*/ }
+		double GetSampleRatio(uint32 inputPortIndex, uint32 outputPortIndex) const override		{ return mSettings.mEpochShift - 1; }
+
+	private:
+		// band value of the current window
+		double CalcValue() const;
+
+		BandPowerSettings			mSettings;
+
+		// one entry per evaluated bin
+		struct Bin
+		{
+			uint32			mIndex;
+			Core::Complex	mTwiddle;		// e^(j 2 pi k / N)
+			double			mCoefficient;	// 2 cos(2 pi k / N)
+			Core::Complex	mSpectrum;		// DFT of the last N samples (sliding)
+			double			mGoertzel1;		// Goertzel state of the current block, used to cancel the rounding drift of the sliding DFT
+			double			mGoertzel2;
+		};
+
+		Core::Array<Bin>			mBins;
+		Core::Array<double>			mWindow;			// last N samples (ring buffer)
+		uint32						mWindowPos;
+		uint64						mNumSamples;
+		uint32						mSamplesUntilOutput;
+		uint32						mNumSpectrumBins;	// N/2+1, for the FFT processor scaling
+};
+
+
+#endif
@@ -27,6 +27,9 @@
 // include required files
 #include "Channel.h"
 #include "../Core/Time.h"
+#include "../Core/Math.h"
+#include <cmath>
+#include <limits>
 
 
 using namespace Core;
@@ -35,6 +38,10 @@ using namespace Core;
 template<class T>
 Channel<T>::Channel(double sampleRate, uint32 bufferSize) : ChannelBase(bufferSize)
 {
+	mChunkStore = NULL;
+	mLastChunkIndex = CORE_INVALIDINDEX32;
+	mSamplesPerElement = 1;
+
 	SetSampleRate (sampleRate);
 
 	// initialize sample buffer
@@ -78,6 +85,7 @@ Channel<T>::Channel(double sampleRate, uint32 bufferSize) : ChannelBase(bufferSi
 template<class T>
 Channel<T>::~Channel()
 {
+	RemoveChunks();
 }
 
 
@@ -92,15 +100,15 @@ void Channel<T>::SetBufferSize(uint32 numSamples, bool discard)
 	if (numSamples == 0)
 	{
 		const uint32 chunkSize = CalcChunkSize();	
-		mSamples[0].Resize(chunkSize);
+		mSamples[0].Resize(CalcNumElements(chunkSize));
 	}
 	else 
 	{
 		// buffer channel: use first 'chunk' as the buffers
-		if (numSamples > mSamples[0].Size())
+		if (numSamples > GetChunkSize())
 		{
-			LogDebug("resizing sample array from %i to %i", mSamples[0].Size(), numSamples);
-			mSamples[0].Resize(numSamples);
+			LogDebug("resizing sample array from %i to %i", GetChunkSize(), numSamples);
+			mSamples[0].Resize(CalcNumElements(numSamples));
 		}
 	}
 
@@ -123,21 +131,6 @@ void Channel<T>::AddSample(const T& value)
 }
 
 
-// copy and add a sample to the Channel (do not use this if channel is a buffer)
-template<>
-void Channel<double>::AddSample(const double& value)
-{
-	LogTraceRT("AddSample");
-	LogDebugRT("adding sample value %f", value);
-
-	double* sampleRef = GetNextSampleRef();
-	
-
-	// copy value to memory location
-	(*sampleRef) = value;
-}
-
-
 // clear the Channel 
 template<class T>
 void Channel<T>::Clear(bool deallocate)
@@ -148,10 +141,11 @@ void Channel<T>::Clear(bool deallocate)
 	if (IsBuffer() == false)
 	{
 		LogDebug("clearing sample array (%i chunks)", mSamples.Size());
+		RemoveChunks();
 		mSamples.Clear();
 		mSamples.AddEmpty();
 		const uint32 chunkSize = CalcChunkSize();;	
-		mSamples[0].Resize(chunkSize);
+		mSamples[0].Resize(CalcNumElements(chunkSize));
 	}
 
 	mNumSamples	= 0;
@@ -166,18 +160,33 @@ void Channel<T>::Clear(bool deallocate)
 template<class T>
 T* Channel<T>::GetNextSampleRef()	
 { 
+	AddNextSample();
+
+	// get reference to new sample 
+	return GetSampleRef(mSampleCounter-1);
+}
+
+
+// 'create' the next sample (grows the storage and increases the counters)
+template<class T>
+void Channel<T>::AddNextSample()
+{
 	// grow storage channel by adding chunks
 	if (IsBuffer() == false)
 	{
-		const uint32 chunkSize = mSamples[0].Size();
+		const uint64 chunkSize = GetChunkSize();
 		const uint64 currentMaxNumSamples = chunkSize * mSamples.Size();
 
 		if (currentMaxNumSamples == mSampleCounter)
 		{
+			// the last chunk is full
+			SealChunk(mSamples.Size() - 1);
+
 			// add another chunk
+			const uint32 numElements = mSamples[0].Size();
 			mSamples.AddEmpty();
-			mSamples.GetLast().Resize(chunkSize);
-			LogDebug("added chunk %i (size = %i)", mSamples.Size(), chunkSize);
+			mSamples.GetLast().Resize(numElements);
+			LogDebug("added chunk %i (size = %i)", mSamples.Size(), (uint32)chunkSize);
 		}
 	}
 
@@ -189,19 +198,15 @@ T* Channel<T>::GetNextSampleRef()
 	if (IsBuffer() == false || mNumSamples < mBufferSize)
 		mNumSamples++;
 
-	// get reference to new sample 
-	T* sampleRef = GetSampleRef(mSampleCounter-1);
-
 	// mark channel  as active
 	SetAsActive();
-
-	return sampleRef;
 }
 
 
 // TODO optimize this - a channel never changes its behaviour, its either a buffer or a storage - we surely can get rid of the branching here
+// find the chunk and the position inside the chunk of a sample
 template<class T>
-const T& Channel<T>::GetSample(uint64 index) const
+void Channel<T>::LocateSample(uint64 index, uint32& outChunkIndex, uint32& outSampleIndex) const
 {
 	if (IsBuffer() == true)
 	{
@@ -212,41 +217,379 @@ const T& Channel<T>::GetSample(uint64 index) const
 	#endif
 
 		// calculate index of sample in circular buffer
-		const uint32 arrIndex = index % mBufferSize;
+		outChunkIndex = 0;
+		outSampleIndex = index % mBufferSize;
 		
-		LogDebugRT("accessing sample reference %i (array index %i)", index, arrIndex);
-
-		return mSamples[0][arrIndex];
+		LogDebugRT("accessing sample reference %i (array index %i)", index, outSampleIndex);
 	}
 	else
 	{
-		const uint64 chunkSize = mSamples[0].Size();
-		const uint64 currentMaxNumSamples = chunkSize * mSamples.Size();
+		const uint64 chunkSize = GetChunkSize();
 
 		// make sure that sample is contained in array
-		CORE_ASSERT(index < currentMaxNumSamples);
+		CORE_ASSERT(index < chunkSize * mSamples.Size());
 	
-		const uint64 chunkIndex = index / chunkSize;
-		const uint64 sampleIndex = index % chunkSize;
+		const uint32 chunkIndex = index / chunkSize;
+		outChunkIndex = chunkIndex;
+		outSampleIndex = index % chunkSize;
+
+		//LogDebugRT("accessing storage sample %i (chunk %i, index %i)", index, chunkIndex, outSampleIndex);
+
+		// disk-backed chunk: make sure it is in memory (the store is only asked when the accessed chunk changes)
+		if (chunkIndex != mLastChunkIndex && chunkIndex < mChunkHandles.Size() && mChunkHandles[chunkIndex] != CORE_INVALIDINDEX32)
+			AccessChunk(chunkIndex);
+	}
+}
+
+
+template<class T>
+typename Channel<T>::SampleValue Channel<T>::GetSample(uint64 index) const
+{
+	uint32 chunkIndex, sampleIndex;
+	LocateSample(index, chunkIndex, sampleIndex);
+
+	return mSamples[chunkIndex][sampleIndex];
+}
+
+
+// decode the sample from the storage format
+template<>
+double Channel<double>::GetSample(uint64 index) const
+{
+	uint32 chunkIndex, sampleIndex;
+	LocateSample(index, chunkIndex, sampleIndex);
+
+	const double* elements = mSamples[chunkIndex].GetReadPtr();
+	switch (mSampleFormat)
+	{
+		case SAMPLEFORMAT_FLOAT:
+			return reinterpret_cast<const float*>(elements)[sampleIndex];
+
+		case SAMPLEFORMAT_INT32:
+		{
+			const int32 value = reinterpret_cast<const int32*>(elements)[sampleIndex];
+			return (value == -CORE_INT32_MAX - 1 ? std::numeric_limits<double>::quiet_NaN() : value * mSampleResolution);
+		}
+
+		case SAMPLEFORMAT_INT16:
+		{
+			const int16 value = reinterpret_cast<const int16*>(elements)[sampleIndex];
+			return (value == -CORE_INT16_MAX - 1 ? std::numeric_limits<double>::quiet_NaN() : value * mSampleResolution);
+		}
 
-		//LogDebugRT("accessing storage sample %i (chunk %i, index %i)", index, chunkIndex, sampleIndex);
+		default:
+			return elements[sampleIndex];
+	}
+}
 
-		return mSamples[chunkIndex][sampleIndex];
+
+// encode the sample in the storage format (the lowest integer value represents NaN)
+template<>
+void Channel<double>::StoreSample(uint64 index, double value)
+{
+	uint32 chunkIndex, sampleIndex;
+	LocateSample(index, chunkIndex, sampleIndex);
+
+	double* elements = mSamples[chunkIndex].GetPtr();
+	switch (mSampleFormat)
+	{
+		case SAMPLEFORMAT_FLOAT:
+			reinterpret_cast<float*>(elements)[sampleIndex] = (float)value;
+			break;
+
+		case SAMPLEFORMAT_INT32:
+			reinterpret_cast<int32*>(elements)[sampleIndex] = (std::isnan(value) ? -CORE_INT32_MAX - 1 : (int32)Math::FloorD(Clamp<double>(value / mSampleResolution, -CORE_INT32_MAX, CORE_INT32_MAX) + 0.5));
+			break;
+
+		case SAMPLEFORMAT_INT16:
+			reinterpret_cast<int16*>(elements)[sampleIndex] = (std::isnan(value) ? -CORE_INT16_MAX - 1 : (int16)Math::FloorD(Clamp<double>(value / mSampleResolution, -CORE_INT16_MAX, CORE_INT16_MAX) + 0.5));
+			break;
+
+		default:
+			elements[sampleIndex] = value;
+			break;
 	}
 }
 
 
+// copy and add a sample to the Channel (do not use this if channel is a buffer)
+template<>
+void Channel<double>::AddSample(const double& value)
+{
+	LogTraceRT("AddSample");
+	LogDebugRT("adding sample value %f", value);
+
+	AddNextSample();
+
+	// write the value in the storage format
+	StoreSample(mSampleCounter-1, value);
+}
+
+
 // access samples by const ref
 template<class T>
 T* Channel<T>::GetSampleRef(uint64 index)
 {
-	return const_cast<T*>(&GetSample(index));
+	CORE_ASSERT(mSamplesPerElement == 1);
+
+	uint32 chunkIndex, sampleIndex;
+	LocateSample(index, chunkIndex, sampleIndex);
+	T* sampleRef = &mSamples[chunkIndex][sampleIndex];
+
+	// the sample may get modified, a sealed chunk has to be written to the scratch file again
+	if (chunkIndex < mChunkHandles.Size() && mChunkHandles[chunkIndex] != CORE_INVALIDINDEX32)
+		mChunkStore->MarkDirty(mChunkHandles[chunkIndex]);
+
+	return sampleRef;
+}
+
+
+// switch the storage format, the accessible samples are converted
+template<>
+void Channel<double>::SetSampleFormat(ESampleFormat format, double resolution)
+{
+	if (format >= NUM_SAMPLEFORMATS)
+		format = SAMPLEFORMAT_DOUBLE;
+	if (resolution <= 0.0)
+		resolution = 1.0;
+
+	if (format == mSampleFormat && resolution == mSampleResolution)
+		return;
+
+	// decode the accessible samples
+	Array<double> samples;
+	samples.Resize(mNumSamples);
+	const uint64 minSampleIndex = mSampleCounter - mNumSamples;
+	for (uint32 i=0; i<mNumSamples; ++i)
+		samples[i] = GetSample(minSampleIndex + i);
+
+	RemoveChunks();
+
+	mSampleFormat = format;
+	mSampleResolution = resolution;
+	mSamplesPerElement = sizeof(double) / GetSampleFormatSize(format);
+
+	// reallocate the storage: the circular buffer or enough chunks for all samples
+	const uint32 chunkSize = (IsBuffer() ? mBufferSize : CalcChunkSize());
+	const uint32 numElements = CalcNumElements(chunkSize);
+	const uint64 numChunks = (IsBuffer() ? 1 : Max<uint64>(1, (mSampleCounter + numElements * mSamplesPerElement - 1) / (numElements * mSamplesPerElement)));
+
+	mSamples.Clear();
+	for (uint64 i=0; i<numChunks; ++i)
+	{
+		mSamples.AddEmpty();
+		mSamples.GetLast().Resize(numElements);
+	}
+
+	// encode the samples again
+	for (uint32 i=0; i<mNumSamples; ++i)
+		StoreSample(minSampleIndex + i, samples[i]);
+
+	// the full chunks go back to the chunk store
+	for (uint32 i=1; i+1<numChunks; ++i)
+		SealChunk(i);
+}
+
+
+// spectrum channels are always stored as they are (the engine-wide format only applies to sample channels)
+template<>
+void Channel<Spectrum>::SetSampleFormat(ESampleFormat format, double resolution)
+{
+}
+
+
+// hand a full storage chunk to the chunk store (in case disk-backed storage is enabled)
+template<class T>
+void Channel<T>::SealChunk(uint32 chunkIndex)
+{
+	// the first chunk stays in memory, it defines the chunk size and gets accessed directly
+	if (chunkIndex == 0)
+		return;
+
+	ChannelChunkStore* store = GetChannelChunkStore();
+	if (store == NULL || store->IsEnabled() == false)
+		return;
+
+	mChunkStore = store;
+	while (mChunkHandles.Size() <= chunkIndex)
+		mChunkHandles.Add(CORE_INVALIDINDEX32);
+
+	mChunkHandles[chunkIndex] = mChunkStore->AddChunk(this, chunkIndex, CalcChunkBytes(chunkIndex));
+}
+
+
+// bring a sealed chunk into memory (if it was spilled) and mark it as recently used
+template<class T>
+void Channel<T>::AccessChunk(uint32 chunkIndex) const
+{
+	mChunkStore->AccessChunk(mChunkHandles[chunkIndex]);
+	mLastChunkIndex = chunkIndex;
+}
+
+
+// give all sealed chunks back to the store
+template<class T>
+void Channel<T>::RemoveChunks()
+{
+	const uint32 numHandles = mChunkHandles.Size();
+	for (uint32 i=0; i<numHandles; ++i)
+		if (mChunkHandles[i] != CORE_INVALIDINDEX32)
+			mChunkStore->RemoveChunk(mChunkHandles[i]);
+
+	mChunkHandles.Clear();
+	mLastChunkIndex = CORE_INVALIDINDEX32;
+}
+
+
+// protect the chunk of a sample from being spilled by accesses to other channels (does nothing for chunks that always stay in memory)
+template<class T>
+void Channel<T>::PinChunk(uint64 sampleIndex)
+{
+	if (IsBuffer() == true)
+		return;
+
+	const uint32 chunkIndex = (uint32)(sampleIndex / GetChunkSize());
+	if (chunkIndex < mChunkHandles.Size() && mChunkHandles[chunkIndex] != CORE_INVALIDINDEX32)
+		mChunkStore->PinChunk(mChunkHandles[chunkIndex]);
+}
+
+
+template<class T>
+void Channel<T>::UnpinChunk(uint64 sampleIndex)
+{
+	if (IsBuffer() == true)
+		return;
+
+	const uint32 chunkIndex = (uint32)(sampleIndex / GetChunkSize());
+	if (chunkIndex < mChunkHandles.Size() && mChunkHandles[chunkIndex] != CORE_INVALIDINDEX32)
+		mChunkStore->UnpinChunk(mChunkHandles[chunkIndex]);
+}
+
+
+// called by the store after the chunk was written to the scratch file
+template<class T>
+void Channel<T>::ReleaseChunk(uint32 chunkIndex)
+{
+	mSamples[chunkIndex].Clear();
+
+	if (mLastChunkIndex == chunkIndex)
+		mLastChunkIndex = CORE_INVALIDINDEX32;
+}
+
+
+// called by the store before it gets destroyed, all chunks are in memory again
+template<class T>
+void Channel<T>::DetachChunkStore()
+{
+	mChunkStore = NULL;
+	mChunkHandles.Clear();
+	mLastChunkIndex = CORE_INVALIDINDEX32;
+}
+
+
+// chunk serialization: raw samples
+template<>
+uint64 Channel<double>::CalcChunkBytes(uint32 chunkIndex) const
+{
+	return (uint64)mSamples[chunkIndex].Size() * sizeof(double);
+}
+
+
+template<>
+void Channel<double>::SaveChunk(uint32 chunkIndex, uint8* data, uint64 numBytes)
+{
+	MemCopy(data, mSamples[chunkIndex].GetReadPtr(), (size_t)numBytes);
+}
+
+
+template<>
+void Channel<double>::LoadChunk(uint32 chunkIndex, const uint8* data, uint64 numBytes)
+{
+	mSamples[chunkIndex].Resize((uint32)(numBytes / sizeof(double)));
+	MemCopy(mSamples[chunkIndex].GetPtr(), data, (size_t)numBytes);
+}
+
+
+// chunk serialization: per spectrum the number of bins, time, max frequency and the complex bins
+template<>
+uint64 Channel<Spectrum>::CalcChunkBytes(uint32 chunkIndex) const
+{
+	const Array<Spectrum>& chunk = mSamples[chunkIndex];
+
+	uint64 numBytes = sizeof(uint32);
+	const uint32 numSpectrums = chunk.Size();
+	for (uint32 i=0; i<numSpectrums; ++i)
+		numBytes += sizeof(uint32) + 2 * sizeof(double) + chunk[i].GetNumBins() * 2 * sizeof(double);
+
+	return numBytes;
+}
+
+
+template<>
+void Channel<Spectrum>::SaveChunk(uint32 chunkIndex, uint8* data, uint64 numBytes)
+{
+	const Array<Spectrum>& chunk = mSamples[chunkIndex];
+	const uint32 numSpectrums = chunk.Size();
+
+	MemCopy(data, &numSpectrums, sizeof(uint32));	data += sizeof(uint32);
+	for (uint32 i=0; i<numSpectrums; ++i)
+	{
+		const Spectrum& spectrum = chunk[i];
+		const uint32 numBins = spectrum.GetNumBins();
+		const double time = spectrum.GetTime();
+		const double maxFrequency = spectrum.GetMaxFrequency();
+
+		MemCopy(data, &numBins, sizeof(uint32));			data += sizeof(uint32);
+		MemCopy(data, &time, sizeof(double));				data += sizeof(double);
+		MemCopy(data, &maxFrequency, sizeof(double));		data += sizeof(double);
+
+		for (uint32 b=0; b<numBins; ++b)
+		{
+			const Complex bin = spectrum.GetComplexBin(b);
+			MemCopy(data, &bin.mReal, sizeof(double));		data += sizeof(double);
+			MemCopy(data, &bin.mImag, sizeof(double));		data += sizeof(double);
+		}
+	}
+}
+
+
+template<>
+void Channel<Spectrum>::LoadChunk(uint32 chunkIndex, const uint8* data, uint64 numBytes)
+{
+	Array<Spectrum>& chunk = mSamples[chunkIndex];
+
+	uint32 numSpectrums;
+	MemCopy(&numSpectrums, data, sizeof(uint32));	data += sizeof(uint32);
+	chunk.Resize(numSpectrums);
+
+	for (uint32 i=0; i<numSpectrums; ++i)
+	{
+		Spectrum& spectrum = chunk[i];
+		uint32 numBins;
+		double time, maxFrequency;
+
+		MemCopy(&numBins, data, sizeof(uint32));			data += sizeof(uint32);
+		MemCopy(&time, data, sizeof(double));				data += sizeof(double);
+		MemCopy(&maxFrequency, data, sizeof(double));		data += sizeof(double);
+
+		spectrum.SetNumBins(numBins);
+		spectrum.SetTime(time);
+		spectrum.SetMaxFrequency(maxFrequency);
+
+		for (uint32 b=0; b<numBins; ++b)
+		{
+			Complex bin;
+			MemCopy(&bin.mReal, data, sizeof(double));		data += sizeof(double);
+			MemCopy(&bin.mImag, data, sizeof(double));		data += sizeof(double);
+			spectrum.SetBin(b, bin);
+		}
+	}
 }
 
 
 // access last sample by const ref
 template<class T>
-const T& Channel<T>::GetLastSample() const
+typename Channel<T>::SampleValue Channel<T>::GetLastSample() const
 { 
 	// no samples in channel -> we have a problem!
 	//CORE_ASSERT(mSampleCounter > 0);
@@ -414,7 +757,7 @@ uint64 Channel<double>::CalculateMemoryUsed(bool countBuffersOnly) const
 		return 0;
 
 	const uint64 numSamples = GetNumSamples();
-	const uint64 numBytes = numSamples * sizeof(double);
+	const uint64 numBytes = numSamples * GetSampleFormatSize(mSampleFormat);
 
 	return numBytes;
 }
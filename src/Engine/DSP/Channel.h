@@ -31,11 +31,17 @@
 #include "../Core/Color.h"
 #include "Spectrum.h"
 #include "ChannelBase.h"
+#include "ChannelChunkStore.h"
+
+
+// sample access type: doubles are returned by value (the channel may store them in a compact format), everything else by const reference
+template<class T> struct ChannelSampleValue			{ typedef const T& Type; };
+template<> struct ChannelSampleValue<double>		{ typedef double Type; };
 
 
 // the Channel class
 template<class T>
-class Channel : public ChannelBase
+class Channel : public ChannelBase, public ChannelChunkStore::Client
 {
 	public:
 
@@ -44,6 +50,8 @@ class Channel : public ChannelBase
 			DOUBLE,
 			SPECTRUM
 		};
+
+		typedef typename ChannelSampleValue<T>::Type SampleValue;
 		
 		// constructors & destructor
 		Channel(double sampleRate = 0, uint32 bufferSize = 0);
@@ -68,13 +76,19 @@ class Channel : public ChannelBase
 		virtual void Clear(bool deallocate = false) override;
 
 		// get sampless and sample time (pointer or const ref, we need both)
+		// NOTE: the sample refs require SAMPLEFORMAT_DOUBLE
+		// NOTE: with disk-backed storage the next access (GetSample() included) may spill the chunk a returned reference points into, so a Channel<Spectrum>
+		//       sample reference is only valid until the next access of any storage channel; copy the spectrum or pin its chunk to keep it around
 		T* GetSampleRef(uint64 index);
 		T* GetLastSampleRef();
-		const T& GetSample(uint64 index) const;
-		const T& GetLastSample() const;
+		SampleValue GetSample(uint64 index) const;
+		SampleValue GetLastSample() const;
+
+		// sample storage format
+		void SetSampleFormat(ESampleFormat format, double resolution = 1.0) override;
 
 		// direct memory access (no circular adressing!)
-		// NOTE this only enables access to the first array chunk;
+		// NOTE this only enables access to the first array chunk and requires SAMPLEFORMAT_DOUBLE;
 		const T& operator[](const uint64 index)							{ return mSamples[0][index]; }
 		Core::Array<T>& GetRawArray()									{ return mSamples[0]; }
 		void ForceUpdateSampleCounters()								{ mSampleCounter = mSamples[0].Size(); mNumSamples = mSamples.Size(); mTimeSinceLastAddSample = 0;}
@@ -92,9 +106,43 @@ class Channel : public ChannelBase
 		uint64 CalculateMemoryAllocated(bool countBuffersOnly = false) const override;
 		uint64 CalculateMemoryUsed(bool countBuffersOnly = false) const override;
 
+		// disk-backed storage (see ChannelChunkStore)
+		uint64 CalcChunkBytes(uint32 chunkIndex) const override;
+		void SaveChunk(uint32 chunkIndex, uint8* data, uint64 numBytes) override;
+		void LoadChunk(uint32 chunkIndex, const uint8* data, uint64 numBytes) override;
+		void ReleaseChunk(uint32 chunkIndex) override;
+		void DetachChunkStore() override;
+
+		// keep the chunk holding the given sample in memory, required while the channel is read from another thread
+		// pin, read the samples of the chunk and unpin again, so the memory budget still applies to the other chunks
+		void PinChunk(uint64 sampleIndex);
+		void UnpinChunk(uint64 sampleIndex);
+		uint32 GetNumChunkSamples() const								{ return GetChunkSize(); }
+
 	protected:
 		// the sample storage arrays
 		Core::Array<Core::Array<T>>  mSamples;	 
+
+	private:
+		// number of samples in a chunk (or in the circular buffer) and the number of storage elements that hold numSamples samples
+		inline uint32 GetChunkSize() const								{ return mSamples[0].Size() * mSamplesPerElement; }
+		inline uint32 CalcNumElements(uint32 numSamples) const			{ return (numSamples + mSamplesPerElement - 1) / mSamplesPerElement; }
+
+		void AddNextSample();
+		void LocateSample(uint64 index, uint32& outChunkIndex, uint32& outSampleIndex) const;
+		void StoreSample(uint64 index, double value);
+
+		void SealChunk(uint32 chunkIndex);
+		void RemoveChunks();
+		void AccessChunk(uint32 chunkIndex) const;
+
+		// storage channels: handle of every sealed chunk in the chunk store (the first and the open chunk always stay in memory)
+		ChannelChunkStore*			mChunkStore;
+		Core::Array<uint32>			mChunkHandles;
+		mutable uint32				mLastChunkIndex;	// chunk accessed last, it is resident
+
+		// compact sample formats pack several samples into one storage element
+		uint32						mSamplesPerElement;
 };
 
 
@@ -56,6 +56,9 @@ ChannelBase::ChannelBase(uint32 bufferSize)
 	mLatency = 0;
 	mTimeSinceLastAddSample = 100; // marks channel as inactive
 	mIsHighlighted = false;
+
+	mSampleFormat = SAMPLEFORMAT_DOUBLE;
+	mSampleResolution = 1.0;
 }
 
 
@@ -80,6 +83,32 @@ void ChannelBase::Reset()
 
 
 
+// number of bytes one sample takes in the given format
+uint32 ChannelBase::GetSampleFormatSize(ESampleFormat format)
+{
+	switch (format)
+	{
+		case SAMPLEFORMAT_FLOAT:	return sizeof(float);
+		case SAMPLEFORMAT_INT32:	return sizeof(int32);
+		case SAMPLEFORMAT_INT16:	return sizeof(int16);
+		default:					return sizeof(double);
+	}
+}
+
+
+const char* ChannelBase::GetSampleFormatName(ESampleFormat format)
+{
+	switch (format)
+	{
+		case SAMPLEFORMAT_DOUBLE:	return "Double";
+		case SAMPLEFORMAT_FLOAT:	return "Float";
+		case SAMPLEFORMAT_INT32:	return "Int32 (scaled)";
+		case SAMPLEFORMAT_INT16:	return "Int16 (scaled)";
+		default:					return "Unknown";
+	}
+}
+
+
 uint64 ChannelBase::GetMinSampleIndex() const 				
 { 
 	if (mSampleCounter == 0)
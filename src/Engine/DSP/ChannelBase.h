@@ -42,6 +42,16 @@ class ENGINE_API ChannelBase
 	CORE_LOGDEBUG_DISABLE("ChannelBase", GetName(), this)
 
 	public:
+		// storage format of the samples; the samples are always presented as doubles (only double channels support the compact formats)
+		enum ESampleFormat
+		{
+			SAMPLEFORMAT_DOUBLE		= 0,		// 64 bit float, lossless
+			SAMPLEFORMAT_FLOAT		= 1,		// 32 bit float, relative error <= 2^-24
+			SAMPLEFORMAT_INT32		= 2,		// scaled 32 bit integer, absolute error <= resolution/2 within +-(2^31-1) * resolution, clamped outside
+			SAMPLEFORMAT_INT16		= 3,		// scaled 16 bit integer, absolute error <= resolution/2 within +-(2^15-1) * resolution, clamped outside
+			NUM_SAMPLEFORMATS
+		};
+
 		ChannelBase(uint32 bufferSize = 0);
 		virtual ~ChannelBase();
 		virtual uint32 GetType() const = 0;
@@ -104,6 +114,14 @@ class ENGINE_API ChannelBase
 		virtual void SetBufferSize(uint32 numSamples, bool discard = true) = 0;
 		uint32 GetBufferSize() const											{ return mBufferSize; }
 
+		// sample storage format (converts the stored samples)
+		virtual void SetSampleFormat(ESampleFormat format, double resolution = 1.0) = 0;
+		ESampleFormat GetSampleFormat() const									{ return mSampleFormat; }
+		double GetSampleResolution() const										{ return mSampleResolution; }
+
+		static uint32 GetSampleFormatSize(ESampleFormat format);
+		static const char* GetSampleFormatName(ESampleFormat format);
+
 		virtual uint64 CalculateMemoryAllocated(bool countBuffersOnly = false) const = 0;
 		virtual uint64 CalculateMemoryUsed( bool countBuffersOnly = false) const = 0;
 
@@ -162,6 +180,8 @@ class ENGINE_API ChannelBase
 		uint64		mSampleCounter;						// added samples since last call of Clear();
 		uint32		mBufferSize;						// the maximum number of samples this channel holds; 0 in case circular buffer is disabled
 		double		mTimeSinceLastAddSample;			// activity-detection
+		ESampleFormat mSampleFormat;					// how the samples are stored
+		double		mSampleResolution;					// value of one integer step (integer sample formats only)
 
 	private:
 		// channel properties
@@ -0,0 +1,385 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required files
+#include "ChannelChunkStore.h"
+#include "../EngineManager.h"
+#include "../Core/LogManager.h"
+
+
+using namespace Core;
+
+
+// constructor
+ChannelChunkStore::ChannelChunkStore()
+{
+	mIsEnabled			= false;
+	mHasFileError		= false;
+	mMemoryBudget		= CHANNELCHUNKSTORE_DEFAULT_BUDGET;
+	mFileEnd			= 0;
+	mHead				= CORE_INVALIDINDEX32;
+	mTail				= CORE_INVALIDINDEX32;
+	mResidentBytes		= 0;
+	mNumChunks			= 0;
+	mNumSpilledChunks	= 0;
+}
+
+
+// destructor
+ChannelChunkStore::~ChannelChunkStore()
+{
+	// bring every spilled chunk back into its channel before the scratch file goes away
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		Entry& entry = mEntries[i];
+		if (entry.mClient != NULL && entry.mIsResident == false)
+			entry.mClient->LoadChunk(entry.mChunkIndex, mFile.GetData() + entry.mOffset, entry.mNumBytes);
+	}
+
+	// and tell the channels to forget their handles
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		Client* client = mEntries[i].mClient;
+		if (client == NULL)
+			continue;
+
+		client->DetachChunkStore();
+
+		// once per channel
+		for (uint32 j=i; j<numEntries; ++j)
+			if (mEntries[j].mClient == client)
+				mEntries[j].mClient = NULL;
+	}
+
+	mFile.Close();
+}
+
+
+// change the budget, evicts right away if the budget shrinks
+void ChannelChunkStore::SetMemoryBudget(uint64 numBytes)
+{
+	mLock.Lock();
+	mMemoryBudget = numBytes;
+	EnforceBudget(CORE_INVALIDINDEX32);
+	mLock.Unlock();
+}
+
+
+// a storage channel sealed a chunk
+uint32 ChannelChunkStore::AddChunk(Client* client, uint32 chunkIndex, uint64 numBytes)
+{
+	mLock.Lock();
+
+	uint32 handle;
+	if (mFreeEntries.IsEmpty() == false)
+	{
+		handle = mFreeEntries.GetLast();
+		mFreeEntries.RemoveLast();
+	}
+	else
+	{
+		handle = mEntries.Size();
+		mEntries.AddEmpty();
+	}
+
+	Entry& entry = mEntries[handle];
+	entry.mClient		= client;
+	entry.mChunkIndex	= chunkIndex;
+	entry.mNumBytes		= numBytes;
+	entry.mOffset		= CORE_INVALIDINDEX64;
+	entry.mCapacity		= 0;
+	entry.mIsResident	= true;
+	entry.mIsDirty		= true;
+	entry.mNumPins		= 0;
+
+	LinkFront(handle);
+	mResidentBytes += numBytes;
+	mNumChunks++;
+
+	EnforceBudget(handle);
+
+	mLock.Unlock();
+	return handle;
+}
+
+
+// the channel got cleared or destroyed
+void ChannelChunkStore::RemoveChunk(uint32 handle)
+{
+	mLock.Lock();
+
+	Entry& entry = mEntries[handle];
+	CORE_ASSERT(entry.mClient != NULL);
+
+	if (entry.mIsResident == true)
+	{
+		Unlink(handle);
+		mResidentBytes -= entry.mNumBytes;
+	}
+	else
+		mNumSpilledChunks--;
+
+	FreeRegion(entry);
+	entry.mClient = NULL;
+	mFreeEntries.Add(handle);
+	mNumChunks--;
+
+	mLock.Unlock();
+}
+
+
+// the channel is about to read from the chunk
+void ChannelChunkStore::AccessChunk(uint32 handle)
+{
+	mLock.Lock();
+
+	Entry& entry = mEntries[handle];
+	if (entry.mIsResident == true)
+	{
+		// most recently used
+		if (mHead != handle)
+		{
+			Unlink(handle);
+			LinkFront(handle);
+		}
+
+		mLock.Unlock();
+		return;
+	}
+
+	// read it back and let the pages of the file go again
+	entry.mClient->LoadChunk(entry.mChunkIndex, mFile.GetData() + entry.mOffset, entry.mNumBytes);
+	mFile.ReleasePages(entry.mOffset, entry.mCapacity);
+
+	entry.mIsResident = true;
+	entry.mIsDirty = false;
+	LinkFront(handle);
+	mResidentBytes += entry.mNumBytes;
+	mNumSpilledChunks--;
+
+	EnforceBudget(handle);
+
+	mLock.Unlock();
+}
+
+
+// a sample of a resident chunk got modified
+void ChannelChunkStore::MarkDirty(uint32 handle)
+{
+	mLock.Lock();
+	mEntries[handle].mIsDirty = true;
+	mLock.Unlock();
+}
+
+
+// keep a chunk in memory until it is unpinned again (pins are counted)
+void ChannelChunkStore::PinChunk(uint32 handle)
+{
+	mLock.Lock();
+	mEntries[handle].mNumPins++;
+	mLock.Unlock();
+}
+
+
+void ChannelChunkStore::UnpinChunk(uint32 handle)
+{
+	mLock.Lock();
+
+	Entry& entry = mEntries[handle];
+	CORE_ASSERT(entry.mNumPins > 0);
+	entry.mNumPins--;
+
+	// the chunks read back while they were pinned count against the budget again
+	if (entry.mNumPins == 0)
+		EnforceBudget(CORE_INVALIDINDEX32);
+
+	mLock.Unlock();
+}
+
+
+// spill least recently used chunks until the budget is met (never the given one and never pinned ones)
+void ChannelChunkStore::EnforceBudget(uint32 keepHandle)
+{
+	uint32 handle = mTail;
+	while (mResidentBytes > mMemoryBudget && handle != CORE_INVALIDINDEX32)
+	{
+		// evicting unlinks the entry, so step to the more recently used one first
+		const uint32 prevHandle = mEntries[handle].mPrev;
+
+		if (handle != keepHandle && mEntries[handle].mNumPins == 0)
+		{
+			if (Evict(handle) == false)
+				break;
+		}
+
+		handle = prevHandle;
+	}
+}
+
+
+// write a chunk to the scratch file (if needed) and free its memory
+bool ChannelChunkStore::Evict(uint32 handle)
+{
+	Entry& entry = mEntries[handle];
+	CORE_ASSERT(entry.mIsResident == true);
+
+	if (entry.mIsDirty == true)
+	{
+		// the scratch file is created on the first spill
+		if (mFile.IsOpen() == false && mHasFileError == false)
+		{
+			if (mFile.OpenScratch(mScratchFolder.AsChar()) == false)
+			{
+				LogError("ChannelChunkStore: Cannot create the scratch file, storage channels stay in memory.");
+				mHasFileError = true;
+			}
+		}
+
+		if (mHasFileError == true)
+			return false;
+
+		const uint64 numBytes = entry.mClient->CalcChunkBytes(entry.mChunkIndex);
+		if (AllocateRegion(entry, numBytes) == false)
+			return false;
+
+		entry.mClient->SaveChunk(entry.mChunkIndex, mFile.GetData() + entry.mOffset, numBytes);
+		mFile.ReleasePages(entry.mOffset, entry.mCapacity);
+
+		// resident size follows the serialized size
+		mResidentBytes = mResidentBytes - entry.mNumBytes + numBytes;
+		entry.mNumBytes = numBytes;
+		entry.mIsDirty = false;
+	}
+
+	entry.mClient->ReleaseChunk(entry.mChunkIndex);
+
+	Unlink(handle);
+	entry.mIsResident = false;
+	mResidentBytes -= entry.mNumBytes;
+	mNumSpilledChunks++;
+
+	return true;
+}
+
+
+// find room for a chunk in the scratch file (keeps the current region if it is large enough)
+bool ChannelChunkStore::AllocateRegion(Entry& entry, uint64 numBytes)
+{
+	if (entry.mOffset != CORE_INVALIDINDEX64 && entry.mCapacity >= numBytes)
+		return true;
+
+	FreeRegion(entry);
+
+	// whole pages, so releasing a chunk does not leave partial pages of its neighbours mapped
+	const uint64 pageSize = MappedFile::GetPageSize();
+	const uint64 capacity = (numBytes + pageSize - 1) / pageSize * pageSize;
+
+	// reuse a free region (chunks of a channel all have the same size, so these fit most of the time)
+	const uint32 numFreeRegions = mFreeRegions.Size();
+	for (uint32 i=0; i<numFreeRegions; ++i)
+	{
+		if (mFreeRegions[i].mCapacity >= capacity)
+		{
+			entry.mOffset	= mFreeRegions[i].mOffset;
+			entry.mCapacity	= mFreeRegions[i].mCapacity;
+			mFreeRegions.Remove(i);
+			return true;
+		}
+	}
+
+	// append
+	if (mFile.Reserve(mFileEnd + capacity) == false)
+	{
+		LogError("ChannelChunkStore: Cannot grow the scratch file.");
+		mHasFileError = true;
+		return false;
+	}
+
+	entry.mOffset	= mFileEnd;
+	entry.mCapacity	= capacity;
+	mFileEnd += capacity;
+
+	return true;
+}
+
+
+// give the region of a chunk back
+void ChannelChunkStore::FreeRegion(Entry& entry)
+{
+	if (entry.mOffset == CORE_INVALIDINDEX64)
+		return;
+
+	Region region;
+	region.mOffset		= entry.mOffset;
+	region.mCapacity	= entry.mCapacity;
+	mFreeRegions.Add(region);
+
+	entry.mOffset	= CORE_INVALIDINDEX64;
+	entry.mCapacity	= 0;
+}
+
+
+// LRU list helpers
+void ChannelChunkStore::LinkFront(uint32 handle)
+{
+	Entry& entry = mEntries[handle];
+	entry.mPrev = CORE_INVALIDINDEX32;
+	entry.mNext = mHead;
+
+	if (mHead != CORE_INVALIDINDEX32)
+		mEntries[mHead].mPrev = handle;
+	mHead = handle;
+
+	if (mTail == CORE_INVALIDINDEX32)
+		mTail = handle;
+}
+
+
+void ChannelChunkStore::Unlink(uint32 handle)
+{
+	Entry& entry = mEntries[handle];
+
+	if (entry.mPrev != CORE_INVALIDINDEX32)
+		mEntries[entry.mPrev].mNext = entry.mNext;
+	else
+		mHead = entry.mNext;
+
+	if (entry.mNext != CORE_INVALIDINDEX32)
+		mEntries[entry.mNext].mPrev = entry.mPrev;
+	else
+		mTail = entry.mPrev;
+
+	entry.mPrev = CORE_INVALIDINDEX32;
+	entry.mNext = CORE_INVALIDINDEX32;
+}
+
+
+// the chunk store of the engine
+ChannelChunkStore* GetChannelChunkStore()
+{
+	return (GetEngine() != NULL ? GetEngine()->GetChannelChunkStore() : NULL);
+}
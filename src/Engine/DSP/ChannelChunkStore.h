@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_CHANNELCHUNKSTORE_H
+#define __NEUROMORE_CHANNELCHUNKSTORE_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/String.h"
+#include "../Core/Mutex.h"
+#include "../Core/MappedFile.h"
+
+// default budget for the sealed chunks of all storage channels
+#define CHANNELCHUNKSTORE_DEFAULT_BUDGET (512 * 1024 * 1024)
+
+// keeps the sealed chunks of storage channels within a memory budget
+// chunks enter the store resident (and dirty) when they are sealed, the least recently used ones get written to a memory-mapped scratch file and
+// dropped from memory once the budget is exceeded; accessing a spilled chunk reads it back in
+// NOTE: any access can evict the chunks of other channels, channels that are read from another thread (e.g. by the session export) have to pin the chunk they read
+class ENGINE_API ChannelChunkStore
+{
+	public:
+		// implemented by the storage channels
+		class Client
+		{
+			public:
+				virtual ~Client()																			{}
+
+				// serialized size of a chunk
+				virtual uint64 CalcChunkBytes(uint32 chunkIndex) const = 0;
+
+				// serialize a chunk into the scratch file / deserialize it back into memory
+				virtual void SaveChunk(uint32 chunkIndex, uint8* data, uint64 numBytes) = 0;
+				virtual void LoadChunk(uint32 chunkIndex, const uint8* data, uint64 numBytes) = 0;
+
+				// free the memory of a chunk (it is stored in the scratch file)
+				virtual void ReleaseChunk(uint32 chunkIndex) = 0;
+
+				// the store goes away, all chunks are resident again and the handles are invalid
+				virtual void DetachChunkStore() = 0;
+		};
+
+		// constructor & destructor
+		ChannelChunkStore();
+		~ChannelChunkStore();
+
+		// settings (disabled by default, only affects chunks sealed afterwards)
+		void SetEnabled(bool enabled)																		{ mIsEnabled = enabled; }
+		bool IsEnabled() const																				{ return mIsEnabled; }
+		void SetMemoryBudget(uint64 numBytes);
+		uint64 GetMemoryBudget() const																		{ return mMemoryBudget; }
+		void SetScratchFolder(const char* folder)															{ mScratchFolder = folder; }
+
+		// chunk handles
+		uint32 AddChunk(Client* client, uint32 chunkIndex, uint64 numBytes);
+		void RemoveChunk(uint32 handle);
+		void AccessChunk(uint32 handle);
+		void MarkDirty(uint32 handle);
+
+		// pinned chunks are never evicted (spilled ones are read back on their next access and stay), the budget may be exceeded by the pinned chunks
+		void PinChunk(uint32 handle);
+		void UnpinChunk(uint32 handle);
+
+		// statistics
+		uint64 GetResidentBytes() const																		{ return mResidentBytes; }
+		uint32 GetNumChunks() const																			{ return mNumChunks; }
+		uint32 GetNumSpilledChunks() const																	{ return mNumSpilledChunks; }
+		uint64 GetScratchFileSize() const																	{ return mFile.GetSize(); }
+
+	private:
+		struct Entry
+		{
+			Client*		mClient;			// NULL for free entries
+			uint32		mChunkIndex;
+			uint64		mNumBytes;			// serialized size (resident memory estimate)
+			uint64		mOffset;			// region in the scratch file (CORE_INVALIDINDEX64 if never written)
+			uint64		mCapacity;
+			bool		mIsResident;
+			bool		mIsDirty;
+			uint32		mNumPins;
+			uint32		mPrev;				// LRU list, head is the most recently used
+			uint32		mNext;
+		};
+
+		struct Region
+		{
+			uint64		mOffset;
+			uint64		mCapacity;
+		};
+
+		void LinkFront(uint32 handle);
+		void Unlink(uint32 handle);
+		bool Evict(uint32 handle);
+		void EnforceBudget(uint32 keepHandle);
+		bool AllocateRegion(Entry& entry, uint64 numBytes);
+		void FreeRegion(Entry& entry);
+
+		Core::Mutex					mLock;
+		Core::MappedFile			mFile;
+		Core::String				mScratchFolder;
+		bool						mIsEnabled;
+		bool						mHasFileError;
+		uint64						mMemoryBudget;
+
+		Core::Array<Entry>			mEntries;
+		Core::Array<uint32>			mFreeEntries;
+		Core::Array<Region>			mFreeRegions;
+		uint64						mFileEnd;			// end of the used part of the scratch file
+		uint32						mHead;
+		uint32						mTail;
+
+		uint64						mResidentBytes;
+		uint32						mNumChunks;
+		uint32						mNumSpilledChunks;
+};
+
+
+// the chunk store of the engine (NULL in case the engine is not initialized)
+ENGINE_API ChannelChunkStore* GetChannelChunkStore();
+
+
+#endif
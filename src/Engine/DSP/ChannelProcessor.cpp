@@ -93,6 +93,37 @@ void ChannelProcessor::Update()
 }
 
 
+// check if the processor can be skipped by the scheduler (must be called after the input nodes were updated)
+bool ChannelProcessor::CanSkipUpdate() const
+{
+	// processors without inputs generate their own samples
+	const uint32 numInputs = GetNumInputs();
+	if (numInputs == 0 || IsClockDriven() == true)
+		return false;
+
+	for (uint32 i=0; i<numInputs; ++i)
+	{
+		const ChannelReader* reader = mInputs[i];
+		if (reader == NULL || reader->HasChannel() == false)
+			continue;
+
+		// the reader still waits for its start time
+		if (reader->HasStarted() == false)
+			return false;
+
+		// the input channel received samples during this tick
+		if (reader->GetChannel()->GetNumNewSamples() > 0)
+			return false;
+
+		// pending samples from previous ticks that are enough for another epoch
+		if (reader->GetNumNewSamples() >= Max<uint32>(1, GetNumEpochSamples(i)))
+			return false;
+	}
+
+	return true;
+}
+
+
 ChannelBase* ChannelProcessor::GetInput(uint32 index) const
 {
 	// return input channel, if there is any 
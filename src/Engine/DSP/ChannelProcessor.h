@@ -64,6 +64,13 @@ class ENGINE_API ChannelProcessor
 		// if the processor is in working condition
 		bool IsInitialized() const																{ return mIsInitialized;  }
 
+		// processors that produce output from their own clock (and not only from new input samples) must be updated every tick
+		virtual bool IsClockDriven() const														{ return false; }
+
+		// true if Update() cannot produce output this tick: no new input samples and not enough pending samples for an epoch
+		// (used by ProcessorNode to skip the processor update, the node itself is still updated)
+		bool CanSkipUpdate() const;
+
 		//
 		// Inputs	
 		//
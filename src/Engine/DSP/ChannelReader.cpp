@@ -295,7 +295,7 @@ void ChannelReader::SetChannel(ChannelBase* inputChannel)
 
 // return one of the new Samples (const reference to the sample in the channel) where index=0 is the oldest one
 template<class T>
-const T& ChannelReader::GetSample(uint32 index)
+typename ChannelSampleValue<T>::Type ChannelReader::GetSample(uint32 index)
 {
 	const uint32 maxNumSamples	= mChannel->GetSampleCounter();
 	const uint32 sampleIndex	= maxNumSamples - mNumNewSamples + index;
@@ -307,21 +307,21 @@ const T& ChannelReader::GetSample(uint32 index)
 
 // get the oldest of the new samples without popping it
 template<class T>
-const T& ChannelReader::GetOldestSample()
+typename ChannelSampleValue<T>::Type ChannelReader::GetOldestSample()
 {
 	CORE_ASSERT( mNumNewSamples > 0 );
 
-	const T& sample = GetSample<T>(0);
+	typename ChannelSampleValue<T>::Type sample = GetSample<T>(0);
 	return sample;
 }
 
 
 // pop operation on the oldest of the new samples on the input channel
 template<class T>
-const T& ChannelReader::PopOldestSample()
+typename ChannelSampleValue<T>::Type ChannelReader::PopOldestSample()
 {
 	CORE_ASSERT(mNumNewSamples > 0);
-	const T& sample = GetSample<T>(0);
+	typename ChannelSampleValue<T>::Type sample = GetSample<T>(0);
 
 	Advance(1);
 
@@ -330,9 +330,9 @@ const T& ChannelReader::PopOldestSample()
 
 // get the newest of the new samples without popping it
 template<class T>
-const T& ChannelReader::GetNewestSample()
+typename ChannelSampleValue<T>::Type ChannelReader::GetNewestSample()
 {
-	const T& sample = GetSample<T>(mNumNewSamples-1);
+	typename ChannelSampleValue<T>::Type sample = GetSample<T>(mNumNewSamples-1);
 	return sample;
 }
 
@@ -506,14 +506,14 @@ uint64 ChannelReader::CalcEpochPosition(uint32 index) const
 
 
 // explicit instantiation
-template const double& ChannelReader::GetSample<double>(uint32 index);
+template double ChannelReader::GetSample<double>(uint32 index);
 template const Spectrum& ChannelReader::GetSample<Spectrum>(uint32 index);
 
-template const double& ChannelReader::PopOldestSample<double>();
+template double ChannelReader::PopOldestSample<double>();
 template const Spectrum& ChannelReader::PopOldestSample<Spectrum>();
 
-template const double& ChannelReader::GetOldestSample<double>();
+template double ChannelReader::GetOldestSample<double>();
 template const Spectrum& ChannelReader::GetOldestSample<Spectrum>();
 
-template const double& ChannelReader::GetNewestSample<double>();
+template double ChannelReader::GetNewestSample<double>();
 template const Spectrum& ChannelReader::GetNewestSample<Spectrum>();
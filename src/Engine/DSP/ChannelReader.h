@@ -27,6 +27,7 @@
 // include required headers
 #include "../Config.h"
 #include "ChannelBase.h"
+#include "Channel.h"
 #include "Epoch.h"
 #include "../Core/LogManager.h"
 
@@ -49,6 +50,7 @@ class ENGINE_API ChannelReader
 
 		// start reading at the given point in time
 		void Start(const Core::Time& time);
+		bool HasStarted() const													{ return mHasStarted; }
 
 		// call this regulary 
 		void Update();
@@ -64,10 +66,10 @@ class ENGINE_API ChannelReader
 		void   Flush()															{ Advance(mNumNewSamples); }
 		void   Advance(uint32 numSamples);
 
-		template <class T> const T& GetSample(uint32 index);
-		template <class T> const T& GetOldestSample();			
-		template <class T> const T& PopOldestSample();		
-		template <class T> const T& GetNewestSample();			
+		template <class T> typename ChannelSampleValue<T>::Type GetSample(uint32 index);
+		template <class T> typename ChannelSampleValue<T>::Type GetOldestSample();			
+		template <class T> typename ChannelSampleValue<T>::Type PopOldestSample();		
+		template <class T> typename ChannelSampleValue<T>::Type GetNewestSample();			
 
 
 		// returns the index of the sample inside the channel
@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "CrossSpectrum.h"
+#include "../Core/Math.h"
+
+
+using namespace Core;
+
+// constructor
+CrossSpectrum::CrossSpectrum()
+{
+	mNumChannels		= 0;
+	mNumBins			= 0;
+	mNumEpochs			= 0;
+	mNumSmoothingEpochs	= 1;
+}
+
+
+// destructor
+CrossSpectrum::~CrossSpectrum()
+{
+}
+
+
+// allocate the accumulators
+void CrossSpectrum::Init(uint32 numChannels, uint32 numBins, const Array<Pair>& pairs)
+{
+	mNumChannels	= numChannels;
+	mNumBins		= numBins;
+	mPairs			= pairs;
+
+	const uint32 numPairs = mPairs.Size();
+	mSpectra.Resize(numChannels * numBins);
+	mAutoSpectra.Resize(numChannels * numBins);
+	mCrossSpectra.Resize(numPairs * numBins);
+	mPhaseLocking.Resize(numPairs * numBins);
+	mAbsImagCross.Resize(numPairs * numBins);
+
+	Reset();
+}
+
+
+// clear the accumulators
+void CrossSpectrum::Reset()
+{
+	mNumEpochs = 0;
+
+	const uint32 numAuto = mAutoSpectra.Size();
+	for (uint32 i=0; i<numAuto; ++i)
+		mAutoSpectra[i] = 0.0;
+
+	const uint32 numCross = mCrossSpectra.Size();
+	for (uint32 i=0; i<numCross; ++i)
+	{
+		mCrossSpectra[i] = Complex();
+		mPhaseLocking[i] = Complex();
+		mAbsImagCross[i] = 0.0;
+	}
+}
+
+
+// accumulate the spectra of one epoch
+void CrossSpectrum::AddEpoch()
+{
+	mNumEpochs++;
+
+	// running mean until the smoothing window is filled, exponential moving average afterwards
+	const double weight = 1.0 / Min<uint32>(mNumEpochs, mNumSmoothingEpochs);
+	const double keep = 1.0 - weight;
+
+	// auto spectra
+	const uint32 numAuto = mNumChannels * mNumBins;
+	for (uint32 i=0; i<numAuto; ++i)
+		mAutoSpectra[i] = keep * mAutoSpectra[i] + weight * mSpectra[i].SquaredNorm();
+
+	// cross spectra
+	const uint32 numPairs = mPairs.Size();
+	for (uint32 p=0; p<numPairs; ++p)
+	{
+		const Complex* spectrumA = mSpectra.GetPtr() + mPairs[p].mChannelA * mNumBins;
+		const Complex* spectrumB = mSpectra.GetPtr() + mPairs[p].mChannelB * mNumBins;
+		Complex* crossSpectra	= mCrossSpectra.GetPtr() + p * mNumBins;
+		Complex* phaseLocking	= mPhaseLocking.GetPtr() + p * mNumBins;
+		double* absImagCross	= mAbsImagCross.GetPtr() + p * mNumBins;
+
+		for (uint32 b=0; b<mNumBins; ++b)
+		{
+			// Sxy = X * conj(Y)
+			const Complex cross = spectrumA[b] * ComplexMath::Conjugate(spectrumB[b]);
+			const double magnitude = cross.Norm();
+
+			crossSpectra[b] = crossSpectra[b] * keep + cross * weight;
+			if (magnitude > 0.0)
+				phaseLocking[b] = phaseLocking[b] * keep + cross * (weight / magnitude);
+			else
+				phaseLocking[b] *= keep;
+			absImagCross[b] = keep * absImagCross[b] + weight * Math::AbsD(cross.mImag);
+		}
+	}
+}
+
+
+// band average of a connectivity measure over the bins [firstBin, firstBin + numBins)
+double CrossSpectrum::CalcMeasure(EMeasure measure, uint32 pairIndex, uint32 firstBin, uint32 numBins) const
+{
+	CORE_ASSERT(firstBin + numBins <= mNumBins);
+	if (numBins == 0 || mNumEpochs == 0)
+		return 0.0;
+
+	const double* autoA			= mAutoSpectra.GetPtr() + mPairs[pairIndex].mChannelA * mNumBins + firstBin;
+	const double* autoB			= mAutoSpectra.GetPtr() + mPairs[pairIndex].mChannelB * mNumBins + firstBin;
+	const Complex* crossSpectra	= mCrossSpectra.GetPtr() + pairIndex * mNumBins + firstBin;
+	const Complex* phaseLocking	= mPhaseLocking.GetPtr() + pairIndex * mNumBins + firstBin;
+	const double* absImagCross	= mAbsImagCross.GetPtr() + pairIndex * mNumBins + firstBin;
+
+	double sum = 0.0;
+	for (uint32 b=0; b<numBins; ++b)
+	{
+		switch (measure)
+		{
+			case MEASURE_COHERENCE:
+			case MEASURE_IMAGINARYCOHERENCE:
+			{
+				const double power = Math::SqrtD(autoA[b] * autoB[b]);
+				if (power > 0.0)
+					sum += (measure == MEASURE_COHERENCE ? crossSpectra[b].Norm() : crossSpectra[b].mImag) / power;
+				break;
+			}
+
+			case MEASURE_PLV:
+				sum += phaseLocking[b].Norm();
+				break;
+
+			case MEASURE_WPLI:
+				if (absImagCross[b] > 0.0)
+					sum += Math::AbsD(crossSpectra[b].mImag) / absImagCross[b];
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	return sum / numBins;
+}
+
+
+// measure names (used for the output ports)
+const char* CrossSpectrum::GetMeasureName(uint32 measure)
+{
+	switch (measure)
+	{
+		case MEASURE_COHERENCE:				return "Coherence";
+		case MEASURE_IMAGINARYCOHERENCE:	return "Imag. Coherence";
+		case MEASURE_PLV:					return "PLV";
+		case MEASURE_WPLI:					return "wPLI";
+		default:							return "";
+	}
+}
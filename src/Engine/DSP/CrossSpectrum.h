@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_CROSSSPECTRUM_H
+#define __NEUROMORE_CROSSSPECTRUM_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/ComplexMath.h"
+
+
+// smoothed cross-spectral matrix of a set of channels, restricted to a range of frequency bins
+// Each epoch adds one complex spectrum per channel (N FFTs); every channel pair then only costs a few multiply-accumulates per bin.
+class ENGINE_API CrossSpectrum
+{
+	public:
+		// the connectivity measures derived from the cross-spectra
+		enum EMeasure
+		{
+			MEASURE_COHERENCE = 0,				// magnitude of the coherency |Sxy| / sqrt(Sxx Syy)
+			MEASURE_IMAGINARYCOHERENCE,			// imaginary part of the coherency (insensitive to volume conduction, Nolte 2004)
+			MEASURE_PLV,						// phase locking value |<Sxy / |Sxy|>|
+			MEASURE_WPLI,						// weighted phase lag index |<Im Sxy>| / <|Im Sxy|> (Vinck 2011)
+			NUM_MEASURES
+		};
+
+		struct Pair
+		{
+			uint32 mChannelA;
+			uint32 mChannelB;
+
+			Pair(uint32 channelA = 0, uint32 channelB = 0) : mChannelA(channelA), mChannelB(channelB) {}
+		};
+
+		// constructor & destructor
+		CrossSpectrum();
+		~CrossSpectrum();
+
+		// allocate the accumulators for the given pairs and number of bins
+		void Init(uint32 numChannels, uint32 numBins, const Core::Array<Pair>& pairs);
+		void Reset();
+
+		// exponential smoothing over this many epochs (after the first numEpochs epochs, before that it is a running mean)
+		void SetNumSmoothingEpochs(uint32 numEpochs)							{ mNumSmoothingEpochs = (numEpochs > 0 ? numEpochs : 1); }
+
+		uint32 GetNumChannels() const											{ return mNumChannels; }
+		uint32 GetNumBins() const												{ return mNumBins; }
+		uint32 GetNumPairs() const												{ return mPairs.Size(); }
+		const Pair& GetPair(uint32 index) const									{ return mPairs[index]; }
+		uint32 GetNumEpochs() const												{ return mNumEpochs; }
+
+		// set the spectrum of a channel for the next epoch, then call AddEpoch() once all channels are set
+		Core::Complex* GetSpectrum(uint32 channel)								{ return mSpectra.GetPtr() + channel * mNumBins; }
+		void AddEpoch();
+
+		// band average of a measure for a pair (over all bins or over a sub range, so several bands share the same cross-spectra)
+		double CalcMeasure(EMeasure measure, uint32 pairIndex) const					{ return CalcMeasure(measure, pairIndex, 0, mNumBins); }
+		double CalcMeasure(EMeasure measure, uint32 pairIndex, uint32 firstBin, uint32 numBins) const;
+
+		static const char* GetMeasureName(uint32 measure);
+
+	private:
+		uint32							mNumChannels;
+		uint32							mNumBins;
+		uint32							mNumEpochs;
+		uint32							mNumSmoothingEpochs;
+		Core::Array<Pair>				mPairs;
+
+		Core::Array<Core::Complex>		mSpectra;			// spectra of the current epoch (channel x bin)
+		Core::Array<double>				mAutoSpectra;		// smoothed Sxx (channel x bin)
+		Core::Array<Core::Complex>		mCrossSpectra;		// smoothed Sxy (pair x bin)
+		Core::Array<Core::Complex>		mPhaseLocking;		// smoothed Sxy / |Sxy| (pair x bin)
+		Core::Array<double>				mAbsImagCross;		// smoothed |Im Sxy| (pair x bin)
+};
+
+
+#endif
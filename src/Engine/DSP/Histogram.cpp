@@ -31,6 +31,11 @@
 
 using namespace Core;
 
+// limits of the integer bin mapping (grid indices stay exact in doubles, the merge factor can't overflow)
+#define HISTOGRAM_MAXGRIDINDEX		(1LL << 52)
+#define HISTOGRAM_MAXGRIDFACTOR		(1LL << 40)
+
+
 // initialize histogram
 void Histogram::Init (uint32 numBins, double minValue, double maxValue)
 {
@@ -43,8 +48,19 @@ void Histogram::Init (uint32 numBins, double minValue, double maxValue)
 
 	mNumBins	= numBins;
 	mBinWidth	= mRange / numBins;
+
+	mGridMinValue	= minValue;
+	mGridBinWidth	= mBinWidth;
+	mGridOffset		= 0;
+	mGridFactor		= 1;
 	
+	// segment tree size
+	mNumLeaves = 1;
+	while (mNumLeaves < numBins)
+		mNumLeaves *= 2;
+
 	mBins.Resize(numBins);
+	mTree.Resize(2 * mNumLeaves);
 	Clear();
 }
 
@@ -54,6 +70,129 @@ void Histogram::Clear()
 	Core::MemSet( mBins.GetPtr(), 0, mBins.Size()*sizeof(uint32) );
 
 	mNumValues = 0;
+
+	BuildTree();
+}
+
+
+// extend the range by merging neighbouring bins
+bool Histogram::ExtendRange(double minValue, double maxValue)
+{
+	if (mNumBins == 0 || mBinWidth <= 0.0)
+		return false;
+
+	// same headroom as used when initializing from an epoch, to reduce the number of range changes
+	const double headroom = (maxValue - minValue) / 4.0;
+	const double targetMin = Min(minValue - headroom, mMinValue);
+	const double targetMax = Max(maxValue + headroom, mMaxValue);
+
+	// the bins (in the current width) that hold the target range, the first one may lie in front of bin 0
+	const int64 lowBin	= Min<int64>( CalcUnclampedBinIndex(targetMin), 0 );
+	const int64 highBin	= Max<int64>( CalcUnclampedBinIndex(targetMax), mNumBins - 1 );
+
+	// number of old bins to prepend, and total number of old bins the new range has to span
+	const int64 numPrepend = -lowBin;
+	const int64 numSpanned = highBin - lowBin + 1;
+
+	// range grows by too much or is invalid: let the caller rebuild the histogram instead
+	if (numSpanned > (int64)mNumBins * (1 << 20))
+		return false;
+
+	// merge factor: each new bin spans 'factor' old bins
+	int64 factor = 2;
+	while (factor * mNumBins < numSpanned)
+		factor *= 2;
+
+	if (mGridFactor * factor > HISTOGRAM_MAXGRIDFACTOR)
+		return false;
+
+	// rebin: the new bin of old bin i is (i + numPrepend) / factor, so every old bin falls into exactly one new bin
+	Core::Array<uint32> oldBins = mBins;
+	Core::MemSet( mBins.GetPtr(), 0, mBins.Size()*sizeof(uint32) );
+	for (uint32 i=0; i<mNumBins; ++i)
+		mBins[(uint32)((i + numPrepend) / factor)] += oldBins[i];
+
+	// the same mapping on the grid
+	mGridOffset	+= numPrepend * mGridFactor;
+	mGridFactor	*= factor;
+
+	mMinValue	= mGridMinValue - mGridOffset * mGridBinWidth;
+	mBinWidth	= mGridBinWidth * mGridFactor;
+	mMaxValue	= mMinValue + mNumBins * mBinWidth;
+	mRange		= mMaxValue - mMinValue;
+
+	BuildTree();
+	return true;
+}
+
+
+void Histogram::SetBin(uint32 index, uint32 value)
+{
+	mBins[index] = value;
+	UpdateTree(index);
+}
+
+
+// recalculate all tree nodes from the bins
+void Histogram::BuildTree()
+{
+	// not initialized yet
+	if (mNumLeaves == 0)
+		return;
+
+	for (uint32 i=0; i<mNumLeaves; ++i)
+	{
+		TreeNode& leaf = mTree[mNumLeaves + i];
+		if (i < mNumBins)
+		{
+			leaf.mCount = mBins[i];
+			leaf.mMinCount = mBins[i];
+			leaf.mMaxCount = mBins[i];
+			leaf.mWeightedCount = (double)i * mBins[i];
+		}
+		else
+		{
+			// padding leaves are empty and don't take part in the minimum
+			leaf.mCount = 0;
+			leaf.mMinCount = CORE_INVALIDINDEX32;
+			leaf.mMaxCount = 0;
+			leaf.mWeightedCount = 0.0;
+		}
+	}
+
+	for (uint32 node=mNumLeaves-1; node>0; --node)
+	{
+		const TreeNode& left = mTree[2 * node];
+		const TreeNode& right = mTree[2 * node + 1];
+		TreeNode& parent = mTree[node];
+		parent.mCount = left.mCount + right.mCount;
+		parent.mMinCount = Min<uint32>(left.mMinCount, right.mMinCount);
+		parent.mMaxCount = Max<uint32>(left.mMaxCount, right.mMaxCount);
+		parent.mWeightedCount = left.mWeightedCount + right.mWeightedCount;
+	}
+}
+
+
+// update the leaf of the given bin and all its parents
+void Histogram::UpdateTree(uint32 index)
+{
+	uint32 node = mNumLeaves + index;
+	TreeNode& leaf = mTree[node];
+	leaf.mCount = mBins[index];
+	leaf.mMinCount = mBins[index];
+	leaf.mMaxCount = mBins[index];
+	leaf.mWeightedCount = (double)index * mBins[index];
+
+	for (node/=2; node>0; node/=2)
+	{
+		const TreeNode& left = mTree[2 * node];
+		const TreeNode& right = mTree[2 * node + 1];
+		TreeNode& parent = mTree[node];
+		parent.mCount = left.mCount + right.mCount;
+		parent.mMinCount = Min<uint32>(left.mMinCount, right.mMinCount);
+		parent.mMaxCount = Max<uint32>(left.mMaxCount, right.mMaxCount);
+		parent.mWeightedCount = left.mWeightedCount + right.mWeightedCount;
+	}
 }
 
 
@@ -81,6 +220,7 @@ void Histogram::AddValue(double value)
 
 	const uint32 binIndex = CalcBinIndex(value);
 	mBins[binIndex]++;
+	UpdateTree(binIndex);
 
 	mNumValues++;
 }
@@ -89,12 +229,14 @@ void Histogram::AddValue(double value)
 void Histogram::RemoveValue(double value)
 {
 	const uint32 binIndex = CalcBinIndex(value);
-	
 	CORE_ASSERT(mBins[binIndex] != 0);
 
 	// never allow underflow (happens in case class is misshandled)
 	if (mBins[binIndex] > 0)
+	{
 		mBins[binIndex]--;
+		UpdateTree(binIndex);
+	}
 	
 	if (mNumValues > 0)
 		mNumValues--;
@@ -109,66 +251,276 @@ uint32 Histogram::CalcBinIndex(double value) const
 		return 0;
 
 	// clamp to valid range (don't return core invalid index, the caller has to know what he asks for)
-	if (value <= mMinValue)
+	const int64 binIndex = CalcUnclampedBinIndex(value);
+	if (binIndex <= 0)
 		return 0;
-	else if (value >= mMaxValue)
+	else if (binIndex >= mNumBins)
 		return mNumBins-1;
 
-	return (value-mMinValue) / mRange * mNumBins;
+	return (uint32)binIndex;
+}
+
+
+bool Histogram::IsInRange(double value) const
+{
+	if (mRange == 0)
+		return (value == mMinValue);
+
+	const int64 binIndex = CalcUnclampedBinIndex(value);
+	return (binIndex >= 0 && binIndex < mNumBins);
+}
+
+
+// index of the initial bin the value falls into (clamped so the integer math can't overflow, NaN ends up below the range)
+int64 Histogram::CalcGridIndex(double value) const
+{
+	const double gridIndex = Math::FloorD( (value - mGridMinValue) / mGridBinWidth );
+	if ((gridIndex > -HISTOGRAM_MAXGRIDINDEX) == false)
+		return -HISTOGRAM_MAXGRIDINDEX;
+	if (gridIndex > HISTOGRAM_MAXGRIDINDEX)
+		return HISTOGRAM_MAXGRIDINDEX;
+
+	return (int64)gridIndex;
+}
+
+
+// merge the grid index into the current bins (rounds towards negative infinity)
+int64 Histogram::CalcUnclampedBinIndex(double value) const
+{
+	const int64 index = CalcGridIndex(value) + mGridOffset;
+	if (index >= 0)
+		return index / mGridFactor;
+
+	return -((-index + mGridFactor - 1) / mGridFactor);
 }
 
 
 // find the top bin of the histogram (first non-empty bin looking from top-down)
 uint32 Histogram::FindHighBin() const
 {
-	for (int32 i=mNumBins-1; i>=0; --i)
-	{
-		if (mBins[i] != 0)
-			return i;
-	}
-
 	// all bins are empty: just return the top bin
-	return mNumBins-1;
+	if (mNumValues == 0)
+		return mNumBins-1;
+
+	// the top bin is the first one that completes the total count
+	const uint32 numValues = mTree[1].mCount;
+	return FindFirstBin( [numValues](uint32 index, uint32 count, double weightedCount) { return count >= numValues; } );
 }
 
 // find the bottom bin of the histogram (first non-empty bin looking from bottom-up)
 uint32 Histogram::FindLowBin() const
 {
-	for (uint32 i=0; i<mNumBins; ++i)
-	{
-		if (mBins[i] != 0)
-			return i;
-	}
-
 	// all bins are empty: just return the lowest bin
-	return 0;
+	if (mNumValues == 0)
+		return 0;
+
+	return FindFirstBin( [](uint32 index, uint32 count, double weightedCount) { return count > 0; } );
 }
 
 
 // find the bin with the lowest count and return it
 uint32 Histogram::CalcMinCount() const
 {
-	uint32 result = CORE_INVALIDINDEX32;
-
-	for (uint32 i=0; i<mNumBins; ++i)
-		result = Min<uint32>( result, mBins[i] );
-
-	if (result == CORE_INVALIDINDEX32)
+	if (mNumBins == 0)
 		return 0;
 
-	return result;
+	return mTree[1].mMinCount;
 }
 
 
 // find the bin with the highest count and return it
 uint32 Histogram::CalcMaxCount() const
+{
+	if (mNumBins == 0)
+		return 0;
+
+	return mTree[1].mMaxCount;
+}
+
+
+// sum of the counts of bins 0..index
+uint32 Histogram::CalcCumulativeCount(uint32 index) const
 {
 	uint32 result = 0;
 
-	for (uint32 i=0; i<mNumBins; ++i)
-		result = Max<uint32>( result, mBins[i] );
+	// walk up from the leaf and add every left sibling
+	for (uint32 node=mNumLeaves+index; node>1; node/=2)
+	{
+		if (node % 2 == 1)
+			result += mTree[node - 1].mCount;
+	}
+
+	return result + mBins[index];
+}
+
+
+// sum of binIndex*count of bins 0..index
+double Histogram::CalcCumulativeWeightedCount(uint32 index) const
+{
+	double result = 0.0;
+
+	for (uint32 node=mNumLeaves+index; node>1; node/=2)
+	{
+		if (node % 2 == 1)
+			result += mTree[node - 1].mWeightedCount;
+	}
+
+	return result + (double)index * mBins[index];
+}
+
+
+// threshold search for the auto threshold node: walks the bins upwards from the low threshold until the target share of the values (or of the signal area) lies between both thresholds
+// Note: the bins are searched on the cumulative counts in O(log bins), with the same result as walking them one by one
+double Histogram::CalcHighThreshold(double lowThreshold, double target, bool areaTarget) const
+{
+	if (mNumValues == 0)
+		return 0;
+
+	// targets for both mode
+	const uint32 numSamples = mNumValues;
+	const uint32 scoreTargetSampleCount = numSamples * target;
+
+	const uint32 highBinIndex = mNumBins-1;//FindHighBin();
+	const uint32 lowBinIndex = CalcBinIndex(lowThreshold);
+
+	// cumulative counts of the bins below the low threshold bin
+	const uint32 countBelow = (lowBinIndex > 0 ? CalcCumulativeCount(lowBinIndex-1) : 0);
+	const double weightedCountBelow = (lowBinIndex > 0 ? CalcCumulativeWeightedCount(lowBinIndex-1) : 0.0);
+
+	if (areaTarget == false)
+	{
+		// first bin where the count of the bins lowBinIndex..i reaches the target count
+		const uint32 binIndex = FindFirstBin( [&](uint32 index, uint32 count, double weightedCount) { return index >= lowBinIndex && count - countBelow >= scoreTargetSampleCount; } );
+		if (binIndex < mNumBins)
+		{
+			const uint32 binSize = mBins[binIndex];
+			const uint32 currentSampleCount = CalcCumulativeCount(binIndex) - countBelow;
+			const double highThreshold = GetBinMaxValue(binIndex);
+
+			// fine-adjust the threshold within BinMinValue and BinMaxValue by assuming equal sample distribution within the bin;
+			const uint32 numSamplesOvershoot = currentSampleCount - scoreTargetSampleCount;
+			const double correctionOffset = (binSize == 0 ? 0 : mBinWidth *  ( (double)numSamplesOvershoot / (double)binSize)); // Note: this check is probably unnecessary because the currentSampleCount never increases when binSize is zero ?!
+			return highThreshold - correctionOffset;
+		}
+	}
+	else // area target
+	{
+		// area test for a high threshold at the top of bin i (count and weightedCount are the cumulative counts of the bins 0..i)
+		auto reachesTarget = [&](uint32 index, uint32 count, double weightedCount)
+		{
+			const double highThreshold = GetBinMaxValue(index);
+			const double height = (highThreshold - lowThreshold);
+			if (height == 0)
+				return false;
+
+			const uint32 currentSampleCount = count - countBelow;
+
+			const double totalArea = height * (double)numSamples;
+
+			// real area taken up by the waveform within the thresholds: sum of (BinMaxValue(i) - BinMaxValue(j)) * binSize(j) over the bins lowBinIndex..i (exact on the integer counts)
+			const double currentArea = mBinWidth * ((double)index * currentSampleCount - (weightedCount - weightedCountBelow));
+
+			// calculate target area from current thresholds
+			const double targetArea = totalArea * target;
+			
+			return currentArea >= targetArea;
+		};
+
+		// the difference between current and target area is convex in the bin index, so above the first bin the test stays true once it is reached
+		// (the first bin is tested on its own because the walk skips bins with zero height)
+		if (reachesTarget(lowBinIndex, CalcCumulativeCount(lowBinIndex), CalcCumulativeWeightedCount(lowBinIndex)) == true)
+			return GetBinMaxValue(lowBinIndex);
+
+		const uint32 binIndex = FindFirstBin( [&](uint32 index, uint32 count, double weightedCount) { return index > lowBinIndex && reachesTarget(index, count, weightedCount); } );
+		if (binIndex < mNumBins)
+		{
+			// TODO fine-adjust the threshold if possible? same as above?? -> whiteboard time!
+			return GetBinMaxValue(binIndex);
+		}
+	}
+
+	// goal was not reached, return the largest value we have			// TODO: add some kind of 'success' output to the node? 
+	return GetBinMaxValue( highBinIndex );
+}
+
+
+// same as CalcHighThreshold(), walking the bins downwards from the high threshold
+double Histogram::CalcLowThreshold(double highThreshold, double target, bool areaTarget) const
+{
+	if (mNumValues == 0)
+		return 0;
+
+	// targets for both mode
+	const uint32 numSamples = mNumValues;
+	const uint32 scoreTargetSampleCount = numSamples * target;
+
+	const uint32 highBinIndex = CalcBinIndex(highThreshold);
+	const uint32 lowBinIndex = 0;//FindLowBin();
+
+	// cumulative counts of the bins up to the high threshold bin
+	const uint32 countUpTo = CalcCumulativeCount(highBinIndex);
+	const double weightedCountUpTo = CalcCumulativeWeightedCount(highBinIndex);
+
+	// walking down from highBinIndex, the result is the largest bin i that passes the test. The search looks for the first bin k = i-1 whose cumulative count
+	// (= count of the bins below i) is too large, so the found bin index is i
+
+	if (areaTarget == false)
+	{
+		// count of the bins i..highBinIndex must reach the target count
+		if (countUpTo >= scoreTargetSampleCount)
+		{
+			const uint32 binIndex = FindFirstBin( [&](uint32 index, uint32 count, double weightedCount) { return index >= highBinIndex || countUpTo - count < scoreTargetSampleCount; } );
+
+			const uint32 binSize = mBins[binIndex];
+			const uint32 currentSampleCount = countUpTo - (binIndex > 0 ? CalcCumulativeCount(binIndex-1) : 0);
+			const double lowThreshold = GetBinMinValue(binIndex);
+
+			// fine-adjust the threshold within BinMinValue and BinMaxValue by assuming equal sample distribution within the bin;
+			const uint32 numSamplesOvershoot = currentSampleCount - scoreTargetSampleCount;
+			const double correctionOffset = (binSize == 0 ? 0 : mBinWidth *  ( (double)numSamplesOvershoot / (double)binSize)); // Note: this check is probably unnecessary because the currentSampleCount never increases when binSize is zero ?!
+			return lowThreshold + correctionOffset;
+		}
+	}
+	else // area target
+	{
+		// area test for a low threshold at the bottom of bin i (countBelow and weightedCountBelow are the cumulative counts of the bins 0..i-1)
+		auto reachesTarget = [&](uint32 index, uint32 countBelow, double weightedCountBelow)
+		{
+			const double lowThreshold = GetBinMinValue(index);
+			const double height = (highThreshold - lowThreshold);
+			if (height == 0)
+				return false;
+
+			const uint32 currentSampleCount = countUpTo - countBelow;
+
+			const double totalArea = height * (double)numSamples;
+
+			// real area taken up by the waveform within the thresholds: sum of (BinMinValue(j) - BinMinValue(i)) * binSize(j) over the bins i..highBinIndex (exact on the integer counts)
+			const double currentArea = mBinWidth * ((weightedCountUpTo - weightedCountBelow) - (double)index * currentSampleCount);
+
+			// calculate target area from current thresholds
+			const double targetArea = totalArea * target;
+			
+			return currentArea >= targetArea;
+		};
+
+		// first bin on its own (same as in CalcHighThreshold())
+		const uint32 highBinSize = mBins[highBinIndex];
+		if (reachesTarget(highBinIndex, countUpTo - highBinSize, weightedCountUpTo - (double)highBinIndex * highBinSize) == true)
+			return GetBinMinValue(highBinIndex);
+
+		// below it the test is true for all bins up to the result
+		if (highBinIndex > lowBinIndex && reachesTarget(lowBinIndex, 0, 0.0) == true)
+		{
+			const uint32 binIndex = FindFirstBin( [&](uint32 index, uint32 count, double weightedCount) { return index + 1 >= highBinIndex || reachesTarget(index + 1, count, weightedCount) == false; } );
+
+			// TODO fine-adjust the threshold if possible? same as above?? -> whiteboard time!
+			return GetBinMinValue(binIndex);
+		}
+	}
 
-	return result;
+	// goal was not reached, return the smallest value we have			// TODO: add some kind of 'success' output to the node? 
+	return GetBinMinValue( lowBinIndex );
 }
 
 
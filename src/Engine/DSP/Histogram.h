@@ -30,6 +30,7 @@
 #include "../Core/String.h"
 #include "../Core/Color.h"
 #include "../Core/ComplexMath.h"
+#include "../Core/Math.h"
 
 
 // the Histogram class
@@ -37,11 +38,14 @@ class ENGINE_API Histogram
 {
 	public:
 		// constructor & destructor
-		Histogram() : mNumBins(0), mBinWidth(0), mNumValues(0), mMinValue(0), mMaxValue(0), mRange(0) 	{}
+		Histogram() : mNumBins(0), mNumLeaves(0), mBinWidth(0), mGridMinValue(0), mGridBinWidth(0), mGridOffset(0), mGridFactor(1), mNumValues(0), mMinValue(0), mMaxValue(0), mRange(0) 	{}
 		Histogram(uint32 numBins, double minValue, double maxValue)										{ Init(minValue, maxValue, numBins); }
 		~Histogram()																					{}
 
 		void Init (uint32 numBins, double minValue, double maxValue);
+
+		// extend the range so it covers the given values by merging bins (the bin width grows by a power of two and the old bins stay aligned); returns false if the histogram has no range yet or the range grows too much
+		bool ExtendRange(double minValue, double maxValue);
 		
 		// writing/reading from channels
 		void Read(double* binValues);
@@ -59,7 +63,7 @@ class ENGINE_API Histogram
 
 		uint32 GetNumBins() const									{ return mNumBins; }
 		uint32 GetBin(uint32 index) const							{ return mBins[index]; }
-		void SetBin(uint32 index, uint32 value)						{ mBins[index] = value; }
+		void SetBin(uint32 index, uint32 value);
 		double GetBinWidth() const									{ return mBinWidth; }
 		
 		double GetMinValue() const									{ return mMinValue; }
@@ -70,6 +74,7 @@ class ENGINE_API Histogram
 		double GetBinCenterValue(uint32 index) const				{ return mMinValue + index * mBinWidth * 0.5; }
 	
 		uint32 CalcBinIndex(double value) const;
+		bool IsInRange(double value) const;							// value falls into one of the bins without being clamped
 
 		uint32 FindHighBin() const;
 		uint32 FindLowBin() const;
@@ -77,11 +82,47 @@ class ENGINE_API Histogram
 		uint32 CalcMinCount() const;
 		uint32 CalcMaxCount() const;
 
+		// cumulative count of the bins 0..index, and of binIndex*count (for weighted sums over bin positions)
+		uint32 CalcCumulativeCount(uint32 index) const;
+		double CalcCumulativeWeightedCount(uint32 index) const;
+
+		// threshold that puts the target share (0..1) of the values (or of the signal area, if areaTarget is set) between the given threshold and the result
+		double CalcHighThreshold(double lowThreshold, double target, bool areaTarget) const;
+		double CalcLowThreshold(double highThreshold, double target, bool areaTarget) const;
+
+		// find the first bin for which predicate(binIndex, cumulativeCount, cumulativeWeightedCount) is true, in O(log bins)
+		// the predicate must be monotone (false for all bins before the result, true for all bins after it); returns GetNumBins() if it is never true
+		template <class Predicate>
+		uint32 FindFirstBin(Predicate predicate) const;
+
 	private:
+		// segment tree node: aggregate of a power of two range of bins
+		struct TreeNode
+		{
+			uint32					mCount;
+			uint32					mMinCount;
+			uint32					mMaxCount;
+			double					mWeightedCount;	// sum of binIndex*count
+		};
+
+		void UpdateTree(uint32 index);
+		void BuildTree();
+
+		int64 CalcGridIndex(double value) const;
+		int64 CalcUnclampedBinIndex(double value) const;
+
 		Core::Array<uint32>			mBins;			// histogram bins	// Note: we should use double instead of integer due to our channel design. Remember: int32 can be represented exactly with doubles, that should be enough :)
 		uint32						mNumBins;		// number of bins 
+		Core::Array<TreeNode>		mTree;			// segment tree over the bins (node 1 is the root, the leaves start at mNumLeaves)
+		uint32						mNumLeaves;		// number of leaves (power of two >= mNumBins)
 		double						mBinWidth;		// width of a bin (in value-space)
 
+		// bins are mapped on the grid of the initial bins using integers only, so a value always ends up in the same bin no matter how often the range was extended
+		double						mGridMinValue;	// min value of the initial bin 0
+		double						mGridBinWidth;	// width of the initial bins
+		int64						mGridOffset;	// number of grid bins in front of the initial bin 0 (bin 0 starts at grid index -mGridOffset)
+		int64						mGridFactor;	// number of grid bins per bin (power of two)
+
 		uint32						mNumValues;		// total number of samples currently in the histogram
 
 		double						mMinValue;		// = min value of bin 0
@@ -90,4 +131,44 @@ class ENGINE_API Histogram
 };
 
 
+// descend the tree and stay left whenever the predicate is already true at the end of the left subtree
+template <class Predicate>
+uint32 Histogram::FindFirstBin(Predicate predicate) const
+{
+	if (mNumBins == 0)
+		return 0;
+
+	// predicate is never true
+	if (predicate(mNumBins - 1, mTree[1].mCount, mTree[1].mWeightedCount) == false)
+		return mNumBins;
+
+	uint32 node = 1;
+	uint32 firstBin = 0;
+	uint32 size = mNumLeaves;
+	uint32 count = 0;
+	double weightedCount = 0.0;
+	while (node < mNumLeaves)
+	{
+		size /= 2;
+		const TreeNode& left = mTree[2 * node];
+
+		// last bin of the left subtree (the padding leaves are empty, so the last real bin has the same cumulative counts)
+		const uint32 lastBin = Core::Min<uint32>(firstBin + size, mNumBins) - 1;
+		if (predicate(lastBin, count + left.mCount, weightedCount + left.mWeightedCount) == true)
+		{
+			node = 2 * node;
+		}
+		else
+		{
+			count += left.mCount;
+			weightedCount += left.mWeightedCount;
+			firstBin += size;
+			node = 2 * node + 1;
+		}
+	}
+
+	return firstBin;
+}
+
+
 #endif
@@ -0,0 +1,274 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "HrvFrequencyDomain.h"
+
+
+using namespace Core;
+
+// constructor
+HrvFrequencyDomain::HrvFrequencyDomain()
+{
+	mBins.Resize(NUM_BINS);
+	Clear();
+}
+
+
+// remove all beats
+void HrvFrequencyDomain::Clear()
+{
+	for (uint32 i = 0; i < NUM_BINS; ++i)
+	{
+		Bin& bin = mBins[i];
+		bin.mSumCos = 0.0;
+		bin.mSumSin = 0.0;
+		bin.mSumYCos = 0.0;
+		bin.mSumYSin = 0.0;
+		bin.mSumCos2 = 0.0;
+		bin.mSumSin2 = 0.0;
+	}
+
+	mNumBeats = 0;
+	mSumRR = 0.0;
+}
+
+
+// add (sign = 1) or remove (sign = -1) the contribution of a single beat to all bins
+void HrvFrequencyDomain::Accumulate(double time, double rr, double sign)
+{
+	for (uint32 i = 0; i < NUM_BINS; ++i)
+	{
+		const double omega = Math::twoPiD * (FIRST_BIN + i) * FREQUENCY_RESOLUTION;
+		const double c = cos(omega * time);
+		const double s = sin(omega * time);
+
+		Bin& bin = mBins[i];
+		bin.mSumCos  += sign * c;
+		bin.mSumSin  += sign * s;
+		bin.mSumYCos += sign * rr * c;
+		bin.mSumYSin += sign * rr * s;
+		bin.mSumCos2 += sign * (c * c - s * s);		// cos(2wt)
+		bin.mSumSin2 += sign * (2.0 * s * c);		// sin(2wt)
+	}
+
+	if (sign > 0.0)
+		mNumBeats++;
+	else
+		mNumBeats--;
+
+	mSumRR += sign * rr;
+}
+
+
+// unnormalized Lomb-Scargle power of a single bin, evaluated from the bin sums
+double HrvFrequencyDomain::CalcBinPower(const Bin& bin, uint32 numBeats, double mean)
+{
+	// sums of the mean-free values
+	const double sumYCos = bin.mSumYCos - mean * bin.mSumCos;
+	const double sumYSin = bin.mSumYSin - mean * bin.mSumSin;
+
+	// time offset tau: tan(2*w*tau) = sum sin(2wt) / sum cos(2wt); cos(w*tau) and sin(w*tau) follow from the half angle formulas
+	const double r = Math::SqrtD(bin.mSumCos2 * bin.mSumCos2 + bin.mSumSin2 * bin.mSumSin2);
+	const double cos2Tau = (r > 0.0 ? bin.mSumCos2 / r : 1.0);
+	double cosTau = Math::SqrtD(Max(0.0, 0.5 * (1.0 + cos2Tau)));
+	double sinTau = Math::SqrtD(Max(0.0, 0.5 * (1.0 - cos2Tau)));
+	if (bin.mSumSin2 < 0.0)
+		sinTau = -sinTau;
+
+	const double a = cosTau * sumYCos + sinTau * sumYSin;		// sum y*cos(w(t-tau))
+	const double b = cosTau * sumYSin - sinTau * sumYCos;		// sum y*sin(w(t-tau))
+	const double sumCosSq = 0.5 * (numBeats + r);				// sum cos^2(w(t-tau))
+	const double sumSinSq = 0.5 * (numBeats - r);				// sum sin^2(w(t-tau))
+
+	const double epsilon = 1e-9 * numBeats;
+	double power = 0.0;
+	if (sumCosSq > epsilon)
+		power += a * a / sumCosSq;
+	if (sumSinSq > epsilon)
+		power += b * b / sumSinSq;
+
+	return 0.5 * power;
+}
+
+
+// evaluate the band powers of the incremental periodogram
+void HrvFrequencyDomain::CalcBandPowers(double timeSpan, double* outLF, double* outHF) const
+{
+	*outLF = 0.0;
+	*outHF = 0.0;
+
+	if (mNumBeats < 3 || timeSpan <= 0.0)
+		return;
+
+	const double mean = mSumRR / mNumBeats;
+
+	double lf = 0.0;
+	double hf = 0.0;
+	for (uint32 i = 0; i < NUM_BINS; ++i)
+	{
+		const double power = CalcBinPower(mBins[i], mNumBeats, mean);
+		if (FIRST_BIN + i < FIRST_HF_BIN)
+			lf += power;
+		else
+			hf += power;
+	}
+
+	// power spectral density is 2*P/n*T (s^2/Hz); integrate over the bins and convert to ms^2
+	const double scale = 2.0 / mNumBeats * timeSpan * FREQUENCY_RESOLUTION * 1e6;
+	*outLF = lf * scale;
+	*outHF = hf * scale;
+}
+
+
+// batch version, evaluated directly from the definition of the periodogram
+void HrvFrequencyDomain::CalcBandPowers(const double* intervals, uint32 numIntervals, double* outLF, double* outHF)
+{
+	*outLF = 0.0;
+	*outHF = 0.0;
+
+	// beat times and mean of the valid intervals
+	Array<double> times;
+	Array<double> values;
+	times.Reserve(numIntervals);
+	values.Reserve(numIntervals);
+
+	double time = 0.0;
+	double sum = 0.0;
+	for (uint32 i = 0; i < numIntervals; ++i)
+	{
+		if (intervals[i] <= 0.0)
+			continue;
+
+		time += intervals[i];
+		times.Add(time);
+		values.Add(intervals[i]);
+		sum += intervals[i];
+	}
+
+	const uint32 numBeats = values.Size();
+	if (numBeats < 3)
+		return;
+
+	const double mean = sum / numBeats;
+	const double timeSpan = times[numBeats - 1] - times[0];
+	if (timeSpan <= 0.0)
+		return;
+
+	double lf = 0.0;
+	double hf = 0.0;
+	for (uint32 k = FIRST_BIN; k < END_BIN; ++k)
+	{
+		const double omega = Math::twoPiD * k * FREQUENCY_RESOLUTION;
+
+		// time offset tau
+		double sumSin2 = 0.0;
+		double sumCos2 = 0.0;
+		for (uint32 i = 0; i < numBeats; ++i)
+		{
+			sumSin2 += sin(2.0 * omega * times[i]);
+			sumCos2 += cos(2.0 * omega * times[i]);
+		}
+		const double tau = atan2(sumSin2, sumCos2) / (2.0 * omega);
+
+		double a = 0.0, b = 0.0, cc = 0.0, ss = 0.0;
+		for (uint32 i = 0; i < numBeats; ++i)
+		{
+			const double c = cos(omega * (times[i] - tau));
+			const double s = sin(omega * (times[i] - tau));
+			const double y = values[i] - mean;
+			a += y * c;
+			b += y * s;
+			cc += c * c;
+			ss += s * s;
+		}
+
+		const double epsilon = 1e-9 * numBeats;
+		double power = 0.0;
+		if (cc > epsilon)
+			power += a * a / cc;
+		if (ss > epsilon)
+			power += b * b / ss;
+		power *= 0.5;
+
+		if (k < FIRST_HF_BIN)
+			lf += power;
+		else
+			hf += power;
+	}
+
+	const double scale = 2.0 / numBeats * timeSpan * FREQUENCY_RESOLUTION * 1e6;
+	*outLF = lf * scale;
+	*outHF = hf * scale;
+}
+
+
+// helper for the epoch functions (band: 0 = LF, 1 = HF, 2 = LF/HF)
+void HrvFrequencyDomain::EpochBandPowers(ChannelReader* inputReader, Channel<double>* output, uint32 band)
+{
+	Array<double> intervals;
+
+	// process all input epochs
+	const uint32 numEpochs = inputReader->GetNumEpochs();
+	for (uint32 i = 0; i < numEpochs; i++)
+	{
+		Epoch epoch = inputReader->PopOldestEpoch();
+
+		const uint32 numSamples = epoch.GetNumSamples();
+		intervals.Resize(numSamples);
+		for (uint32 s = 0; s < numSamples; s++)
+			intervals[s] = epoch.GetSample(s);
+
+		double lf, hf;
+		CalcBandPowers(intervals.GetPtr(), numSamples, &lf, &hf);
+
+		switch (band)
+		{
+			case 0:		output->AddSample(lf); break;
+			case 1:		output->AddSample(hf); break;
+			default:	output->AddSample(CalcRatio(lf, hf)); break;
+		}
+	}
+}
+
+
+void HrvFrequencyDomain::LF(ChannelReader* inputReader, Channel<double>* output)
+{
+	EpochBandPowers(inputReader, output, 0);
+}
+
+
+void HrvFrequencyDomain::HF(ChannelReader* inputReader, Channel<double>* output)
+{
+	EpochBandPowers(inputReader, output, 1);
+}
+
+
+void HrvFrequencyDomain::LFHF(ChannelReader* inputReader, Channel<double>* output)
+{
+	EpochBandPowers(inputReader, output, 2);
+}
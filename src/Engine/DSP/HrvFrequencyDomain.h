@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+#ifndef __NEUROMORE_HRVFREQUENCYDOMAIN_H
+#define __NEUROMORE_HRVFREQUENCYDOMAIN_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/Array.h"
+#include "ChannelReader.h"
+#include "Channel.h"
+
+
+// frequency domain HRV measures: LF (0.04-0.15 Hz) and HF (0.15-0.4 Hz) band power of the RR tachogram
+// Note: RR intervals are unevenly spaced in time, so the spectrum is estimated with the Lomb-Scargle periodogram instead of an FFT of a resampled series
+class ENGINE_API HrvFrequencyDomain
+{
+	public:
+		enum
+		{
+			FIRST_BIN		= 16,		// 0.04 Hz
+			FIRST_HF_BIN	= 60,		// 0.15 Hz
+			END_BIN			= 160,		// 0.40 Hz (exclusive)
+			NUM_BINS		= END_BIN - FIRST_BIN
+		};
+
+		static constexpr double FREQUENCY_RESOLUTION = 0.0025;	// bin width in Hz
+
+		// constructor & destructor
+		HrvFrequencyDomain();
+		~HrvFrequencyDomain()													{}
+
+		// incremental periodogram: add or remove a single beat (time in seconds, relative to a fixed origin, and its RR interval in seconds)
+		void Clear();
+		void AddBeat(double time, double rr)									{ Accumulate(time, rr, 1.0); }
+		void RemoveBeat(double time, double rr)									{ Accumulate(time, rr, -1.0); }
+		uint32 GetNumBeats() const												{ return mNumBeats; }
+
+		// evaluate the LF and HF band power (in ms^2) of the beats added so far; timeSpan is the time between the first and the last beat
+		void CalcBandPowers(double timeSpan, double* outLF, double* outHF) const;
+
+		// batch version: evaluates the periodogram of the given RR intervals directly (intervals <= 0 are ignored)
+		static void CalcBandPowers(const double* intervals, uint32 numIntervals, double* outLF, double* outHF);
+
+		// batch epoch functions (same signature as the time domain functions)
+		static void CORE_CDECL LF(ChannelReader* inputReader, Channel<double>* output);
+		static void CORE_CDECL HF(ChannelReader* inputReader, Channel<double>* output);
+		static void CORE_CDECL LFHF(ChannelReader* inputReader, Channel<double>* output);
+
+		static double CalcRatio(double lf, double hf)							{ return (hf > 0.0 ? lf / hf : 0.0); }
+
+	private:
+		// per frequency bin sums of the periodogram
+		struct Bin
+		{
+			double mSumCos;			// sum cos(wt)
+			double mSumSin;			// sum sin(wt)
+			double mSumYCos;		// sum y*cos(wt)
+			double mSumYSin;		// sum y*sin(wt)
+			double mSumCos2;		// sum cos(2wt)
+			double mSumSin2;		// sum sin(2wt)
+		};
+
+		void Accumulate(double time, double rr, double sign);
+		static double CalcBinPower(const Bin& bin, uint32 numBeats, double mean);
+
+		Core::Array<Bin>	mBins;
+		uint32				mNumBeats;
+		double				mSumRR;
+
+		static void EpochBandPowers(ChannelReader* inputReader, Channel<double>* output, uint32 band);
+};
+
+
+#endif
@@ -36,7 +36,6 @@ HrvProcessor::HrvProcessor() : ChannelProcessor()
 {
 	Init();
 
-	mTimeDomainFunction			= NULL;
 	mSettings.mTimeDomainMethod	= HrvTimeDomain::METHOD_RMSSD;
 	mSettings.mNumRRIntervals	= 10;
 	mSettings.mStartTime		= 0;
@@ -88,8 +87,10 @@ void HrvProcessor::ReInit()
 	GetInputReader()->SetEpochShift(1);
 	GetInputReader()->SetEpochZeroPadding(true);
 
-	// update algo function pointer
-	mTimeDomainFunction = HrvTimeDomain::GetFunction(mSettings.mTimeDomainMethod);
+	// reset the sliding window together with the input reader, so it starts with the same zero padding as the epochs
+	const bool isFrequencyDomain = (mSettings.mTimeDomainMethod == HrvTimeDomain::METHOD_LF || mSettings.mTimeDomainMethod == HrvTimeDomain::METHOD_HF || mSettings.mTimeDomainMethod == HrvTimeDomain::METHOD_LFHF);
+	mWindow.SetFrequencyDomainEnabled(isFrequencyDomain);
+	mWindow.Init(mSettings.mNumRRIntervals);
 
 	mIsInitialized = true;
 }
@@ -100,16 +101,18 @@ void HrvProcessor::Update()
 	// update input readers
 	ChannelProcessor::Update();
 
-	// call resample method (if set and inputs are connected)
-	if (GetInput() != NULL)
-	{
-		if (mTimeDomainFunction != NULL)
-		{
-			ChannelReader* inputReader = GetInputReader();
-			Channel<double>* output = GetOutput()->AsType<double>();
+	if (GetInput() == NULL || mIsInitialized == false)
+		return;
 
-			(mTimeDomainFunction)(inputReader, output);
-		}
+	ChannelReader* inputReader = GetInputReader();
+	Channel<double>* output = GetOutput()->AsType<double>();
+
+	// push each new interval into the window and output the value of the window ending at it (same as one epoch with shift 1)
+	const uint32 numNewSamples = inputReader->GetNumNewSamples();
+	for (uint32 i = 0; i < numNewSamples; i++)
+	{
+		mWindow.AddInterval(inputReader->PopOldestSample<double>());
+		output->AddSample(mWindow.GetValue(mSettings.mTimeDomainMethod));
 	}
 }
 
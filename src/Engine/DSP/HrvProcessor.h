@@ -28,6 +28,7 @@
 #include "../Config.h"
 #include "ChannelProcessor.h"
 #include "HrvTimeDomain.h"
+#include "HrvSlidingWindow.h"
 
 
 // heart rate variability processor
@@ -82,7 +83,7 @@ class ENGINE_API HrvProcessor : public ChannelProcessor
 		uint32 GetNumEpochSamples(uint32 inputPortIndex) const override						{ return mSettings.mNumRRIntervals + 1; }
 
 	private:
-		HrvTimeDomain::Function	mTimeDomainFunction;
+		HrvSlidingWindow		mWindow;				// incremental calculation of the selected method (one output sample per interval)
 		Settings				mSettings;
 };
 
@@ -0,0 +1,255 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "HrvSlidingWindow.h"
+
+
+using namespace Core;
+
+// constructor
+HrvSlidingWindow::HrvSlidingWindow()
+{
+	mFrequencyDomainEnabled = false;
+	Init(2);
+}
+
+
+// (re)initialize the window
+void HrvSlidingWindow::Init(uint32 numIntervals)
+{
+	mLength = Max<uint32>(2, numIntervals);
+
+	mIntervals.Resize(mLength);
+	mTimes.Resize(mLength);
+	for (uint32 i = 0; i < mLength; ++i)
+	{
+		mIntervals[i] = 0.0;
+		mTimes[i] = 0.0;
+	}
+
+	mNumAdded = 0;
+	mNumAddedSinceRecalc = 0;
+	mTime = 0.0;
+
+	mSumSD = 0.0;
+	mSumSquaredSD = 0.0;
+	mNumAbove50 = 0;
+	mNumAbove20 = 0;
+
+	InitQueue(mMinQueue);
+	InitQueue(mMaxQueue);
+
+	mFrequencyDomain.Clear();
+}
+
+
+// push the newest interval: one successive difference leaves the window, one enters it
+void HrvSlidingWindow::AddInterval(double rr)
+{
+	const uint32 slot = GetSlot(mNumAdded);
+	const double oldest = mIntervals[slot];
+	const double secondOldest = mIntervals[GetSlot(mNumAdded + 1)];
+	const double newest = mIntervals[GetSlot(mNumAdded + mLength - 1)];
+
+	const double removedSD = oldest - secondOldest;
+	const double addedSD = newest - rr;
+
+	mSumSD += addedSD - removedSD;
+	mSumSquaredSD += addedSD * addedSD - removedSD * removedSD;
+
+	// same comparisons as HrvTimeDomain::RRX()
+	if (removedSD > 0.05)	mNumAbove50--;
+	if (removedSD > 0.02)	mNumAbove20--;
+	if (addedSD > 0.05)		mNumAbove50++;
+	if (addedSD > 0.02)		mNumAbove20++;
+
+	// periodogram: only positive intervals are beats
+	if (mFrequencyDomainEnabled == true && oldest > 0.0)
+		mFrequencyDomain.RemoveBeat(mTimes[slot], oldest);
+
+	if (rr > 0.0)
+	{
+		mTime += rr;
+		if (mFrequencyDomainEnabled == true)
+			mFrequencyDomain.AddBeat(mTime, rr);
+	}
+
+	mIntervals[slot] = rr;
+	mTimes[slot] = mTime;
+
+	PushQueue(mMinQueue, mNumAdded, false);
+	PushQueue(mMaxQueue, mNumAdded, true);
+
+	mNumAdded++;
+
+	// rebuild the running sums once per window length, so rounding errors can't accumulate
+	mNumAddedSinceRecalc++;
+	if (mNumAddedSinceRecalc >= mLength)
+		Recalculate();
+}
+
+
+// recalculate all running sums from the window contents and move the time origin to the newest beat
+void HrvSlidingWindow::Recalculate()
+{
+	mNumAddedSinceRecalc = 0;
+
+	mSumSD = 0.0;
+	mSumSquaredSD = 0.0;
+	for (uint32 i = 0; i < mLength - 1; ++i)
+	{
+		const double sd = mIntervals[GetSlot(mNumAdded + i)] - mIntervals[GetSlot(mNumAdded + i + 1)];
+		mSumSD += sd;
+		mSumSquaredSD += sd * sd;
+	}
+
+	const double origin = mTime;
+	for (uint32 i = 0; i < mLength; ++i)
+		mTimes[i] -= origin;
+	mTime = 0.0;
+
+	if (mFrequencyDomainEnabled == true)
+	{
+		mFrequencyDomain.Clear();
+		for (uint32 i = 0; i < mLength; ++i)
+		{
+			const uint32 slot = GetSlot(mNumAdded + i);
+			if (mIntervals[slot] > 0.0)
+				mFrequencyDomain.AddBeat(mTimes[slot], mIntervals[slot]);
+		}
+	}
+}
+
+
+void HrvSlidingWindow::InitQueue(ExtremaQueue& queue)
+{
+	queue.mItems.Resize(mLength);
+	queue.mHead = 0;
+	queue.mCount = 0;
+}
+
+
+// add the interval with the given sequence number to a monotonic queue (the front is always the minimum or maximum of the window)
+void HrvSlidingWindow::PushQueue(ExtremaQueue& queue, uint64 index, bool isMax)
+{
+	// remove intervals that left the window
+	while (queue.mCount > 0 && queue.mItems[queue.mHead] + mLength <= index)
+	{
+		queue.mHead = (queue.mHead + 1) % mLength;
+		queue.mCount--;
+	}
+
+	// remove intervals that can't become the extremum anymore
+	const double value = mIntervals[GetSlot(index)];
+	while (queue.mCount > 0)
+	{
+		const uint32 back = (queue.mHead + queue.mCount - 1) % mLength;
+		const double backValue = mIntervals[GetSlot(queue.mItems[back])];
+		if ((isMax == true && backValue > value) || (isMax == false && backValue < value))
+			break;
+
+		queue.mCount--;
+	}
+
+	queue.mItems[(queue.mHead + queue.mCount) % mLength] = index;
+	queue.mCount++;
+}
+
+
+double HrvSlidingWindow::GetRMSSD() const
+{
+	return Math::SqrtD( Max(0.0, mSumSquaredSD) / (mLength - 1) );
+}
+
+
+double HrvSlidingWindow::GetSDSD() const
+{
+	const double mean = mSumSD / (mLength - 1);
+	const double variance = mSumSquaredSD / (mLength - 1) - mean * mean;
+	return Math::SqrtD( Max(0.0, variance) );
+}
+
+
+// range of the intervals inside the window (zero padding excluded, same as Epoch::Min/Max)
+double HrvSlidingWindow::GetEBC() const
+{
+	if (mNumAdded == 0)
+		return 0.0;
+
+	return GetQueueFront(mMaxQueue) - GetQueueFront(mMinQueue);
+}
+
+
+void HrvSlidingWindow::CalcBandPowers(double* outLF, double* outHF) const
+{
+	*outLF = 0.0;
+	*outHF = 0.0;
+
+	if (mFrequencyDomainEnabled == false)
+		return;
+
+	// time of the oldest beat inside the window (skip the zero padding)
+	uint32 first = (mNumAdded < mLength ? mLength - (uint32)mNumAdded : 0);
+	while (first < mLength && mIntervals[GetSlot(mNumAdded + first)] <= 0.0)
+		first++;
+
+	if (first >= mLength)
+		return;
+
+	const double timeSpan = mTime - mTimes[GetSlot(mNumAdded + first)];
+	mFrequencyDomain.CalcBandPowers(timeSpan, outLF, outHF);
+}
+
+
+double HrvSlidingWindow::GetValue(HrvTimeDomain::EMethod method) const
+{
+	switch (method)
+	{
+		case HrvTimeDomain::METHOD_RMSSD:		return GetRMSSD();
+		case HrvTimeDomain::METHOD_SDSD:		return GetSDSD();
+		case HrvTimeDomain::METHOD_EBC:			return GetEBC();
+		case HrvTimeDomain::METHOD_RR50:		return GetRR50();
+		case HrvTimeDomain::METHOD_pRR50:		return GetpRR50();
+		case HrvTimeDomain::METHOD_pRR20:		return GetpRR20();
+
+		case HrvTimeDomain::METHOD_LF:
+		case HrvTimeDomain::METHOD_HF:
+		case HrvTimeDomain::METHOD_LFHF:
+		{
+			double lf, hf;
+			CalcBandPowers(&lf, &hf);
+			if (method == HrvTimeDomain::METHOD_LF)
+				return lf;
+			if (method == HrvTimeDomain::METHOD_HF)
+				return hf;
+			return HrvFrequencyDomain::CalcRatio(lf, hf);
+		}
+
+		default:								return 0.0;
+	}
+}
@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+#ifndef __NEUROMORE_HRVSLIDINGWINDOW_H
+#define __NEUROMORE_HRVSLIDINGWINDOW_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/Array.h"
+#include "HrvTimeDomain.h"
+#include "HrvFrequencyDomain.h"
+
+
+// incremental HRV over the last N RR intervals
+// Gives the same results as the HrvTimeDomain functions on a zero padded epoch with shift 1, but each new interval only updates running sums and counters
+class ENGINE_API HrvSlidingWindow
+{
+	public:
+		// constructor & destructor
+		HrvSlidingWindow();
+		~HrvSlidingWindow()														{}
+
+		// (re)initialize the window; it starts out filled with zeros, same as a zero padded epoch
+		void Init(uint32 numIntervals);
+
+		// the periodogram is only maintained if enabled (set before calling Init)
+		void SetFrequencyDomainEnabled(bool enable)								{ mFrequencyDomainEnabled = enable; }
+
+		// push the newest RR interval (in seconds)
+		void AddInterval(double rr);
+
+		uint32 GetLength() const												{ return mLength; }
+		uint64 GetNumIntervalsAdded() const										{ return mNumAdded; }
+
+		// time domain
+		double GetRMSSD() const;
+		double GetSDSD() const;
+		double GetEBC() const;
+		double GetRR50() const													{ return mNumAbove50; }
+		double GetpRR50() const													{ return (double)mNumAbove50 / (double)(mLength - 1); }
+		double GetpRR20() const													{ return (double)mNumAbove20 / (double)(mLength - 1); }
+
+		// frequency domain (band powers in ms^2)
+		void CalcBandPowers(double* outLF, double* outHF) const;
+
+		// value of the given method
+		double GetValue(HrvTimeDomain::EMethod method) const;
+
+	private:
+		// monotonic queue of interval sequence numbers for the sliding minimum and maximum
+		struct ExtremaQueue
+		{
+			Core::Array<uint64>	mItems;
+			uint32				mHead;
+			uint32				mCount;
+		};
+
+		void Recalculate();
+		void InitQueue(ExtremaQueue& queue);
+		void PushQueue(ExtremaQueue& queue, uint64 index, bool isMax);
+		double GetQueueFront(const ExtremaQueue& queue) const					{ return mIntervals[GetSlot(queue.mItems[queue.mHead])]; }
+		uint32 GetSlot(uint64 index) const										{ return (uint32)(index % mLength); }
+
+		Core::Array<double>	mIntervals;				// ring buffer with the last N intervals (the oldest one is at mNumAdded % N)
+		Core::Array<double>	mTimes;					// beat time of each interval
+		uint32				mLength;
+		uint64				mNumAdded;
+		uint32				mNumAddedSinceRecalc;
+		double				mTime;					// time of the newest beat
+
+		// successive differences (older - newer) inside the window
+		double				mSumSD;
+		double				mSumSquaredSD;
+		uint32				mNumAbove50;
+		uint32				mNumAbove20;
+
+		ExtremaQueue		mMinQueue;
+		ExtremaQueue		mMaxQueue;
+
+		HrvFrequencyDomain	mFrequencyDomain;
+		bool				mFrequencyDomainEnabled;
+};
+
+
+#endif
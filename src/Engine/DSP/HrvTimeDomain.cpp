@@ -26,6 +26,7 @@
 
 // include required headers
 #include "HrvTimeDomain.h"
+#include "HrvFrequencyDomain.h"
 
 
 using namespace Core;
@@ -208,6 +209,9 @@ const char* HrvTimeDomain::GetName(EMethod method)
 		case METHOD_RR50:		return "RR50";
 		case METHOD_pRR50:		return "pRR50";
 		case METHOD_pRR20:		return "pRR20";
+		case METHOD_LF:			return "LF";
+		case METHOD_HF:			return "HF";
+		case METHOD_LFHF:		return "LF/HF";
 		default:				return "Unknown";
 	}
 }
@@ -227,6 +231,9 @@ bool HrvTimeDomain::GetIntervalRequirement(EMethod method)
 		case METHOD_RR50:
 		case METHOD_pRR50:
 		case METHOD_pRR20:
+		case METHOD_LF:
+		case METHOD_HF:
+		case METHOD_LFHF:
 			return true;
 
 		default:			return false;
@@ -245,6 +252,9 @@ HrvTimeDomain::Function HrvTimeDomain::GetFunction(EMethod method)
 		case METHOD_RR50:		return (&RR50);
 		case METHOD_pRR50:		return (&pRR50);
 		case METHOD_pRR20:		return (&pRR20);
+		case METHOD_LF:			return (&HrvFrequencyDomain::LF);
+		case METHOD_HF:			return (&HrvFrequencyDomain::HF);
+		case METHOD_LFHF:		return (&HrvFrequencyDomain::LFHF);
 		default:		
 			CORE_ASSERT(false); 
 			return (&RMSSD);
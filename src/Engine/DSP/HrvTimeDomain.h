@@ -41,6 +41,9 @@ class HrvTimeDomain
 			METHOD_RR50,					// the number of pairs of successive RRs that differ by more than 50 ms
 			METHOD_pRR50,					// the proportion of "the number of pairs of successive RRs that differ by more than 50 ms." divided by total number of RRs
 			METHOD_pRR20,					// same as pRR50 but with 20ms
+			METHOD_LF,						// low frequency (0.04-0.15 Hz) band power of the RR intervals (Lomb-Scargle, see HrvFrequencyDomain)
+			METHOD_HF,						// high frequency (0.15-0.4 Hz) band power of the RR intervals
+			METHOD_LFHF,					// ratio of LF and HF band power
 			NUM_TIME_DOMAIN_METHODS
 		};
 
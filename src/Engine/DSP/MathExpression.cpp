@@ -0,0 +1,686 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "MathExpression.h"
+#include "../Core/Math.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+using namespace Core;
+
+//-----------------------------------------------
+// the operations (same conventions as the Math1/Math2 nodes)
+//-----------------------------------------------
+
+static inline double CalculateNegate(double x)					{ return -x; }
+static inline double CalculateAbs(double x)						{ return Math::AbsD(x); }
+static inline double CalculateSqrt(double x)					{ return Math::SafeSqrtD(x); }
+static inline double CalculateExp(double x)						{ return Math::ExpD(x); }
+static inline double CalculateLog(double x)						{ if (x > Math::epsilon) return Math::LogD(x); return 0.0; }
+static inline double CalculateLog10(double x)					{ if (x > Math::epsilon) return Math::Log10D(x); return 0.0; }
+static inline double CalculateSin(double x)						{ return Math::SinD(x); }
+static inline double CalculateCos(double x)						{ return Math::CosD(x); }
+static inline double CalculateTan(double x)						{ return Math::TanD(x); }
+static inline double CalculateASin(double x)					{ return Math::ASinD(x); }
+static inline double CalculateACos(double x)					{ return Math::ACosD(x); }
+static inline double CalculateATan(double x)					{ return Math::ATanD(x); }
+static inline double CalculateFloor(double x)					{ return Math::FloorD(x); }
+static inline double CalculateCeil(double x)					{ return Math::CeilD(x); }
+static inline double CalculateSign(double x)					{ if (x < 0.0) return -1.0; if (x > 0.0) return 1.0; return 0.0; }
+
+static inline double CalculateAdd(double x, double y)			{ return x + y; }
+static inline double CalculateSubtract(double x, double y)		{ return x - y; }
+static inline double CalculateMultiply(double x, double y)		{ return x * y; }
+static inline double CalculateDivide(double x, double y)		{ if (IsClose<double>(y, 0.0, Math::epsilon) == false) return x / y; return 0.0; }
+static inline double CalculatePow(double x, double y)			{ if (IsClose<double>(x, 0.0, Math::epsilon) == true && y < 0.0) return 0.0; return Math::PowD(x, y); }
+static inline double CalculateMin(double x, double y)			{ return Min<double>(x, y); }
+static inline double CalculateMax(double x, double y)			{ return Max<double>(x, y); }
+
+
+// the block loops, the operation is a template argument so it gets inlined
+template <double (*Function)(double)>
+static void ApplyUnary(const double* x, double* out, uint32 numSamples)
+{
+	for (uint32 i=0; i<numSamples; ++i)
+		out[i] = Function(x[i]);
+}
+
+template <double (*Function)(double, double)>
+static void ApplyBinary(const double* x, const double* y, double* out, uint32 numSamples)
+{
+	for (uint32 i=0; i<numSamples; ++i)
+		out[i] = Function(x[i], y[i]);
+}
+
+template <double (*Function)(double, double)>
+static void ApplyBinaryImmediate(const double* x, double y, double* out, uint32 numSamples)
+{
+	for (uint32 i=0; i<numSamples; ++i)
+		out[i] = Function(x[i], y);
+}
+
+
+static bool IsBinary(uint32 opCode)
+{
+	switch (opCode)
+	{
+		case MathExpression::OP_ADD:
+		case MathExpression::OP_SUBTRACT:
+		case MathExpression::OP_MULTIPLY:
+		case MathExpression::OP_DIVIDE:
+		case MathExpression::OP_POW:
+		case MathExpression::OP_MIN:
+		case MathExpression::OP_MAX:
+			return true;
+		default:
+			return false;
+	}
+}
+
+
+// function names and their opcodes
+struct MathExpressionFunction
+{
+	const char*					mName;
+	MathExpression::EOpCode		mOpCode;
+	uint32						mNumArguments;
+};
+
+static const MathExpressionFunction gMathExpressionFunctions[] =
+{
+	{ "abs",	MathExpression::OP_ABS,		1 },
+	{ "sqrt",	MathExpression::OP_SQRT,	1 },
+	{ "exp",	MathExpression::OP_EXP,		1 },
+	{ "log",	MathExpression::OP_LOG,		1 },
+	{ "ln",		MathExpression::OP_LOG,		1 },
+	{ "log10",	MathExpression::OP_LOG10,	1 },
+	{ "sin",	MathExpression::OP_SIN,		1 },
+	{ "cos",	MathExpression::OP_COS,		1 },
+	{ "tan",	MathExpression::OP_TAN,		1 },
+	{ "asin",	MathExpression::OP_ASIN,	1 },
+	{ "acos",	MathExpression::OP_ACOS,	1 },
+	{ "atan",	MathExpression::OP_ATAN,	1 },
+	{ "floor",	MathExpression::OP_FLOOR,	1 },
+	{ "ceil",	MathExpression::OP_CEIL,	1 },
+	{ "sign",	MathExpression::OP_SIGN,	1 },
+	{ "min",	MathExpression::OP_MIN,		2 },
+	{ "max",	MathExpression::OP_MAX,		2 },
+	{ "pow",	MathExpression::OP_POW,		2 },
+};
+
+
+// constructor
+MathExpression::MathExpression()
+{
+	mStackDepth		= 0;
+	mPos			= NULL;
+	mFormula		= NULL;
+	mVariableNames	= NULL;
+}
+
+
+// destructor
+MathExpression::~MathExpression()
+{
+}
+
+
+void MathExpression::Clear()
+{
+	mInstructions.Clear();
+	mStack.Clear();
+	mOperands.Clear();
+	mVariables.Clear();
+	mStackDepth = 0;
+	mError.Clear();
+}
+
+
+// parse the formula and generate the bytecode
+bool MathExpression::Compile(const char* formula, const Array<String>& variableNames)
+{
+	Clear();
+
+	mFormula = formula;
+	mPos = formula;
+	mVariableNames = &variableNames;
+
+	bool result = ParseExpression();
+	if (result == true)
+	{
+		SkipWhitespace();
+		if (*mPos != '\0')
+			result = SetError("Unexpected character");
+	}
+
+	mPos = NULL;
+	mFormula = NULL;
+	mVariableNames = NULL;
+
+	if (result == false)
+	{
+		mInstructions.Clear();
+		return false;
+	}
+
+	// maximum stack depth, one block per slot
+	uint32 depth = 0;
+	const uint32 numInstructions = mInstructions.Size();
+	for (uint32 i=0; i<numInstructions; ++i)
+	{
+		const Instruction& instruction = mInstructions[i];
+		if (instruction.mOpCode == OP_CONSTANT || instruction.mOpCode == OP_VARIABLE)
+			++depth;
+		else if (IsBinary(instruction.mOpCode) == true && instruction.mImmediate == false)
+			--depth;
+
+		mStackDepth = Max(mStackDepth, depth);
+	}
+
+	mStack.Resize(mStackDepth * BLOCKSIZE);
+	mOperands.Resize(mStackDepth);
+	mVariables.Resize(variableNames.Size());
+	return true;
+}
+
+
+bool MathExpression::UsesVariable(uint32 index) const
+{
+	const uint32 numInstructions = mInstructions.Size();
+	for (uint32 i=0; i<numInstructions; ++i)
+		if (mInstructions[i].mOpCode == OP_VARIABLE && mInstructions[i].mVariable == index)
+			return true;
+
+	return false;
+}
+
+
+//-----------------------------------------------
+// parser
+//-----------------------------------------------
+
+// expression := term (('+' | '-') term)*
+bool MathExpression::ParseExpression()
+{
+	if (ParseTerm() == false)
+		return false;
+
+	while (true)
+	{
+		if (Accept('+') == true)
+		{
+			if (ParseTerm() == false)
+				return false;
+			EmitBinary(OP_ADD);
+		}
+		else if (Accept('-') == true)
+		{
+			if (ParseTerm() == false)
+				return false;
+			EmitBinary(OP_SUBTRACT);
+		}
+		else
+			return true;
+	}
+}
+
+
+// term := unary (('*' | '/') unary)*
+bool MathExpression::ParseTerm()
+{
+	if (ParseUnary() == false)
+		return false;
+
+	while (true)
+	{
+		if (Accept('*') == true)
+		{
+			if (ParseUnary() == false)
+				return false;
+			EmitBinary(OP_MULTIPLY);
+		}
+		else if (Accept('/') == true)
+		{
+			if (ParseUnary() == false)
+				return false;
+			EmitBinary(OP_DIVIDE);
+		}
+		else
+			return true;
+	}
+}
+
+
+// unary := ('-' | '+') unary | power
+bool MathExpression::ParseUnary()
+{
+	if (Accept('-') == true)
+	{
+		if (ParseUnary() == false)
+			return false;
+		EmitUnary(OP_NEGATE);
+		return true;
+	}
+
+	if (Accept('+') == true)
+		return ParseUnary();
+
+	return ParsePower();
+}
+
+
+// power := primary ('^' unary)?   (right associative, binds stronger than the unary minus on its left)
+bool MathExpression::ParsePower()
+{
+	if (ParsePrimary() == false)
+		return false;
+
+	if (Accept('^') == true)
+	{
+		if (ParseUnary() == false)
+			return false;
+		EmitBinary(OP_POW);
+	}
+
+	return true;
+}
+
+
+// primary := number | variable | constant | function '(' arguments ')' | '(' expression ')'
+bool MathExpression::ParsePrimary()
+{
+	SkipWhitespace();
+
+	// number
+	if (isdigit((unsigned char)*mPos) || *mPos == '.')
+	{
+		char* end = NULL;
+		const double value = strtod(mPos, &end);
+		if (end == mPos)
+			return SetError("Invalid number");
+
+		mPos = end;
+		EmitConstant(value);
+		return true;
+	}
+
+	// sub expression
+	if (Accept('(') == true)
+	{
+		if (ParseExpression() == false)
+			return false;
+		if (Accept(')') == false)
+			return SetError("Missing ')'");
+		return true;
+	}
+
+	// identifier
+	if (isalpha((unsigned char)*mPos) || *mPos == '_')
+	{
+		const char* start = mPos;
+		while (isalnum((unsigned char)*mPos) || *mPos == '_')
+			++mPos;
+
+		String name;
+		name.Copy(start, (uint32)(mPos - start));
+
+		SkipWhitespace();
+		if (*mPos == '(')
+			return ParseFunction(name);
+
+		// variables first, so inputs can shadow the constants
+		const uint32 numVariables = mVariableNames->Size();
+		for (uint32 i=0; i<numVariables; ++i)
+		{
+			if ((*mVariableNames)[i] == name)
+			{
+				Instruction instruction;
+				instruction.mOpCode		= OP_VARIABLE;
+				instruction.mVariable	= i;
+				instruction.mImmediate	= false;
+				instruction.mValue		= 0.0;
+				mInstructions.Add(instruction);
+				return true;
+			}
+		}
+
+		if (name == "pi")
+		{
+			EmitConstant(Math::piD);
+			return true;
+		}
+
+		if (name == "e")
+		{
+			EmitConstant(Math::ExpD(1.0));
+			return true;
+		}
+
+		mPos = start;
+		mTempString.Format("Unknown variable '%s'", name.AsChar());
+		return SetError(mTempString.AsChar());
+	}
+
+	if (*mPos == '\0')
+		return SetError("Unexpected end of expression");
+
+	return SetError("Unexpected character");
+}
+
+
+// function call, the name was already consumed
+bool MathExpression::ParseFunction(const String& name)
+{
+	const MathExpressionFunction* function = NULL;
+	const uint32 numFunctions = sizeof(gMathExpressionFunctions) / sizeof(MathExpressionFunction);
+	for (uint32 i=0; i<numFunctions; ++i)
+	{
+		if (name == gMathExpressionFunctions[i].mName)
+		{
+			function = &gMathExpressionFunctions[i];
+			break;
+		}
+	}
+
+	if (function == NULL)
+	{
+		mTempString.Format("Unknown function '%s'", name.AsChar());
+		return SetError(mTempString.AsChar());
+	}
+
+	Accept('(');
+
+	for (uint32 i=0; i<function->mNumArguments; ++i)
+	{
+		if (i > 0 && Accept(',') == false)
+		{
+			mTempString.Format("Function '%s' expects %i arguments", function->mName, function->mNumArguments);
+			return SetError(mTempString.AsChar());
+		}
+
+		if (ParseExpression() == false)
+			return false;
+	}
+
+	if (Accept(')') == false)
+	{
+		mTempString.Format("Function '%s' expects %i argument%s", function->mName, function->mNumArguments, function->mNumArguments > 1 ? "s" : "");
+		return SetError(mTempString.AsChar());
+	}
+
+	if (function->mNumArguments == 1)
+		EmitUnary(function->mOpCode);
+	else
+		EmitBinary(function->mOpCode);
+
+	return true;
+}
+
+
+void MathExpression::SkipWhitespace()
+{
+	while (isspace((unsigned char)*mPos))
+		++mPos;
+}
+
+
+// consume the character if it comes next
+bool MathExpression::Accept(char c)
+{
+	SkipWhitespace();
+	if (*mPos != c)
+		return false;
+
+	++mPos;
+	return true;
+}
+
+
+// error message with the position in the formula (1-indexed)
+bool MathExpression::SetError(const char* message)
+{
+	mError.Format("%s at position %i", message, (int32)(mPos - mFormula) + 1);
+	return false;
+}
+
+
+//-----------------------------------------------
+// code generation with constant folding
+//-----------------------------------------------
+
+void MathExpression::EmitConstant(double value)
+{
+	Instruction instruction;
+	instruction.mOpCode		= OP_CONSTANT;
+	instruction.mVariable	= 0;
+	instruction.mImmediate	= false;
+	instruction.mValue		= value;
+	mInstructions.Add(instruction);
+}
+
+
+void MathExpression::EmitUnary(EOpCode opCode)
+{
+	// fold constant operand
+	Instruction& last = mInstructions.GetLast();
+	if (last.mOpCode == OP_CONSTANT)
+	{
+		last.mValue = CalculateUnary(opCode, last.mValue);
+		return;
+	}
+
+	Instruction instruction;
+	instruction.mOpCode		= opCode;
+	instruction.mVariable	= 0;
+	instruction.mImmediate	= false;
+	instruction.mValue		= 0.0;
+	mInstructions.Add(instruction);
+}
+
+
+void MathExpression::EmitBinary(EOpCode opCode)
+{
+	// note: an operand that ends with a constant instruction is that constant (a leaf), so the two previous instructions are the operands if both are constants
+	const uint32 numInstructions = mInstructions.Size();
+	if (mInstructions[numInstructions-1].mOpCode == OP_CONSTANT)
+	{
+		const double y = mInstructions[numInstructions-1].mValue;
+		mInstructions.RemoveLast();
+
+		// both constant: fold
+		Instruction& last = mInstructions.GetLast();
+		if (last.mOpCode == OP_CONSTANT)
+		{
+			last.mValue = CalculateBinary(opCode, last.mValue, y);
+			return;
+		}
+
+		// constant right operand: immediate
+		Instruction instruction;
+		instruction.mOpCode		= opCode;
+		instruction.mVariable	= 0;
+		instruction.mImmediate	= true;
+		instruction.mValue		= y;
+		mInstructions.Add(instruction);
+		return;
+	}
+
+	Instruction instruction;
+	instruction.mOpCode		= opCode;
+	instruction.mVariable	= 0;
+	instruction.mImmediate	= false;
+	instruction.mValue		= 0.0;
+	mInstructions.Add(instruction);
+}
+
+
+double MathExpression::CalculateUnary(EOpCode opCode, double x)
+{
+	switch (opCode)
+	{
+		case OP_NEGATE:	return CalculateNegate(x);
+		case OP_ABS:	return CalculateAbs(x);
+		case OP_SQRT:	return CalculateSqrt(x);
+		case OP_EXP:	return CalculateExp(x);
+		case OP_LOG:	return CalculateLog(x);
+		case OP_LOG10:	return CalculateLog10(x);
+		case OP_SIN:	return CalculateSin(x);
+		case OP_COS:	return CalculateCos(x);
+		case OP_TAN:	return CalculateTan(x);
+		case OP_ASIN:	return CalculateASin(x);
+		case OP_ACOS:	return CalculateACos(x);
+		case OP_ATAN:	return CalculateATan(x);
+		case OP_FLOOR:	return CalculateFloor(x);
+		case OP_CEIL:	return CalculateCeil(x);
+		case OP_SIGN:	return CalculateSign(x);
+		default:		CORE_ASSERT(false); return 0.0;
+	}
+}
+
+
+double MathExpression::CalculateBinary(EOpCode opCode, double x, double y)
+{
+	switch (opCode)
+	{
+		case OP_ADD:		return CalculateAdd(x, y);
+		case OP_SUBTRACT:	return CalculateSubtract(x, y);
+		case OP_MULTIPLY:	return CalculateMultiply(x, y);
+		case OP_DIVIDE:		return CalculateDivide(x, y);
+		case OP_POW:		return CalculatePow(x, y);
+		case OP_MIN:		return CalculateMin(x, y);
+		case OP_MAX:		return CalculateMax(x, y);
+		default:			CORE_ASSERT(false); return 0.0;
+	}
+}
+
+
+//-----------------------------------------------
+// evaluation
+//-----------------------------------------------
+
+void MathExpression::Evaluate(const double* const* variables, uint32 numSamples, double* outResults)
+{
+	if (IsValid() == false)
+		return;
+
+	for (uint32 offset=0; offset<numSamples; offset+=BLOCKSIZE)
+		EvaluateBlock(variables, offset, Min<uint32>(BLOCKSIZE, numSamples - offset), outResults + offset);
+}
+
+
+double MathExpression::Evaluate(const double* variableValues)
+{
+	if (IsValid() == false)
+		return 0.0;
+
+	const uint32 numVariables = mVariables.Size();
+	for (uint32 i=0; i<numVariables; ++i)
+		mVariables[i] = variableValues + i;
+
+	double result;
+	EvaluateBlock(mVariables.GetPtr(), 0, 1, &result);
+	return result;
+}
+
+
+// run the bytecode over one block: every instruction is a tight loop over all samples of the block
+//  stack slot i either points directly at the variable samples or at its own block in mStack
+void MathExpression::EvaluateBlock(const double* const* variables, uint32 offset, uint32 numSamples, double* outResults)
+{
+	int32 top = -1;
+
+	const uint32 numInstructions = mInstructions.Size();
+	for (uint32 i=0; i<numInstructions; ++i)
+	{
+		const Instruction& instruction = mInstructions[i];
+
+		if (instruction.mOpCode == OP_VARIABLE)
+		{
+			++top;
+			mOperands[top] = variables[instruction.mVariable] + offset;
+			continue;
+		}
+
+		if (instruction.mOpCode == OP_CONSTANT)
+		{
+			++top;
+			double* out = mStack.GetPtr() + top * BLOCKSIZE;
+			for (uint32 s=0; s<numSamples; ++s)
+				out[s] = instruction.mValue;
+			mOperands[top] = out;
+			continue;
+		}
+
+		const double* y = NULL;
+		if (IsBinary(instruction.mOpCode) == true && instruction.mImmediate == false)
+		{
+			y = mOperands[top];
+			--top;
+		}
+
+		const double* x = mOperands[top];
+		double* out = mStack.GetPtr() + top * BLOCKSIZE;
+		const double value = instruction.mValue;
+
+		switch (instruction.mOpCode)
+		{
+			case OP_NEGATE:		ApplyUnary<CalculateNegate>(x, out, numSamples);	break;
+			case OP_ABS:		ApplyUnary<CalculateAbs>(x, out, numSamples);		break;
+			case OP_SQRT:		ApplyUnary<CalculateSqrt>(x, out, numSamples);		break;
+			case OP_EXP:		ApplyUnary<CalculateExp>(x, out, numSamples);		break;
+			case OP_LOG:		ApplyUnary<CalculateLog>(x, out, numSamples);		break;
+			case OP_LOG10:		ApplyUnary<CalculateLog10>(x, out, numSamples);		break;
+			case OP_SIN:		ApplyUnary<CalculateSin>(x, out, numSamples);		break;
+			case OP_COS:		ApplyUnary<CalculateCos>(x, out, numSamples);		break;
+			case OP_TAN:		ApplyUnary<CalculateTan>(x, out, numSamples);		break;
+			case OP_ASIN:		ApplyUnary<CalculateASin>(x, out, numSamples);		break;
+			case OP_ACOS:		ApplyUnary<CalculateACos>(x, out, numSamples);		break;
+			case OP_ATAN:		ApplyUnary<CalculateATan>(x, out, numSamples);		break;
+			case OP_FLOOR:		ApplyUnary<CalculateFloor>(x, out, numSamples);		break;
+			case OP_CEIL:		ApplyUnary<CalculateCeil>(x, out, numSamples);		break;
+			case OP_SIGN:		ApplyUnary<CalculateSign>(x, out, numSamples);		break;
+
+			case OP_ADD:		if (y == NULL) ApplyBinaryImmediate<CalculateAdd>(x, value, out, numSamples);		else ApplyBinary<CalculateAdd>(x, y, out, numSamples);		break;
+			case OP_SUBTRACT:	if (y == NULL) ApplyBinaryImmediate<CalculateSubtract>(x, value, out, numSamples);	else ApplyBinary<CalculateSubtract>(x, y, out, numSamples);	break;
+			case OP_MULTIPLY:	if (y == NULL) ApplyBinaryImmediate<CalculateMultiply>(x, value, out, numSamples);	else ApplyBinary<CalculateMultiply>(x, y, out, numSamples);	break;
+			case OP_DIVIDE:		if (y == NULL) ApplyBinaryImmediate<CalculateDivide>(x, value, out, numSamples);	else ApplyBinary<CalculateDivide>(x, y, out, numSamples);	break;
+			case OP_POW:		if (y == NULL) ApplyBinaryImmediate<CalculatePow>(x, value, out, numSamples);		else ApplyBinary<CalculatePow>(x, y, out, numSamples);		break;
+			case OP_MIN:		if (y == NULL) ApplyBinaryImmediate<CalculateMin>(x, value, out, numSamples);		else ApplyBinary<CalculateMin>(x, y, out, numSamples);		break;
+			case OP_MAX:		if (y == NULL) ApplyBinaryImmediate<CalculateMax>(x, value, out, numSamples);		else ApplyBinary<CalculateMax>(x, y, out, numSamples);		break;
+
+			default:			CORE_ASSERT(false);
+		}
+
+		mOperands[top] = out;
+	}
+
+	CORE_ASSERT(top == 0);
+	memcpy(outResults, mOperands[0], numSamples * sizeof(double));
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+#ifndef __NEUROMORE_MATHEXPRESSION_H
+#define __NEUROMORE_MATHEXPRESSION_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/String.h"
+
+
+// math formula over a set of named variables, compiled once into postfix bytecode and evaluated over whole blocks of samples
+//  syntax: numbers, variables, pi, e, + - * / ^ (power), unary minus, parentheses and the functions
+//          abs sqrt exp log log10 sin cos tan asin acos atan floor ceil sign min(x,y) max(x,y) pow(x,y)
+//  division, log, sqrt and pow return 0 where the result is undefined, like the Math1/Math2 nodes do
+class ENGINE_API MathExpression
+{
+	public:
+		// samples per evaluation block (the stack holds one block per slot)
+		enum { BLOCKSIZE = 256 };
+
+		enum EOpCode
+		{
+			OP_CONSTANT,
+			OP_VARIABLE,
+			OP_NEGATE,
+			OP_ADD,
+			OP_SUBTRACT,
+			OP_MULTIPLY,
+			OP_DIVIDE,
+			OP_POW,
+			OP_MIN,
+			OP_MAX,
+			OP_ABS,
+			OP_SQRT,
+			OP_EXP,
+			OP_LOG,
+			OP_LOG10,
+			OP_SIN,
+			OP_COS,
+			OP_TAN,
+			OP_ASIN,
+			OP_ACOS,
+			OP_ATAN,
+			OP_FLOOR,
+			OP_CEIL,
+			OP_SIGN,
+			NUM_OPCODES
+		};
+
+		// binary operations with a constant right operand carry it as immediate value instead of a stack slot
+		struct Instruction
+		{
+			uint16	mOpCode;
+			uint16	mVariable;
+			bool	mImmediate;
+			double	mValue;
+		};
+
+		// constructor & destructor
+		MathExpression();
+		~MathExpression();
+
+		// parse the formula; returns false and sets the error message if it is invalid
+		bool Compile(const char* formula, const Core::Array<Core::String>& variableNames);
+		void Clear();
+
+		bool IsValid() const													{ return mInstructions.IsEmpty() == false; }
+		const char* GetError() const											{ return mError.AsChar(); }
+
+		// true if the variable appears in the compiled formula (after constant folding)
+		bool UsesVariable(uint32 index) const;
+
+		uint32 GetNumInstructions() const										{ return mInstructions.Size(); }
+		const Instruction& GetInstruction(uint32 index) const					{ return mInstructions[index]; }
+
+		// evaluate numSamples results; variables[i] points to the samples of variable i (may be NULL if unused)
+		void Evaluate(const double* const* variables, uint32 numSamples, double* outResults);
+
+		// evaluate a single sample, variableValues holds one value per variable
+		double Evaluate(const double* variableValues);
+
+	private:
+		Core::Array<Instruction>	mInstructions;
+		Core::Array<double>			mStack;
+		Core::Array<const double*>	mOperands;
+		Core::Array<const double*>	mVariables;
+		uint32						mStackDepth;
+		Core::String				mError;
+		Core::String				mTempString;
+
+		// recursive descent parser state
+		const char*							mPos;
+		const char*							mFormula;
+		const Core::Array<Core::String>*	mVariableNames;
+
+		bool ParseExpression();
+		bool ParseTerm();
+		bool ParseUnary();
+		bool ParsePower();
+		bool ParsePrimary();
+		bool ParseFunction(const Core::String& name);
+
+		void SkipWhitespace();
+		bool Accept(char c);
+		bool SetError(const char* message);
+
+		// emit with constant folding
+		void EmitConstant(double value);
+		void EmitUnary(EOpCode opCode);
+		void EmitBinary(EOpCode opCode);
+
+		void EvaluateBlock(const double* const* variables, uint32 offset, uint32 numSamples, double* outResults);
+
+		static double CalculateUnary(EOpCode opCode, double x);
+		static double CalculateBinary(EOpCode opCode, double x, double y);
+};
+
+
+#endif
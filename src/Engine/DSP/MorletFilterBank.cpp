@@ -0,0 +1,149 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "MorletFilterBank.h"
+#include "../Core/Math.h"
+#include "../Core/LogManager.h"
+#include <wavelib/wavelib.h>
+
+
+using namespace Core;
+
+// constructor
+MorletFilterBank::MorletFilterBank()
+{
+	mMaxHalfLength = 0;
+}
+
+
+// destructor
+MorletFilterBank::~MorletFilterBank()
+{
+}
+
+
+// create the filter kernels from the CWT of a unit impulse
+bool MorletFilterBank::Init(double sampleRate, double minFrequency, double maxFrequency, uint32 voicesPerOctave, double omega0)
+{
+	mScales.Clear();
+	mMaxHalfLength = 0;
+
+	if (sampleRate <= 0.0 || minFrequency <= 0.0 || maxFrequency < minFrequency || voicesPerOctave == 0 || omega0 <= 0.0)
+		return false;
+
+	// scales above nyquist are useless
+	maxFrequency = Min<double>(maxFrequency, sampleRate / 2.0);
+	minFrequency = Min<double>(minFrequency, maxFrequency);
+
+	const double dt = 1.0 / sampleRate;
+	const double dj = 1.0 / voicesPerOctave;
+	const uint32 numScales = (uint32)Math::FloorD(Math::Log2D(maxFrequency / minFrequency) * voicesPerOctave + 1e-9) + 1;
+
+	// scale of a frequency (Torrence & Compo 1998)
+	const double fourierFactor = 4.0 * Math::piD / (omega0 + Math::SqrtD(2.0 + omega0 * omega0));
+
+	Array<double> scales;
+	scales.Resize(numScales);
+	mScales.Resize(numScales);
+	for (uint32 j=0; j<numScales; ++j)
+	{
+		const double frequency = maxFrequency * Math::PowD(2.0, -(double)j * dj);
+		scales[j] = 1.0 / (frequency * fourierFactor);
+
+		// cut the gaussian envelope after three e-folding times (sqrt(2) * scale)
+		mScales[j].mFrequency = frequency;
+		mScales[j].mHalfLength = Max<uint32>(1, (uint32)Math::CeilD(3.0 * Math::SqrtD(2.0) * scales[j] * sampleRate));
+		mMaxHalfLength = Max<uint32>(mMaxHalfLength, mScales[j].mHalfLength);
+	}
+
+	// impulse in the center of a zero signal, padded so the FFT convolution does not wrap around
+	const uint32 numSamples = 2 * mMaxHalfLength + 1;
+	Array<double> impulse;
+	impulse.Resize(numSamples);
+	for (uint32 i=0; i<numSamples; ++i)
+		impulse[i] = 0.0;
+	impulse[mMaxHalfLength] = 1.0;
+
+	cwt_object wt = NULL;
+	try
+	{
+		wt = cwt_init("morlet", omega0, numSamples, dt, numScales);
+		setCWTScaleVector(wt, scales.GetPtr(), numScales, scales[0], dj);
+		setCWTPadding(wt, 1);
+		cwt(wt, impulse.GetPtr());
+	}
+	catch (std::exception& e)
+	{
+		LogError("MorletFilterBank::Init(): wavelib error: %s", e.what());
+		if (wt != NULL)
+			cwt_free(wt);
+
+		mScales.Clear();
+		mMaxHalfLength = 0;
+		return false;
+	}
+
+	// the impulse response at offset d is output[center + d], the kernel is stored reversed (oldest sample first)
+	for (uint32 j=0; j<numScales; ++j)
+	{
+		Scale& scale = mScales[j];
+		const cplx_data* response = wt->output + j * numSamples;
+		const uint32 numTaps = 2 * scale.mHalfLength + 1;
+
+		scale.mKernel.Resize(numTaps);
+		for (uint32 i=0; i<numTaps; ++i)
+		{
+			const cplx_data& value = response[mMaxHalfLength + scale.mHalfLength - i];
+			scale.mKernel[i] = Complex(value.re, value.im);
+		}
+	}
+
+	cwt_free(wt);
+	return true;
+}
+
+
+// one output value of the wavelet transform
+double MorletFilterBank::CalcPower(uint32 scaleIndex, const double* samples) const
+{
+	const Scale& scale = mScales[scaleIndex];
+	const uint32 numTaps = scale.mKernel.Size();
+
+	// shorter kernels only see the newest samples
+	const double* x = samples + (mMaxHalfLength - scale.mHalfLength) * 2;
+	const Complex* kernel = scale.mKernel.GetPtr();
+
+	double real = 0.0;
+	double imag = 0.0;
+	for (uint32 i=0; i<numTaps; ++i)
+	{
+		real += kernel[i].mReal * x[i];
+		imag += kernel[i].mImag * x[i];
+	}
+
+	return real * real + imag * imag;
+}
@@ -0,0 +1,69 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_MORLETFILTERBANK_H
+#define __NEUROMORE_MORLETFILTERBANK_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/ComplexMath.h"
+
+
+// continuous Morlet wavelet transform as a bank of complex FIR filters, one per scale
+// The filters are the impulse responses of the wavelib CWT, so a new output value only costs one dot product per scale
+// instead of transforming the whole window again. Scale j is centered GetHalfLength(j) samples before the newest sample.
+class ENGINE_API MorletFilterBank
+{
+	public:
+		// constructor & destructor
+		MorletFilterBank();
+		~MorletFilterBank();
+
+		// logarithmically spaced scales from the upper to the lower frequency
+		bool Init(double sampleRate, double minFrequency, double maxFrequency, uint32 voicesPerOctave, double omega0);
+		bool IsInitialized() const												{ return mScales.IsEmpty() == false; }
+
+		uint32 GetNumScales() const												{ return mScales.Size(); }
+		double GetFrequency(uint32 scale) const									{ return mScales[scale].mFrequency; }
+		uint32 GetHalfLength(uint32 scale) const								{ return mScales[scale].mHalfLength; }
+		uint32 GetMaxHalfLength() const											{ return mMaxHalfLength; }
+
+		// wavelet power (variance units) of a scale; samples points to the newest 2 * GetMaxHalfLength() + 1 samples, oldest first
+		double CalcPower(uint32 scale, const double* samples) const;
+
+	private:
+		struct Scale
+		{
+			double						mFrequency;
+			uint32						mHalfLength;
+			Core::Array<Core::Complex>	mKernel;		// reversed impulse response, 2 * mHalfLength + 1 taps
+		};
+
+		Core::Array<Scale>	mScales;
+		uint32				mMaxHalfLength;
+};
+
+
+#endif
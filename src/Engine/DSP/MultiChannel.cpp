@@ -161,6 +161,14 @@ void MultiChannel::SetBufferSize(uint32 numSamples, bool discard)
 }
 
 
+void MultiChannel::SetSampleFormat(ChannelBase::ESampleFormat format, double resolution)
+{
+	const uint32 numChannels = mChannels.Size();
+	for (uint32 i=0; i<numChannels; ++i)
+		mChannels[i]->SetSampleFormat(format, resolution);
+}
+
+
 uint32 MultiChannel::GetMinBufferSize() const
 {
 	const uint32 numChannels = mChannels.Size();
@@ -75,6 +75,10 @@ class ENGINE_API MultiChannel
 		}
 
 		uint32 GetMinBufferSize() const;
+
+		// set the storage format of all channels
+		void SetSampleFormat(ChannelBase::ESampleFormat format, double resolution = 1.0);
+
 		bool IsBuffer() const;
 		uint32 CalculateMemoryAllocated(bool countBuffersOnly = false);
 		uint32 CalculateMemoryUsed(bool countBuffersOnly = false);
@@ -0,0 +1,385 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required files
+#include "PSDProcessor.h"
+#include "../Core/Math.h"
+#include "Channel.h"
+
+
+using namespace Core;
+
+// constructor
+PSDProcessor::PSDProcessor()
+{
+	mSegmentShift	= 1;
+	mNumTapers		= 0;
+	mTaperScale		= 0.0;
+	mNumBins		= 0;
+	mNumSegments	= 0;
+	mSegmentIndex	= 0;
+
+	Init();
+	mIsInitialized = false;
+}
+
+
+// destructor
+PSDProcessor::~PSDProcessor()
+{
+}
+
+
+// init PSD processor
+void PSDProcessor::Init()
+{
+	// one double channel input
+	AddInput<double>();
+
+	// one spectrum channel output
+	AddOutput<Spectrum>();
+}
+
+
+// reinit processor internals
+void PSDProcessor::ReInit()
+{
+	// ReInit baseclass
+	ChannelProcessor::ReInit();
+
+	mIsInitialized = false;
+
+	ChannelBase* input = GetInput();
+	ChannelBase* output = GetOutput();
+
+	// nothing to do until both channels are connected
+	if (input == NULL || output == NULL)
+		return;
+
+	// clamp parameters
+	mSettings.mFFTOrder = Max<uint32>(mSettings.mFFTOrder, 1);
+	mSettings.mNumSegments = Max<uint32>(mSettings.mNumSegments, 1);
+	mSettings.mOverlap = Clamp<double>(mSettings.mOverlap, 0.0, 0.95);
+	mSettings.mNumFFTSamples = Math::Pow(2, mSettings.mFFTOrder);
+
+	// segments start every shift samples
+	const uint32 numFFTSamples = mSettings.mNumFFTSamples;
+	mSegmentShift = Max<uint32>(1, (uint32)(numFFTSamples * (1.0 - mSettings.mOverlap) + 0.5));
+
+	// configure input reader epoching (one epoch per segment)
+	ChannelReader* inputReader = GetInputReader(0);
+	inputReader->SetEpochLength(numFFTSamples);
+	inputReader->SetEpochZeroPadding(false);
+	inputReader->SetEpochShift(mSegmentShift);
+
+	mFFT.Init(numFFTSamples);
+
+	// precalculate the tapers
+	if (mSettings.mMethod == METHOD_MULTITAPER)
+	{
+		mNumTapers = Clamp<uint32>(mSettings.mNumTapers, 1, numFFTSamples);
+		CalcDPSS(numFFTSamples, mSettings.mTimeBandwidth, mNumTapers, mTapers);
+	}
+	else
+	{
+		mNumTapers = 1;
+		mTapers.Resize(numFFTSamples);
+		for (uint32 i=0; i<numFFTSamples; ++i)
+			mTapers[i] = mSettings.mWindowFunction.Evaluate(i, numFFTSamples);
+	}
+
+	// normalize by the taper energy, so a rectangular window gives the same scale as the FFT processor (squared amplitudes)
+	double taperEnergy = 0.0;
+	for (uint32 i=0; i<numFFTSamples; ++i)
+		taperEnergy += mTapers[i] * mTapers[i];
+
+	mTaperScale = (taperEnergy > 0.0 ? 4.0 / (numFFTSamples * taperEnergy * mNumTapers) : 0.0);
+
+	// clear the segment ring
+	mNumBins = numFFTSamples / 2 + 1;
+	mNumSegments = 0;
+	mSegmentIndex = 0;
+	mSegmentPower.Resize(mSettings.mNumSegments * mNumBins);
+	mPowerSum.Resize(mNumBins);
+	for (uint32 i=0; i<mNumBins; ++i)
+		mPowerSum[i] = 0.0;
+
+	// one output spectrum per segment
+	output->SetSampleRate(input->GetSampleRate() / (double)mSegmentShift);
+
+	mIsInitialized = true;
+}
+
+
+// main update function
+void PSDProcessor::Update()
+{
+	if (mIsInitialized == false)
+		return;
+
+	// update input readers
+	ChannelProcessor::Update();
+
+	ChannelBase* inputChannel = GetInput();
+	ChannelReader* inputReader = GetInputReader();
+
+	Channel<double>* input = inputChannel->AsType<double>();
+	Channel<Spectrum>* output = GetOutput()->AsType<Spectrum>();
+
+	const uint32 maxNumSegments = mSettings.mNumSegments;
+
+	// only the new segments are transformed, the older ones are reused from the ring
+	const uint32 numNewEpochs = inputReader->GetNumEpochs();
+	for (uint32 e=0; e<numNewEpochs; ++e)
+	{
+		Epoch inputEpoch = inputReader->PopOldestEpoch();
+
+		// replace the oldest segment in the ring
+		double* segmentPower = mSegmentPower.GetPtr() + mSegmentIndex * mNumBins;
+		if (mNumSegments == maxNumSegments)
+		{
+			for (uint32 b=0; b<mNumBins; ++b)
+				mPowerSum[b] -= segmentPower[b];
+		}
+		else
+		{
+			mNumSegments++;
+		}
+
+		CalcSegmentPower(inputEpoch, segmentPower);
+
+		for (uint32 b=0; b<mNumBins; ++b)
+			mPowerSum[b] += segmentPower[b];
+
+		mSegmentIndex++;
+		if (mSegmentIndex == maxNumSegments)
+		{
+			mSegmentIndex = 0;
+
+			// resum once per ring cycle so the rounding errors of the running sum do not accumulate
+			for (uint32 b=0; b<mNumBins; ++b)
+			{
+				double sum = 0.0;
+				for (uint32 s=0; s<mNumSegments; ++s)
+					sum += mSegmentPower[s * mNumBins + b];
+				mPowerSum[b] = sum;
+			}
+		}
+
+		// output the averaged spectrum (as amplitudes, like the FFT processor)
+		Spectrum* spectrum = output->GetNextSampleRef();
+		spectrum->SetMaxFrequency(inputChannel->GetSampleRate() / 2.0);
+		spectrum->SetNumBins(mNumBins);
+
+		const double scale = 1.0 / mNumSegments;
+		for (uint32 b=0; b<mNumBins; ++b)
+			spectrum->SetBin(b, Complex(Math::SqrtD(Max<double>(0.0, mPowerSum[b] * scale)), 0.0));
+
+		spectrum->SetTime(input->GetSampleTime(inputEpoch.GetPosition()).InSeconds());
+	}
+}
+
+
+// power spectrum of a single segment, averaged over all tapers
+void PSDProcessor::CalcSegmentPower(const Epoch& epoch, double* outPower)
+{
+	const uint32 numFFTSamples = mSettings.mNumFFTSamples;
+
+	for (uint32 b=0; b<mNumBins; ++b)
+		outPower[b] = 0.0;
+
+	double* inputBuffer = mFFT.GetInput();
+	for (uint32 t=0; t<mNumTapers; ++t)
+	{
+		const double* taper = mTapers.GetPtr() + t * numFFTSamples;
+		for (uint32 s=0; s<numFFTSamples; ++s)
+			inputBuffer[s] = epoch.GetSample(s) * taper[s];
+
+		mFFT.CalcFFT();
+
+		const Complex* complexSpectrum = mFFT.GetOutput();
+		for (uint32 b=0; b<mNumBins; ++b)
+			outPower[b] += complexSpectrum[b].SquaredNorm();
+	}
+
+	// one-sided spectrum: DC and nyquist bin are not doubled
+	for (uint32 b=0; b<mNumBins; ++b)
+		outPower[b] *= mTaperScale;
+
+	outPower[0] *= 0.25;
+	outPower[mNumBins - 1] *= 0.25;
+}
+
+
+// latency: center of the averaged segments
+double PSDProcessor::GetLatency(uint32 inputPortIndex, uint32 outputPortIndex) const
+{
+	ChannelBase* input = GetInput();
+	if (input == NULL || input->GetSampleRate() <= 0.0)
+		return 0.0;
+
+	const double numSamples = mSettings.mNumFFTSamples + (mSettings.mNumSegments - 1) * (double)mSegmentShift;
+	return (numSamples / 2.0) / input->GetSampleRate();
+}
+
+
+const char* PSDProcessor::GetMethodName(uint32 method)
+{
+	switch (method)
+	{
+		case METHOD_WELCH:			return "Welch";
+		case METHOD_MULTITAPER:		return "Multitaper (DPSS)";
+		default:					return "";
+	}
+}
+
+
+// DPSS are the eigenvectors of a symmetric tridiagonal matrix (Percival & Walden 1993), the tapers belong to the largest eigenvalues.
+// The eigenvalues are found by bisection with Sturm sequence counts and the eigenvectors by inverse iteration, both O(N) per taper.
+void PSDProcessor::CalcDPSS(uint32 numSamples, double timeBandwidth, uint32 numTapers, Array<double>& outTapers)
+{
+	outTapers.Resize(numSamples * numTapers);
+	if (numSamples == 0 || numTapers == 0)
+		return;
+
+	// tridiagonal matrix: diagonal d[i] = ((N-1-2i)/2)^2 cos(2 pi W), off-diagonal e[i] = (i+1)(N-i-1)/2
+	const double bandwidth = timeBandwidth / numSamples;
+	const double cosine = Math::CosD(2.0 * Math::piD * bandwidth);
+
+	Array<double> diagonal, offDiagonal;
+	diagonal.Resize(numSamples);
+	offDiagonal.Resize(numSamples);
+	for (uint32 i=0; i<numSamples; ++i)
+	{
+		const double x = (numSamples - 1 - 2.0 * i) / 2.0;
+		diagonal[i] = x * x * cosine;
+		offDiagonal[i] = (i + 1 < numSamples ? (i + 1) * (double)(numSamples - i - 1) / 2.0 : 0.0);
+	}
+
+	// gershgorin bounds of the spectrum
+	double lower = DBL_MAX;
+	double upper = -DBL_MAX;
+	for (uint32 i=0; i<numSamples; ++i)
+	{
+		const double radius = Math::AbsD(offDiagonal[i]) + (i > 0 ? Math::AbsD(offDiagonal[i-1]) : 0.0);
+		lower = Min<double>(lower, diagonal[i] - radius);
+		upper = Max<double>(upper, diagonal[i] + radius);
+	}
+
+	const double tolerance = (upper - lower) * 1e-14 + DBL_MIN;
+
+	Array<double> vector, pivots, upperDiagonal;
+	vector.Resize(numSamples);
+	pivots.Resize(numSamples);
+	upperDiagonal.Resize(numSamples);
+
+	for (uint32 t=0; t<numTapers; ++t)
+	{
+		// 1) bisection for the t-th largest eigenvalue (index in ascending order)
+		const uint32 index = numSamples - 1 - t;
+		double a = lower;
+		double b = upper;
+		while (b - a > tolerance)
+		{
+			const double mid = 0.5 * (a + b);
+
+			// Sturm count: number of eigenvalues smaller than mid
+			uint32 count = 0;
+			double q = diagonal[0] - mid;
+			for (uint32 i=0; ; )
+			{
+				if (q < 0.0)
+					count++;
+
+				if (++i == numSamples)
+					break;
+
+				if (q == 0.0)
+					q = tolerance;
+
+				q = diagonal[i] - mid - offDiagonal[i-1] * offDiagonal[i-1] / q;
+			}
+
+			if (count > index)
+				b = mid;
+			else
+				a = mid;
+
+			if (mid == a && mid == b)
+				break;
+		}
+
+		const double eigenValue = 0.5 * (a + b) + tolerance;
+
+		// 2) inverse iteration (T - lambda I) x = v, with an asymmetric start vector so odd tapers are not missed
+		for (uint32 i=0; i<numSamples; ++i)
+			vector[i] = 1.0 + (double)i / numSamples;
+
+		// LU factorization of the shifted tridiagonal matrix
+		pivots[0] = diagonal[0] - eigenValue;
+		for (uint32 i=1; i<numSamples; ++i)
+		{
+			if (pivots[i-1] == 0.0)
+				pivots[i-1] = tolerance;
+
+			upperDiagonal[i-1] = offDiagonal[i-1] / pivots[i-1];
+			pivots[i] = diagonal[i] - eigenValue - offDiagonal[i-1] * upperDiagonal[i-1];
+		}
+
+		if (pivots[numSamples-1] == 0.0)
+			pivots[numSamples-1] = tolerance;
+
+		for (uint32 iteration=0; iteration<3; ++iteration)
+		{
+			// forward and back substitution
+			for (uint32 i=1; i<numSamples; ++i)
+				vector[i] -= upperDiagonal[i-1] * vector[i-1];
+
+			vector[numSamples-1] /= pivots[numSamples-1];
+			for (int32 i=(int32)numSamples-2; i>=0; --i)
+				vector[i] = (vector[i] - offDiagonal[i] * vector[i+1]) / pivots[i];
+
+			// normalize to unit energy
+			double energy = 0.0;
+			for (uint32 i=0; i<numSamples; ++i)
+				energy += vector[i] * vector[i];
+
+			const double scale = 1.0 / Math::SqrtD(energy);
+			for (uint32 i=0; i<numSamples; ++i)
+				vector[i] *= scale;
+		}
+
+		// sign convention: symmetric tapers have a positive sum, antisymmetric tapers start positive
+		double sum = 0.0;
+		for (uint32 i=0; i<numSamples; ++i)
+			sum += (t % 2 == 0 ? vector[i] : vector[i] * (numSamples - 1 - 2.0 * i));
+
+		const double sign = (sum < 0.0 ? -1.0 : 1.0);
+		double* taper = outTapers.GetPtr() + t * numSamples;
+		for (uint32 i=0; i<numSamples; ++i)
+			taper[i] = vector[i] * sign;
+	}
+}
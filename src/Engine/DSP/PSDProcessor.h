@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_PSDPROCESSOR_H
+#define __NEUROMORE_PSDPROCESSOR_H
+
+// include required headers
+#include "../Config.h"
+#include "ChannelProcessor.h"
+#include "WindowFunction.h"
+#include "FFT.h"
+#include "Channel.h"
+
+
+// power spectral density estimation (Welch's method or DPSS multitaper)
+// Each new segment is transformed once and kept in a ring of segment spectra, the output is the running average over the last segments.
+class ENGINE_API PSDProcessor : public ChannelProcessor
+{
+	public:
+		enum { TYPE_ID = 0x005C };
+
+		enum EMethod
+		{
+			METHOD_WELCH		= 0,
+			METHOD_MULTITAPER	= 1,
+			NUM_METHODS
+		};
+
+		class PSDSettings : public ChannelProcessor::Settings
+		{
+			public:
+				enum { TYPE_ID = 0x005C };
+
+				PSDSettings()									{ mMethod = METHOD_WELCH; mFFTOrder = 8; mNumFFTSamples = 256; mOverlap = 0.5; mNumSegments = 8; mTimeBandwidth = 3.0; mNumTapers = 5; }
+				virtual ~PSDSettings()							{}
+
+				uint32 GetType() const override					{ return PSDProcessor::TYPE_ID; }
+
+				EMethod			mMethod;
+				uint32			mFFTOrder;
+				uint32			mNumFFTSamples;
+				double			mOverlap;				// segment overlap (0 .. <1)
+				uint32			mNumSegments;			// number of segments that are averaged
+				WindowFunction	mWindowFunction;		// Welch only
+				double			mTimeBandwidth;			// multitaper only: time-half-bandwidth product NW
+				uint32			mNumTapers;				// multitaper only: number of DPSS tapers (usually 2NW-1)
+		};
+
+		// constructors & destructor
+		PSDProcessor();
+		virtual ~PSDProcessor();
+
+		uint32 GetType() const override											{ return TYPE_ID; }
+		ChannelProcessor* Clone() override										{ PSDProcessor* clone = new PSDProcessor(); return clone; }
+
+		void Init() override;
+		void ReInit() override;
+		void Update() override;
+
+		// settings
+		void Setup(const ChannelProcessor::Settings& settings) override			{ mSettings = static_cast<const PSDSettings&>(settings); }
+		const Settings& GetSettings() const	override							{ return mSettings; }
+
+		uint32 GetSegmentShift() const											{ return mSegmentShift; }
+
+		static const char* GetMethodName(uint32 method);
+
+		// discrete prolate spheroidal sequences (Slepian tapers) with unit energy, one after another in the output array
+		static void CalcDPSS(uint32 numSamples, double timeBandwidth, uint32 numTapers, Core::Array<double>& outTapers);
+
+		// DSP related properties
+		uint32 GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const override							{ return mSettings.mNumFFTSamples; }
+		double GetLatency(uint32 inputPortIndex, uint32 outputPortIndex) const override;
+		double GetSampleRatio(uint32 inputPortIndex, uint32 outputPortIndex) const override		{ return mSegmentShift - 1; }
+		uint32 GetNumEpochSamples(uint32 inputPortIndex) const override							{ return mSettings.mNumFFTSamples + mSegmentShift; }
+
+	private:
+		// power spectrum of one segment
+		void CalcSegmentPower(const Epoch& epoch, double* outPower);
+
+		PSDSettings				mSettings;
+		uint32					mSegmentShift;
+
+		FFT						mFFT;
+
+		// tapers (one window for Welch, numTapers DPSS for multitaper) and their power normalization
+		Core::Array<double>		mTapers;
+		uint32					mNumTapers;
+		double					mTaperScale;
+
+		// ring of segment power spectra and their sum
+		Core::Array<double>		mSegmentPower;
+		Core::Array<double>		mPowerSum;
+		uint32					mNumBins;
+		uint32					mNumSegments;
+		uint32					mSegmentIndex;
+};
+
+
+#endif
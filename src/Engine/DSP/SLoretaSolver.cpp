@@ -0,0 +1,272 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "SLoretaSolver.h"
+#include "../Core/Math.h"
+#include "../Core/LogManager.h"
+
+
+using namespace Core;
+
+// head model: the brain is a sphere inside the unit sphere the electrodes sit on
+static const double BRAIN_RADIUS		= 0.8;
+static const double MIN_VOXEL_HEIGHT	= -0.1;		// skip voxels far below the electrode cap, they are not observable
+static const double DEEP_VOXEL_RADIUS	= 0.3;		// voxels closer to the center don't belong to any cortical region
+static const double CONDUCTIVITY		= 0.33;		// S/m, cancels out after standardization
+
+
+// constructor
+SLoretaSolver::SLoretaSolver()
+{
+	Clear();
+}
+
+
+// destructor
+SLoretaSolver::~SLoretaSolver()
+{
+}
+
+
+// release the precomputed operators
+void SLoretaSolver::Clear()
+{
+	mNumElectrodes	= 0;
+	mNumVoxels		= 0;
+	mVoxelPositions.Clear();
+	mVoxelRegions.Clear();
+	for (uint32 i=0; i<NUM_REGIONS; ++i)
+		mNumRegionVoxels[i] = 0;
+
+	mOperator.resize(0, 0);
+	mRegionOperator.resize(0, 0);
+	mTempProduct.resize(0, 0);
+}
+
+
+// build the inverse operator
+bool SLoretaSolver::Init(const Array<Vector3>& electrodePositions, uint32 gridResolution, double regularization)
+{
+	Clear();
+
+	// the average reference removes one degree of freedom
+	const uint32 numElectrodes = electrodePositions.Size();
+	if (numElectrodes < 3)
+		return false;
+
+	CreateVoxels(gridResolution);
+	const uint32 numVoxels = mVoxelPositions.Size();
+	if (numVoxels == 0)
+		return false;
+
+	// 1) lead field K (E x 3V) of an unbounded homogeneous volume conductor
+	const double scale = 1.0 / (4.0 * Math::piD * CONDUCTIVITY);
+	Eigen::MatrixXd leadField(numElectrodes, 3 * numVoxels);
+	for (uint32 v=0; v<numVoxels; ++v)
+	{
+		const Vector3& voxel = mVoxelPositions[v];
+		for (uint32 e=0; e<numElectrodes; ++e)
+		{
+			const Vector3 delta = electrodePositions[e] - voxel;
+			const double distance = delta.Length();
+			const double factor = scale / (distance * distance * distance);
+
+			leadField(e, 3*v+0) = delta.x * factor;
+			leadField(e, 3*v+1) = delta.y * factor;
+			leadField(e, 3*v+2) = delta.z * factor;
+		}
+	}
+
+	// average reference: K = H*K with the centering matrix H = I - 1/E
+	leadField.rowwise() -= leadField.colwise().mean();
+
+	// 2) regularized pseudo inverse of K*K^T + alpha*H (the common mode is in the null space of both terms)
+	Eigen::MatrixXd gram = leadField * leadField.transpose();
+	const double alpha = regularization * gram.trace() / (numElectrodes - 1);
+	gram.diagonal().array() += alpha;
+	gram.array() -= alpha / numElectrodes;
+
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigenSolver(gram);
+	if (eigenSolver.info() != Eigen::Success)
+	{
+		LogError("SLoretaSolver::Init(): Eigen decomposition failed.");
+		return false;
+	}
+
+	const Eigen::VectorXd& eigenValues = eigenSolver.eigenvalues();
+	const double tolerance = eigenValues.maxCoeff() * 1e-10;
+	Eigen::VectorXd invEigenValues(numElectrodes);
+	for (uint32 i=0; i<numElectrodes; ++i)
+		invEigenValues[i] = (eigenValues[i] > tolerance) ? 1.0 / eigenValues[i] : 0.0;
+
+	const Eigen::MatrixXd& eigenVectors = eigenSolver.eigenvectors();
+	const Eigen::MatrixXd inverseGram = eigenVectors * invEigenValues.asDiagonal() * eigenVectors.transpose();
+
+	// 3) minimum norm operator T = K^T * (K*K^T + alpha*H)^+ (3V x E)
+	mOperator.noalias() = leadField.transpose() * inverseGram;
+
+	// 4) standardize every voxel with the inverse square root of its 3x3 resolution matrix block S_v = T_v * K_v
+	for (uint32 v=0; v<numVoxels; ++v)
+	{
+		const Eigen::Matrix3d resolution = mOperator.middleRows<3>(3*v) * leadField.middleCols<3>(3*v);
+
+		Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> voxelSolver(0.5 * (resolution + resolution.transpose()));
+		const Eigen::Vector3d values = voxelSolver.eigenvalues().cwiseMax(tolerance);
+		const Eigen::Matrix3d invSqrt = voxelSolver.eigenvectors() * values.cwiseSqrt().cwiseInverse().asDiagonal() * voxelSolver.eigenvectors().transpose();
+
+		mOperator.middleRows<3>(3*v) = (invSqrt * mOperator.middleRows<3>(3*v)).eval();
+	}
+
+	// 5) region operators: the mean power of a region is trace(C * mean(W_v^T W_v)), so precompute the E x E matrix per region
+	mRegionOperator.setZero(NUM_REGIONS, numElectrodes * numElectrodes);
+	for (uint32 r=0; r<NUM_REGIONS; ++r)
+	{
+		if (mNumRegionVoxels[r] == 0)
+			continue;
+
+		Eigen::MatrixXd regionGram = Eigen::MatrixXd::Zero(numElectrodes, numElectrodes);
+		for (uint32 v=0; v<numVoxels; ++v)
+		{
+			if (mVoxelRegions[v] == r)
+				regionGram.noalias() += mOperator.middleRows<3>(3*v).transpose() * mOperator.middleRows<3>(3*v);
+		}
+
+		regionGram /= (double)mNumRegionVoxels[r];
+		mRegionOperator.row(r) = Eigen::Map<const Eigen::RowVectorXd>(regionGram.data(), numElectrodes * numElectrodes);
+	}
+
+	mNumElectrodes	= numElectrodes;
+	mNumVoxels		= numVoxels;
+	return true;
+}
+
+
+// standardized source power per region
+void SLoretaSolver::CalcRegionPower(const Eigen::MatrixXd& covariance, double* outPower) const
+{
+	CORE_ASSERT(covariance.rows() == mNumElectrodes && covariance.cols() == mNumElectrodes);
+
+	// one matrix vector product: both matrices are symmetric, so trace(G*C) is the dot product of the flattened matrices
+	Eigen::Map<Eigen::VectorXd> result(outPower, NUM_REGIONS);
+	result.noalias() = mRegionOperator * Eigen::Map<const Eigen::VectorXd>(covariance.data(), mNumElectrodes * mNumElectrodes);
+}
+
+
+// standardized source power per voxel
+void SLoretaSolver::CalcVoxelPower(const Eigen::MatrixXd& covariance, Eigen::VectorXd& outPower) const
+{
+	CORE_ASSERT(covariance.rows() == mNumElectrodes && covariance.cols() == mNumElectrodes);
+
+	// diag(W * C * W^T), summed over the three dipole directions of each voxel
+	mTempProduct.noalias() = mOperator * covariance;
+	const Eigen::VectorXd rowPower = mTempProduct.cwiseProduct(mOperator).rowwise().sum();
+
+	outPower.resize(mNumVoxels);
+	for (uint32 v=0; v<mNumVoxels; ++v)
+		outPower[v] = rowPower[3*v] + rowPower[3*v+1] + rowPower[3*v+2];
+}
+
+
+// memory used by the operators
+uint32 SLoretaSolver::CalcMemoryUsed() const
+{
+	return (uint32)((mOperator.size() + mRegionOperator.size() + mTempProduct.size()) * sizeof(double) + mVoxelPositions.Size() * (sizeof(Vector3) + sizeof(uint32)));
+}
+
+
+// create a regular grid of voxels inside the brain sphere
+void SLoretaSolver::CreateVoxels(uint32 gridResolution)
+{
+	mVoxelPositions.Clear();
+	mVoxelRegions.Clear();
+
+	if (gridResolution == 0)
+		return;
+
+	const double spacing = 2.0 * BRAIN_RADIUS / gridResolution;
+	for (uint32 z=0; z<gridResolution; ++z)
+	{
+		for (uint32 y=0; y<gridResolution; ++y)
+		{
+			for (uint32 x=0; x<gridResolution; ++x)
+			{
+				const Vector3 position( -BRAIN_RADIUS + (x + 0.5) * spacing, -BRAIN_RADIUS + (y + 0.5) * spacing, -BRAIN_RADIUS + (z + 0.5) * spacing );
+				if (position.Length() > BRAIN_RADIUS || position.z < MIN_VOXEL_HEIGHT)
+					continue;
+
+				const uint32 region = ClassifyRegion(position);
+				mVoxelPositions.Add(position);
+				mVoxelRegions.Add(region);
+				if (region != CORE_INVALIDINDEX32)
+					mNumRegionVoxels[region]++;
+			}
+		}
+	}
+}
+
+
+// coarse lobe assignment based on the direction from the head center
+uint32 SLoretaSolver::ClassifyRegion(const Vector3& position)
+{
+	const double length = position.Length();
+	if (length < DEEP_VOXEL_RADIUS * BRAIN_RADIUS)
+		return CORE_INVALIDINDEX32;
+
+	const Vector3 direction = position.Normalized();
+	const uint32 side = (direction.x < 0.0) ? 0 : 1;
+
+	if (direction.y > 0.35)
+		return REGION_FRONTAL_LEFT + side;
+	if (direction.y < -0.65)
+		return REGION_OCCIPITAL_LEFT + side;
+	if (direction.z < 0.3 && Math::AbsD(direction.x) > 0.5)
+		return REGION_TEMPORAL_LEFT + side;
+	if (direction.y < -0.15)
+		return REGION_PARIETAL_LEFT + side;
+
+	return REGION_CENTRAL_LEFT + side;
+}
+
+
+// region names (used for the output channels)
+const char* SLoretaSolver::GetRegionName(uint32 region)
+{
+	switch (region)
+	{
+		case REGION_FRONTAL_LEFT:		return "Frontal L";
+		case REGION_FRONTAL_RIGHT:		return "Frontal R";
+		case REGION_CENTRAL_LEFT:		return "Central L";
+		case REGION_CENTRAL_RIGHT:		return "Central R";
+		case REGION_TEMPORAL_LEFT:		return "Temporal L";
+		case REGION_TEMPORAL_RIGHT:		return "Temporal R";
+		case REGION_PARIETAL_LEFT:		return "Parietal L";
+		case REGION_PARIETAL_RIGHT:		return "Parietal R";
+		case REGION_OCCIPITAL_LEFT:		return "Occipital L";
+		case REGION_OCCIPITAL_RIGHT:	return "Occipital R";
+		default:						return "";
+	}
+}
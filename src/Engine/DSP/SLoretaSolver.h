@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SLORETASOLVER_H
+#define __NEUROMORE_SLORETASOLVER_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/Vector.h"
+#include <Eigen/Dense>
+
+
+// sLORETA source localization on a spherical head model (standardized low resolution electromagnetic tomography, Pascual-Marqui 2002)
+// The standardized inverse operator is precomputed once per electrode montage; afterwards every epoch is a single matrix product with
+// the electrode covariance (or band limited cross-spectrum) matrix.
+class ENGINE_API SLoretaSolver
+{
+	public:
+		// the regions of interest the voxels are grouped into
+		enum ERegion
+		{
+			REGION_FRONTAL_LEFT = 0,
+			REGION_FRONTAL_RIGHT,
+			REGION_CENTRAL_LEFT,
+			REGION_CENTRAL_RIGHT,
+			REGION_TEMPORAL_LEFT,
+			REGION_TEMPORAL_RIGHT,
+			REGION_PARIETAL_LEFT,
+			REGION_PARIETAL_RIGHT,
+			REGION_OCCIPITAL_LEFT,
+			REGION_OCCIPITAL_RIGHT,
+			NUM_REGIONS
+		};
+
+		// constructor & destructor
+		SLoretaSolver();
+		~SLoretaSolver();
+
+		// build the voxel grid, the lead field and the standardized inverse operator
+		// electrode positions are on the unit sphere in head coordinates (x = right, y = front, z = up)
+		bool Init(const Core::Array<Core::Vector3>& electrodePositions, uint32 gridResolution, double regularization);
+		void Clear();
+		bool IsInitialized() const												{ return mNumVoxels > 0; }
+
+		uint32 GetNumElectrodes() const											{ return mNumElectrodes; }
+		uint32 GetNumVoxels() const												{ return mNumVoxels; }
+		const Core::Vector3& GetVoxelPosition(uint32 index) const				{ return mVoxelPositions[index]; }
+		uint32 GetVoxelRegion(uint32 index) const								{ return mVoxelRegions[index]; }
+		uint32 GetNumRegionVoxels(uint32 region) const							{ return mNumRegionVoxels[region]; }
+
+		static const char* GetRegionName(uint32 region);
+
+		// standardized source power per region for the given electrode covariance matrix (E x E), outPower must hold NUM_REGIONS values
+		void CalcRegionPower(const Eigen::MatrixXd& covariance, double* outPower) const;
+
+		// standardized source power per voxel for the given electrode covariance matrix (E x E)
+		void CalcVoxelPower(const Eigen::MatrixXd& covariance, Eigen::VectorXd& outPower) const;
+
+		// memory used by the precomputed operators in bytes
+		uint32 CalcMemoryUsed() const;
+
+	private:
+		void CreateVoxels(uint32 gridResolution);
+		static uint32 ClassifyRegion(const Core::Vector3& position);
+
+		uint32							mNumElectrodes;
+		uint32							mNumVoxels;
+		Core::Array<Core::Vector3>		mVoxelPositions;
+		Core::Array<uint32>				mVoxelRegions;					// region per voxel (CORE_INVALIDINDEX32 for deep voxels)
+		uint32							mNumRegionVoxels[NUM_REGIONS];
+
+		Eigen::MatrixXd					mOperator;						// standardized inverse operator (3V x E), three rows per voxel
+		Eigen::MatrixXd					mRegionOperator;				// per region mean of W_v^T W_v, flattened (NUM_REGIONS x E*E)
+
+		// temporary buffers
+		mutable Eigen::MatrixXd			mTempProduct;
+};
+
+
+#endif
@@ -0,0 +1,344 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required files
+#include "SpectrumAnalyzerCache.h"
+#include "../EngineManager.h"
+#include "../Graph/Node.h"
+
+
+using namespace Core;
+
+// default number of spectra kept if the consumer does not care
+#define SPECTRUMANALYZERCACHE_DEFAULT_HISTORY 32
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Entry
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// constructor
+SpectrumAnalyzerCache::Entry::Entry(Channel<double>* input, const FFTProcessor::FFTSettings& settings)
+{
+	mInput			= input;
+	mSettings		= settings;
+	mAnalyzer		= NULL;
+	mProvider		= NULL;
+	mProviderNode	= NULL;
+	mHistorySize	= 0;
+	mOutputRevision	= 0;
+	mIsUpdated		= false;
+}
+
+
+// destructor
+SpectrumAnalyzerCache::Entry::~Entry()
+{
+	delete mAnalyzer;
+}
+
+
+// the output of the provider or of the own analyzer
+Channel<Spectrum>* SpectrumAnalyzerCache::Entry::GetOutput() const
+{
+	if (mAnalyzer != NULL)
+		return mAnalyzer->GetOutput()->AsType<Spectrum>();
+
+	if (mProvider != NULL)
+		return mProvider->GetOutput()->AsType<Spectrum>();
+
+	return NULL;
+}
+
+
+// check if the entry was created for the given key
+bool SpectrumAnalyzerCache::Entry::IsMatching(Channel<double>* input, const FFTProcessor::FFTSettings& settings) const
+{
+	return (mInput == input &&
+			mSettings.mFFTOrder == settings.mFFTOrder &&
+			mSettings.mEpochShift == settings.mEpochShift &&
+			mSettings.mUseZeroPadding == settings.mUseZeroPadding &&
+			mSettings.mWindowFunction.GetType() == settings.mWindowFunction.GetType());
+}
+
+
+// a provider can only be used if its node is updated and its buffer holds the requested history
+bool SpectrumAnalyzerCache::Entry::IsProviderUsable() const
+{
+	if (mProvider == NULL || mProvider->IsInitialized() == false)
+		return false;
+
+	// the node is suspended by demand tracking (nothing else consumes its output), its output does not advance anymore
+	if (mProviderNode != NULL && mProviderNode->IsSuspended() == true)
+		return false;
+
+	const uint32 bufferSize = mProvider->GetOutput()->GetBufferSize();
+	return (bufferSize == 0 || bufferSize >= mHistorySize);
+}
+
+
+// create the own analyzer
+void SpectrumAnalyzerCache::Entry::CreateAnalyzer()
+{
+	delete mAnalyzer;
+
+	mAnalyzer = new FFTProcessor();
+	mAnalyzer->SetInput(mInput);
+	mAnalyzer->GetOutput()->SetBufferSize(mHistorySize);
+	mAnalyzer->Setup(mSettings);
+	mAnalyzer->ReInit();
+
+	mOutputRevision++;
+}
+
+
+// keep the largest history requested by the remaining references
+void SpectrumAnalyzerCache::Entry::UpdateHistorySize()
+{
+	uint32 historySize = 0;
+	const uint32 numRequests = mHistoryRequests.Size();
+	for (uint32 i=0; i<numRequests; ++i)
+		historySize = Max<uint32>(historySize, mHistoryRequests[i]);
+
+	mHistorySize = historySize;
+
+	// never shrink the own analyzer, the remaining consumers would lose their spectra (the larger buffer goes away with the entry)
+	if (mAnalyzer == NULL || historySize <= mAnalyzer->GetOutput()->GetBufferSize())
+		return;
+
+	// growing clears the circular buffer
+	mAnalyzer->GetOutput()->SetBufferSize(historySize);
+	mOutputRevision++;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SpectrumAnalyzerCache
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// constructor
+SpectrumAnalyzerCache::SpectrumAnalyzerCache()
+{
+}
+
+
+// destructor
+SpectrumAnalyzerCache::~SpectrumAnalyzerCache()
+{
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+		delete mEntries[i];
+	mEntries.Clear();
+}
+
+
+// get or create the shared analyzer for the given key
+SpectrumAnalyzerCache::Entry* SpectrumAnalyzerCache::Acquire(Channel<double>* input, const FFTProcessor::FFTSettings& settings, uint32 historySize)
+{
+	if (input == NULL)
+		return NULL;
+
+	if (historySize == 0)
+		historySize = SPECTRUMANALYZERCACHE_DEFAULT_HISTORY;
+
+	// find existing entry
+	Entry* entry = NULL;
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		if (mEntries[i]->IsMatching(input, settings) == true)
+		{
+			entry = mEntries[i];
+			break;
+		}
+	}
+
+	// create new one
+	if (entry == NULL)
+	{
+		entry = new Entry(input, settings);
+		SetProvider( entry, FindProvider(input, settings) );
+		mEntries.Add(entry);
+	}
+
+	entry->mHistoryRequests.Add(historySize);
+	entry->UpdateHistorySize();
+
+	// make sure there always is an output
+	if (entry->mAnalyzer == NULL && entry->IsProviderUsable() == false)
+		entry->CreateAnalyzer();
+
+	return entry;
+}
+
+
+// drop a reference, the history shrinks to the largest one still requested and the analyzer is destroyed together with the last reference
+void SpectrumAnalyzerCache::Release(Entry* entry, uint32 historySize)
+{
+	if (entry == NULL)
+		return;
+
+	if (historySize == 0)
+		historySize = SPECTRUMANALYZERCACHE_DEFAULT_HISTORY;
+
+	CORE_ASSERT(entry->mHistoryRequests.IsEmpty() == false);
+	if (entry->mHistoryRequests.RemoveByValue(historySize) == false)
+	{
+		// released with a different size than acquired
+		CORE_ASSERT(false);
+		entry->mHistoryRequests.RemoveLast();
+	}
+
+	if (entry->mHistoryRequests.IsEmpty() == false)
+	{
+		entry->UpdateHistorySize();
+		return;
+	}
+
+	mEntries.RemoveByValue(entry);
+	delete entry;
+}
+
+
+// calculate new spectra once per engine update
+void SpectrumAnalyzerCache::Update(Entry* entry)
+{
+	if (entry == NULL)
+		return;
+
+	const Time elapsedTime = GetEngine()->GetElapsedTime();
+	if (entry->mIsUpdated == true && entry->mLastUpdateTime == elapsedTime)
+		return;
+
+	entry->mIsUpdated = true;
+	entry->mLastUpdateTime = elapsedTime;
+
+	// the node updates the provider itself (switch back to the provider once its node is updated again)
+	if (entry->IsProviderUsable() == true)
+	{
+		if (entry->mAnalyzer != NULL)
+		{
+			delete entry->mAnalyzer;
+			entry->mAnalyzer = NULL;
+			entry->mOutputRevision++;
+		}
+
+		return;
+	}
+
+	if (entry->mAnalyzer == NULL)
+		entry->CreateAnalyzer();
+
+	entry->mAnalyzer->Update();
+}
+
+
+// an FFT node processor got (re)initialized
+void SpectrumAnalyzerCache::RegisterProvider(FFTProcessor* processor, const Node* node)
+{
+	if (processor == NULL || mProviders.Contains(processor) == true)
+		return;
+
+	mProviders.Add(processor);
+	mProviderNodes.Add(node);
+
+	Channel<double>* input = static_cast<Channel<double>*>(processor->GetInput());
+	const FFTProcessor::FFTSettings& settings = static_cast<const FFTProcessor::FFTSettings&>(processor->GetSettings());
+
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		Entry* entry = mEntries[i];
+		if (entry->mProvider == NULL && entry->IsMatching(input, settings) == true)
+			SetProvider( entry, mProviders.Size() - 1 );
+	}
+}
+
+
+// an FFT node processor is about to be destroyed
+void SpectrumAnalyzerCache::UnregisterProvider(FFTProcessor* processor)
+{
+	const uint32 providerIndex = mProviders.Find(processor);
+	if (providerIndex == CORE_INVALIDINDEX32)
+		return;
+
+	mProviders.Remove(providerIndex);
+	mProviderNodes.Remove(providerIndex);
+
+	// switch the entries to another provider or back to their own analyzer
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		Entry* entry = mEntries[i];
+		if (entry->mProvider != processor)
+			continue;
+
+		SetProvider( entry, FindProvider(entry->mInput, entry->mSettings) );
+		if (entry->mAnalyzer == NULL)
+		{
+			// the output was the one of the removed processor
+			entry->mOutputRevision++;
+			if (entry->IsProviderUsable() == false)
+				entry->CreateAnalyzer();
+		}
+	}
+}
+
+
+// find the index of a registered FFT node processor with matching input and settings
+uint32 SpectrumAnalyzerCache::FindProvider(Channel<double>* input, const FFTProcessor::FFTSettings& settings) const
+{
+	const uint32 numProviders = mProviders.Size();
+	for (uint32 i=0; i<numProviders; ++i)
+	{
+		FFTProcessor* provider = mProviders[i];
+		const FFTProcessor::FFTSettings& providerSettings = static_cast<const FFTProcessor::FFTSettings&>(provider->GetSettings());
+
+		if (provider->GetInput() == input &&
+			providerSettings.mFFTOrder == settings.mFFTOrder &&
+			providerSettings.mEpochShift == settings.mEpochShift &&
+			providerSettings.mUseZeroPadding == settings.mUseZeroPadding &&
+			providerSettings.mWindowFunction.GetType() == settings.mWindowFunction.GetType())
+			return i;
+	}
+
+	return CORE_INVALIDINDEX32;
+}
+
+
+// use the given provider (or none if the index is invalid)
+void SpectrumAnalyzerCache::SetProvider(Entry* entry, uint32 providerIndex) const
+{
+	if (providerIndex == CORE_INVALIDINDEX32)
+	{
+		entry->mProvider		= NULL;
+		entry->mProviderNode	= NULL;
+		return;
+	}
+
+	entry->mProvider		= mProviders[providerIndex];
+	entry->mProviderNode	= mProviderNodes[providerIndex];
+}
@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SPECTRUMANALYZERCACHE_H
+#define __NEUROMORE_SPECTRUMANALYZERCACHE_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/Time.h"
+#include "FFTProcessor.h"
+#include "Spectrum.h"
+#include "Channel.h"
+
+// forward declaration
+class Node;
+
+
+// shared spectrum analyzers, keyed by input channel and FFT settings (order, window function, shift, zero padding)
+// every consumer acquires a reference; the spectra are calculated at most once per engine update and dropped with the last reference
+// FFT nodes register their processors as providers, so views of the same channel with matching settings reuse the node output
+// (only while the node is updated: a node suspended by demand tracking does not count, the views then use their own analyzer)
+class ENGINE_API SpectrumAnalyzerCache
+{
+	public:
+		class Entry
+		{
+			friend class SpectrumAnalyzerCache;
+
+			public:
+				// the spectra (valid until the next update, do not keep the pointer)
+				Channel<Spectrum>* GetOutput() const;
+				Channel<double>* GetInput() const								{ return mInput; }
+				const FFTProcessor::FFTSettings& GetSettings() const			{ return mSettings; }
+
+				// the number of spectra kept in the output buffer (at least, the buffer does not shrink while the entry is in use)
+				uint32 GetHistorySize() const									{ return mHistorySize; }
+
+				// changes whenever the output is replaced (switch between provider and own analyzer) or cleared; consumers that keep sample indices have to reset them
+				uint32 GetOutputRevision() const								{ return mOutputRevision; }
+
+			private:
+				Entry(Channel<double>* input, const FFTProcessor::FFTSettings& settings);
+				~Entry();
+
+				bool IsMatching(Channel<double>* input, const FFTProcessor::FFTSettings& settings) const;
+				bool IsProviderUsable() const;
+				void CreateAnalyzer();
+				void UpdateHistorySize();
+
+				Channel<double>*			mInput;
+				FFTProcessor::FFTSettings	mSettings;
+				FFTProcessor*				mAnalyzer;				// own analyzer, NULL while a provider is used
+				FFTProcessor*				mProvider;				// processor of a FFT node with matching settings
+				const Node*					mProviderNode;			// the FFT node of the provider
+				uint32						mHistorySize;			// largest requested history
+				uint32						mOutputRevision;
+				Core::Array<uint32>			mHistoryRequests;		// requested history of every reference
+				Core::Time					mLastUpdateTime;
+				bool						mIsUpdated;
+		};
+
+		// constructor & destructor
+		SpectrumAnalyzerCache();
+		~SpectrumAnalyzerCache();
+
+		// get a shared analyzer and keep at least historySize spectra; call Release() with the same history size once the entry is no longer needed
+		Entry* Acquire(Channel<double>* input, const FFTProcessor::FFTSettings& settings, uint32 historySize);
+		void Release(Entry* entry, uint32 historySize);
+
+		// calculate the new spectra (does nothing if the entry was already updated during the current engine update)
+		void Update(Entry* entry);
+
+		// FFT node processors
+		void RegisterProvider(FFTProcessor* processor, const Node* node);
+		void UnregisterProvider(FFTProcessor* processor);
+
+		uint32 GetNumEntries() const											{ return mEntries.Size(); }
+
+	private:
+		uint32 FindProvider(Channel<double>* input, const FFTProcessor::FFTSettings& settings) const;
+		void SetProvider(Entry* entry, uint32 providerIndex) const;
+
+		Core::Array<Entry*>			mEntries;
+		Core::Array<FFTProcessor*>	mProviders;
+		Core::Array<const Node*>	mProviderNodes;			// the FFT node of each provider
+};
+
+
+#endif
@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "WaveletDenoiser.h"
+#include "../Core/LogManager.h"
+#include <wavelib/wauxlib.h>
+
+
+using namespace Core;
+
+// the wavelets offered in the interface
+static const char* gWaveletNames[] = { "haar", "db2", "db4", "db6", "db8", "sym4", "sym8", "coif2", "coif4" };
+
+
+// constructor
+WaveletDenoiser::WaveletDenoiser()
+{
+	mBlockLength	= 0;
+	mNumLevels		= 0;
+	mNumSamples		= 0;
+	mHasFailed		= false;
+}
+
+
+// destructor
+WaveletDenoiser::~WaveletDenoiser()
+{
+}
+
+
+// setup the block buffers
+bool WaveletDenoiser::Init(uint32 blockLength, uint32 numLevels, const char* waveletName)
+{
+	mWaveletName	= waveletName;
+	mBlockLength	= blockLength;
+	mNumLevels		= numLevels;
+	mHasFailed		= false;
+
+	mInput.Resize(blockLength);
+	mOutput.Resize(blockLength);
+	Reset();
+
+	return (blockLength > 0 && numLevels > 0);
+}
+
+
+void WaveletDenoiser::Reset()
+{
+	mNumSamples = 0;
+	for (uint32 i=0; i<mOutput.Size(); ++i)
+		mOutput[i] = 0.0;
+}
+
+
+// collect a sample and denoise the block once it is full
+bool WaveletDenoiser::AddSample(double sample)
+{
+	if (mBlockLength == 0)
+		return false;
+
+	mInput[mNumSamples++] = sample;
+	if (mNumSamples < mBlockLength)
+		return false;
+
+	mNumSamples = 0;
+
+	// pass the block through if wavelib rejected the settings (e.g. too many levels for the block length)
+	if (mHasFailed == false)
+	{
+		try
+		{
+			visushrink(mInput.GetPtr(), mBlockLength, mNumLevels, mWaveletName.AsChar(), "dwt", "sym", "soft", "first", mOutput.GetPtr());
+			return true;
+		}
+		catch (std::exception& e)
+		{
+			LogError("WaveletDenoiser::AddSample(): wavelib error: %s", e.what());
+			mHasFailed = true;
+		}
+	}
+
+	for (uint32 i=0; i<mBlockLength; ++i)
+		mOutput[i] = mInput[i];
+
+	return true;
+}
+
+
+uint32 WaveletDenoiser::GetNumWavelets()
+{
+	return sizeof(gWaveletNames) / sizeof(gWaveletNames[0]);
+}
+
+
+const char* WaveletDenoiser::GetWaveletName(uint32 index)
+{
+	if (index >= GetNumWavelets())
+		return "";
+
+	return gWaveletNames[index];
+}
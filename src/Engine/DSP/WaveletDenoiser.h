@@ -0,0 +1,67 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_WAVELETDENOISER_H
+#define __NEUROMORE_WAVELETDENOISER_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/String.h"
+
+
+// blockwise DWT denoising (wavelib VisuShrink with soft thresholding)
+// Samples are collected into blocks, each block is transformed once when it is complete.
+class ENGINE_API WaveletDenoiser
+{
+	public:
+		// constructor & destructor
+		WaveletDenoiser();
+		~WaveletDenoiser();
+
+		// wavelet names as understood by wavelib (e.g. "db4", "sym8")
+		bool Init(uint32 blockLength, uint32 numLevels, const char* waveletName);
+		void Reset();
+
+		uint32 GetBlockLength() const											{ return mBlockLength; }
+
+		// add a sample, returns true if a block was completed and GetOutput() holds the denoised block
+		bool AddSample(double sample);
+		const double* GetOutput() const											{ return mOutput.GetPtr(); }
+
+		static uint32 GetNumWavelets();
+		static const char* GetWaveletName(uint32 index);
+
+	private:
+		Core::String			mWaveletName;
+		uint32					mBlockLength;
+		uint32					mNumLevels;
+		uint32					mNumSamples;
+		Core::Array<double>		mInput;
+		Core::Array<double>		mOutput;
+		bool					mHasFailed;
+};
+
+
+#endif
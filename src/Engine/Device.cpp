@@ -33,6 +33,9 @@
 
 using namespace Core;
 
+// smallest sample queue bound (irregular sensors have no sample rate)
+#define DEVICE_MINQUEUEDSAMPLES 1024
+
 
 // device constructor
 Device::Device(DeviceDriver* deviceDriver) : OscReceiver()
@@ -54,6 +57,8 @@ Device::Device(DeviceDriver* deviceDriver) : OscReceiver()
 
 	mWirelessSignalQuality			= 0.0;
 	mReceivedWirelessSignalQuality  = false;
+
+	mMaxQueueDuration				= 0.0;
 }
 
 
@@ -346,6 +351,7 @@ void Device::AddSensor(Sensor* sensor, ESensorDirection direction)
 	if (direction == SENSOR_INPUT)
 	{
 		mInputSensors.Add(sensor);
+		ApplyMaxQueueDuration(sensor);
 	}
 	else
 	{
@@ -480,6 +486,30 @@ Sensor* Device::FindSensorByName(const char* name) const
 }
 
 
+// bound the sample queues of all input sensors
+void Device::SetMaxQueueDuration(double seconds)
+{
+	mMaxQueueDuration = seconds;
+
+	const uint32 numSensors = mInputSensors.Size();
+	for (uint32 i=0; i<numSensors; ++i)
+		ApplyMaxQueueDuration(mInputSensors[i]);
+}
+
+
+void Device::ApplyMaxQueueDuration(Sensor* sensor)
+{
+	if (mMaxQueueDuration <= 0.0)
+	{
+		sensor->SetMaxQueuedSamples(0);
+		return;
+	}
+
+	const uint32 maxQueuedSamples = (uint32)(sensor->GetInput()->GetSampleRate() * mMaxQueueDuration + 0.5);
+	sensor->SetMaxQueuedSamples( Max<uint32>(maxQueuedSamples, DEVICE_MINQUEUEDSAMPLES) );
+}
+
+
 Sensor* Device::AddSensor(ESensorDirection direction, const char* name, double sampleRate, bool isIrregularInput, double minValue, double maxValue, const char* unit, const Color& color)
 {
 	Sensor* sensor;
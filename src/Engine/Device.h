@@ -132,6 +132,17 @@ class ENGINE_API Device : public OscReceiver, public Core::EventSource
 		virtual void Reset();
 		virtual void Update(const Core::Time& elapsed, const Core::Time& delta);
 
+		// acquisition: read and decode everything the hardware delivered and queue the samples into the input sensors
+		// Runs on an acquisition thread of the device manager (or right before Update() if they are disabled), so it must only touch the
+		// sensors through their sample queues. The elapsed time is the engine time of the latest update.
+		virtual bool HasAcquisition() const										{ return false; }
+		virtual void Acquire(const Core::Time& elapsed)							{}
+		virtual double GetAcquisitionInterval() const							{ return 0.002; }		// seconds between two calls on the acquisition thread
+
+		// bound the sample queues of the input sensors to the given duration (0 = unbounded), sensors that get added later are bounded as well
+		void SetMaxQueueDuration(double seconds);
+		double GetMaxQueueDuration() const										{ return mMaxQueueDuration; }
+
 		// if device is enabled/disabled
 		bool IsEnabled() const;
 
@@ -273,6 +284,9 @@ class ENGINE_API Device : public OscReceiver, public Core::EventSource
 		double						mWirelessSignalQuality;			// normalized wireless signal quality (0..1)
 		bool						mReceivedWirelessSignalQuality;	// false until SetWirelessSignalQuality was called with valid level
 
+		double						mMaxQueueDuration;				// input sensor queue bound in seconds (0 = unbounded)
+		void ApplyMaxQueueDuration(Sensor* sensor);
+
 
 	public:
 	
@@ -62,6 +62,10 @@ class ENGINE_API DeviceDriver
 		// main update function
 		virtual void Update(const Core::Time& delta, const Core::Time& elapsed) = 0;
 
+		// acquisition of drivers that read and parse the stream of their devices themselves (e.g. from a serial port)
+		// called from Device::Acquire() of devices that forward their acquisition to the driver, so it runs on the acquisition thread of the device
+		virtual void Acquire(Device* device)									{}
+
 		// enable/disable device driver
 		bool IsEnabled() const													{ return mIsEnabled; }
 		virtual void SetEnabled(bool enabled = true);
@@ -30,9 +30,57 @@
 #include "Core/EventSource.h"
 #include "EngineManager.h"
 #include "Notifications.h"
+#include <atomic>
 
 using namespace Core;
 
+// sensor queue bound of devices with an acquisition thread
+#define ACQUISITION_MAXQUEUEDURATION	2.0
+
+
+// acquisition thread of a single device
+class DeviceAcquisitionHandler : public Core::ThreadHandler
+{
+	public:
+		// constructor & destructor
+		DeviceAcquisitionHandler(DeviceManager* deviceManager, Device* device) : ThreadHandler()		{ mDeviceManager = deviceManager; mDevice = device; mBreak = false; mIsFinished = false; }
+		virtual ~DeviceAcquisitionHandler()																{}
+
+		// poll the device until the thread gets terminated
+		void Execute() override
+		{
+			mIsFinished = false;
+
+			while (mBreak == false)
+			{
+				mLock.Lock();
+				mDevice->Acquire( mDeviceManager->GetAcquisitionTime() );
+				mLock.Unlock();
+
+				if (mBreak == false)
+					Thread::Sleep( mDevice->GetAcquisitionInterval() * 1000.0 );
+			}
+
+			mIsFinished = true;
+		}
+
+		// stop and terminate thread
+		void Terminate() override
+		{
+			mBreak = true;
+		}
+
+		// held during an acquisition
+		Mutex& GetLock()						{ return mLock; }
+
+	private:
+		DeviceManager*			mDeviceManager;
+		Device*					mDevice;
+		Mutex					mLock;
+		std::atomic<bool>		mBreak;
+};
+
+
 // constructor
 DeviceManager::DeviceManager()
 {
@@ -46,6 +94,11 @@ DeviceManager::DeviceManager()
 
 	// enable autoremoval by default
 	mRemoveInactiveDevices = true;
+
+	// devices with an acquisition of their own run it on a thread by default, so a slow device does not delay the others or the classifier
+	mUseAcquisitionThreads	= true;
+	mMaxQueueDuration		= ACQUISITION_MAXQUEUEDURATION;
+	mAcquisitionTime		= 0;
 }
 
 
@@ -104,6 +157,11 @@ void DeviceManager::Update(const Time& elapsed, const Time& delta)
 {
 	mFpsCounter.BeginTiming();
 
+	// the acquisition threads generate/timestamp against the engine time of the latest update
+	mAcquisitionTimeLock.Lock();
+	mAcquisitionTime = elapsed;
+	mAcquisitionTimeLock.Unlock();
+
 	// check for inactive devices and remove them (if feature is enabled)
 	if (mRemoveInactiveDevices == true)
 		RemoveInactiveDevices();
@@ -129,8 +187,16 @@ void DeviceManager::Update(const Time& elapsed, const Time& delta)
 	for (uint32 i=0; i<numDrivers; ++i)
 		mDeviceDrivers[i]->Update(elapsed, delta);
 
-	// update devices
+	// acquire in sequence if the devices have no threads of their own
 	const uint32 numDevices = mDevices.Size();
+	if (mUseAcquisitionThreads == false)
+	{
+		for (uint32 i=0; i<numDevices; ++i)
+			if (mDevices[i]->HasAcquisition() == true)
+				mDevices[i]->Acquire(elapsed);
+	}
+
+	// update devices (drains the sensor queues)
 	for (uint32 i=0; i<numDevices; ++i)
 		mDevices[i]->Update(elapsed, delta);
 
@@ -138,6 +204,100 @@ void DeviceManager::Update(const Time& elapsed, const Time& delta)
 }
 
 
+// start or stop the acquisition threads of all devices
+void DeviceManager::SetAcquisitionThreadsEnabled(bool enable)
+{
+	if (mUseAcquisitionThreads == enable)
+		return;
+
+	mUseAcquisitionThreads = enable;
+
+	const uint32 numDevices = mDevices.Size();
+	for (uint32 i=0; i<numDevices; ++i)
+	{
+		if (enable == true)
+			StartAcquisition(mDevices[i]);
+		else
+			StopAcquisition(mDevices[i]);
+	}
+}
+
+
+// engine time of the latest update
+Time DeviceManager::GetAcquisitionTime()
+{
+	mAcquisitionTimeLock.Lock();
+	const Time time = mAcquisitionTime;
+	mAcquisitionTimeLock.Unlock();
+
+	return time;
+}
+
+
+// start the acquisition thread of the device (if it has an acquisition)
+void DeviceManager::StartAcquisition(Device* device)
+{
+	if (device->HasAcquisition() == false || FindAcquisitionIndex(device) != CORE_INVALIDINDEX32)
+		return;
+
+	// bound the sensor queues (including the sensors the device creates after connecting), the engine drains them on every update
+	device->SetMaxQueueDuration(mMaxQueueDuration);
+
+	String name;
+	name.Format("Acquisition %s", device->GetName().AsChar());
+
+	Acquisition& acquisition = mAcquisitions.AddEmpty();
+	acquisition.mDevice		= device;
+	acquisition.mHandler	= new DeviceAcquisitionHandler(this, device);
+	acquisition.mThread		= new Thread(acquisition.mHandler, name.AsChar());
+	acquisition.mHandler->mThread = acquisition.mThread;
+	acquisition.mThread->Start();
+}
+
+
+// stop the acquisition thread of the device (waits for the running acquisition)
+void DeviceManager::StopAcquisition(Device* device)
+{
+	const uint32 index = FindAcquisitionIndex(device);
+	if (index == CORE_INVALIDINDEX32)
+		return;
+
+	// deletes the handler as well
+	delete mAcquisitions[index].mThread;
+	mAcquisitions.Remove(index);
+
+	// unbounded queues again
+	device->SetMaxQueueDuration(0.0);
+}
+
+
+uint32 DeviceManager::FindAcquisitionIndex(Device* device) const
+{
+	const uint32 numAcquisitions = mAcquisitions.Size();
+	for (uint32 i=0; i<numAcquisitions; ++i)
+		if (mAcquisitions[i].mDevice == device)
+			return i;
+
+	return CORE_INVALIDINDEX32;
+}
+
+
+void DeviceManager::LockAcquisition(Device* device)
+{
+	const uint32 index = FindAcquisitionIndex(device);
+	if (index != CORE_INVALIDINDEX32)
+		mAcquisitions[index].mHandler->GetLock().Lock();
+}
+
+
+void DeviceManager::UnlockAcquisition(Device* device)
+{
+	const uint32 index = FindAcquisitionIndex(device);
+	if (index != CORE_INVALIDINDEX32)
+		mAcquisitions[index].mHandler->GetLock().Unlock();
+}
+
+
 // register a device using an unitialized instance
 void DeviceManager::RegisterDeviceType(Device* prototype)
 {
@@ -313,6 +473,10 @@ void DeviceManager::AddDevice(Device* device)
 	// add device
 	mDevices.Add(device);
 
+	// acquire on its own thread
+	if (mUseAcquisitionThreads == true)
+		StartAcquisition(device);
+
 	// fire events
 	EMIT_EVENT( OnDeviceAdded(device) );
 
@@ -392,10 +556,13 @@ void DeviceManager::RemoveDevice(Device* device)
 		}
 	}
 
-	// 2) fire pre-event
+	// 2) stop the acquisition thread (before the driver cleans up the connection the acquisition reads from)
+	StopAcquisition(device);
+
+	// 3) fire pre-event
 	EMIT_EVENT(OnRemoveDevice(device));
 
-	// 3) unregister device from the osc message router
+	// 4) unregister device from the osc message router
 	GetOscMessageRouter()->UnregisterReceiver(device);
 
 	// 5) remove the device from manager
@@ -467,12 +634,20 @@ double DeviceManager::FindMaximumLatency()
 // synchronize all sensors of all devices so the next sample that is received falls on the given relative time
 void DeviceManager::SyncDevices(double syncTime)
 {
+	// the engine time restarts
+	mAcquisitionTimeLock.Lock();
+	mAcquisitionTime = 0;
+	mAcquisitionTimeLock.Unlock();
+
 	const uint32 numDevices = mDevices.Size();
 
 	for (uint32 i=0; i<numDevices; ++i)
 	{
 		Device* device = mDevices[i];
+
+		LockAcquisition(device);
 		device->Sync(syncTime);
+		UnlockAcquisition(device);
 	}
 }
 
@@ -480,12 +655,20 @@ void DeviceManager::SyncDevices(double syncTime)
 // reset all device sensors and queues (dont reset connection)
 void DeviceManager::ResetDevices()
 {
+	// the engine time restarts
+	mAcquisitionTimeLock.Lock();
+	mAcquisitionTime = 0;
+	mAcquisitionTimeLock.Unlock();
+
 	const uint32 numDevices = mDevices.Size();
 
 	for (uint32 i = 0; i<numDevices; ++i)
 	{
 		Device* device = mDevices[i];
+
+		LockAcquisition(device);
 		device->Reset();
+		UnlockAcquisition(device);
 	}
 }
 
@@ -29,10 +29,13 @@
 #include "Networking/OscReceiver.h"
 #include "Core/EventSource.h"
 #include "Core/Mutex.h"
+#include "Core/Thread.h"
 #include "Core/FpsCounter.h"
 #include "DeviceDriver.h"
 #include "Device.h"
 
+// forward declaration
+class DeviceAcquisitionHandler;
 
 // the DeviceManager class
 class ENGINE_API DeviceManager : public Core::EventSource, OscReceiver
@@ -121,6 +124,26 @@ class ENGINE_API DeviceManager : public Core::EventSource, OscReceiver
 		DeviceDriver* FindDeviceDriverByType(uint32 driverTypeID) const;
 
 
+		//
+		// Acquisition
+		//
+
+		// run the acquisition of every device on its own thread (default), so a slow device does not delay the others (the update only drains the sensor queues)
+		// without acquisition threads the update acquires all devices in sequence, which makes runs reproducible (see the bench --acquisition-threads switch)
+		// NOTE: only devices with Device::HasAcquisition() get a thread (BrainFlow, BrainMaster and load generator devices), the flag does not affect any other device;
+		//       OpenBCI, NeuroSky, Versus and Brainquiry read their serial ports on threads of their own, the Emotiv event loop still runs in DeviceDriver::Update()
+		void SetAcquisitionThreadsEnabled(bool enable = true);
+		bool GetAcquisitionThreadsEnabled() const						{ return mUseAcquisitionThreads; }
+		uint32 GetNumAcquisitionThreads() const							{ return mAcquisitions.Size(); }
+
+		// the sensor queues of devices with an acquisition thread hold at most this many seconds of samples
+		void SetMaxQueueDuration(double seconds)						{ mMaxQueueDuration = seconds; }
+		double GetMaxQueueDuration() const								{ return mMaxQueueDuration; }
+
+		// engine time of the latest update (passed to the acquisition)
+		Core::Time GetAcquisitionTime();
+
+
 		//
 		// Configure Device Manager Behaviour
 		//
@@ -156,6 +179,22 @@ class ENGINE_API DeviceManager : public Core::EventSource, OscReceiver
 
 	private:
 		void RemoveInactiveDevices();
+
+		// acquisition threads
+		struct Acquisition
+		{
+			Device*						mDevice;
+			Core::Thread*				mThread;
+			DeviceAcquisitionHandler*	mHandler;		// owned by the thread
+		};
+
+		void StartAcquisition(Device* device);
+		void StopAcquisition(Device* device);
+		uint32 FindAcquisitionIndex(Device* device) const;
+
+		// keep the acquisition thread of the device out while the engine resets or syncs it
+		void LockAcquisition(Device* device);
+		void UnlockAcquisition(Device* device);
 		
 		// active devices and drivers
 		Core::Array<Device*>				mDevices;
@@ -173,6 +212,13 @@ class ENGINE_API DeviceManager : public Core::EventSource, OscReceiver
 		Core::Mutex						mAddLock;
 		Core::Mutex						mRemoveLock;
 
+		// acquisition
+		Core::Array<Acquisition>		mAcquisitions;
+		bool							mUseAcquisitionThreads;
+		double							mMaxQueueDuration;
+		Core::Time						mAcquisitionTime;
+		Core::Mutex						mAcquisitionTimeLock;
+
 		// device manager config
 		bool							mRemoveInactiveDevices;
 
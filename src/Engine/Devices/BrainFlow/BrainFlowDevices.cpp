@@ -75,6 +75,9 @@ bool BrainFlowDeviceBase::Connect()
 
 bool BrainFlowDeviceBase::Disconnect()
 {
+	mIsAcquiring = false;
+	mBoardLock.Lock();
+
 	if (mBoard && mBoard->is_prepared())
 	{
 		try
@@ -87,6 +90,8 @@ bool BrainFlowDeviceBase::Disconnect()
 		}
 	}
 	mBoard.reset();
+
+	mBoardLock.Unlock();
 	return Device::Disconnect();
 }
 
@@ -143,29 +148,38 @@ void BrainFlowDeviceBase::Update(const Core::Time& elapsed, const Core::Time& de
 {
 	if (!InitAfterConnected())
 		return;
+
+	// update the neuro headset (the acquisition queued the samples)
+	Device::Update(elapsed, delta);
+}
+
+void BrainFlowDeviceBase::Acquire(const Core::Time& elapsed)
+{
+	if (mIsAcquiring == false)
+		return;
+
+	mBoardLock.Lock();
 	try
 	{
-		BrainFlowArray<double, 2> board_data = mBoard->get_board_data();
-		std::vector<int> channels_numbers = BoardShim::get_eeg_channels(GetBoardId());
-		for (uint32 i = 0; i < mSensors.Size(); ++i)
+		// Disconnect() may have come first
+		if (mIsAcquiring == true && mBoard)
 		{
-			auto* sensor = mSensors[i];
-			int channel_number = channels_numbers[i];
-            double* channel_data = board_data.get_address(channel_number);
-			for (int j = 0; j < board_data.get_size(1); ++j)
+			BrainFlowArray<double, 2> board_data = mBoard->get_board_data();
+			std::vector<int> channels_numbers = BoardShim::get_eeg_channels(GetBoardId());
+			for (uint32 i = 0; i < mSensors.Size(); ++i)
 			{
-				double value = channel_data[j];
-				sensor->AddQueuedSample(value);
+				auto* sensor = mSensors[i];
+				int channel_number = channels_numbers[i];
+				double* channel_data = board_data.get_address(channel_number);
+				sensor->AddQueuedSamples(channel_data, board_data.get_size(1));
 			}
 		}
 	}
 	catch (const BrainFlowException& err)
 	{
 		LogError(err.what());
-		return;
 	}
-	// update the neuro headset
-	Device::Update(elapsed, delta);
+	mBoardLock.Unlock();
 }
 
 bool BrainFlowDeviceBase::DoesConnectingFinished() const
@@ -198,9 +212,14 @@ bool BrainFlowDeviceBase::InitAfterConnected()
 	// initialize device after connecting finished
 	try
 	{
-		mBoard = std::move(mFuture.get());
+		std::unique_ptr<BoardShim> board = mFuture.get();
+		mBoardLock.Lock();
+		mBoard = std::move(board);
+		mBoardLock.Unlock();
 		// device is connected successfully
 		CreateSensors();
+		mIsAcquiring = true;
+
 		GetEngine()->SetActiveBci(this);
 		return true;
 	}
@@ -34,6 +34,7 @@
 #include <brainflow/utils/brainflow_constants.h>
 #include <brainflow/board_controller/brainflow_input_params.h>
 #include <future>
+#include <atomic>
 
 // the base class for all OpenBCI devices
 class ENGINE_API BrainFlowDeviceBase : public BciDevice
@@ -55,6 +56,10 @@ public:
 	const BrainFlowInputParams& GetParams() const { return mParams; }
 	void Update(const Core::Time& elapsed, const Core::Time& delta) override;
 
+	// get_board_data() copies and decodes on the acquisition thread
+	bool HasAcquisition() const override { return true; }
+	void Acquire(const Core::Time& elapsed) override;
+
 	
 protected:
 	void CreateElectrodes() override;
@@ -66,6 +71,8 @@ private:
 	const BrainFlowInputParams mParams;
 	std::future<std::unique_ptr<BoardShim>> mFuture;
 	std::unique_ptr<BoardShim> mBoard = nullptr;
+	Core::Mutex mBoardLock;					// board and sensors are (re)created on the engine thread while the acquisition reads them
+	std::atomic<bool> mIsAcquiring { false };	// board connected and sensors created
 
 };
 
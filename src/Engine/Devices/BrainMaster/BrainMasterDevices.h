@@ -81,6 +81,10 @@ public:
    void StopTest() override { mDeviceDriver->StopTest(this); }
    bool IsTestRunning() override { return mDeviceDriver->IsTestRunning(this); }
 
+   // the driver parses the serial stream of the amplifier on the acquisition thread
+   bool HasAcquisition() const override { return true; }
+   void Acquire(const Core::Time& elapsed) override { mDeviceDriver->Acquire(this); }
+
    bool HasEegContactQualityIndicator() override { return IsTestRunning(); }
    double GetImpedance(uint32 neuroSensorIndex) override;
 
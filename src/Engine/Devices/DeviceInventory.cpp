@@ -33,6 +33,8 @@
 #ifdef INCLUDE_DEVICE_TEST
 	#include "Test/TestDevice.h"
 	#include "Test/TestDeviceNode.h"
+	#include "Test/LoadGeneratorDevice.h"
+	#include "Test/LoadGeneratorDeviceNode.h"
 #endif
 
 #ifdef INCLUDE_DEVICE_INTERAXON_MUSE
@@ -154,6 +156,8 @@ void DeviceInventory::RegisterDevices(bool disablePermissionCheck)
 	{
 		GetDeviceManager()->RegisterDeviceType(new TestDevice());
 		GetGraphObjectFactory()->RegisterObjectType(new TestDeviceNode(NULL));
+		GetDeviceManager()->RegisterDeviceType(new LoadGeneratorDevice());
+		GetGraphObjectFactory()->RegisterObjectType(new LoadGeneratorDeviceNode(NULL));
 	}
 #endif
 
@@ -34,6 +34,7 @@ class ENGINE_API DeviceTypeIDs
 		{
 			INVALID_DEVICE_TYPEID					= 0,		// zero denotes invalid device type
 			DEVICE_TYPEID_TEST						= 0x0023,	// 00XX = Test devices
+			DEVICE_TYPEID_LOADGENERATOR				= 0x0024,
 			DEVICE_TYPEID_INTERAXON_MUSE			= 0x0101,	// 01XX = InteraXon
 			DEVICE_TYPEID_NEUROSKY_MINDWAVE			= 0x0201,   // 02XX = Neurosky
 			DEVICE_TYPEID_EMOTIV_EPOC				= 0x0301,	// 03XX = Emotiv
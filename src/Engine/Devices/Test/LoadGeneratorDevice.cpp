@@ -0,0 +1,331 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required files
+#include "LoadGeneratorDevice.h"
+#include "../../EngineManager.h"
+#include "../../Core/LogManager.h"
+#include "../../Core/Math.h"
+
+#ifdef INCLUDE_DEVICE_TEST
+
+using namespace Core;
+
+// default settings: a small headset without artifacts, dropouts or jitter
+LoadGeneratorDevice::Settings::Settings()
+{
+	mNumChannels		= 8;
+	mSampleRate			= 250.0;
+	mSeed				= 1;
+	mNumOscillators		= 8;
+	mAmplitude			= 100.0;
+	mNoiseAmplitude		= 30.0;
+	mArtifactRate		= 0.0;
+	mArtifactAmplitude	= 400.0;
+	mArtifactDuration	= 0.25;
+	mDropoutRate		= 0.0;
+	mDropoutDuration	= 0.1;
+	mJitter				= 0.0;
+	mAcquisitionDelay	= 0.0;
+}
+
+
+// constructor
+LoadGeneratorDevice::LoadGeneratorDevice(DeviceDriver* driver, const Settings& settings) : BciDevice()
+{
+	mDeviceDriver = driver;
+	mSettings = settings;
+	mClock.SetFrequency(mSettings.mSampleRate);
+	mState = STATE_IDLE;
+
+	// create all sensors
+	CreateSensors();
+
+	InitGenerators();
+}
+
+
+// destructor
+LoadGeneratorDevice::~LoadGeneratorDevice()
+{
+}
+
+
+void LoadGeneratorDevice::CreateSensors()
+{
+	BciDevice::CreateSensors();
+
+	// bound the sensor buffers (one minute of 256 channels at 16 kHz would take gigabytes)
+	const uint32 maxBufferSize = 65536;
+	const uint32 numSensors = mNeuroSensors.Size();
+	for (uint32 i=0; i<numSensors; ++i)
+	{
+		Sensor* sensor = mNeuroSensors[i];
+		if (sensor->GetInput()->GetBufferSize() > maxBufferSize)
+			sensor->GetInput()->SetBufferSize(maxBufferSize);
+		if (sensor->GetOutput()->GetBufferSize() > maxBufferSize)
+			sensor->GetOutput()->SetBufferSize(maxBufferSize);
+	}
+}
+
+
+// numbered channels without positions, the 10-20 system list is too short for high channel counts
+void LoadGeneratorDevice::CreateElectrodes()
+{
+	mElectrodes.Clear();
+	mElectrodes.Reserve(mSettings.mNumChannels);
+
+	String name;
+	for (uint32 i=0; i<mSettings.mNumChannels; ++i)
+		mElectrodes.Add( EEGElectrodes::Electrode(name.Format("CH%i", i+1).AsChar(), 0.0, 0.0) );
+}
+
+
+// set up the oscillator banks and the random generators from the seed
+void LoadGeneratorDevice::InitGenerators()
+{
+	uint32 state = mSettings.mSeed ^ 0x9E3779B9;
+	if (state == 0)
+		state = 1;
+
+	const uint32 numChannels = mNeuroSensors.Size();
+	const uint32 numOscillators = mSettings.mNumOscillators;
+	const double maxFrequency = 0.45 * mSettings.mSampleRate;
+
+	mOscillators.Resize(numChannels * numOscillators);
+	mNoiseStates.Resize(numChannels);
+	mArtifactGains.Resize(numChannels);
+
+	for (uint32 c=0; c<numChannels; ++c)
+	{
+		Oscillator* oscillators = mOscillators.GetPtr() + c * numOscillators;
+
+		// random frequencies spread over 1..30 Hz with a 1/f like amplitude falloff
+		double totalWeight = 0.0;
+		for (uint32 k=0; k<numOscillators; ++k)
+		{
+			const double frequency = Min( 1.0 + 29.0 * (k + NextUniform(state)) / numOscillators, maxFrequency );
+			const double phase = Math::twoPiD * NextUniform(state);
+			const double omega = Math::twoPiD * frequency / mSettings.mSampleRate;
+
+			Oscillator& oscillator = oscillators[k];
+			oscillator.mReal		= Math::CosD(phase);
+			oscillator.mImag		= Math::SinD(phase);
+			oscillator.mCos			= Math::CosD(omega);
+			oscillator.mSin			= Math::SinD(omega);
+			oscillator.mAmplitude	= 1.0 / Math::SqrtD(frequency);
+
+			totalWeight += oscillator.mAmplitude;
+		}
+
+		for (uint32 k=0; k<numOscillators; ++k)
+			oscillators[k].mAmplitude *= mSettings.mAmplitude / totalWeight;
+
+		mNoiseStates[c] = NextRandom(state);
+		mArtifactGains[c] = 0.25 + 0.75 * NextUniform(state);
+	}
+
+	mEventState = NextRandom(state);
+	mJitterState = NextRandom(state);
+
+	// schedule the first events
+	mArtifactEndTick = 0;
+	mDropoutEndTick = 0;
+	mNextArtifactTick = (mSettings.mArtifactRate > 0.0 ? CalcEventInterval(mSettings.mArtifactRate) : 0);
+	mNextDropoutTick = (mSettings.mDropoutRate > 0.0 ? CalcEventInterval(mSettings.mDropoutRate) : 0);
+	mNumArtifacts = 0;
+	mNumDropouts = 0;
+}
+
+
+// exponentially distributed interval between two events
+uint64 LoadGeneratorDevice::CalcEventInterval(double rate)
+{
+	return (uint64)(-Math::LogD(1.0 - NextUniform(mEventState)) * mSettings.mSampleRate / rate) + 1;
+}
+
+
+// generate the samples up to the given engine time
+void LoadGeneratorDevice::Acquire(const Time& elapsed)
+{
+	// the clock only depends on the elapsed time
+	mClock.Update(elapsed, 0.0);
+
+	// dont generate data if driver is disabled
+	if (mDeviceDriver == NULL || mDeviceDriver->IsEnabled() == false)
+		return;
+
+	// simulate a slow driver
+	if (mSettings.mAcquisitionDelay > 0.0)
+		Thread::Sleep(mSettings.mAcquisitionDelay * 1000.0);
+
+	uint32 numTicks = mClock.GetNumNewTicks();
+
+	// delivery jitter: hold back the samples that are younger than a random delay, they arrive with one of the next acquisitions
+	if (mSettings.mJitter > 0.0)
+	{
+		const double deliveryTime = elapsed.InSeconds() - mSettings.mJitter * NextUniform(mJitterState);
+		while (numTicks > 0 && mClock.GetTickTime(mClock.GetTick(numTicks - 1)).InSeconds() > deliveryTime)
+			--numTicks;
+	}
+
+	if (numTicks == 0)
+		return;
+
+	const uint64 firstTick = mClock.GetTick(0);
+	const bool hasArtifacts = (mSettings.mArtifactRate > 0.0);
+	const bool hasDropouts = (mSettings.mDropoutRate > 0.0);
+	const uint64 artifactLength = Max<uint64>( 1, (uint64)(mSettings.mArtifactDuration * mSettings.mSampleRate) );
+	const uint64 dropoutLength = Max<uint64>( 1, (uint64)(mSettings.mDropoutDuration * mSettings.mSampleRate) );
+
+	// 1) events: artifact signal and delivered/lost segments of this acquisition (scheduled per tick, so they do not depend on the block sizes)
+	if (hasArtifacts == true)
+		mArtifactBlock.Resize(numTicks);
+
+	mSegments.Clear();
+	for (uint32 i=0; i<numTicks; ++i)
+	{
+		const uint64 tick = firstTick + i;
+
+		if (hasArtifacts == true)
+		{
+			if (tick >= mNextArtifactTick)
+			{
+				mArtifactEndTick = tick + artifactLength;
+				mNextArtifactTick = mArtifactEndTick + CalcEventInterval(mSettings.mArtifactRate);
+				mNumArtifacts++;
+			}
+
+			// half sine bump, similar to an eye blink
+			if (tick < mArtifactEndTick)
+				mArtifactBlock[i] = mSettings.mArtifactAmplitude * Math::SinD( Math::piD * (artifactLength - (mArtifactEndTick - tick) + 0.5) / artifactLength );
+			else
+				mArtifactBlock[i] = 0.0;
+		}
+
+		if (hasDropouts == true && tick >= mNextDropoutTick)
+		{
+			mDropoutEndTick = tick + dropoutLength;
+			mNextDropoutTick = mDropoutEndTick + CalcEventInterval(mSettings.mDropoutRate);
+			mNumDropouts++;
+		}
+
+		const bool isLost = (tick < mDropoutEndTick);
+		if (mSegments.IsEmpty() == true || mSegments.GetLast().mIsLost != isLost)
+		{
+			Segment& segment = mSegments.AddEmpty();
+			segment.mFirst = i;
+			segment.mNumSamples = 0;
+			segment.mIsLost = isLost;
+		}
+
+		mSegments.GetLast().mNumSamples++;
+	}
+
+	// 2) generate and deliver the samples channel by channel
+	mBlock.Resize(numTicks);
+	double* block = mBlock.GetPtr();
+
+	const uint32 numOscillators = mSettings.mNumOscillators;
+	const double noiseScale = 2.0 * mSettings.mNoiseAmplitude;
+	const uint32 numSegments = mSegments.Size();
+	const uint32 numSensors = mNeuroSensors.Size();
+	for (uint32 s=0; s<numSensors; ++s)
+	{
+		// uniform noise
+		uint32 noiseState = mNoiseStates[s];
+		for (uint32 i=0; i<numTicks; ++i)
+			block[i] = (NextUniform(noiseState) - 0.5) * noiseScale;
+		mNoiseStates[s] = noiseState;
+
+		// oscillator bank: rotate each phasor once per sample
+		Oscillator* oscillators = mOscillators.GetPtr() + s * numOscillators;
+		for (uint32 k=0; k<numOscillators; ++k)
+		{
+			Oscillator& oscillator = oscillators[k];
+			double real = oscillator.mReal;
+			double imag = oscillator.mImag;
+			for (uint32 i=0; i<numTicks; ++i)
+			{
+				block[i] += oscillator.mAmplitude * imag;
+
+				const double nextReal = real * oscillator.mCos - imag * oscillator.mSin;
+				imag = real * oscillator.mSin + imag * oscillator.mCos;
+				real = nextReal;
+			}
+
+			// pull the phasor back onto the unit circle so the rounding errors do not accumulate
+			const double correction = 0.5 * (3.0 - (real * real + imag * imag));
+			oscillator.mReal = real * correction;
+			oscillator.mImag = imag * correction;
+		}
+
+		// artifacts
+		if (hasArtifacts == true)
+		{
+			const double gain = mArtifactGains[s];
+			for (uint32 i=0; i<numTicks; ++i)
+				block[i] += gain * mArtifactBlock[i];
+		}
+
+		// deliver the samples, dropouts are reported as lost samples
+		Sensor* sensor = mNeuroSensors[s];
+		for (uint32 i=0; i<numSegments; ++i)
+		{
+			const Segment& segment = mSegments[i];
+			if (segment.mIsLost == true)
+				sensor->HandleLostSamples(segment.mNumSamples);
+			else
+				sensor->AddQueuedSamples(block + segment.mFirst, segment.mNumSamples);
+		}
+	}
+
+	// mark clock ticks as processed
+	mClock.DecrementNewTicks(numTicks);
+}
+
+
+void LoadGeneratorDevice::Reset()
+{
+	// clear sensors
+	Device::Reset();
+
+	mClock.Reset();
+	InitGenerators();
+}
+
+
+void LoadGeneratorDevice::Sync(const Core::Time& time, bool usePadding)
+{
+	Device::Sync(time, usePadding);
+
+	mClock.Reset();
+	mClock.SetStartTime(time);
+	InitGenerators();
+}
+
+#endif
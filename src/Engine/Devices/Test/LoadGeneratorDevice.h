@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+#ifndef __NEUROMORE_LOADGENERATORDEVICE_H
+#define __NEUROMORE_LOADGENERATORDEVICE_H
+
+// include required headers
+#include "../../Config.h"
+#include "../../DSP/ClockGenerator.h"
+#include "../../BciDevice.h"
+
+#ifdef INCLUDE_DEVICE_TEST
+
+
+// synthetic device for capacity testing: any number of channels at any sample rate, generated from precomputed oscillator banks and xorshift noise
+class ENGINE_API LoadGeneratorDevice : public BciDevice
+{
+	public:
+		enum { TYPE_ID = DeviceTypeIDs::DEVICE_TYPEID_LOADGENERATOR };
+
+		// generator settings (all random decisions derive from the seed, so equal settings produce equal sample streams)
+		struct ENGINE_API Settings
+		{
+			Settings();
+
+			uint32		mNumChannels;			// number of generated channels
+			double		mSampleRate;			// output sample rate in Hz
+			uint32		mSeed;					// seed of the oscillator, noise, artifact and dropout generators
+			uint32		mNumOscillators;		// sine oscillators per channel (spread over 1..30 Hz)
+			double		mAmplitude;				// amplitude of the oscillator sum
+			double		mNoiseAmplitude;		// amplitude of the uniform noise
+			double		mArtifactRate;			// injected artifacts per second (0 = none)
+			double		mArtifactAmplitude;		// peak amplitude of an artifact
+			double		mArtifactDuration;		// duration of an artifact in seconds
+			double		mDropoutRate;			// dropouts per second (0 = none)
+			double		mDropoutDuration;		// duration of a dropout in seconds (the samples are reported as lost)
+			double		mJitter;				// maximum delivery delay in seconds (0 = samples arrive on every update)
+			double		mAcquisitionDelay;		// seconds every acquisition blocks, like a slow driver (0 = none)
+		};
+
+		// constructor & destructor
+		LoadGeneratorDevice(DeviceDriver* driver = NULL, const Settings& settings = Settings());
+		virtual ~LoadGeneratorDevice();
+
+		Device* Clone() override							{ return new LoadGeneratorDevice(); }
+
+		// information
+		uint32 GetType() const override						{ return TYPE_ID; }
+		double GetSampleRate() const override				{ return mSettings.mSampleRate; }
+		const char* GetHardwareName() const override		{ return "Load Generator"; }
+		static const char* GetRuleName()					{ return "DEVICE_TestSystem"; }
+		bool IsWireless() const override					{ return false; }
+		bool HasEegContactQualityIndicator() override		{ return false; }
+		const char* GetUuid() const override				{ return "24278277-caf4-11f1-8870-50c18c541241"; }
+		const char* GetTypeName() const override			{ return "loadgenerator"; }
+		double GetTimeoutLimit() const override				{ return 5; }
+		double GetExpectedJitter() const override			{ return mSettings.mJitter; }
+
+		// all channels go to the multi channel port, the node cannot have a port for each of them
+		bool ShowNeuroChannels() const override				{ return false; }
+		bool HasElectrodePositions() override				{ return false; }
+		void CreateSensors() override;
+		void CreateElectrodes() override;
+
+		const Settings& GetSettings() const					{ return mSettings; }
+
+		// number of injected artifacts and dropouts since the last reset
+		uint32 GetNumArtifacts() const						{ return mNumArtifacts; }
+		uint32 GetNumDropouts() const						{ return mNumDropouts; }
+
+		// device is self-driving and need reset
+		void Reset() override;
+
+		// the samples are generated by the acquisition, the generator clock follows the engine time
+		bool HasAcquisition() const override				{ return true; }
+		void Acquire(const Core::Time& elapsed) override;
+
+		void Sync(const Core::Time& time, bool usePadding = true) override;
+
+	private:
+		// sine oscillator, advanced by rotating its phasor
+		struct Oscillator
+		{
+			double		mReal;
+			double		mImag;
+			double		mCos;					// rotation per sample
+			double		mSin;
+			double		mAmplitude;
+		};
+
+		// consecutive delivered or lost samples within an acquisition
+		struct Segment
+		{
+			uint32		mFirst;
+			uint32		mNumSamples;
+			bool		mIsLost;
+		};
+
+		// xorshift32 generator, the state must not be zero
+		static inline uint32 NextRandom(uint32& state)		{ state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+		static inline double NextUniform(uint32& state)		{ return NextRandom(state) * (1.0 / 4294967296.0); }
+
+		// number of ticks until the next event of a poisson process with the given rate per second
+		uint64 CalcEventInterval(double rate);
+
+		void InitGenerators();
+
+		Settings					mSettings;
+		ClockGenerator				mClock;					// clock for generating samples
+
+		Core::Array<Oscillator>		mOscillators;			// mNumOscillators per channel, channel after channel
+		Core::Array<uint32>			mNoiseStates;			// noise generator per channel (independent of the acquisition block sizes)
+		Core::Array<double>			mArtifactGains;			// how strong each channel picks up the artifacts
+		uint32						mEventState;			// generator for the artifact and dropout times
+		uint32						mJitterState;			// generator for the delivery delays
+
+		Core::Array<double>			mBlock;					// samples of one channel for the current acquisition
+		Core::Array<double>			mArtifactBlock;			// artifact signal for the current acquisition
+		Core::Array<Segment>		mSegments;				// delivered and lost samples for the current acquisition
+
+		uint64						mNextArtifactTick;		// start of the next artifact
+		uint64						mArtifactEndTick;		// end of the current artifact
+		uint64						mNextDropoutTick;		// start of the next dropout
+		uint64						mDropoutEndTick;		// end of the current dropout
+		uint32						mNumArtifacts;
+		uint32						mNumDropouts;
+};
+
+#endif
+
+#endif
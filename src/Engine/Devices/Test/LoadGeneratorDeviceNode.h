@@ -0,0 +1,57 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_LOADGENERATORDEVICENODE_H
+#define __NEUROMORE_LOADGENERATORDEVICENODE_H
+
+// include the required headers
+#include "../../Config.h"
+#include "../../Graph/DeviceInputNode.h"
+#include "LoadGeneratorDevice.h"
+
+#ifdef INCLUDE_DEVICE_TEST
+
+class ENGINE_API LoadGeneratorDeviceNode : public DeviceInputNode
+{
+	public:
+		enum { TYPE_ID = 0xD00000 | LoadGeneratorDevice::TYPE_ID };
+		static const char* Uuid () { return "24278483-caf4-11f1-a239-b6278e91579a"; }
+
+		LoadGeneratorDeviceNode(Graph* parentGraph) : DeviceInputNode(parentGraph, LoadGeneratorDevice::TYPE_ID)		{}
+		~LoadGeneratorDeviceNode()				  															{}
+
+		Core::Color GetColor() const override									{ return Core::RGBA(200,88,68); }
+		uint32 GetType() const override											{ return TYPE_ID; }
+		const char* GetTypeUuid() const override final							{ return Uuid(); }
+		const char* GetReadableType() const override							{ return "Load Generator"; }
+		const char* GetRuleName() const override final							{ return LoadGeneratorDevice::GetRuleName(); }
+		GraphObject* Clone(Graph* parentGraph) override							{ LoadGeneratorDeviceNode* clone = new LoadGeneratorDeviceNode(parentGraph); return clone; }
+
+		// load generator generates own samples and is time independent
+		bool IsTimeIndependent() const override									{ return true; }
+
+};
+
+#endif
+
+#endif
@@ -0,0 +1,191 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required files
+#include "ReplayDevice.h"
+#include "../../EngineManager.h"
+#include "../../Core/LogManager.h"
+
+#ifdef INCLUDE_DEVICE_TEST
+
+using namespace Core;
+
+//
+// SensorReplay
+//
+
+SensorReplay::SensorReplay(const SensorRecording* recording, uint32 deviceIndex)
+{
+	mRecording		= recording;
+	mDeviceIndex	= deviceIndex;
+	mTime			= 0;
+	mNextUpdate		= 0;
+}
+
+
+void SensorReplay::CreateDevices(const SensorRecording* recording, Array<Device*>& outDevices)
+{
+	const uint32 numDevices = recording->GetNumDevices();
+	for (uint32 i=0; i<numDevices; ++i)
+	{
+		if (recording->GetDevice(i).mIsBci == true)
+			outDevices.Add( new ReplayBciDevice(recording, i) );
+		else
+			outDevices.Add( new ReplayDevice(recording, i) );
+	}
+}
+
+
+void SensorReplay::CreateSensors(Device* device, uint32 firstSensor) const
+{
+	const SensorRecording::DeviceInfo& info = GetInfo();
+
+	const uint32 numSensors = info.mSensors.Size();
+	for (uint32 i=firstSensor; i<numSensors; ++i)
+	{
+		const SensorRecording::SensorInfo& sensorInfo = info.mSensors[i];
+		const bool isIrregular = (sensorInfo.mInputSampleRate <= 0.0);
+		device->AddSensor( sensorInfo.mIsInput ? Device::SENSOR_INPUT : Device::SENSOR_OUTPUT, sensorInfo.mName.AsChar(), sensorInfo.mSampleRate, isIrregular, sensorInfo.mMinValue, sensorInfo.mMaxValue, sensorInfo.mUnit.AsChar() );
+	}
+
+	// settings that affect the channels
+	for (uint32 i=0; i<numSensors && i<device->GetNumSensors(); ++i)
+	{
+		const SensorRecording::SensorInfo& sensorInfo = info.mSensors[i];
+		Sensor* sensor = device->GetSensor(i);
+
+		sensor->SetDriftCorrectionEnabled(sensorInfo.mUseDriftCorrection);
+		sensor->GetInput()->SetBufferSize(sensorInfo.mInputBufferSize);
+		sensor->GetOutput()->SetBufferSize(sensorInfo.mOutputBufferSize);
+		sensor->GetOutput()->SetMinValue(sensorInfo.mMinValue);
+		sensor->GetOutput()->SetMaxValue(sensorInfo.mMaxValue);
+		sensor->GetOutput()->SetUnit(sensorInfo.mUnit.AsChar());
+	}
+}
+
+
+void SensorReplay::Update(Device* device, const Time& delta)
+{
+	mTime += delta;
+
+	const uint32 numUpdates = mRecording->GetNumUpdates();
+	for (; mNextUpdate < numUpdates && mRecording->GetUpdate(mNextUpdate).mTime <= mTime; ++mNextUpdate)
+	{
+		const SensorRecording::Update& update = mRecording->GetUpdate(mNextUpdate);
+		for (uint32 i=0; i<update.mNumBlocks; ++i)
+		{
+			const SensorRecording::Block& block = mRecording->GetBlock(update.mFirstBlock + i);
+			if (block.mDeviceIndex == mDeviceIndex && block.mSensorIndex < device->GetNumSensors())
+				device->GetSensor(block.mSensorIndex)->AddQueuedSamples( mRecording->GetSamples(block), block.mNumSamples );
+		}
+	}
+}
+
+
+//
+// ReplayDevice
+//
+
+// constructor
+ReplayDevice::ReplayDevice(const SensorRecording* recording, uint32 deviceIndex) : Device(), mReplay(recording, deviceIndex)
+{
+	mState = STATE_IDLE;
+	SetDeviceId(mReplay.GetInfo().mDeviceID);
+
+	CreateSensors();
+}
+
+
+// destructor
+ReplayDevice::~ReplayDevice()
+{
+}
+
+
+void ReplayDevice::CreateSensors()
+{
+	mReplay.CreateSensors(this, 0);
+}
+
+
+void ReplayDevice::Update(const Time& elapsed, const Time& delta)
+{
+	mReplay.Update(this, delta);
+	Device::Update(elapsed, delta);
+}
+
+
+//
+// ReplayBciDevice
+//
+
+// constructor
+ReplayBciDevice::ReplayBciDevice(const SensorRecording* recording, uint32 deviceIndex) : BciDevice(), mReplay(recording, deviceIndex)
+{
+	mState = STATE_IDLE;
+	SetDeviceId(mReplay.GetInfo().mDeviceID);
+
+	CreateSensors();
+}
+
+
+// destructor
+ReplayBciDevice::~ReplayBciDevice()
+{
+}
+
+
+void ReplayBciDevice::CreateSensors()
+{
+	// the neuro sensors are created from the electrodes
+	BciDevice::CreateSensors();
+	mReplay.CreateSensors(this, mNeuroSensors.Size());
+}
+
+
+// recorded electrode names and positions
+void ReplayBciDevice::CreateElectrodes()
+{
+	const SensorRecording::DeviceInfo& info = mReplay.GetInfo();
+
+	mElectrodes.Clear();
+	mElectrodes.Reserve(info.mNumNeuroSensors);
+	for (uint32 i=0; i<info.mNumNeuroSensors; ++i)
+	{
+		const SensorRecording::SensorInfo& sensorInfo = info.mSensors[i];
+		mElectrodes.Add( EEGElectrodes::Electrode(sensorInfo.mName.AsChar(), sensorInfo.mTheta, sensorInfo.mPhi) );
+	}
+}
+
+
+void ReplayBciDevice::Update(const Time& elapsed, const Time& delta)
+{
+	mReplay.Update(this, delta);
+	BciDevice::Update(elapsed, delta);
+}
+
+#endif
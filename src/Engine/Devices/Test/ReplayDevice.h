@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+#ifndef __NEUROMORE_REPLAYDEVICE_H
+#define __NEUROMORE_REPLAYDEVICE_H
+
+// include required headers
+#include "../../Config.h"
+#include "../../BciDevice.h"
+#include "../../SensorRecording.h"
+
+#ifdef INCLUDE_DEVICE_TEST
+
+
+// plays back the samples of one recorded device
+// The replay time is the sum of the update deltas the device receives, every block is queued during the first update that reaches its recorded time.
+class ENGINE_API SensorReplay
+{
+	public:
+		SensorReplay(const SensorRecording* recording, uint32 deviceIndex);
+
+		// create a replay device for every recorded device (the caller adds them to the device manager)
+		static void CreateDevices(const SensorRecording* recording, Core::Array<Device*>& outDevices);
+
+		const SensorRecording* GetRecording() const							{ return mRecording; }
+		uint32 GetDeviceIndex() const										{ return mDeviceIndex; }
+		const SensorRecording::DeviceInfo& GetInfo() const					{ return mRecording->GetDevice(mDeviceIndex); }
+
+		// add the recorded sensors starting at the given index (the neuro sensors of a BCI already exist), then apply the recorded settings to all of them
+		void CreateSensors(Device* device, uint32 firstSensor) const;
+
+		// queue the blocks that are due into the sensors of the device
+		void Update(Device* device, const Core::Time& delta);
+
+		// all recorded blocks were queued
+		bool IsFinished() const												{ return mNextUpdate >= mRecording->GetNumUpdates(); }
+
+	private:
+		const SensorRecording*		mRecording;
+		uint32						mDeviceIndex;
+		Core::Time					mTime;
+		uint32						mNextUpdate;
+};
+
+
+// replays a recorded device that is not a BCI
+class ENGINE_API ReplayDevice : public Device
+{
+	public:
+		// constructor & destructor
+		ReplayDevice(const SensorRecording* recording, uint32 deviceIndex);
+		virtual ~ReplayDevice();
+
+		Device* Clone() override							{ return new ReplayDevice(mReplay.GetRecording(), mReplay.GetDeviceIndex()); }
+
+		// information (as recorded)
+		uint32 GetType() const override						{ return mReplay.GetInfo().mType; }
+		const char* GetHardwareName() const override		{ return mReplay.GetInfo().mHardwareName.AsChar(); }
+		const char* GetUuid() const override				{ return mReplay.GetInfo().mUuid.AsChar(); }
+		const char* GetTypeName() const override			{ return mReplay.GetInfo().mTypeName.AsChar(); }
+		double GetLatency() const override					{ return mReplay.GetInfo().mLatency; }
+		double GetExpectedJitter() const override			{ return mReplay.GetInfo().mExpectedJitter; }
+		double GetTimeoutLimit() const override				{ return mReplay.GetInfo().mTimeoutLimit; }
+
+		void CreateSensors() override;
+
+		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+
+		bool IsFinished() const								{ return mReplay.IsFinished(); }
+
+	private:
+		SensorReplay				mReplay;
+};
+
+
+// replays a recorded BCI
+class ENGINE_API ReplayBciDevice : public BciDevice
+{
+	public:
+		// constructor & destructor
+		ReplayBciDevice(const SensorRecording* recording, uint32 deviceIndex);
+		virtual ~ReplayBciDevice();
+
+		Device* Clone() override							{ return new ReplayBciDevice(mReplay.GetRecording(), mReplay.GetDeviceIndex()); }
+
+		// information (as recorded)
+		uint32 GetType() const override						{ return mReplay.GetInfo().mType; }
+		double GetSampleRate() const override				{ return mReplay.GetInfo().mSampleRate; }
+		const char* GetHardwareName() const override		{ return mReplay.GetInfo().mHardwareName.AsChar(); }
+		const char* GetUuid() const override				{ return mReplay.GetInfo().mUuid.AsChar(); }
+		const char* GetTypeName() const override			{ return mReplay.GetInfo().mTypeName.AsChar(); }
+		double GetLatency() const override					{ return mReplay.GetInfo().mLatency; }
+		double GetExpectedJitter() const override			{ return mReplay.GetInfo().mExpectedJitter; }
+		double GetTimeoutLimit() const override				{ return mReplay.GetInfo().mTimeoutLimit; }
+		bool ShowNeuroChannels() const override				{ return mReplay.GetInfo().mShowNeuroChannels; }
+
+		void CreateSensors() override;
+		void CreateElectrodes() override;
+
+		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+
+		bool IsFinished() const								{ return mReplay.IsFinished(); }
+
+	private:
+		SensorReplay				mReplay;
+};
+
+
+#endif
+
+#endif
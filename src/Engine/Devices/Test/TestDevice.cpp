@@ -37,10 +37,11 @@
 using namespace Core;
 
 // constructor
-TestDevice::TestDevice(DeviceDriver* driver, uint32 sampleRate) : BciDevice()
+TestDevice::TestDevice(DeviceDriver* driver, uint32 sampleRate, uint32 numChannels) : BciDevice()
 {
 	mDeviceDriver = driver;
 	mSampleRate	= sampleRate;
+	mNumChannels = numChannels;
 	mClock.SetFrequency(sampleRate);
 	mState = STATE_IDLE;
 
@@ -117,6 +118,13 @@ TestDevice::~TestDevice()
 }
 
 
+// all electrodes of the 10-20 system list except the default one at index 0
+uint32 TestDevice::GetMaxNumChannels()
+{
+	return GetEEGElectrodes()->GetNumElectrodes() - 1;
+}
+
+
 // get the available electrodes of the neuro headset
 void TestDevice::CreateElectrodes()
 {
@@ -131,6 +139,24 @@ void TestDevice::CreateElectrodes()
 	mElectrodes.Add( GetEEGElectrodes()->GetElectrodeByID("O1") );
 	mElectrodes.Add( GetEEGElectrodes()->GetElectrodeByID("O2") );
 
+	// custom channel count: use the electrodes in order instead (skip the default electrode at index 0)
+	if (mNumChannels != mElectrodes.Size())
+	{
+		mElectrodes.Clear();
+
+		// never drop channels silently, the caller has to check GetMaxNumChannels()
+		uint32 numElectrodes = mNumChannels;
+		if (numElectrodes > GetMaxNumChannels())
+		{
+			LogError("TestDevice::CreateElectrodes(): %i channels requested, but there are only %i electrodes (use the load generator device for more channels).", mNumChannels, GetMaxNumChannels());
+			numElectrodes = GetMaxNumChannels();
+		}
+
+		mElectrodes.Reserve(numElectrodes);
+		for (uint32 i=0; i<numElectrodes; ++i)
+			mElectrodes.Add( GetEEGElectrodes()->GetElectrode(i + 1) );
+	}
+
 /*
 	for (uint32 i=0; i< EEGElectrodes::NUM; ++i)
 		result.Add((EEGElectrodes::EElectrode)i);
@@ -38,10 +38,13 @@ class ENGINE_API TestDevice : public BciDevice
 	public:
 		enum { TYPE_ID = DeviceTypeIDs::DEVICE_TYPEID_TEST };
 
-		// constructor & destructor
-		TestDevice(DeviceDriver* driver = NULL, uint32 sampleRate = 128);
+		// constructor & destructor (a channel count other than the size of the default montage takes the electrodes in order of the 10-20 system list)
+		TestDevice(DeviceDriver* driver = NULL, uint32 sampleRate = 128, uint32 numChannels = 8);
 		virtual ~TestDevice();
 
+		// the largest channel count, one electrode per channel (use the load generator for more channels)
+		static uint32 GetMaxNumChannels();
+
 		Device* Clone() override							{ return new TestDevice(); }
 
 		// information
@@ -67,6 +70,7 @@ class ENGINE_API TestDevice : public BciDevice
 		ClockGenerator			mClock;						// clock for generating samples
 		Core::Array<double>		mElectrodeTimeOffsets;		// random offset for each sensor
 		double					mSampleRate;				// output sample rate
+		uint32					mNumChannels;				// number of generated channels
 };
 
 #endif
@@ -37,6 +37,7 @@ using namespace Core;
 TestDeviceDriver::TestDeviceDriver() : DeviceDriver(Branding::DefaultTestDeviceEnabled)
 {
 	AddSupportedDevice(TestDevice::TYPE_ID);
+	AddSupportedDevice(LoadGeneratorDevice::TYPE_ID);
 
 	mTimeSinceDeviceCheck = 0.0;
 }
@@ -63,6 +64,21 @@ bool TestDeviceDriver::Init()
 }
 
 
+// create a test device or a load generator with default settings
+Device* TestDeviceDriver::CreateDevice(uint32 deviceTypeID)
+{
+	// check if its the correct device
+	CORE_ASSERT(IsDeviceSupported(deviceTypeID));
+
+	switch (deviceTypeID)
+	{
+		case TestDevice::TYPE_ID:			return new TestDevice(this);
+		case LoadGeneratorDevice::TYPE_ID:	return new LoadGeneratorDevice(this);
+		default:  /* does not happen*/		return NULL;
+	}
+}
+
+
 // update the system
 void TestDeviceDriver::Update(const Time& elapsed, const Time& delta)
 {
@@ -27,6 +27,7 @@
 // include required headers
 #include "../../DeviceDriver.h"
 #include "TestDevice.h"
+#include "LoadGeneratorDevice.h"
 #include "../../EngineManager.h"
 
 #ifdef INCLUDE_DEVICE_TEST
@@ -51,7 +52,7 @@ class ENGINE_API TestDeviceDriver : public DeviceDriver
 		// update process
 		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
 
-		Device* CreateDevice(uint32 deviceTypeID) override				{ return new TestDevice(this); }
+		Device* CreateDevice(uint32 deviceTypeID) override;
 
 		bool HasAutoDetectionSupport() const override					{ return false; }
 
@@ -48,6 +48,12 @@ EngineManager::EngineManager()
 
 	// set version
 	mVersion = Version( NEUROMORE_ENGINE_VERSION_MAJOR, NEUROMORE_ENGINE_VERSION_MINOR, NEUROMORE_ENGINE_VERSION_PATCH );
+
+	// profiler scopes of the update stages
+	mProfilerScopeDevices		= mProfiler.RegisterScope( "DeviceManager", "Engine" );
+	mProfilerScopeOscRouter		= mProfiler.RegisterScope( "OscMessageRouter", "Engine" );
+	mProfilerScopeStateMachine	= mProfiler.RegisterScope( "StateMachine", "Engine" );
+	mProfilerScopeClassifier	= mProfiler.RegisterScope( "Classifier", "Engine" );
 }
 
 
@@ -74,8 +80,9 @@ EngineManager::~EngineManager()
 	// get rid of the graph manager
 	delete mGraphManager;
 
-	// get rid of the spectrum analyzer settings
+	// get rid of the spectrum analyzer settings and shared analyzers (after the graphs, FFT nodes unregister from the cache)
 	delete mSpectrumAnalyzerSettings;
+	delete mSpectrumAnalyzerCache;
 
 	// get rid of the callback
 	delete mCallback;
@@ -86,6 +93,10 @@ EngineManager::~EngineManager()
 	// serial port manager
 	delete mSerialPortManager;
 
+	// get rid of the chunk store (after the graphs, remaining storage channels get their chunks back)
+	delete mChannelChunkStore;
+	mChannelChunkStore = NULL;
+
 
 	// destruct core systems
 
@@ -121,6 +132,7 @@ bool EngineManager::Init()
 
 	// state
 	mActiveBci				= NULL;
+	mSensorRecording		= NULL;
 	mActiveClassifier		= NULL;
 	mActiveStateMachine		= NULL;
 	mActiveExperience		= NULL;
@@ -133,6 +145,12 @@ bool EngineManager::Init()
 	mPowerLineFrequencyType	= POWERLINEFREQ_AUTO;
 	mAutoSyncEnabled		= true;
 	mAutoDetectionEnabled	= Branding::DefaultAutoDetectionEnabled;
+	mChannelSampleFormat	= ChannelBase::SAMPLEFORMAT_DOUBLE;
+	mChannelSampleResolution = 1.0;
+	mSkipIdleProcessors		= true;
+	mDemandTrackingEnabled	= false;
+	for (uint32 i=0; i<NUM_VIEWTYPES; ++i)
+		mNumViewConsumers[i] = 0;
 
 	// drift correction settings
 	mDriftCorrectionSettings.mIsEnabled = true;
@@ -146,8 +164,12 @@ bool EngineManager::Init()
 	// add the EEG 10-20 system electrodes
 	mEEGElectrodes			= new EEGElectrodes();
 
+	// sealed chunks of storage channels (before anything creates channels)
+	mChannelChunkStore		= new ChannelChunkStore();
+
 	// create the spectrum analyzer settings
 	mSpectrumAnalyzerSettings = new SpectrumAnalyzerSettings();
+	mSpectrumAnalyzerCache = new SpectrumAnalyzerCache();
 
 	// create the osc router (must be created before device manager!)
 	mOscMessageRouter		= new OscMessageRouter();
@@ -201,11 +223,19 @@ void EngineManager::Update(Time delta)
 
 	// 2) update the osc message router, so the newest messages are pushed into the devices
 	// this internally passes the asynch received messages over to the receiver objects and let them process the data
+	Profiler::Marker marker;
+	mProfiler.Begin(marker);
 	mOscMessageRouter->ProcessData();
 	mOscMessageRouter->ScrubPacketPool();
+	mProfiler.End(marker, mProfilerScopeOscRouter);
 
 	// 3) update the devices, so the newest messages will be processed
+	mProfiler.Begin(marker);
 	mDeviceManager->Update(mElapsedTime, delta);
+	mProfiler.End(marker, mProfilerScopeDevices);
+
+	if (mSensorRecording != NULL)
+		mSensorRecording->Record(delta);
 
 	// TODO get rid of engine sync here (update loop should never reset the engine, it has to be called from outside by the owner that controls it (studio, app, etc)
 
@@ -230,11 +260,19 @@ void EngineManager::Update(Time delta)
 	// 5) update classifier (if we did not sync)
 	// update and output the state machine
 	if (mActiveStateMachine != NULL)
+	{
+		mProfiler.Begin(marker);
 		mActiveStateMachine->Update(mElapsedTime, delta);
+		mProfiler.End(marker, mProfilerScopeStateMachine);
+	}
 
-	// update and output the classifier
+	// update and output the classifier (contains the events of all its nodes)
 	if (mActiveClassifier != NULL)
+	{
+		mProfiler.Begin(marker);
 		mActiveClassifier->Update(mElapsedTime, delta);
+		mProfiler.End(marker, mProfilerScopeClassifier);
+	}
 
 	mFpsCounter.StopTiming();
 }
@@ -593,6 +631,14 @@ double EngineManager::GetPowerLineFrequency(User* user) const
 }
 
 
+// a visualization stopped showing the view node channels of the given type (never drops below zero)
+void EngineManager::RemoveViewConsumer(EViewType type)
+{
+	uint32 numConsumers = mNumViewConsumers[type].load(std::memory_order_relaxed);
+	while (numConsumers > 0 && mNumViewConsumers[type].compare_exchange_weak(numConsumers, numConsumers - 1, std::memory_order_relaxed) == false) {}
+}
+
+
 // enable autodetection
 void EngineManager::SetAutoDetectionSetting(bool enable)
 {
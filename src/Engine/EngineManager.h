@@ -33,6 +33,7 @@
 #include "Core/Timer.h"
 #include "Core/Version.h"
 #include "Core/FpsCounter.h"
+#include "Core/Profiler.h"
 #include "Core/EventManager.h"
 #include "Core/EventSource.h"
 #include "Core/Counter.h"
@@ -42,14 +43,18 @@
 #include "Experience.h"
 #include "User.h"
 #include "DSP/SpectrumAnalyzerSettings.h"
+#include "DSP/SpectrumAnalyzerCache.h"
+#include "DSP/ChannelChunkStore.h"
 #include "Graph/GraphManager.h"
 #include "Graph/GraphObjectFactory.h"
 #include "Graph/Classifier.h"
 #include "Graph/StateMachine.h"
 #include "Networking/OscMessageRouter.h"
 #include "DeviceManager.h"
+#include "SensorRecording.h"
 #include "SerialPortManager.h"
 #include "Core/AttributeFactory.h"
+#include <atomic>
 
 // forward declarations
 
@@ -172,6 +177,10 @@ class ENGINE_API EngineManager : public Core::EventSource
 		// device manager
 		DeviceManager* GetDeviceManager() const									{ return mDeviceManager; }
 		
+		// captures the sensor input of all devices after every device update (NULL = not recording)
+		void SetSensorRecording(SensorRecording* recording)						{ mSensorRecording = recording; }
+		SensorRecording* GetSensorRecording() const								{ return mSensorRecording; }
+
 		// serial port management
 		SerialPortManager* GetSerialPortManager() const							{ return mSerialPortManager; }
 
@@ -201,6 +210,9 @@ class ENGINE_API EngineManager : public Core::EventSource
 
 		// performance statistics
 		const Core::FpsCounter& GetFpsCounter() const							{ return mFpsCounter; }
+
+		// per-node hot-path profiler (disabled by default)
+		Core::Profiler& GetProfiler()											{ return mProfiler; }
 		
 		// version
 		Core::Version GetVersion() const										{ return mVersion; }
@@ -217,6 +229,37 @@ class ENGINE_API EngineManager : public Core::EventSource
 		// spectrum analyzer settings
 		SpectrumAnalyzerSettings* GetSpectrumAnalyzerSettings()					{ return mSpectrumAnalyzerSettings; }
 
+		// spectrum analyzers shared by the visualizations and FFT nodes
+		SpectrumAnalyzerCache* GetSpectrumAnalyzerCache()						{ return mSpectrumAnalyzerCache; }
+
+		// disk-backed storage channels (disabled by default)
+		ChannelChunkStore* GetChannelChunkStore()								{ return mChannelChunkStore; }
+
+		// sample format of the node output buffers (can be overridden per output port)
+		void SetChannelSampleFormat(ChannelBase::ESampleFormat format, double resolution = 1.0)	{ mChannelSampleFormat = format; mChannelSampleResolution = resolution; }
+		ChannelBase::ESampleFormat GetChannelSampleFormat() const				{ return mChannelSampleFormat; }
+		double GetChannelSampleResolution() const								{ return mChannelSampleResolution; }
+
+		// skip the update of processors that cannot produce output during a tick (enabled by default)
+		void SetSkipIdleProcessors(bool enable)									{ mSkipIdleProcessors = enable; }
+		bool GetSkipIdleProcessors() const										{ return mSkipIdleProcessors; }
+
+		// demand tracking: suspend the nodes that have no path to a consumed sink (disabled by default)
+		void SetDemandTrackingEnabled(bool enable)								{ mDemandTrackingEnabled.store(enable, std::memory_order_relaxed); }
+		bool IsDemandTrackingEnabled() const									{ return mDemandTrackingEnabled.load(std::memory_order_relaxed); }
+
+		// visualizations register themselves while they show the view node channels of the given type (called from the UI thread, read by the engine update)
+		enum EViewType
+		{
+			VIEWTYPE_SIGNAL = 0,		// double channels of the view nodes
+			VIEWTYPE_SPECTRUM,			// spectrum channels of the view nodes
+			NUM_VIEWTYPES
+		};
+
+		void AddViewConsumer(EViewType type)									{ mNumViewConsumers[type].fetch_add(1, std::memory_order_relaxed); }
+		void RemoveViewConsumer(EViewType type);
+		uint32 GetNumViewConsumers(EViewType type) const						{ return mNumViewConsumers[type].load(std::memory_order_relaxed); }
+
 		// power line frequency
 		enum EPowerLineFrequencyType
 		{
@@ -294,6 +337,7 @@ class ENGINE_API EngineManager : public Core::EventSource
 		// devices
 		DeviceManager*					mDeviceManager;
 		BciDevice*						mActiveBci;
+		SensorRecording*				mSensorRecording;
 		EEGElectrodes*					mEEGElectrodes;
 		SerialPortManager*				mSerialPortManager;
 
@@ -302,6 +346,13 @@ class ENGINE_API EngineManager : public Core::EventSource
 
 		// signal processing
 		SpectrumAnalyzerSettings*		mSpectrumAnalyzerSettings;
+		SpectrumAnalyzerCache*			mSpectrumAnalyzerCache;
+		ChannelChunkStore*				mChannelChunkStore;
+		ChannelBase::ESampleFormat		mChannelSampleFormat;
+		double							mChannelSampleResolution;
+		bool							mSkipIdleProcessors;
+		std::atomic<bool>				mDemandTrackingEnabled;
+		std::atomic<uint32>				mNumViewConsumers[NUM_VIEWTYPES];
 
 		// power line frequency
 		EPowerLineFrequencyType			mPowerLineFrequencyType;
@@ -330,6 +381,11 @@ class ENGINE_API EngineManager : public Core::EventSource
 
 		// performance timing
 		Core::FpsCounter				mFpsCounter;
+		Core::Profiler					mProfiler;
+		uint32							mProfilerScopeDevices;
+		uint32							mProfilerScopeOscRouter;
+		uint32							mProfilerScopeStateMachine;
+		uint32							mProfilerScopeClassifier;
 
 };
 
@@ -286,20 +286,41 @@ void AutoThresholdNode::Processor::Update()
 	// Step 1: check if histogram is still sufficient for the sample range by checking the new samples first
 	double minValue = mHistogram.GetMinValue();
 	double maxValue = mHistogram.GetMaxValue();
+	double minSampleValue = DBL_MAX;
+	double maxSampleValue = -DBL_MAX;
 	for (uint32 i=0; i<numSignalSamples; ++i)
 	{
 		const double value = signalInputReader->GetSample<double>(i);
-		minValue = Min(minValue, value);
-		maxValue = Max(maxValue, value);
+		minSampleValue = Min(minSampleValue, value);
+		maxSampleValue = Max(maxSampleValue, value);
 	}
+	minValue = Min(minValue, minSampleValue);
+	maxValue = Max(maxValue, maxSampleValue);
 
-	// Step 2: Reinitialize Histogram if necessary
+	// Step 2: Extend or reinitialize Histogram if necessary
 	const bool canRebuildHistogram = signalInputReader->GetNumEpochs() > 0;
 	
 	const bool isEmpty = (mHistogram.GetNumValues() == 0);
-	const bool isTooSmall = (minValue < mHistogram.GetMinValue() || maxValue > mHistogram.GetMaxValue());				// histogram range doesn't cover the input values
-	//const bool isTooLarge = (mHistogram.GetMaxValue() - mHistogram.GetMinValue()) > 20.0 * (maxValue - minValue);		// only 5% of the histogram are actually used
-	const bool isTooLarge = (maxValue - minValue) / mHistogram.GetBinWidth();		// value range is covered by less than 100 bins (= possible 'steps' in the output)
+	bool isTooSmall = (numSignalSamples > 0 && (mHistogram.IsInRange(minSampleValue) == false || mHistogram.IsInRange(maxSampleValue) == false));		// histogram range doesn't cover the input values (a value on the upper edge would be clamped into the last bin)
+
+	// extend the range by merging bins instead of rebuilding the histogram from the whole epoch
+	if (isEmpty == false && isTooSmall == true && mHistogram.ExtendRange(minValue, maxValue) == true)
+		isTooSmall = false;
+
+	// values (including the new ones) are covered by less than a quarter of the bins (= possible 'steps' in the output)
+	bool isTooLarge = false;
+	if (isEmpty == false)
+	{
+		uint32 lowBin = mHistogram.FindLowBin();
+		uint32 highBin = mHistogram.FindHighBin();
+		if (numSignalSamples > 0)
+		{
+			lowBin = Min(lowBin, mHistogram.CalcBinIndex(minSampleValue));
+			highBin = Max(highBin, mHistogram.CalcBinIndex(maxSampleValue));
+		}
+		isTooLarge = (highBin - lowBin + 1) * 4 < mHistogram.GetNumBins();
+	}
+
 	const bool needRebuildHistogram = isEmpty || isTooSmall || isTooLarge;
 
 	if (needRebuildHistogram && canRebuildHistogram)
@@ -431,143 +452,11 @@ double AutoThresholdNode::Processor::CalcLowInputThreshold (double inputValue)
 
 double AutoThresholdNode::Processor::CalcHighAutoThreshold (double lowThreshold, double target)
 {
-	if (mHistogram.GetNumValues() == 0)
-		return 0;
-
-	// targets for both mode
-	const uint32 numSamples = mHistogram.GetNumValues();
-	const uint32 scoreTargetSampleCount = numSamples * target;
-
-	// find threshold so the target is matched as closely as possible
-	uint32 currentSampleCount = 0;
-	double currentInverseArea = 0;
-
-	const int32 highBinIndex = mHistogram.GetNumBins()-1;;//mHistogram.FindHighBin(); 
-	const int32 lowBinIndex = mHistogram.CalcBinIndex(lowThreshold);
-
-	for (int32 i=lowBinIndex; i<=highBinIndex; ++i)
-	{
-		// move low threshold one bin down and increase the current sample count
-		const uint32 binSize = mHistogram.GetBin(i);
-
-		// proposed low threshold that will be tested for the target
-		const double highThreshold = mHistogram.GetBinMaxValue(i);
-
-		// current sample count
-		currentSampleCount += binSize;
-
-		if (mSettings.mTargetMode == TARGETMODE_TIME)
-		{
-			// reached target count?
-			if (currentSampleCount >= scoreTargetSampleCount)
-			{
-				// fine-adjust the threshold within BinMinValue and BinMaxValue by assuming equal sample distribution within the bin;
-				const uint32 numSamplesOvershoot = currentSampleCount - scoreTargetSampleCount;
-				const double correctionOffset = (binSize == 0 ? 0 : mHistogram.GetBinWidth() *  ( (double)numSamplesOvershoot / (double)binSize)); // Note: this check is probably unnecessary because the currentSampleCount never increases when binSize is zero ?!
-				return highThreshold - correctionOffset;
-			}
-		}
-		else // TARGETMODE_SCORE
-		{
-			const double height = (highThreshold - lowThreshold);
-
-			if (height == 0)
-				continue;
-
-			// increment current (inverse) area
-			currentInverseArea += height * binSize;
-
-			const double totalArea = height * (double)numSamples;
-
-			// calculate real area taken up by the waveform within the thresholds
-			const double nonVisitedInverseArea = height * (numSamples - currentSampleCount);
-			const double currentArea = totalArea - (currentInverseArea + nonVisitedInverseArea);
-
-			// calculate target area from current thresholds
-			const double targetArea = totalArea * target;
-			
-			if (currentArea >= targetArea)
-			{
-				// TODO fine-adjust the threshold if possible? same as above?? -> whiteboard time!
-				return highThreshold;
-			}
-		}
-	}
-
-	// goal was not reached, return the largest value we have			// TODO: add some kind of 'success' output to the node? 
-	return mHistogram.GetBinMaxValue( highBinIndex );
+	return mHistogram.CalcHighThreshold(lowThreshold, target, mSettings.mTargetMode == TARGETMODE_SCORE);
 }
 
 
 double AutoThresholdNode::Processor::CalcLowAutoThreshold (double highThreshold, double target)
 {
-	if (mHistogram.GetNumValues() == 0)
-		return 0;
-
-	// targets for both mode
-	const uint32 numSamples = mHistogram.GetNumValues();
-	const uint32 scoreTargetSampleCount = numSamples * target;
-
-	// find threshold so the target is matched as closely as possible
-	uint32 currentSampleCount = 0;
-	double currentInverseArea = 0;
-
-	const int32 highBinIndex = mHistogram.CalcBinIndex(highThreshold);
-	const int32 lowBinIndex = 0;//mHistogram.FindLowBin();
-
-	for (int32 i=highBinIndex; i>=lowBinIndex; --i)
-	{
-		// move low threshold one bin down and increase the current sample count
-		const uint32 binSize = mHistogram.GetBin(i);
-
-		// proposed low threshold that will be tested for the target
-		const double lowThreshold = mHistogram.GetBinMinValue(i);
-
-		// current sample count
-		currentSampleCount += binSize;
-
-		if (mSettings.mTargetMode == TARGETMODE_TIME)
-		{
-			// reached target count?
-			if (currentSampleCount >= scoreTargetSampleCount)
-			{
-				// fine-adjust the threshold within BinMinValue and BinMaxValue by assuming equal sample distribution within the bin;
-				const uint32 numSamplesOvershoot = currentSampleCount - scoreTargetSampleCount;
-				const double correctionOffset = (binSize == 0 ? 0 : mHistogram.GetBinWidth() *  ( (double)numSamplesOvershoot / (double)binSize)); // Note: this check is probably unnecessary because the currentSampleCount never increases when binSize is zero ?!
-				return lowThreshold + correctionOffset;
-			}
-		}
-		else // TARGETMODE_SCORE
-		{
-			const double height = (highThreshold - lowThreshold);
-
-			if (height == 0)
-				continue;
-
-			// increment current (inverse) area
-			currentInverseArea += height * binSize;
-
-			const double totalArea = height * (double)numSamples;
-
-			// calculate real area taken up by the waveform within the thresholds
-			const double nonVisitedInverseArea = height * (numSamples - currentSampleCount);
-			const double currentArea = totalArea - (currentInverseArea + nonVisitedInverseArea);
-
-			// calculate target area from current thresholds
-			const double targetArea = totalArea * target;
-			
-			if (currentArea >= targetArea)
-			{
-				// TODO fine-adjust the threshold if possible? same as above?? -> whiteboard time!
-				return lowThreshold;
-			}
-		}
-	}
-
-	// goal was not reached, return the smallest value we have			// TODO: add some kind of 'success' output to the node? 
-	return mHistogram.GetBinMinValue( lowBinIndex );
+	return mHistogram.CalcLowThreshold(highThreshold, target, mSettings.mTargetMode == TARGETMODE_SCORE);
 }
-
-
-
-
@@ -0,0 +1,159 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "BandPowerNode.h"
+#include "../Core/Math.h"
+#include "../EngineManager.h"
+
+
+using namespace Core;
+
+// constructor
+BandPowerNode::BandPowerNode(Graph* graph) : ProcessorNode(graph, new BandPowerProcessor())
+{
+	// default values (alpha band)
+	mSettings.mValueType = BandPowerProcessor::VALUE_AMPLITUDE;
+	mSettings.mMinFrequency = 8.0;
+	mSettings.mMaxFrequency = 12.0;
+	mSettings.mFFTOrder = 7;
+	mSettings.mEpochShift = 1;
+}
+
+
+// destructor
+BandPowerNode::~BandPowerNode()
+{
+}
+
+
+// initialize the node
+void BandPowerNode::Init()
+{
+	// init base class first
+	ProcessorNode::Init();
+
+	// CONFIG SPNODE
+	RequireConstantSampleRate();
+
+	// SETUP PORTS
+
+	GetInputPort(INPUTPORT_CHANNEL).Setup("In", "x", AttributeChannels<double>::TYPE_ID, PORTID_INPUT_SAMPLE);
+	GetOutputPort(OUTPUTPORT_CHANNEL).Setup("Out", "y", AttributeChannels<double>::TYPE_ID, PORTID_OUTPUT_VALUE);
+
+	// SETUP ATTRIBUTES
+
+	// value types
+	Core::AttributeSettings* valueAttr = RegisterAttribute( "Value", "ValueType", "The value to average.", Core::ATTRIBUTE_INTERFACETYPE_COMBOBOX );
+	valueAttr->ResizeComboValues(2);
+	valueAttr->SetComboValue(BandPowerProcessor::VALUE_AMPLITUDE, "Average Amplitude");
+	valueAttr->SetComboValue(BandPowerProcessor::VALUE_POWER, "Average Power");
+	valueAttr->SetDefaultValue(Core::AttributeInt32::Create((int32)mSettings.mValueType));
+
+	// frequency range
+	Core::AttributeSettings* minFreqAttr = RegisterAttribute( "Lower Frequency", "MinFrequency", "The lower bound of the frequency range.", Core::ATTRIBUTE_INTERFACETYPE_FLOATSLIDER );
+	minFreqAttr->SetMinValue(Core::AttributeFloat::Create(0));
+	minFreqAttr->SetMaxValue(Core::AttributeFloat::Create(200));
+	minFreqAttr->SetDefaultValue(Core::AttributeFloat::Create(mSettings.mMinFrequency));
+
+	Core::AttributeSettings* maxFreqAttr = RegisterAttribute( "Upper Frequency", "MaxFrequency", "The upper bound of the frequency range.", Core::ATTRIBUTE_INTERFACETYPE_FLOATSLIDER );
+	maxFreqAttr->SetMinValue(Core::AttributeFloat::Create(0));
+	maxFreqAttr->SetMaxValue(Core::AttributeFloat::Create(200));
+	maxFreqAttr->SetDefaultValue(Core::AttributeFloat::Create(mSettings.mMaxFrequency));
+
+	// window length
+	Core::AttributeSettings* FFTOrderAttr = RegisterAttribute( "FFT Order", "FFTorder", "Order of the equivalent FFT (the window length is 2^order samples).", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER );
+	FFTOrderAttr->SetDefaultValue(Core::AttributeInt32::Create(mSettings.mFFTOrder));
+	FFTOrderAttr->SetMinValue(Core::AttributeInt32::Create(2));
+	FFTOrderAttr->SetMaxValue(Core::AttributeInt32::Create(20));
+
+	// window step size
+	Core::AttributeSettings* winShiftAttr = RegisterAttribute( "Window Shift", "NumWindowShiftSamples", "The number of samples the input window advances for each output value.", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER );
+	winShiftAttr->SetDefaultValue(Core::AttributeInt32::Create(mSettings.mEpochShift));
+	winShiftAttr->SetMinValue(Core::AttributeInt32::Create(1));
+	winShiftAttr->SetMaxValue(Core::AttributeInt32::Create(1024));
+}
+
+
+void BandPowerNode::ReInit(const Time& elapsed, const Time& delta)
+{
+	if (BaseReInit(elapsed, delta) == false)
+		return;
+
+	// reinit baseclass
+	ProcessorNode::ReInit(elapsed, delta);
+
+	PostReInit(elapsed, delta);
+}
+
+
+void BandPowerNode::Update(const Time& elapsed, const Time& delta)
+{
+	if (BaseUpdate(elapsed, delta) == false)
+		return;
+
+	// update baseclass
+	ProcessorNode::Update(elapsed, delta);
+}
+
+
+// attributes have changed
+void BandPowerNode::OnAttributesChanged()
+{
+	const BandPowerProcessor::EValueType valueType = (BandPowerProcessor::EValueType)GetInt32Attribute(ATTRIB_VALUETYPE);
+	double minFreq = GetFloatAttribute(ATTRIB_MINFREQ);
+	const double maxFreq = GetFloatAttribute(ATTRIB_MAXFREQ);
+	const uint32 fftOrder = GetInt32Attribute(ATTRIB_FFTORDER);
+	const uint32 shiftSteps = GetInt32Attribute(ATTRIB_SHIFTSAMPLES);
+
+	// make sure minfreq < maxFreq
+	if (minFreq > maxFreq)
+	{
+		minFreq = maxFreq;
+		SetFloatAttribute("MinFrequency", minFreq);
+
+		// fire event
+		EMIT_EVENT( OnAttributeUpdated(mParentGraph, this, GetAttributeValue(ATTRIB_MINFREQ)) );
+	}
+
+	// check if settings have changed
+	if (mSettings.mValueType == valueType &&
+		mSettings.mMinFrequency == minFreq &&
+		mSettings.mMaxFrequency == maxFreq &&
+		mSettings.mFFTOrder == fftOrder &&
+		mSettings.mEpochShift == shiftSteps)
+	{
+		return;
+	}
+
+	mSettings.mValueType = valueType;
+	mSettings.mMinFrequency = minFreq;
+	mSettings.mMaxFrequency = maxFreq;
+	mSettings.mFFTOrder = fftOrder;
+	mSettings.mEpochShift = shiftSteps;
+
+	ResetAsync();
+}
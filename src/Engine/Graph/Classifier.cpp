@@ -51,6 +51,9 @@ Classifier::Classifier(Graph* parentNode) : Graph(parentNode)
 	mIsFinalized	= false;
 	mBufferDuration	= 10.0;
 
+	ResetNodeUpdateCounters();
+	mNumSuspendedNodes = 0;
+
 	Core::AttributeSettings* attribInitTime = RegisterAttribute("Init Time (s)", "InitTime", "Required initialization time until classifier is stable.", Core::ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
 	attribInitTime->SetDefaultValue(Core::AttributeFloat::Create(DEFAULTINITTIME));
 	attribInitTime->SetMinValue(Core::AttributeFloat::Create(0.0));
@@ -86,7 +89,8 @@ void Classifier::Update(const Time& elapsed, const Time& delta)
 	// FIXME execute finalize only if something changed (not working correctly, ReinitAsync() is not called at every required action which leaves the classifier partially uninitialized)
 	Finalize(elapsed, delta);
 
-	if (mCreud.Execute() == true)
+	const bool isUpdating = mCreud.Execute();
+	if (isUpdating == true)
 	{
 		/////////////////////////////////////////////////////////////
 		// Phase 2: Update
@@ -97,10 +101,19 @@ void Classifier::Update(const Time& elapsed, const Time& delta)
 		// update all nodes
 		const uint32 numEndNodes = mEndNodes.Size();
 		for (uint32 i = 0; i<numEndNodes; ++i)
+		{
+			// nobody consumes the output of this branch
+			if (mEndNodes[i]->IsSuspended() == true)
+				continue;
+
 			mEndNodes[i]->Update(elapsed, delta);
+			mEndNodes[i]->EndProfilerEvent();
+		}
 	}
 
-	// always update channel activity (but only required for rendering) 
+	// always update channel activity (but only required for rendering) and count the node updates and processor skips of this update
+	mNumNodeUpdates = 0;
+	mNumProcessorSkips = 0;
 	const uint32 numNodes = mNodes.Size();
 	for (uint32 i = 0; i<numNodes; ++i)
 	{
@@ -109,7 +122,16 @@ void Classifier::Update(const Time& elapsed, const Time& delta)
 
 		SPNode* node = static_cast<SPNode*>(mNodes[i]);
 		node->UpdateChannelActivity(delta.InSeconds());
+
+		if (isUpdating == true && node->IsUpdateReady() == true)
+		{
+			mNumNodeUpdates++;
+			mNumProcessorSkips += node->GetNumSkippedProcessors();
+		}
 	}
+
+	mTotalNodeUpdates += mNumNodeUpdates;
+	mTotalProcessorSkips += mNumProcessorSkips;
 	
 	// stop performance timing
 	mFpsCounter.StopTiming();
@@ -120,6 +142,60 @@ void Classifier::Reset()
 {
 	// reset all nodes
 	Graph::Reset();
+
+	ResetNodeUpdateCounters();
+}
+
+
+// demand tracking: suspend all nodes without a path to a consumed sink and resynchronize the ones that are demanded again
+void Classifier::UpdateDemand()
+{
+	const bool isTracking = GetEngine()->IsDemandTrackingEnabled();
+
+	// without demand tracking every node is demanded
+	const uint32 numNodes = mNodes.Size();
+	for (uint32 i=0; i<numNodes; ++i)
+		mNodes[i]->SetDemanded(isTracking == false);
+
+	// walk up from all consumed sinks
+	if (isTracking == true)
+	{
+		const uint32 numEndNodes = mEndNodes.Size();
+		for (uint32 i=0; i<numEndNodes; ++i)
+			if (mEndNodes[i]->IsConsumed() == true)
+				mEndNodes[i]->MarkDemanded();
+	}
+
+	mNumSuspendedNodes = 0;
+	for (uint32 i=0; i<numNodes; ++i)
+	{
+		Node* node = mNodes[i];
+		if (node->IsDemanded() == false)
+		{
+			// clear the outputs of newly suspended nodes, so nobody sees stale values (all nodes behind it are suspended as well)
+			if (node->IsSuspended() == false && node->GetNodeType() != Node::NODE_TYPE)
+				static_cast<SPNode*>(node)->ResetBuffers();
+
+			node->SetSuspended(true);
+			mNumSuspendedNodes++;
+		}
+		else if (node->IsSuspended() == true)
+		{
+			// the node missed all samples while it was suspended: restart it (this also resets its outputs, so its children restart too)
+			node->SetSuspended(false);
+			node->ResetAsync();
+		}
+	}
+}
+
+
+// reset the node update and processor skip counters
+void Classifier::ResetNodeUpdateCounters()
+{
+	mNumNodeUpdates				= 0;
+	mNumProcessorSkips			= 0;
+	mTotalNodeUpdates			= 0;
+	mTotalProcessorSkips		= 0;
 }
 
 void Classifier::ResetOnSessionStart()
@@ -165,6 +241,9 @@ void Classifier::Finalize(const Time& elapsed, const Time& delta)
 	// collect all nodes into lists
 	CollectNodes();
 
+	// suspend or resume branches (before the reinit, so resumed nodes are reset right away)
+	UpdateDemand();
+
 	// reinit nodes
 	ReInit(elapsed, delta);
 
@@ -238,6 +238,23 @@ class ENGINE_API Classifier : public Graph, public Core::EventHandler
 		// number of buffers
 		uint32 CalcNumBufferChannelsUsed() const;
 
+		//
+		// Scheduling
+		//
+
+		// node updates of the last update and the processor updates that were skipped because they could not produce output
+		// (every node is still updated, a skip only saves the work of one processor)
+		uint32 GetNumNodeUpdates() const									{ return mNumNodeUpdates; }
+		uint32 GetNumProcessorSkips() const									{ return mNumProcessorSkips; }
+
+		// node updates and processor skips since the last reset
+		uint64 GetTotalNodeUpdates() const									{ return mTotalNodeUpdates; }
+		uint64 GetTotalProcessorSkips() const								{ return mTotalProcessorSkips; }
+		void ResetNodeUpdateCounters();
+
+		// demand tracking: number of nodes that were suspended because no consumed sink depends on them
+		uint32 GetNumSuspendedNodes() const									{ return mNumSuspendedNodes; }
+
 	
 	protected:
 		// graph internal callback
@@ -272,6 +289,16 @@ class ENGINE_API Classifier : public Graph, public Core::EventHandler
 		bool	mIsPaused;				
 		bool	mIsFinalized;			// true, after finalize() was called, until something is changed
 		double  mBufferDuration;		// number of seconds the buffers can take (also defines the absolute minimum update frequency)
+
+		// node update and processor skip counters
+		uint32	mNumNodeUpdates;
+		uint32	mNumProcessorSkips;
+		uint64	mTotalNodeUpdates;
+		uint64	mTotalProcessorSkips;
+
+		// demand tracking
+		void UpdateDemand();
+		uint32	mNumSuspendedNodes;
 };
 
 
@@ -0,0 +1,552 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "ConnectivityNode.h"
+#include "../Core/Math.h"
+#include "../Core/AttributeFloat.h"
+#include "../Core/AttributeInt32.h"
+#include "../Core/AttributeStringArray.h"
+#include "../EngineManager.h"
+
+
+using namespace Core;
+
+// constructor
+ConnectivityNode::ConnectivityNode(Graph* graph) : SPNode(graph)
+{
+	mWindowPos				= 0;
+	mNumWindowSamples		= 0;
+	mNumHopSamples			= 1;
+	mSamplesUntilUpdate		= 0;
+	mMinBin					= 0;
+	mMaxBin					= 0;
+}
+
+
+// destructor
+ConnectivityNode::~ConnectivityNode()
+{
+	DeleteOutputChannels();
+}
+
+
+// initialize the node
+void ConnectivityNode::Init()
+{
+	// configure SPNode behaviour
+	RequireConstantSampleRate();
+	RequireMatchingSampleRates();
+	RequireInputConnection();
+
+	// SETUP PORTS
+
+	// setup the input ports
+	InitInputPorts(1);
+	GetInputPort(INPUTPORT).Setup("In", "x", AttributeChannels<double>::TYPE_ID, INPUTPORT);
+
+	// setup the output ports (one per measure)
+	InitOutputPorts(CrossSpectrum::NUM_MEASURES);
+	for (uint32 i=0; i<CrossSpectrum::NUM_MEASURES; ++i)
+	{
+		mTempString.Format("y%i", i+1);
+		GetOutputPort(i).SetupAsChannels<double>(CrossSpectrum::GetMeasureName(i), mTempString.AsChar(), i);
+	}
+
+	// ATTRIBUTES
+
+	// frequency bands
+	AttributeSettings* bandsAttr = RegisterAttribute("Bands", "bands", "Frequency bands, by preset name (e.g. 'Alpha') or as a range in Hz (e.g. '8-12').", ATTRIBUTE_INTERFACETYPE_STRINGARRAY);
+	bandsAttr->SetDefaultValue( AttributeStringArray::Create("Alpha") );
+
+	// analysis window
+	AttributeSettings* windowAttr = RegisterAttribute("Window Length", "windowLength", "Length of the analysis window (epoch) in seconds.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	windowAttr->SetDefaultValue( AttributeFloat::Create(1.0) );
+	windowAttr->SetMinValue( AttributeFloat::Create(0.1) );
+	windowAttr->SetMaxValue( AttributeFloat::Create(10.0) );
+
+	AttributeSettings* rateAttr = RegisterAttribute("Update Rate", "updateRate", "Number of epochs per second.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	rateAttr->SetDefaultValue( AttributeFloat::Create(4.0) );
+	rateAttr->SetMinValue( AttributeFloat::Create(0.1) );
+	rateAttr->SetMaxValue( AttributeFloat::Create(100.0) );
+
+	AttributeSettings* smoothingAttr = RegisterAttribute("Smoothing", "smoothing", "Number of epochs the cross-spectra are averaged over.", ATTRIBUTE_INTERFACETYPE_INTSPINNER);
+	smoothingAttr->SetDefaultValue( AttributeInt32::Create(8) );
+	smoothingAttr->SetMinValue( AttributeInt32::Create(1) );
+	smoothingAttr->SetMaxValue( AttributeInt32::Create(1000) );
+
+	// window type
+	AttributeSettings* winFuncAttr = RegisterAttribute("Window Function", "windowFunction", "The Time-Domain Window Function that is applied to each epoch.", ATTRIBUTE_INTERFACETYPE_WINDOWFUNCTION);
+	winFuncAttr->ResizeComboValues( WindowFunction::WINDOWFUNCTION_NUMFUNCTIONS );
+	for (uint32 i = 0; i < WindowFunction::WINDOWFUNCTION_NUMFUNCTIONS; i++)
+		winFuncAttr->SetComboValue(i, WindowFunction::GetName((WindowFunction::EWindowFunction)i));
+	winFuncAttr->SetDefaultValue( AttributeInt32::Create((int32)WindowFunction::WINDOWFUNCTION_HANN) );
+
+	// channel pairs (two lists, so channel names may contain any separator)
+	AttributeSettings* channelsAAttr = RegisterAttribute("Pair Channels A", "pairChannelsA", "First channel of each pair, by name or 1-based index ('*' for all pairs).", ATTRIBUTE_INTERFACETYPE_STRINGARRAY);
+	channelsAAttr->SetDefaultValue( AttributeStringArray::Create("*") );
+
+	AttributeSettings* channelsBAttr = RegisterAttribute("Pair Channels B", "pairChannelsB", "Second channel of each pair, by name or 1-based index (in the same order as the first channels).", ATTRIBUTE_INTERFACETYPE_STRINGARRAY);
+	channelsBAttr->SetDefaultValue( AttributeStringArray::Create("") );
+}
+
+
+// reset everything
+void ConnectivityNode::Reset()
+{
+	SPNode::Reset();
+
+	DeleteOutputChannels();
+}
+
+
+void ConnectivityNode::ReInit(const Time& elapsed, const Time& delta)
+{
+	if (BaseReInit(elapsed, delta) == false)
+		return;
+
+	// reinit baseclass
+	SPNode::ReInit(elapsed, delta);
+
+	if (mIsInitialized == true)
+	{
+		Array<CrossSpectrum::Pair> pairs;
+
+		if (mInputReader.GetNumChannels() < 2)
+		{
+			SetError(ERROR_NUM_CHANNELS, "At least two input channels are required.");
+			mIsInitialized = false;
+		}
+		else
+		{
+			ClearError(ERROR_NUM_CHANNELS);
+		}
+
+		if (mIsInitialized == true && (CollectPairs(pairs) == false || pairs.IsEmpty() == true))
+		{
+			SetError(ERROR_PAIRS, "Channel pairs are invalid or do not match the input channels.");
+			mIsInitialized = false;
+		}
+		else
+		{
+			ClearError(ERROR_PAIRS);
+		}
+
+		Array<Band> bands;
+		if (mIsInitialized == true && (CollectBands(bands) == false || bands.IsEmpty() == true))
+		{
+			SetError(ERROR_BANDS, "Frequency bands are invalid.");
+			mIsInitialized = false;
+		}
+		else
+		{
+			ClearError(ERROR_BANDS);
+		}
+
+		// bands have to start below the Nyquist frequency, the ones reaching above it are cut off
+		if (mIsInitialized == true)
+		{
+			const double nyquistFrequency = mInputReader.GetSampleRate() / 2.0;
+
+			bool isClipped = false;
+			const uint32 numBands = bands.Size();
+			for (uint32 i=0; i<numBands && mIsInitialized == true; ++i)
+			{
+				if (bands[i].mMinFrequency >= nyquistFrequency)
+				{
+					mTempString.Format("Frequency band '%s' lies above the Nyquist frequency (%.1f Hz).", bands[i].mName.AsChar(), nyquistFrequency);
+					SetError(ERROR_BANDS, mTempString.AsChar());
+					mIsInitialized = false;
+				}
+				else if (bands[i].mMaxFrequency > nyquistFrequency)
+				{
+					isClipped = true;
+				}
+			}
+
+			if (isClipped == true)
+			{
+				mTempString.Format("Frequency bands are cut off at the Nyquist frequency (%.1f Hz).", nyquistFrequency);
+				SetWarning(WARNING_BANDS_CLIPPED, mTempString.AsChar());
+			}
+			else
+			{
+				ClearWarning(WARNING_BANDS_CLIPPED);
+			}
+		}
+	}
+
+	PostReInit(elapsed, delta);
+}
+
+
+void ConnectivityNode::Start(const Time& elapsed)
+{
+	const uint32 numChannels = mInputReader.GetNumChannels();
+	const double sampleRate = mInputReader.GetSampleRate();
+
+	// analysis window (even number of samples for the FFT)
+	mNumWindowSamples = Max<uint32>(2, (uint32)(GetFloatAttribute(ATTRIB_WINDOWLENGTH) * sampleRate + 0.5));
+	mNumWindowSamples += mNumWindowSamples % 2;
+	mNumHopSamples = Max<uint32>(1, (uint32)(sampleRate / GetFloatAttribute(ATTRIB_UPDATERATE) + 0.5));
+
+	mWindow.Resize(numChannels * mNumWindowSamples);
+	for (uint32 i=0; i<mWindow.Size(); ++i)
+		mWindow[i] = 0.0;
+	mWindowPos = 0;
+	mSamplesUntilUpdate = mNumWindowSamples;
+
+	// precalculate the window function
+	mFFT.Init(mNumWindowSamples);
+	mWindowFunction.SetType((WindowFunction::EWindowFunction)GetInt32Attribute(ATTRIB_WINDOWFUNCTION));
+	mWindowCoefficients.Resize(mNumWindowSamples);
+	for (uint32 i=0; i<mNumWindowSamples; ++i)
+		mWindowCoefficients[i] = mWindowFunction.Evaluate(i, mNumWindowSamples);
+
+	// frequency bins of the bands
+	const double binWidth = sampleRate / mNumWindowSamples;
+	const uint32 numBins = mNumWindowSamples / 2 + 1;
+	CollectBands(mBands);
+	const uint32 numBands = mBands.Size();
+
+	mMinBin = numBins - 1;
+	mMaxBin = 1;
+	for (uint32 b=0; b<numBands; ++b)
+	{
+		Band& band = mBands[b];
+		// all bins with their center inside the band (without DC, bands above the Nyquist frequency were rejected in ReInit())
+		uint32 minBin = Max<uint32>(1, (uint32)Math::CeilD(band.mMinFrequency / binWidth));
+		uint32 maxBin = Min<uint32>(numBins - 1, (uint32)Math::FloorD(band.mMaxFrequency / binWidth));
+
+		// band narrower than a bin: the bin closest to its center
+		if (minBin > maxBin)
+		{
+			minBin = Clamp<uint32>((uint32)Math::FloorD(0.5 * (band.mMinFrequency + band.mMaxFrequency) / binWidth + 0.5), 1, numBins - 1);
+			maxBin = minBin;
+		}
+
+		band.mFirstBin = minBin;
+		band.mNumBins = maxBin - minBin + 1;
+		mMinBin = Min<uint32>(mMinBin, minBin);
+		mMaxBin = Max<uint32>(mMaxBin, maxBin);
+	}
+
+	mMaxBin = Max<uint32>(mMinBin, mMaxBin);
+	for (uint32 b=0; b<numBands; ++b)
+		mBands[b].mFirstBin -= mMinBin;
+
+	// one cross-spectral matrix from the lowest to the highest band bin, the bands only average different bin ranges of it
+	Array<CrossSpectrum::Pair> pairs;
+	CollectPairs(pairs);
+	mCrossSpectrum.Init(numChannels, mMaxBin - mMinBin + 1, pairs);
+	mCrossSpectrum.SetNumSmoothingEpochs(GetInt32Attribute(ATTRIB_SMOOTHING));
+
+	// create the output channels, one per band, pair and measure (all pairs of the first band, then of the second band ...)
+	const uint32 numPairs = pairs.Size();
+	for (uint32 m=0; m<CrossSpectrum::NUM_MEASURES; ++m)
+	{
+		MultiChannel* outputSet = GetOutputPort(m).GetChannels();
+		CORE_ASSERT(outputSet->GetNumChannels() == 0);
+
+		for (uint32 b=0; b<numBands; ++b)
+		{
+			for (uint32 p=0; p<numPairs; ++p)
+			{
+				mTempString.Format("%s-%s %s", mInputReader.GetChannel(pairs[p].mChannelA)->GetName(), mInputReader.GetChannel(pairs[p].mChannelB)->GetName(), mBands[b].mName.AsChar());
+
+				Channel<double>* channel = new Channel<double>();
+				channel->SetBufferSize(10);
+				channel->SetName(mTempString.AsChar());
+				channel->SetSampleRate(sampleRate / mNumHopSamples);
+				channel->SetMinValue(m == CrossSpectrum::MEASURE_IMAGINARYCOHERENCE ? -1.0 : 0.0);
+				channel->SetMaxValue(1.0);
+				outputSet->AddChannel(channel);
+			}
+		}
+	}
+
+	SPNode::Start(elapsed);
+
+	// the first estimate is available after one full window
+	for (uint32 m=0; m<CrossSpectrum::NUM_MEASURES; ++m)
+	{
+		MultiChannel* outputSet = GetOutputPort(m).GetChannels();
+		const uint32 numOutputs = outputSet->GetNumChannels();
+		for (uint32 i=0; i<numOutputs; ++i)
+		{
+			ChannelBase* channel = outputSet->GetChannel(i);
+			channel->SetStartTime(channel->GetStartTime() + Time(mNumWindowSamples / sampleRate));
+		}
+	}
+}
+
+
+// update the node
+void ConnectivityNode::Update(const Time& elapsed, const Time& delta)
+{
+	if (BaseUpdate(elapsed, delta) == false)
+		return;
+
+	// update the baseclass
+	SPNode::Update(elapsed, delta);
+
+	// do nothing if node is not fully initialized
+	if (mIsInitialized == false)
+		return;
+
+	// consume the inputs in lockstep
+	const uint32 numSamples = mInputReader.GetMinNumNewSamples();
+	const uint32 numChannels = mInputReader.GetNumChannels();
+	const uint32 numPairs = mCrossSpectrum.GetNumPairs();
+	const uint32 numBands = mBands.Size();
+	for (uint32 s=0; s<numSamples; ++s)
+	{
+		for (uint32 c=0; c<numChannels; ++c)
+			mWindow[c * mNumWindowSamples + mWindowPos] = mInputReader.GetReader(c)->PopOldestSample<double>();
+
+		mWindowPos = (mWindowPos + 1) % mNumWindowSamples;
+
+		// wait for the first full window, then add one epoch per hop
+		mSamplesUntilUpdate--;
+		if (mSamplesUntilUpdate > 0)
+			continue;
+
+		mSamplesUntilUpdate = mNumHopSamples;
+
+		CalcSpectra();
+		mCrossSpectrum.AddEpoch();
+
+		// every band averages its bins of the same cross-spectra
+		for (uint32 m=0; m<CrossSpectrum::NUM_MEASURES; ++m)
+		{
+			MultiChannel* outputSet = GetOutputPort(m).GetChannels();
+			for (uint32 b=0; b<numBands; ++b)
+			{
+				const Band& band = mBands[b];
+				for (uint32 p=0; p<numPairs; ++p)
+					outputSet->GetChannel(b * numPairs + p)->AsType<double>()->AddSample( mCrossSpectrum.CalcMeasure((CrossSpectrum::EMeasure)m, p, band.mFirstBin, band.mNumBins) );
+			}
+		}
+	}
+}
+
+
+// one FFT per channel, only the band bins are passed on to the cross-spectrum
+void ConnectivityNode::CalcSpectra()
+{
+	const uint32 numChannels = mCrossSpectrum.GetNumChannels();
+	const uint32 numBandBins = mCrossSpectrum.GetNumBins();
+
+	for (uint32 c=0; c<numChannels; ++c)
+	{
+		// unroll the ring buffer, oldest sample first
+		const double* window = mWindow.GetPtr() + c * mNumWindowSamples;
+		double* input = mFFT.GetInput();
+		for (uint32 i=0; i<mNumWindowSamples; ++i)
+			input[i] = window[(mWindowPos + i) % mNumWindowSamples] * mWindowCoefficients[i];
+
+		mFFT.CalcFFT();
+
+		const Complex* output = mFFT.GetOutput();
+		Complex* spectrum = mCrossSpectrum.GetSpectrum(c);
+		for (uint32 b=0; b<numBandBins; ++b)
+			spectrum[b] = output[mMinBin + b];
+	}
+}
+
+
+// combine the i-th entries of the two pair channel lists to input channel index pairs
+bool ConnectivityNode::CollectPairs(Array<CrossSpectrum::Pair>& outPairs)
+{
+	outPairs.Clear();
+
+	const uint32 numChannels = mInputReader.GetNumChannels();
+	const Array<String>& channelsA = GetStringArrayAttribute(ATTRIB_PAIRCHANNELS_A, Array<String>());
+	const Array<String>& channelsB = GetStringArrayAttribute(ATTRIB_PAIRCHANNELS_B, Array<String>());
+
+	// all pairs
+	if (channelsA.IsEmpty() == true || (channelsA.Size() == 1 && channelsA[0].GetLength() == 1 && channelsA[0].GetFirst() == StringCharacter::asterisk))
+	{
+		for (uint32 a=0; a<numChannels; ++a)
+			for (uint32 b=a+1; b<numChannels; ++b)
+				outPairs.Add( CrossSpectrum::Pair(a, b) );
+
+		return true;
+	}
+
+	if (channelsA.Size() != channelsB.Size())
+		return false;
+
+	bool isValid = true;
+	const uint32 numEntries = channelsA.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		const uint32 channelA = FindInputChannel(channelsA[i]);
+		const uint32 channelB = FindInputChannel(channelsB[i]);
+		if (channelA == CORE_INVALIDINDEX32 || channelB == CORE_INVALIDINDEX32 || channelA == channelB)
+		{
+			isValid = false;
+			continue;
+		}
+
+		outPairs.Add( CrossSpectrum::Pair(channelA, channelB) );
+	}
+
+	return isValid;
+}
+
+
+// find an input channel by name or 1-based index
+uint32 ConnectivityNode::FindInputChannel(const String& nameOrIndex) const
+{
+	String name = nameOrIndex;
+	name.Trim();
+
+	const bool isIndex = name.IsValidInt();
+	const uint32 numChannels = mInputReader.GetNumChannels();
+	for (uint32 c=0; c<numChannels; ++c)
+	{
+		if ((isIndex == true && name.ToInt() == (int)(c+1)) || name.IsEqual(mInputReader.GetChannel(c)->GetName()))
+			return c;
+	}
+
+	return CORE_INVALIDINDEX32;
+}
+
+
+// resolve the bands attribute to frequency ranges
+bool ConnectivityNode::CollectBands(Array<Band>& outBands)
+{
+	outBands.Clear();
+
+	SpectrumAnalyzerSettings* settings = GetEngine()->GetSpectrumAnalyzerSettings();
+	const uint32 numPresets = settings->GetNumFrequencyBands();
+
+	bool isValid = true;
+	const Array<String>& entries = GetStringArrayAttribute(ATTRIB_BANDS, Array<String>());
+	const uint32 numEntries = entries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		Band band;
+		band.mName = entries[i];
+		band.mName.Trim();
+		band.mMinFrequency = -1.0;
+		band.mMaxFrequency = -1.0;
+		band.mFirstBin = 0;
+		band.mNumBins = 0;
+
+		// preset band by name
+		bool isFound = false;
+		for (uint32 p=0; p<numPresets && isFound == false; ++p)
+		{
+			FrequencyBand* preset = settings->GetFrequencyBand(p);
+			if (band.mName.IsEqualNoCase(preset->GetName()) == true)
+			{
+				band.mMinFrequency = preset->GetMinFrequency();
+				band.mMaxFrequency = preset->GetMaxFrequency();
+				isFound = true;
+			}
+		}
+
+		// frequency range in Hz (numbers only, so the dash is unambiguous)
+		if (isFound == false)
+		{
+			Array<String> limits = band.mName.Split(StringCharacter::dash);
+			if (limits.Size() == 2)
+			{
+				limits[0].Trim();
+				limits[1].Trim();
+				if (limits[0].IsValidFloat() == true && limits[1].IsValidFloat() == true)
+				{
+					band.mMinFrequency = limits[0].ToDouble();
+					band.mMaxFrequency = limits[1].ToDouble();
+					isFound = true;
+				}
+			}
+		}
+
+		if (isFound == false || band.mMinFrequency < 0.0 || band.mMaxFrequency < band.mMinFrequency)
+		{
+			isValid = false;
+			continue;
+		}
+
+		outBands.Add(band);
+	}
+
+	return isValid;
+}
+
+
+void ConnectivityNode::DeleteOutputChannels()
+{
+	// delete all output channels
+	const uint32 numOutPorts = GetNumOutputPorts();
+	for (uint32 i=0; i<numOutPorts; ++i)
+	{
+		MultiChannel* outputSet = GetOutputPort(i).GetChannels();
+		if (outputSet == NULL)
+			continue;
+
+		const uint32 numChannels = outputSet->GetNumChannels();
+		for (uint32 c=0; c<numChannels; ++c)
+			delete outputSet->GetChannel(c);
+
+		outputSet->Clear();
+	}
+}
+
+
+// update the data
+void ConnectivityNode::OnAttributesChanged()
+{
+	// restart with new window, bands and pair settings
+	ResetAsync();
+}
+
+
+// node delay: one full analysis window
+double ConnectivityNode::GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const
+{
+	return GetFloatAttribute(ATTRIB_WINDOWLENGTH);
+}
+
+
+Core::String& ConnectivityNode::GetDebugString(Core::String& inout)
+{
+	SPNode::GetDebugString(inout);
+
+	mTempString.Format("Num Pairs: %i\n", mCrossSpectrum.GetNumPairs());
+	inout += mTempString;
+
+	mTempString.Format("Num Bands: %i\n", mBands.Size());
+	inout += mTempString;
+
+	mTempString.Format("Window: %i samples, bins %i-%i\n", mNumWindowSamples, mMinBin, mMaxBin);
+	inout += mTempString;
+
+	return inout;
+}
@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_CONNECTIVITYNODE_H
+#define __NEUROMORE_CONNECTIVITYNODE_H
+
+// include the required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "SPNode.h"
+#include "../DSP/CrossSpectrum.h"
+#include "../DSP/FFT.h"
+#include "../DSP/WindowFunction.h"
+
+
+// band limited connectivity (coherence, imaginary coherence, PLV, wPLI) of all channel pairs or a selection of pairs, for one or more frequency bands
+class ENGINE_API ConnectivityNode : public SPNode
+{
+	public:
+		enum { TYPE_ID = 0x005B };
+		static const char* Uuid () { return "a3c1f6d2-5b8e-4c7a-9e41-2d6f0b8e5c13"; }
+
+		enum
+		{
+			INPUTPORT					= 0,
+			OUTPUTPORT_COHERENCE		= CrossSpectrum::MEASURE_COHERENCE,
+			OUTPUTPORT_IMAGCOHERENCE	= CrossSpectrum::MEASURE_IMAGINARYCOHERENCE,
+			OUTPUTPORT_PLV				= CrossSpectrum::MEASURE_PLV,
+			OUTPUTPORT_WPLI				= CrossSpectrum::MEASURE_WPLI,
+		};
+
+		enum
+		{
+			ATTRIB_BANDS			= 0,
+			ATTRIB_WINDOWLENGTH,
+			ATTRIB_UPDATERATE,
+			ATTRIB_SMOOTHING,
+			ATTRIB_WINDOWFUNCTION,
+			ATTRIB_PAIRCHANNELS_A,
+			ATTRIB_PAIRCHANNELS_B,
+		};
+
+		enum EError
+		{
+			ERROR_NUM_CHANNELS		= GraphObjectError::ERROR_CONFIGURATION | 0x01,
+			ERROR_PAIRS				= GraphObjectError::ERROR_CONFIGURATION | 0x02,
+			ERROR_BANDS				= GraphObjectError::ERROR_CONFIGURATION | 0x03,
+		};
+
+		enum EWarning
+		{
+			WARNING_BANDS_CLIPPED	= GraphObjectWarning::WARNING_CONFIGURATION | 0x01,
+		};
+
+		// constructor & destructor
+		ConnectivityNode(Graph* graph);
+		~ConnectivityNode();
+
+		// initialize & update
+		void Init() override;
+		void Reset() override;
+		void ReInit(const Core::Time& elapsed, const Core::Time& delta) override;
+		void Start(const Core::Time& elapsed) override;
+		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+
+		void OnAttributesChanged() override;
+
+		Core::Color GetColor() const override								{ return Core::RGBA(128,22,255); }
+		uint32 GetType() const override											{ return TYPE_ID; }
+		const char* GetTypeUuid() const override final							{ return Uuid(); }
+		const char* GetReadableType() const override							{ return "Connectivity"; }
+		const char* GetRuleName() const override final							{ return "NODE_Connectivity"; }
+		uint32 GetPaletteCategory() const override								{ return CATEGORY_DSP; }
+		double GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const override;
+		GraphObject* Clone(Graph* graph) override								{ ConnectivityNode* clone = new ConnectivityNode(graph); return clone; }
+
+		Core::String& GetDebugString(Core::String& inout) override;
+
+	private:
+		// frequency band, as a range of bins relative to mMinBin
+		struct Band
+		{
+			Core::String	mName;
+			double			mMinFrequency;
+			double			mMaxFrequency;
+			uint32			mFirstBin;
+			uint32			mNumBins;
+		};
+
+		// combine the two pair channel lists into channel index pairs, returns false if an entry could not be resolved
+		bool CollectPairs(Core::Array<CrossSpectrum::Pair>& outPairs);
+		uint32 FindInputChannel(const Core::String& nameOrIndex) const;
+
+		// parse the bands attribute (preset names or ranges like '8-12'), returns false if an entry could not be parsed
+		bool CollectBands(Core::Array<Band>& outBands);
+
+		void CalcSpectra();
+		void DeleteOutputChannels();
+
+		// sliding window over all channels (ring buffer, one block per channel)
+		Core::Array<double>				mWindow;
+		uint32							mWindowPos;
+		uint32							mNumWindowSamples;
+		uint32							mNumHopSamples;
+		uint32							mSamplesUntilUpdate;
+
+		// one FFT per channel and epoch, the pairs only work on the bins from the lowest to the highest band
+		FFT								mFFT;
+		WindowFunction					mWindowFunction;
+		Core::Array<double>				mWindowCoefficients;
+		CrossSpectrum					mCrossSpectrum;
+		Core::Array<Band>				mBands;				// all bands are averaged from the same cross-spectra
+		uint32							mMinBin;
+		uint32							mMaxBin;
+};
+
+
+#endif
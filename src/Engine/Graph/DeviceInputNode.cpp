@@ -158,6 +158,9 @@ void DeviceInputNode::Start(const Time& elapsed)
 	const uint32 numSensors = mCurrentDevice->GetNumSensors();
 	const bool rawOutputEnabled = GetBoolAttribute(ATTRIB_RAWOUTPUT);
 
+	// the ports were created from the device prototype, a device with more sensors (e.g. a test device with a custom channel count) only gets the ports that exist
+	const uint32 numPorts = GetNumOutputPorts();
+
 	// connect EEG channels to multi channel port if its a neuro headset
 	if (mCurrentDevice->GetBaseType() == BciDevice::BASE_TYPE_ID)
 	{
@@ -177,7 +180,7 @@ void DeviceInputNode::Start(const Time& elapsed)
 		if (headset->ShowNeuroChannels() == true)
 		{
 			// forward all sensors channels to ports
-			for (uint32 i = 0; i < numSensors; ++i)
+			for (uint32 i = 0; i < numSensors && i + 1 < numPorts; ++i)
 			{
 				// get access to the current sensor
 				Sensor* sensor = headset->GetSensor(i);
@@ -196,7 +199,7 @@ void DeviceInputNode::Start(const Time& elapsed)
 		{
 			// forward all non-neuro sensor channels to ports (they come first in the list)
 			int portIndex = 1;
-			for (uint32 i = numNeuroSensors; i < numSensors; ++i)
+			for (uint32 i = numNeuroSensors; i < numSensors && portIndex < (int)numPorts; ++i)
 			{
 				// get access to the current sensor
 				Sensor* sensor = headset->GetSensor(i);
@@ -218,7 +221,7 @@ void DeviceInputNode::Start(const Time& elapsed)
 	else // device is not a neuro headset
 	{
 		// forward all sensors channels to ports
-		for (uint32 i = 0; i<numSensors; ++i)
+		for (uint32 i = 0; i<numSensors && i<numPorts; ++i)
 		{
 			// get access to the current sensor
 			Sensor* sensor = mCurrentDevice->GetSensor(i);
@@ -395,8 +398,8 @@ void DeviceInputNode::UpdateOutputChannelColors()
 	}
 
 	// iterate over all remaining output channels and set a unique color
+	// Note: startIndex can exceed the ports if the device has more sensors than its prototype (the loop is skipped then)
 	const uint32 numOutputs = GetNumOutputPorts();
-	CORE_ASSERT(startIndex <= numOutputs);
 
 	uint32 uniqueIndex = 0;
 
@@ -448,10 +451,10 @@ bool DeviceInputNode::IsSensorUsed(uint32 index)
 		}
 
 		// at last, check if the single-channel port has a connection
-		return GetOutputPort(index + 1).HasConnection();
+		return (index + 1 < GetNumOutputPorts() && GetOutputPort(index + 1).HasConnection());
 	}	
 	else // device is not a neuro headset, has no EEG port
 	{
-		return GetOutputPort(index).HasConnection();
+		return (index < GetNumOutputPorts() && GetOutputPort(index).HasConnection());
 	}
 }
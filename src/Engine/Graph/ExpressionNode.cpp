@@ -0,0 +1,332 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "ExpressionNode.h"
+
+
+using namespace Core;
+
+// constructor
+ExpressionNode::ExpressionNode(Graph* graph) : ProcessorNode(graph, new ExpressionNode::Processor())
+{
+	// default settings
+	mSettings.mExpression = "a";
+	mExpression.Compile(mSettings.mExpression.AsChar(), GetVariableNames());
+}
+
+
+// destructor
+ExpressionNode::~ExpressionNode()
+{
+}
+
+
+// the input ports are the variables a, b, c and d
+const Array<String>& ExpressionNode::GetVariableNames()
+{
+	static Array<String> names;
+	if (names.IsEmpty() == true)
+	{
+		names.Add("a");
+		names.Add("b");
+		names.Add("c");
+		names.Add("d");
+	}
+
+	return names;
+}
+
+
+// initialize the node
+void ExpressionNode::Init()
+{
+	// init base class first
+	ProcessorNode::Init();
+	
+	// SETUP PORTS
+
+	// setup the input ports
+	const Array<String>& variableNames = GetVariableNames();
+	for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+	{
+		mTempString.Format("x%i", i+1);		// is 1-indexed
+		GetInputPort(i).Setup(variableNames[i].AsChar(), mTempString.AsChar(), AttributeChannels<double>::TYPE_ID, PORTID_INPUTPORT_A + i);
+	}
+
+	// setup the output ports
+	GetOutputPort(OUTPUTPORT_RESULT).Setup("Result", "y", AttributeChannels<double>::TYPE_ID, PORTID_OUTPUTPORT_RESULT);
+
+	// SETUP ATTRIBUTES
+
+	// the formula
+	Core::AttributeSettings* expressionParam = RegisterAttribute("Expression", "expression", "Formula over the inputs a, b, c and d, for example log10(a/(b+c)) * 0.5. Supports + - * / ^, parentheses, pi, e and the functions abs, sqrt, exp, log, log10, sin, cos, tan, asin, acos, atan, floor, ceil, sign, min, max and pow.", Core::ATTRIBUTE_INTERFACETYPE_STRING);
+	expressionParam->SetDefaultValue( Core::AttributeString::Create(mSettings.mExpression.AsChar()) );
+}
+
+
+void ExpressionNode::ReInit(const Time& elapsed, const Time& delta)
+{
+	if (BaseReInit(elapsed, delta) == false)
+		return;
+
+	// reinit baseclass
+	ProcessorNode::ReInit(elapsed, delta);
+
+	PostReInit(elapsed, delta);
+
+	// invalid formula
+	if (mExpression.IsValid() == false)
+	{
+		mIsInitialized = false;
+		SetError(ERROR_INVALID_EXPRESSION, mExpression.GetError());
+		return;
+	}
+
+	ClearError(ERROR_INVALID_EXPRESSION);
+
+	// all inputs used by the formula must be connected, and the ones with a fixed sample rate must have the same
+	double sampleRate = 0;
+	const Array<String>& variableNames = GetVariableNames();
+	for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+	{
+		if (mExpression.UsesVariable(i) == false)
+			continue;
+
+		MultiChannel* channels = GetInputPort(i).GetChannels();
+		if (GetInputPort(i).HasConnection() == false || channels == NULL)
+		{
+			mIsInitialized = false;
+			mTempString.Format("Input '%s' is used in the expression but not connected.", variableNames[i].AsChar());
+			SetError(ERROR_MISSING_INPUT, mTempString.AsChar());
+			return;
+		}
+
+		const double inputSampleRate = channels->GetSampleRate();
+		if (inputSampleRate > 0 && sampleRate > 0 && inputSampleRate != sampleRate)
+		{
+			mIsInitialized = false;
+			SetError(ERROR_INPUT_MATCHING_SAMPLERATES, "Input sample rates are incompatible.");
+			return;
+		}
+
+		if (inputSampleRate > 0)
+			sampleRate = inputSampleRate;
+	}
+
+	ClearError(ERROR_MISSING_INPUT);
+	ClearError(ERROR_INPUT_MATCHING_SAMPLERATES);
+}
+
+
+void ExpressionNode::Update(const Time& elapsed, const Time& delta)
+{
+	if (BaseUpdate(elapsed, delta) == false)
+		return;
+
+	// update baseclass
+	ProcessorNode::Update(elapsed, delta);
+}
+
+
+// update the data
+void ExpressionNode::OnAttributesChanged()
+{
+	const char* expression = GetStringAttribute(ATTRIB_EXPRESSION);
+
+	// if it didn't change, don't update anything
+	if (mSettings.mExpression == expression)
+		return;
+
+	mSettings.mExpression = expression;
+
+	// parse once here, the processors get their own copy of the bytecode
+	mExpression.Compile(expression, GetVariableNames());
+
+	// reconfigure processors and restart (the used inputs may have changed)
+	SetupProcessors();
+	ResetAsync();
+}
+
+
+//-----------------------------------------------
+// the node's processor implementation
+//-----------------------------------------------
+
+void ExpressionNode::Processor::Setup(const ChannelProcessor::Settings& settings)
+{
+	mSettings = static_cast<const ProcessorSettings&>(settings);
+	mExpression.Compile(mSettings.mExpression.AsChar(), GetVariableNames());
+
+	for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+		mUsesInput[i] = mExpression.UsesVariable(i);
+}
+
+
+void ExpressionNode::Processor::ReInit()
+{ 
+	// ReInit baseclass
+	ChannelProcessor::ReInit();
+
+	mIsInitialized = false;
+
+	ChannelBase* output = GetOutput();
+	if (output == NULL || mExpression.IsValid() == false)
+		return;
+
+	// the output sample rate is the one of the first used input with a fixed sample rate (zero if there is none)
+	double outputSampleRate = 0;
+	bool haveInput = false;
+	for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+	{
+		ChannelBase* input = GetInput(i);
+		if (input == NULL || mUsesInput[i] == false)
+			continue;
+
+		haveInput = true;
+		if (outputSampleRate == 0 && input->GetSampleRate() > 0)
+			outputSampleRate = input->GetSampleRate();
+	}
+
+	// constant formula: nothing drives the output
+	if (haveInput == false)
+		return;
+
+	output->SetSampleRate(outputSampleRate);
+
+	for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+		mInputValues[i].Resize(MathExpression::BLOCKSIZE);
+	mResults.Resize(MathExpression::BLOCKSIZE);
+
+	mIsInitialized = true;
+}
+
+
+void ExpressionNode::Processor::Update()
+{
+	if (mIsInitialized == false)
+		return;
+			
+	// update base
+	ChannelProcessor::Update();
+
+	Channel<double>* output = GetOutput()->AsType<double>();
+
+
+	//
+	// 1) number of samples we can process: inputs with a fixed sample rate drive the output, non-uniform inputs only provide their last value
+	//
+
+	bool haveUniformInput = false;
+	uint32 numSamplesUniform = CORE_INT32_MAX;
+	uint32 numSamplesNonuniform = CORE_INT32_MAX;
+
+	for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+	{
+		ChannelBase* input = GetInput(i);
+		if (input == NULL)
+			continue;
+
+		// connected but not used by the formula: skip the samples
+		if (mUsesInput[i] == false)
+		{
+			GetInputReader(i)->Flush();
+			continue;
+		}
+
+		const uint32 numNewSamples = GetInputReader(i)->GetNumNewSamples();
+		if (input->GetSampleRate() > 0)
+		{
+			haveUniformInput = true;
+			numSamplesUniform = Min<uint32>(numSamplesUniform, numNewSamples);
+		}
+		else
+			numSamplesNonuniform = Min<uint32>(numSamplesNonuniform, numNewSamples);
+	}
+
+	const uint32 numSamplesOut = (haveUniformInput == true ? numSamplesUniform : numSamplesNonuniform);
+	if (numSamplesOut == CORE_INT32_MAX)
+		return;
+
+
+	//
+	// 2) non-uniform inputs are constant over the block if an uniform input drives the output
+	//
+
+	bool isConstant[NUM_INPUTPORTS];
+	const double* variables[NUM_INPUTPORTS];
+	for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+	{
+		ChannelBase* input = GetInput(i);
+		variables[i] = mInputValues[i].GetPtr();
+		isConstant[i] = false;
+
+		if (mUsesInput[i] == false)
+			continue;
+
+		if (input == NULL || (haveUniformInput == true && input->GetSampleRate() == 0))
+		{
+			isConstant[i] = true;
+
+			double value = 0.0;
+			if (input != NULL && input->GetNumSamples() > 0)
+				value = input->AsType<double>()->GetLastSample();
+
+			for (uint32 s=0; s<MathExpression::BLOCKSIZE; ++s)
+				mInputValues[i][s] = value;
+
+			if (input != NULL)
+				GetInputReader(i)->Flush();
+		}
+	}
+
+
+	//
+	// 3) produce the output samples block by block
+	//
+
+	for (uint32 offset=0; offset<numSamplesOut; offset+=MathExpression::BLOCKSIZE)
+	{
+		const uint32 numSamples = Min<uint32>(MathExpression::BLOCKSIZE, numSamplesOut - offset);
+
+		for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+		{
+			if (mUsesInput[i] == false || isConstant[i] == true)
+				continue;
+
+			ChannelReader* reader = GetInputReader(i);
+			double* values = mInputValues[i].GetPtr();
+			for (uint32 s=0; s<numSamples; ++s)
+				values[s] = reader->PopOldestSample<double>();
+		}
+
+		mExpression.Evaluate(variables, numSamples, mResults.GetPtr());
+
+		for (uint32 s=0; s<numSamples; ++s)
+			output->AddSample(mResults[s]);
+	}
+}
@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+
+#ifndef __NEUROMORE_EXPRESSIONNODE_H
+#define __NEUROMORE_EXPRESSIONNODE_H
+
+// include the required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "ProcessorNode.h"
+#include "../DSP/ChannelProcessor.h"
+#include "../DSP/MathExpression.h"
+
+
+// evaluates a formula over its inputs a, b, c and d, replaces chains of Math1/Math2 nodes
+class ENGINE_API ExpressionNode : public ProcessorNode
+{
+	public:
+		enum { TYPE_ID = 0x005F };
+		static const char* Uuid () { return "2889d3ac-caec-11f1-8a8c-02fc00000001"; }
+
+		//
+		enum
+		{
+			INPUTPORT_A			= 0,
+			INPUTPORT_B			= 1,
+			INPUTPORT_C			= 2,
+			INPUTPORT_D			= 3,
+			NUM_INPUTPORTS		= 4,
+			OUTPUTPORT_RESULT	= 0
+		};
+
+		enum
+		{
+			PORTID_INPUTPORT_A		 = 0,
+			PORTID_INPUTPORT_B		 = 1,
+			PORTID_INPUTPORT_C		 = 2,
+			PORTID_INPUTPORT_D		 = 3,
+			PORTID_OUTPUTPORT_RESULT = 4,
+		};
+
+		enum
+		{
+			ATTRIB_EXPRESSION	= 0
+		};
+
+		enum EError
+		{
+			ERROR_INVALID_EXPRESSION	= GraphObjectError::ERROR_CONFIGURATION | 0x01,
+			ERROR_MISSING_INPUT			= GraphObjectError::ERROR_CONFIGURATION | 0x02,
+		};
+
+		// constructor & destructor
+		ExpressionNode(Graph* graph);
+		~ExpressionNode();
+
+		// initialize
+		void Init() override;
+		void ReInit(const Core::Time& elapsed, const Core::Time& delta) override;
+		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+
+		void OnAttributesChanged() override;
+
+		Core::Color GetColor() const override								{ return Core::RGBA(91,255,250); }
+		uint32 GetType() const override											{ return TYPE_ID; }
+		const char* GetTypeUuid() const override final							{ return Uuid(); }
+		const char* GetReadableType() const override							{ return "Expression"; }
+		const char* GetRuleName() const override final							{ return "NODE_Expression"; }
+		uint32 GetPaletteCategory() const override								{ return CATEGORY_MATH; }
+		GraphObject* Clone(Graph* graph) override								{ ExpressionNode* clone = new ExpressionNode(graph); return clone; }
+
+		const ChannelProcessor::Settings& GetSettings() override				{ return mSettings; }
+
+		// the variable names of the inputs
+		static const Core::Array<Core::String>& GetVariableNames();
+
+	private:
+
+		class ProcessorSettings : public ChannelProcessor::Settings
+		{
+			public:
+				enum { TYPE_ID = 0x005F };
+
+				ProcessorSettings()			 {}
+				virtual ~ProcessorSettings() {}
+			
+				uint32 GetType() const override		{ return TYPE_ID; }
+
+				Core::String	mExpression;
+		};
+
+		ProcessorSettings	mSettings;
+
+		// compiled on attribute change, used for error reporting and to find the used inputs
+		MathExpression		mExpression;
+
+		class Processor : public ChannelProcessor
+		{
+			enum { TYPE_ID = 0x0005F };
+
+			public:
+				Processor() : ChannelProcessor()                                { Init(); for (uint32 i=0; i<NUM_INPUTPORTS; ++i) mUsesInput[i] = false; }
+				~Processor() { }
+
+				uint32 GetType() const override                                 { return TYPE_ID; }
+				ChannelProcessor* Clone() override                              { Processor* clone = new Processor(); clone->Setup(mSettings); return clone; }
+
+				// settings (compiles the expression)
+				void Setup(const ChannelProcessor::Settings& settings) override;
+				virtual const Settings& GetSettings() const override			{ return mSettings; }
+
+				void Init() override
+				{
+					for (uint32 i=0; i<NUM_INPUTPORTS; ++i)
+						AddInput<double>();
+					AddOutput<double>();
+				}
+
+				void ReInit() override;
+				void Update() override;
+
+			private:
+				ProcessorSettings		mSettings;
+				MathExpression			mExpression;
+				bool					mUsesInput[NUM_INPUTPORTS];
+
+				// one block of samples per input and for the results
+				Core::Array<double>		mInputValues[NUM_INPUTPORTS];
+				Core::Array<double>		mResults;
+		};
+
+};
+
+
+#endif
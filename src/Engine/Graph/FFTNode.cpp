@@ -27,6 +27,7 @@
 // include required headers
 #include "FFTNode.h"
 #include "../Core/Math.h"
+#include "../EngineManager.h"
 
 
 using namespace Core;
@@ -45,6 +46,7 @@ FFTNode::FFTNode(Graph* graph) : ProcessorNode(graph, new FFTProcessor())
 // destructor
 FFTNode::~FFTNode()
 {
+	UnregisterProviders();
 }
 
 
@@ -112,6 +114,54 @@ void FFTNode::Update(const Time& elapsed, const Time& delta)
 }
 
 
+// reset node state
+void FFTNode::Reset()
+{
+	UnregisterProviders();
+
+	// reset baseclass (destroys the processors)
+	ProcessorNode::Reset();
+}
+
+
+// create and start the processors
+void FFTNode::Start(const Time& elapsed)
+{
+	UnregisterProviders();
+
+	// start baseclass (recreates the processors)
+	ProcessorNode::Start(elapsed);
+
+	RegisterProviders();
+}
+
+
+void FFTNode::RegisterProviders()
+{
+	SpectrumAnalyzerCache* cache = GetEngine()->GetSpectrumAnalyzerCache();
+
+	const uint32 numProcessors = mProcessors.Size();
+	for (uint32 i=0; i<numProcessors; ++i)
+		if (mProcessors[i]->IsInitialized() == true)
+			cache->RegisterProvider( static_cast<FFTProcessor*>(mProcessors[i]), this );
+}
+
+
+void FFTNode::UnregisterProviders()
+{
+	if (mProcessors.IsEmpty() == true || GetEngine() == NULL)
+		return;
+
+	SpectrumAnalyzerCache* cache = GetEngine()->GetSpectrumAnalyzerCache();
+	if (cache == NULL)
+		return;
+
+	const uint32 numProcessors = mProcessors.Size();
+	for (uint32 i=0; i<numProcessors; ++i)
+		cache->UnregisterProvider( static_cast<FFTProcessor*>(mProcessors[i]) );
+}
+
+
 // attributes have changed
 void FFTNode::OnAttributesChanged()
 {
@@ -67,6 +67,7 @@ class ENGINE_API FFTNode : public ProcessorNode
 		void Init() override;
 		void ReInit(const Core::Time& elapsed, const Core::Time& delta) override;
 		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+		void Reset() override;
 		
 		void OnAttributesChanged() override;
 
@@ -80,7 +81,14 @@ class ENGINE_API FFTNode : public ProcessorNode
 
 		const ChannelProcessor::Settings& GetSettings() override			{ return mSettings; }
 
+	protected:
+		void Start(const Core::Time& elapsed) override;
+
 	private:
+		// offer the processors to the spectrum analyzer cache
+		void RegisterProviders();
+		void UnregisterProviders();
+
 		FFTProcessor::FFTSettings  mSettings;
 
 };
@@ -49,6 +49,9 @@ class ENGINE_API FeedbackNode : public OutputNode
 		virtual void Init() override;
 		virtual void OnAttributesChanged() override;
 
+		// demand tracking: disabled feedback nodes are not consumed
+		bool IsConsumed() const override													{ return IsEnabled(); }
+
 		// OSC
 		virtual void WriteOscMessage(OscPacketParser::OutStream* outStream)					{}
 		bool GetSendOscNetworkMessages() const												{ return GetBoolAttribute(ATTRIB_SENDOSCNETWORKMESSAGES); }
@@ -352,6 +352,13 @@ void FileWriterNode::OnAttributesChanged()
 }
 
 
+// the writer only records while a session is running (Update() does nothing otherwise)
+bool FileWriterNode::IsConsumed() const
+{
+	return GetSession()->IsRunning();
+}
+
+
 bool FileWriterNode::closeFile()
 {
 	if (mFileFormat == ChannelFileWriter::EFormat::FORMAT_CSV_SIMPLE || mFileFormat == ChannelFileWriter::EFormat::FORMAT_CSV_TIMESTAMP) {
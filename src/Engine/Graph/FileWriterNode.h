@@ -70,6 +70,9 @@ class ENGINE_API FileWriterNode : public SPNode
 		
 		void OnAttributesChanged() override;
 
+		// demand tracking: only consumed while a session is recorded
+		bool IsConsumed() const override;
+
 		// node information & helpers
 		Core::Color GetColor() const override									{ return Core::RGBA(122,211,255); }
 		uint32 GetType() const override											{ return TYPE_ID; }
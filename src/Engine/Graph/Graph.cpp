@@ -122,6 +122,7 @@ void Graph::AddNode(Node* node)
 {
 	mNodes.Add(node); 
 	mObjects.Add(node);
+	mNodesByUuid.emplace( node->GetUuidString().Lowered(), node );
 	node->SetParent(this);
 
 	// graph callback
@@ -164,6 +165,23 @@ bool Graph::RemoveNode(Node* node)
 	// delete the node from the array
 	mNodes.Remove( index );
 	mObjects.RemoveByValue(node);
+
+	// remove it from the uuid index (and let a remaining node with the same uuid take its place)
+	auto uuidIter = mNodesByUuid.find( nodeToRemove->GetUuidString().Lowered() );
+	if (uuidIter != mNodesByUuid.end() && uuidIter->second == nodeToRemove)
+	{
+		mNodesByUuid.erase( uuidIter );
+
+		const uint32 numNodes = mNodes.Size();
+		for (uint32 i=0; i<numNodes; ++i)
+		{
+			if (mNodes[i]->GetUuidString().IsEqualNoCase(nodeToRemove->GetUuid()))
+			{
+				mNodesByUuid.emplace( mNodes[i]->GetUuidString().Lowered(), mNodes[i] );
+				break;
+			}
+		}
+	}
 	// TODO remove from child graph list if node is a graph
 
 	// delete the node from memory
@@ -204,13 +222,32 @@ Node* Graph::FindNodeByName(const char* name, const uint32 typeId)
 
 Node* Graph::FindNodeByUuid(const char* uuid)
 {
-	// get the number of nodes and iterate through them
-	const uint32 numNodes = mNodes.Size();
-	for (uint32 i=0; i<numNodes; ++i)
+	// look up the node in the uuid index
+	String key = uuid;
+	key.ToLower();
+
+	auto iter = mNodesByUuid.find( key );
+	if (iter != mNodesByUuid.end() && iter->second->GetUuidString().IsEqualNoCase(uuid))
+		return iter->second;
+
+	// failure, return NULL pointer
+	return NULL;
+}
+
+
+// find any graph object by uuid
+GraphObject* Graph::FindObjectByUuid(const char* uuid)
+{
+	// nodes are indexed
+	Node* node = FindNodeByUuid(uuid);
+	if (node != NULL)
+		return node;
+
+	const uint32 numObjects = mObjects.Size();
+	for (uint32 i=0; i<numObjects; ++i)
 	{
-		// compare the node name with the parameter and return a pointer to the node in case they are equal
-		if (mNodes[i]->GetUuidString().IsEqualNoCase(uuid))
-			return mNodes[i];
+		if (mObjects[i]->GetUuidString().IsEqualNoCase(uuid) == true)
+			return mObjects[i];
 	}
 
 	// failure, return NULL pointer
@@ -218,6 +255,62 @@ Node* Graph::FindNodeByUuid(const char* uuid)
 }
 
 
+// keep the uuid index in sync with the node uuids
+void Graph::OnObjectUuidChanged(GraphObject* object, const Core::String& oldUuid)
+{
+	// the index is case insensitive
+	if (object->GetUuidString().IsEqualNoCase(oldUuid) == true)
+		return;
+
+	const String oldKey = oldUuid.Lowered();
+	Node* node = NULL;
+
+	auto iter = mNodesByUuid.find( oldKey );
+	if (iter != mNodesByUuid.end() && iter->second == object)
+	{
+		node = iter->second;
+
+		// release the old uuid and let a remaining node with the same uuid take its place (like RemoveNode() does)
+		mNodesByUuid.erase( iter );
+
+		const uint32 numNodes = mNodes.Size();
+		for (uint32 i=0; i<numNodes; ++i)
+		{
+			if (mNodes[i] != node && mNodes[i]->GetUuidString().IsEqualNoCase(oldUuid))
+			{
+				mNodesByUuid.emplace( oldKey, mNodes[i] );
+				break;
+			}
+		}
+	}
+	else
+	{
+		// not indexed: only a node that shared its uuid with another one (or no node of this graph at all)
+		const uint32 numNodes = mNodes.Size();
+		for (uint32 i=0; i<numNodes && node == NULL; ++i)
+		{
+			if (mNodes[i] == object)
+				node = mNodes[i];
+		}
+
+		if (node == NULL)
+			return;
+	}
+
+	// the new uuid already belongs to another node: leave this one out of the index, it gets indexed once the other one releases the uuid
+	const String newKey = node->GetUuidString().Lowered();
+	auto newIter = mNodesByUuid.find( newKey );
+	if (newIter != mNodesByUuid.end())
+	{
+		if (newIter->second != node)
+			LogError( "Graph::OnObjectUuidChanged(): Node '%s' in graph '%s' got the uuid %s of node '%s'. Only the other node can be found by this uuid.", node->GetName(), GetName(), node->GetUuid(), newIter->second->GetName() );
+		return;
+	}
+
+	mNodesByUuid.emplace( newKey, node );
+}
+
+
 /**
  * Find node index by name. This will only iterate through the nodes and isn't a recursive process.
  * @param[in] name The name of the node to search.
@@ -329,7 +422,7 @@ Connection* Graph::AddConnection(Node* sourceNode, uint32 sourcePortNr, Node* ta
 bool Graph::AddConnection(Connection* connection)
 {
 	// create the connection and add it to the graph
-	mConnections.Add(connection);
+	InsertConnection(connection);
 	mObjects.Add(connection);
 
 	// graph callbacks
@@ -368,6 +461,12 @@ void Graph::RemoveConnection(Connection* connection)
 	mConnections.Remove(index);
 	mObjects.RemoveByValue(connection);
 
+	// the connections behind the removed one moved down by one
+	mConnectionIndices.erase(connection);
+	const uint32 numConnections = mConnections.Size();
+	for (uint32 i=index; i<numConnections; ++i)
+		mConnectionIndices[mConnections[i]] = i;
+
 	delete connection;
 
 	// graph callback
@@ -384,14 +483,50 @@ void Graph::RemoveConnection(Connection* connection)
 // remove all connections connected to a node
 void Graph::RemoveConnectionsUsingNode(const Node* node)
 {
-	for (uint32 i=0; i<mConnections.Size();)
+	// collect them first, removing a connection unlinks it from the port lists we are iterating
+	Array<Connection*> connections;
+
+	const uint32 numInputPorts = node->GetNumInputPorts();
+	for (uint32 p=0; p<numInputPorts; ++p)
+	{
+		const InputPort& port = node->GetInputPort(p);
+		const uint32 numPortConnections = port.GetNumConnection();
+		for (uint32 c=0; c<numPortConnections; ++c)
+			connections.Add( port.GetConnection(c) );
+	}
+
+	const uint32 numOutputPorts = node->GetNumOutputPorts();
+	for (uint32 p=0; p<numOutputPorts; ++p)
 	{
-		// if this connection comes from the specified node, delete it 
-		if (mConnections[i]->GetSourceNode() == node || mConnections[i]->GetTargetNode() == node)
-			RemoveConnection(mConnections[i]);
-		else
-			i++;
+		const OutputPort& port = node->GetOutputPort(p);
+		const uint32 numPortConnections = port.GetNumConnection();
+		for (uint32 c=0; c<numPortConnections; ++c)
+			connections.Add( port.GetConnection(c) );
 	}
+
+	const uint32 numConnections = connections.Size();
+	for (uint32 i=0; i<numConnections; ++i)
+		if (HasConnection(connections[i]) == true)
+			RemoveConnection(connections[i]);
+}
+
+
+// add the connection to the connection array and the index
+void Graph::InsertConnection(Connection* connection)
+{
+	mConnectionIndices[connection] = mConnections.Size();
+	mConnections.Add(connection);
+}
+
+
+// find the index of the connection inside the connection array
+uint32 Graph::FindConnectionIndex(const Connection* connection) const
+{
+	auto iter = mConnectionIndices.find(connection);
+	if (iter == mConnectionIndices.end())
+		return CORE_INVALIDINDEX32;
+
+	return iter->second;
 }
 
 
@@ -404,10 +539,17 @@ void Graph::RemoveConnectionsUsingNode(const Node* node)
  */
 Connection* Graph::FindConnection(const Node* sourceNode, uint16 sourcePort, uint16 targetPort) const
 {
-	const uint32 numConnections = mConnections.Size();
+	if (sourcePort >= sourceNode->GetNumOutputPorts())
+		return NULL;
+
+	const OutputPort& port = sourceNode->GetOutputPort(sourcePort);
+	const uint32 numConnections = port.GetNumConnection();
 	for (uint32 i=0; i<numConnections; ++i)
-		if (mConnections[i]->GetSourceNode() == sourceNode && mConnections[i]->GetSourcePort() == sourcePort && mConnections[i]->GetTargetPort() == targetPort)
-			return mConnections[i];
+	{
+		Connection* connection = port.GetConnection(i);
+		if (connection->GetTargetPort() == targetPort && HasConnection(connection) == true)
+			return connection;
+	}
 
 	return NULL;
 }
@@ -416,62 +558,48 @@ Connection* Graph::FindConnection(const Node* sourceNode, uint16 sourcePort, uin
 // find the number of connections arriving at a given node and port
 uint32 Graph::CalcNumInputConnections(const Node* targetNode, uint16 targetPort) const
 {
-	uint32 count = 0;
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i = 0; i<numConnections; ++i)
-		if (mConnections[i]->GetTargetNode() == targetNode && mConnections[i]->GetTargetPort() == targetPort)
-			count++;
+	if (targetPort >= targetNode->GetNumInputPorts())
+		return 0;
 
-	return count;
+	return targetNode->GetInputPort(targetPort).GetNumConnection();
 }
 
 
 // find a given connection going to a given node and port
 uint32 Graph::FindInputConnection(const Node* targetNode, uint16 targetPort, uint32 index) const
 {
-	uint32 currentIndex = 0;
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i=0; i<numConnections; ++i)
-		if (mConnections[i]->GetTargetNode() == targetNode && mConnections[i]->GetTargetPort() == targetPort)
-		{
-			if (currentIndex == index)
-				return i;
-			else
-				currentIndex++;
-		}
+	if (targetPort >= targetNode->GetNumInputPorts())
+		return CORE_INVALIDINDEX32;
 
-	return CORE_INVALIDINDEX32;
+	const InputPort& port = targetNode->GetInputPort(targetPort);
+	if (index >= port.GetNumConnection())
+		return CORE_INVALIDINDEX32;
+
+	return FindConnectionIndex( port.GetConnection(index) );
 }
 
 
 // find the number of connections originating at a given node and port
 uint32 Graph::CalcNumOutputConnections(const Node* sourceNode, uint16 sourcePort) const
 {
-	uint32 count = 0;
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i=0; i<numConnections; ++i)
-		if (mConnections[i]->GetSourceNode() == sourceNode && mConnections[i]->GetSourcePort() == sourcePort)
-			count++;
+	if (sourcePort >= sourceNode->GetNumOutputPorts())
+		return 0;
 
-	return count;
+	return sourceNode->GetOutputPort(sourcePort).GetNumConnection();
 }
 
 
 // find a given connection originating at a given node and port
 uint32 Graph::FindOutputConnection(const Node* sourceNode, uint16 sourcePort, uint32 index) const
 {
-	uint32 currentIndex = 0;
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i=0; i<numConnections; ++i)
-		if (mConnections[i]->GetSourceNode() == sourceNode && mConnections[i]->GetSourcePort() == sourcePort)
-		{
-			if (currentIndex == index)
-				return i;
-			else
-				currentIndex++;
-		}
-	
-	return CORE_INVALIDINDEX32;
+	if (sourcePort >= sourceNode->GetNumOutputPorts())
+		return CORE_INVALIDINDEX32;
+
+	const OutputPort& port = sourceNode->GetOutputPort(sourcePort);
+	if (index >= port.GetNumConnection())
+		return CORE_INVALIDINDEX32;
+
+	return FindConnectionIndex( port.GetConnection(index) );
 }
 
 
@@ -480,14 +608,10 @@ uint32 Graph::CalcNumInputConnections(const Node* node) const
 {
 	uint32 result = 0;
 
-	// get the number of connections and iterate through them
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i = 0; i<numConnections; ++i)
-	{
-		Connection* connection = mConnections[i];
-		if (connection->GetTargetNode() == node)
-			result++;
-	}
+	// sum up the connections of all input ports
+	const uint32 numPorts = node->GetNumInputPorts();
+	for (uint32 i=0; i<numPorts; ++i)
+		result += node->GetInputPort(i).GetNumConnection();
 
 	return result;
 }
@@ -496,16 +620,16 @@ uint32 Graph::CalcNumInputConnections(const Node* node) const
 // find a given connection going into a given node (independent from ports; unordered)
 uint32 Graph::FindInputConnection(const Node* targetNode, uint32 index) const
 {
-	uint32 currentIndex = 0;
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i = 0; i<numConnections; ++i)
-		if (mConnections[i]->GetTargetNode() == targetNode)
-		{
-			if (currentIndex == index)
-				return i;
-			else
-				currentIndex++;
-		}
+	const uint32 numPorts = targetNode->GetNumInputPorts();
+	for (uint32 i=0; i<numPorts; ++i)
+	{
+		const InputPort& port = targetNode->GetInputPort(i);
+		const uint32 numConnections = port.GetNumConnection();
+		if (index < numConnections)
+			return FindConnectionIndex( port.GetConnection(index) );
+
+		index -= numConnections;
+	}
 
 	return CORE_INVALIDINDEX32;
 }
@@ -516,14 +640,10 @@ uint32 Graph::CalcNumOutputConnections(const Node* node) const
 {
 	uint32 result = 0;
 
-	// get the number of connections and iterate through them
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i=0; i<numConnections; ++i)
-	{
-		Connection* connection = mConnections[i];
-		if (connection->GetSourceNode() == node)
-			result++;
-	}
+	// sum up the connections of all output ports
+	const uint32 numPorts = node->GetNumOutputPorts();
+	for (uint32 i=0; i<numPorts; ++i)
+		result += node->GetOutputPort(i).GetNumConnection();
 
 	return result;
 }
@@ -532,31 +652,25 @@ uint32 Graph::CalcNumOutputConnections(const Node* node) const
 // find a connection going out of a node (access them independent from the ports as an unordered list)
 uint32 Graph::FindOutputConnection(const Node* sourceNode, uint32 index) const
 {
-	uint32 currentIndex = 0;
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i = 0; i<numConnections; ++i)
-		if (mConnections[i]->GetSourceNode() == sourceNode)
-		{
-			if (currentIndex == index)
-				return i;
-			else
-				currentIndex++;
-		}
+	const uint32 numPorts = sourceNode->GetNumOutputPorts();
+	for (uint32 i=0; i<numPorts; ++i)
+	{
+		const OutputPort& port = sourceNode->GetOutputPort(i);
+		const uint32 numConnections = port.GetNumConnection();
+		if (index < numConnections)
+			return FindConnectionIndex( port.GetConnection(index) );
+
+		index -= numConnections;
+	}
 
 	return CORE_INVALIDINDEX32;
 }
 
 
 // does this node has a specific connection?
-bool Graph::HasConnection(Connection* connection) const
+bool Graph::HasConnection(const Connection* connection) const
 {
-	// for all input connections
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i=0; i<numConnections; ++i)
-		if (mConnections[i] == connection)
-			return true;
-
-	return false;
+	return mConnectionIndices.find(connection) != mConnectionIndices.end();
 }
 
 
@@ -576,40 +690,20 @@ bool Graph::ValidateConnections() const
 // check if the given port already has a connection plugged in
 bool Graph::HasInputConnection(const Node* targetNode, uint32 targetPortNr) const
 {
-	// get the number of connections and iterate through them
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i=0; i<numConnections; ++i)
-	{
-		// get the current connection and check if the connection is connected to the given port
-		Connection* connection = mConnections[i];
-
-		// check if the connection properties are equal
-		if (connection->GetTargetNode() == targetNode && connection->GetTargetPort() == targetPortNr)
-			return true;
-	}
+	if (targetPortNr >= targetNode->GetNumInputPorts())
+		return false;
 
-	// failure, connection not found
-	return false;
+	return targetNode->GetInputPort(targetPortNr).HasConnection();
 }
 
 
 // check if the given port already has a connection plugged in
 bool Graph::HasOutputConnection(const Node* sourceNode, uint32 sourcePortNr) const
 {
-	// get the number of connections and iterate through them
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i = 0; i<numConnections; ++i)
-	{
-		// get the current connection and check if the connection is connected to the given port
-		Connection* connection = mConnections[i];
-
-		// check if the connection properties are equal
-		if (connection->GetSourceNode() == sourceNode && connection->GetSourcePort() == sourcePortNr)
-			return true;
-	}
+	if (sourcePortNr >= sourceNode->GetNumOutputPorts())
+		return false;
 
-	// failure, connection not found
-	return false;
+	return sourceNode->GetOutputPort(sourcePortNr).HasConnection();
 }
 
 
@@ -617,12 +711,13 @@ bool Graph::HasOutputConnection(const Node* sourceNode, uint32 sourcePortNr) con
 void Graph::ResetOutputConnections(const Node* node)
 {
 	// reset all connections that originate at this node
-	const uint32 numConnections = mConnections.Size();
-	for (uint32 i = 0; i<numConnections; ++i)
+	const uint32 numPorts = node->GetNumOutputPorts();
+	for (uint32 i=0; i<numPorts; ++i)
 	{
-		Connection* connection = mConnections[i];
-		if (connection->GetSourceNode() == node)
-			connection->Reset();
+		const OutputPort& port = node->GetOutputPort(i);
+		const uint32 numConnections = port.GetNumConnection();
+		for (uint32 c=0; c<numConnections; ++c)
+			port.GetConnection(c)->Reset();
 	}
 }
 
@@ -780,7 +875,10 @@ void Graph::ResetUpdateReadyFlags()
 	// get the number of nodes, iterate through them and reset their update ready flag
 	const uint32 numNodes = mNodes.Size();
 	for (uint32 i=0; i<numNodes; ++i)
+	{
 		mNodes[i]->SetUpdateReady(false);
+		mNodes[i]->SetNumSkippedProcessors(0);
+	}
 
 	// TODO recurse into child graphs
 }
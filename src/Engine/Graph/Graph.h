@@ -31,6 +31,7 @@
 #include "GraphObject.h"
 #include "GraphSettings.h"
 #include "Node.h"
+#include <unordered_map>
 
 
 class ENGINE_API Graph : public GraphObject
@@ -85,9 +86,13 @@ class ENGINE_API Graph : public GraphObject
 		// node search helpers
 		Node* FindNodeByName(const char* name, const uint32 typeId=0);
 		Node* FindNodeByUuid(const char* uuid);
+		GraphObject* FindObjectByUuid(const char* uuid);			// any graph object (nodes, connections and the objects of derived graphs)
 		uint32 FindNodeIndexByName(const char* name) const;
 		uint32 FindNodeIndex(Node* node) const;
 
+		// keeps the uuid index up to date (called by GraphObject::SetUuid())
+		void OnObjectUuidChanged(GraphObject* object, const Core::String& oldUuid);
+
 		// node helpers
 		void CollectNodesOfType(uint32 nodeTypeID, Core::Array<Node*>* outNodes);	// note: outNodes is NOT cleared internally, nodes are added to the array
 
@@ -118,9 +123,9 @@ class ENGINE_API Graph : public GraphObject
 		virtual void RemoveConnectionsUsingNode(const Node* source);
 
 		// search connections
-		bool HasConnection(Connection* connection) const;
+		bool HasConnection(const Connection* connection) const;
 		Connection* FindConnection(const Node* sourceNode, uint16 sourcePort, uint16 targetPort) const;
-		inline uint32 FindConnectionIndex(Connection* connection) const										{ return mConnections.Find( connection ); }
+		uint32 FindConnectionIndex(const Connection* connection) const;
 		
 		// search incoming connections (by port)
 		bool HasInputConnection(const Node* targetNode, uint32 targetPort) const;
@@ -175,9 +180,14 @@ class ENGINE_API Graph : public GraphObject
 		bool SaveNodes(Core::Json& json, Core::Json::Item& item);
 		bool SaveConnections(Core::Json& json, Core::Json::Item& item);
 
+		// adds the connection to the connection array and keeps the index up to date
+		void InsertConnection(Connection* connection);
+
 	protected:
 		Core::Array<Node*>			mNodes;				// all nodes 
+		std::unordered_map<Core::String, Node*, Core::StringHasher> mNodesByUuid;	// lowercased uuid -> node, for fast lookups while loading large graphs
 		Core::Array<Connection*>	mConnections;		// all connections
+		std::unordered_map<const Connection*, uint32> mConnectionIndices;	// connection -> index in mConnections, the per-port connection lists resolve to graph indices through this
 		Core::Array<Graph*>			mGraphs;			// all nested graphs (which are also present in mNodes)
 
 		Core::Array<GraphObject*>	mObjects;			// references to all graph objects (includes all the objects above and everything the derived class uses, e.g. state machine action)
@@ -68,9 +68,9 @@ bool GraphImporter::LoadFromString(const char* jsonString, Graph* rootNode)
 {
 	Timer loadTimer;
 
-	// parse our file
+	// parse our file (in-situ, the json doesn't leave this function)
 	Json json;
-	if (json.Parse(jsonString) == false)
+	if (json.ParseInsitu(jsonString) == false)
 	{
 		LogWarning("GraphImporter::LoadFromString(): JSON parser failed.");
 		return false;
@@ -26,6 +26,7 @@
 
 // include required headers
 #include "GraphObject.h"
+#include "Graph.h"
 #include "../Core/AttributeSettings.h"
 #include "../Core/Counter.h"
 #include "../EngineManager.h"
@@ -85,7 +86,12 @@ const String& GraphObject::GetNameString() const
 // set the uuid
 void GraphObject::SetUuid(const char* uuid)
 { 
+	const String oldUuid = mUuid;
 	mUuid = uuid;
+
+	// let the parent graph update its uuid index
+	if (mParentGraph != NULL)
+		mParentGraph->OnObjectUuidChanged(this, oldUuid);
 }
 
 
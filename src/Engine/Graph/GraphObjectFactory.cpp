@@ -71,6 +71,7 @@
 #include "Math2Node.h"
 #include "StatisticsNode.h"
 #include "ChannelMathNode.h"
+#include "ExpressionNode.h"
 #ifndef PRODUCTION_BUILD
   #include "PairwiseMathNode.h"
 #endif
@@ -85,6 +86,10 @@
 #include "BinSelectorNode.h"
 #include "OscillatorNode.h"
 #include "WaveformNode.h"
+#include "ConnectivityNode.h"
+#include "PSDNode.h"
+#include "WaveletNode.h"
+#include "BandPowerNode.h"
 
 #ifdef INCLUDE_NODE_COHERENCE
   #include <Graph/CoherenceNode.h>
@@ -201,6 +206,7 @@ GraphObjectFactory::GraphObjectFactory()
 		RegisterObjectType( new LogicNode(NULL) );
 		RegisterObjectType( new RemapNode(NULL) );
 		RegisterObjectType( new ChannelMathNode(NULL) );
+		RegisterObjectType( new ExpressionNode(NULL) );
 		RegisterObjectType( new StatisticsNode(NULL) );
 #ifndef PRODUCTION_BUILD
 		RegisterObjectType( new PairwiseMathNode(NULL) );
@@ -209,6 +215,7 @@ GraphObjectFactory::GraphObjectFactory()
 
 		// DSP nodes
 		RegisterObjectType( new FFTNode(NULL) );
+		RegisterObjectType( new PSDNode(NULL) );
 		RegisterObjectType( new LinearFilterNode(NULL) );
 		RegisterObjectType( new FrequencyBandNode(NULL) );
 		RegisterObjectType( new DominantFrequencyNode(NULL) );
@@ -216,6 +223,9 @@ GraphObjectFactory::GraphObjectFactory()
 		RegisterObjectType( new BinSelectorNode(NULL) );
 		RegisterObjectType( new OscillatorNode(NULL) );
 		RegisterObjectType( new WaveformNode(NULL) );
+		RegisterObjectType( new ConnectivityNode(NULL) );
+		RegisterObjectType( new WaveletNode(NULL) );
+		RegisterObjectType( new BandPowerNode(NULL) );
 
 #ifdef INCLUDE_NODE_COHERENCE
 		RegisterObjectType( new CoherenceNode(NULL) );
@@ -27,8 +27,9 @@
 // include required headers
 #include "LoretaNode.h"
 #include "../Core/Math.h"
+#include "../Core/AttributeFloat.h"
+#include "../Core/AttributeInt32.h"
 #include "../EngineManager.h"
-#include "../DSP/Spectrum.h"
 
 
 using namespace Core;
@@ -36,6 +37,18 @@ using namespace Core;
 // constructor
 LoretaNode::LoretaNode(Graph* graph) : SPNode(graph)
 {
+	mSolverGridResolution	= 0;
+	mSolverRegularization	= 0.0;
+	mWindowPos				= 0;
+	mNumWindowSamples		= 0;
+	mNumHopSamples			= 1;
+	mSamplesUntilUpdate		= 0;
+	mMinBin					= 0;
+	mMaxBin					= 0;
+	mPowerScale				= 0.0;
+
+	for (uint32 i=0; i<SLoretaSolver::NUM_REGIONS; ++i)
+		mRegionPower[i] = 0.0;
 }
 
 
@@ -48,6 +61,10 @@ LoretaNode::~LoretaNode()
 // initialize the node
 void LoretaNode::Init()
 {
+	// configure SPNode behaviour
+	RequireConstantSampleRate();
+	RequireMatchingSampleRates();
+	RequireInputConnection();
 
 	// SETUP PORTS
 	
@@ -55,13 +72,50 @@ void LoretaNode::Init()
 	InitInputPorts(1);
 	GetInputPort(INPUTPORT).Setup("EEG", "x", AttributeChannels<double>::TYPE_ID, INPUTPORT);
 
+	// setup the output ports
+	InitOutputPorts(1);
+	GetOutputPort(OUTPUTPORT).SetupAsChannels<double>("ROI Power", "y", OUTPUTPORT);
+
+	for (uint32 i=0; i<SLoretaSolver::NUM_REGIONS; ++i)
+	{
+		mRegionChannels[i].SetName( SLoretaSolver::GetRegionName(i) );
+		mRegionChannels[i].SetBufferSize(10);
+	}
+
 	// ATTRIBUTES
 
-	//Core::AttributeSettings* functionParam = RegisterAttribute("Math Function", "mathFunction", "The math function to use.", ATTRIBUTE_INTERFACETYPE_COMBOBOX);
-	//functionParam->ResizeComboValues( (uint32)MATHFUNCTION_NUMFUNCTIONS );
-	//for (uint32 i=0; i<MATHFUNCTION_NUMFUNCTIONS; ++i)
-	//	functionParam->SetComboValue( i, GetFunctionString((EMathFunction)i) );
-	//functionParam->SetDefaultValue( Core::AttributeInt32::Create(mSettings.mMathFunction) );
+	// frequency band
+	AttributeSettings* minFreqAttr = RegisterAttribute("Lower Frequency", "minFrequency", "The lower bound of the frequency band.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	minFreqAttr->SetDefaultValue( AttributeFloat::Create(8.0) );
+	minFreqAttr->SetMinValue( AttributeFloat::Create(0.0) );
+	minFreqAttr->SetMaxValue( AttributeFloat::Create(FLT_MAX) );
+
+	AttributeSettings* maxFreqAttr = RegisterAttribute("Upper Frequency", "maxFrequency", "The upper bound of the frequency band.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	maxFreqAttr->SetDefaultValue( AttributeFloat::Create(12.0) );
+	maxFreqAttr->SetMinValue( AttributeFloat::Create(0.0) );
+	maxFreqAttr->SetMaxValue( AttributeFloat::Create(FLT_MAX) );
+
+	// analysis window
+	AttributeSettings* windowAttr = RegisterAttribute("Window Length", "windowLength", "Length of the analysis window in seconds.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	windowAttr->SetDefaultValue( AttributeFloat::Create(1.0) );
+	windowAttr->SetMinValue( AttributeFloat::Create(0.1) );
+	windowAttr->SetMaxValue( AttributeFloat::Create(10.0) );
+
+	AttributeSettings* rateAttr = RegisterAttribute("Update Rate", "updateRate", "Number of source estimates per second.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	rateAttr->SetDefaultValue( AttributeFloat::Create(10.0) );
+	rateAttr->SetMinValue( AttributeFloat::Create(0.1) );
+	rateAttr->SetMaxValue( AttributeFloat::Create(100.0) );
+
+	// head model
+	AttributeSettings* regAttr = RegisterAttribute("Regularization", "regularization", "Tikhonov regularization of the inverse solution, relative to the mean lead field power.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	regAttr->SetDefaultValue( AttributeFloat::Create(0.05) );
+	regAttr->SetMinValue( AttributeFloat::Create(0.0) );
+	regAttr->SetMaxValue( AttributeFloat::Create(10.0) );
+
+	AttributeSettings* gridAttr = RegisterAttribute("Grid Resolution", "gridResolution", "Number of voxels along the diameter of the brain sphere.", ATTRIBUTE_INTERFACETYPE_INTSPINNER);
+	gridAttr->SetDefaultValue( AttributeInt32::Create(24) );
+	gridAttr->SetMinValue( AttributeInt32::Create(4) );
+	gridAttr->SetMaxValue( AttributeInt32::Create(40) );
 }
 
 // reset everything
@@ -70,7 +124,11 @@ void LoretaNode::Reset()
 	SPNode::Reset();
 
 	mChannels.Clear();
+	mReaderIndices.Clear();
 	mElectrodes.Clear();
+
+	// clear output channel set (but not delete channels)
+	GetOutputPort(OUTPUTPORT).GetChannels()->Clear();
 }
 
 void LoretaNode::ReInit(const Time& elapsed, const Time& delta)
@@ -81,15 +139,111 @@ void LoretaNode::ReInit(const Time& elapsed, const Time& delta)
 	// reinit baseclass
 	SPNode::ReInit(elapsed, delta);
 
+	// the inverse solution needs at least three electrodes (average reference)
+	if (mIsInitialized == true)
+	{
+		CollectElectrodeChannels();
+		if (mChannels.GetNumChannels() < 3)
+		{
+			SetError(ERROR_NUM_ELECTRODES, "At least three channels named like electrodes are required.");
+			mIsInitialized = false;
+		}
+		else
+		{
+			ClearError(ERROR_NUM_ELECTRODES);
+		}
+	}
+
+	// the band has to start below the Nyquist frequency, if it reaches above it is cut off
+	if (mIsInitialized == true)
+	{
+		const double nyquistFrequency = mInputReader.GetSampleRate() / 2.0;
+		if (GetFloatAttribute(ATTRIB_MINFREQUENCY) >= nyquistFrequency)
+		{
+			mTempString.Format("The frequency band lies above the Nyquist frequency (%.1f Hz).", nyquistFrequency);
+			SetError(ERROR_FREQUENCY_BAND, mTempString.AsChar());
+			mIsInitialized = false;
+		}
+		else
+		{
+			ClearError(ERROR_FREQUENCY_BAND);
+		}
+
+		if (mIsInitialized == true && GetFloatAttribute(ATTRIB_MAXFREQUENCY) > nyquistFrequency)
+		{
+			mTempString.Format("The frequency band is cut off at the Nyquist frequency (%.1f Hz).", nyquistFrequency);
+			SetWarning(WARNING_BAND_CLIPPED, mTempString.AsChar());
+		}
+		else
+		{
+			ClearWarning(WARNING_BAND_CLIPPED);
+		}
+	}
+
 	PostReInit(elapsed, delta);
 }
 
 
 void LoretaNode::Start(const Time& elapsed)
 {
+	CollectElectrodeChannels();
+	InitSolver();
+
+	const uint32 numElectrodes = mChannels.GetNumChannels();
+	const double sampleRate = mInputReader.GetSampleRate();
+
+	// analysis window (even number of samples for the FFT)
+	mNumWindowSamples = Max<uint32>(2, (uint32)(GetFloatAttribute(ATTRIB_WINDOWLENGTH) * sampleRate + 0.5));
+	mNumWindowSamples += mNumWindowSamples % 2;
+	mNumHopSamples = Max<uint32>(1, (uint32)(sampleRate / GetFloatAttribute(ATTRIB_UPDATERATE) + 0.5));
+
+	mWindow.setZero(numElectrodes, mNumWindowSamples);
+	mWindowPos = 0;
+	mSamplesUntilUpdate = mNumWindowSamples;
+
+	// hann window, normalized so the band power matches the power of the band limited signal
+	mFFT.Init(mNumWindowSamples);
+	mWindowFunction.SetType(WindowFunction::WINDOWFUNCTION_HANN);
+	mWindowCoefficients.Resize(mNumWindowSamples);
+	double windowPower = 0.0;
+	for (uint32 i=0; i<mNumWindowSamples; ++i)
+	{
+		mWindowCoefficients[i] = mWindowFunction.Evaluate(i, mNumWindowSamples);
+		windowPower += mWindowCoefficients[i] * mWindowCoefficients[i];
+	}
+	mPowerScale = 2.0 / (mNumWindowSamples * windowPower);
+
+	// all bins with their center inside the band (without DC, a band above the Nyquist frequency was rejected in ReInit())
+	const double minFrequency = GetFloatAttribute(ATTRIB_MINFREQUENCY);
+	const double maxFrequency = GetFloatAttribute(ATTRIB_MAXFREQUENCY);
+	const double binWidth = sampleRate / mNumWindowSamples;
+	const uint32 numBins = mNumWindowSamples / 2 + 1;
+	mMinBin = Max<uint32>(1, (uint32)Math::CeilD(minFrequency / binWidth));
+	mMaxBin = Min<uint32>(numBins - 1, (uint32)Math::FloorD(maxFrequency / binWidth));
+
+	// band narrower than a bin: the bin closest to its center
+	if (mMinBin > mMaxBin)
+	{
+		mMinBin = Clamp<uint32>((uint32)Math::FloorD(0.5 * (minFrequency + maxFrequency) / binWidth + 0.5), 1, numBins - 1);
+		mMaxBin = mMinBin;
+	}
+
+	mBandSpectrum.resize(numElectrodes, mMaxBin - mMinBin + 1);
+	mCovariance.setZero(numElectrodes, numElectrodes);
+
+	// one output sample per hop
+	MultiChannel* outputSet = GetOutputPort(OUTPUTPORT).GetChannels();
+	for (uint32 i=0; i<SLoretaSolver::NUM_REGIONS; ++i)
+	{
+		mRegionChannels[i].SetSampleRate(sampleRate / mNumHopSamples);
+		outputSet->AddChannel(&mRegionChannels[i]);
+	}
+
 	SPNode::Start(elapsed);
 
-	CollectElectrodeChannels();
+	// the first estimate is available after one full window
+	for (uint32 i=0; i<SLoretaSolver::NUM_REGIONS; ++i)
+		mRegionChannels[i].SetStartTime(mRegionChannels[i].GetStartTime() + Time(mNumWindowSamples / sampleRate));
 }
 
 
@@ -101,14 +255,120 @@ void LoretaNode::Update(const Time& elapsed, const Time& delta)
 
 	// update the baseclass
 	SPNode::Update(elapsed, delta);
+
+	// do nothing if node is not fully initialized
+	if (mIsInitialized == false)
+		return;
+
+	if (mSolver.IsInitialized() == false)
+	{
+		mInputReader.Flush();
+		return;
+	}
+
+	// consume the inputs in lockstep, channels that are not mapped to electrodes are dropped
+	const uint32 numSamples = mInputReader.GetMinNumNewSamples();
+	const uint32 numElectrodes = mReaderIndices.Size();
+	for (uint32 s=0; s<numSamples; ++s)
+	{
+		for (uint32 e=0; e<numElectrodes; ++e)
+			mWindow(e, mWindowPos) = mInputReader.GetReader(mReaderIndices[e])->PopOldestSample<double>();
+
+		mWindowPos = (mWindowPos + 1) % mNumWindowSamples;
+
+		// wait for the first full window, then estimate once per hop
+		mSamplesUntilUpdate--;
+		if (mSamplesUntilUpdate > 0)
+			continue;
+
+		mSamplesUntilUpdate = mNumHopSamples;
+
+		CalcBandCovariance();
+		mSolver.CalcRegionPower(mCovariance, mRegionPower);
+
+		for (uint32 i=0; i<SLoretaSolver::NUM_REGIONS; ++i)
+			mRegionChannels[i].AddSample(mRegionPower[i]);
+	}
+
+	// drop samples of channels that are not used
+	const uint32 numChannels = mInputReader.GetNumChannels();
+	for (uint32 i=0; i<numChannels; ++i)
+	{
+		if (mReaderIndices.Contains(i) == false)
+			mInputReader.GetReader(i)->Flush();
+	}
 }
 
 
+// band limited cross-spectrum of the current window (real part, as power)
+void LoretaNode::CalcBandCovariance()
+{
+	const uint32 numElectrodes = mReaderIndices.Size();
+	const uint32 numBandBins = mMaxBin - mMinBin + 1;
+
+	for (uint32 e=0; e<numElectrodes; ++e)
+	{
+		// unroll the ring buffer, oldest sample first
+		double* input = mFFT.GetInput();
+		for (uint32 i=0; i<mNumWindowSamples; ++i)
+			input[i] = mWindow(e, (mWindowPos + i) % mNumWindowSamples) * mWindowCoefficients[i];
+
+		mFFT.CalcFFT();
+
+		const Complex* output = mFFT.GetOutput();
+		for (uint32 b=0; b<numBandBins; ++b)
+			mBandSpectrum(e, b) = std::complex<double>(output[mMinBin + b].mReal, output[mMinBin + b].mImag);
+	}
+
+	mCovariance.noalias() = (mBandSpectrum * mBandSpectrum.adjoint()).real() * mPowerScale;
+}
+
 
 // update the data
 void LoretaNode::OnAttributesChanged()
 {
-	// nothing yet
+	// restart with new window and head model settings
+	ResetAsync();
+}
+
+
+// node delay: one full analysis window
+double LoretaNode::GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const
+{
+	return GetFloatAttribute(ATTRIB_WINDOWLENGTH);
+}
+
+
+// build the inverse solution, unless the montage and the head model settings did not change
+void LoretaNode::InitSolver()
+{
+	const uint32 gridResolution = GetInt32Attribute(ATTRIB_GRIDRESOLUTION);
+	const double regularization = GetFloatAttribute(ATTRIB_REGULARIZATION);
+	const uint32 numElectrodes = mElectrodes.Size();
+
+	bool hasChanged = (mSolver.IsInitialized() == false || mSolverMontage.Size() != numElectrodes || mSolverGridResolution != gridResolution || mSolverRegularization != regularization);
+	for (uint32 i=0; i<numElectrodes && hasChanged == false; ++i)
+		hasChanged = (mSolverMontage[i] != mElectrodes[i].GetNameString());
+
+	if (hasChanged == false)
+		return;
+
+	// electrode positions in head coordinates (x = right, y = front, z = up)
+	Array<Vector3> positions;
+	positions.Resize(numElectrodes);
+	mSolverMontage.Resize(numElectrodes);
+	for (uint32 i=0; i<numElectrodes; ++i)
+	{
+		const Vector3 position = GetEngine()->GetEEGElectrodes()->Get3DPosition(1.0, mElectrodes[i]);
+		positions[i] = Vector3(-position.x, -position.y, position.z);
+		mSolverMontage[i] = mElectrodes[i].GetNameString();
+	}
+
+	mSolverGridResolution = gridResolution;
+	mSolverRegularization = regularization;
+
+	if (mSolver.Init(positions, gridResolution, regularization) == false)
+		LogError("LoretaNode::InitSolver(): Cannot create the inverse solution for %i electrodes.", numElectrodes);
 }
 
 
@@ -116,6 +376,7 @@ void LoretaNode::OnAttributesChanged()
 void LoretaNode::CollectElectrodeChannels()
 {
 	mChannels.Clear();
+	mReaderIndices.Clear();
 	mElectrodes.Clear();
 
 	// 0) handle special cases
@@ -143,6 +404,7 @@ void LoretaNode::CollectElectrodeChannels()
 
 			// add channel and the electrode to our list
 			mChannels.AddChannel(channel);
+			mReaderIndices.Add(i);
 			mElectrodes.Add(electrode);
 		}
 		else
@@ -166,6 +428,12 @@ Core::String& LoretaNode::GetDebugString(Core::String& inout)
 	const uint32 numChannels = GetNumChannels();
 	mTempString.Format("Num Channels: %i\n", numChannels);
 	inout += mTempString;
+
+	mTempString.Format("Num Voxels: %i\n", mSolver.GetNumVoxels());
+	inout += mTempString;
+
+	mTempString.Format("Window: %i samples, bins %i-%i\n", mNumWindowSamples, mMinBin, mMaxBin);
+	inout += mTempString;
 		
 	return inout;
 }
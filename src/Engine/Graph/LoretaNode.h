@@ -29,6 +29,9 @@
 #include "../Core/StandardHeaders.h"
 #include "SPNode.h"
 #include "../EEGElectrodes.h"
+#include "../DSP/SLoretaSolver.h"
+#include "../DSP/FFT.h"
+#include "../DSP/WindowFunction.h"
 
 
 class ENGINE_API LoretaNode : public SPNode
@@ -41,16 +44,29 @@ class ENGINE_API LoretaNode : public SPNode
 		enum
 		{
 			INPUTPORT	= 0,
+			OUTPUTPORT	= 0,
 		};
 
-		/*enum
+		enum
 		{
-			ATTRIB_FOOBAR	= 0,
-		};*/
+			ATTRIB_MINFREQUENCY		= 0,
+			ATTRIB_MAXFREQUENCY,
+			ATTRIB_WINDOWLENGTH,
+			ATTRIB_UPDATERATE,
+			ATTRIB_REGULARIZATION,
+			ATTRIB_GRIDRESOLUTION,
+		};
 
 		enum EError
 		{
 			ERROR_ELECTRODE_NAMES	= GraphObjectError::ERROR_CONFIGURATION | 0x01,
+			ERROR_NUM_ELECTRODES	= GraphObjectError::ERROR_CONFIGURATION | 0x02,
+			ERROR_FREQUENCY_BAND	= GraphObjectError::ERROR_CONFIGURATION | 0x03,
+		};
+
+		enum EWarning
+		{
+			WARNING_BAND_CLIPPED	= GraphObjectWarning::WARNING_CONFIGURATION | 0x01,
 		};
 
 		// constructor & destructor
@@ -74,6 +90,7 @@ class ENGINE_API LoretaNode : public SPNode
 		const char* GetReadableType() const override							{ return "sLORETA"; }
 		const char* GetRuleName() const override final							{ return "NODE_Loreta"; }
 		uint32 GetPaletteCategory() const override								{ return CATEGORY_MATH; }
+		double GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const override;
 		GraphObject* Clone(Graph* graph) override								{ LoretaNode* clone = new LoretaNode(graph); return clone; }
 
 		// get the selected channels and the electrodes they belong to
@@ -81,16 +98,48 @@ class ENGINE_API LoretaNode : public SPNode
 		Channel<double>* GetChannel(uint32 index)								{ return static_cast<Channel<double>*>(mChannels.GetChannel(index)); /* cast is OK because channel is under control of the node itself */ }
 		const EEGElectrodes::Electrode& GetElectrode(uint32 index) const		{ return mElectrodes[index]; }
 
+		// the precomputed inverse solution
+		const SLoretaSolver& GetSolver() const									{ return mSolver; }
+
 		Core::String& GetDebugString(Core::String& inout) override;
 
 	private:
+		void InitSolver();
+		void CalcBandCovariance();
 
 		// the channels the loreta algorithm will use
 		MultiChannel							mChannels;
+		Core::Array<uint32>						mReaderIndices;		// input reader index of each channel
 
 		// one electrode per channel
 		Core::Array<EEGElectrodes::Electrode>	mElectrodes;
 
+		// inverse solution, only rebuilt if the montage or the head model settings change
+		SLoretaSolver							mSolver;
+		Core::Array<Core::String>				mSolverMontage;
+		uint32									mSolverGridResolution;
+		double									mSolverRegularization;
+
+		// sliding window over all electrodes (ring buffer, one row per electrode)
+		Eigen::MatrixXd							mWindow;
+		uint32									mWindowPos;
+		uint32									mNumWindowSamples;
+		uint32									mNumHopSamples;
+		uint32									mSamplesUntilUpdate;
+
+		// band limited cross-spectrum of the current window
+		FFT										mFFT;
+		WindowFunction							mWindowFunction;
+		Core::Array<double>						mWindowCoefficients;
+		Eigen::MatrixXcd						mBandSpectrum;		// E x numBins
+		Eigen::MatrixXd							mCovariance;		// E x E
+		uint32									mMinBin;
+		uint32									mMaxBin;
+		double									mPowerScale;
+
+		// one output channel per region
+		Channel<double>							mRegionChannels[SLoretaSolver::NUM_REGIONS];
+		double									mRegionPower[SLoretaSolver::NUM_REGIONS];
 };
 
 
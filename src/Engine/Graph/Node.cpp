@@ -41,8 +41,12 @@ Node::Node(Graph* parentGraph) : GraphObject(parentGraph)
 	mPosY				= 0;
 	mCollapsedState		= COLLAPSE_NONE;
 	mIsUpdateReady		= false;
+	mNumSkippedProcessors = 0;
+	mIsDemanded			= true;
+	mIsSuspended		= false;
 	mIsFirstUpdateReady = true;
 	mIsInitialized		= false;
+	mProfilerScopeID	= CORE_INVALIDINDEX32;
 
 	Reset();
 }
@@ -51,6 +55,9 @@ Node::Node(Graph* parentGraph) : GraphObject(parentGraph)
 // destructor
 Node::~Node()
 {
+	// the scope id can be handed out to another node
+	if (mProfilerScopeID != CORE_INVALIDINDEX32 && GetEngine() != NULL)
+		GetEngine()->GetProfiler().UnregisterScope(mProfilerScopeID);
 }
 
 
@@ -99,6 +106,9 @@ void Node::SetName(const char* name)
 	// actually set the name
 	GraphObject::SetName(name);
 
+	if (mProfilerScopeID != CORE_INVALIDINDEX32)
+		GetEngine()->GetProfiler().SetScopeName( mProfilerScopeID, name );
+
 	if (mParentGraph != NULL)
 		mParentGraph->OnRenamedNode( mParentGraph, this, oldName );
 	
@@ -169,7 +179,7 @@ uint32 Node::FindOutputPortByID(uint32 portID) const
 void Node::RemoveInputPort(uint32 index)
 {
 	// find and remove incoming connection (if any)
-	uint32 conIndex = mParentGraph->FindInputConnection(this, index);
+	uint32 conIndex = mParentGraph->FindInputConnection(this, (uint16)index, 0);
 	if (conIndex != CORE_INVALIDINDEX32)
 		mParentGraph->RemoveConnection(mParentGraph->GetConnection(conIndex));
 
@@ -299,7 +309,30 @@ void Node::UpdateAllIncomingNodes(const Time& elapsed, const Time& delta)
 	{
 		Connection* connection = mInputPorts[i].GetConnection();
 		if (connection != NULL)
-			connection->GetSourceNode()->Update(elapsed, delta);
+		{
+			Node* sourceNode = connection->GetSourceNode();
+			sourceNode->Update(elapsed, delta);
+			sourceNode->EndProfilerEvent();
+		}
+	}
+}
+
+
+// demand tracking: mark this node and all nodes on its inputs as demanded
+void Node::MarkDemanded()
+{
+	// already visited via another path
+	if (mIsDemanded == true)
+		return;
+
+	mIsDemanded = true;
+
+	const uint32 numPorts = mInputPorts.Size();
+	for (uint32 i=0; i<numPorts; ++i)
+	{
+		Connection* connection = mInputPorts[i].GetConnection();
+		if (connection != NULL)
+			connection->GetSourceNode()->MarkDemanded();
 	}
 }
 
@@ -322,10 +355,36 @@ bool Node::BaseUpdate(const Time& elapsed, const Time& delta)
 
 	// update all inputs
 	UpdateAllIncomingNodes(elapsed, delta);
+
+	// measure only the node's own work, the inputs have their own events
+	GetEngine()->GetProfiler().Begin(mProfilerMarker);
 	return true;
 }
 
 
+// close the profiler event opened in BaseUpdate()
+void Node::EndProfilerEvent()
+{
+	if (mProfilerMarker.mIsOpen == false)
+		return;
+
+	uint32 numSamplesIn, numSamplesOut;
+	CountProfilerSamples( numSamplesIn, numSamplesOut );
+
+	GetEngine()->GetProfiler().End( mProfilerMarker, GetProfilerScopeID(), CORE_INVALIDINDEX32, numSamplesIn, numSamplesOut );
+}
+
+
+// get the profiler scope of this node, registers it on first use
+uint32 Node::GetProfilerScopeID()
+{
+	if (mProfilerScopeID == CORE_INVALIDINDEX32)
+		mProfilerScopeID = GetEngine()->GetProfiler().RegisterScope( GetName(), GetReadableType() );
+
+	return mProfilerScopeID;
+}
+
+
 // recursive reinit
 bool Node::BaseReInit(const Time& elapsed, const Time& delta)
 {
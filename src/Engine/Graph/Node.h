@@ -27,6 +27,7 @@
 // include the required headers
 #include "../Config.h"
 #include "../Core/EventSource.h"
+#include "../Core/Profiler.h"
 #include "GraphObject.h"
 #include "Connection.h"
 #include "StateTransition.h"
@@ -63,8 +64,27 @@ class ENGINE_API Node : public GraphObject
 		bool IsReInitReady() const												{ return mIsReInitReady; }
 		void SetReInitReady(bool isReady)										{ mIsReInitReady = isReady; }
 
+		// number of processors the last Update() skipped because they could not produce any output (the node itself was still updated)
+		inline uint32 GetNumSkippedProcessors() const							{ return mNumSkippedProcessors; }
+		inline void SetNumSkippedProcessors(uint32 numSkipped)					{ mNumSkippedProcessors = numSkipped; }
+
+		// demand tracking: sinks report if their output is currently consumed (e.g. an open view or a running recording)
+		virtual bool IsConsumed() const											{ return true; }
+		void MarkDemanded();													// marks this node and all its input nodes
+		inline bool IsDemanded() const											{ return mIsDemanded; }
+		inline void SetDemanded(bool isDemanded)								{ mIsDemanded = isDemanded; }
+
+		// suspended nodes have no path to a consumed sink and are not updated, their outputs are cleared when they get suspended
+		inline bool IsSuspended() const											{ return mIsSuspended; }
+		inline void SetSuspended(bool isSuspended)								{ mIsSuspended = isSuspended; }
+
 		bool IsInitialized() const												{ return mIsInitialized; }
 
+		// profiling: BaseUpdate() opens the event of this node (after all inputs were updated), the caller of Update() closes it
+		void EndProfilerEvent();
+		uint32 GetProfilerScopeID();
+		virtual void CountProfilerSamples(uint32& outNumSamplesIn, uint32& outNumSamplesOut) const	{ outNumSamplesIn = 0; outNumSamplesOut = 0; }
+
 		// Async reset forces a node reset during the next ReInit() call. Node will startup immediately, if it can.
 		void ResetAsync()														{ mDoAsyncReset = true; }
 
@@ -92,6 +112,7 @@ class ENGINE_API Node : public GraphObject
 
 		inline uint32 GetNumInputPorts() const									{ return mInputPorts.Size(); }
 		inline InputPort& GetInputPort(uint32 index)							{ return mInputPorts[index]; }
+		inline const InputPort& GetInputPort(uint32 index) const				{ return mInputPorts[index]; }
 
 		// adding input ports
 		void InitInputPorts(uint32 numPorts);
@@ -113,6 +134,7 @@ class ENGINE_API Node : public GraphObject
 
 		inline uint32 GetNumOutputPorts() const									{ return mOutputPorts.Size(); }
 		inline OutputPort& GetOutputPort(uint32 index) 							{ return mOutputPorts[index]; }
+		inline const OutputPort& GetOutputPort(uint32 index) const				{ return mOutputPorts[index]; }
 
 		// adding output ports
 		void InitOutputPorts(uint32 numPorts);
@@ -174,8 +196,15 @@ class ENGINE_API Node : public GraphObject
 
 		// temporal tree traversal flag
 		bool					mIsUpdateReady;
+		uint32					mNumSkippedProcessors;
 		bool					mIsReInitReady;
+		bool					mIsDemanded;
+		bool					mIsSuspended;
 		bool					mIsFirstUpdateReady;
+
+		// profiling
+		Core::Profiler::Marker	mProfilerMarker;
+		uint32					mProfilerScopeID;
 };
 
 
@@ -104,6 +104,7 @@ class ENGINE_API OscillatorNode : public ProcessorNode
 				void ReInit() override;
 				void Update() override;
 				void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+				bool IsClockDriven() const override								{ return true; }
 
 				// settings
 				class Settings : public ChannelProcessor::Settings
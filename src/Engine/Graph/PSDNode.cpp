@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "PSDNode.h"
+#include "../Core/Math.h"
+
+
+using namespace Core;
+
+// constructor
+PSDNode::PSDNode(Graph* graph) : ProcessorNode(graph, new PSDProcessor())
+{
+	// default values
+	mSettings.mMethod = PSDProcessor::METHOD_WELCH;
+	mSettings.mFFTOrder = 8;
+	mSettings.mOverlap = 0.5;
+	mSettings.mNumSegments = 8;
+	mSettings.mWindowFunction.SetType(WindowFunction::WINDOWFUNCTION_HANN);
+	mSettings.mTimeBandwidth = 3.0;
+	mSettings.mNumTapers = 5;
+}
+
+
+// destructor
+PSDNode::~PSDNode()
+{
+}
+
+
+// initialize the node
+void PSDNode::Init()
+{
+	// init base class first
+	ProcessorNode::Init();
+
+	// CONFIG SPNODE
+	RequireConstantSampleRate();
+
+	// SETUP PORTS
+
+	GetInputPort(INPUTPORT_CHANNEL).Setup("In", "x", AttributeChannels<double>::TYPE_ID, PORTID_INPUT_SAMPLE);
+	GetOutputPort(OUTPUTPORT_SPECTRUM).Setup("Out (Spectrum)", "y", AttributeChannels<Spectrum>::TYPE_ID, PORTID_OUTPUT_SPECTRUM);
+
+	// SETUP ATTRIBUTES
+
+	// estimation method
+	Core::AttributeSettings* methodAttr = RegisterAttribute( "Method", "method", "Welch: average of windowed, overlapping segments. Multitaper: average of DPSS tapered spectra of each segment.", Core::ATTRIBUTE_INTERFACETYPE_COMBOBOX );
+	methodAttr->ResizeComboValues( PSDProcessor::NUM_METHODS );
+	for (uint32 i = 0; i < PSDProcessor::NUM_METHODS; i++)
+		methodAttr->SetComboValue(i, PSDProcessor::GetMethodName(i));
+	methodAttr->SetDefaultValue(Core::AttributeInt32::Create((int32)mSettings.mMethod));
+
+	// segment length
+	Core::AttributeSettings* FFTOrderAttr = RegisterAttribute( "FFT Order", "FFTorder", "Order of the FFT (the segment length is 2^order samples).", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER );
+	FFTOrderAttr->SetDefaultValue(Core::AttributeInt32::Create(mSettings.mFFTOrder));
+	FFTOrderAttr->SetMinValue(Core::AttributeInt32::Create(2));
+	FFTOrderAttr->SetMaxValue(Core::AttributeInt32::Create(16));
+
+	// segment overlap
+	Core::AttributeSettings* overlapAttr = RegisterAttribute( "Overlap", "overlap", "Overlap of successive segments in percent. A new spectrum is output for each segment.", Core::ATTRIBUTE_INTERFACETYPE_FLOATSPINNER );
+	overlapAttr->SetDefaultValue(Core::AttributeFloat::Create(mSettings.mOverlap * 100.0));
+	overlapAttr->SetMinValue(Core::AttributeFloat::Create(0.0));
+	overlapAttr->SetMaxValue(Core::AttributeFloat::Create(95.0));
+
+	// number of averaged segments
+	Core::AttributeSettings* numSegmentsAttr = RegisterAttribute( "Segments", "numSegments", "Number of segments that are averaged.", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER );
+	numSegmentsAttr->SetDefaultValue(Core::AttributeInt32::Create(mSettings.mNumSegments));
+	numSegmentsAttr->SetMinValue(Core::AttributeInt32::Create(1));
+	numSegmentsAttr->SetMaxValue(Core::AttributeInt32::Create(1024));
+
+	// window type (welch)
+	Core::AttributeSettings* winFuncAttr = RegisterAttribute( "Window Function", "WindowFunction", "The Time-Domain Window Function that is applied to each segment (Welch only).", Core::ATTRIBUTE_INTERFACETYPE_WINDOWFUNCTION );
+	winFuncAttr->ResizeComboValues( WindowFunction::WINDOWFUNCTION_NUMFUNCTIONS );
+	for (uint32 i = 0; i < WindowFunction::WINDOWFUNCTION_NUMFUNCTIONS; i++)
+		winFuncAttr->SetComboValue(i, WindowFunction::GetName((WindowFunction::EWindowFunction)i));
+	winFuncAttr->SetDefaultValue(Core::AttributeInt32::Create((uint32)mSettings.mWindowFunction.GetType()));
+
+	// tapers (multitaper)
+	Core::AttributeSettings* bandwidthAttr = RegisterAttribute( "Time-Bandwidth", "timeBandwidth", "Time-half-bandwidth product NW of the DPSS tapers (Multitaper only).", Core::ATTRIBUTE_INTERFACETYPE_FLOATSPINNER );
+	bandwidthAttr->SetDefaultValue(Core::AttributeFloat::Create(mSettings.mTimeBandwidth));
+	bandwidthAttr->SetMinValue(Core::AttributeFloat::Create(1.0));
+	bandwidthAttr->SetMaxValue(Core::AttributeFloat::Create(20.0));
+
+	Core::AttributeSettings* numTapersAttr = RegisterAttribute( "Tapers", "numTapers", "Number of DPSS tapers, usually 2NW-1 (Multitaper only).", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER );
+	numTapersAttr->SetDefaultValue(Core::AttributeInt32::Create(mSettings.mNumTapers));
+	numTapersAttr->SetMinValue(Core::AttributeInt32::Create(1));
+	numTapersAttr->SetMaxValue(Core::AttributeInt32::Create(40));
+}
+
+
+void PSDNode::ReInit(const Time& elapsed, const Time& delta)
+{
+	if (BaseReInit(elapsed, delta) == false)
+		return;
+
+	// reinit baseclass
+	ProcessorNode::ReInit(elapsed, delta);
+
+	PostReInit(elapsed, delta);
+}
+
+
+void PSDNode::Update(const Time& elapsed, const Time& delta)
+{
+	if (BaseUpdate(elapsed, delta) == false)
+		return;
+
+	// update baseclass
+	ProcessorNode::Update(elapsed, delta);
+}
+
+
+// attributes have changed
+void PSDNode::OnAttributesChanged()
+{
+	const PSDProcessor::EMethod method = (PSDProcessor::EMethod)GetInt32Attribute(ATTRIB_METHOD);
+	const uint32 fftOrder = GetInt32Attribute(ATTRIB_FFTORDER);
+	const double overlap = GetFloatAttribute(ATTRIB_OVERLAP) / 100.0;
+	const uint32 numSegments = GetInt32Attribute(ATTRIB_NUMSEGMENTS);
+	const WindowFunction::EWindowFunction windowFunction = (WindowFunction::EWindowFunction)GetInt32Attribute(ATTRIB_WINDOWFUNCTION);
+	const double timeBandwidth = GetFloatAttribute(ATTRIB_TIMEBANDWIDTH);
+	const uint32 numTapers = GetInt32Attribute(ATTRIB_NUMTAPERS);
+
+	// check if settings have changed
+	if (mSettings.mMethod == method &&
+		mSettings.mFFTOrder == fftOrder &&
+		mSettings.mOverlap == overlap &&
+		mSettings.mNumSegments == numSegments &&
+		mSettings.mWindowFunction.GetType() == windowFunction &&
+		mSettings.mTimeBandwidth == timeBandwidth &&
+		mSettings.mNumTapers == numTapers)
+	{
+		return;
+	}
+
+	mSettings.mMethod = method;
+	mSettings.mFFTOrder = fftOrder;
+	mSettings.mOverlap = overlap;
+	mSettings.mNumSegments = numSegments;
+	mSettings.mWindowFunction.SetType(windowFunction);
+	mSettings.mTimeBandwidth = timeBandwidth;
+	mSettings.mNumTapers = numTapers;
+
+	ResetAsync();
+}
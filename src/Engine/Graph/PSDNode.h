@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_PSDNODE_H
+#define __NEUROMORE_PSDNODE_H
+
+// include the required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "ProcessorNode.h"
+#include "../DSP/PSDProcessor.h"
+
+
+class ENGINE_API PSDNode : public ProcessorNode
+{
+	public:
+		enum { TYPE_ID = 0x005C };
+		static const char* Uuid () { return "6f0b2d94-8c1e-4a53-b7d2-91e4c6a0f358"; }
+
+		enum
+		{
+			ATTRIB_METHOD			= 0,
+			ATTRIB_FFTORDER,
+			ATTRIB_OVERLAP,
+			ATTRIB_NUMSEGMENTS,
+			ATTRIB_WINDOWFUNCTION,
+			ATTRIB_TIMEBANDWIDTH,
+			ATTRIB_NUMTAPERS,
+		};
+
+		enum
+		{
+			INPUTPORT_CHANNEL		= 0,
+			OUTPUTPORT_SPECTRUM		= 0
+		};
+
+		enum
+		{
+			PORTID_INPUT_SAMPLE		= 0,
+			PORTID_OUTPUT_SPECTRUM	= 1
+		};
+
+		// constructor & destructor
+		PSDNode(Graph* graph);
+		~PSDNode();
+
+		// initialize & update
+		void Init() override;
+		void ReInit(const Core::Time& elapsed, const Core::Time& delta) override;
+		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+
+		void OnAttributesChanged() override;
+
+		Core::Color GetColor() const override							{ return Core::RGBA(128,22,255); }
+		uint32 GetType() const override										{ return TYPE_ID; }
+		const char* GetTypeUuid() const override final						{ return Uuid(); }
+		const char* GetReadableType() const override						{ return "PSD"; }
+		const char* GetRuleName() const override final						{ return "NODE_PSD"; }
+		uint32 GetPaletteCategory() const override							{ return CATEGORY_DSP; }
+		GraphObject* Clone(Graph* graph) override							{ PSDNode* clone = new PSDNode(graph); return clone; }
+
+		const ChannelProcessor::Settings& GetSettings() override			{ return mSettings; }
+
+	private:
+		PSDProcessor::PSDSettings	mSettings;
+};
+
+
+#endif
@@ -128,8 +128,20 @@ class InputPort : public Port
 class OutputPort : public Port
 {
 	public:
-		OutputPort() : Port(Port::OUTPUT) {}
+		OutputPort() : Port(Port::OUTPUT), mUseDefaultSampleFormat(true), mSampleFormat(ChannelBase::SAMPLEFORMAT_DOUBLE), mSampleResolution(1.0) {}
 		virtual ~OutputPort() {};
+
+		// sample format override of the output buffers (uses the engine-wide default if not set)
+		void SetSampleFormat(ChannelBase::ESampleFormat format, double resolution = 1.0)	{ mUseDefaultSampleFormat = false; mSampleFormat = format; mSampleResolution = resolution; }
+		void ResetSampleFormat()																{ mUseDefaultSampleFormat = true; }
+		bool UsesDefaultSampleFormat() const													{ return mUseDefaultSampleFormat; }
+		ChannelBase::ESampleFormat GetSampleFormat() const										{ return mSampleFormat; }
+		double GetSampleResolution() const														{ return mSampleResolution; }
+
+	private:
+		bool						mUseDefaultSampleFormat;
+		ChannelBase::ESampleFormat	mSampleFormat;
+		double						mSampleResolution;
 };
 
 
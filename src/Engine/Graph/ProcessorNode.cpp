@@ -27,7 +27,7 @@
 // include required files
 #include "ProcessorNode.h"
 #include "../DSP/Channel.h"
-#include "ProcessorNode.h"
+#include "../EngineManager.h"
 
 
 using namespace Core;
@@ -234,10 +234,51 @@ void ProcessorNode::Update(const Time& elapsed, const Time& delta)
 
 	if (mIsInitialized == true)
 	{
+		Profiler& profiler = GetEngine()->GetProfiler();
+		const bool skipIdleProcessors = GetEngine()->GetSkipIdleProcessors();
+
 		// update all processors
 		uint32 numProcessors = mProcessors.Size();
+		uint32 numSkippedProcessors = 0;
 		for (uint32 i = 0; i < numProcessors; ++i)
-			mProcessors[i]->Update(elapsed, delta);
+		{
+			ChannelProcessor* processor = mProcessors[i];
+
+			// skip processors that cannot produce output this tick (e.g. behind a slow epoch node)
+			// NOTE: only the processor work is saved; the node itself is still updated (BaseUpdate() updates its inputs and
+			// SPNode::Update() runs), because the inputs must be updated before we know if new samples arrived
+			if (skipIdleProcessors == true && processor->CanSkipUpdate() == true)
+			{
+				numSkippedProcessors++;
+				continue;
+			}
+
+			Profiler::Marker marker;
+			profiler.Begin(marker);
+			processor->Update(elapsed, delta);
+
+			// per-processor event (only shows up in the trace, the node event already contains it)
+			if (marker.mIsOpen == true)
+			{
+				uint32 numSamplesIn = 0;
+				const uint32 numInputs = processor->GetNumInputs();
+				for (uint32 j = 0; j < numInputs; ++j)
+				{
+					const ChannelBase* input = processor->GetInput(j);
+					if (input != NULL)
+						numSamplesIn += input->GetNumNewSamples();
+				}
+
+				uint32 numSamplesOut = 0;
+				const uint32 numOutputs = processor->GetNumOutputs();
+				for (uint32 j = 0; j < numOutputs; ++j)
+					numSamplesOut += processor->GetOutput(j)->GetNumNewSamples();
+
+				profiler.End( marker, GetProfilerScopeID(), i, numSamplesIn, numSamplesOut );
+			}
+		}
+
+		SetNumSkippedProcessors(numSkippedProcessors);
 	}
 	else
 	{
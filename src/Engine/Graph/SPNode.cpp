@@ -651,6 +651,29 @@ void SPNode::UpdateChannelActivity(double timePassedInSeconds)
 }
 
 
+// count the new samples of all input and output channels (used by the profiler)
+void SPNode::CountProfilerSamples(uint32& outNumSamplesIn, uint32& outNumSamplesOut) const
+{
+	outNumSamplesIn = 0;
+	const uint32 numInputChannels = mInputChannels.GetNumChannels();
+	for (uint32 c=0; c<numInputChannels; ++c)
+		outNumSamplesIn += mInputChannels.GetChannel(c)->GetNumNewSamples();
+
+	outNumSamplesOut = 0;
+	const uint32 numOutPorts = mOutputPorts.Size();
+	for (uint32 i=0; i<numOutPorts; ++i)
+	{
+		const MultiChannel* channels = mOutputPorts[i].GetChannels();
+		if (channels == NULL)
+			continue;
+
+		const uint32 numChannels = channels->GetNumChannels();
+		for (uint32 c=0; c<numChannels; ++c)
+			outNumSamplesOut += channels->GetChannel(c)->GetNumNewSamples();
+	}
+}
+
+
 // this resizes the output buffers recursively
 void SPNode::ResizeBuffers(double seconds)
 {
@@ -684,7 +707,7 @@ void SPNode::ResizeBuffers(double seconds)
 	const uint32 numOutPorts = GetNumOutputPorts();
 	for (uint32 i = 0; i < numOutPorts; ++i)
 	{
-		Port& port = GetOutputPort(i);
+		OutputPort& port = GetOutputPort(i);
 
 		// get the output channel (if its a multichannel, use the first in the set)
 		MultiChannel* channels = port.GetChannels();
@@ -719,7 +742,13 @@ void SPNode::ResizeBuffers(double seconds)
 		const uint32 minBufferSizeForRealtime = (sampleRate > 0 ? seconds * sampleRate : defaultMinBufferSize);
 		const uint32 newBufferSize = ::std::max(minBufferSizeForReader, minBufferSizeForRealtime);
 
-		// 3) resize all buffers, but DO NOT RESET
+		// 3) apply the sample format (port override or engine default), converts the buffered samples if it changed
+		if (port.UsesDefaultSampleFormat() == true)
+			channels->SetSampleFormat(GetEngine()->GetChannelSampleFormat(), GetEngine()->GetChannelSampleResolution());
+		else
+			channels->SetSampleFormat(port.GetSampleFormat(), port.GetSampleResolution());
+
+		// 4) resize all buffers, but DO NOT RESET
 		channels->SetBufferSize(newBufferSize, false);
 	}
 }
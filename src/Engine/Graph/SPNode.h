@@ -120,6 +120,9 @@ class ENGINE_API SPNode : public Node
 		// update channel activity timer
 		void UpdateChannelActivity(double timePassedInSeconds);
 
+		// number of samples that arrived at the inputs and were added to the outputs during this update
+		virtual void CountProfilerSamples(uint32& outNumSamplesIn, uint32& outNumSamplesOut) const override;
+
 		// reset output channels
 		void ResetBuffers();
 
@@ -145,15 +145,14 @@ StateTransition* StateMachine::GetTransition(uint32 connectionIndex) const
 
 uint32 StateMachine::FindNumOutTransitions(const State* sourceState, bool ignoreDisabled) const
 {
-	const uint32 numTransitions = mConnections.Size();
+	const uint32 numTransitions = CalcNumOutputConnections(sourceState);
+	if (ignoreDisabled == false)
+		return numTransitions;
 
 	uint32 count = 0;
 	for (uint32 i = 0; i < numTransitions; ++i)
 	{
-		StateTransition* transition = GetTransition(i);
-
-		if (transition->GetSourceState() != sourceState)
-			continue;
+		StateTransition* transition = GetTransition( FindOutputConnection(sourceState, i) );
 
 		if (ignoreDisabled == true && transition->IsDisabled() == true)
 			continue;
@@ -168,15 +167,12 @@ uint32 StateMachine::FindNumOutTransitions(const State* sourceState, bool ignore
 
 StateTransition* StateMachine::FindOutTransition(const State* sourceState, uint32 index, bool ignoreDisabled) const
 {
-	const uint32 numTransitions = mConnections.Size();
+	const uint32 numTransitions = CalcNumOutputConnections(sourceState);
 
 	uint32 count = 0;
 	for (uint32 i = 0; i < numTransitions; ++i)
 	{
-		StateTransition* transition = GetTransition(i);
-
-		if (transition->GetSourceState() != sourceState)
-			continue;
+		StateTransition* transition = GetTransition( FindOutputConnection(sourceState, i) );
 
 		if (ignoreDisabled == true && transition->IsDisabled() == true)
 			continue;
@@ -193,15 +189,14 @@ StateTransition* StateMachine::FindOutTransition(const State* sourceState, uint3
 
 uint32 StateMachine::FindNumInTransitions(const State* targetState, bool ignoreDisabled) const
 {
-	const uint32 numTransitions = mConnections.Size();
+	const uint32 numTransitions = CalcNumInputConnections(targetState);
+	if (ignoreDisabled == false)
+		return numTransitions;
 
 	uint32 count = 0;
 	for (uint32 i = 0; i < numTransitions; ++i)
 	{
-		StateTransition* transition = GetTransition(i);
-
-		if (transition->GetTargetState() != targetState)
-			continue;
+		StateTransition* transition = GetTransition( FindInputConnection(targetState, i) );
 
 		if (ignoreDisabled == true && transition->IsDisabled() == true)
 			continue;
@@ -216,15 +211,12 @@ uint32 StateMachine::FindNumInTransitions(const State* targetState, bool ignoreD
 
 StateTransition* StateMachine::FindInTransition(const State* targetState, uint32 index, bool ignoreDisabled) const
 {
-	const uint32 numTransitions = mConnections.Size();
+	const uint32 numTransitions = CalcNumInputConnections(targetState);
 
 	uint32 count = 0;
 	for (uint32 i = 0; i < numTransitions; ++i)
 	{
-		StateTransition* transition = GetTransition(i);
-
-		if (transition->GetTargetState() != targetState)
-			continue;
+		StateTransition* transition = GetTransition( FindInputConnection(targetState, i) );
 
 		if (ignoreDisabled == true && transition->IsDisabled() == true)
 			continue;
@@ -308,8 +300,8 @@ void StateMachine::CheckConditions(State* sourceState)
 	if (sourceState == NULL)
 		return;
 
-	// num transitions total
-	const uint32 numTransitions	= GetNumConnections();
+	// num transitions starting at the source state
+	const uint32 numTransitions	= CalcNumOutputConnections(sourceState);
 
 	// FIXME optimize alloc
 	// arrays to collect all ready transitions from this node
@@ -320,14 +312,10 @@ void StateMachine::CheckConditions(State* sourceState)
 	for (uint32 i=0; i<numTransitions; ++i)
 	{
 		// get the current transition and skip it directly if in case it is disabled
-		StateTransition* curTransition = GetTransition(i);
+		StateTransition* curTransition = GetTransition( FindOutputConnection(sourceState, i) );
 		if (curTransition->IsDisabled() == true)
 			continue;
 
-		// skip transitions that don't start from our given start node
-		if (curTransition->GetSourceState() != sourceState)
-			continue;
-
 		// make sure source node can exit
 		if (sourceState->CanExit(curTransition) == false)
 			continue;
@@ -399,19 +387,15 @@ void StateMachine::UpdateConditions(State* state, const Time& elapsed, const Tim
 	if (state == NULL)
 		return;
 
-	// get the number of transitions and iterate through them
-	const uint32 numTransitions = GetNumConnections();
+	// get the number of transitions starting at the state and iterate through them
+	const uint32 numTransitions = CalcNumOutputConnections(state);
 	for (uint32 i=0; i<numTransitions; ++i)
 	{
 		// get the current transition and skip it directly if in case it is disabled
-		StateTransition* transition = GetTransition(i);
+		StateTransition* transition = GetTransition( FindOutputConnection(state, i) );
 		if (transition->IsDisabled() == true)
 			continue;
 
-		// skip transitions that don't start from our given current node
-		if (transition->GetSourceNode() != state)
-			continue;
-
 		// skip transitions that are not made for interrupting when we are currently transitioning
 		if (transition->IsTransitioning() == true)
 			continue;
@@ -796,7 +780,7 @@ Connection* StateMachine::AddConnection(Node* sourceNode, uint32 sourcePortNr, N
 	transition->SetVisualOffsets( startOffsetX, startOffsetY, endOffsetX, endOffsetY );
 
 	// add it to the connections array
-	mConnections.Add( transition );
+	InsertConnection( transition );
 
 	// 1. initialize the transition
 	transition->Init();
@@ -229,7 +229,7 @@ void ThresholdNode::SetRangeModeEnabled(bool enabled)
 	// remove input connections on second threshold port if range mode is disabled
 	if (enabled == false)
 	{
-		uint32 conIndex = mParentGraph->FindInputConnection(this, INPUTPORT_HIGH_THRESHOLD);
+		uint32 conIndex = mParentGraph->FindInputConnection(this, (uint16)INPUTPORT_HIGH_THRESHOLD, 0);
 		if (conIndex != CORE_INVALIDINDEX32)
 			mParentGraph->RemoveConnection(mParentGraph->GetConnection(conIndex));
 	}
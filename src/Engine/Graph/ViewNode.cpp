@@ -234,6 +234,32 @@ void ViewNode::OnAttributesChanged()
 }
 
 
+// view nodes are only consumed while a visualization shows their channels
+bool ViewNode::IsConsumed() const
+{
+	return GetNumConsumers() > 0;
+}
+
+
+// number of visualizations that show the channels of this node (disabled nodes are not shown at all)
+// NOTE: the enable input is not taken into account, it is only read while the node is updated
+uint32 ViewNode::GetNumConsumers() const
+{
+	if (IsEnabled() == false)
+		return 0;
+
+	EngineManager* engine = GetEngine();
+
+	uint32 numConsumers = 0;
+	if (GetInputPort(INPUTPORT_DOUBLE).HasConnection() == true)
+		numConsumers += engine->GetNumViewConsumers(EngineManager::VIEWTYPE_SIGNAL);
+	if (GetInputPort(INPUTPORT_SPECTRUM).HasConnection() == true)
+		numConsumers += engine->GetNumViewConsumers(EngineManager::VIEWTYPE_SPECTRUM);
+
+	return numConsumers;
+}
+
+
 uint32 ViewNode::GetNumDoubleChannels()
 {
 	Port& port = GetInputPort(INPUTPORT_DOUBLE);
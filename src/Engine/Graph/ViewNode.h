@@ -76,6 +76,10 @@ class ENGINE_API ViewNode : public SPNode
 		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
 
 		void OnAttributesChanged() override;
+
+		// demand tracking: only consumed while a visualization shows the channels of the node
+		bool IsConsumed() const override;
+		uint32 GetNumConsumers() const;
 		
 		Core::Color GetColor() const override									{ return Core::RGBA(0,229,189); }
 		uint32 GetType() const override											{ return TYPE_ID; }
@@ -110,6 +110,7 @@ class ENGINE_API WaveformNode : public ProcessorNode
 				void Init() override;
 				void ReInit() override;
 				void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+				bool IsClockDriven() const override								{ return true; }
 
 
 				// settings
@@ -0,0 +1,365 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required headers
+#include "WaveletNode.h"
+#include "../Core/Math.h"
+#include "../Core/AttributeFloat.h"
+#include "../Core/AttributeInt32.h"
+#include "../Core/AttributeBool.h"
+
+
+using namespace Core;
+
+// constructor
+WaveletNode::WaveletNode(Graph* graph) : SPNode(graph)
+{
+	mSampleRate			= 0.0;
+	mWindowLength		= 0;
+	mWindowPos			= 0;
+	mNumHopSamples		= 1;
+	mSamplesUntilUpdate	= 0;
+	mUseDenoising		= false;
+}
+
+
+// destructor
+WaveletNode::~WaveletNode()
+{
+	DeleteOutputChannels();
+}
+
+
+// initialize the node
+void WaveletNode::Init()
+{
+	// configure SPNode behaviour
+	RequireConstantSampleRate();
+	RequireMatchingSampleRates();
+	RequireInputConnection();
+
+	// SETUP PORTS
+
+	// setup the input ports
+	InitInputPorts(1);
+	GetInputPort(INPUTPORT).Setup("In", "x", AttributeChannels<double>::TYPE_ID, INPUTPORT);
+
+	// setup the output ports
+	InitOutputPorts(2);
+	GetOutputPort(OUTPUTPORT_POWER).SetupAsChannels<double>("Power", "y1", OUTPUTPORT_POWER);
+	GetOutputPort(OUTPUTPORT_SIGNAL).SetupAsChannels<double>("Signal", "y2", OUTPUTPORT_SIGNAL);
+
+	// ATTRIBUTES
+
+	// scales
+	AttributeSettings* minFreqAttr = RegisterAttribute("Lower Frequency", "minFrequency", "Frequency of the largest scale.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	minFreqAttr->SetDefaultValue( AttributeFloat::Create(2.0) );
+	minFreqAttr->SetMinValue( AttributeFloat::Create(0.1) );
+	minFreqAttr->SetMaxValue( AttributeFloat::Create(FLT_MAX) );
+
+	AttributeSettings* maxFreqAttr = RegisterAttribute("Upper Frequency", "maxFrequency", "Frequency of the smallest scale.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	maxFreqAttr->SetDefaultValue( AttributeFloat::Create(40.0) );
+	maxFreqAttr->SetMinValue( AttributeFloat::Create(0.1) );
+	maxFreqAttr->SetMaxValue( AttributeFloat::Create(FLT_MAX) );
+
+	AttributeSettings* voicesAttr = RegisterAttribute("Voices per Octave", "voicesPerOctave", "Number of scales per octave.", ATTRIBUTE_INTERFACETYPE_INTSPINNER);
+	voicesAttr->SetDefaultValue( AttributeInt32::Create(2) );
+	voicesAttr->SetMinValue( AttributeInt32::Create(1) );
+	voicesAttr->SetMaxValue( AttributeInt32::Create(32) );
+
+	AttributeSettings* omegaAttr = RegisterAttribute("Morlet Parameter", "omega", "Center frequency omega0 of the Morlet wavelet. Larger values give better frequency and worse time resolution.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	omegaAttr->SetDefaultValue( AttributeFloat::Create(6.0) );
+	omegaAttr->SetMinValue( AttributeFloat::Create(1.0) );
+	omegaAttr->SetMaxValue( AttributeFloat::Create(20.0) );
+
+	AttributeSettings* rateAttr = RegisterAttribute("Update Rate", "updateRate", "Number of power values per second.", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	rateAttr->SetDefaultValue( AttributeFloat::Create(32.0) );
+	rateAttr->SetMinValue( AttributeFloat::Create(0.1) );
+	rateAttr->SetMaxValue( AttributeFloat::Create(FLT_MAX) );
+
+	// denoising
+	AttributeSettings* denoiseAttr = RegisterAttribute("Denoise", "denoise", "Denoise the input with the discrete wavelet transform (VisuShrink) before the analysis.", ATTRIBUTE_INTERFACETYPE_CHECKBOX);
+	denoiseAttr->SetDefaultValue( AttributeBool::Create(false) );
+
+	AttributeSettings* waveletAttr = RegisterAttribute("Wavelet", "wavelet", "The wavelet used for denoising.", ATTRIBUTE_INTERFACETYPE_COMBOBOX);
+	waveletAttr->ResizeComboValues( WaveletDenoiser::GetNumWavelets() );
+	for (uint32 i=0; i<WaveletDenoiser::GetNumWavelets(); ++i)
+		waveletAttr->SetComboValue(i, WaveletDenoiser::GetWaveletName(i));
+	waveletAttr->SetDefaultValue( AttributeInt32::Create(2) );
+
+	AttributeSettings* levelsAttr = RegisterAttribute("Levels", "levels", "Number of DWT decomposition levels used for denoising.", ATTRIBUTE_INTERFACETYPE_INTSPINNER);
+	levelsAttr->SetDefaultValue( AttributeInt32::Create(4) );
+	levelsAttr->SetMinValue( AttributeInt32::Create(1) );
+	levelsAttr->SetMaxValue( AttributeInt32::Create(10) );
+
+	AttributeSettings* blockAttr = RegisterAttribute("Block Length", "blockLength", "Number of samples that are denoised at once (adds the same delay).", ATTRIBUTE_INTERFACETYPE_INTSPINNER);
+	blockAttr->SetDefaultValue( AttributeInt32::Create(256) );
+	blockAttr->SetMinValue( AttributeInt32::Create(16) );
+	blockAttr->SetMaxValue( AttributeInt32::Create(8192) );
+}
+
+
+// reset everything
+void WaveletNode::Reset()
+{
+	SPNode::Reset();
+
+	DeleteOutputChannels();
+}
+
+
+void WaveletNode::ReInit(const Time& elapsed, const Time& delta)
+{
+	if (BaseReInit(elapsed, delta) == false)
+		return;
+
+	// reinit baseclass
+	SPNode::ReInit(elapsed, delta);
+
+	PostReInit(elapsed, delta);
+}
+
+
+void WaveletNode::Start(const Time& elapsed)
+{
+	const uint32 numChannels = mInputReader.GetNumChannels();
+	const double sampleRate = mInputReader.GetSampleRate();
+	mSampleRate = sampleRate;
+
+	// the filters are only rebuilt on start
+	if (mFilterBank.Init(sampleRate, GetFloatAttribute(ATTRIB_MINFREQUENCY), GetFloatAttribute(ATTRIB_MAXFREQUENCY), GetInt32Attribute(ATTRIB_VOICESPEROCTAVE), GetFloatAttribute(ATTRIB_OMEGA)) == false)
+		LogError("WaveletNode::Start(): Cannot create the wavelet filters.");
+
+	const uint32 numScales = mFilterBank.GetNumScales();
+
+	// analysis windows
+	mWindowLength = 2 * mFilterBank.GetMaxHalfLength() + 1;
+	mWindows.Resize(2 * mWindowLength * numChannels);
+	for (uint32 i=0; i<mWindows.Size(); ++i)
+		mWindows[i] = 0.0;
+	mWindowPos = 0;
+	mFrame.Resize(numChannels);
+
+	mNumHopSamples = Max<uint32>(1, (uint32)(sampleRate / GetFloatAttribute(ATTRIB_UPDATERATE) + 0.5));
+	mSamplesUntilUpdate = mNumHopSamples;
+
+	// denoisers
+	mUseDenoising = GetBoolAttribute(ATTRIB_DENOISE);
+	const uint32 blockLength = GetInt32Attribute(ATTRIB_BLOCKLENGTH);
+	mDenoisers.Resize(mUseDenoising ? numChannels : 0);
+	for (uint32 c=0; c<mDenoisers.Size(); ++c)
+		mDenoisers[c].Init(blockLength, GetInt32Attribute(ATTRIB_LEVELS), WaveletDenoiser::GetWaveletName(GetInt32Attribute(ATTRIB_WAVELET)));
+
+	const double denoiseDelay = (mUseDenoising ? blockLength / sampleRate : 0.0);
+
+	// create the output channels
+	MultiChannel* powerSet = GetOutputPort(OUTPUTPORT_POWER).GetChannels();
+	MultiChannel* signalSet = GetOutputPort(OUTPUTPORT_SIGNAL).GetChannels();
+	CORE_ASSERT(powerSet->GetNumChannels() == 0 && signalSet->GetNumChannels() == 0);
+
+	for (uint32 c=0; c<numChannels; ++c)
+	{
+		ChannelBase* inputChannel = mInputReader.GetChannel(c);
+
+		for (uint32 j=0; j<numScales; ++j)
+		{
+			mTempString.Format("%s %.1f Hz", inputChannel->GetName(), mFilterBank.GetFrequency(j));
+
+			Channel<double>* channel = new Channel<double>();
+			channel->SetBufferSize(10);
+			channel->SetName(mTempString.AsChar());
+			channel->SetSampleRate(sampleRate / mNumHopSamples);
+			channel->SetColor(inputChannel->GetColor());
+			powerSet->AddChannel(channel);
+		}
+
+		Channel<double>* channel = new Channel<double>();
+		channel->SetBufferSize(10);
+		channel->SetName(inputChannel->GetName());
+		channel->SetSampleRate(sampleRate);
+		channel->SetColor(inputChannel->GetColor());
+		signalSet->AddChannel(channel);
+	}
+
+	SPNode::Start(elapsed);
+
+	// each scale is centered half a filter length before the newest sample
+	for (uint32 c=0; c<numChannels; ++c)
+	{
+		for (uint32 j=0; j<numScales; ++j)
+		{
+			ChannelBase* channel = powerSet->GetChannel(c * numScales + j);
+			channel->SetStartTime(channel->GetStartTime() + Time(denoiseDelay + mFilterBank.GetHalfLength(j) / sampleRate));
+		}
+
+		ChannelBase* channel = signalSet->GetChannel(c);
+		channel->SetStartTime(channel->GetStartTime() + Time(denoiseDelay));
+	}
+}
+
+
+// update the node
+void WaveletNode::Update(const Time& elapsed, const Time& delta)
+{
+	if (BaseUpdate(elapsed, delta) == false)
+		return;
+
+	// update the baseclass
+	SPNode::Update(elapsed, delta);
+
+	// do nothing if node is not fully initialized
+	if (mIsInitialized == false)
+		return;
+
+	if (mFilterBank.IsInitialized() == false)
+	{
+		mInputReader.Flush();
+		return;
+	}
+
+	// consume the inputs in lockstep
+	const uint32 numSamples = mInputReader.GetMinNumNewSamples();
+	const uint32 numChannels = mInputReader.GetNumChannels();
+	for (uint32 s=0; s<numSamples; ++s)
+	{
+		if (mUseDenoising == false)
+		{
+			for (uint32 c=0; c<numChannels; ++c)
+				mFrame[c] = mInputReader.GetReader(c)->PopOldestSample<double>();
+
+			ProcessFrame(mFrame.GetPtr());
+			continue;
+		}
+
+		// all denoisers complete their blocks at the same sample
+		bool hasBlock = false;
+		for (uint32 c=0; c<numChannels; ++c)
+			hasBlock = mDenoisers[c].AddSample( mInputReader.GetReader(c)->PopOldestSample<double>() );
+
+		if (hasBlock == false)
+			continue;
+
+		const uint32 blockLength = mDenoisers[0].GetBlockLength();
+		for (uint32 i=0; i<blockLength; ++i)
+		{
+			for (uint32 c=0; c<numChannels; ++c)
+				mFrame[c] = mDenoisers[c].GetOutput()[i];
+
+			ProcessFrame(mFrame.GetPtr());
+		}
+	}
+}
+
+
+// add one sample per channel to the windows, output the signal and the scale powers once per hop
+void WaveletNode::ProcessFrame(const double* samples)
+{
+	const uint32 numChannels = mFrame.Size();
+	const uint32 numScales = mFilterBank.GetNumScales();
+
+	MultiChannel* signalSet = GetOutputPort(OUTPUTPORT_SIGNAL).GetChannels();
+	for (uint32 c=0; c<numChannels; ++c)
+	{
+		double* window = mWindows.GetPtr() + c * 2 * mWindowLength;
+		window[mWindowPos] = samples[c];
+		window[mWindowPos + mWindowLength] = samples[c];
+
+		signalSet->GetChannel(c)->AsType<double>()->AddSample(samples[c]);
+	}
+
+	mWindowPos = (mWindowPos + 1) % mWindowLength;
+
+	mSamplesUntilUpdate--;
+	if (mSamplesUntilUpdate > 0)
+		return;
+
+	mSamplesUntilUpdate = mNumHopSamples;
+
+	// only one dot product per scale for the new output value
+	MultiChannel* powerSet = GetOutputPort(OUTPUTPORT_POWER).GetChannels();
+	for (uint32 c=0; c<numChannels; ++c)
+	{
+		const double* window = mWindows.GetPtr() + c * 2 * mWindowLength + mWindowPos;
+		for (uint32 j=0; j<numScales; ++j)
+			powerSet->GetChannel(c * numScales + j)->AsType<double>()->AddSample( mFilterBank.CalcPower(j, window) );
+	}
+}
+
+
+void WaveletNode::DeleteOutputChannels()
+{
+	// delete all output channels
+	const uint32 numOutPorts = GetNumOutputPorts();
+	for (uint32 i=0; i<numOutPorts; ++i)
+	{
+		MultiChannel* outputSet = GetOutputPort(i).GetChannels();
+		if (outputSet == NULL)
+			continue;
+
+		const uint32 numChannels = outputSet->GetNumChannels();
+		for (uint32 c=0; c<numChannels; ++c)
+			delete outputSet->GetChannel(c);
+
+		outputSet->Clear();
+	}
+}
+
+
+// update the data
+void WaveletNode::OnAttributesChanged()
+{
+	// restart with the new scales
+	ResetAsync();
+}
+
+
+// node delay: the largest scale is centered half a filter length in the past
+double WaveletNode::GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const
+{
+	const double sampleRate = mSampleRate;
+	if (sampleRate <= 0.0)
+		return 0.0;
+
+	double delay = (GetBoolAttribute(ATTRIB_DENOISE) ? GetInt32Attribute(ATTRIB_BLOCKLENGTH) / sampleRate : 0.0);
+	if (outputPortIndex == OUTPUTPORT_POWER)
+		delay += mFilterBank.GetMaxHalfLength() / sampleRate;
+
+	return delay;
+}
+
+
+Core::String& WaveletNode::GetDebugString(Core::String& inout)
+{
+	SPNode::GetDebugString(inout);
+
+	mTempString.Format("Num Scales: %i\n", mFilterBank.GetNumScales());
+	inout += mTempString;
+
+	mTempString.Format("Window: %i samples, hop %i\n", mWindowLength, mNumHopSamples);
+	inout += mTempString;
+
+	return inout;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_WAVELETNODE_H
+#define __NEUROMORE_WAVELETNODE_H
+
+// include the required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "SPNode.h"
+#include "../DSP/MorletFilterBank.h"
+#include "../DSP/WaveletDenoiser.h"
+
+
+// time-frequency analysis with the Morlet CWT (one power channel per input channel and scale), optional DWT denoising of the input
+class ENGINE_API WaveletNode : public SPNode
+{
+	public:
+		enum { TYPE_ID = 0x005D };
+		static const char* Uuid () { return "c8e5a1f7-3d92-4b06-8a4e-57f1d2b9e064"; }
+
+		enum
+		{
+			INPUTPORT			= 0,
+			OUTPUTPORT_POWER	= 0,
+			OUTPUTPORT_SIGNAL	= 1,
+		};
+
+		enum
+		{
+			ATTRIB_MINFREQUENCY		= 0,
+			ATTRIB_MAXFREQUENCY,
+			ATTRIB_VOICESPEROCTAVE,
+			ATTRIB_OMEGA,
+			ATTRIB_UPDATERATE,
+			ATTRIB_DENOISE,
+			ATTRIB_WAVELET,
+			ATTRIB_LEVELS,
+			ATTRIB_BLOCKLENGTH,
+		};
+
+		// constructor & destructor
+		WaveletNode(Graph* graph);
+		~WaveletNode();
+
+		// initialize & update
+		void Init() override;
+		void Reset() override;
+		void ReInit(const Core::Time& elapsed, const Core::Time& delta) override;
+		void Start(const Core::Time& elapsed) override;
+		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+
+		void OnAttributesChanged() override;
+
+		Core::Color GetColor() const override								{ return Core::RGBA(128,22,255); }
+		uint32 GetType() const override											{ return TYPE_ID; }
+		const char* GetTypeUuid() const override final							{ return Uuid(); }
+		const char* GetReadableType() const override							{ return "Wavelet Transform"; }
+		const char* GetRuleName() const override final							{ return "NODE_Wavelet"; }
+		uint32 GetPaletteCategory() const override								{ return CATEGORY_DSP; }
+		double GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const override;
+		GraphObject* Clone(Graph* graph) override								{ WaveletNode* clone = new WaveletNode(graph); return clone; }
+
+		Core::String& GetDebugString(Core::String& inout) override;
+
+	private:
+		// push one (denoised) sample of every channel into the analysis windows
+		void ProcessFrame(const double* samples);
+		void DeleteOutputChannels();
+
+		// CWT filters, shared by all channels
+		MorletFilterBank					mFilterBank;
+
+		// per channel: analysis window (ring buffer stored twice, so the window is always contiguous) and denoiser
+		Core::Array<double>					mWindows;
+		Core::Array<WaveletDenoiser>		mDenoisers;
+		Core::Array<double>					mFrame;
+		double								mSampleRate;
+		uint32								mWindowLength;
+		uint32								mWindowPos;
+		uint32								mNumHopSamples;
+		uint32								mSamplesUntilUpdate;
+		bool								mUseDenoising;
+};
+
+
+#endif
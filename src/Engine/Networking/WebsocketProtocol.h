@@ -64,6 +64,8 @@ public:
       static constexpr char ON_BROWSER_PLAYER_STOPPED[] = "ON_BROWSER_PLAYER_STOPPED";
       static constexpr char ON_BROWSER_PLAYER_PAUSED[]  = "ON_BROWSER_PLAYER_PAUSED";
       static constexpr char ON_IMPERSONATION[]          = "IMPERSONATION";
+      static constexpr char SUBSCRIBE_CHANNELS[]        = "SUBSCRIBE_CHANNELS";
+      static constexpr char ON_CHANNELS_SUBSCRIBED[]    = "ON_CHANNELS_SUBSCRIBED";
    };
 
    inline WSMessage() : d(rapidjson::kObjectType) { }
@@ -638,6 +640,92 @@ public:
    }
 };
 
+/// <summary>
+/// Sent from Client to Studio to select the channels of the binary channel stream.
+/// Each entry selects all channels of an output port: { "node": "Raw", "port": 0 }.
+/// Replaces the previous selection, an empty array stops the stream.
+/// </summary>
+class WSMessageSubscribeChannels : public WSMessage
+{
+public:
+   inline virtual const char* msgtype() const override { return Type::SUBSCRIBE_CHANNELS; }
+   inline WSMessageSubscribeChannels() : WSMessage(msgtype())
+   {
+      using namespace rapidjson;
+      auto& alloc = d.GetAllocator();
+      Value& data = d["data"];
+      Value channels(kArrayType);
+      data.AddMember("channels", channels, alloc);
+   }
+   inline bool isvalid() const
+   {
+      if (!WSMessage::isvalid())
+         return false;
+      auto& data = d["data"];
+      if (!data.HasMember("channels") || !data["channels"].IsArray())
+         return false;
+      for (auto& c : data["channels"].GetArray())
+         if (!c.IsObject() || !c.HasMember("node") || !c["node"].IsString())
+            return false;
+      return true;
+   }
+   inline uint32_t getNumChannels() const
+   {
+      return d["data"]["channels"].Size();
+   }
+   inline const char* getNode(uint32_t index) const
+   {
+      return d["data"]["channels"][index]["node"].GetString();
+   }
+   inline uint32_t getPort(uint32_t index) const
+   {
+      auto& c = d["data"]["channels"][index];
+      return (c.HasMember("port") && c["port"].IsUint()) ? c["port"].GetUint() : 0;
+   }
+};
+
+/// <summary>
+/// Sent from Studio to a Client after SUBSCRIBE_CHANNELS, maps the ids in the binary channel stream to channels
+/// </summary>
+class WSMessageOnChannelsSubscribed : public WSMessage
+{
+public:
+   inline virtual const char* msgtype() const override { return Type::ON_CHANNELS_SUBSCRIBED; }
+   inline WSMessageOnChannelsSubscribed() : WSMessage(msgtype())
+   {
+      using namespace rapidjson;
+      auto& alloc = d.GetAllocator();
+      Value& data = d["data"];
+      Value channels(kArrayType);
+      data.AddMember("channels", channels, alloc);
+   }
+   inline bool isvalid() const
+   {
+      if (!WSMessage::isvalid())
+         return false;
+      auto& data = d["data"];
+      return data.HasMember("channels") && data["channels"].IsArray();
+   }
+   inline void clear()
+   {
+      d["data"]["channels"].Clear();
+   }
+   inline void addChannel(uint16_t id, const char* node, uint32_t port, const char* channel, double sampleRate)
+   {
+      using namespace rapidjson;
+      auto& alloc = d.GetAllocator();
+
+      Value item(kObjectType);
+      item.AddMember("id", id, alloc);
+      item.AddMember("node", Value(node, alloc), alloc);
+      item.AddMember("port", port, alloc);
+      item.AddMember("channel", Value(channel, alloc), alloc);
+      item.AddMember("sample_rate", sampleRate, alloc);
+
+      d["data"]["channels"].PushBack(item, alloc);
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 // BINARY
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -651,10 +739,12 @@ public:
    QByteArray mBuffer;
 
    static constexpr uint16_t TYPE_CUSTOM_FEEDBACK = 1;
+   static constexpr uint16_t TYPE_CHANNEL_STREAM  = 2;
 
    enum Type : uint16_t
    {
-      CUSTOM_FEEDBACK = TYPE_CUSTOM_FEEDBACK
+      CUSTOM_FEEDBACK = TYPE_CUSTOM_FEEDBACK,
+      CHANNEL_STREAM  = TYPE_CHANNEL_STREAM
    };
 
    inline bool createMessageCustomFeedback(Classifier* c, const uint16_t index)
@@ -673,17 +763,67 @@ public:
       if (NUMCHANNELS == 0)
          return false;
 
+      // size the buffer once
+      mBuffer.resize(sizeof(TYPE_CUSTOM_FEEDBACK) + sizeof(index) + NUMCHANNELS * sizeof(double));
+      char* p = mBuffer.data();
+      ::memcpy(p, &TYPE_CUSTOM_FEEDBACK, sizeof(TYPE_CUSTOM_FEEDBACK)); p += sizeof(TYPE_CUSTOM_FEEDBACK);
+      ::memcpy(p, &index, sizeof(index));                               p += sizeof(index);
+
+      const double v = n->GetCurrentValue();
+      for (uint32_t j = 0; j < NUMCHANNELS; j++, p += sizeof(v))
+         ::memcpy(p, &v, sizeof(v));
+
+      return true;
+   }
+
+   /// <summary>
+   /// Channel stream frame, one per client and tick with the new samples of all subscribed channels:
+   /// uint16 type, uint16 numChannels, uint32 sequence, then per channel:
+   /// uint16 id, uint16 decimation, uint32 numDropped, uint32 numSamples, float samples[numSamples]
+   /// (numDropped: samples skipped since the last frame because the client could not keep up)
+   /// </summary>
+   inline void beginMessageChannelStream(const uint32_t sequence)
+   {
+      const uint16_t numChannels = 0;
+
       mBuffer.clear();
-      mBuffer.append((const char*)&TYPE_CUSTOM_FEEDBACK, sizeof(TYPE_CUSTOM_FEEDBACK));
-      mBuffer.append((const char*)&index, sizeof(index));
+      mBuffer.append((const char*)&TYPE_CHANNEL_STREAM, sizeof(TYPE_CHANNEL_STREAM));
+      mBuffer.append((const char*)&numChannels, sizeof(numChannels));
+      mBuffer.append((const char*)&sequence, sizeof(sequence));
+   }
 
-      for (uint32_t j = 0; j < NUMCHANNELS; j++)
+   inline uint16_t getNumStreamChannels() const
+   {
+      uint16_t numChannels;
+      ::memcpy(&numChannels, mBuffer.constData() + sizeof(TYPE_CHANNEL_STREAM), sizeof(numChannels));
+      return numChannels;
+   }
+
+   /// appends every decimation-th sample in [first, end), returns the index of the next sample to send
+   inline uint64_t addChannelStream(const uint16_t id, const uint16_t decimation, const uint32_t numDropped, const Channel<double>* channel, uint64_t first, const uint64_t end)
+   {
+      const uint32_t NUMSAMPLES = first < end ? (uint32_t)((end - first + decimation - 1) / decimation) : 0;
+
+      // grow once and write in place
+      const int offset = mBuffer.size();
+      mBuffer.resize(offset + sizeof(id) + sizeof(decimation) + sizeof(numDropped) + sizeof(NUMSAMPLES) + NUMSAMPLES * sizeof(float));
+      char* p = mBuffer.data() + offset;
+      ::memcpy(p, &id, sizeof(id));                 p += sizeof(id);
+      ::memcpy(p, &decimation, sizeof(decimation)); p += sizeof(decimation);
+      ::memcpy(p, &numDropped, sizeof(numDropped)); p += sizeof(numDropped);
+      ::memcpy(p, &NUMSAMPLES, sizeof(NUMSAMPLES)); p += sizeof(NUMSAMPLES);
+
+      for (uint32_t i = 0; i < NUMSAMPLES; i++, first += decimation, p += sizeof(float))
       {
-         double v = n->GetCurrentValue();
-         mBuffer.append((const char*)&v, sizeof(v));
+         const float v = (float)channel->GetSample(first);
+         ::memcpy(p, &v, sizeof(v));
       }
 
-      return true;
+      // count the channel in the header
+      const uint16_t numChannels = getNumStreamChannels() + 1;
+      ::memcpy(mBuffer.data() + sizeof(TYPE_CHANNEL_STREAM), &numChannels, sizeof(numChannels));
+
+      return first;
    }
 };
 
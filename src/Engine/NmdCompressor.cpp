@@ -0,0 +1,326 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required files
+#include "NmdCompressor.h"
+#include "Core/LogManager.h"
+#include <zlib/zlib.h>
+
+
+using namespace Core;
+
+// zlib compression level
+#define NMDCOMPRESSOR_LEVEL 3
+
+// little endian helpers for the header fields
+static inline void WriteUInt32(uint8* data, uint32 value)			{ data[0] = value & 0xFF; data[1] = (value >> 8) & 0xFF; data[2] = (value >> 16) & 0xFF; data[3] = (value >> 24) & 0xFF; }
+static inline void WriteUInt16(uint8* data, uint16 value)			{ data[0] = value & 0xFF; data[1] = (value >> 8) & 0xFF; }
+static inline uint32 ReadUInt32(const uint8* data)					{ return (uint32)data[0] | ((uint32)data[1] << 8) | ((uint32)data[2] << 16) | ((uint32)data[3] << 24); }
+static inline uint16 ReadUInt16(const uint8* data)					{ return (uint16)(data[0] | (data[1] << 8)); }
+
+
+// delta encode the float bit patterns, split into byte planes and deflate
+bool NmdCompressor::CompressChunk(const float* samples, uint32 numSamples, Array<uint8>& outData)
+{
+	// 1) delta encoding of the bit patterns (lossless, the first sample of each chunk is stored relative to zero)
+	// 2) byte planes: slowly changing signals produce mostly zero high bytes that compress well
+	Array<uint8> planes;
+	planes.Resize(numSamples * 4);
+	uint8* planeData = planes.GetPtr();
+
+	uint32 previous = 0;
+	for (uint32 i=0; i<numSamples; ++i)
+	{
+		uint32 bits;
+		memcpy( &bits, samples + i, sizeof(uint32) );
+
+		const uint32 delta = bits - previous;
+		previous = bits;
+
+		planeData[i]				= delta & 0xFF;
+		planeData[i + numSamples]	= (delta >> 8) & 0xFF;
+		planeData[i + numSamples*2]	= (delta >> 16) & 0xFF;
+		planeData[i + numSamples*3]	= (delta >> 24) & 0xFF;
+	}
+
+	// 3) zlib (low levels: the mantissa noise of real signals hardly compresses better with the slow levels)
+	uLongf compressedSize = compressBound(planes.Size());
+	outData.Resize(compressedSize);
+	if (compress2(outData.GetPtr(), &compressedSize, planeData, planes.Size(), NMDCOMPRESSOR_LEVEL) != Z_OK)
+		return false;
+
+	outData.Resize(compressedSize);
+	return true;
+}
+
+
+// inflate, merge the byte planes and undo the delta encoding
+bool NmdCompressor::DecompressChunk(const uint8* data, uint32 dataSize, float* outSamples, uint32 numSamples)
+{
+	Array<uint8> planes;
+	planes.Resize(numSamples * 4);
+
+	uLongf planeSize = planes.Size();
+	if (uncompress(planes.GetPtr(), &planeSize, data, dataSize) != Z_OK || planeSize != planes.Size())
+		return false;
+
+	const uint8* planeData = planes.GetPtr();
+
+	uint32 previous = 0;
+	for (uint32 i=0; i<numSamples; ++i)
+	{
+		const uint32 delta = (uint32)planeData[i] | ((uint32)planeData[i + numSamples] << 8) | ((uint32)planeData[i + numSamples*2] << 16) | ((uint32)planeData[i + numSamples*3] << 24);
+		const uint32 bits = previous + delta;
+		previous = bits;
+
+		memcpy( outSamples + i, &bits, sizeof(float) );
+	}
+
+	return true;
+}
+
+
+// encode the samples into the compressed .nmd layout
+bool NmdCompressor::Compress(const float* samples, uint32 numSamples, Array<uint8>& outData, uint32 numChunkSamples, uint32 numThreads)
+{
+	if (numChunkSamples == 0)
+		numChunkSamples = DEFAULT_CHUNKSAMPLES;
+
+	const uint32 numChunks = (numSamples + numChunkSamples - 1) / numChunkSamples;
+
+	// compress the chunks in parallel
+	Array< Array<uint8> > chunks;
+	chunks.Resize(numChunks);
+
+	std::atomic<bool> success(true);
+	ParallelFor( numChunks, numThreads, [&](uint32 chunkIndex)
+	{
+		const uint32 first = chunkIndex * numChunkSamples;
+		const uint32 count = Min<uint32>(numChunkSamples, numSamples - first);
+		if (CompressChunk(samples + first, count, chunks[chunkIndex]) == false)
+			success = false;
+	});
+
+	if (success == false)
+	{
+		LogError("NmdCompressor: Cannot compress samples.");
+		return false;
+	}
+
+	// header
+	uint32 totalSize = HEADER_SIZE;
+	for (uint32 i=0; i<numChunks; ++i)
+		totalSize += sizeof(uint32) + chunks[i].Size();
+
+	outData.Resize(totalSize);
+	uint8* data = outData.GetPtr();
+
+	WriteUInt32( data, MAGIC );
+	WriteUInt16( data + 4, VERSION );
+	WriteUInt16( data + 6, FLAG_DELTA | FLAG_BYTEPLANES );
+	WriteUInt32( data + 8, numSamples );
+	WriteUInt32( data + 12, numChunkSamples );
+	WriteUInt32( data + 16, numChunks );
+	data += HEADER_SIZE;
+
+	// chunks
+	for (uint32 i=0; i<numChunks; ++i)
+	{
+		const uint32 chunkSize = chunks[i].Size();
+		WriteUInt32( data, chunkSize );
+		memcpy( data + sizeof(uint32), chunks[i].GetReadPtr(), chunkSize );
+		data += sizeof(uint32) + chunkSize;
+	}
+
+	return true;
+}
+
+
+// check the header magic
+bool NmdCompressor::IsCompressed(const uint8* data, uint64 dataSize)
+{
+	if (dataSize < HEADER_SIZE)
+		return false;
+
+	return (ReadUInt32(data) == MAGIC);
+}
+
+
+// decode a compressed or an uncompressed .nmd
+bool NmdCompressor::Decompress(const uint8* data, uint64 dataSize, Array<float>& outSamples, uint32 numThreads)
+{
+	outSamples.Clear();
+
+	// uncompressed: sample count followed by the raw floats
+	if (IsCompressed(data, dataSize) == false)
+	{
+		if (dataSize < sizeof(uint32))
+			return false;
+
+		const uint32 numSamples = ReadUInt32(data);
+		if (dataSize < sizeof(uint32) + (uint64)numSamples * sizeof(float))
+			return false;
+
+		outSamples.Resize(numSamples);
+		memcpy( outSamples.GetPtr(), data + sizeof(uint32), numSamples * sizeof(float) );
+		return true;
+	}
+
+	// header
+	const uint16 version			= ReadUInt16(data + 4);
+	const uint16 flags				= ReadUInt16(data + 6);
+	const uint32 numSamples			= ReadUInt32(data + 8);
+	const uint32 numChunkSamples	= ReadUInt32(data + 12);
+	const uint32 numChunks			= ReadUInt32(data + 16);
+
+	if (version != VERSION || flags != (FLAG_DELTA | FLAG_BYTEPLANES) || numChunkSamples == 0 || numChunks != (numSamples + numChunkSamples - 1) / numChunkSamples)
+	{
+		LogError("NmdCompressor: Unsupported header (version=%i, flags=%i).", version, flags);
+		return false;
+	}
+
+	// locate the chunks
+	Array<uint64> offsets;
+	offsets.Resize(numChunks);
+
+	uint64 offset = HEADER_SIZE;
+	for (uint32 i=0; i<numChunks; ++i)
+	{
+		if (offset + sizeof(uint32) > dataSize)
+			return false;
+
+		offsets[i] = offset;
+		offset += sizeof(uint32) + ReadUInt32(data + offset);
+	}
+
+	if (offset > dataSize)
+		return false;
+
+	// decompress the chunks in parallel
+	outSamples.Resize(numSamples);
+
+	std::atomic<bool> success(true);
+	ParallelFor( numChunks, numThreads, [&](uint32 chunkIndex)
+	{
+		const uint32 first = chunkIndex * numChunkSamples;
+		const uint32 count = Min<uint32>(numChunkSamples, numSamples - first);
+		const uint8* chunkData = data + offsets[chunkIndex];
+		if (DecompressChunk(chunkData + sizeof(uint32), ReadUInt32(chunkData), outSamples.GetPtr() + first, count) == false)
+			success = false;
+	});
+
+	if (success == false)
+	{
+		LogError("NmdCompressor: Corrupt chunk data.");
+		outSamples.Clear();
+		return false;
+	}
+
+	return true;
+}
+
+
+// compress and write the samples with a single write
+bool NmdCompressor::SaveToDisk(const char* filename, const float* samples, uint32 numSamples, uint32 numChunkSamples, uint32 numThreads)
+{
+	Array<uint8> data;
+	if (Compress(samples, numSamples, data, numChunkSamples, numThreads) == false)
+		return false;
+
+	FILE* file = fopen(filename, "wb");
+	if (file == NULL)
+	{
+		LogError("Cannot save channel to '%s'. Opening file in write mode failed.", filename);
+		return false;
+	}
+
+	const bool result = (fwrite(data.GetReadPtr(), 1, data.Size(), file) == data.Size());
+	fclose(file);
+	return result;
+}
+
+
+// write the uncompressed layout (sample count followed by the raw floats)
+bool NmdCompressor::SaveUncompressedToDisk(const char* filename, const float* samples, uint32 numSamples)
+{
+	FILE* file = fopen(filename, "wb");
+	if (file == NULL)
+	{
+		LogError("Cannot save channel to '%s'. Opening file in write mode failed.", filename);
+		return false;
+	}
+
+	bool result = (fwrite(&numSamples, sizeof(uint32), 1, file) == 1);
+	if (numSamples > 0)
+		result &= (fwrite(samples, sizeof(float), numSamples, file) == numSamples);
+
+	fclose(file);
+	return result;
+}
+
+
+// read a compressed or an uncompressed .nmd file
+bool NmdCompressor::LoadFromDisk(const char* filename, Array<float>& outSamples, uint32 numThreads)
+{
+	FILE* file = fopen(filename, "rb");
+	if (file == NULL)
+	{
+		LogError("Cannot load '%s'. Opening file in read mode failed.", filename);
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	const long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	Array<uint8> data;
+	data.Resize(fileSize > 0 ? (uint32)fileSize : 0);
+	const bool readResult = (data.IsEmpty() == false && fread(data.GetPtr(), 1, data.Size(), file) == data.Size());
+	fclose(file);
+
+	if (readResult == false)
+	{
+		LogError("Cannot load '%s'. Reading the file failed.", filename);
+		return false;
+	}
+
+	return Decompress(data.GetReadPtr(), data.Size(), outSamples, numThreads);
+}
+
+
+// check the header magic of a file on disk
+bool NmdCompressor::IsCompressedFile(const char* filename)
+{
+	FILE* file = fopen(filename, "rb");
+	if (file == NULL)
+		return false;
+
+	uint8 header[HEADER_SIZE];
+	const size_t numRead = fread(header, 1, HEADER_SIZE, file);
+	fclose(file);
+
+	return IsCompressed(header, numRead);
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_NMDCOMPRESSOR_H
+#define __NEUROMORE_NMDCOMPRESSOR_H
+
+// include required headers
+#include "Config.h"
+#include "Core/StandardHeaders.h"
+#include "Core/Array.h"
+#include "Core/Math.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+// compressed .nmd sample files
+// The samples are split into chunks that are encoded independently on worker threads: the float bit patterns are delta encoded,
+// split into byte planes (all lowest bytes first, ...) and zlib compressed. Uncompressed .nmd files (uint32 sample count followed by
+// the raw floats) are still read.
+//
+// file layout (little endian):
+//   uint32 magic ('NMDZ'), uint16 version, uint16 flags, uint32 numSamples, uint32 numChunkSamples, uint32 numChunks
+//   per chunk: uint32 compressed size, zlib stream
+class ENGINE_API NmdCompressor
+{
+	public:
+		enum
+		{
+			MAGIC					= 0x5A444D4E,	// 'NMDZ'
+			VERSION					= 1,
+			HEADER_SIZE				= 20,
+			DEFAULT_CHUNKSAMPLES	= 65536
+		};
+
+		enum EFlags
+		{
+			FLAG_DELTA				= 1 << 0,
+			FLAG_BYTEPLANES			= 1 << 1
+		};
+
+		// encode/decode in memory (numThreads=0: one thread per core)
+		static bool Compress(const float* samples, uint32 numSamples, Core::Array<uint8>& outData, uint32 numChunkSamples=DEFAULT_CHUNKSAMPLES, uint32 numThreads=0);
+		static bool Decompress(const uint8* data, uint64 dataSize, Core::Array<float>& outSamples, uint32 numThreads=0);
+
+		static bool IsCompressed(const uint8* data, uint64 dataSize);
+
+		// files on disk
+		static bool SaveToDisk(const char* filename, const float* samples, uint32 numSamples, uint32 numChunkSamples=DEFAULT_CHUNKSAMPLES, uint32 numThreads=0);
+		static bool SaveUncompressedToDisk(const char* filename, const float* samples, uint32 numSamples);
+		static bool LoadFromDisk(const char* filename, Core::Array<float>& outSamples, uint32 numThreads=0);		// compressed or uncompressed
+		static bool IsCompressedFile(const char* filename);
+
+		// calls function(jobIndex) for all jobs, spread over the worker threads (numThreads=0: one thread per core)
+		template <class Function>
+		static void ParallelFor(uint32 numJobs, uint32 numThreads, const Function& function);
+
+	private:
+		static bool CompressChunk(const float* samples, uint32 numSamples, Core::Array<uint8>& outData);
+		static bool DecompressChunk(const uint8* data, uint32 dataSize, float* outSamples, uint32 numSamples);
+};
+
+
+// calls function(jobIndex) for all jobs, spread over the worker threads
+template <class Function>
+void NmdCompressor::ParallelFor(uint32 numJobs, uint32 numThreads, const Function& function)
+{
+	if (numThreads == 0)
+		numThreads = Core::Max<uint32>(1, std::thread::hardware_concurrency());
+
+	numThreads = Core::Min<uint32>(numThreads, numJobs);
+
+	// run small jobs directly
+	if (numThreads <= 1)
+	{
+		for (uint32 i=0; i<numJobs; ++i)
+			function(i);
+		return;
+	}
+
+	// the workers pull the next job index until all jobs are done
+	std::atomic<uint32> nextJob(0);
+	auto worker = [&]()
+	{
+		for (uint32 i = nextJob++; i < numJobs; i = nextJob++)
+			function(i);
+	};
+
+	std::vector<std::thread> threads;
+	for (uint32 i=1; i<numThreads; ++i)
+		threads.emplace_back(worker);
+
+	// the calling thread works as well
+	worker();
+
+	for (uint32 i=0; i<threads.size(); ++i)
+		threads[i].join();
+}
+
+
+#endif
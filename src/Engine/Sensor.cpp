@@ -62,6 +62,11 @@ Sensor::Sensor(const char* name, double sampleRateOut, double sampleRateIn)
 	mRealSampleRate  = 0;
 	mNumLostSamples  = 0;
 	mSampleRate		 = sampleRateOut;
+
+	mMaxQueuedSamples	= 0;
+	mNumDroppedSamples	= 0;
+	mQueuedSamplesHead	= 0;
+	mNumQueuedSamples	= 0;
 	
 	mUseDriftCorrection		= true;		// enabled drift correction by default // TODO check if the other way around makes more sense
 	mNumDriftSamplesAdded	= 0;
@@ -70,7 +75,7 @@ Sensor::Sensor(const char* name, double sampleRateOut, double sampleRateIn)
 	mContactQuality = CONTACTQUALITY_NOT_AVAILABLE;
 
 	// reserve some memory for the sample queue
-	mQueuedSamples.Reserve(2048);
+	mQueuedSamples.Resize(2048);
 
 	// for bursts, look at the last 200 updates (not great as it depends on the update rate.. but better than nothing)
 	mBursts.Resize(200);
@@ -115,17 +120,24 @@ void Sensor::Update(const Time& elapsed, const Time& delta)
 
 	mQueuedSamplesLock.Lock();
 
-	const uint32 numQueuedSamples = mQueuedSamples.Size();
+	const uint32 numQueuedSamples = mNumQueuedSamples;
+	const uint32 capacity = mQueuedSamples.Size();
 
 	// always reset counter before adding the new samples
 	GetInput()->BeginAddSamples();
 
-	// add samples to raw sample channel
+	// add samples to raw sample channel (oldest first, the ring may wrap around)
+	uint32 index = mQueuedSamplesHead;
 	for (uint32 i = 0; i < numQueuedSamples; ++i)
-		GetInput()->AddSample(mQueuedSamples[i]);
+	{
+		GetInput()->AddSample(mQueuedSamples[index]);
+		if (++index == capacity)
+			index = 0;
+	}
 	
 	// clear the queued samples
-	mQueuedSamples.Clear();
+	mQueuedSamplesHead = 0;
+	mNumQueuedSamples = 0;
 
 	mQueuedSamplesLock.Unlock();
 
@@ -173,6 +185,7 @@ void Sensor::Reset()
 	mNumDriftSamplesAdded = 0;
 	mNumDriftSamplesRemoved = 0;
 	mNumLostSamples = 0;
+	mNumDroppedSamples = 0;
 
 	mResampler.ReInit();
 }
@@ -205,15 +218,88 @@ void Sensor::SetSampleRate(double sampleRate)
 void Sensor::AddQueuedSample(double value)
 {
 	mQueuedSamplesLock.Lock();
-	mQueuedSamples.Add(value);
+	if (mMaxQueuedSamples > 0)
+		DropQueuedSamples(1);
+	PushQueuedSample(value);
 	mQueuedSamplesLock.Unlock();
 }
 
 
+// add a block of samples under a single lock
+void Sensor::AddQueuedSamples(const double* values, uint32 numValues)
+{
+	mQueuedSamplesLock.Lock();
+
+	// a block larger than the whole queue only keeps its newest samples
+	if (mMaxQueuedSamples > 0 && numValues > mMaxQueuedSamples)
+	{
+		mNumDroppedSamples += numValues - mMaxQueuedSamples;
+		values += numValues - mMaxQueuedSamples;
+		numValues = mMaxQueuedSamples;
+	}
+
+	if (mMaxQueuedSamples > 0)
+		DropQueuedSamples(numValues);
+
+	for (uint32 i=0; i<numValues; ++i)
+		PushQueuedSample(values[i]);
+	mQueuedSamplesLock.Unlock();
+}
+
+
+// drop the oldest queued samples so the new ones fit into the bounded queue
+void Sensor::DropQueuedSamples(uint32 numNewSamples)
+{
+	const uint32 numQueuedSamples = mNumQueuedSamples;
+	if (numQueuedSamples + numNewSamples <= mMaxQueuedSamples)
+		return;
+
+	// advance the head of the ring past the dropped samples
+	const uint32 numDropped = Min(numQueuedSamples, numQueuedSamples + numNewSamples - mMaxQueuedSamples);
+	mQueuedSamplesHead = (mQueuedSamplesHead + numDropped) % mQueuedSamples.Size();
+	mNumQueuedSamples -= numDropped;
+	mNumDroppedSamples += numDropped;
+}
+
+
+// append a sample at the tail of the ring
+void Sensor::PushQueuedSample(double value)
+{
+	uint32 capacity = mQueuedSamples.Size();
+
+	// ring is full: grow it (a bounded queue never beyond its bound) and move the part from the head on to the end of the new storage
+	if (mNumQueuedSamples == capacity)
+	{
+		uint32 newCapacity = Max<uint32>(2048, capacity * 2);
+		if (mMaxQueuedSamples > 0)
+			newCapacity = Clamp<uint32>(mMaxQueuedSamples, capacity + 1, newCapacity);
+
+		mQueuedSamples.Resize(newCapacity);
+		if (mQueuedSamplesHead > 0)
+		{
+			const uint32 numMoved = capacity - mQueuedSamplesHead;
+			for (uint32 i=1; i<=numMoved; ++i)
+				mQueuedSamples[newCapacity - i] = mQueuedSamples[capacity - i];
+			mQueuedSamplesHead = newCapacity - numMoved;
+		}
+
+		capacity = newCapacity;
+	}
+
+	uint32 tail = mQueuedSamplesHead + mNumQueuedSamples;
+	if (tail >= capacity)
+		tail -= capacity;
+
+	mQueuedSamples[tail] = value;
+	mNumQueuedSamples++;
+}
+
+
 void Sensor::ClearQueuedSamples()
 { 
 	mQueuedSamplesLock.Lock();
-	mQueuedSamples.Clear(); 
+	mQueuedSamplesHead = 0;
+	mNumQueuedSamples = 0;
 	mQueuedSamplesLock.Unlock();
 }
 
@@ -221,10 +307,25 @@ void Sensor::ClearQueuedSamples()
 // compensate for lost samples by adding zero values and increase lostsample counter
 void Sensor::HandleLostSamples(uint32 numLostSamples)
 {
-	for (uint32 i=0; i<numLostSamples; ++i)
-		AddQueuedSample(0.0);
+	mQueuedSamplesLock.Lock();
+
+	// like a sample block, a gap larger than the whole queue only keeps its newest samples
+	uint32 numSamples = numLostSamples;
+	if (mMaxQueuedSamples > 0 && numSamples > mMaxQueuedSamples)
+	{
+		mNumDroppedSamples += numSamples - mMaxQueuedSamples;
+		numSamples = mMaxQueuedSamples;
+	}
+
+	if (mMaxQueuedSamples > 0)
+		DropQueuedSamples(numSamples);
+
+	for (uint32 i=0; i<numSamples; ++i)
+		PushQueuedSample(0.0);
 
 	mNumLostSamples += numLostSamples;
+
+	mQueuedSamplesLock.Unlock();
 }
 
 
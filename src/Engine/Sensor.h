@@ -32,6 +32,7 @@
 #include "Core/Mutex.h"
 #include "DSP/Channel.h"
 #include "DSP/ResampleProcessor.h"
+#include <atomic>
 
 
 // forward declaration
@@ -64,7 +65,13 @@ class ENGINE_API Sensor
 
 		// input sample queue
 		void AddQueuedSample(double value);
-		uint32 GetNumQueuedSamples() const										{ return mQueuedSamples.Size(); }
+		void AddQueuedSamples(const double* values, uint32 numValues);
+		uint32 GetNumQueuedSamples() const										{ mQueuedSamplesLock.Lock(); const uint32 numSamples = mNumQueuedSamples; mQueuedSamplesLock.Unlock(); return numSamples; }
+
+		// bound the input sample queue (0 = unbounded), the oldest samples are dropped if the engine does not drain the queue in time
+		void SetMaxQueuedSamples(uint32 maxSamples)								{ mQueuedSamplesLock.Lock(); mMaxQueuedSamples = maxSamples; mQueuedSamplesLock.Unlock(); }
+		uint32 GetMaxQueuedSamples() const										{ mQueuedSamplesLock.Lock(); const uint32 maxSamples = mMaxQueuedSamples; mQueuedSamplesLock.Unlock(); return maxSamples; }
+		uint32 GetNumDroppedSamples() const										{ return mNumDroppedSamples; }
 
 		// the output channel
 		Channel<double>* GetOutput()											{ return mResampler.GetOutput()->AsType<double>(); }
@@ -163,9 +170,16 @@ class ENGINE_API Sensor
 
 	private:
 
-		// the input sample queue
-		Core::Array<double> mQueuedSamples;			
-		Core::Mutex			mQueuedSamplesLock;		// lock for queued samples queue
+		// the input sample queue (ring buffer, so dropping the oldest samples of a full bounded queue does not move the others)
+		Core::Array<double> mQueuedSamples;			// ring storage, its size is the capacity
+		uint32				mQueuedSamplesHead;		// index of the oldest queued sample
+		uint32				mNumQueuedSamples;		// number of queued samples
+		mutable Core::Mutex	mQueuedSamplesLock;		// lock for queued samples queue (the acquisition thread adds while the engine reads)
+		uint32				mMaxQueuedSamples;		// queue bound (0 = unbounded)
+		std::atomic<uint32>	mNumDroppedSamples;		// samples dropped because the queue was full (read by the engine while the acquisition thread adds)
+	
+		void DropQueuedSamples(uint32 numNewSamples);	// make room for new samples in a bounded queue (lock must be held)
+		void PushQueuedSample(double value);			// append a sample to the ring, grows it if full (lock must be held)
 	
 		void FeedQueuedSamples();					// push queued samples into channel
 		void ClearQueuedSamples();					// remove all queued samples
@@ -178,7 +192,7 @@ class ENGINE_API Sensor
 		double		mRealSampleRate;				// the actual sample rate of the input stream that goes into the sensor
 		uint32		mNumDriftSamplesAdded;			// samples added to correct drift
 		uint32		mNumDriftSamplesRemoved;		// samples removed to correct drift
-		uint32		mNumLostSamples;
+		std::atomic<uint32>	mNumLostSamples;		// counted on the acquisition thread, read by the engine
 
 		// array of burst sizes of the last Update() calls for max burst delay calculation
 		Core::Array<uint32> mBursts;
@@ -0,0 +1,473 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Engine/Precompiled.h>
+
+// include required files
+#include "SensorRecording.h"
+#include "EngineManager.h"
+#include "Core/LogManager.h"
+
+using namespace Core;
+
+// serialization helpers (the engine only runs on little endian platforms)
+namespace
+{
+	template <class T>
+	void WriteValue(Array<uint8>& data, const T& value)
+	{
+		const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+		for (uint32 i=0; i<sizeof(T); ++i)
+			data.Add(bytes[i]);
+	}
+
+	void WriteString(Array<uint8>& data, const String& value)
+	{
+		const uint32 length = value.GetLength();
+		WriteValue(data, length);
+		for (uint32 i=0; i<length; ++i)
+			data.Add((uint8)value.AsChar()[i]);
+	}
+
+	// reads from a buffer, all reads after the first failed one fail as well
+	class Reader
+	{
+		public:
+			Reader(const Array<uint8>& data) : mData(data), mPosition(0), mIsValid(true)	{}
+
+			bool IsValid() const								{ return mIsValid; }
+
+			template <class T>
+			T Read()
+			{
+				T value = T();
+				if (Skip(sizeof(T)) == true)
+					memcpy(&value, mData.GetReadPtr() + mPosition - sizeof(T), sizeof(T));
+				return value;
+			}
+
+			String ReadString()
+			{
+				const uint32 length = Read<uint32>();
+				String result;
+				if (Skip(length) == true)
+					result.Copy((const char*)mData.GetReadPtr() + mPosition - length, length);
+				return result;
+			}
+
+			bool ReadDoubles(double* outValues, uint64 numValues)
+			{
+				if (numValues > (mData.Size() - mPosition) / sizeof(double))
+					mIsValid = false;
+				else if (Skip(numValues * sizeof(double)) == true)
+					memcpy(outValues, mData.GetReadPtr() + mPosition - numValues * sizeof(double), numValues * sizeof(double));
+				return mIsValid;
+			}
+
+		private:
+			bool Skip(uint64 numBytes)
+			{
+				if (mIsValid == false || numBytes > mData.Size() - mPosition)
+				{
+					mIsValid = false;
+					return false;
+				}
+
+				mPosition += numBytes;
+				return true;
+			}
+
+			const Array<uint8>&	mData;
+			uint64				mPosition;
+			bool				mIsValid;
+	};
+}
+
+
+// constructor
+SensorRecording::SensorRecording()
+{
+	mTime = 0;
+}
+
+
+// destructor
+SensorRecording::~SensorRecording()
+{
+}
+
+
+void SensorRecording::Clear()
+{
+	mDevices.Clear();
+	mRecordedDevices.Clear();
+	mUpdates.Clear();
+	mBlocks.Clear();
+	mSamples.Clear();
+	mTime = 0;
+}
+
+
+// copy the samples all devices received during the last update
+void SensorRecording::Record(const Time& delta)
+{
+	mTime += delta;
+
+	DeviceManager* deviceManager = GetDeviceManager();
+	const uint32 firstBlock = mBlocks.Size();
+
+	const uint32 numDevices = deviceManager->GetNumDevices();
+	for (uint32 d=0; d<numDevices; ++d)
+	{
+		Device* device = deviceManager->GetDevice(d);
+
+		uint32 deviceIndex = CORE_INVALIDINDEX32;
+		const uint32 numSensors = device->GetNumSensors();
+		for (uint32 s=0; s<numSensors; ++s)
+		{
+			Channel<double>* input = device->GetSensor(s)->GetInput();
+
+			// the new samples are the last ones in the input channel (unless the buffer was too small to hold them)
+			const uint64 numNewSamples = Min<uint64>( input->GetNumNewSamples(), input->GetNumSamples() );
+			if (numNewSamples == 0)
+				continue;
+
+			if (deviceIndex == CORE_INVALIDINDEX32)
+				deviceIndex = FindOrAddDevice(device);
+
+			Block block;
+			block.mDeviceIndex	= deviceIndex;
+			block.mSensorIndex	= s;
+			block.mNumSamples	= (uint32)numNewSamples;
+			block.mFirstSample	= mSamples.Size();
+			mBlocks.Add(block);
+
+			const uint64 endIndex = input->GetSampleCounter();
+			for (uint64 i=endIndex-numNewSamples; i<endIndex; ++i)
+				mSamples.Add( input->GetSample(i) );
+		}
+	}
+
+	// only updates that delivered samples are stored
+	if (mBlocks.Size() > firstBlock)
+	{
+		Update update;
+		update.mTime		= mTime;
+		update.mFirstBlock	= firstBlock;
+		update.mNumBlocks	= mBlocks.Size() - firstBlock;
+		mUpdates.Add(update);
+	}
+}
+
+
+// describe the device the first time it delivers samples
+uint32 SensorRecording::FindOrAddDevice(Device* device)
+{
+	const uint32 numDevices = mRecordedDevices.Size();
+	for (uint32 i=0; i<numDevices; ++i)
+		if (mRecordedDevices[i] == device && mDevices[i].mType == device->GetType() && mDevices[i].mDeviceID == device->GetDeviceID())
+			return i;
+
+	DeviceInfo info;
+	info.mType				= device->GetType();
+	info.mDeviceID			= device->GetDeviceID();
+	info.mIsBci				= (device->GetBaseType() == BciDevice::BASE_TYPE_ID);
+	info.mShowNeuroChannels	= false;
+	info.mUuid				= device->GetUuid();
+	info.mHardwareName		= device->GetHardwareName();
+	info.mTypeName			= device->GetTypeName();
+	info.mSampleRate		= 0.0;
+	info.mLatency			= device->GetLatency();
+	info.mExpectedJitter	= device->GetExpectedJitter();
+	info.mTimeoutLimit		= device->GetTimeoutLimit();
+	info.mNumNeuroSensors	= 0;
+
+	const BciDevice* headset = NULL;
+	if (info.mIsBci == true)
+	{
+		headset = static_cast<const BciDevice*>(device);
+		info.mShowNeuroChannels	= headset->ShowNeuroChannels();
+		info.mSampleRate		= headset->GetSampleRate();
+		info.mNumNeuroSensors	= headset->GetNumNeuroSensors();
+	}
+
+	const uint32 numSensors = device->GetNumSensors();
+	info.mSensors.Resize(numSensors);
+	for (uint32 i=0; i<numSensors; ++i)
+	{
+		Sensor* sensor = device->GetSensor(i);
+		SensorInfo& sensorInfo = info.mSensors[i];
+
+		sensorInfo.mName				= sensor->GetName();
+		sensorInfo.mUnit				= sensor->GetOutput()->GetUnit();
+		sensorInfo.mIsInput				= false;
+		sensorInfo.mUseDriftCorrection	= sensor->GetDriftCorrectionEnabled();
+		sensorInfo.mSampleRate			= sensor->GetSampleRate();
+		sensorInfo.mInputSampleRate		= sensor->GetInput()->GetSampleRate();
+		sensorInfo.mMinValue			= sensor->GetOutput()->GetMinValue();
+		sensorInfo.mMaxValue			= sensor->GetOutput()->GetMaxValue();
+		sensorInfo.mInputBufferSize		= sensor->GetInput()->GetBufferSize();
+		sensorInfo.mOutputBufferSize	= sensor->GetOutput()->GetBufferSize();
+		sensorInfo.mTheta				= 0.0;
+		sensorInfo.mPhi					= 0.0;
+
+		const uint32 numInputSensors = device->GetNumInputSensors();
+		for (uint32 j=0; j<numInputSensors; ++j)
+			if (device->GetInputSensor(j) == sensor)
+				sensorInfo.mIsInput = true;
+
+		if (i < info.mNumNeuroSensors)
+		{
+			const EEGElectrodes::Electrode electrode = headset->GetElectrodePosition(i);
+			sensorInfo.mTheta	= electrode.GetTheta();
+			sensorInfo.mPhi		= electrode.GetPhi();
+		}
+	}
+
+	mDevices.Add(info);
+	mRecordedDevices.Add(device);
+	return mDevices.Size() - 1;
+}
+
+
+bool SensorRecording::SaveToDisk(const char* filename) const
+{
+	Array<uint8> data;
+	data.Reserve( 64 + mUpdates.Size() * 16 + mBlocks.Size() * 12 + mSamples.Size() * sizeof(double) );
+
+	// header
+	WriteValue<uint32>(data, MAGIC);
+	WriteValue<uint16>(data, VERSION);
+	WriteValue<uint16>(data, 0);
+	WriteValue<uint32>(data, mDevices.Size());
+	WriteValue<uint32>(data, mUpdates.Size());
+	WriteValue<uint32>(data, mBlocks.Size());
+	WriteValue<uint64>(data, mSamples.Size());
+	WriteValue<uint64>(data, mTime.mSeconds);
+	WriteValue<uint32>(data, mTime.mNanoSeconds);
+
+	// devices
+	const uint32 numDevices = mDevices.Size();
+	for (uint32 i=0; i<numDevices; ++i)
+	{
+		const DeviceInfo& info = mDevices[i];
+		WriteValue<uint32>(data, info.mType);
+		WriteValue<uint32>(data, info.mDeviceID);
+		WriteValue<uint8>(data, info.mIsBci);
+		WriteValue<uint8>(data, info.mShowNeuroChannels);
+		WriteString(data, info.mUuid);
+		WriteString(data, info.mHardwareName);
+		WriteString(data, info.mTypeName);
+		WriteValue<double>(data, info.mSampleRate);
+		WriteValue<double>(data, info.mLatency);
+		WriteValue<double>(data, info.mExpectedJitter);
+		WriteValue<double>(data, info.mTimeoutLimit);
+		WriteValue<uint32>(data, info.mNumNeuroSensors);
+
+		const uint32 numSensors = info.mSensors.Size();
+		WriteValue<uint32>(data, numSensors);
+		for (uint32 j=0; j<numSensors; ++j)
+		{
+			const SensorInfo& sensorInfo = info.mSensors[j];
+			WriteString(data, sensorInfo.mName);
+			WriteString(data, sensorInfo.mUnit);
+			WriteValue<uint8>(data, sensorInfo.mIsInput);
+			WriteValue<uint8>(data, sensorInfo.mUseDriftCorrection);
+			WriteValue<double>(data, sensorInfo.mSampleRate);
+			WriteValue<double>(data, sensorInfo.mInputSampleRate);
+			WriteValue<double>(data, sensorInfo.mMinValue);
+			WriteValue<double>(data, sensorInfo.mMaxValue);
+			WriteValue<uint32>(data, sensorInfo.mInputBufferSize);
+			WriteValue<uint32>(data, sensorInfo.mOutputBufferSize);
+			WriteValue<double>(data, sensorInfo.mTheta);
+			WriteValue<double>(data, sensorInfo.mPhi);
+		}
+	}
+
+	// updates and blocks (the block sample offsets follow from the sample counts)
+	const uint32 numUpdates = mUpdates.Size();
+	for (uint32 i=0; i<numUpdates; ++i)
+	{
+		WriteValue<uint64>(data, mUpdates[i].mTime.mSeconds);
+		WriteValue<uint32>(data, mUpdates[i].mTime.mNanoSeconds);
+		WriteValue<uint32>(data, mUpdates[i].mNumBlocks);
+	}
+
+	const uint32 numBlocks = mBlocks.Size();
+	for (uint32 i=0; i<numBlocks; ++i)
+	{
+		WriteValue<uint32>(data, mBlocks[i].mDeviceIndex);
+		WriteValue<uint32>(data, mBlocks[i].mSensorIndex);
+		WriteValue<uint32>(data, mBlocks[i].mNumSamples);
+	}
+
+	FILE* file = fopen(filename, "wb");
+	if (file == NULL)
+	{
+		LogError("Cannot save sensor recording to '%s'. Opening file in write mode failed.", filename);
+		return false;
+	}
+
+	bool result = (fwrite(data.GetReadPtr(), 1, data.Size(), file) == data.Size());
+	if (mSamples.IsEmpty() == false)
+		result &= (fwrite(mSamples.GetReadPtr(), sizeof(double), mSamples.Size(), file) == mSamples.Size());
+
+	fclose(file);
+	return result;
+}
+
+
+bool SensorRecording::LoadFromDisk(const char* filename)
+{
+	Clear();
+
+	FILE* file = fopen(filename, "rb");
+	if (file == NULL)
+	{
+		LogError("Cannot load '%s'. Opening file in read mode failed.", filename);
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	const long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	Array<uint8> data;
+	data.Resize(fileSize > 0 ? (uint32)fileSize : 0);
+	const bool readResult = (data.IsEmpty() == false && fread(data.GetPtr(), 1, data.Size(), file) == data.Size());
+	fclose(file);
+
+	if (readResult == false)
+	{
+		LogError("Cannot load '%s'. Reading the file failed.", filename);
+		return false;
+	}
+
+	Reader reader(data);
+	const uint32 magic		= reader.Read<uint32>();
+	const uint16 version	= reader.Read<uint16>();
+	reader.Read<uint16>();
+	if (reader.IsValid() == false || magic != MAGIC || version != VERSION)
+	{
+		LogError("Cannot load '%s'. The file is not a sensor recording or was written by a different version.", filename);
+		return false;
+	}
+
+	const uint32 numDevices	= reader.Read<uint32>();
+	const uint32 numUpdates	= reader.Read<uint32>();
+	const uint32 numBlocks	= reader.Read<uint32>();
+	const uint64 numSamples	= reader.Read<uint64>();
+	const uint64 seconds	= reader.Read<uint64>();
+	const uint32 nanoSeconds = reader.Read<uint32>();
+
+	// devices
+	for (uint32 i=0; i<numDevices && reader.IsValid() == true; ++i)
+	{
+		DeviceInfo info;
+		info.mType				= reader.Read<uint32>();
+		info.mDeviceID			= reader.Read<uint32>();
+		info.mIsBci				= (reader.Read<uint8>() != 0);
+		info.mShowNeuroChannels	= (reader.Read<uint8>() != 0);
+		info.mUuid				= reader.ReadString();
+		info.mHardwareName		= reader.ReadString();
+		info.mTypeName			= reader.ReadString();
+		info.mSampleRate		= reader.Read<double>();
+		info.mLatency			= reader.Read<double>();
+		info.mExpectedJitter	= reader.Read<double>();
+		info.mTimeoutLimit		= reader.Read<double>();
+		info.mNumNeuroSensors	= reader.Read<uint32>();
+
+		const uint32 numSensors = reader.Read<uint32>();
+		for (uint32 j=0; j<numSensors && reader.IsValid() == true; ++j)
+		{
+			SensorInfo sensorInfo;
+			sensorInfo.mName				= reader.ReadString();
+			sensorInfo.mUnit				= reader.ReadString();
+			sensorInfo.mIsInput				= (reader.Read<uint8>() != 0);
+			sensorInfo.mUseDriftCorrection	= (reader.Read<uint8>() != 0);
+			sensorInfo.mSampleRate			= reader.Read<double>();
+			sensorInfo.mInputSampleRate		= reader.Read<double>();
+			sensorInfo.mMinValue			= reader.Read<double>();
+			sensorInfo.mMaxValue			= reader.Read<double>();
+			sensorInfo.mInputBufferSize		= reader.Read<uint32>();
+			sensorInfo.mOutputBufferSize	= reader.Read<uint32>();
+			sensorInfo.mTheta				= reader.Read<double>();
+			sensorInfo.mPhi					= reader.Read<double>();
+			info.mSensors.Add(sensorInfo);
+		}
+
+		if (info.mNumNeuroSensors > info.mSensors.Size())
+			info.mNumNeuroSensors = info.mSensors.Size();
+
+		mDevices.Add(info);
+	}
+
+	// updates
+	uint32 blockIndex = 0;
+	for (uint32 i=0; i<numUpdates && reader.IsValid() == true; ++i)
+	{
+		Update update;
+		update.mTime.mSeconds		= reader.Read<uint64>();
+		update.mTime.mNanoSeconds	= reader.Read<uint32>();
+		update.mFirstBlock			= blockIndex;
+		update.mNumBlocks			= reader.Read<uint32>();
+		mUpdates.Add(update);
+
+		blockIndex += update.mNumBlocks;
+	}
+
+	// blocks
+	uint64 sampleIndex = 0;
+	bool isConsistent = (blockIndex == numBlocks);
+	for (uint32 i=0; i<numBlocks && reader.IsValid() == true && isConsistent == true; ++i)
+	{
+		Block block;
+		block.mDeviceIndex	= reader.Read<uint32>();
+		block.mSensorIndex	= reader.Read<uint32>();
+		block.mNumSamples	= reader.Read<uint32>();
+		block.mFirstSample	= sampleIndex;
+		mBlocks.Add(block);
+
+		sampleIndex += block.mNumSamples;
+		isConsistent = (block.mDeviceIndex < mDevices.Size() && block.mSensorIndex < mDevices[block.mDeviceIndex].mSensors.Size());
+	}
+
+	// samples
+	isConsistent &= (sampleIndex == numSamples && numSamples <= CORE_INT32_MAX);
+	if (isConsistent == true && reader.IsValid() == true)
+	{
+		mSamples.Resize((uint32)numSamples);
+		reader.ReadDoubles(mSamples.GetPtr(), numSamples);
+	}
+
+	if (isConsistent == false || reader.IsValid() == false)
+	{
+		LogError("Cannot load '%s'. The sensor recording is corrupt.", filename);
+		Clear();
+		return false;
+	}
+
+	mTime = Time(seconds, nanoSeconds);
+	return true;
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SENSORRECORDING_H
+#define __NEUROMORE_SENSORRECORDING_H
+
+// include required headers
+#include "Config.h"
+#include "Core/StandardHeaders.h"
+#include "Core/String.h"
+#include "Core/Array.h"
+#include "Core/Time.h"
+
+// forward declaration
+class Device;
+
+
+// raw sensor input of a session with the exact time each sample block arrived
+// The recording is fed by the engine after every device update. The time is the sum of the update deltas (not the engine time, which
+// restarts on every sync), so a replay that gets the same update deltas delivers every block during the same update as the original session.
+//
+// file layout (.nmr, little endian):
+//   uint32 magic ('NMRC'), uint16 version, uint16 flags, uint32 numDevices, uint32 numUpdates, uint32 numBlocks, uint64 numSamples, uint64 seconds, uint32 nanoseconds
+//   per device: type, ID, flags, strings and parameters, uint32 numSensors, per sensor: name, unit, rates, range, buffer sizes, electrode position
+//   per update: uint64 seconds, uint32 nanoseconds, uint32 numBlocks
+//   per block: uint32 device, uint32 sensor, uint32 numSamples
+//   all samples as doubles, block after block
+class ENGINE_API SensorRecording
+{
+	public:
+		enum
+		{
+			MAGIC		= 0x43524D4E,	// 'NMRC'
+			VERSION		= 1
+		};
+
+		// sensor setup, enough to recreate a sensor with the same channels
+		struct SensorInfo
+		{
+			Core::String	mName;
+			Core::String	mUnit;
+			bool			mIsInput;
+			bool			mUseDriftCorrection;
+			double			mSampleRate;			// output sample rate
+			double			mInputSampleRate;		// 0 for irregular input
+			double			mMinValue;
+			double			mMaxValue;
+			uint32			mInputBufferSize;
+			uint32			mOutputBufferSize;
+			double			mTheta;					// electrode position (neuro sensors only)
+			double			mPhi;
+		};
+
+		// device setup, the replay device reports the same type, ID and sensor layout
+		struct DeviceInfo
+		{
+			uint32			mType;
+			uint32			mDeviceID;
+			bool			mIsBci;
+			bool			mShowNeuroChannels;
+			Core::String	mUuid;
+			Core::String	mHardwareName;
+			Core::String	mTypeName;
+			double			mSampleRate;			// sample rate of the neuro sensors (BCIs only)
+			double			mLatency;
+			double			mExpectedJitter;
+			double			mTimeoutLimit;
+			uint32			mNumNeuroSensors;		// the neuro sensors come first
+			Core::Array<SensorInfo> mSensors;
+		};
+
+		// samples of one sensor that arrived during an update
+		struct Block
+		{
+			uint32			mDeviceIndex;
+			uint32			mSensorIndex;
+			uint32			mNumSamples;
+			uint64			mFirstSample;			// index into the sample array
+		};
+
+		// an engine update that delivered samples
+		struct Update
+		{
+			Core::Time		mTime;
+			uint32			mFirstBlock;
+			uint32			mNumBlocks;
+		};
+
+		// constructor & destructor
+		SensorRecording();
+		~SensorRecording();
+
+		void Clear();
+
+		// called by the engine after the device update
+		void Record(const Core::Time& delta);
+
+		// duration of the recording
+		const Core::Time& GetTime() const										{ return mTime; }
+
+		// access the data
+		uint32 GetNumDevices() const											{ return mDevices.Size(); }
+		const DeviceInfo& GetDevice(uint32 index) const							{ return mDevices[index]; }
+		uint32 GetNumUpdates() const											{ return mUpdates.Size(); }
+		const Update& GetUpdate(uint32 index) const								{ return mUpdates[index]; }
+		const Block& GetBlock(uint32 index) const								{ return mBlocks[index]; }
+		const double* GetSamples(const Block& block) const						{ return mSamples.GetReadPtr() + block.mFirstSample; }
+		uint64 GetNumSamples() const											{ return mSamples.Size(); }
+
+		// files on disk
+		bool SaveToDisk(const char* filename) const;
+		bool LoadFromDisk(const char* filename);
+
+	private:
+		// index of the device in the recording, describes the device if it was not recorded yet
+		uint32 FindOrAddDevice(Device* device);
+
+		Core::Array<DeviceInfo>		mDevices;
+		Core::Array<Device*>		mRecordedDevices;		// live devices behind mDevices (only valid while recording)
+		Core::Array<Update>			mUpdates;
+		Core::Array<Block>			mBlocks;
+		Core::Array<double>			mSamples;
+		Core::Time					mTime;
+};
+
+
+#endif
@@ -28,14 +28,19 @@
 #include "SessionExporter.h"
 #include "Core/LogManager.h"
 #include "EngineManager.h"
+#include "NmdCompressor.h"
 
 
 using namespace Core;
 
 // save session
-bool SessionExporter::Save(const char* folderPath, const char* userId, const char* dataChunkId)
+bool SessionExporter::Save(const char* folderPath, const char* userId, const char* dataChunkId, bool compress)
 {
-	String filename, jsonFilename, nmdFilename;
+	String filename, jsonFilename;
+
+	// the sample files are written in parallel after all json files are written
+	Array<Channel<double>*> channels;
+	Array<String> nmdFilenames;
 
 	// get the active classifier
 	Classifier* classifier = GetEngine()->GetActiveClassifier();
@@ -64,30 +69,21 @@ bool SessionExporter::Save(const char* folderPath, const char* userId, const cha
 			jsonFilename = filename + ".json";
 			SaveChannelJsonToDisk(jsonFilename.AsChar(), userId, dataChunkId, classifier->GetUuid(), feedbackNode->GetUuid(), channel);
 
-			// save biodata to a binary file
-			nmdFilename = filename + ".nmd";
-			SaveSamplesToDisk(nmdFilename.AsChar(), channel);
-
-
-			/*uint32 numSamplesInChunk = channel->GetSampleRate() * 10;
-
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Float4Byte.nmd", channel, numSamplesInChunk, NmdFileFormat::FLOATINGPOINT_4BYTE, false);
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Float4Byte_Compressed.nmd", channel, numSamplesInChunk, NmdFileFormat::FLOATINGPOINT_4BYTE, true);
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Float8Byte.nmd", channel, numSamplesInChunk, NmdFileFormat::FLOATINGPOINT_8BYTE, false);
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Float8Byte_Compressed.nmd", channel, numSamplesInChunk, NmdFileFormat::FLOATINGPOINT_8BYTE, true);
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Quant1Byte.nmd", channel, numSamplesInChunk, NmdFileFormat::QUANTIZATION_1BYTE, false);
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Quant1Byte_Compressed.nmd", channel, numSamplesInChunk, NmdFileFormat::QUANTIZATION_1BYTE, true);
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Quant2Byte.nmd", channel, numSamplesInChunk, NmdFileFormat::QUANTIZATION_2BYTE, false);
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Quant2Byte_Compressed.nmd", channel, numSamplesInChunk, NmdFileFormat::QUANTIZATION_2BYTE, true);
-
-			NmdExporter::SaveSamplesToDisk("D:\\NmdTest_Temp.nmd", channel, numSamplesInChunk, NmdFileFormat::FLOATINGPOINT_4BYTE, false);
-			NmdImporter importer;
-			bool loadRes = importer.LoadFromDisk("D:\\NmdTest_Temp.nmd");
-			LogInfo("Loading result = %i", loadRes);*/
+			// save biodata to a binary file (below)
+			channels.Add(channel);
+			nmdFilenames.Add(filename + ".nmd");
 		}
 	}
 
-	return true;
+	// one channel per worker thread, so only a few channels are held in float format at the same time
+	std::atomic<bool> result(true);
+	NmdCompressor::ParallelFor( channels.Size(), 0, [&](uint32 index)
+	{
+		if (SaveSamplesToDisk(nmdFilenames[index].AsChar(), channels[index], compress, 1) == false)
+			result = false;
+	});
+
+	return result;
 }
 
 
@@ -149,31 +145,35 @@ bool SessionExporter::SaveChannelJsonToDisk(const char* filename, const char* us
 }
 
 
-// save biodata (raw samples) to disk
-bool SessionExporter::SaveSamplesToDisk(const char* filename, Channel<double>* channel)
+// save biodata (samples as floats) to disk
+bool SessionExporter::SaveSamplesToDisk(const char* filename, Channel<double>* channel, bool compress, uint32 numThreads)
 {
-	// create the file on disk
-	FILE* file;
-	file = fopen(filename, "wb\0");
-	if (file == NULL)
-	{
-		LogError("Cannot save channel to '%s'. Opening file in write mode failed.", filename);
-		return false;
-	}
-
-	// save the samples
+	// convert the samples
 	const uint32 numSamples = channel->GetNumSamples();
-	fwrite( &numSamples, 1, sizeof(uint32), file );
 
-	// iterate through and save the samples
-	for (uint32 i=0; i<numSamples; ++i)
+	Array<float> samples;
+	samples.Resize(numSamples);
+
+	// chunk by chunk: the workers read different channels at the same time, with disk-backed storage the access of one worker must not spill the chunk another one reads
+	const uint32 chunkSize = Max<uint32>(1, channel->GetNumChunkSamples());
+	uint32 i = 0;
+	while (i < numSamples)
 	{
-		const float value = channel->GetSample(i);
-		fwrite( &value, 1, sizeof(float), file );
+		const uint32 chunkEnd = Min<uint32>(numSamples, (i / chunkSize + 1) * chunkSize);
+
+		channel->PinChunk(i);
+		for (uint32 j=i; j<chunkEnd; ++j)
+			samples[j] = channel->GetSample(j);
+		channel->UnpinChunk(i);
+
+		i = chunkEnd;
 	}
 
-	fclose(file);
-	return true;
+	// write them with a single write
+	if (compress == true)
+		return NmdCompressor::SaveToDisk( filename, samples.GetReadPtr(), numSamples, NmdCompressor::DEFAULT_CHUNKSAMPLES, numThreads );
+	else
+		return NmdCompressor::SaveUncompressedToDisk( filename, samples.GetReadPtr(), numSamples );
 }
 
 
@@ -36,7 +36,9 @@
 class ENGINE_API SessionExporter
 {
 	public:
-		static bool Save(const char* folderPath, const char* userId, const char* dataChunkId);
+		// writes a .json/.nmd pair per uploaded feedback channel on worker threads
+		// the .nmd files stay raw unless compression is requested (see NmdCompressor), the backend does not accept compressed uploads yet
+		static bool Save(const char* folderPath, const char* userId, const char* dataChunkId, bool compress=false);
 
 		// data chunk
 		static bool GenerateDataChunkJson(Core::Json& json, Core::Json::Item& item, const char* userId, const char* supervisorId, const char* debitorId, const char* classifierId, uint32 classifierRevision, const Core::String& stateMachineId, uint32 stateMachineRevision, const Core::String& experienceId, uint32 experienceRevision, const Core::String& startDateTime, const Core::String& stopDateTime);
@@ -46,7 +48,7 @@ class ENGINE_API SessionExporter
 		static bool SaveChannelJsonToDisk(const char* filename, const char* userId, const char* dataChunkId, const char* classifierUuid, const char* nodeUuid, Channel<double>* channel);
 
 		// sample helpers
-		static bool SaveSamplesToDisk(const char* filename, Channel<double>* channel);
+		static bool SaveSamplesToDisk(const char* filename, Channel<double>* channel, bool compress=false, uint32 numThreads=0);
 		static bool SaveSamplesToMemoryFile(Core::MemoryFile* outFile, Channel<double>* channel);
 		static void SaveSamples(Core::MemoryFile* file, Channel<double>* channel);
 };
@@ -30,6 +30,7 @@
 #include "Core/Json.h"
 #include "Core/FpsCounter.h"
 #include "Core/LogManager.h"
+#include "Core/SeqLock.h"
 #include "EngineManager.h"
 #include "CloudParameters.h"
 #include "SessionExporter.h"
@@ -105,6 +106,9 @@ class FeedbacksData
 				mData[i].Reset();
 			}
 
+			// the snapshot covers all feedbacks of the classifier (the lock serializes this with the publish)
+			mSnapshot.Reserve(newNumFeedbacks);
+
 			mLock.Unlock();
 		}
 
@@ -131,9 +135,39 @@ class FeedbacksData
 		double GetFeedbackMaxValue(uint32 index)					{ double result = 0.0; mLock.Lock(); const uint32 numFeedbacks = mData.Size(); if(index < numFeedbacks) result = mData[index].mMaxValue; mLock.Unlock(); return result; }
 		const char* GetFeedbackName(uint32 index)					{ const char* result = NULL; mLock.Lock(); const uint32 numFeedbacks = mData.Size(); if(index < numFeedbacks) result = mData[index].mName.AsChar(); mLock.Unlock(); return result; }
 
+		// publish the current values to the snapshot readers (the lock only serializes the writers)
+		void PublishSnapshot(double timestamp)
+		{
+			mLock.Lock();
+
+			const uint32 numFeedbacks = mData.Size();
+			mSnapshotValues.Resize(numFeedbacks);
+			for (uint32 i=0; i<numFeedbacks; ++i)
+				mSnapshotValues[i] = mData[i].mValue;
+
+			mSnapshot.Publish(mSnapshotValues.GetReadPtr(), numFeedbacks, timestamp);
+
+			mLock.Unlock();
+		}
+
+		// lock-free, never blocks the engine thread
+		uint32 GetSnapshot(double* outValues, uint32 maxValues, double* outTimestamp) const	{ return mSnapshot.Read(outValues, maxValues, outTimestamp); }
+
+		// lock-free, zero for feedbacks that are not part of the latest snapshot (e.g. before the first publish)
+		double GetSnapshotValue(uint32 index) const
+		{
+			double result = 0.0;
+			mSnapshot.ReadValue(index, result);
+			return result;
+		}
+
 	private:
 		Mutex						mLock;
 		Core::Array<FeedbackData>	mData;
+
+		// last published values
+		Core::Array<double>			mSnapshotValues;
+		SeqLockArray<double>		mSnapshot;
 };
 
 class NMEngineData
@@ -158,6 +192,9 @@ class NMEngineData
 		// for creating jsons strings
 		String mTempJsonString;
 
+		// profiler statistics of the last UpdateProfilerStatistics() call
+		Array<Profiler::ScopeStatistics> mProfilerStatistics;
+
 		// performance statistics (thread safe operation)
 		PerformanceStatistics GetPerformanceStatistics()																{ mPerformanceStatisticsLock.Lock(); PerformanceStatistics result = mPerformanceStatistics; mPerformanceStatisticsLock.Unlock(); return result; }
 		void SetPerformanceStatistics(PerformanceStatistics stats)														{ mPerformanceStatisticsLock.Lock(); mPerformanceStatistics = stats; mPerformanceStatisticsLock.Unlock(); }
@@ -174,7 +211,18 @@ class NMEngineData
 class NMEngineEventHandler : public Core::EventHandler
 {
 	public:
-		NMEngineEventHandler() : EventHandler()																			{}
+		NMEngineEventHandler() : EventHandler()
+		{
+			// only receive the events we forward to the callback
+			UnsubscribeAllEvents();
+			const EEventType events[] = { EVENT_PLAYAUDIO, EVENT_STOPAUDIO, EVENT_PAUSEAUDIO, EVENT_SEEKAUDIO, EVENT_PLAYVIDEO, EVENT_STOPVIDEO, EVENT_PAUSEVIDEO, EVENT_SEEKVIDEO,
+										  EVENT_SHOWIMAGE, EVENT_HIDEIMAGE, EVENT_SHOWTEXT, EVENT_HIDETEXT, EVENT_SETFOURZONEAVECOLORS, EVENT_HIDEFOURZONEAVE, EVENT_SHOWBUTTON, EVENT_CLEARBUTTONS,
+										  EVENT_COMMAND, EVENT_EXITSTATEREACHED };
+			const uint32 numEvents = sizeof(events) / sizeof(EEventType);
+			for (uint32 i=0; i<numEvents; ++i)
+				SubscribeEvent( events[i] );
+		}
+
 		virtual ~NMEngineEventHandler()																						{}
 
 		void OnPlayAudio(const char* url, int32 numLoops, double beginAt, double volume, bool allowStream) override final	{ if (gCallback) gCallback->OnPlayAudio(url, numLoops, beginAt, volume); }
@@ -253,6 +301,9 @@ void UpdateFeedbackData()
 			const double maxValue = node->GetRangeMax();
 			gNMEngineData->mFeedbackData.SetFeedbackData(i, node->GetName(), node->GetCurrentValue(), minValue, maxValue );
 		}
+
+		// one consistent snapshot per update
+		gNMEngineData->mFeedbackData.PublishSnapshot( engine->GetElapsedTime().InSeconds() );
 	}
 }
 
@@ -698,6 +749,55 @@ BOOL GetPerformanceStatistics(double* outFps, double* outTheoreticalFps, double*
 }
 
 
+void EnableProfiling(BOOL enable)
+{
+	EngineManager* engine = GetEngine();
+	if (engine != NULL)
+		engine->GetProfiler().SetEnabled(enable);
+}
+
+
+int UpdateProfilerStatistics(double windowSeconds)
+{
+	EngineManager* engine = GetEngine();
+	if (engine == NULL || gNMEngineData == NULL)
+		return 0;
+
+	engine->GetProfiler().CollectStatistics( gNMEngineData->mProfilerStatistics, windowSeconds );
+	return gNMEngineData->mProfilerStatistics.Size();
+}
+
+
+BOOL GetProfilerStatistics(int index, const char** outName, int* outNumCalls, double* outTotalTime, double* outAverageTime, double* outMaxTime, double* outNumSamplesIn, double* outNumSamplesOut, double* outNumAllocations)
+{
+	if (gNMEngineData == NULL || index < 0 || index >= (int)gNMEngineData->mProfilerStatistics.Size())
+		return FALSE;
+
+	const Profiler::ScopeStatistics& stats = gNMEngineData->mProfilerStatistics[index];
+
+	*outName			= stats.mName.AsChar();
+	*outNumCalls		= stats.mNumCalls;
+	*outTotalTime		= stats.mTotalTime;
+	*outAverageTime		= stats.mAverageTime;
+	*outMaxTime			= stats.mMaxTime;
+	*outNumSamplesIn	= (double)stats.mNumSamplesIn;
+	*outNumSamplesOut	= (double)stats.mNumSamplesOut;
+	*outNumAllocations	= (double)stats.mNumAllocations;
+
+	return TRUE;
+}
+
+
+BOOL ExportProfilerTrace(const char* filename, double windowSeconds)
+{
+	EngineManager* engine = GetEngine();
+	if (engine == NULL)
+		return FALSE;
+
+	return engine->GetProfiler().ExportChromeTrace(filename, windowSeconds) ? TRUE : FALSE;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helpers
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1128,10 +1228,24 @@ double GetCurrentFeedbackValue(int index)
 	if (gNMEngineData == NULL)
 		return 0.0;
 
-	if (index >= (int)gNMEngineData->mFeedbackData.GetNumFeedbacks())
+	if (index < 0)
 		return 0.0;
 
-	return gNMEngineData->mFeedbackData.GetFeedbackValue(index);
+	// read from the snapshot, never takes the feedback lock
+	return gNMEngineData->mFeedbackData.GetSnapshotValue(index);
+}
+
+
+// get all feedback values of the same engine update
+int GetFeedbackSnapshot(double* outValues, int maxValues, double* outTimestamp)
+{
+	if (outTimestamp != NULL)
+		*outTimestamp = 0.0;
+
+	if (gNMEngineData == NULL || (outValues == NULL && maxValues > 0))
+		return 0;
+
+	return gNMEngineData->mFeedbackData.GetSnapshot(outValues, maxValues > 0 ? maxValues : 0, outTimestamp);
 }
 
 
@@ -134,6 +134,32 @@ namespace neuromoreEngine
    **/
    NEUROMORE_EXPORT BOOL GetPerformanceStatistics(double* outFps, double* outTheoreticalFps, double* outAveragedTiming, double* outBestCaseTiming, double* outWorstCaseTiming);
 
+   /**
+   * Enable or disable the per-node profiler.
+   * While enabled, every node update records its cycle count, the number of samples in and out and the number of heap allocations into per-thread ring buffers. Disabled by default.
+   */
+   NEUROMORE_EXPORT void EnableProfiling(BOOL enable);
+
+   /**
+   * Aggregate the profiler events of the last seconds per node (and per engine update stage), sorted by total time, most expensive first.
+   * @param windowSeconds The time window in seconds.
+   * @return The number of entries that can be accessed with GetProfilerStatistics().
+   */
+   NEUROMORE_EXPORT int UpdateProfilerStatistics(double windowSeconds);
+
+   /**
+   * Get an entry of the statistics aggregated by the last UpdateProfilerStatistics() call. Times are in seconds.
+   * The name stays valid until the next call of UpdateProfilerStatistics().
+   * @return false in case the index is out of range.
+   */
+   NEUROMORE_EXPORT BOOL GetProfilerStatistics(int index, const char** outName, int* outNumCalls, double* outTotalTime, double* outAverageTime, double* outMaxTime, double* outNumSamplesIn, double* outNumSamplesOut, double* outNumAllocations);
+
+   /**
+   * Export the profiler events of the last seconds in the Chrome trace event format (open with chrome://tracing or ui.perfetto.dev).
+   * @return false in case the file could not be written.
+   */
+   NEUROMORE_EXPORT BOOL ExportProfilerTrace(const char* filename, double windowSeconds);
+
    /**
    * Check if the engine is currently running. 
    * Note that you cannot modify the engine in any way during runtime.
@@ -343,6 +369,17 @@ namespace neuromoreEngine
    */
    NEUROMORE_EXPORT double GetCurrentFeedbackValue(int index);
 
+   /**
+   * Get the current values of all feedback nodes with a single call.
+   * The engine publishes the values once per update, so all values belong to the same update. Reading never takes a lock and never blocks the engine thread.
+   * The snapshot covers all feedback nodes of the active classifier.
+   * @param[out] outValues     Array receiving the values, indexed like the custom feedback nodes.
+   * @param[in]  maxValues     The size of outValues. Further values are skipped.
+   * @param[out] outTimestamp  The engine time in seconds of the update the values belong to. Can be NULL.
+   * @return The number of feedbacks in the snapshot, which can be larger than maxValues. 0 in case nothing has been published yet.
+   */
+   NEUROMORE_EXPORT int GetFeedbackSnapshot(double* outValues, int maxValues, double* outTimestamp);
+
    /**
    * Get the value range of a feedback
    * @param[in]  index		  The index of the custom feedback node from which we want to know the value range. The index has to be in range of [0, GetNumFeedbacks()].
@@ -94,7 +94,8 @@ public class Wrapper
     public static native int GetNumFeedbacks();
     public static native String GetFeedbackName(int index);
     public static native double GetCurrentFeedbackValue(int index);
-    //public static native void GetFeedbackRange();
+    public static native int GetFeedbackSnapshot(double[] values, double[] timestamp); // all values of one engine update, timestamp[0] receives the engine time (can be null)
+    public static native void GetFeedbackRange(int index, double[] range); // range[0] = min, range[1] = max
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Cloud Data Serialization
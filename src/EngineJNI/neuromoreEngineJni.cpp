@@ -610,11 +610,39 @@ extern "C"
       return neuromoreEngine::GetCurrentFeedbackValue(index);
    }
 
-   /*JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_GetFeedbackRange(JNIEnv* env, jobject thiz, jint index, jdoubleArray values)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetFeedbackSnapshot(JNIEnv* env, jobject thiz, jdoubleArray values, jdoubleArray timestamp)
    {
-      env->doublearray
-      //neuromoreEngine::GetFeedbackRange(index, values, value);
-   }*/
+      double time = 0.0;
+      int result = 0;
+
+      // write straight into the java array, no allocation and no JNI calls while it is pinned
+      const jsize length = values ? env->GetArrayLength(values) : 0;
+      if (length > 0)
+      {
+         jdouble* data = (jdouble*)env->GetPrimitiveArrayCritical(values, NULL);
+         if (data)
+         {
+            result = neuromoreEngine::GetFeedbackSnapshot(data, length, &time);
+            env->ReleasePrimitiveArrayCritical(values, data, 0);
+         }
+      }
+      else
+         result = neuromoreEngine::GetFeedbackSnapshot(NULL, 0, &time);
+
+      if (timestamp && env->GetArrayLength(timestamp) > 0)
+         env->SetDoubleArrayRegion(timestamp, 0, 1, &time);
+
+      return result;
+   }
+
+   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_GetFeedbackRange(JNIEnv* env, jobject thiz, jint index, jdoubleArray range)
+   {
+      double minmax[2];
+      neuromoreEngine::GetFeedbackRange(index, &minmax[0], &minmax[1]);
+
+      if (range && env->GetArrayLength(range) >= 2)
+         env->SetDoubleArrayRegion(range, 0, 2, minmax);
+   }
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // Cloud Data Serialization
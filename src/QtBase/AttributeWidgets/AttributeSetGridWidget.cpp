@@ -28,6 +28,9 @@ AttributeSetGridWidget::AttributeSetGridWidget(QWidget* parent) : QWidget(parent
 	connect(mPropertyManager, SIGNAL(PropertyAdded(const char*, Property*)), this, SLOT(OnPropertyAdded(const char*, Property*)));
 
 	// register event handler
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_ATTRIBUTEUPDATED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// init
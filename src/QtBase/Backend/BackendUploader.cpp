@@ -13,6 +13,7 @@
 #include <Core/Json.h>
 #include <EngineManager.h>
 #include <License.h>
+#include <NmdCompressor.h>
 #include <Core/EventManager.h>
 #include <Core/Timer.h>
 #include "../QtBaseManager.h"
@@ -121,7 +122,18 @@ void BackendUploader::StartUpload(const char* token)
 // callback for upload status updates
 void BackendUploader::OnUploadProgress(qint64 bytesSent, qint64 bytesTotal)
 {
-	mSubProgress = bytesSent / (float)bytesTotal;
+	// the total is unknown (0 or -1) until the reply starts sending
+	if (bytesTotal <= 0)
+		return;
+
+	// up to UPLOADER_MAX_PARALLEL_UPLOADS replies report their progress, combine them
+	QueueEntry* entry = mQueue->FindEntry( qobject_cast<QNetworkReply*>(sender()) );
+	if (entry == NULL)
+		return;
+
+	entry->SetBytesSent(bytesSent, bytesTotal);
+
+	mSubProgress = mQueue->CalcUploadingProgress();
 	UpdateProgressCallback();
 }
 
@@ -148,51 +160,48 @@ void BackendUploader::UpdateProgressValue(uint32 currentFileIndex, bool isProces
 // Uploading
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// upload the next file from the upload queue
+// upload the next files from the upload queue
 void BackendUploader::UploadNextFile()
 {
-	// in case we are already uploading a file, skip directly
-	if (mQueue->IsUploading() == true)
-		return;
-
-	// find the entry to be uploaded as next, return in case there is none
-	QueueEntry* nextEntry = mQueue->FindNextUploadEntry();
-	if (nextEntry == NULL)
+	// keep up to UPLOADER_MAX_PARALLEL_UPLOADS uploads in flight
+	while (mQueue->CalcNumUploadingEntries() < UPLOADER_MAX_PARALLEL_UPLOADS)
 	{
-		emit UploadFinished();
-		
-		if (mCallback != NULL)
-			mCallback->OnFinishedUpload();
+		// find the entry to be uploaded as next, stop in case there is none
+		QueueEntry* nextEntry = mQueue->FindNextUploadEntry();
+		if (nextEntry == NULL)
+			break;
 
-		mIsBusy = false;
+		// start uploading the next entry
+		if (UploadEntry(nextEntry) == false)
+		{
+			LogError( "Uploading '%s' failed. Removing it from queue.", nextEntry->GetAbsoluteFilePath() );
+			RemoveCorrespondingFiles( nextEntry );
+		}
+	}
 
+	// wait for the running uploads
+	if (mQueue->IsUploading() == true)
 		return;
-	}
 
-	// start uploading the next entry
-	if (UploadEntry(nextEntry) == false)
-	{
-		LogError( "Uploading '%s' failed. Removing it from queue.", nextEntry->GetAbsoluteFilePath() );
-		RemoveCorrespondingFiles( nextEntry );
-		UploadNextFile();
-	}
+	emit UploadFinished();
+	
+	if (mCallback != NULL)
+		mCallback->OnFinishedUpload();
+
+	mIsBusy = false;
 }
 
 
 // start uploading a file
 bool BackendUploader::UploadEntry(QueueEntry* entry)
 {
-	// do not return false in case we're already uploading, only leave this assert here due to:
-	// in case we return false we remove the data chunk channel files from disk and go on with the next entry
-	CORE_ASSERT( mQueue->IsUploading() == false );
-
 	// prepare entry for the upload process
 	if (entry->OnStartUpload() == false)
 		return false;
 
 	// let the progress window know we're about to upload the next file
 	mSubProgressText	= entry->GetFilenameString();
-	mSubProgress		= 0.0f;
+	mSubProgress		= mQueue->CalcUploadingProgress();
 	UpdateProgressValue( entry->GetIndex(), false );
 
 
@@ -232,6 +241,10 @@ bool BackendUploader::UploadEntry(QueueEntry* entry)
 	if (visualMinItem.IsNumber() == true)		{ urlTemp.Format( "&visualMin=%f", visualMinItem.GetDouble() ); urlParameters += urlTemp; }
 	if (visualMaxItem.IsNumber() == true)		{ urlTemp.Format( "&visualMax=%f", visualMaxItem.GetDouble() ); urlParameters += urlTemp; }
 
+	// delta encoded and zlib compressed samples (see NmdCompressor), older exports are raw floats
+	if (NmdCompressor::IsCompressedFile(entry->GetAbsoluteFilePath()) == true)
+		urlParameters += "&encoding=nmdz";
+
 	// create the network request
 	QNetworkRequest request = mNetworkAccessManager->ConstructNetworkRequest( "datachunks/upload", urlParameters );
 
@@ -258,6 +271,7 @@ bool BackendUploader::UploadEntry(QueueEntry* entry)
 	// post the http multi part
 	QNetworkReply* reply = mNetworkAccessManager->post_Deprecated( request, httpMultiPart, NULL );
 	httpMultiPart->setParent(reply); // delete the multiPart with the reply
+	entry->SetReply(reply);
 	connect(reply, SIGNAL(uploadProgress(qint64, qint64)), this, SLOT(OnUploadProgress(qint64, qint64)));
 	connect(reply, SIGNAL(finished()), this, SLOT(OnUploadFinished()));
 
@@ -281,7 +295,13 @@ void BackendUploader::OnUploadFinished()
 		json.Parse( replyDataString.AsChar() );
 
 	// find the entry that got uploaded
-	QueueEntry* uploadEntry = mQueue->FindUploadingEntry();
+	QueueEntry* uploadEntry = mQueue->FindEntry(networkReply);
+	if (uploadEntry == NULL)
+	{
+		mNetworkAccessManager->NetworkReplyAftermath( networkReply );
+		UploadNextFile();
+		return;
+	}
 
 	if (hasError == false)
 	{
@@ -402,6 +422,9 @@ BackendUploader::QueueEntry::QueueEntry(BackendUploader* uploader, const char* f
 	mFinishedUpload		= false;
 	mUploadAttemptNr	= 0;
 	mFile				= NULL;
+	mReply				= NULL;
+	mBytesSent			= 0;
+	mBytesTotal			= 0;
 }
 
 
@@ -440,6 +463,8 @@ bool BackendUploader::QueueEntry::OnStartUpload()
 	// enable the uploading flag and return success
 	mIsUploading = true;
 	mUploadAttemptNr++;
+	mBytesSent = 0;
+	mBytesTotal = 0;
 	return true;
 }
 
@@ -450,6 +475,7 @@ bool BackendUploader::QueueEntry::OnUploadFinished(bool error)
 	mFile->close();
 	mFile->deleteLater();
 	mFile = NULL;
+	mReply = NULL;
 
 	// disable the uploading flag and enable the upload finished flag
 	mIsUploading	= false;
@@ -562,6 +588,22 @@ BackendUploader::QueueEntry* BackendUploader::Queue::FindEntry(const char* filen
 }
 
 
+// find the entry that is uploaded by the given network reply
+BackendUploader::QueueEntry* BackendUploader::Queue::FindEntry(QNetworkReply* reply) const
+{
+	// get the number of entries in the queue and iterate through them
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		if (mEntries[i]->GetReply() == reply)
+			return mEntries[i];
+	}
+
+	// failure, no entry belongs to the reply
+	return NULL;
+}
+
+
 // remove the given file from the upload queue
 bool BackendUploader::Queue::RemoveEntry(QueueEntry* entry)
 {
@@ -599,6 +641,46 @@ BackendUploader::QueueEntry* BackendUploader::Queue::FindUploadingEntry() const
 }
 
 
+// count the entries that are currently being uploaded
+uint32 BackendUploader::Queue::CalcNumUploadingEntries() const
+{
+	uint32 result = 0;
+
+	// get the number of entries in the queue and iterate through them
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		if (mEntries[i]->IsUploading() == true)
+			result++;
+	}
+
+	return result;
+}
+
+
+// combined progress of the running uploads (the bytes sent of all replies that reported their total)
+float BackendUploader::Queue::CalcUploadingProgress() const
+{
+	qint64 bytesSent = 0;
+	qint64 bytesTotal = 0;
+
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		if (mEntries[i]->IsUploading() == false || mEntries[i]->GetBytesTotal() <= 0)
+			continue;
+
+		bytesSent += mEntries[i]->GetBytesSent();
+		bytesTotal += mEntries[i]->GetBytesTotal();
+	}
+
+	if (bytesTotal <= 0)
+		return 0.0f;
+
+	return bytesSent / (float)bytesTotal;
+}
+
+
 // get the file that is next in the queue
 BackendUploader::QueueEntry* BackendUploader::Queue::FindNextUploadEntry()
 {
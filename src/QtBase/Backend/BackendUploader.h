@@ -17,6 +17,7 @@
 
 
 #define UPLOADER_PERCENTAGE_PROCESSING		0.10f
+#define UPLOADER_MAX_PARALLEL_UPLOADS		4		// the files are streamed from disk, so this also bounds the memory used by the uploads
 
 // PHASE 1: PROCESSING			= Uploading
 // PHASE 2: POST PROCESSING		= Check if upload worked and file is on S3 server
@@ -79,6 +80,13 @@ class QTBASE_API BackendUploader : public QObject
 				inline const char* GetAbsoluteFilePath() const					{ return mFullFilePath.AsChar(); }
 				inline const Core::String& GetAbsoluteFilePathString() const	{ return mFullFilePath; }
 				inline QFile* GetFile() const									{ return mFile; }
+				inline void SetReply(QNetworkReply* reply)						{ mReply = reply; }
+				inline QNetworkReply* GetReply() const							{ return mReply; }
+
+				// upload progress of the current attempt (0 until the reply reports the total)
+				inline void SetBytesSent(qint64 bytesSent, qint64 bytesTotal)	{ mBytesSent = bytesSent; mBytesTotal = bytesTotal; }
+				inline qint64 GetBytesSent() const								{ return mBytesSent; }
+				inline qint64 GetBytesTotal() const								{ return mBytesTotal; }
 
 			private:
 				BackendUploader*	mUploader;
@@ -93,6 +101,9 @@ class QTBASE_API BackendUploader : public QObject
 
 				// data
 				QFile*				mFile;
+				QNetworkReply*		mReply;
+				qint64				mBytesSent;
+				qint64				mBytesTotal;
 		};
 
 		class Queue
@@ -110,11 +121,14 @@ class QTBASE_API BackendUploader : public QObject
 
 				// upload queue control
 				QueueEntry* FindEntry(const char* filename);
+				QueueEntry* FindEntry(QNetworkReply* reply) const;
 				bool IsInQueue(const char* filename)									{ return (FindEntry(filename) != NULL); }
 				bool RemoveEntry(QueueEntry* entry);
 				void AddFiles(const char* folderPath, const char* extensionFilter); // example: extensionFilter="*.json"
 
 				QueueEntry* FindUploadingEntry() const;
+				uint32 CalcNumUploadingEntries() const;
+				float CalcUploadingProgress() const;
 				QueueEntry* FindNextUploadEntry();
 
 				inline bool IsUploading() const											{ return (FindUploadingEntry() != NULL); }
@@ -267,6 +267,9 @@ void MainWindowBase::OnEngineUpdate()
 	{
 		GetEngine()->Update(timeDelta);
 	}
+
+	// deliver the events that were queued during the engine update (handlers with queued delivery live in the main thread)
+	CORE_EVENTMANAGER.ProcessQueuedEvents();
 }
 
 
@@ -170,6 +170,12 @@ class QTBASE_API NetworkServer : public QObject
 				ClientEventHandler(NetworkServer* server) : EventHandler() 
 				{ 
 					mNetworkServer = server; 
+
+					// only receive the events we forward to the clients
+					UnsubscribeAllEvents();
+					SubscribeEvent( EVENT_SWITCHAPPLICATION );
+					SubscribeEvent( EVENT_SWITCHSTAGE );
+					SubscribeEvent( EVENT_COMMAND );
 				}
 
 
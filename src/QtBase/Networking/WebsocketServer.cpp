@@ -40,6 +40,21 @@ WebsocketServer::WebsocketServer(uint16 port, bool debug, QObject* parent) :
    mJsonBuf(),
    mJsonWriter(mJsonBuf)
 {
+   // only receive the events we handle
+   UnsubscribeAllEvents();
+   SubscribeEvent( EVENT_STARTSESSION );
+   SubscribeEvent( EVENT_STOPSESSION );
+   SubscribeEvent( EVENT_NODEADDED );
+   SubscribeEvent( EVENT_REMOVENODE );
+   SubscribeEvent( EVENT_CONNECTIONADDED );
+   SubscribeEvent( EVENT_REMOVECONNECTION );
+   SubscribeEvent( EVENT_ACTIVECLASSIFIERCHANGED );
+   SubscribeEvent( EVENT_ACTIVESTATEMACHINECHANGED );
+   SubscribeEvent( EVENT_ACTIVEEXPERIENCECHANGED );
+   SubscribeEvent( EVENT_OPENURL );
+   SubscribeEvent( EVENT_BROWSERSTARTPLAYER );
+   SubscribeEvent( EVENT_BROWSERSTOPPLAYER );
+   SubscribeEvent( EVENT_BROWSERPAUSEPLAYER );
    CORE_EVENTMANAGER.AddEventHandler(this);
 
    // configure timer
@@ -66,6 +81,11 @@ void WebsocketServer::Init()
          this, &WebsocketServer::closed);
       connect(mTimerFeedbacks, &QTimer::timeout, 
          this, &WebsocketServer::sendFeedbacks);
+      connect(mTimerFeedbacks, &QTimer::timeout,
+         this, &WebsocketServer::sendChannels);
+
+      // channels are streamed with or without a running session
+      mTimerFeedbacks->start(100);
    }
    else
    {
@@ -112,6 +132,7 @@ void WebsocketServer::socketDisconnected()
    qDebug() << "socketDisconnected:" << pClient;
    if (pClient) {
       mClients.removeAll(pClient);
+      mStreams.remove(pClient);
       pClient->deleteLater();
    }
 }
@@ -150,6 +171,10 @@ void WebsocketServer::processTextMessage(QString message)
    {
       handleOnImpersonation(*(WSMessageOnImpersonation*)&mMessageRecv);
    }
+   else if (0 == ::strcmp(mMessageRecv.type(), WSMessage::Type::SUBSCRIBE_CHANNELS))
+   {
+      handleSubscribeChannels(pClient, *(WSMessageSubscribeChannels*)&mMessageRecv);
+   }
    else
       qDebug() << "Unhandled WSMessage: " << mMessageRecv.type();
 }
@@ -289,12 +314,120 @@ void WebsocketServer::sendFeedbacks()
       if (!mMessageBinary.createMessageCustomFeedback(c, i))
          continue;
 
-      // send to all
+      // send to all that keep up
       for (QWebSocket* s : mClients)
-         s->sendBinaryMessage(mMessageBinary.mBuffer);
+         if (!isCongested(s))
+            s->sendBinaryMessage(mMessageBinary.mBuffer);
+   }
+}
+
+void WebsocketServer::sendChannels()
+{
+   Classifier* c = GetEngine()->GetActiveClassifier();
+
+   if (!c || mStreams.isEmpty())
+      return;
+
+   for (auto it = mStreams.begin(); it != mStreams.end(); ++it)
+   {
+      QWebSocket*   client = it.key();
+      ClientStream& stream = it.value();
+
+      if (stream.mChannels.empty())
+         continue;
+
+      // slow client: skip this frame and thin out the following ones
+      const bool congested = isCongested(client);
+      if (congested)
+      {
+         stream.mDecimation   = std::min<uint16_t>(stream.mDecimation * 2, STREAM_MAXDECIMATION);
+         stream.mNumCalmTicks = 0;
+      }
+
+      // drained: step back towards full rate
+      else if (stream.mDecimation > 1 && client->bytesToWrite() < STREAM_LOWWATERMARK)
+      {
+         if (++stream.mNumCalmTicks >= STREAM_RECOVERYTICKS)
+         {
+            stream.mDecimation  /= 2;
+            stream.mNumCalmTicks = 0;
+         }
+      }
+
+      mMessageBinary.beginMessageChannelStream(stream.mSequence);
+
+      for (StreamChannel& sc : stream.mChannels)
+      {
+         Channel<double>* channel = findStreamChannel(c, sc);
+         if (!channel)
+            continue;
+
+         const uint64 end = channel->GetSampleCounter();
+
+         // channel was recreated or reset: start over with the next new sample
+         if (channel != sc.mChannel || end < sc.mLastCounter)
+         {
+            sc.mChannel    = channel;
+            sc.mNextSample = end;
+         }
+         sc.mLastCounter = end;
+
+         // samples that already left the channel buffer
+         const uint64 oldest = end - channel->GetNumSamples();
+         if (sc.mNextSample < oldest)
+         {
+            sc.mNumDropped += (uint32)(oldest - sc.mNextSample);
+            sc.mNextSample  = oldest;
+         }
+
+         if (congested)
+         {
+            if (sc.mNextSample < end)
+            {
+               sc.mNumDropped += (uint32)(end - sc.mNextSample);
+               sc.mNextSample  = end;
+            }
+            continue;
+         }
+
+         if (sc.mNextSample >= end && sc.mNumDropped == 0)
+            continue;
+
+         sc.mNextSample = mMessageBinary.addChannelStream(sc.mId, stream.mDecimation, sc.mNumDropped, channel, sc.mNextSample, end);
+         sc.mNumDropped = 0;
+      }
+
+      // one frame per client and tick
+      if (mMessageBinary.getNumStreamChannels() > 0)
+      {
+         client->sendBinaryMessage(mMessageBinary.mBuffer);
+         stream.mSequence++;
+      }
    }
 }
 
+Channel<double>* WebsocketServer::findStreamChannel(Classifier* classifier, const StreamChannel& streamChannel)
+{
+   Node* node = classifier->FindNodeByName(streamChannel.mNodeName.AsChar());
+   if (!node || streamChannel.mPortIndex >= node->GetNumOutputPorts())
+      return NULL;
+
+   MultiChannel* channels = node->GetOutputPort(streamChannel.mPortIndex).GetChannels();
+   if (!channels || streamChannel.mChannelIndex >= channels->GetNumChannels())
+      return NULL;
+
+   ChannelBase* channel = channels->GetChannel(streamChannel.mChannelIndex);
+   if (!channel || channel->GetType() != Channel<double>::TYPE_ID)
+      return NULL;
+
+   return channel->AsType<double>();
+}
+
+bool WebsocketServer::isCongested(QWebSocket* client) const
+{
+   return client->bytesToWrite() > STREAM_HIGHWATERMARK;
+}
+
 // MESSAGE HANDLERS
 
 void WebsocketServer::handleOnUrlOpened(const WSMessageOnUrlOpened& msg)
@@ -473,6 +606,72 @@ void WebsocketServer::handleOnImpersonation(const WSMessageOnImpersonation& msg)
    impersonateOrCreateUser();
 }
 
+void WebsocketServer::handleSubscribeChannels(QWebSocket* client, const WSMessageSubscribeChannels& msg)
+{
+   if (!client)
+      return;
+
+   if (!msg.isvalid()) {
+      qDebug() << "Failed to parse WSMessageSubscribeChannels:";
+      return;
+   }
+
+   // replaces the previous subscription
+   ClientStream& stream = mStreams[client];
+   stream.mChannels.clear();
+   stream.mDecimation   = 1;
+   stream.mNumCalmTicks = 0;
+
+   mMessageOnChannelsSubscribed.clear();
+
+   Classifier* classifier = GetEngine()->GetActiveClassifier();
+   const uint32 numRequested = msg.getNumChannels();
+   for (uint32 i = 0; i < numRequested && classifier; ++i)
+   {
+      StreamChannel sc;
+      sc.mNodeName     = msg.getNode(i);
+      sc.mPortIndex    = msg.getPort(i);
+      sc.mNextSample   = 0;
+      sc.mLastCounter  = 0;
+      sc.mNumDropped   = 0;
+      sc.mChannel      = NULL;
+
+      Node* node = classifier->FindNodeByName(sc.mNodeName.AsChar());
+      if (!node || sc.mPortIndex >= node->GetNumOutputPorts()) {
+         qDebug() << "Cannot stream unknown node port:" << sc.mNodeName.AsChar() << sc.mPortIndex;
+         continue;
+      }
+
+      // all channels of the port, starting with the next new sample
+      const uint32 numChannels = node->GetOutputPort(sc.mPortIndex).GetChannels() ? node->GetOutputPort(sc.mPortIndex).GetChannels()->GetNumChannels() : 0;
+      for (uint32 j = 0; j < numChannels; ++j)
+      {
+         sc.mChannelIndex = j;
+         sc.mId = (uint16_t)stream.mChannels.size();
+
+         Channel<double>* channel = findStreamChannel(classifier, sc);
+         if (!channel)
+            continue;
+
+         sc.mChannel     = channel;
+         sc.mNextSample  = channel->GetSampleCounter();
+         sc.mLastCounter = sc.mNextSample;
+         stream.mChannels.push_back(sc);
+
+         mMessageOnChannelsSubscribed.addChannel(sc.mId, sc.mNodeName.AsChar(), sc.mPortIndex, channel->GetName(), channel->GetSampleRate());
+      }
+   }
+
+   if (stream.mChannels.empty())
+      mStreams.remove(client);
+
+   // tell only this client which ids to expect
+   mJsonBuf.Clear();
+   mJsonWriter.Reset(mJsonBuf);
+   mMessageOnChannelsSubscribed.d.Accept(mJsonWriter);
+   client->sendTextMessage(mJsonBuf.GetString());
+}
+
 // MESSAGE HANDLER SUBFUNCTIONS
 
 void WebsocketServer::impersonateOrCreateUser()
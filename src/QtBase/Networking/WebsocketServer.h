@@ -9,6 +9,7 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QList>
+#include <QtCore/QHash>
 #include <QtCore/QByteArray>
 
 #include <Engine/Networking/WebsocketProtocol.h>
@@ -58,6 +59,7 @@ private Q_SLOTS:
    void processBinaryMessage(QByteArray message);
    void socketDisconnected();
    void sendFeedbacks();
+   void sendChannels();
 
 private:
    void handleOnUrlOpened(const WSMessageOnUrlOpened& msg);
@@ -65,11 +67,45 @@ private:
    void handleOnBrowserPlayerStopped(const WSMessageOnBrowserPlayerStopped& msg);
    void handleOnBrowserPlayerPaused(const WSMessageOnBrowserPlayerPaused& msg);
    void handleOnImpersonation(const WSMessageOnImpersonation& msg);
+   void handleSubscribeChannels(QWebSocket* client, const WSMessageSubscribeChannels& msg);
 
 private:
    void impersonateOrCreateUser();
    void createUser();
 
+private:
+   // channel stream backpressure: clients with more than HIGHWATERMARK bytes queued get no
+   // new frame (samples are dropped) and double their decimation, below LOWWATERMARK it recovers
+   static constexpr qint64   STREAM_HIGHWATERMARK  = 1024 * 1024;
+   static constexpr qint64   STREAM_LOWWATERMARK   = 64 * 1024;
+   static constexpr uint16_t STREAM_MAXDECIMATION  = 64;
+   static constexpr uint32_t STREAM_RECOVERYTICKS  = 10;
+
+   // a subscribed channel, resolved by name every tick so it survives classifier reloads
+   struct StreamChannel
+   {
+      Core::String       mNodeName;
+      uint32             mPortIndex;
+      uint32             mChannelIndex;
+      uint16_t           mId;
+      uint64             mNextSample;
+      uint64             mLastCounter;
+      uint32             mNumDropped;
+      const ChannelBase* mChannel;
+   };
+
+   // stream state of one client
+   struct ClientStream
+   {
+      std::vector<StreamChannel> mChannels;
+      uint32_t                   mSequence     = 0;
+      uint16_t                   mDecimation   = 1;
+      uint32_t                   mNumCalmTicks = 0;
+   };
+
+   Channel<double>* findStreamChannel(Classifier* classifier, const StreamChannel& streamChannel);
+   bool isCongested(QWebSocket* client) const;
+
 private:
    // qt websockets
    QWebSocketServer*  mWebSocketServer;
@@ -79,6 +115,9 @@ private:
    // feedbacks timer
    QTimer* mTimerFeedbacks;
 
+   // channel stream subscriptions
+   QHash<QWebSocket*, ClientStream> mStreams;
+
    // rapidjson
    rapidjson::StringBuffer                    mJsonBuf;
    rapidjson::Writer<rapidjson::StringBuffer> mJsonWriter;
@@ -96,6 +135,7 @@ private:
    WSMessageBrowserStopPlayer    mMessageBrowserStopPlayer;
    WSMessageBrowserPausePlayer   mMessageBrowserPausePlayer;
    WSMessageOnImpersonation      mMessageOnImpersonation;
+   WSMessageOnChannelsSubscribed mMessageOnChannelsSubscribed;
 
    // binary message
    WSBMessage mMessageBinary;
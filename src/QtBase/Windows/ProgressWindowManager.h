@@ -23,7 +23,18 @@ class QTBASE_API ProgressHandler : public QObject, public Core::EventHandler
 {
 	Q_OBJECT
 	public:
-		ProgressHandler() : QObject(), EventHandler()																				{}
+		ProgressHandler() : QObject(), EventHandler()
+		{
+			// only receive the progress events
+			UnsubscribeAllEvents();
+			SubscribeEvent( EVENT_PROGRESSSTART );
+			SubscribeEvent( EVENT_PROGRESSEND );
+			SubscribeEvent( EVENT_PROGRESSTEXT );
+			SubscribeEvent( EVENT_PROGRESSVALUE );
+			SubscribeEvent( EVENT_SUBPROGRESSTEXT );
+			SubscribeEvent( EVENT_SUBPROGRESSVALUE );
+		}
+
 		virtual ~ProgressHandler() {}
 
 		void OnProgressStart(bool showProgressText, bool showProgressValue, bool showSubProgressText, bool showSubProgressValue)	{ emit ProgressStart(showProgressText, showProgressValue, showSubProgressText, showSubProgressValue); }
@@ -66,6 +66,9 @@ bool AbmDriver::Init()
 	LogInfo("Initializing Advanced Brain Monitoring driver ...");
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// init thread
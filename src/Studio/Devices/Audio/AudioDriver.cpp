@@ -75,6 +75,9 @@ bool AudioDriver::Init()
 	LogInfo("Initializing Audio device driver");
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	return true;
@@ -61,6 +61,9 @@ bool BluetoothDriver::Init()
 	LogInfo("Initializing Bluetooth device driver");
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// create the bluetooth device discovery agent
@@ -35,6 +35,11 @@ using namespace Core;
 
 BrainFlowDriver::BrainFlowDriver() : DeviceDriver(Branding::DefaultBrainflowEnabled)
 {
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_REMOVENODE );
+	SubscribeEvent( EVENT_DEVICEADDED );
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 	AddSupportedDevice(BrainFlowDevice::TYPE_ID);
 }
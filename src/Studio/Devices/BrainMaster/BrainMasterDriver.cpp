@@ -57,6 +57,10 @@ bool BrainMasterDriver::Init()
    LogInfo("Initializing BrainMaster driver...");
 
    // register event handler
+   // only receive the events we handle
+   UnsubscribeAllEvents();
+   SubscribeEvent( EVENT_DEVICEADDED );
+   SubscribeEvent( EVENT_REMOVEDEVICE );
    CORE_EVENTMANAGER.AddEventHandler(this);
 
    LogDetailedInfo("BrainMaster driver initialized ...");
@@ -110,9 +114,17 @@ void BrainMasterDriver::Update(const Time& elapsed, const Time& delta)
    // try find device regularly if got none and autodetect is enabled
    if (!mDevice && IsAutoDetectionEnabled() && (Core::Time::Now() - mLastDetect) > Core::Time(3.0))
       DetectDevices();
+}
 
-   // no device available/found
-   if (!mDevice)
+// read and parse the serial stream (on the acquisition thread of the device)
+void BrainMasterDriver::Acquire(Device* device)
+{
+   // driver not enabled or not our device
+   if (!mIsEnabled || !mDevice || device != mDevice)
+      return;
+
+   // the acquisition thread starts before OnDeviceAdded() starts the stream, skip until it did
+   if (mMode == EMode::MODE_IDLE)
       return;
 
    // update on SDK
@@ -32,6 +32,7 @@
 #ifdef INCLUDE_DEVICE_BRAINMASTER
 
 #include "Discovery20.h"
+#include <atomic>
 
 // the BrainMaster driver class
 class BrainMasterDriver : public DeviceDriver, Core::EventHandler, Discovery20::Callback
@@ -55,6 +56,7 @@ public:
 
    bool Init() override;
    void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+   void Acquire(Device* device) override;
    void DetectDevices() override;
    Device* CreateDevice(uint32 deviceTypeID) override;
    void OnRemoveDevice(Device* device) override;
@@ -92,7 +94,7 @@ private:
    virtual void onFrame(Discovery20& d, const Discovery20::Frame& f, const Discovery20::Channels& c) override;
 
 
-   EMode              mMode;
+   std::atomic<EMode> mMode;             // written by the engine thread, read by the acquisition
    std::string        mCodeKey;
    std::string        mSerial;
    std::string        mPassKey;
@@ -57,6 +57,10 @@ bool ActiChampDriver::Init()
 	LogInfo("Initializing Mitsar Driver... ");
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_DEVICEADDED );
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	LogDetailedInfo("Mitsar Driver initialized.");
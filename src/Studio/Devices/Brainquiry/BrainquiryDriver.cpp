@@ -102,6 +102,9 @@ bool BrainquiryDriver::Init()
 	mAutoDetection->moveToThread(mAutoDetectionThread);
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	return true;
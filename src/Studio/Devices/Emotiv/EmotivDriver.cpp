@@ -100,6 +100,9 @@ bool EmotivDriver::Init()
 	EE_DataSetBufferSizeInSec( mDataSizeInSeconds );
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	LogDetailedInfo("Emotiv EPOC driver initialized ...");
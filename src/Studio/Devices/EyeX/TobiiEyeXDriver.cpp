@@ -230,6 +230,8 @@ bool TobiiEyeXDriver::Init()
 	mSuccess &= txEnableConnection(mContext) == TX_RESULT_OK;
 
 	// register event handler for reacting to device removal
+	// we do not handle any of the core events
+	UnsubscribeAllEvents();
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	return mSuccess;
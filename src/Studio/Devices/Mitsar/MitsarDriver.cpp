@@ -65,6 +65,10 @@ bool MitsarDriver::Init()
 	LogInfo("Initializing Mitsar Driver... ");
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_DEVICEADDED );
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// init thread
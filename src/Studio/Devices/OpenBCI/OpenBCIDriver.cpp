@@ -104,6 +104,9 @@ bool OpenBCIDriver::Init()
 	mAutoDetection->moveToThread(mAutoDetectionThread);
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	return true;
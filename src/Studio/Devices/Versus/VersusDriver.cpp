@@ -103,6 +103,9 @@ bool VersusDriver::Init()
 	mAutoDetection->moveToThread(mAutoDetectionThread);
 
 	// register event handler for reacting to device removal
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	return true;
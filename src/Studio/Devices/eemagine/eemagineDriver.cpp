@@ -85,6 +85,10 @@ bool eemagineDriver::Init()
    LogInfo("Initializing eemagine driver...");
 
    // register event handler
+   // only receive the events we handle
+   UnsubscribeAllEvents();
+   SubscribeEvent( EVENT_DEVICEADDED );
+   SubscribeEvent( EVENT_REMOVEDEVICE );
    CORE_EVENTMANAGER.AddEventHandler(this);
 
    LogDetailedInfo("eemagine driver initialized ...");
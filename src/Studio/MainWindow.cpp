@@ -101,6 +101,16 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags flags) : MainWindowBase(
 	mSettingsAction				= NULL;
 
 	LogDetailedInfo("Adding main window event handler ...");
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_PREPARESESSION );
+	SubscribeEvent( EVENT_STARTSESSION );
+	SubscribeEvent( EVENT_STOPSESSION );
+	SubscribeEvent( EVENT_SESSIONUSERCHANGED );
+	SubscribeEvent( EVENT_DEVICEADDED );
+	SubscribeEvent( EVENT_DEVICEREMOVED );
+	SubscribeEvent( EVENT_ACTIVEBCICHANGED );
+	SubscribeEvent( EVENT_ACTIVEEXPERIENCECHANGED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// setup some properties
@@ -1292,6 +1302,15 @@ void MainWindow::OnSettings()
 		mEngineUpdateRateProperty = generalPropertyWidget->GetPropertyManager()->AddFloatSpinnerProperty("Performance", "Engine Update Rate (Hz)", GetEngineUpdateRate(), GetEngineUpdateRate(), FLT_MIN, FLT_MAX);
 		mInterfaceUpdateRateProperty = generalPropertyWidget->GetPropertyManager()->AddFloatSpinnerProperty("Performance", "Interface Update Rate (Hz)", GetInterfaceUpdateRate(), GetInterfaceUpdateRate(), FLT_MIN, FLT_MAX);
 		mRealtimeInterfaceUpdateRateProperty = generalPropertyWidget->GetPropertyManager()->AddFloatSpinnerProperty("Performance", "Realtime Interface Update Rate (Hz)", GetRealtimeUIUpdateRate(), GetRealtimeUIUpdateRate(), FLT_MIN, FLT_MAX);
+		mSpillRecordingsProperty = generalPropertyWidget->GetPropertyManager()->AddBoolProperty("Performance", "Spill Recordings To Disk", GetEngine()->GetChannelChunkStore()->IsEnabled(), false);
+		const int32 recordingBudget = (int32)(GetEngine()->GetChannelChunkStore()->GetMemoryBudget() / (1024 * 1024));
+		mRecordingMemoryBudgetProperty = generalPropertyWidget->GetPropertyManager()->AddIntProperty("Performance", "Recording Memory Budget (MB)", recordingBudget, CHANNELCHUNKSTORE_DEFAULT_BUDGET / (1024 * 1024), 16, CORE_INT32_MAX);
+		Array<String> sampleFormatComboValues;
+		for (uint32 i=0; i<ChannelBase::NUM_SAMPLEFORMATS; ++i)
+			sampleFormatComboValues.Add( ChannelBase::GetSampleFormatName((ChannelBase::ESampleFormat)i) );
+		mBufferSampleFormatProperty = generalPropertyWidget->GetPropertyManager()->AddComboBoxProperty("Performance", "Buffer Sample Format", sampleFormatComboValues, GetEngine()->GetChannelSampleFormat(), false);
+		mBufferSampleResolutionProperty = generalPropertyWidget->GetPropertyManager()->AddFloatSpinnerProperty("Performance", "Buffer Sample Resolution (Integer Formats)", GetEngine()->GetChannelSampleResolution(), 1.0f, FLT_MIN, FLT_MAX);
+		mSuspendUnusedNodesProperty = generalPropertyWidget->GetPropertyManager()->AddBoolProperty("Performance", "Suspend Nodes Without Visible Output", GetEngine()->IsDemandTrackingEnabled(), false);
 	
 		//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// Devices category
@@ -1458,6 +1477,16 @@ void MainWindow::OnValueChanged(Property* property)
 		SetInterfaceUpdateRate(property->AsFloat());
 	if (property == mRealtimeInterfaceUpdateRateProperty)
 		SetRealtimeUIUpdateRate(property->AsFloat());
+	if (property == mSpillRecordingsProperty)
+		GetEngine()->GetChannelChunkStore()->SetEnabled(property->AsBool());
+	if (property == mRecordingMemoryBudgetProperty)
+		GetEngine()->GetChannelChunkStore()->SetMemoryBudget((uint64)property->AsInt() * 1024 * 1024);
+	if (property == mBufferSampleFormatProperty)
+		GetEngine()->SetChannelSampleFormat((ChannelBase::ESampleFormat)property->AsInt(), GetEngine()->GetChannelSampleResolution());
+	if (property == mBufferSampleResolutionProperty)
+		GetEngine()->SetChannelSampleFormat(GetEngine()->GetChannelSampleFormat(), property->AsFloat());
+	if (property == mSuspendUnusedNodesProperty)
+		GetEngine()->SetDemandTrackingEnabled(property->AsBool());
 	
 	// global device autodetection
 	if (property == mAutoDetectionProperty)
@@ -1656,6 +1685,15 @@ void MainWindow::OnLoadSettings()
 	SetInterfaceUpdateRate(interfaceUpdateRate);
 	const float realtimeInterfaceUpdateRate = settings.value("realtimeInterfaceUpdateRate", GetRealtimeUIUpdateRate()).toFloat();
 	SetRealtimeUIUpdateRate(realtimeInterfaceUpdateRate);
+	const bool spillRecordings = settings.value("spillRecordingsToDisk", GetEngine()->GetChannelChunkStore()->IsEnabled()).toBool();
+	GetEngine()->GetChannelChunkStore()->SetEnabled(spillRecordings);
+	const uint64 recordingBudget = settings.value("recordingMemoryBudget", (qulonglong)GetEngine()->GetChannelChunkStore()->GetMemoryBudget()).toULongLong();
+	GetEngine()->GetChannelChunkStore()->SetMemoryBudget(recordingBudget);
+	const int32 bufferSampleFormat = settings.value("bufferSampleFormat", (int32)GetEngine()->GetChannelSampleFormat()).toInt();
+	const double bufferSampleResolution = settings.value("bufferSampleResolution", GetEngine()->GetChannelSampleResolution()).toDouble();
+	GetEngine()->SetChannelSampleFormat((ChannelBase::ESampleFormat)Clamp<int32>(bufferSampleFormat, 0, ChannelBase::NUM_SAMPLEFORMATS-1), bufferSampleResolution);
+	const bool suspendUnusedNodes = settings.value("suspendUnusedNodes", false).toBool();
+	GetEngine()->SetDemandTrackingEnabled(suspendUnusedNodes);
 
 	// device detection
 	const bool enableAutoDetection = settings.value("deviceAutoDetectionEnabled", GetEngine()->GetAutoDetectionSetting()).toBool();
@@ -1771,6 +1809,11 @@ void MainWindow::OnSaveSettings()
 	settings.setValue("engineUpdateRate", GetEngineUpdateRate());
 	settings.setValue("interfaceUpdateRate", GetInterfaceUpdateRate());
 	settings.setValue("realtimeInterfaceUpdateRate", GetRealtimeUIUpdateRate());
+	settings.setValue("spillRecordingsToDisk", GetEngine()->GetChannelChunkStore()->IsEnabled());
+	settings.setValue("recordingMemoryBudget", (qulonglong)GetEngine()->GetChannelChunkStore()->GetMemoryBudget());
+	settings.setValue("bufferSampleFormat", (int32)GetEngine()->GetChannelSampleFormat());
+	settings.setValue("bufferSampleResolution", GetEngine()->GetChannelSampleResolution());
+	settings.setValue("suspendUnusedNodes", GetEngine()->IsDemandTrackingEnabled());
 
 	// device auto detection settings
 	settings.setValue("deviceAutoDetectionEnabled", GetEngine()->GetAutoDetectionSetting());
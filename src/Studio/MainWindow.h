@@ -120,6 +120,11 @@ class MainWindow : public MainWindowBase, public Core::EventHandler
 		Property*					mEngineUpdateRateProperty;
 		Property*					mRealtimeInterfaceUpdateRateProperty;
 		Property*					mInterfaceUpdateRateProperty;
+		Property*					mSpillRecordingsProperty;
+		Property*					mRecordingMemoryBudgetProperty;
+		Property*					mBufferSampleFormatProperty;
+		Property*					mBufferSampleResolutionProperty;
+		Property*					mSuspendUnusedNodesProperty;
 
 		// devices
 		Property*					mPowerLineFrequencyTypeProperty;
@@ -58,6 +58,13 @@ bool BackendFileSystemPlugin::Init()
 
 	// attach to event system
 	LogDebug("Attaching backend file system plugin to event system ...");
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_STARTSESSION );
+	SubscribeEvent( EVENT_STOPSESSION );
+	SubscribeEvent( EVENT_ACTIVECLASSIFIERCHANGED );
+	SubscribeEvent( EVENT_ACTIVESTATEMACHINECHANGED );
+	SubscribeEvent( EVENT_ACTIVEEXPERIENCECHANGED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	LogDetailedInfo("Backend file system plugin successfully initialized");
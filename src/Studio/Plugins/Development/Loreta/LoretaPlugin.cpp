@@ -44,6 +44,16 @@ LoretaPlugin::LoretaPlugin() : Plugin(GetStaticTypeUuid())
 	mLoretaThreadHandler = new LoretaThreadHandler(mLoretaWidget);
 	mThread = new Thread(mLoretaThreadHandler, "LoretaThread");
 
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_NODEADDED );
+	SubscribeEvent( EVENT_NODEREMOVED );
+	SubscribeEvent( EVENT_CONNECTIONADDED );
+	SubscribeEvent( EVENT_CONNECTIONREMOVED );
+	SubscribeEvent( EVENT_NODESTARTED );
+	SubscribeEvent( EVENT_ACTIVECLASSIFIERCHANGED );
+	// handle node starts after the engine update
+	SetQueuedDelivery( EVENT_NODESTARTED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 }
 
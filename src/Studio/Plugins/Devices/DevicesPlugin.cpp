@@ -68,6 +68,10 @@ bool DevicesPlugin::Init()
 	vLayout->addWidget(mNoDeviceWidget);
 
 	// add event handler
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_DEVICEADDED );
+	SubscribeEvent( EVENT_REMOVEDEVICE );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// reinit
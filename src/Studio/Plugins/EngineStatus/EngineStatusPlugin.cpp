@@ -27,6 +27,9 @@
 // include required headers
 #include "EngineStatusPlugin.h"
 #include <Networking/NetworkClient.h>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QMessageBox>
 
 using namespace Core;
 
@@ -38,6 +41,7 @@ EngineStatusPlugin::EngineStatusPlugin() : Plugin(GetStaticTypeUuid())
 	// Init stuff
 	mLogOutput = NULL;
 	mClientInfoWidget = NULL;
+	mProfilerTable = NULL;
 
 	// reset last values
 	mLastMemoryUsed = 0;
@@ -234,6 +238,46 @@ bool EngineStatusPlugin::Init()
 	mainLayout->addWidget( new QLabel("OSC Server") );
 	mainLayout->addLayout( oscListenerLayout );
 
+	//////////////////////////////////////////////////////////////////////////
+	// 3) per-node profiler
+	mProfilingCheckBox = new QCheckBox("Enable");
+	mProfilingCheckBox->setChecked( GetEngine()->GetProfiler().IsEnabled() );
+	connect( mProfilingCheckBox, SIGNAL( stateChanged( int ) ), this, SLOT( OnProfilingCheckBoxStateChanged( int ) ) );
+
+	mExportTraceButton = new QPushButton("Export Trace...");
+	connect( mExportTraceButton, SIGNAL( clicked() ), this, SLOT( OnExportTraceClicked() ) );
+
+	QHBoxLayout* profilerControlLayout = new QHBoxLayout();
+	profilerControlLayout->setMargin(0);
+	profilerControlLayout->addWidget(mProfilingCheckBox);
+	profilerControlLayout->addWidget(GetHSpacer());
+	profilerControlLayout->addWidget(mExportTraceButton);
+
+	mProfilerTable = new QTableWidget();
+	mProfilerTable->setSelectionBehavior( QAbstractItemView::SelectRows );
+	mProfilerTable->setEditTriggers( QAbstractItemView::NoEditTriggers );
+	mProfilerTable->verticalHeader()->hide();
+	mProfilerTable->setColumnCount(9);
+	QStringList horizontalHeaderLabels;
+	horizontalHeaderLabels.append( "Node" );
+	horizontalHeaderLabels.append( "Type" );
+	horizontalHeaderLabels.append( "Calls" );
+	horizontalHeaderLabels.append( "Total [ms]" );
+	horizontalHeaderLabels.append( "Avg [us]" );
+	horizontalHeaderLabels.append( "Max [us]" );
+	horizontalHeaderLabels.append( "Samples In" );
+	horizontalHeaderLabels.append( "Samples Out" );
+	horizontalHeaderLabels.append( "Allocations" );
+	mProfilerTable->setHorizontalHeaderLabels(horizontalHeaderLabels);
+	mProfilerTable->horizontalHeader()->setSectionResizeMode( QHeaderView::ResizeToContents );
+	mProfilerTable->setSortingEnabled(true);
+	mProfilerTable->sortByColumn(3, Qt::DescendingOrder);
+
+	mainLayout->addWidget( new QLabel("") );
+	mainLayout->addWidget( new QLabel("Profiler") );
+	mainLayout->addLayout( profilerControlLayout );
+	mainLayout->addWidget( mProfilerTable );
+
 	//////////////////////////////////////////////////////////////////////////
 	// 4) debug log text field
 	mLogOutput = new QTextEdit();
@@ -278,6 +322,73 @@ void EngineStatusPlugin::OnClientListChanged()
 }
 
 
+// enable or disable the engine profiler
+void EngineStatusPlugin::OnProfilingCheckBoxStateChanged(int state)
+{
+	GetEngine()->GetProfiler().SetEnabled( state == Qt::Checked );
+}
+
+
+// export the profiler events of the last seconds as chrome trace
+void EngineStatusPlugin::OnExportTraceClicked()
+{
+	QFileDialog::Options options;
+	QString selectedFilter;
+	const QString filename = QFileDialog::getSaveFileName(NULL, "Export Trace", "", "Chrome Trace (*.json)", &selectedFilter, options);
+
+	// no output file selected
+	if (filename.isEmpty() == true)
+		return;
+
+	// the ring buffers hold the most recent events, export the last 10 seconds
+	if (GetEngine()->GetProfiler().ExportChromeTrace( FromQtString(filename).AsChar(), 10.0 ) == false)
+		QMessageBox::critical(GetQtBaseManager()->GetMainWindow(), "ERROR", "Cannot write trace file.");
+}
+
+
+// fill the profiler table with the statistics of the last update interval
+void EngineStatusPlugin::UpdateProfilerTable()
+{
+	if (mProfilerTable == NULL)
+		return;
+
+	Profiler& profiler = GetEngine()->GetProfiler();
+	if (profiler.IsEnabled() == false)
+	{
+		mProfilerTable->setRowCount(0);
+		return;
+	}
+
+	profiler.CollectStatistics( mProfilerStatistics, mUpdateTimer.interval() / 1000.0 );
+
+	// disable sorting while filling, otherwise rows move while we set their items
+	mProfilerTable->setSortingEnabled(false);
+
+	const uint32 numScopes = mProfilerStatistics.Size();
+	mProfilerTable->setRowCount(numScopes);
+	for (uint32 i=0; i<numScopes; ++i)
+	{
+		const Profiler::ScopeStatistics& stats = mProfilerStatistics[i];
+
+		mProfilerTable->setItem( i, 0, new QTableWidgetItem(stats.mName.AsChar()) );
+		mProfilerTable->setItem( i, 1, new QTableWidgetItem(stats.mCategory.AsChar()) );
+
+		// numeric columns (use display role data so sorting is numeric)
+		const double values[7] = { (double)stats.mNumCalls, stats.mTotalTime * 1000.0, stats.mAverageTime * 1000000.0, stats.mMaxTime * 1000000.0, (double)stats.mNumSamplesIn, (double)stats.mNumSamplesOut, (double)stats.mNumAllocations };
+		for (uint32 j=0; j<7; ++j)
+		{
+			const double value = (j >= 1 && j <= 3) ? std::round(values[j] * 100.0) / 100.0 : values[j];
+
+			QTableWidgetItem* item = new QTableWidgetItem();
+			item->setData( Qt::DisplayRole, value );
+			mProfilerTable->setItem( i, 2+j, item );
+		}
+	}
+
+	mProfilerTable->setSortingEnabled(true);
+}
+
+
 // update interface information
 void EngineStatusPlugin::UpdateInterface()
 {
@@ -385,6 +496,9 @@ void EngineStatusPlugin::UpdateInterface()
 	mDeviceManagerPerformanceLabel->setText( GetDeviceManager()->GetFpsCounter().GetText() );
 	mOscRouterPerformanceLabel->setText( GetOscMessageRouter()->GetFpsCounter().GetText() );
 
+	// per-node profiler
+	UpdateProfilerTable();
+
 	// 2) network server
 	NetworkServer* server = GetNetworkServer();
 	
@@ -31,6 +31,9 @@
 #include "../SessionControl/ClientInfoWidget.h"	// TODO move widget elswhere? remove from session control?
 #include <QTextEdit>
 #include <QLabel>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QTableWidget>
 
 
 /**
@@ -62,6 +65,8 @@ class EngineStatusPlugin : public Plugin
 	private slots:
 		void OnTimerTimeout();
 		void OnClientListChanged();
+		void OnProfilingCheckBoxStateChanged(int state);
+		void OnExportTraceClicked();
 		
 	private:
 
@@ -94,6 +99,13 @@ class EngineStatusPlugin : public Plugin
 		QLabel*				mNumOscPacketsSentLabel;
 		QLabel*				mNumOscPacketPoolTXStatusLabel;
 
+		// per-node profiler
+		QCheckBox*			mProfilingCheckBox;
+		QPushButton*		mExportTraceButton;
+		QTableWidget*		mProfilerTable;
+		Core::Array<Core::Profiler::ScopeStatistics> mProfilerStatistics;
+		void UpdateProfilerTable();
+
 		// debug log
 		QTextEdit*			mLogOutput;
 
@@ -49,6 +49,9 @@ bool ExperiencePlugin::Init()
 {
 	LogDetailedInfo("Initializing experience plugin ...");
 
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_ACTIVEEXPERIENCECHANGED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	QWidget*		mainWidget		= NULL;
@@ -80,6 +80,15 @@ ExperienceWidget::ExperienceWidget(QWidget* parent) :
 
 	setLayout( mMainLayout );
 
+	// the presentation events only carry values, so we can handle them after the engine update instead of while the graph is being updated
+	// NOTE: session stop and exit state are queued as well so they can't overtake the presentation events
+	const EEventType queuedEvents[] = { EVENT_STOPSESSION, EVENT_EXITSTATEREACHED, EVENT_PLAYAUDIO, EVENT_STOPAUDIO, EVENT_PAUSEAUDIO, EVENT_SEEKAUDIO, EVENT_PLAYVIDEO, EVENT_STOPVIDEO, EVENT_PAUSEVIDEO, EVENT_SEEKVIDEO,
+										EVENT_SHOWIMAGE, EVENT_HIDEIMAGE, EVENT_SHOWTEXT, EVENT_HIDETEXT, EVENT_SETBACKGROUNDCOLOR, EVENT_HIDEFOURZONEAVE, EVENT_SHOWBUTTON, EVENT_CLEARBUTTONS,
+										EVENT_SHOWTEXTINPUT, EVENT_HIDETEXTINPUT };
+	const uint32 numQueuedEvents = sizeof(queuedEvents) / sizeof(EEventType);
+	for (uint32 i=0; i<numQueuedEvents; ++i)
+		SetQueuedDelivery( queuedEvents[i] );
+
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// create gif animation timer
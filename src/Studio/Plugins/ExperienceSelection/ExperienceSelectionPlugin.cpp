@@ -58,6 +58,10 @@ bool ExperienceSelectionPlugin::Init()
 
 	// attach to event system
 	LogDebug("Attaching Experience selection pluginplugin to event system ...");
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_STARTSESSION );
+	SubscribeEvent( EVENT_STOPSESSION );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	LogDetailedInfo("Experience selection plugin successfully initialized");
@@ -109,6 +109,9 @@ void FeedbackHistoryWidget::paintGL()
 
 	RenderSplitViews( numCustomFeedbackNodes );
 
+	// destroy the pyramids of channels that are not displayed anymore
+	mPyramids.RemoveUnused();
+
 	// post rendering
 	PostRendering();
 }
@@ -177,7 +180,7 @@ void FeedbackHistoryWidget::RenderCallback::Render(uint32 index, bool isHighligh
 
 	// render feedback signal
 	const OpenGLWidget2DHelpers::EChartRenderStyle style = (OpenGLWidget2DHelpers::EChartRenderStyle)mFeedbackWidget->GetPlugin()->GetSampleStyle();
-	OpenGLWidget2DHelpers::RenderChart( this, channel, FromQtColor(feedbackColor), style, timeRange, maxTime, rangeMin, rangeMax, areaStartX, width, height, height,  drawLatencyMarker);
+	OpenGLWidget2DHelpers::RenderChart( this, channel, FromQtColor(feedbackColor), style, timeRange, maxTime, rangeMin, rangeMax, areaStartX, width, height, height,  drawLatencyMarker, mFeedbackWidget->mPyramids.Get(channel));
 
 	// use thicker lines if styles with lines are selected
 	if (style == OpenGLWidget2DHelpers::LINE || style == OpenGLWidget2DHelpers::LOLLIPOP || style == OpenGLWidget2DHelpers::CROSS)
@@ -29,6 +29,7 @@
 #include <DSP/Channel.h>
 #include <Graph/Classifier.h>
 #include "../../Rendering/OpenGLWidget.h"
+#include "../../Rendering/MinMaxPyramid.h"
 
 
 // forward declaration
@@ -64,6 +65,7 @@ class FeedbackHistoryWidget : public OpenGLWidget
 		FeedbackPlugin*		mPlugin;
 		RenderCallback*		mRenderCallback;
 		double				mLeftTextWidth;
+		MinMaxPyramidCache	mPyramids;
 
 		QColor				mGridColor;
 		QColor				mSubGridColor;
@@ -94,6 +94,8 @@ bool FeedbackPlugin::Init()
 
 	vWidget->show();
 	
+	// we do not handle any of the core events
+	UnsubscribeAllEvents();
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	LogDetailedInfo("Feedback plugin successfully initialized");
@@ -60,6 +60,14 @@ GraphAttributesWidget::GraphAttributesWidget(QWidget* parent) : QScrollArea(pare
 
 
 	// register event handler
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_STARTSESSION );
+	SubscribeEvent( EVENT_STOPSESSION );
+	SubscribeEvent( EVENT_GRAPHMODIFIED );
+	SubscribeEvent( EVENT_ATTRIBUTEUPDATED );
+	// attribute updates are handled after the engine update, removed objects are skipped
+	SetQueuedDelivery( EVENT_ATTRIBUTEUPDATED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// init
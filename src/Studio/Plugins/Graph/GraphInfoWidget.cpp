@@ -35,6 +35,10 @@ GraphInfoWidget::GraphInfoWidget(QWidget* parent, Classifier* classifier) : QWid
 	mClassifier = classifier;
 	
 	// register event handler
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_GRAPHMODIFIED );
+	SubscribeEvent( EVENT_ACTIVECLASSIFIERCHANGED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	Init();
@@ -241,6 +241,11 @@ bool GraphPlugin::Init()
 
 	// attach to event system
 	LogDebug("Attaching graph widget to event system ...");
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_GRAPHMODIFIED );
+	SubscribeEvent( EVENT_ACTIVECLASSIFIERCHANGED );
+	SubscribeEvent( EVENT_ACTIVESTATEMACHINECHANGED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// show the active classifier
@@ -179,8 +179,8 @@ void GraphRenderer::RenderNode(Graph* graph, Node* node, QPainter& painter, cons
 		borderColor.setAlphaF(0.5);
 	}
 
-	// disabled node: more transparency
-	if (node->IsEnabled() == false)
+	// disabled or suspended node (demand tracking, its outputs are not updated): more transparency
+	if (node->IsEnabled() == false || node->IsSuspended() == true)
 	{
 		bgColor.setAlphaF(0.5);
 		borderColor.setAlphaF(0.5);
@@ -371,7 +371,7 @@ void GraphRenderer::RenderNode(Graph* graph, Node* node, QPainter& painter, cons
 		borderPen.setWidth(borderWidth * mShared->GetScreenScaling());
 
 		// used dashed border and more transparencyif node is not uninitialized
-		if (node->IsInitialized() == false || node->IsEnabled() == false || node->IsLocked() == true)
+		if (node->IsInitialized() == false || node->IsEnabled() == false || node->IsLocked() == true || node->IsSuspended() == true)
 		{
 			borderPen.setStyle(Qt::DotLine);
 			painter.setOpacity(inactiveTransOpacity);
@@ -569,6 +569,24 @@ void GraphRenderer::RenderNode(Graph* graph, Node* node, QPainter& painter, cons
 
 		
 		}
+
+		// mouse over suspended node (demand tracking): explain why its outputs are empty
+		else if (node->IsSuspended() == true && rect.contains(mousePos) == true)
+		{
+			const char* message = "Suspended (no visible output)";
+			const int textWidth = mShared->GetNodeInfoMetrics().width(message);
+			const int textHeight = mShared->GetNodeInfoMetrics().height();
+			const int textLeft = rect.left() + (rect.width() - textWidth) / 2;
+			const int textTop = rect.top() + (rect.height() - textHeight) / 2;
+			const int textBorder = 5 * mShared->GetScreenScaling();
+
+			painter.setOpacity(0.7);
+			painter.setPen(Qt::NoPen);
+			painter.setBrush(Qt::black);
+			painter.drawRoundedRect(QRect(textLeft - textBorder, textTop - textBorder, textWidth + 2 * textBorder, textHeight + 2*textBorder), mShared->GetBorderRadius(), mShared->GetBorderRadius());
+			painter.setOpacity(1.0);
+			RenderText(true, painter, message, Qt::lightGray, QRect(textLeft, textTop, textWidth, textHeight), mShared->GetNodeInfoFont(), mShared->GetNodeInfoMetrics(), Qt::AlignCenter);
+		}
 	}
 
 	// Render node in collapsed state
@@ -89,6 +89,12 @@ GraphWidget::GraphWidget(Type type, GraphPlugin* plugin, QWidget* parent) : QOpe
 	setAutoFillBackground(false);
 
 	// attach to event system
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_NODEADDED );
+	SubscribeEvent( EVENT_REMOVENODE );
+	SubscribeEvent( EVENT_CONNECTIONADDED );
+	SubscribeEvent( EVENT_REMOVECONNECTION );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	connect( &mShared, SIGNAL(SelectionChanged()), this, SLOT(OnEmitSelectionChangedSignal()) );
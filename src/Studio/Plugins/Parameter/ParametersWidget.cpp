@@ -60,6 +60,20 @@ ParametersWidget::ParametersWidget(QWidget* parent) : QScrollArea(parent)
 	mSpacerWidget->setObjectName("TransparentWidget");
 
 	// add event handler
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_STARTSESSION );
+	SubscribeEvent( EVENT_GRAPHRESET );
+	SubscribeEvent( EVENT_GRAPHMODIFIED );
+	SubscribeEvent( EVENT_REMOVENODE );
+	SubscribeEvent( EVENT_ATTRIBUTEUPDATED );
+	SubscribeEvent( EVENT_NODESTARTED );
+	SubscribeEvent( EVENT_NODESTOPPED );
+	SubscribeEvent( EVENT_ACTIVECLASSIFIERCHANGED );
+	// the node events are handled after the engine update, removed nodes are skipped
+	SetQueuedDelivery( EVENT_ATTRIBUTEUPDATED );
+	SetQueuedDelivery( EVENT_NODESTARTED );
+	SetQueuedDelivery( EVENT_NODESTOPPED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	// add Widgets immediately
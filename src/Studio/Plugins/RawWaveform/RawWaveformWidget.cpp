@@ -75,6 +75,9 @@ void RawWaveformWidget::paintGL()
 	else
 		Render();
 
+	// destroy the pyramids of channels that are not displayed anymore
+	mPyramids.RemoveUnused();
+
 	// post rendering
 	PostRendering();
 }
@@ -371,21 +374,16 @@ void RawWaveformWidget::RenderCallback::RenderWave2D(Channel<double>* channel, b
 
 	CORE_ASSERT(maxSampleIndex >= minSampleIndex);
 
-	// find max/min of all displayed values for scaling
+	// find max/min of all displayed values for scaling (from the min/max pyramid, so we don't have to iterate all samples)
+	MinMaxPyramid* pyramid = mParent->mPyramids.Get(channel);
+	pyramid->Update(channel);
+
 	double rawMin = DBL_MAX;
 	double rawMax = -DBL_MAX;
 	double mean = 0;
-	uint32 numVals = 0;
-	for (uint32 i=minSampleIndex; i<=maxSampleIndex; ++i)
-	{
-		double* rawValue = channel->GetSampleRef(i);
-		rawMin = (*rawValue) < rawMin ? (*rawValue) : rawMin;
-		rawMax = (*rawValue) > rawMax ? (*rawValue) : rawMax;
-		mean += (*rawValue);
-		numVals++;
-	}
-	if (numVals != 0)
-		mean /= numVals;
+	uint64 numMeanSamples = 0;
+	if (pyramid->CalcRange(minSampleIndex, maxSampleIndex, &rawMin, &rawMax, &mean, &numMeanSamples) == true)
+		mean /= numMeanSamples;		// the range gets clamped to the samples in the pyramid
 
 	// calculate waveform scaling parmeters
 	if (useAutoScale == true)
@@ -418,6 +416,14 @@ void RawWaveformWidget::RenderCallback::RenderWave2D(Channel<double>* channel, b
 
 	//// render axis
 	AddLine( xStart + 0.375, yCenter + 0.375, mAxisColor, xEnd + 0.375, yCenter + 0.375, mAxisColor );
+
+	// many samples per pixel: render the min/max envelope, one vertical line per pixel column
+	if (OpenGLWidget2DHelpers::GetNumSamplesPerPixel(channel, timeRange, xEnd - xStart) > 2.0)
+	{
+		OpenGLWidget2DHelpers::RenderChartEnvelope( this, channel, pyramid, minTime, maxTime, xStart, xEnd, xEnd, mean, mean + 1.0, yCenter, yCenter + valueScale, false, rawMin, rawMax, lighterColor, darkerColor, &previousX, &previousY );
+		Render2DCircle(previousX, previousY, 3.0, 32, color);
+		return;
+	}
 	
 	////////////////////////////////////////////////////////////////////
 	//// 0) Setup: calculate previousX and previousY using the sample at minSampleIndex (which lies outside of the drawing area)
@@ -27,6 +27,7 @@
 // include required headers
 #include "../../Config.h"
 #include "../../Rendering/OpenGLWidget.h"
+#include "../../Rendering/MinMaxPyramid.h"
 #include <BciDevice.h>
 
 
@@ -76,6 +77,7 @@ class RawWaveformWidget : public OpenGLWidget
 
 		RawWaveformPlugin*		mPlugin;
 		RenderCallback*			mRenderCallback;
+		MinMaxPyramidCache		mPyramids;
 };
 
 
@@ -145,6 +145,21 @@ bool SessionControlPlugin::Init()
 	mDock->update();
 
 	// register with event handler
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_PREPAREDSESSION );
+	SubscribeEvent( EVENT_SESSIONUSERCHANGED );
+	SubscribeEvent( EVENT_REMOVENODE );
+	SubscribeEvent( EVENT_ATTRIBUTEUPDATED );
+	SubscribeEvent( EVENT_NODESTARTED );
+	SubscribeEvent( EVENT_REMOVEDEVICE );
+	SubscribeEvent( EVENT_ACTIVEBCICHANGED );
+	SubscribeEvent( EVENT_ACTIVECLASSIFIERCHANGED );
+	SubscribeEvent( EVENT_ACTIVESTATEMACHINECHANGED );
+	SubscribeEvent( EVENT_ACTIVEEXPERIENCECHANGED );
+	// the node events are handled after the engine update, removed nodes are skipped
+	SetQueuedDelivery( EVENT_ATTRIBUTEUPDATED );
+	SetQueuedDelivery( EVENT_NODESTARTED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	LogDetailedInfo("Session control plugin successfully initialized");
@@ -58,6 +58,8 @@ SessionInfoWidget::SessionInfoWidget(QWidget* parent) : QWidget(parent)
 
 	UpdateLayout();
 
+	// we do not handle any of the core events
+	UnsubscribeAllEvents();
 	CORE_EVENTMANAGER.AddEventHandler(this);
 }
 
@@ -174,17 +174,18 @@ void SpectrogramBandsPlugin::ChannelBandsDataProxy::ReInit()
 {
 	const int numChannels = mChannels.Size();
 	if (numChannels == 0)
+	{
+		ReleaseSpectrumAnalyzers();
 		return;
+	}
 
 	int sampleRate = -1;
 
 	// re-init data array
 	mData->clear();
 
-	// clear spectrum analyzers (better would be: reuse them)
-	const uint32 numAnalyzers = mSpectrumAnalyzers.Size();
-	for (uint32 i=0; i<numAnalyzers; i++)
-		delete mSpectrumAnalyzers[i];
+	// keep the old analyzers referenced until the new ones are acquired, so unchanged ones are reused
+	Array<SpectrumAnalyzerCache::Entry*> oldAnalyzers = mSpectrumAnalyzers;
 	mSpectrumAnalyzers.Clear();
 
 	// remember frequency resolution
@@ -211,12 +212,8 @@ void SpectrogramBandsPlugin::ChannelBandsDataProxy::ReInit()
 			LogError("Samplerate of the channels do not match while initializing ChannelBandsDataProxy!");
 		}
 
-		// create a spectrum analyzer
-		FFTProcessor* analyzer = new FFTProcessor();
-		analyzer->SetInput(channel);
-		analyzer->Setup(GetEngine()->GetSpectrumAnalyzerSettings()->GetFFTSettings());
-		analyzer->ReInit();
-
+		// get the shared spectrum analyzer (only the last spectrum is displayed)
+		SpectrumAnalyzerCache::Entry* analyzer = GetEngine()->GetSpectrumAnalyzerCache()->Acquire(channel, GetEngine()->GetSpectrumAnalyzerSettings()->GetFFTSettings(), 1);
 		mSpectrumAnalyzers.Add(analyzer);
 
 		// init data array row by row
@@ -224,10 +221,24 @@ void SpectrogramBandsPlugin::ChannelBandsDataProxy::ReInit()
 		*mData << row;
 	}
 
+	const uint32 numOldAnalyzers = oldAnalyzers.Size();
+	for (uint32 i=0; i<numOldAnalyzers; i++)
+		GetEngine()->GetSpectrumAnalyzerCache()->Release(oldAnalyzers[i], 1);
+
 	resetArray(mData);
 }
 
 
+// drop the references to the shared spectrum analyzers
+void SpectrogramBandsPlugin::ChannelBandsDataProxy::ReleaseSpectrumAnalyzers()
+{
+	const uint32 numAnalyzers = mSpectrumAnalyzers.Size();
+	for (uint32 i=0; i<numAnalyzers; i++)
+		GetEngine()->GetSpectrumAnalyzerCache()->Release(mSpectrumAnalyzers[i], 1);
+	mSpectrumAnalyzers.Clear();
+}
+
+
 // data proxy update : fill visualization arrays with data
 void SpectrogramBandsPlugin::ChannelBandsDataProxy::Update()
 {
@@ -241,10 +252,11 @@ void SpectrogramBandsPlugin::ChannelBandsDataProxy::Update()
 	if (settings->GetNumFFTBins() != mNumBins || settings->GetNumWindowShiftSamples() != mNumShiftSamples || settings->GetWindowFunction()->GetType() != mWindowFunctionType)
 		ReInit();
 
-	// update spectrum analyzer
+	// update spectrum analyzers (shared ones are calculated only once per engine update)
+	SpectrumAnalyzerCache* cache = GetEngine()->GetSpectrumAnalyzerCache();
 	const uint32 numAnalyzers = mSpectrumAnalyzers.Size();
 	for (uint32 i=0; i<numAnalyzers; i++)
-		mSpectrumAnalyzers[i]->Update();
+		cache->Update(mSpectrumAnalyzers[i]);
 
 	// reset to extremes
 	mMinValue = DBL_MAX;
@@ -254,9 +266,11 @@ void SpectrogramBandsPlugin::ChannelBandsDataProxy::Update()
 	for (int c = 0; c < numChannels; c++)
 	{
 		Channel<double>* channel = mChannels[c];
-		Channel<Spectrum>* output = mSpectrumAnalyzers[c]->GetOutput()->AsType<Spectrum>();
-		
-		if (output->GetNumSamples() == 0)
+		if (mSpectrumAnalyzers[c] == NULL)
+			continue;
+
+		Channel<Spectrum>* output = mSpectrumAnalyzers[c]->GetOutput();
+		if (output == NULL || output->GetNumSamples() == 0)
 			continue; 
 
 		const Spectrum* spectrum = &output->GetLastSample();
@@ -356,7 +370,11 @@ void SpectrogramBandsPlugin::OnChannelSelectionChanged()
 	// check that max frequency is consitent for all channels
 	for (int i = 0; i < numSelected; i++)
 	{
-		const double currentMaxFrequency = mDataProxy->GetSpectrumAnalyzer(i)->GetOutput()->GetSampleRate() / 2.0;
+		SpectrumAnalyzerCache::Entry* analyzer = mDataProxy->GetSpectrumAnalyzer(i);
+		if (analyzer == NULL || analyzer->GetOutput() == NULL)
+			continue;
+
+		const double currentMaxFrequency = analyzer->GetOutput()->GetSampleRate() / 2.0;
 		if (maxFrequency == -1)
 		{
 			maxFrequency = currentMaxFrequency;
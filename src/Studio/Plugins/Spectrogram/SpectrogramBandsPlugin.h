@@ -30,7 +30,7 @@
 #include "../../Widgets/ChannelMultiSelectionWidget.h"
 #include <Core/String.h>
 #include <Sensor.h>
-#include <DSP/FFTProcessor.h>
+#include <DSP/SpectrumAnalyzerCache.h>
 
 #ifdef USE_QTDATAVISUALIZATION
 
@@ -57,10 +57,7 @@ class SpectrogramBandsPlugin : public SpectrogramPlugin
 			}
 			~ChannelBandsDataProxy()
 			{
-				const uint32 numAnalyzers = mSpectrumAnalyzers.Size();
-				for (uint32 i=0; i<numAnalyzers; i++)
-					delete mSpectrumAnalyzers[i];
-				mSpectrumAnalyzers.Clear();
+				ReleaseSpectrumAnalyzers();
 			}
 			
 			void ReInit();
@@ -70,7 +67,7 @@ class SpectrogramBandsPlugin : public SpectrogramPlugin
 			Channel<double>* GetChannel(uint32 index)			{ return mChannels[index]; }
 			void Clear()										{ mChannels.Clear(); }
 
-			FFTProcessor* GetSpectrumAnalyzer(uint32 index)		{ return mSpectrumAnalyzers[index]; }
+			SpectrumAnalyzerCache::Entry* GetSpectrumAnalyzer(uint32 index)		{ return mSpectrumAnalyzers[index]; }
 			
 			inline uint32 GetNumBins() const					{ return GetEngine()->GetSpectrumAnalyzerSettings()->GetNumFrequencyBands(); }
 			inline uint32 GetNumChannels() const				{ return (uint32)(mChannels.Size()); }
@@ -78,9 +75,11 @@ class SpectrogramBandsPlugin : public SpectrogramPlugin
 			void SetConvertToDezibel(bool enable = true)		{ mConvertToDezibel = enable; }
 
 		private:
+			void ReleaseSpectrumAnalyzers();
+
 			QBarDataArray*						mData;				// deallocated by QT
 			Core::Array<Channel<double>*>		mChannels;
-			Core::Array<FFTProcessor*>			mSpectrumAnalyzers;
+			Core::Array<SpectrumAnalyzerCache::Entry*>	mSpectrumAnalyzers;	// shared with the other views and FFT nodes
 			double								mMaxFrequency;
 			bool								mConvertToDezibel;	// convert spectrum values from uV to uVdB for rendering
 			uint32								mNumBins;			// number of frequency bins (size of mesh in frequency direction)
@@ -266,18 +266,19 @@ void SpectrogramSurfacePlugin::SurfaceDataProxy::ReInit()
 	// remember window function
 	mWindowFunctionType = GetEngine()->GetSpectrumAnalyzerSettings()->GetWindowFunction()->GetType();
 
-	// remember sampling rate
-	const double inputSampleRate = mSpectrumAnalyzer.GetOutput()->GetSampleRate();
-	mSampleRate = inputSampleRate;
+	// remember sampling rate (of the spectra)
+	mSampleRate = mChannel->GetSampleRate() / (double)Max<uint32>(mNumShiftSamples, 1);
 
 	// calculate number of (downsampled) spectrums to keep in the display buffer
 	mNumSamples = (uint32)(mSampleRate * mDuration) + 1;
 
-	// configure spectrum analyzer
-	mSpectrumAnalyzer.SetInput(mChannel);
-	mSpectrumAnalyzer.GetOutput()->SetBufferSize(2*mNumSamples);
-	mSpectrumAnalyzer.Setup(GetEngine()->GetSpectrumAnalyzerSettings()->GetFFTSettings());
-	mSpectrumAnalyzer.ReInit();
+	// get the shared spectrum analyzer before releasing the old one, so an unchanged one is reused
+	SpectrumAnalyzerCache* cache = GetEngine()->GetSpectrumAnalyzerCache();
+	SpectrumAnalyzerCache::Entry* analyzer = cache->Acquire(mChannel, GetEngine()->GetSpectrumAnalyzerSettings()->GetFFTSettings(), 2*mNumSamples);
+	cache->Release(mSpectrumAnalyzer, mSpectrumAnalyzerHistorySize);
+	mSpectrumAnalyzer = analyzer;
+	mSpectrumAnalyzerHistorySize = 2*mNumSamples;
+	mSpectrumAnalyzerRevision = CORE_INVALIDINDEX32;
 
 	
 	// pre-allocate surface data array
@@ -293,13 +294,32 @@ void SpectrogramSurfacePlugin::SurfaceDataProxy::Update()
 	if (mChannel == NULL)
 		return;
 
-	mSpectrumAnalyzer.Update();
-	Channel<Spectrum>* output = mSpectrumAnalyzer.GetOutput()->AsType<Spectrum>();
+	// shared analyzers are calculated only once per engine update
+	GetEngine()->GetSpectrumAnalyzerCache()->Update(mSpectrumAnalyzer);
+	Channel<Spectrum>* output = GetSpectrumOutput();
+	if (output == NULL)
+		return;
+
 	SpectrumAnalyzerSettings* settings = GetEngine()->GetSpectrumAnalyzerSettings();
 
 	// force reinit if FFT settings have changed
 	if (settings->GetNumFFTBins() != mNumBins || output->GetSampleRate() != mSampleRate || settings->GetNumWindowShiftSamples() != mNumShiftSamples || settings->GetWindowFunction()->GetType() != mWindowFunctionType)
+	{
+		// the reinit acquires another analyzer
 		ReInit();
+		GetEngine()->GetSpectrumAnalyzerCache()->Update(mSpectrumAnalyzer);
+		output = GetSpectrumOutput();
+		if (output == NULL)
+			return;
+	}
+
+	// the shared output got replaced or cleared: start over with the spectra it holds
+	if (mSpectrumAnalyzer->GetOutputRevision() != mSpectrumAnalyzerRevision)
+	{
+		Clear();
+		mLastIndex = output->GetContinuousSampleCounter() - Min<uint64>(output->GetNumSamples(), mNumSamples);
+		mSpectrumAnalyzerRevision = mSpectrumAnalyzer->GetOutputRevision();
+	}
 
 	// current number of rows (time axis)
 	uint32 numRows = (uint32)mData->size();
@@ -465,8 +485,8 @@ void SpectrogramSurfacePlugin::UpdateTimeAxis()
 
 	float currentTime = 0.0;
 	if (mDataProxy->GetChannel() != NULL)
-		if (mDataProxy->GetSpectrumAnalyzer()->GetOutput()->GetNumSamples() > 0)
-			currentTime = mDataProxy->GetSpectrumAnalyzer()->GetOutput()->AsType<Spectrum>()->GetLastSample().GetTime();
+		if (mDataProxy->GetSpectrumOutput() != NULL && mDataProxy->GetSpectrumOutput()->GetNumSamples() > 0)
+			currentTime = mDataProxy->GetSpectrumOutput()->GetLastSample().GetTime();
 
 	mGraph->axisZ()->setRange(currentTime - mIntervalLength, currentTime);
 }
@@ -526,7 +546,8 @@ void SpectrogramSurfacePlugin::OnChannelSelectionChanged(Channel<double>* channe
 {
 	mDataProxy->SetChannel(channel);
 	// update max frequency in base class
-	SetFrequencyRange(0, mDataProxy->GetSpectrumAnalyzer()->GetInput()->GetSampleRate() / 2.0);
+	if (channel != NULL)
+		SetFrequencyRange(0, channel->GetSampleRate() / 2.0);
 }
 
 
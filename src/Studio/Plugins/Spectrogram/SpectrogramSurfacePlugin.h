@@ -33,7 +33,7 @@
 #ifdef USE_QTDATAVISUALIZATION
 
 #include <QtDataVisualization/q3dsurface.h>
-#include <DSP/FFTProcessor.h>
+#include <DSP/SpectrumAnalyzerCache.h>
 
 using namespace QtDataVisualization;
 
@@ -77,13 +77,14 @@ class SpectrogramSurfacePlugin : public SpectrogramPlugin
 				mConvertToDezibel = false;
 				mLastTime = 0.0;
 				mLastIndex = 0;
-					
-				mSpectrumAnalyzer.Init();
-				mSpectrumAnalyzer.GetOutput()->SetBufferSize(0);
+				mSpectrumAnalyzer = NULL;
+				mSpectrumAnalyzerHistorySize = 0;
+				mSpectrumAnalyzerRevision = CORE_INVALIDINDEX32;
 			}
 
 			~SurfaceDataProxy() 
 			{
+				GetEngine()->GetSpectrumAnalyzerCache()->Release(mSpectrumAnalyzer, mSpectrumAnalyzerHistorySize);
 			}
 
 			virtual void Update();								// copy new spectrum values to data proxy
@@ -98,13 +99,15 @@ class SpectrogramSurfacePlugin : public SpectrogramPlugin
 
 			void SetConvertToDezibel(bool enable = true)		{ if (mConvertToDezibel != enable) { mConvertToDezibel = enable; ReInit(); } }
 
-			FFTProcessor* GetSpectrumAnalyzer()					{ return &mSpectrumAnalyzer; }
+			Channel<Spectrum>* GetSpectrumOutput()				{ return (mSpectrumAnalyzer != NULL ? mSpectrumAnalyzer->GetOutput() : NULL); }
 				
 		private:
 			QSurfaceDataArray*	mData;						// deallocated by QT
 
 			Channel<double>*	mChannel;					// the displayed channel
-			FFTProcessor		mSpectrumAnalyzer;			// one spectrum analyzer for each channel
+			SpectrumAnalyzerCache::Entry* mSpectrumAnalyzer;	// shared spectrum analyzer of the channel (keeps twice the displayed spectra)
+			uint32				mSpectrumAnalyzerHistorySize;	// history size the analyzer was acquired with
+			uint32				mSpectrumAnalyzerRevision;	// output revision of the analyzer the running index refers to
 			double				mSampleRate;				// sampling rate of the spectrum sampler
 				
 			double				mDuration;					// displayed intervalsize in seconds
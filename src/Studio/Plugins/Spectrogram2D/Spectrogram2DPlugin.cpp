@@ -44,13 +44,20 @@ Spectrogram2DPlugin::~Spectrogram2DPlugin()
 {
 	LogDetailedInfo("Destructing raw spectrum plugin ...");
 	
-	// dealloc spectrum analyzers (simple solution)
+	ReleaseSpectrumAnalyzers();
+	mAverageSpectra.Clear();
+}
+
+
+// drop the references to the shared spectrum analyzers
+void Spectrogram2DPlugin::ReleaseSpectrumAnalyzers()
+{
 	const uint32 numAnalyzers = mSpectrumAnalyzers.Size();
 	for (uint32 i=0; i<numAnalyzers; ++i)
-		delete mSpectrumAnalyzers[i];
+		GetEngine()->GetSpectrumAnalyzerCache()->Release(mSpectrumAnalyzers[i], mNumAverageSpectra[i]);
 
 	mSpectrumAnalyzers.Clear();
-	mAverageSpectra.Clear();
+	mNumAverageSpectra.Clear();
 }
 
 
@@ -189,10 +196,11 @@ void Spectrogram2DPlugin::RealtimeUpdate()
 {
 
 	udpateSelectedChannels();
-	// must always update spectrum analyzers
+	// must always update spectrum analyzers (shared ones are calculated only once per engine update)
+	SpectrumAnalyzerCache* cache = GetEngine()->GetSpectrumAnalyzerCache();
 	const uint32 numAnalyzers = mSpectrumAnalyzers.Size();
 	for (uint32 i = 0; i < numAnalyzers; ++i)
-		mSpectrumAnalyzers[i]->Update();
+		cache->Update(mSpectrumAnalyzers[i]);
 
 	if (mSpectrumWidget != NULL && mSpectrumWidget->isVisible() == true)
 		mSpectrumWidget->update();
@@ -204,34 +212,15 @@ void Spectrogram2DPlugin::ReInit()
 	// clear channel list
 	mChannels.Clear();
 
-	// dealloc spectrum analyzers
-	const uint32 numAnalyzers = mSpectrumAnalyzers.Size();
-	for (uint32 i = 0; i < numAnalyzers; ++i)
-		delete mSpectrumAnalyzers[i];
-	mSpectrumAnalyzers.Clear();
-
 	mAverageSpectra.Clear();
 
 	Array<Channel<double>*> channels = mChannelSelectionWidget->GetSelectedChannels();
-	const FFTProcessor::FFTSettings& settings = GetEngine()->GetSpectrumAnalyzerSettings()->GetFFTSettings();
 
-	// put each channel in a separate chartform
+	// put each channel in a separate chartform (the spectrum analyzers are acquired in SetAverageInterval())
 	const int numSelected = channels.Size();
 	for (int i = 0; i < numSelected; i++)
 	{
-		// get channel and create the spectrum analyzer, add it to waveform
-		Channel<double>* channel = channels[i];
-		FFTProcessor* analyzer = new FFTProcessor();
-
-		// connect and configure FFT
-		analyzer->SetInput(channel);
-		analyzer->Setup(settings);
-		analyzer->SetUseZeroPadding(true);
-		analyzer->ReInit();
-
-		// store everythin in the lists
-		mChannels.Add(channel);
-		mSpectrumAnalyzers.Add(analyzer);
+		mChannels.Add(channels[i]);
 		mAverageSpectra.AddEmpty();
 	}
 
@@ -260,7 +249,7 @@ void Spectrogram2DPlugin::ReInit()
 	// remember window function
 	mWindowFunctionType = GetEngine()->GetSpectrumAnalyzerSettings()->GetWindowFunction()->GetType();
 
-	// set the current channel spectrum analyzer statistic size
+	// acquire the spectrum analyzers with the current average interval
 	SetAverageInterval( GetAverageInterval() );
 
 	SetMultiView( GetMultiView() );
@@ -286,13 +275,19 @@ void Spectrogram2DPlugin::UpdateInterface()
 	mViewedSpectrums.Resize(numAnalyzers);
 
 	// update spectrum analyzers and calculate averages
+	SpectrumAnalyzerCache* cache = GetEngine()->GetSpectrumAnalyzerCache();
 	for (uint32 i=0; i<numAnalyzers; ++i)
 	{
-		mSpectrumAnalyzers[i]->Update();
+		cache->Update(mSpectrumAnalyzers[i]);
 
-		// calculate average and (uses output channel spectrum directly)
-		Channel<Spectrum>* spectra = mSpectrumAnalyzers[i]->GetOutput()->AsType<Spectrum>();
-		spectra->CalculateAverage(&mAverageSpectra[i]);
+		// calculate average over the last spectra (the shared output may hold more than the interval)
+		Channel<Spectrum>* spectra = (mSpectrumAnalyzers[i] != NULL ? mSpectrumAnalyzers[i]->GetOutput() : NULL);
+		if (spectra != NULL && spectra->GetNumSamples() > 0)
+		{
+			const uint64 maxSampleIndex = spectra->GetMaxSampleIndex();
+			const uint64 numAverageSpectra = Min<uint64>( Max<uint32>(mNumAverageSpectra[i], 1), spectra->GetNumSamples() );
+			spectra->CalculateAverage( &mAverageSpectra[i], maxSampleIndex + 1 - numAverageSpectra, maxSampleIndex );
+		}
 
 		mSpectrumWidget->UpdateSpectrum(i, &mAverageSpectra[i]);
 		mViewedSpectrums[i] = &mAverageSpectra[i];
@@ -308,25 +303,36 @@ void Spectrogram2DPlugin::OnChannelSelectionChanged()
 
 void Spectrogram2DPlugin::SetAverageInterval(double length)
 {
+	SpectrumAnalyzerCache* cache = GetEngine()->GetSpectrumAnalyzerCache();
+
+	// this view always pads incomplete epochs with zeros (so it does not share the analyzers of views and nodes without padding)
+	FFTProcessor::FFTSettings settings = GetEngine()->GetSpectrumAnalyzerSettings()->GetFFTSettings();
+	settings.mUseZeroPadding = true;
+
+	// keep the old analyzers referenced until the new ones are acquired, so they are not recreated
+	Array<SpectrumAnalyzerCache::Entry*> oldAnalyzers = mSpectrumAnalyzers;
+	Array<uint32> oldNumAverageSpectra = mNumAverageSpectra;
+	mSpectrumAnalyzers.Clear();
+	mNumAverageSpectra.Clear();
+
 	const uint32 numChannels = mChannels.Size();
 	for (uint32 i = 0; i < numChannels; i++)
 	{
-		FFTProcessor* analyzer = mSpectrumAnalyzers[i];
-		const uint32 sampleRate = analyzer->GetOutput()->GetSampleRate();
-		
-		uint32 numSamples = length * sampleRate;
-		if (length == 0)
+		Channel<double>* channel = mChannels[i];
+		const double spectrumSampleRate = channel->GetSampleRate() / (double)Max<uint32>(settings.mEpochShift, 1);
+
+		// number of spectra we want to average (the shared analyzer keeps at least this many)
+		uint32 numSamples = length * spectrumSampleRate;
+		if (numSamples == 0)
 			numSamples = 1;
 
-		// set buffer size of fft processor output channel to the number of samples we want to average
-		ChannelBase* output = mSpectrumAnalyzers[i]->GetOutput();
-		
-		// resize the output channel which holds the samples for averaging
-		output->Reset();
-		output->Clear(true);					// deallocate, so SetBufferSize() will shrink the array
-		output->SetBufferSize(numSamples);		// resize the buffer to the interval
-		output->Reset();
+		mSpectrumAnalyzers.Add( cache->Acquire(channel, settings, numSamples) );
+		mNumAverageSpectra.Add(numSamples);
 	}
+
+	const uint32 numOldAnalyzers = oldAnalyzers.Size();
+	for (uint32 i = 0; i < numOldAnalyzers; i++)
+		cache->Release(oldAnalyzers[i], oldNumAverageSpectra[i]);
 }
 
 void Spectrogram2DPlugin::udpateSelectedChannels()
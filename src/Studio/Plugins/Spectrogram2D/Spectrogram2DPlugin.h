@@ -30,7 +30,7 @@
 #include "Spectrogram2DWidget.h"
 #include <AttributeWidgets/Property.h>
 #include "../../Widgets/ChannelMultiSelectionWidget.h"
-#include <DSP/FFTProcessor.h>
+#include <DSP/SpectrumAnalyzerCache.h>
 
 
 // universal waveform plugin
@@ -75,11 +75,13 @@ class Spectrogram2DPlugin : public Plugin
 	private:
 		void enableHorizontalViewCheckbox(bool enable);
 		void udpateSelectedChannels();
+		void ReleaseSpectrumAnalyzers();
 	
 	private:
 		// selected channels
 		Core::Array<Channel<double>*>		mChannels;					// list of the selected channels				// TODO get rid of these
-		Core::Array<FFTProcessor*>			mSpectrumAnalyzers;			// one FFT processor for each channel
+		Core::Array<SpectrumAnalyzerCache::Entry*> mSpectrumAnalyzers;	// one shared spectrum analyzer for each channel
+		Core::Array<uint32>					mNumAverageSpectra;			// number of spectra in the average interval for each channel
 		Core::Array<Spectrum>				mAverageSpectra;			// holds the current average (the display values)
 
 		ChannelMultiSelectionWidget*		mChannelSelectionWidget;
@@ -35,6 +35,7 @@ ViewPlugin::ViewPlugin() : Plugin(GetStaticTypeUuid())
 {
 	LogDetailedInfo("Constructing Signal View plugin ...");
 	mViewWidget			= NULL;
+	mIsViewConsumer		= false;
 }
 
 
@@ -43,6 +44,9 @@ ViewPlugin::~ViewPlugin()
 {
 	LogDetailedInfo("Destructing Signal View plugin ...");
 	CORE_EVENTMANAGER.RemoveEventHandler(this);
+
+	if (mIsViewConsumer == true)
+		GetEngine()->RemoveViewConsumer(EngineManager::VIEWTYPE_SIGNAL);
 }
 
 
@@ -95,6 +99,8 @@ bool ViewPlugin::Init()
 
 	vWidget->show();
 	
+	// we do not handle any of the core events
+	UnsubscribeAllEvents();
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	LogDetailedInfo("Signal View plugin successfully initialized");
@@ -138,6 +144,25 @@ void ViewPlugin::RegisterAttributes()
 }
 
 
+// real-time update
+void ViewPlugin::RealtimeUpdate()
+{
+	// the view nodes with signal inputs are only updated while a view shows them (demand tracking)
+	const bool isShown = (mViewWidget != NULL && mViewWidget->isVisible() == true);
+	if (isShown != mIsViewConsumer)
+	{
+		if (isShown == true)
+			GetEngine()->AddViewConsumer(EngineManager::VIEWTYPE_SIGNAL);
+		else
+			GetEngine()->RemoveViewConsumer(EngineManager::VIEWTYPE_SIGNAL);
+
+		mIsViewConsumer = isShown;
+	}
+
+	Plugin::RealtimeUpdate();
+}
+
+
 void ViewPlugin::OnAttributeChanged(Property* property)
 {
 	const String& propertyInternalName = property->GetAttributeSettings()->GetInternalNameString();
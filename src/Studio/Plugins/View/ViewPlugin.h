@@ -65,6 +65,7 @@ class ViewPlugin : public Plugin, public Core::EventHandler
 		//void ReInit();
 
 		void RegisterAttributes() override;
+		void RealtimeUpdate() override;
 		
 		// get settings
 		double		 GetTimeRange()											{ return GetFloatAttribute(ATTRIB_TIMERANGE); }
@@ -85,6 +86,7 @@ class ViewPlugin : public Plugin, public Core::EventHandler
 	private:
 
 		ViewWidget*	mViewWidget;
+		bool		mIsViewConsumer;
 };
 
 
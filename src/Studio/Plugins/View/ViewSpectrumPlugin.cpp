@@ -34,6 +34,7 @@ ViewSpectrumPlugin::ViewSpectrumPlugin() : Plugin(GetStaticTypeUuid())
 {
 	LogDetailedInfo("Constructing Spectrum View plugin ...");
 	mViewWidget			= NULL;
+	mIsViewConsumer		= false;
 }
 
 
@@ -42,6 +43,9 @@ ViewSpectrumPlugin::~ViewSpectrumPlugin()
 {
 	LogDetailedInfo("Destructing Spectrum View plugin ...");
 	CORE_EVENTMANAGER.RemoveEventHandler(this);
+
+	if (mIsViewConsumer == true)
+		GetEngine()->RemoveViewConsumer(EngineManager::VIEWTYPE_SPECTRUM);
 }
 
 
@@ -94,6 +98,8 @@ bool ViewSpectrumPlugin::Init()
 
 	vWidget->show();
 	
+	// we do not handle any of the core events
+	UnsubscribeAllEvents();
 	CORE_EVENTMANAGER.AddEventHandler(this);
 
 	LogDetailedInfo("Spectrum View plugin successfully initialized");
@@ -129,6 +135,25 @@ void ViewSpectrumPlugin::RegisterAttributes()
 }
 
 
+// real-time update
+void ViewSpectrumPlugin::RealtimeUpdate()
+{
+	// keep the view nodes with spectrum inputs running while the widget is visible (demand tracking)
+	const bool isShown = (mViewWidget != NULL && mViewWidget->isVisible() == true);
+	if (isShown != mIsViewConsumer)
+	{
+		if (isShown == true)
+			GetEngine()->AddViewConsumer(EngineManager::VIEWTYPE_SPECTRUM);
+		else
+			GetEngine()->RemoveViewConsumer(EngineManager::VIEWTYPE_SPECTRUM);
+
+		mIsViewConsumer = isShown;
+	}
+
+	Plugin::RealtimeUpdate();
+}
+
+
 uint32 ViewSpectrumPlugin::GetNumMultiChannels()
 {
 	Classifier* classifier = GetEngine()->GetActiveClassifier();
@@ -60,6 +60,7 @@ class ViewSpectrumPlugin : public Plugin, public Core::EventHandler
 		bool Init() override;
 
 		void RegisterAttributes() override;
+		void RealtimeUpdate() override;
 
 		double GetMinFrequency()											{ return GetFloatAttribute(ATTRIB_MINFREQUENCY); }
 		double GetMaxFrequency()											{ return GetFloatAttribute(ATTRIB_MAXFREQUENCY); }
@@ -71,6 +72,7 @@ class ViewSpectrumPlugin : public Plugin, public Core::EventHandler
 
 	private:
 		ViewSpectrumWidget*		mViewWidget;
+		bool					mIsViewConsumer;
 };
 
 
@@ -107,6 +107,9 @@ void ViewWidget::paintGL()
 
 	RenderSplitViews(numMultiChannels);
 
+	// destroy the pyramids of channels that are not displayed anymore
+	mPyramids.RemoveUnused();
+
 	// post rendering
 	PostRendering();
 }
@@ -201,7 +204,7 @@ void ViewWidget::RenderCallback::Render(uint32 index, bool isHighlighted, double
 	{
 		Channel<double>* channel = channels.GetChannel(i)->AsType<double>();
 		const Color& color = mViewWidget->mPlugin->GetChannelColor(index, i);
-		OpenGLWidget2DHelpers::RenderChart( this, channel, color, style, timeRange, maxTime, rangeMin, rangeMax, areaStartX, width, height, height,  drawLatencyMarker);
+		OpenGLWidget2DHelpers::RenderChart( this, channel, color, style, timeRange, maxTime, rangeMin, rangeMax, areaStartX, width, height, height,  drawLatencyMarker, mViewWidget->mPyramids.Get(channel));
 
 		// Render channels text
 		if (channel->GetSourceNameString().IsEmpty() == false)
@@ -0,0 +1,348 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include precompiled header
+#include <Studio/Precompiled.h>
+
+// include the required headers
+#include "MinMaxPyramid.h"
+
+using namespace Core;
+
+// constructor
+MinMaxPyramid::MinMaxPyramid()
+{
+	mChannel			= NULL;
+	mBufferSize			= 0;
+	mFirstSampleIndex	= 0;
+	mNumProcessed		= 0;
+	mLastValue			= 0.0;
+}
+
+
+// destructor
+MinMaxPyramid::~MinMaxPyramid()
+{
+}
+
+
+// forget the channel and release the levels
+void MinMaxPyramid::Clear()
+{
+	mChannel			= NULL;
+	mBufferSize			= 0;
+	mFirstSampleIndex	= 0;
+	mNumProcessed		= 0;
+	mLastValue			= 0.0;
+
+	for (uint32 i=0; i<NUM_LEVELS; ++i)
+		mLevels[i].Clear();
+}
+
+
+// start over with the oldest sample of the channel
+void MinMaxPyramid::Reset(Channel<double>* channel)
+{
+	mChannel	= channel;
+	mBufferSize	= channel->GetBufferSize();
+	mLastValue	= 0.0;
+
+	if (channel->IsEmpty() == true)
+		mFirstSampleIndex = channel->GetSampleCounter();
+	else
+		mFirstSampleIndex = channel->GetMinSampleIndex();
+
+	mNumProcessed = mFirstSampleIndex;
+
+	// ring buffer channels: allocate enough blocks to cover the whole buffer plus the partially filled blocks at both ends
+	// storage channels: levels grow with the channel
+	for (uint32 i=0; i<NUM_LEVELS; ++i)
+	{
+		if (mBufferSize > 0)
+			mLevels[i].Resize( (mBufferSize >> GetLevelShift(i)) + 2 );
+		else
+			mLevels[i].Clear(false);
+	}
+}
+
+
+// fold all new samples into the pyramid
+void MinMaxPyramid::Update(Channel<double>* channel)
+{
+	if (channel == NULL)
+	{
+		Clear();
+		return;
+	}
+
+	const uint64 sampleCounter = channel->GetSampleCounter();
+
+	// rebuild the pyramid in case the channel changed, was cleared or we fell behind more than the buffer size
+	bool reset = (channel != mChannel || channel->GetBufferSize() != mBufferSize || sampleCounter < mNumProcessed);
+	if (reset == false && mNumProcessed > mFirstSampleIndex)
+	{
+		if (channel->IsEmpty() == true || mNumProcessed - 1 < channel->GetMinSampleIndex())
+			reset = true;
+		else
+		{
+			const double lastValue = channel->GetSample(mNumProcessed - 1);
+			if (memcmp(&lastValue, &mLastValue, sizeof(double)) != 0)	// bitwise, so NaN samples do not trigger a rebuild every frame
+				reset = true;
+		}
+	}
+
+	if (reset == true)
+		Reset(channel);
+
+	if (channel->IsEmpty() == true)
+		return;
+
+	// the samples before the oldest one in the channel are gone
+	if (mNumProcessed < channel->GetMinSampleIndex())
+		Reset(channel);
+
+	for (uint64 i=mNumProcessed; i<sampleCounter; ++i)
+		AddSample( i, channel->GetSample(i) );
+
+	mNumProcessed = sampleCounter;
+}
+
+
+// add a single sample to the finest level and propagate completed blocks upwards
+void MinMaxPyramid::AddSample(uint64 sampleIndex, double value)
+{
+	mLastValue = value;
+
+	// finest level
+	const uint32 baseShift = GetLevelShift(0);
+	const uint64 baseMask = ((uint64)1 << baseShift) - 1;
+	uint64 blockIndex = sampleIndex >> baseShift;
+
+	Block& block = GetBlock(0, blockIndex);
+	if ((sampleIndex & baseMask) == 0 || sampleIndex == mFirstSampleIndex)
+	{
+		block.mMin = value;
+		block.mMax = value;
+		block.mSum = value;
+	}
+	else
+	{
+		block.mMin = Min<double>(block.mMin, value);
+		block.mMax = Max<double>(block.mMax, value);
+		block.mSum += value;
+	}
+
+	// block not complete yet
+	if (((sampleIndex + 1) & baseMask) != 0)
+		return;
+
+	// merge the completed block into the coarser levels
+	const uint64 childMask = ((uint64)1 << LEVEL_SHIFT) - 1;
+	for (uint32 level=1; level<NUM_LEVELS; ++level)
+	{
+		const Block child = GetBlock(level - 1, blockIndex);
+		const uint64 firstChildIndex = mFirstSampleIndex >> GetLevelShift(level - 1);
+
+		const uint64 parentIndex = blockIndex >> LEVEL_SHIFT;
+		Block& parent = GetBlock(level, parentIndex);
+		if ((blockIndex & childMask) == 0 || blockIndex == firstChildIndex)
+			parent = child;
+		else
+		{
+			parent.mMin = Min<double>(parent.mMin, child.mMin);
+			parent.mMax = Max<double>(parent.mMax, child.mMax);
+			parent.mSum += child.mSum;
+		}
+
+		// parent not complete yet
+		if ((blockIndex & childMask) != childMask)
+			return;
+
+		blockIndex = parentIndex;
+	}
+}
+
+
+// get block (ring buffer channels wrap around, storage channels grow)
+MinMaxPyramid::Block& MinMaxPyramid::GetBlock(uint32 level, uint64 blockIndex)
+{
+	Array<Block>& blocks = mLevels[level];
+	if (mBufferSize > 0)
+		return blocks[blockIndex % blocks.Size()];
+
+	const uint32 index = (uint32)(blockIndex - (mFirstSampleIndex >> GetLevelShift(level)));
+	if (index >= blocks.Size())
+		blocks.Resize(index + 1);
+
+	return blocks[index];
+}
+
+
+// get block (const version, block must exist)
+const MinMaxPyramid::Block& MinMaxPyramid::GetBlock(uint32 level, uint64 blockIndex) const
+{
+	const Array<Block>& blocks = mLevels[level];
+	if (mBufferSize > 0)
+		return blocks[blockIndex % blocks.Size()];
+
+	return blocks[(uint32)(blockIndex - (mFirstSampleIndex >> GetLevelShift(level)))];
+}
+
+
+// find min/max/sum of a sample range by combining the largest aligned blocks that fit and reading only the unaligned samples at the edges
+bool MinMaxPyramid::CalcRange(uint64 minSampleIndex, uint64 maxSampleIndex, double* outMin, double* outMax, double* outSum, uint64* outNumSamples) const
+{
+	if (mChannel == NULL || mChannel->IsEmpty() == true || mNumProcessed == mFirstSampleIndex)
+		return false;
+
+	// clamp to the samples that are both inside the channel and the pyramid
+	minSampleIndex = Max<uint64>( minSampleIndex, Max<uint64>(mFirstSampleIndex, mChannel->GetMinSampleIndex()) );
+	maxSampleIndex = Min<uint64>( maxSampleIndex, mNumProcessed - 1 );
+	if (minSampleIndex > maxSampleIndex)
+		return false;
+
+	double minValue = DBL_MAX;
+	double maxValue = -DBL_MAX;
+	double sum = 0.0;
+
+	const uint64 end = maxSampleIndex + 1;
+	uint64 index = minSampleIndex;
+	while (index < end)
+	{
+		// find the coarsest block that starts at the current index and fits into the range
+		int32 level = NUM_LEVELS - 1;
+		for (; level>=0; --level)
+		{
+			const uint32 shift = GetLevelShift(level);
+			const uint64 blockSize = (uint64)1 << shift;
+			if ((index & (blockSize - 1)) == 0 && index + blockSize <= end)
+				break;
+		}
+
+		// no block fits: use the raw sample
+		if (level < 0)
+		{
+			const double value = mChannel->GetSample(index);
+			minValue = Min<double>(minValue, value);
+			maxValue = Max<double>(maxValue, value);
+			sum += value;
+			++index;
+			continue;
+		}
+
+		const uint32 shift = GetLevelShift(level);
+		const Block& block = GetBlock(level, index >> shift);
+		minValue = Min<double>(minValue, block.mMin);
+		maxValue = Max<double>(maxValue, block.mMax);
+		sum += block.mSum;
+		index += (uint64)1 << shift;
+	}
+
+	*outMin = minValue;
+	*outMax = maxValue;
+	if (outSum != NULL)
+		*outSum = sum;
+	if (outNumSamples != NULL)
+		*outNumSamples = end - minSampleIndex;
+
+	return true;
+}
+
+
+// memory used by the pyramid in bytes
+uint32 MinMaxPyramid::CalcMemoryUsed() const
+{
+	uint32 numBytes = sizeof(MinMaxPyramid);
+	for (uint32 i=0; i<NUM_LEVELS; ++i)
+		numBytes += mLevels[i].Size() * sizeof(Block);
+
+	return numBytes;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MinMaxPyramidCache
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// constructor
+MinMaxPyramidCache::MinMaxPyramidCache()
+{
+}
+
+
+// destructor
+MinMaxPyramidCache::~MinMaxPyramidCache()
+{
+	Clear();
+}
+
+
+// find or create the pyramid for the given channel
+MinMaxPyramid* MinMaxPyramidCache::Get(Channel<double>* channel)
+{
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		if (mEntries[i].mPyramid->GetChannel() == channel)
+		{
+			mEntries[i].mIsUsed = true;
+			return mEntries[i].mPyramid;
+		}
+	}
+
+	Entry& entry = mEntries.AddEmpty();
+	entry.mPyramid = new MinMaxPyramid();
+	entry.mPyramid->Update(channel);
+	entry.mIsUsed = true;
+
+	return entry.mPyramid;
+}
+
+
+// destroy the pyramids of channels that are no longer displayed
+void MinMaxPyramidCache::RemoveUnused()
+{
+	for (uint32 i=0; i<mEntries.Size();)
+	{
+		if (mEntries[i].mIsUsed == false)
+		{
+			delete mEntries[i].mPyramid;
+			mEntries.Remove(i);
+			continue;
+		}
+
+		mEntries[i].mIsUsed = false;
+		++i;
+	}
+}
+
+
+// destroy all pyramids
+void MinMaxPyramidCache::Clear()
+{
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+		delete mEntries[i].mPyramid;
+
+	mEntries.Clear();
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_MINMAXPYRAMID_H
+#define __NEUROMORE_MINMAXPYRAMID_H
+
+// include required headers
+#include "../Config.h"
+#include <DSP/Channel.h>
+
+
+// min/max level-of-detail pyramid of a channel
+// NOTE: every level stores the min, max and sum of aligned sample blocks (16, 64, 256, ... samples) indexed by the absolute sample index; the levels are
+//       updated incrementally as samples arrive, so querying the value range of an arbitrary sample range costs O(levels) instead of O(samples)
+class MinMaxPyramid
+{
+	public:
+		enum
+		{
+			NUM_LEVELS		= 7,	// coarsest level holds blocks of 16 * 4^6 = 65536 samples
+			BASE_SHIFT		= 4,	// finest level holds blocks of 16 samples
+			LEVEL_SHIFT		= 2		// every level merges 4 blocks of the level below
+		};
+
+		// constructor & destructor
+		MinMaxPyramid();
+		virtual ~MinMaxPyramid();
+
+		// fold all samples added to the channel since the last call into the pyramid (rebuilds it if the channel was cleared or replaced)
+		void Update(Channel<double>* channel);
+		void Clear();
+
+		Channel<double>* GetChannel() const								{ return mChannel; }
+
+		// find min/max (and optionally the sum) of the samples in the index range [minSampleIndex, maxSampleIndex] (clamped to the samples of the channel and the pyramid)
+		// outNumSamples receives the number of samples actually covered after clamping (divide the sum by it for the mean)
+		bool CalcRange(uint64 minSampleIndex, uint64 maxSampleIndex, double* outMin, double* outMax, double* outSum = NULL, uint64* outNumSamples = NULL) const;
+
+		// memory used by the pyramid in bytes
+		uint32 CalcMemoryUsed() const;
+
+	private:
+		struct Block
+		{
+			double	mMin;
+			double	mMax;
+			double	mSum;
+		};
+
+		void Reset(Channel<double>* channel);
+		void AddSample(uint64 sampleIndex, double value);
+
+		// get the block at the given level that contains the block index (wraps around for ring buffer channels)
+		Block& GetBlock(uint32 level, uint64 blockIndex);
+		const Block& GetBlock(uint32 level, uint64 blockIndex) const;
+
+		static uint32 GetLevelShift(uint32 level)						{ return BASE_SHIFT + level * LEVEL_SHIFT; }
+
+		Channel<double>*	mChannel;
+		Core::Array<Block>	mLevels[NUM_LEVELS];
+		uint32				mBufferSize;				// buffer size of the channel the levels were allocated for (0 = unbounded, levels grow)
+		uint64				mFirstSampleIndex;			// first sample folded into the pyramid since the last reset
+		uint64				mNumProcessed;				// sample counter of the channel the pyramid is up to date with
+		double				mLastValue;					// value of the last folded sample, used to detect channels that were cleared and refilled
+};
+
+
+// pyramids for all channels displayed by a widget
+// NOTE: pyramids of channels that were not requested since the last call to RemoveUnused() get destroyed
+class MinMaxPyramidCache
+{
+	public:
+		// constructor & destructor
+		MinMaxPyramidCache();
+		virtual ~MinMaxPyramidCache();
+
+		// find or create the pyramid for the given channel
+		MinMaxPyramid* Get(Channel<double>* channel);
+
+		void RemoveUnused();
+		void Clear();
+
+		uint32 GetNumPyramids() const									{ return mEntries.Size(); }
+
+	private:
+		struct Entry
+		{
+			MinMaxPyramid*	mPyramid;
+			bool			mIsUsed;
+		};
+
+		Core::Array<Entry>	mEntries;
+};
+
+
+#endif
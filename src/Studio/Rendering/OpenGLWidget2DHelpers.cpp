@@ -320,7 +320,7 @@ void OpenGLWidget2DHelpers::AutoCalcChartSplits(double height, uint32* outNumSpl
 
 
 // render a channel
-void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<double>* channel, const Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker)
+void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<double>* channel, const Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker, MinMaxPyramid* pyramid)
 {
 	// draw only if the parameters are valid 
 	if (channel == NULL || xEnd < xStart)
@@ -359,6 +359,24 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 		xClippingEnd = markerX;
 	}
 
+	//
+	// Render Envelope (many samples per pixel)
+	//
+
+	if (pyramid != NULL && style == LINE && GetNumSamplesPerPixel(channel, timeRange, xEnd - xStart) > 2.0)
+	{
+		pyramid->Update(channel);
+
+		Color lighterColor = FromQtColor( ToQColor(color).lighter(110) );
+		Color darkerColor = FromQtColor( ToQColor(color).darker(170) );
+		RenderChartEnvelope(callback, channel, pyramid, minTime, maxTime, xStart, xEnd, xClippingEnd, rangeMin, rangeMax, yStart, 0, true, rangeMin, rangeMax, lighterColor, darkerColor);
+
+		if (drawLatencyMarker == true)
+			callback->AddLine(markerX, yStart, lighterColor, markerX, 0, lighterColor);
+
+		return;
+	}
+
 	//
 	// Render Samples
 	//
@@ -511,6 +529,92 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 }
 
 
+// number of samples that fall onto a single pixel
+double OpenGLWidget2DHelpers::GetNumSamplesPerPixel(Channel<double>* channel, double timeRange, double numPixels)
+{
+	if (numPixels <= 0)
+		return 0.0;
+
+	return timeRange * channel->GetSampleRate() / numPixels;
+}
+
+
+// render min/max envelope, one vertical line per pixel column
+void OpenGLWidget2DHelpers::RenderChartEnvelope(OpenGLWidgetCallback* callback, Channel<double>* channel, const MinMaxPyramid* pyramid, double minTime, double maxTime, double xStart, double xEnd, double xClippingEnd, double valueFrom, double valueTo, double yFrom, double yTo, bool clampValues, double colorRangeMin, double colorRangeMax, const Color& lighterColor, const Color& darkerColor, double* outLastX, double* outLastY)
+{
+	if (channel == NULL || pyramid == NULL || channel->IsEmpty() == true || channel->GetSampleRate() <= 0 || maxTime <= minTime || xEnd <= xStart)
+		return;
+
+	const double sampleRate = channel->GetSampleRate();
+	const uint64 minSampleIndex = channel->FindIndexByTime(minTime);
+	const uint64 maxSampleIndex = channel->GetMaxSampleIndex();
+	const double minSampleTime = channel->GetSampleTime(minSampleIndex).InSeconds();
+	const double secondsPerPixel = (maxTime - minTime) / (xEnd - xStart);
+
+	double	previousX = 0.0, previousY = 0.0;
+	Color	previousColor;
+	bool	hasPrevious = false;
+
+	// start with the column of the first sample, stop after the column of the clip edge
+	int32 column = Max<double>( xStart, Math::FloorD(RemapRange(minSampleTime, minTime, maxTime, xStart, xEnd)) );
+	const int32 columnEnd = Min<double>( xEnd, Math::FloorD(xClippingEnd) + 1.0 );
+	uint64 firstIndex = minSampleIndex;
+	for (; column < columnEnd && firstIndex <= maxSampleIndex; ++column)
+	{
+		// the column holds all samples that lie before the left border of the next column
+		const double columnEndTime = minTime + (column + 1 - xStart) * secondsPerPixel;
+		const double numSamples = Math::CeilD( (columnEndTime - minSampleTime) * sampleRate );
+		if (numSamples <= 0.0)
+			continue;
+
+		const uint64 lastIndex = Min<uint64>( minSampleIndex + (uint64)numSamples - 1, maxSampleIndex );
+		if (lastIndex < firstIndex)
+			continue;
+
+		double minValue, maxValue;
+		if (pyramid->CalcRange(firstIndex, lastIndex, &minValue, &maxValue) == false)
+			break;
+
+		const double firstValue	= channel->GetSample(firstIndex);
+		const double lastValue	= channel->GetSample(lastIndex);
+
+		// map values to y coordinates (FIX due to antialiasing problems : round the coords to int and add the twiddle factor)
+		double y[4] = { firstValue, lastValue, minValue, maxValue };
+		Color colors[4];
+		for (uint32 i=0; i<4; ++i)
+		{
+			const float normalizedValue = ClampedRemapRange( y[i], colorRangeMin, colorRangeMax, 0.0, 1.0 );
+			colors[i] = LinearInterpolate<Color>( darkerColor, lighterColor, normalizedValue );
+
+			y[i] = (clampValues == true ? ClampedRemapRange(y[i], valueFrom, valueTo, yFrom, yTo) : RemapRange(y[i], valueFrom, valueTo, yFrom, yTo));
+			y[i] = (int32)y[i] + 0.375;
+		}
+
+		const double x = column + 0.375;
+
+		// connect to the previous column
+		if (hasPrevious == true)
+			callback->AddLine( previousX, previousY, previousColor, x, y[0], colors[0] );
+
+		// value range inside the column
+		if (y[2] != y[3])
+			callback->AddLine( x, y[3], colors[3], x, y[2], colors[2] );
+
+		previousX		= x;
+		previousY		= y[1];
+		previousColor	= colors[1];
+		hasPrevious		= true;
+
+		firstIndex = lastIndex + 1;
+	}
+
+	if (outLastX != NULL)
+		*outLastX = previousX;
+	if (outLastY != NULL)
+		*outLastY = previousY;
+}
+
+
 
 //
 //// render 2D wave for the given channel										   
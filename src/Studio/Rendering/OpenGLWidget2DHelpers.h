@@ -26,6 +26,7 @@
 
 #include "../Config.h"
 #include "OpenGLWidget.h"
+#include "MinMaxPyramid.h"
 
 
 class OpenGLWidget2DHelpers
@@ -63,7 +64,14 @@ class OpenGLWidget2DHelpers
 		
 		// NOTE: used for feedback plugin
 		static void AutoCalcChartSplits(double height, uint32* outNumSplits, uint32* outNumSubSplits);
-		static void RenderChart(OpenGLWidgetCallback* callback, Channel<double>* channel, const Core::Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker = false);
+		// NOTE: pass a pyramid to render line charts with more than a few samples per pixel as min/max envelope (costs O(pixels) instead of O(samples))
+		static void RenderChart(OpenGLWidgetCallback* callback, Channel<double>* channel, const Core::Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker = false, MinMaxPyramid* pyramid = NULL);
+
+		// render the samples between minTime and maxTime as one vertical min/max line per pixel column, connected by the first/last sample of each column
+		// NOTE: the pyramid has to be up to date with the channel; values are mapped linearly from [valueFrom, valueTo] to [yFrom, yTo] and optionally clamped
+		//       time is mapped to [xStart, xEnd], but no column right of xClippingEnd is rendered (e.g. the latency marker)
+		static void RenderChartEnvelope(OpenGLWidgetCallback* callback, Channel<double>* channel, const MinMaxPyramid* pyramid, double minTime, double maxTime, double xStart, double xEnd, double xClippingEnd, double valueFrom, double valueTo, double yFrom, double yTo, bool clampValues, double colorRangeMin, double colorRangeMax, const Core::Color& lighterColor, const Core::Color& darkerColor, double* outLastX = NULL, double* outLastY = NULL);
+		static double GetNumSamplesPerPixel(Channel<double>* channel, double timeRange, double numPixels);
 		
 		// sample render functions
 		typedef void (CORE_CDECL *RenderSampleFunction)(OpenGLWidgetCallback* callback, double value, double xPos, double yPos, double previousXPos, double previousYPos, double xStart, double xEnd, double yStart, double yEnd, double size, const Core::Color& lighterColor, Core::Color& darkerColor, Core::Color& valueColor);
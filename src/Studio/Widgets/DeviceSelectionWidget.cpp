@@ -32,6 +32,12 @@ using namespace Core;
 // constructor
 DeviceSelectionWidget::DeviceSelectionWidget(QWidget* parent) : QComboBox(parent)
 {
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_DEVICEADDED );
+	SubscribeEvent( EVENT_REMOVEDEVICE );
+	SubscribeEvent( EVENT_DEVICEREMOVED );
+	SubscribeEvent( EVENT_ACTIVEBCICHANGED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 	connect(this, SIGNAL(activated(int)), this, SLOT(OnCurrentIndexChanged(int)));
 
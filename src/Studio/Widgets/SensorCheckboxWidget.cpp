@@ -33,6 +33,9 @@ using namespace Core;
 SensorCheckboxWidget::SensorCheckboxWidget(QWidget* parent) : HMultiCheckboxWidget(parent)
 {
 	mBciDevice = NULL;
+	// only receive the events we handle
+	UnsubscribeAllEvents();
+	SubscribeEvent( EVENT_ACTIVEBCICHANGED );
 	CORE_EVENTMANAGER.AddEventHandler(this);
 }
 